@@ -0,0 +1,104 @@
+// batch_lookup_bench.cc
+//
+// Поиск пачками: Map::find для каждого ключа по очереди против
+// Map::find_many и Set::contains против Set::contains_many, где спуски
+// нескольких ключей идут вперемешку с предвыборкой следующих узлов.
+// Ключи запросов случайные (половина отсутствует) и приходят пачками по
+// 64, 256 и 1024. Размеры по умолчанию 1K (дерево в кэше, выигрыша нет) и
+// 1M (дерево больше кэша).
+
+#include <cstdint>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+
+constexpr std::size_t kMinQueries = 1000000;
+
+long long sink = 0; // не даёт компилятору выбросить поиск
+
+void reportRate(const char *name, std::size_t batch, std::size_t n,
+                double ms) {
+  double rate = ms > 0 ? static_cast<double>(n) / ms * 1000.0 : 0.0;
+  std::printf("%-24s batch=%-5zu %10.2f ms %12.0f lookups/s\n", name, batch,
+              ms, rate);
+}
+
+void runBench(std::size_t n) {
+  using Map = s21::Map<int, int>;
+  // чётные ключи есть в дереве, нечётные - нет
+  std::vector<int> raw = s21::bench::randomKeys(n, 11);
+  Map map;
+  s21::Set<int> set;
+  for (int key : raw) {
+    map.insert(key & ~1, key);
+    set.insert(key & ~1);
+  }
+  std::size_t count = n > kMinQueries ? n : kMinQueries;
+  std::vector<int> queries(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    int key = raw[(i * 7919) % n] & ~1;
+    queries[i] = i % 2 == 0 ? key : key + 1;
+  }
+
+  std::printf("-- %zu keys, %zu lookups\n", map.size(), count);
+  std::vector<Map::iterator> found(1024);
+  bool flags[1024];
+  for (std::size_t batch : {64, 256, 1024}) {
+    reportRate("Map::find", batch, count, measureMs([&] {
+                 long long sum = 0;
+                 for (std::size_t i = 0; i < count; i += batch) {
+                   std::size_t end = i + batch < count ? i + batch : count;
+                   for (std::size_t j = i; j < end; ++j) {
+                     found[j - i] = map.find(queries[j]);
+                   }
+                   for (std::size_t j = i; j < end; ++j) {
+                     if (found[j - i] != map.end()) sum += found[j - i]->second;
+                   }
+                 }
+                 sink += sum;
+               }));
+    reportRate("Map::find_many", batch, count, measureMs([&] {
+                 long long sum = 0;
+                 for (std::size_t i = 0; i < count; i += batch) {
+                   std::size_t end = i + batch < count ? i + batch : count;
+                   map.find_many(queries.begin() + i, queries.begin() + end,
+                                 found.begin());
+                   for (std::size_t j = i; j < end; ++j) {
+                     if (found[j - i] != map.end()) sum += found[j - i]->second;
+                   }
+                 }
+                 sink += sum;
+               }));
+    reportRate("Set::contains", batch, count, measureMs([&] {
+                 long long hits = 0;
+                 for (std::size_t i = 0; i < count; ++i) {
+                   hits += set.contains(queries[i]);
+                 }
+                 sink += hits;
+               }));
+    reportRate("Set::contains_many", batch, count, measureMs([&] {
+                 long long hits = 0;
+                 for (std::size_t i = 0; i < count; i += batch) {
+                   std::size_t end = i + batch < count ? i + batch : count;
+                   set.contains_many(queries.begin() + i,
+                                     queries.begin() + end, flags);
+                   for (std::size_t j = 0; j < end - i; ++j) hits += flags[j];
+                 }
+                 sink += hits;
+               }));
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {1000, 1000000})) {
+    runBench(n);
+  }
+  return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,79 @@
+// bench_common.h
+
+#ifndef S21_BENCH_COMMON_H_
+#define S21_BENCH_COMMON_H_
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace s21 {
+namespace bench {
+
+/**
+ * @brief Measures wall-clock time of a callable in milliseconds.
+ *
+ * @param fn The callable to measure.
+ * @return Elapsed time in milliseconds.
+ */
+template <typename Fn>
+double measureMs(Fn &&fn) {
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  auto stop = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::milli>(stop - start).count();
+}
+
+/**
+ * @brief Prints one benchmark result line: name, size, time and throughput.
+ *
+ * @param name The benchmark name.
+ * @param n The number of processed elements.
+ * @param ms The elapsed time in milliseconds.
+ */
+inline void report(const char *name, std::size_t n, double ms) {
+  double mops = ms > 0 ? static_cast<double>(n) / ms / 1000.0 : 0.0;
+  std::printf("%-28s n=%-10zu %10.2f ms %10.2f Mops/s\n", name, n, ms, mops);
+}
+
+/**
+ * @brief Generates a deterministic sequence of pseudo-random keys.
+ *
+ * @param n The number of keys.
+ * @param seed The generator seed.
+ * @return Vector of keys.
+ */
+inline std::vector<int> randomKeys(std::size_t n, std::uint32_t seed = 1) {
+  std::vector<int> keys(n);
+  // линейный конгруэнтный генератор — одинаковые ключи при каждом запуске
+  for (auto &key : keys) {
+    seed = seed * 1664525u + 1013904223u;
+    key = static_cast<int>(seed >> 1);
+  }
+  return keys;
+}
+
+/**
+ * @brief Reads benchmark sizes from the command line or returns defaults.
+ *
+ * @param argc Argument count.
+ * @param argv Argument values; each one is a size.
+ * @param defaults Sizes to use when no arguments are given.
+ * @return Vector of sizes.
+ */
+inline std::vector<std::size_t> sizesFromArgs(
+    int argc, char **argv, std::vector<std::size_t> defaults) {
+  if (argc < 2) return defaults;
+  std::vector<std::size_t> sizes;
+  for (int i = 1; i < argc; ++i) {
+    sizes.push_back(static_cast<std::size_t>(std::strtoull(argv[i], nullptr, 10)));
+  }
+  return sizes;
+}
+
+} // namespace bench
+} // namespace s21
+
+#endif // S21_BENCH_COMMON_H_
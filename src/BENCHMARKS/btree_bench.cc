@@ -0,0 +1,98 @@
+// btree_bench.cc
+//
+// Set / Map на красно-чёрном дереве против BTreeSet / BTreeMap на B+ дереве:
+// вставка случайных ключей, поиск, обход по порядку и память на элемент
+// (по счётчику аллокатора, вместе со служебными полями узлов).
+
+#include <cstdint>
+
+#include "../s21_containers.h"
+#include "../TESTS/counting_allocator.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+using s21_test::AllocStats;
+using s21_test::CountingAllocator;
+
+volatile std::uint64_t sink; // не даёт компилятору выбросить поиск и обход
+
+template <typename Container>
+void runSet(const char *name, const std::vector<int> &keys) {
+  AllocStats stats;
+  std::size_t n = keys.size();
+  std::string label = name;
+  {
+    Container set{CountingAllocator<int>(&stats)};
+    report((label + ": insert").c_str(), n, measureMs([&] {
+             for (int key : keys) set.insert(key);
+           }));
+    report((label + ": find").c_str(), n, measureMs([&] {
+             std::uint64_t found = 0;
+             for (int key : keys) found += set.find(key) != set.end();
+             sink = found;
+           }));
+    report((label + ": scan").c_str(), set.size(), measureMs([&] {
+             std::uint64_t sum = 0;
+             for (int key : set) sum += static_cast<std::uint64_t>(key);
+             sink = sum;
+           }));
+    std::printf("%-28s %.1f bytes/element\n", (label + ": memory").c_str(),
+                static_cast<double>(stats.live_bytes) /
+                    static_cast<double>(set.size()));
+  }
+}
+
+template <typename Container>
+void runMap(const char *name, const std::vector<int> &keys) {
+  using Value = std::pair<const std::uint64_t, std::uint64_t>;
+  AllocStats stats;
+  std::size_t n = keys.size();
+  std::string label = name;
+  {
+    Container map{CountingAllocator<Value>(&stats)};
+    report((label + ": insert").c_str(), n, measureMs([&] {
+             for (int key : keys) {
+               map.insert({static_cast<std::uint64_t>(key), 1});
+             }
+           }));
+    report((label + ": find").c_str(), n, measureMs([&] {
+             std::uint64_t sum = 0;
+             for (int key : keys) {
+               sum += map.find(static_cast<std::uint64_t>(key))->second;
+             }
+             sink = sum;
+           }));
+    report((label + ": scan").c_str(), map.size(), measureMs([&] {
+             std::uint64_t sum = 0;
+             for (const auto &item : map) sum += item.first + item.second;
+             sink = sum;
+           }));
+    std::printf("%-28s %.1f bytes/element\n", (label + ": memory").c_str(),
+                static_cast<double>(stats.live_bytes) /
+                    static_cast<double>(map.size()));
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  using MapValue = std::pair<const std::uint64_t, std::uint64_t>;
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {100000, 1000000})) {
+    std::vector<int> keys = s21::bench::randomKeys(n);
+    runSet<s21::Set<int, std::less<int>, CountingAllocator<int>>>("Set<int>",
+                                                                  keys);
+    runSet<s21::BTreeSet<int, std::less<int>, CountingAllocator<int>>>(
+        "BTreeSet<int>", keys);
+    runMap<s21::Map<std::uint64_t, std::uint64_t, std::less<std::uint64_t>,
+                    CountingAllocator<MapValue>>>("Map<u64,u64>", keys);
+    runMap<s21::BTreeMap<std::uint64_t, std::uint64_t,
+                         std::less<std::uint64_t>,
+                         CountingAllocator<MapValue>>>("BTreeMap<u64,u64>",
+                                                       keys);
+  }
+  return 0;
+}
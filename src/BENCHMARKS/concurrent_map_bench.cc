@@ -0,0 +1,106 @@
+// concurrent_map_bench.cc
+//
+// Map под одним общим std::mutex против ConcurrentMap с 64 шардами:
+// заполненная карта, фиксированное общее число операций делится между
+// 1, 2, 4... потоками. Доли чтений 100%, 90% и 50%; запись - поочерёдно
+// erase и insert того же ключа, так что размер карты почти не меняется.
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+
+using Key = int;
+using Value = long long;
+
+std::atomic<long long> sink{0}; // не даёт компилятору выбросить поиск
+
+// текущий способ: обычная Map, все потоки ждут один мьютекс
+struct LockedMap {
+  bool find(Key key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return map.find(key) != map.end();
+  }
+  void insert(Key key, Value value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    map.insert(key, value);
+  }
+  void erase(Key key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    map.erase(key);
+  }
+
+  std::mutex mutex;
+  s21::Map<Key, Value> map;
+};
+
+struct ShardedMap {
+  bool find(Key key) { return map.contains(key); }
+  void insert(Key key, Value value) { map.insert(key, value); }
+  void erase(Key key) { map.erase(key); }
+
+  s21::ConcurrentMap<Key, Value, 64> map;
+};
+
+// threads потоков выполняют вместе keys.size() операций; поток t берёт
+// каждый threads-й ключ, начиная с t
+template <typename Container>
+void runMix(Container &container, const std::vector<Key> &keys,
+            unsigned threads, unsigned read_percent) {
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      long long found = 0;
+      unsigned writes = 0;
+      for (std::size_t i = t; i < keys.size(); i += threads) {
+        if (i % 100 < read_percent) {
+          found += container.find(keys[i]);
+        } else if (writes++ % 2 == 0) {
+          container.erase(keys[i]);
+        } else {
+          container.insert(keys[i], static_cast<Value>(i));
+        }
+      }
+      sink += found;
+    });
+  }
+  for (std::thread &worker : workers) worker.join();
+}
+
+template <typename Container>
+void runBench(const char *label, const std::vector<Key> &keys) {
+  unsigned hardware = std::thread::hardware_concurrency();
+  for (unsigned read_percent : {100U, 90U, 50U}) {
+    for (unsigned threads = 1; threads <= (hardware > 1 ? hardware : 2);
+         threads *= 2) {
+      Container container;
+      for (Key key : keys) container.insert(key, key);
+      char name[48];
+      std::snprintf(name, sizeof(name), "%s %u%% read, %u thr", label,
+                    read_percent, threads);
+      report(name, keys.size(), measureMs([&] {
+               runMix(container, keys, threads, read_percent);
+             }));
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {100000, 1000000})) {
+    std::vector<Key> keys = s21::bench::randomKeys(n);
+    runBench<LockedMap>("Map+mutex", keys);
+    runBench<ShardedMap>("Concurrent", keys);
+  }
+  return 0;
+}
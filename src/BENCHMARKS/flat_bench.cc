@@ -0,0 +1,120 @@
+// flat_bench.cc
+//
+// Set / Map на красно-чёрном дереве против FlatSet / FlatMap на
+// отсортированном s21::vector: построение из случайного набора ключей
+// (поэлементно и одним insert(first, last)), поиск, обход по порядку,
+// память на элемент (по счётчику аллокатора) и перевод между ними.
+
+#include <cstdint>
+
+#include "../s21_containers.h"
+#include "../TESTS/counting_allocator.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+using s21_test::AllocStats;
+using s21_test::CountingAllocator;
+
+volatile std::uint64_t sink; // не даёт компилятору выбросить поиск и обход
+
+// поиск каждого ключа и обход по порядку - общие для всех контейнеров
+template <typename Container>
+void lookupAndScan(const std::string &label, const Container &set,
+                   const std::vector<int> &keys) {
+  report((label + ": find").c_str(), keys.size(), measureMs([&] {
+           std::uint64_t found = 0;
+           for (int key : keys) found += set.find(key) != set.end();
+           sink = found;
+         }));
+  report((label + ": scan").c_str(), set.size(), measureMs([&] {
+           std::uint64_t sum = 0;
+           for (int key : set) sum += static_cast<std::uint64_t>(key);
+           sink = sum;
+         }));
+}
+
+void printMemory(const std::string &label, const AllocStats &stats,
+                 std::size_t size) {
+  std::printf("%-28s %.1f bytes/element\n", (label + ": memory").c_str(),
+              static_cast<double>(stats.live_bytes) /
+                  static_cast<double>(size));
+}
+
+void runSets(const std::vector<int> &keys) {
+  using TreeSet = s21::Set<int, std::less<int>, CountingAllocator<int>>;
+  using FlatSet = s21::FlatSet<int, std::less<int>, CountingAllocator<int>>;
+  std::size_t n = keys.size();
+  AllocStats tree_stats;
+  AllocStats flat_stats;
+  TreeSet tree{CountingAllocator<int>(&tree_stats)};
+  FlatSet flat{CountingAllocator<int>(&flat_stats)};
+
+  report("Set<int>: insert", n, measureMs([&] {
+           for (int key : keys) tree.insert(key);
+         }));
+  if (n <= 100000) { // поэлементная вставка в массив - O(n^2)
+    FlatSet slow{CountingAllocator<int>(&flat_stats)};
+    report("FlatSet<int>: insert", n, measureMs([&] {
+             for (int key : keys) slow.insert(key);
+           }));
+  }
+  report("FlatSet<int>: bulk insert", n, measureMs([&] {
+           flat.insert(keys.begin(), keys.end());
+         }));
+  lookupAndScan("Set<int>", tree, keys);
+  lookupAndScan("FlatSet<int>", flat, keys);
+  printMemory("Set<int>", tree_stats, tree.size());
+  flat.shrink_to_fit();
+  printMemory("FlatSet<int>", flat_stats, flat.size());
+
+  report("Set -> FlatSet", tree.size(), measureMs([&] {
+           FlatSet copy(tree, CountingAllocator<int>(&flat_stats));
+           sink = copy.size();
+         }));
+  report("FlatSet -> Set", flat.size(), measureMs([&] {
+           sink = flat.to_set().size();
+         }));
+}
+
+void runMaps(const std::vector<int> &keys) {
+  using TreeMap = s21::Map<std::uint64_t, std::uint64_t>;
+  using FlatMap = s21::FlatMap<std::uint64_t, std::uint64_t>;
+  std::vector<std::pair<std::uint64_t, std::uint64_t>> pairs;
+  pairs.reserve(keys.size());
+  for (int key : keys) pairs.emplace_back(key, 1);
+  std::size_t n = keys.size();
+  TreeMap tree;
+  FlatMap flat;
+
+  report("Map<u64,u64>: insert", n, measureMs([&] {
+           for (const auto &item : pairs) tree.insert(item);
+         }));
+  report("FlatMap<u64,u64>: bulk insert", n, measureMs([&] {
+           flat.insert(pairs.begin(), pairs.end());
+         }));
+  report("Map<u64,u64>: find", n, measureMs([&] {
+           std::uint64_t sum = 0;
+           for (const auto &item : pairs) sum += tree.find(item.first)->second;
+           sink = sum;
+         }));
+  report("FlatMap<u64,u64>: find", n, measureMs([&] {
+           std::uint64_t sum = 0;
+           for (const auto &item : pairs) sum += flat.find(item.first)->second;
+           sink = sum;
+         }));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {100000, 1000000})) {
+    std::vector<int> keys = s21::bench::randomKeys(n);
+    runSets(keys);
+    runMaps(keys);
+  }
+  return 0;
+}
@@ -0,0 +1,72 @@
+// frozen_bench.cc
+//
+// Проверка принадлежности в множестве, построенном один раз: Set::contains
+// (спуск по указателям), FlatSet::contains (двоичный поиск в массиве) и
+// FrozenSet::contains (индекс блоков в порядке Эйтцингера и сравнение
+// блока SSE2). Ключи - случайные uint32_t; каждый раз выполняется не меньше
+// миллиона поисков: половина - существующие ключи, половина - отсутствующие.
+// Размеры по умолчанию 1K и 1M; 100M можно передать через BENCH_ARGS
+// (Set такого размера занимает около 4 ГБ).
+
+#include <cstdint>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+
+using Key = std::uint32_t;
+
+constexpr std::size_t kMinQueries = 1000000;
+
+long long sink = 0; // не даёт компилятору выбросить поиск
+
+template <typename Container>
+void runLookups(const char *name, const Container &container,
+                const std::vector<Key> &queries) {
+  report(name, queries.size(), measureMs([&] {
+           long long found = 0;
+           for (Key key : queries) found += container.contains(key);
+           sink += found;
+         }));
+}
+
+void runBench(std::size_t n) {
+  // чётные ключи есть в множестве, нечётные - нет
+  std::vector<int> raw = s21::bench::randomKeys(n, 7);
+  s21::Set<Key> set;
+  for (int key : raw) set.insert(static_cast<Key>(key) & ~Key(1));
+  std::size_t count = n > kMinQueries ? n : kMinQueries;
+  std::vector<Key> queries;
+  queries.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    Key key = static_cast<Key>(raw[(i * 7919) % n]) & ~Key(1);
+    queries.push_back(i % 2 == 0 ? key : key + 1);
+  }
+
+  std::printf("-- %zu keys\n", set.size());
+  runLookups("Set::contains", set, queries);
+  {
+    s21::FlatSet<Key> flat(set);
+    runLookups("FlatSet::contains", flat, queries);
+  }
+  s21::FrozenSet<Key> frozen;
+  report("Set::freeze", set.size(), measureMs([&] { frozen = set.freeze(); }));
+  runLookups("FrozenSet::contains", frozen, queries);
+  std::printf("%-28s %.2f bytes/key\n", "FrozenSet memory",
+              static_cast<double>(frozen.memory_usage()) /
+                  static_cast<double>(frozen.size()));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {1000, 1000000})) {
+    runBench(n);
+  }
+  return sink == 42 ? 1 : 0;
+}
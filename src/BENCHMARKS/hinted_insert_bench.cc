@@ -0,0 +1,73 @@
+// hinted_insert_bench.cc
+//
+// Вставка почти упорядоченного потока ключей (метки времени): обычный
+// insert против insert с подсказкой end() и с подсказкой от предыдущей
+// вставки, для Set и MultiSet.
+
+#include <string>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+
+// монотонный поток: каждый ключ больше предыдущего
+std::vector<int> monotonicKeys(std::size_t n) {
+  std::vector<int> keys(n);
+  for (std::size_t i = 0; i < n; ++i) keys[i] = static_cast<int>(i * 2);
+  return keys;
+}
+
+// почти монотонный поток: каждый ключ с небольшим случайным запаздыванием
+std::vector<int> nearlyMonotonicKeys(std::size_t n) {
+  std::vector<int> keys = s21::bench::randomKeys(n, 7);
+  for (std::size_t i = 0; i < n; ++i) {
+    keys[i] = static_cast<int>(i * 2) - keys[i] % 16;
+  }
+  return keys;
+}
+
+template <typename Container>
+void runHintBench(const char *stream, const std::vector<int> &keys) {
+  const std::size_t n = keys.size();
+  std::string prefix(stream);
+  {
+    Container c;
+    report((prefix + " insert").c_str(), n, measureMs([&] {
+             for (int key : keys) c.insert(key);
+           }));
+  }
+  {
+    Container c;
+    report((prefix + " hint end()").c_str(), n, measureMs([&] {
+             for (int key : keys) c.insert(c.end(), key);
+           }));
+  }
+  {
+    Container c;
+    report((prefix + " hint last pos").c_str(), n, measureMs([&] {
+             auto hint = c.end();
+             for (int key : keys) hint = std::next(c.insert(hint, key));
+           }));
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {100000, 1000000})) {
+    auto monotonic = monotonicKeys(n);
+    auto nearly = nearlyMonotonicKeys(n);
+    std::printf("Set<int>\n");
+    runHintBench<s21::Set<int>>("mono", monotonic);
+    runHintBench<s21::Set<int>>("nearly", nearly);
+    std::printf("MultiSet<int>\n");
+    runHintBench<s21::MultiSet<int>>("mono", monotonic);
+    runHintBench<s21::MultiSet<int>>("nearly", nearly);
+  }
+  return 0;
+}
@@ -0,0 +1,106 @@
+// mapped_bench.cc
+//
+// Таблица поиска только для чтения: загрузка двоичного снимка Set (дерево
+// строится в куче процесса) против открытия файла MappedSet (mmap и
+// проверка заголовка), затем проверки принадлежности в Set, FrozenSet и
+// MappedSet. Ключи uint64_t, запросы - половина есть, половины нет, не
+// меньше 1M. Размеры по умолчанию 1K и 1M.
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <unistd.h>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+
+constexpr std::size_t kMinQueries = 1000000;
+
+long long sink = 0; // не даёт компилятору выбросить поиск
+
+void runBench(std::size_t n) {
+  using Key = std::uint64_t;
+  std::vector<int> raw = s21::bench::randomKeys(n, 17);
+  s21::Set<Key> set;
+  for (int key : raw) {
+    set.insert(static_cast<Key>(key) * 2); // чётные есть, нечётных нет
+  }
+  std::size_t count = n > kMinQueries ? n : kMinQueries;
+  std::vector<Key> queries(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    queries[i] = static_cast<Key>(raw[(i * 7919) % n]) * 2 + i % 2;
+  }
+
+  char snapshot_path[] = "/tmp/s21_mapped_bench_XXXXXX";
+  char mapped_path[] = "/tmp/s21_mapped_bench_XXXXXX";
+  int snapshot = mkstemp(snapshot_path);
+  int mapped_fd = mkstemp(mapped_path);
+  if (snapshot < 0 || mapped_fd < 0) {
+    std::perror("mkstemp");
+    std::exit(1);
+  }
+  set.save(snapshot);
+  s21::MappedSet<Key>::save(mapped_fd, set);
+  std::printf("-- %zu keys, %zu lookups\n", set.size(), count);
+
+  report("Set snapshot load", set.size(), measureMs([&] {
+           lseek(snapshot, 0, SEEK_SET);
+           s21::Set<Key> loaded;
+           loaded.load(snapshot);
+           sink += static_cast<long long>(loaded.size());
+         }));
+  report("MappedSet open", set.size(), measureMs([&] {
+           s21::MappedSet<Key> opened(mapped_path);
+           sink += static_cast<long long>(opened.size());
+         }));
+
+  s21::MappedSet<Key> mapped(mapped_path);
+  s21::FrozenSet<Key> frozen = set.freeze();
+  std::printf("   mapped file: %.1f bytes per key\n",
+              static_cast<double>(mapped.mapped_bytes()) /
+                  static_cast<double>(set.size()));
+  report("Set::contains", count, measureMs([&] {
+           long long hits = 0;
+           for (Key key : queries) hits += set.contains(key);
+           sink += hits;
+         }));
+  report("FrozenSet::contains", count, measureMs([&] {
+           long long hits = 0;
+           for (Key key : queries) hits += frozen.contains(key);
+           sink += hits;
+         }));
+  report("MappedSet::contains", count, measureMs([&] {
+           long long hits = 0;
+           for (Key key : queries) hits += mapped.contains(key);
+           sink += hits;
+         }));
+  report("MappedSet::lower_bound", count, measureMs([&] {
+           long long sum = 0;
+           for (Key key : queries) {
+             auto it = mapped.lower_bound(key);
+             if (it != mapped.end()) sum += static_cast<long long>(*it);
+           }
+           sink += sum;
+         }));
+
+  close(snapshot);
+  close(mapped_fd);
+  unlink(snapshot_path);
+  unlink(mapped_path);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {1000, 1000000})) {
+    runBench(n);
+  }
+  return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,58 @@
+// merge_bench.cc
+//
+// Слияние двух Set<std::string>: merge, переносящий узлы, против вставки
+// копий и очистки источника (как было до node handle), и перенос одного
+// элемента через extract/insert(node_type&&).
+
+#include <string>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+using StringSet = s21::Set<std::string>;
+
+// половина ключей общая для обоих множеств
+void fill(StringSet &a, StringSet &b, const std::vector<int> &keys) {
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    std::string key = "key-" + std::to_string(keys[i]);
+    if (i % 2 == 0 || i % 3 == 0) a.insert(key);
+    if (i % 2 == 1 || i % 3 == 0) b.insert(key);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {100000, 1000000})) {
+    auto keys = s21::bench::randomKeys(n, 11);
+    {
+      StringSet a;
+      StringSet b;
+      fill(a, b, keys);
+      report("copy + clear", n, measureMs([&] {
+               for (const auto &key : b) a.insert(key);
+               b.clear();
+             }));
+    }
+    {
+      StringSet a;
+      StringSet b;
+      fill(a, b, keys);
+      report("merge (nodes)", n, measureMs([&] { a.merge(b); }));
+    }
+    {
+      StringSet a;
+      StringSet b;
+      fill(a, b, keys);
+      report("extract + insert(node)", n, measureMs([&] {
+               while (!b.empty()) a.insert(b.extract(b.begin()));
+             }));
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,85 @@
+// node_memory_bench.cc
+//
+// Размер узла красно-чёрного дерева и память на элемент. Собирается дважды:
+// с цветом в младшем бите указателя на родителя (по умолчанию) и с
+// S21_RBTREE_PACKED_COLOR=0 - отдельное поле bool (см. цель bench в
+// makefile). Для каждого n память считается CountingAllocator'ом после
+// вставки n случайных ключей, время - для вставки и поиска всех ключей;
+// строка "x 100M" пересчитывает размер узла на 100 миллионов элементов.
+
+#include <string>
+
+#include "../TESTS/counting_allocator.h"
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+
+constexpr double kMiB = 1024.0 * 1024.0;
+constexpr std::size_t kHundredMillion = 100000000;
+
+long long sink = 0; // не даёт компилятору выбросить поиск
+
+template <typename Node> void printNodeSize(const char *name) {
+  std::printf("%-28s sizeof(node)=%-3zu x 100M = %8.0f MiB\n", name,
+              sizeof(Node),
+              static_cast<double>(sizeof(Node) * kHundredMillion) / kMiB);
+}
+
+void printMeasured(const char *name, const s21_test::AllocStats &stats,
+                   std::size_t n) {
+  std::printf("%-28s n=%-10zu %10.2f MiB %10.1f bytes/element\n", name, n,
+              static_cast<double>(stats.live_bytes) / kMiB,
+              static_cast<double>(stats.live_bytes) / static_cast<double>(n));
+}
+
+void benchSet(const std::vector<int> &keys) {
+  using Alloc = s21_test::CountingAllocator<int>;
+  s21_test::AllocStats stats;
+  s21::Set<int, std::less<int>, Alloc> set{Alloc(&stats)};
+  report("Set<int> insert", keys.size(), measureMs([&] {
+           for (int key : keys) set.insert(key);
+         }));
+  report("Set<int> find", keys.size(), measureMs([&] {
+           for (int key : keys) sink += set.contains(key);
+         }));
+  printMeasured("Set<int> memory", stats, set.size());
+}
+
+void benchMap(const std::vector<int> &keys) {
+  using Alloc = s21_test::CountingAllocator<std::pair<const int, int>>;
+  s21_test::AllocStats stats;
+  s21::Map<int, int, std::less<int>, Alloc> map{Alloc(&stats)};
+  report("Map<int, int> insert", keys.size(), measureMs([&] {
+           for (int key : keys) map.insert(key, key);
+         }));
+  report("Map<int, int> find", keys.size(), measureMs([&] {
+           for (int key : keys) sink += map.contains(key);
+         }));
+  printMeasured("Map<int, int> memory", stats, map.size());
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::printf("RBTree node color: %s\n",
+              S21_RBTREE_PACKED_COLOR ? "packed into parent pointer"
+                                      : "separate bool");
+  printNodeSize<s21::RBTNode<int, std::less<int>>>("Set<int>");
+  printNodeSize<s21::RBTNode<long long, std::less<long long>>>(
+      "Set<long long>");
+  printNodeSize<s21::RBTNode<std::pair<const int, int>, std::less<int>>>(
+      "Map<int, int>");
+  printNodeSize<s21::RBTNode<std::string, std::less<std::string>>>(
+      "Set<std::string>");
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {1000000, 10000000})) {
+    std::vector<int> keys = s21::bench::randomKeys(n);
+    benchSet(keys);
+    benchMap(keys);
+  }
+  return sink == 42 ? 1 : 0;
+}
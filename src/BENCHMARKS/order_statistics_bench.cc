@@ -0,0 +1,63 @@
+// order_statistics_bench.cc
+//
+// Доступ к k-му элементу MultiSet: select/nth по размерам поддеревьев против
+// линейного std::next от begin(), и прыжок итератора advance против ++.
+
+#include <algorithm>
+#include <iterator>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+
+// число запросов на каждый замер
+constexpr std::size_t kQueries = 1000;
+// линейные замеры дороги — для них запросов меньше
+constexpr std::size_t kLinearQueries = 20;
+
+} // namespace
+
+int main(int argc, char **argv) {
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {1000000, 10000000})) {
+    auto keys = s21::bench::randomKeys(n);
+    std::sort(keys.begin(), keys.end());
+    s21::MultiSet<int> set(s21::sorted_equivalent, keys.begin(), keys.end());
+
+    for (unsigned percentile : {50u, 99u}) {
+      std::size_t k = n * percentile / 100;
+      long long sink = 0;
+      char name[32];
+
+      std::snprintf(name, sizeof(name), "select p%u", percentile);
+      double ms = measureMs([&] {
+        for (std::size_t i = 0; i < kQueries; ++i) sink += set.select(k);
+      });
+      report(name, kQueries, ms);
+
+      std::snprintf(name, sizeof(name), "begin().advance p%u", percentile);
+      ms = measureMs([&] {
+        for (std::size_t i = 0; i < kQueries; ++i) {
+          auto it = set.begin();
+          sink += *it.advance(k);
+        }
+      });
+      report(name, kQueries, ms);
+
+      std::snprintf(name, sizeof(name), "std::next p%u", percentile);
+      ms = measureMs([&] {
+        for (std::size_t i = 0; i < kLinearQueries; ++i) {
+          sink += *std::next(set.begin(), k);
+        }
+      });
+      report(name, kLinearQueries, ms);
+
+      std::printf("(n=%zu, checksum %lld)\n", n, sink);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,107 @@
+// persistent_bench.cc
+//
+// История версий: после каждого изменения сохраняется снимок, последние
+// kKept снимков хранятся. PersistentMap делает снимок за O(1) и копирует
+// при изменении только путь до ключа; Map для того же копируется целиком.
+// Отдельно - цена одного изменения без снимков. Память считается
+// CountingAllocator'ом: байты живых узлов при kKept сохранённых версиях.
+
+#include <deque>
+
+#include "../TESTS/counting_allocator.h"
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+
+using Key = int;
+using Value = long long;
+using Alloc = s21_test::CountingAllocator<std::pair<const Key, Value>>;
+using PMap = s21::PersistentMap<Key, Value, std::less<Key>, Alloc>;
+using CopyMap = s21::Map<Key, Value, std::less<Key>, Alloc>;
+
+constexpr std::size_t kKept = 16;
+
+long long sink = 0; // не даёт компилятору выбросить работу
+
+void printMemory(const char *name, const s21_test::AllocStats &stats,
+                 std::size_t n) {
+  std::printf("%-28s n=%-10zu %10.2f MiB %10.1f bytes/element\n", name, n,
+              static_cast<double>(stats.live_bytes) / (1024.0 * 1024.0),
+              static_cast<double>(stats.live_bytes) / static_cast<double>(n));
+}
+
+// изменение без снимков: Map меняется на месте, PersistentMap строит
+// новую версию и отпускает старую
+void benchUpdates(const std::vector<Key> &keys) {
+  s21_test::AllocStats map_stats;
+  CopyMap map{Alloc(&map_stats)};
+  for (Key key : keys) map.insert(key, key);
+  report("Map update in place", keys.size(), measureMs([&] {
+           for (std::size_t i = 0; i < keys.size(); ++i) {
+             map.insert_or_assign(keys[i], static_cast<Value>(i));
+           }
+         }));
+
+  s21_test::AllocStats persistent_stats;
+  PMap persistent{Alloc(&persistent_stats)};
+  for (Key key : keys) persistent = persistent.insert(key, key);
+  report("Persistent new version", keys.size(), measureMs([&] {
+           for (std::size_t i = 0; i < keys.size(); ++i) {
+             persistent = persistent.insert_or_assign(keys[i],
+                                                      static_cast<Value>(i));
+           }
+         }));
+  sink += static_cast<long long>(map.size() + persistent.size());
+}
+
+// updates изменений, после каждого - снимок
+void benchSnapshots(const std::vector<Key> &keys, std::size_t updates) {
+  s21_test::AllocStats copy_stats;
+  {
+    CopyMap map{Alloc(&copy_stats)};
+    for (Key key : keys) map.insert(key, key);
+    std::deque<CopyMap> history;
+    report("Map full copy + update", updates, measureMs([&] {
+             for (std::size_t i = 0; i < updates; ++i) {
+               history.push_back(map);
+               if (history.size() > kKept) history.pop_front();
+               map.insert_or_assign(keys[i % keys.size()],
+                                    static_cast<Value>(i));
+             }
+           }));
+    printMemory("Map, 16 copies kept", copy_stats, keys.size());
+  }
+
+  s21_test::AllocStats persistent_stats;
+  {
+    PMap persistent{Alloc(&persistent_stats)};
+    for (Key key : keys) persistent = persistent.insert(key, key);
+    std::deque<PMap> history;
+    report("Persistent snapshot+update", updates, measureMs([&] {
+             for (std::size_t i = 0; i < updates; ++i) {
+               history.push_back(persistent.snapshot());
+               if (history.size() > kKept) history.pop_front();
+               persistent = persistent.insert_or_assign(
+                   keys[i % keys.size()], static_cast<Value>(i));
+             }
+           }));
+    printMemory("Persistent, 16 versions", persistent_stats, keys.size());
+    sink += static_cast<long long>(history.front().size());
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {100000, 1000000})) {
+    std::vector<Key> keys = s21::bench::randomKeys(n);
+    benchUpdates(keys);
+    benchSnapshots(keys, 200);
+  }
+  return sink == 42 ? 1 : 0;
+}
@@ -0,0 +1,72 @@
+// range_erase_bench.cc
+//
+// Вытеснение просроченных ключей из Set<uint64_t> (все ключи ниже
+// водяной отметки): цикл одиночных erase против erase(first, last), и
+// прореживание по предикату циклом против erase_if.
+
+#include <cstdint>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+using TimeSet = s21::Set<std::uint64_t>;
+
+TimeSet makeTimestamps(std::size_t n) {
+  TimeSet set;
+  for (std::uint64_t i = 0; i < n; ++i) set.insert(set.end(), i);
+  return set;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {100000, 1000000})) {
+    const std::size_t watermark = n / 2;
+    {
+      TimeSet set = makeTimestamps(n);
+      report("expire: erase loop", n, measureMs([&] {
+               for (std::size_t i = 0; i < watermark; ++i)
+                 set.erase(set.begin());
+             }));
+    }
+    {
+      TimeSet set = makeTimestamps(n);
+      report("expire: erase(first, last)", n, measureMs([&] {
+               set.erase(set.begin(), set.nth(watermark));
+             }));
+    }
+    {
+      TimeSet set = makeTimestamps(n);
+      report("expire: erase_if", n, measureMs([&] {
+               s21::erase_if(set, [watermark](std::uint64_t key) {
+                 return key < watermark;
+               });
+             }));
+    }
+    {
+      TimeSet set = makeTimestamps(n);
+      report("filter: erase loop", n, measureMs([&] {
+               for (auto it = set.begin(); it != set.end();) {
+                 auto next = it;
+                 ++next;
+                 if (*it % 3 == 0) set.erase(it);
+                 it = next;
+               }
+             }));
+    }
+    {
+      TimeSet set = makeTimestamps(n);
+      report("filter: erase_if", n, measureMs([&] {
+               s21::erase_if(set, [](std::uint64_t key) {
+                 return key % 3 == 0;
+               });
+             }));
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,51 @@
+// rb_tree_bulk_bench.cc
+//
+// Построение Set из уже отсортированного диапазона: поштучная вставка
+// против линейной сборки (диапазонный конструктор и тег sorted_unique).
+
+#include <algorithm>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+
+void runBulkBench(const std::vector<int> &sorted) {
+  const std::size_t n = sorted.size();
+  {
+    s21::Set<int> set;
+    report("insert one by one", n, measureMs([&] {
+             for (int key : sorted) set.insert(key);
+           }));
+  }
+  {
+    double ms = measureMs([&] {
+      s21::Set<int> set(sorted.begin(), sorted.end());
+      if (set.size() != n) std::abort();
+    });
+    report("range ctor (checked)", n, ms);
+  }
+  {
+    double ms = measureMs([&] {
+      s21::Set<int> set(s21::sorted_unique, sorted.begin(), sorted.end());
+      if (set.size() != n) std::abort();
+    });
+    report("sorted_unique ctor", n, ms);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {100000, 1000000})) {
+    auto keys = s21::bench::randomKeys(n);
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    runBulkBench(keys);
+  }
+  return 0;
+}
@@ -0,0 +1,50 @@
+// rb_tree_copy_bench.cc
+//
+// Копирование RBTree разным числом потоков (RBTree::copyFrom). Один поток —
+// последовательная сборка через buildSorted, остальные — параллельная копия.
+
+#include <string>
+#include <thread>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+
+template <typename Key>
+void runCopyBench(const std::vector<Key> &keys) {
+  s21::RBTree<Key> tree;
+  for (const auto &key : keys) tree.insert(key);
+
+  unsigned hardware = std::thread::hardware_concurrency();
+  for (unsigned threads = 1; threads <= (hardware > 1 ? hardware : 2);
+       threads *= 2) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "copy, %u thread(s)", threads);
+    s21::RBTree<Key> copy;
+    report(name, tree.size(),
+           measureMs([&] { copy.copyFrom(tree, threads); }));
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {100000, 1000000})) {
+    auto keys = s21::bench::randomKeys(n);
+    std::printf("-- int keys\n");
+    runCopyBench(keys);
+
+    std::vector<std::string> str_keys;
+    str_keys.reserve(n);
+    for (int key : keys) str_keys.push_back(std::string(24, 'k') + std::to_string(key));
+    std::printf("-- std::string keys\n");
+    runCopyBench(str_keys);
+  }
+  return 0;
+}
@@ -0,0 +1,58 @@
+// rb_tree_pool_bench.cc
+//
+// Пропускная способность insert/erase/clear для RBTree. Собирается дважды:
+// с пулом узлов (по умолчанию) и с S21_RBTREE_NODE_POOL=0 — поштучные
+// new/delete, чтобы сравнить оба пути (см. цель bench в makefile).
+
+#include <string>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+
+template <typename Key>
+void runTreeBench(const std::vector<Key> &keys, bool reserve) {
+  const std::size_t n = keys.size();
+  s21::RBTree<Key> tree;
+  if (reserve) tree.reserve(n);
+
+  report(reserve ? "insert (reserved)" : "insert", n, measureMs([&] {
+           for (const auto &key : keys) tree.insert(key);
+         }));
+
+  // удаляем половину ключей и вставляем их снова — узлы берутся из free list
+  const std::size_t half = n / 2;
+  report("erase half", half, measureMs([&] {
+           for (std::size_t i = 0; i < half; ++i) tree.erase(tree.find(keys[i]));
+         }));
+  report("reinsert half", half, measureMs([&] {
+           for (std::size_t i = 0; i < half; ++i) tree.insert(keys[i]);
+         }));
+
+  report("clear", n, measureMs([&] { tree.clear(); }));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::printf("RBTree node allocation: %s\n",
+              S21_RBTREE_NODE_POOL ? "slab pool" : "new/delete");
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {100000, 1000000})) {
+    auto keys = s21::bench::randomKeys(n);
+    std::printf("-- int keys\n");
+    runTreeBench(keys, false);
+    runTreeBench(keys, true);
+
+    std::vector<std::string> str_keys;
+    str_keys.reserve(n);
+    for (int key : keys) str_keys.push_back(std::to_string(key));
+    std::printf("-- std::string keys\n");
+    runTreeBench(str_keys, false);
+  }
+  return 0;
+}
@@ -0,0 +1,112 @@
+// seqlock_map_bench.cc
+//
+// Поиск в почти неизменяемой карте: Map под std::shared_mutex, ConcurrentMap
+// с 16 шардами и SeqlockMap без блокировок у читателей. Заполненная карта,
+// фиксированное общее число операций делится между 1, 2, 4... потоками;
+// 100% и 99% поисков, остальное - insert_or_assign существующих ключей.
+
+#include <atomic>
+#include <shared_mutex>
+#include <thread>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+
+using Key = int;
+using Value = long long;
+
+std::atomic<long long> sink{0}; // не даёт компилятору выбросить поиск
+
+// обычный способ: читатели берут общий мьютекс на чтение
+struct SharedLockedMap {
+  bool find(Key key) {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return map.find(key) != map.end();
+  }
+  void insert(Key key, Value value) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    map.insert(key, value);
+  }
+  void assign(Key key, Value value) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    map.insert_or_assign(key, value);
+  }
+
+  std::shared_mutex mutex;
+  s21::Map<Key, Value> map;
+};
+
+struct ShardedMap {
+  bool find(Key key) { return map.contains(key); }
+  void insert(Key key, Value value) { map.insert(key, value); }
+  void assign(Key key, Value value) { map.insert_or_assign(key, value); }
+
+  s21::ConcurrentMap<Key, Value, 16> map;
+};
+
+struct OptimisticMap {
+  bool find(Key key) { return map.contains(key); }
+  void insert(Key key, Value value) { map.insert(key, value); }
+  void assign(Key key, Value value) { map.insert_or_assign(key, value); }
+
+  s21::SeqlockMap<Key, Value> map;
+};
+
+// threads потоков выполняют вместе keys.size() операций; поток t берёт
+// каждый threads-й ключ, начиная с t
+template <typename Container>
+void runMix(Container &container, const std::vector<Key> &keys,
+            unsigned threads, unsigned read_percent) {
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      long long found = 0;
+      for (std::size_t i = t; i < keys.size(); i += threads) {
+        if (i % 100 < read_percent) {
+          found += container.find(keys[i]);
+        } else {
+          container.assign(keys[i], static_cast<Value>(i));
+        }
+      }
+      sink += found;
+    });
+  }
+  for (std::thread &worker : workers) worker.join();
+}
+
+template <typename Container>
+void runBench(const char *label, const std::vector<Key> &keys) {
+  unsigned hardware = std::thread::hardware_concurrency();
+  for (unsigned read_percent : {100U, 99U}) {
+    for (unsigned threads = 1; threads <= (hardware > 1 ? hardware : 2);
+         threads *= 2) {
+      Container container;
+      for (Key key : keys) container.insert(key, key);
+      char name[48];
+      std::snprintf(name, sizeof(name), "%s %u%% read, %u thr", label,
+                    read_percent, threads);
+      report(name, keys.size(), measureMs([&] {
+               runMix(container, keys, threads, read_percent);
+             }));
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {100000, 1000000})) {
+    std::vector<Key> keys = s21::bench::randomKeys(n);
+    runBench<SharedLockedMap>("Map+shared", keys);
+    runBench<ShardedMap>("Concurrent", keys);
+    runBench<OptimisticMap>("Seqlock", keys);
+  }
+  return 0;
+}
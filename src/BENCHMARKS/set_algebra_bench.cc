@@ -0,0 +1,64 @@
+// set_algebra_bench.cc
+//
+// Пересечение, разность и объединение двух Set<uint64_t> (идентификаторы):
+// поиск каждого ключа второго множества и вставка по одному против
+// однопроходных set_intersection / set_difference / set_union.
+
+#include <cstdint>
+#include <string>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+using IdSet = s21::Set<std::uint64_t>;
+
+// множество из n идентификаторов; около трети общие для двух seed
+IdSet makeIds(std::size_t n, std::uint32_t seed) {
+  auto keys = s21::bench::randomKeys(n, seed);
+  IdSet ids;
+  for (std::size_t i = 0; i < n; ++i) {
+    std::uint64_t id = static_cast<std::uint64_t>(keys[i]) % (n * 3);
+    ids.insert(i % 3 == 0 ? i : id);
+  }
+  return ids;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {100000, 1000000})) {
+    IdSet a = makeIds(n, 1);
+    IdSet b = makeIds(n, 2);
+    std::size_t total = a.size() + b.size();
+
+    report("intersection: find+insert", total, measureMs([&] {
+             IdSet result;
+             for (auto id : a) {
+               if (b.contains(id)) result.insert(result.end(), id);
+             }
+           }));
+    report("set_intersection", total,
+           measureMs([&] { IdSet result = a.set_intersection(b); }));
+    report("difference: find+insert", total, measureMs([&] {
+             IdSet result;
+             for (auto id : a) {
+               if (!b.contains(id)) result.insert(result.end(), id);
+             }
+           }));
+    report("set_difference", total,
+           measureMs([&] { IdSet result = a.set_difference(b); }));
+    report("union: copy+merge", total, measureMs([&] {
+             IdSet result = a;
+             IdSet rest = b;
+             result.merge(rest);
+           }));
+    report("set_union", total,
+           measureMs([&] { IdSet result = a.set_union(b); }));
+  }
+  return 0;
+}
@@ -0,0 +1,114 @@
+// snapshot_bench.cc
+//
+// Сохранение и загрузка контейнеров: текстовый файл "ключ значение" с
+// разбором строк и вставкой по одному элементу против двоичного снимка
+// (save / load). Для Map<int, int> снимок загружается в ключевом порядке
+// линейным построением дерева, vector<int> читается одним блоком прямо в
+// память вектора. Размеры по умолчанию 100K и 1M.
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <unistd.h>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+
+long long sink = 0; // не даёт компилятору выбросить загрузку
+
+// временный файл в /tmp, удаляется сразу после открытия
+int openTemp() {
+  char path[] = "/tmp/s21_snapshot_bench_XXXXXX";
+  int fd = mkstemp(path);
+  if (fd < 0) {
+    std::perror("mkstemp");
+    std::exit(1);
+  }
+  unlink(path);
+  return fd;
+}
+
+void saveText(int fd, const s21::Map<int, int> &map) {
+  std::FILE *file = fdopen(dup(fd), "w");
+  for (const auto &item : map) {
+    std::fprintf(file, "%d %d\n", item.first, item.second);
+  }
+  std::fclose(file);
+}
+
+s21::Map<int, int> loadText(int fd) {
+  std::FILE *file = fdopen(dup(fd), "r");
+  s21::Map<int, int> map;
+  int key = 0, value = 0;
+  while (std::fscanf(file, "%d %d", &key, &value) == 2) {
+    map.insert(key, value);
+  }
+  std::fclose(file);
+  return map;
+}
+
+void runBench(std::size_t n) {
+  std::vector<int> keys = s21::bench::randomKeys(n, 5);
+  s21::Map<int, int> map;
+  s21::vector<int> numbers;
+  for (int key : keys) {
+    map.insert(key, key ^ 0x5bd1e995);
+    numbers.push_back(key);
+  }
+  std::printf("-- %zu elements\n", map.size());
+
+  int text = openTemp();
+  int binary = openTemp();
+  report("Map text save", n, measureMs([&] {
+           ftruncate(text, 0);
+           lseek(text, 0, SEEK_SET);
+           saveText(text, map);
+         }));
+  report("Map snapshot save", n, measureMs([&] {
+           ftruncate(binary, 0);
+           lseek(binary, 0, SEEK_SET);
+           map.save(binary);
+         }));
+  std::printf("   file size: text %lld bytes, snapshot %lld bytes\n",
+              static_cast<long long>(lseek(text, 0, SEEK_END)),
+              static_cast<long long>(lseek(binary, 0, SEEK_END)));
+  report("Map text load", n, measureMs([&] {
+           lseek(text, 0, SEEK_SET);
+           sink += loadText(text).size();
+         }));
+  report("Map snapshot load", n, measureMs([&] {
+           lseek(binary, 0, SEEK_SET);
+           s21::Map<int, int> loaded;
+           loaded.load(binary);
+           sink += loaded.size();
+         }));
+
+  report("vector snapshot save", n, measureMs([&] {
+           ftruncate(binary, 0);
+           lseek(binary, 0, SEEK_SET);
+           numbers.save(binary);
+         }));
+  report("vector snapshot load", n, measureMs([&] {
+           lseek(binary, 0, SEEK_SET);
+           s21::vector<int> loaded;
+           loaded.load(binary);
+           sink += loaded[loaded.size() / 2];
+         }));
+  close(text);
+  close(binary);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {100000, 1000000})) {
+    runBench(n);
+  }
+  return sink == 42 ? 1 : 0;
+}
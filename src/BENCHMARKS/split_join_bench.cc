@@ -0,0 +1,49 @@
+// split_join_bench.cc
+//
+// Перешардирование Map<uint64_t, uint64_t> по границе ключа: split/join
+// против переноса хвоста вставками в другую карту и стиранием из исходной.
+
+#include <cstdint>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+using IdMap = s21::Map<std::uint64_t, std::uint64_t>;
+
+IdMap makeShard(std::size_t n) {
+  IdMap shard;
+  for (std::uint64_t i = 0; i < n; ++i) shard.insert({i, i * 7});
+  return shard;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {100000, 1000000})) {
+    const std::uint64_t boundary = n / 2;
+    {
+      IdMap shard = makeShard(n);
+      report("insert + erase", n, measureMs([&] {
+               IdMap tail;
+               // ключи 0..n-1, поэтому граница совпадает с позицией
+               for (auto it = shard.nth(boundary); it != shard.end(); ++it)
+                 tail.insert(tail.end(), *it);
+               while (shard.size() > boundary) shard.erase(shard.nth(boundary));
+               for (const auto &item : tail) shard.insert(shard.end(), item);
+             }));
+    }
+    {
+      IdMap shard = makeShard(n);
+      report("split + join", n, measureMs([&] {
+               IdMap tail = shard.split(boundary);
+               shard.join(tail);
+             }));
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,89 @@
+// unordered_bench.cc
+//
+// Map на красно-чёрном дереве, std::unordered_map и UnorderedMap на
+// открытой адресации: вставка случайных ключей (с reserve и без), поиск
+// существующих и отсутствующих ключей и смена половины ключей
+// (удаление + вставка новых, надгробия).
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "../s21_containers.h"
+#include "bench_common.h"
+
+namespace {
+
+using s21::bench::measureMs;
+using s21::bench::report;
+
+volatile std::uint64_t sink; // не даёт компилятору выбросить поиск
+
+// случайные 64-битные ключи: искомые чётные, промахи нечётные - вперемешку
+// с ними, чтобы дерево не находило промах по одному краю
+std::vector<std::uint64_t> makeKeys(std::size_t n, std::uint32_t seed) {
+  std::vector<int> low = s21::bench::randomKeys(n, seed);
+  std::vector<int> high = s21::bench::randomKeys(n, seed + 1);
+  std::vector<std::uint64_t> keys(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    keys[i] = (static_cast<std::uint64_t>(high[i]) << 32 |
+               static_cast<std::uint32_t>(low[i])) &
+              ~1ULL;
+  }
+  return keys;
+}
+
+template <typename Container>
+void run(const char *name, const std::vector<std::uint64_t> &keys,
+         const std::vector<std::uint64_t> &misses, bool reserve) {
+  std::size_t n = keys.size();
+  std::string label(name);
+  Container map;
+  report((label + (reserve ? ": insert+reserve" : ": insert")).c_str(), n,
+         measureMs([&] {
+           if constexpr (!std::is_same<Container,
+                                       s21::Map<std::uint64_t,
+                                                std::uint64_t>>::value) {
+             if (reserve) map.reserve(n);
+           }
+           for (std::uint64_t key : keys) map.insert({key, key});
+         }));
+  if (reserve) {
+    return;
+  }
+  report((label + ": find hit").c_str(), n, measureMs([&] {
+           std::uint64_t sum = 0;
+           for (std::uint64_t key : keys) sum += map.find(key)->second;
+           sink = sum;
+         }));
+  report((label + ": find miss").c_str(), n, measureMs([&] {
+           std::uint64_t found = 0;
+           for (std::uint64_t key : misses) found += map.count(key);
+           sink = found;
+         }));
+  report((label + ": churn").c_str(), n, measureMs([&] {
+           for (std::size_t i = 0; i < n; i += 2) {
+             map.erase(keys[i]);
+             map.insert({misses[i], i});
+           }
+         }));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  using Tree = s21::Map<std::uint64_t, std::uint64_t>;
+  using Std = std::unordered_map<std::uint64_t, std::uint64_t>;
+  using Flat = s21::UnorderedMap<std::uint64_t, std::uint64_t>;
+  for (std::size_t n :
+       s21::bench::sizesFromArgs(argc, argv, {100000, 1000000})) {
+    std::vector<std::uint64_t> keys = makeKeys(n, 1);
+    std::vector<std::uint64_t> misses = makeKeys(n, 7);
+    for (auto &key : misses) key |= 1;
+    run<Tree>("Map", keys, misses, false);
+    run<Std>("std::unordered_map", keys, misses, false);
+    run<Std>("std::unordered_map", keys, misses, true);
+    run<Flat>("UnorderedMap", keys, misses, false);
+    run<Flat>("UnorderedMap", keys, misses, true);
+  }
+  return 0;
+}
@@ -66,6 +66,23 @@ size_type max_size() noexcept {
         return vector<value_type>::size();
 }
 
+// запись снимка (формат описан в SUPPORT_FUNCTIONS/snapshot.h)
+void save(int fd) const {
+    saveSnapshotBlock<value_type>(fd, SnapshotKind::kArray,
+                                  vector<value_type>::data(), N);
+}
+
+// чтение снимка: в нём должно быть ровно N элементов, иначе исключение
+void load(int fd) {
+    SnapshotReader reader = openSnapshot<value_type>(fd, SnapshotKind::kArray);
+    if (reader.count() != N) throw std::runtime_error(
+        "s21::snapshot: the number of elements does not match the array size");
+    array Temp;
+    readSnapshotElements(reader, Temp.data(), N);
+    reader.finish();
+    *this = std::move(Temp);
+}
+
 
 private:
 
@@ -0,0 +1 @@
+#include "s21_btree_map.h"
\ No newline at end of file
@@ -0,0 +1,144 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_btree_map.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-07-27
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_BTREE_MAP_H_
+#define CPP2_S21_CONTAINERS_BTREE_MAP_H_
+
+#include <vector>
+
+#include "../SUPPORT_FUNCTIONS/b_tree.h"
+
+namespace s21 {
+
+/**
+ * @brief Ordered map with unique keys stored in a B+ tree.
+ *
+ * Has the interface of Map, but keeps many key-value pairs per node, which
+ * makes lookups and in-order scans cache-friendly. Pairs are moved between
+ * nodes when the tree changes, so every insertion and erasure invalidates
+ * all iterators and references, and copying a key must not throw.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class BTreeMap {
+public:
+  // BTreeMap Member type:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using b_tree =
+      s21::BTree<Key, value_type, SelectFirst<Key>, Compare, Allocator>;
+  using iterator = typename b_tree::iterator;
+  using const_iterator = typename b_tree::const_iterator;
+  using reverse_iterator = typename b_tree::reverse_iterator;
+  using const_reverse_iterator = typename b_tree::const_reverse_iterator;
+
+  // BTreeMap Member functions:
+  BTreeMap();
+  explicit BTreeMap(const allocator_type &alloc);
+  BTreeMap(std::initializer_list<value_type> const &items);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  BTreeMap(InputIt first, InputIt last);
+  BTreeMap(const BTreeMap &m);
+  BTreeMap(BTreeMap &&m) noexcept;
+  ~BTreeMap();
+  BTreeMap &operator=(const BTreeMap &m);
+  BTreeMap &operator=(BTreeMap &&m) noexcept;
+  allocator_type get_allocator() const noexcept;
+
+  // BTreeMap Element access:
+  mapped_type &at(const key_type &key);
+  const mapped_type &at(const key_type &key) const;
+  mapped_type &operator[](const key_type &key);
+
+  // BTreeMap Iterators:
+  iterator begin() noexcept;
+  iterator end() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+  reverse_iterator rbegin() noexcept;
+  reverse_iterator rend() noexcept;
+  const_reverse_iterator rbegin() const noexcept;
+  const_reverse_iterator rend() const noexcept;
+
+  // BTreeMap Capacity:
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  size_type memory_usage() const noexcept; // байты узлов дерева
+
+  // BTreeMap Modifiers:
+  void clear() noexcept;
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  iterator insert(const_iterator hint, const value_type &value);
+  iterator insert(const_iterator hint, value_type &&value);
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &obj);
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <typename... Args>
+  std::vector<bool> insert_many(Args &&...args); // true - пара вставлена
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type &key); // возвращает число удалённых
+  void swap(BTreeMap &other) noexcept;
+  void merge(BTreeMap &other);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args);
+
+  // BTreeMap Lookup:
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  iterator find(const key_type &key);
+  const_iterator find(const key_type &key) const;
+  iterator lower_bound(const key_type &key);
+  const_iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key);
+  const_iterator upper_bound(const key_type &key) const;
+  std::pair<iterator, iterator> equal_range(const key_type &key);
+  std::pair<const_iterator, const_iterator>
+  equal_range(const key_type &key) const;
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  template <typename K, typename V, typename C, typename A, typename Pred>
+  friend typename BTreeMap<K, V, C, A>::size_type
+  erase_if(BTreeMap<K, V, C, A> &map, Pred pred);
+
+  b_tree tree_;
+};
+
+template <typename Key, typename Value, typename Compare, typename Allocator,
+          typename Pred>
+typename BTreeMap<Key, Value, Compare, Allocator>::size_type
+erase_if(BTreeMap<Key, Value, Compare, Allocator> &map, Pred pred);
+
+} // namespace s21
+
+#include "s21_btree_map.tpp"
+
+#endif // CPP2_S21_CONTAINERS_BTREE_MAP_H_
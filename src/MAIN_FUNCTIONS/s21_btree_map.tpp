@@ -0,0 +1,632 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_btree_map.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-07-27
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTreeMap<Key, Value, Compare, Allocator>::BTreeMap() : tree_() {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator used for all nodes of the BTreeMap.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTreeMap<Key, Value, Compare, Allocator>::BTreeMap(const allocator_type &alloc)
+    : tree_(alloc) {}
+
+/**
+ * @brief Constructor with initializer list.
+ * @param items Initializer list of value_type.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTreeMap<Key, Value, Compare, Allocator>::BTreeMap(
+    std::initializer_list<value_type> const &items)
+    : BTreeMap(items.begin(), items.end()) {}
+
+/**
+ * @brief Range constructor. Only the first pair with each key is stored.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+BTreeMap<Key, Value, Compare, Allocator>::BTreeMap(InputIt first,
+                                                   InputIt last)
+    : tree_() {
+  for (; first != last; ++first) {
+    this->tree_.insertHint(this->tree_.end(), *first, true);
+  }
+}
+
+/**
+ * @brief Copy constructor.
+ * @param m BTreeMap to copy.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTreeMap<Key, Value, Compare, Allocator>::BTreeMap(const BTreeMap &m)
+    : tree_(m.tree_) {}
+
+/**
+ * @brief Move constructor.
+ * @param m BTreeMap to move.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTreeMap<Key, Value, Compare, Allocator>::BTreeMap(BTreeMap &&m) noexcept
+    : tree_(std::move(m.tree_)) {}
+
+/**
+ * @brief Destructor.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTreeMap<Key, Value, Compare, Allocator>::~BTreeMap() = default;
+
+/**
+ * @brief Copy assignment operator.
+ * @param m BTreeMap to copy.
+ * @return Reference to this BTreeMap.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTreeMap<Key, Value, Compare, Allocator> &
+BTreeMap<Key, Value, Compare, Allocator>::operator=(const BTreeMap &m) {
+  this->tree_ = m.tree_;
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator.
+ * @param m BTreeMap to move.
+ * @return Reference to this BTreeMap.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+BTreeMap<Key, Value, Compare, Allocator> &
+BTreeMap<Key, Value, Compare, Allocator>::operator=(BTreeMap &&m) noexcept {
+  this->tree_ = std::move(m.tree_);
+  return *this;
+}
+
+/**
+ * @brief Returns the allocator associated with the BTreeMap.
+ * @return Copy of the allocator.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::allocator_type
+BTreeMap<Key, Value, Compare, Allocator>::get_allocator() const noexcept {
+  return this->tree_.get_allocator();
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+// BTreeMap Element access
+/**
+ * @brief Access specified element with bounds checking.
+ * @param key Key of the element to access.
+ * @return Reference to the mapped value.
+ * @throws std::out_of_range if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::mapped_type &
+BTreeMap<Key, Value, Compare, Allocator>::at(const key_type &key) {
+  return const_cast<mapped_type &>(
+      static_cast<const BTreeMap *>(this)->at(key));
+}
+
+/**
+ * @brief Access specified element with bounds checking.
+ * @param key Key of the element to access.
+ * @return Const reference to the mapped value.
+ * @throws std::out_of_range if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+const typename BTreeMap<Key, Value, Compare, Allocator>::mapped_type &
+BTreeMap<Key, Value, Compare, Allocator>::at(const key_type &key) const {
+  auto it = this->find(key);
+  if (it == this->end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+/**
+ * @brief Access or insert value.
+ *
+ * One descent of the tree: a value-initialized element is inserted only if
+ * the key is absent.
+ * @param key Key of the element to access.
+ * @return Reference to the mapped value.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::mapped_type &
+BTreeMap<Key, Value, Compare, Allocator>::operator[](const key_type &key) {
+  return try_emplace(key).first->second;
+}
+
+// BTreeMap Iterators
+/**
+ * @brief Returns an iterator to the beginning.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::iterator
+BTreeMap<Key, Value, Compare, Allocator>::begin() noexcept {
+  return this->tree_.begin();
+}
+
+/**
+ * @brief Returns an iterator to the end.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::iterator
+BTreeMap<Key, Value, Compare, Allocator>::end() noexcept {
+  return this->tree_.end();
+}
+
+/**
+ * @brief Returns a const iterator to the beginning.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::const_iterator
+BTreeMap<Key, Value, Compare, Allocator>::begin() const noexcept {
+  return this->tree_.begin();
+}
+
+/**
+ * @brief Returns a const iterator to the end.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::const_iterator
+BTreeMap<Key, Value, Compare, Allocator>::end() const noexcept {
+  return this->tree_.end();
+}
+
+/**
+ * @brief Returns a reverse iterator to the largest key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::reverse_iterator
+BTreeMap<Key, Value, Compare, Allocator>::rbegin() noexcept {
+  return reverse_iterator(end());
+}
+
+/**
+ * @brief Returns a reverse iterator past the smallest key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::reverse_iterator
+BTreeMap<Key, Value, Compare, Allocator>::rend() noexcept {
+  return reverse_iterator(begin());
+}
+
+/**
+ * @brief Returns a const reverse iterator to the largest key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::const_reverse_iterator
+BTreeMap<Key, Value, Compare, Allocator>::rbegin() const noexcept {
+  return const_reverse_iterator(end());
+}
+
+/**
+ * @brief Returns a const reverse iterator past the smallest key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::const_reverse_iterator
+BTreeMap<Key, Value, Compare, Allocator>::rend() const noexcept {
+  return const_reverse_iterator(begin());
+}
+
+// BTreeMap Capacity
+/**
+ * @brief Checks whether the container is empty.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool BTreeMap<Key, Value, Compare, Allocator>::empty() const noexcept {
+  return this->tree_.empty();
+}
+
+/**
+ * @brief Returns the number of elements.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::size_type
+BTreeMap<Key, Value, Compare, Allocator>::size() const noexcept {
+  return this->tree_.size();
+}
+
+/**
+ * @brief Returns the maximum possible number of elements.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::size_type
+BTreeMap<Key, Value, Compare, Allocator>::max_size() const noexcept {
+  return this->tree_.max_size();
+}
+
+/**
+ * @brief Returns the number of bytes taken by the nodes of the tree.
+ *
+ * Counts whole nodes, including their free slots; allocator overhead is not
+ * included.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::size_type
+BTreeMap<Key, Value, Compare, Allocator>::memory_usage() const noexcept {
+  return this->tree_.memoryUsage();
+}
+
+// BTreeMap Modifiers
+/**
+ * @brief Clears the contents.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void BTreeMap<Key, Value, Compare, Allocator>::clear() noexcept {
+  this->tree_.clear();
+}
+
+/**
+ * @brief Inserts a pair if its key is absent.
+ * @param value Pair to insert.
+ * @return Pair consisting of an iterator to the inserted element (or to the
+ * element that prevented the insertion) and a bool denoting whether the
+ * insertion took place.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename BTreeMap<Key, Value, Compare, Allocator>::iterator, bool>
+BTreeMap<Key, Value, Compare, Allocator>::insert(const value_type &value) {
+  return this->tree_.insert(value, true);
+}
+
+/**
+ * @brief Inserts a pair if its key is absent, moving it into the tree.
+ * @param value Pair to insert.
+ * @return Same as insert(const value_type &).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename BTreeMap<Key, Value, Compare, Allocator>::iterator, bool>
+BTreeMap<Key, Value, Compare, Allocator>::insert(value_type &&value) {
+  return this->tree_.insert(std::move(value), true);
+}
+
+/**
+ * @brief Inserts a pair as close as possible to the position before hint.
+ * @param hint Iterator to the position before which the pair should go.
+ * @param value Pair to insert.
+ * @return Iterator to the inserted element or to the one with the same key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::iterator
+BTreeMap<Key, Value, Compare, Allocator>::insert(const_iterator hint,
+                                                 const value_type &value) {
+  return this->tree_.insertHint(hint, value, true);
+}
+
+/**
+ * @brief Inserts a pair before hint, moving it into the tree.
+ * @param hint Iterator to the position before which the pair should go.
+ * @param value Pair to insert.
+ * @return Iterator to the inserted element or to the one with the same key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::iterator
+BTreeMap<Key, Value, Compare, Allocator>::insert(const_iterator hint,
+                                                 value_type &&value) {
+  return this->tree_.insertHint(hint, std::move(value), true);
+}
+
+/**
+ * @brief Inserts a pair built from key and obj if the key is absent.
+ * @param key Key of the element to insert.
+ * @param obj Value of the element to insert.
+ * @return Same as insert(const value_type &).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename BTreeMap<Key, Value, Compare, Allocator>::iterator, bool>
+BTreeMap<Key, Value, Compare, Allocator>::insert(const key_type &key,
+                                                 const mapped_type &obj) {
+  return try_emplace(key, obj);
+}
+
+/**
+ * @brief Inserts a pair or assigns obj if the key already exists.
+ * @param key Key of the element.
+ * @param obj Value to insert or assign.
+ * @return Iterator to the element and whether it was inserted.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename M>
+std::pair<typename BTreeMap<Key, Value, Compare, Allocator>::iterator, bool>
+BTreeMap<Key, Value, Compare, Allocator>::insert_or_assign(
+    const key_type &key, M &&obj) {
+  // tryEmplace не трогает obj, если ключ уже есть
+  auto result = this->tree_.tryEmplace(key, std::forward<M>(obj));
+  if (!result.second) {
+    result.first->second = std::forward<M>(obj);
+  }
+  return result;
+}
+
+/**
+ * @brief Inserts a pair with the value built from args if the key is absent.
+ *
+ * If the key already exists, nothing is constructed and args are not moved
+ * from.
+ * @param key Key of the element to insert.
+ * @param args Arguments forwarded to the constructor of the mapped value.
+ * @return Iterator to the element and whether it was inserted.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename BTreeMap<Key, Value, Compare, Allocator>::iterator, bool>
+BTreeMap<Key, Value, Compare, Allocator>::try_emplace(const key_type &key,
+                                                      Args &&...args) {
+  return this->tree_.tryEmplace(key, std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Inserts multiple pairs.
+ *
+ * Each insertion invalidates the iterators returned by the previous ones,
+ * so only the results are reported.
+ * @param args The pairs to insert.
+ * @return For each pair, whether it was inserted.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+std::vector<bool>
+BTreeMap<Key, Value, Compare, Allocator>::insert_many(Args &&...args) {
+  std::vector<bool> results;
+  (results.push_back(insert(std::forward<Args>(args)).second), ...);
+  return results;
+}
+
+/**
+ * @brief Erases an element.
+ * @param pos Iterator to the element to erase.
+ * @return Iterator to the element that followed the erased one.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::iterator
+BTreeMap<Key, Value, Compare, Allocator>::erase(const_iterator pos) {
+  return this->tree_.erase(pos);
+}
+
+/**
+ * @brief Erases the elements in [first, last).
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @return Iterator to the element that followed the erased range.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::iterator
+BTreeMap<Key, Value, Compare, Allocator>::erase(const_iterator first,
+                                                const_iterator last) {
+  return this->tree_.erase(first, last);
+}
+
+/**
+ * @brief Erases the element with the key.
+ * @param key Key of the element to erase.
+ * @return Number of erased elements (0 or 1).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::size_type
+BTreeMap<Key, Value, Compare, Allocator>::erase(const key_type &key) {
+  return this->tree_.eraseEqual(key);
+}
+
+/**
+ * @brief Swaps the contents.
+ * @param other BTreeMap to swap with.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void BTreeMap<Key, Value, Compare, Allocator>::swap(BTreeMap &other) noexcept {
+  this->tree_.swap(other.tree_);
+}
+
+/**
+ * @brief Moves the pairs of other whose keys are absent here into this map.
+ *
+ * B-tree elements live inside nodes, so the pairs are moved one by one.
+ * Pairs with keys that are already present stay in other.
+ * @param other BTreeMap to merge from.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void BTreeMap<Key, Value, Compare, Allocator>::merge(BTreeMap &other) {
+  if (this == &other) {
+    return;
+  }
+  for (auto it = other.tree_.begin(); it != other.tree_.end();) {
+    if (this->tree_.insert(std::move(*it), true).second) {
+      it = other.tree_.erase(it);
+    } else {
+      ++it; // пара не перемещена: insert не трогает её при совпадении
+    }
+  }
+}
+
+/**
+ * @brief Builds a pair from args and inserts it if its key is absent.
+ * @param args Arguments of the pair constructor.
+ * @return Same as insert(const value_type &).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename BTreeMap<Key, Value, Compare, Allocator>::iterator, bool>
+BTreeMap<Key, Value, Compare, Allocator>::emplace(Args &&...args) {
+  return this->tree_.emplace(true, std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Builds a pair from args and inserts it before hint if possible.
+ * @param hint Iterator to the position before which the pair should go.
+ * @param args Arguments of the pair constructor.
+ * @return Iterator to the inserted element or to the one with the same key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+typename BTreeMap<Key, Value, Compare, Allocator>::iterator
+BTreeMap<Key, Value, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                                       Args &&...args) {
+  return this->tree_.insertHint(hint, value_type(std::forward<Args>(args)...),
+                                true);
+}
+
+// BTreeMap Lookup
+/**
+ * @brief Checks if the container contains an element with the key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool BTreeMap<Key, Value, Compare, Allocator>::contains(
+    const key_type &key) const {
+  return this->tree_.find(key) != this->tree_.end();
+}
+
+/**
+ * @brief Returns the number of elements with the key (0 or 1).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::size_type
+BTreeMap<Key, Value, Compare, Allocator>::count(const key_type &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Finds the element with the key.
+ * @param key Key to search for.
+ * @return Iterator to the element, or end() if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::iterator
+BTreeMap<Key, Value, Compare, Allocator>::find(const key_type &key) {
+  return this->tree_.find(key);
+}
+
+/**
+ * @brief Finds the element with the key.
+ * @param key Key to search for.
+ * @return Const iterator to the element, or end() if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::const_iterator
+BTreeMap<Key, Value, Compare, Allocator>::find(const key_type &key) const {
+  return this->tree_.find(key);
+}
+
+/**
+ * @brief Returns an iterator to the first element with a key not less than
+ * key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::iterator
+BTreeMap<Key, Value, Compare, Allocator>::lower_bound(const key_type &key) {
+  return this->tree_.lower_bound(key);
+}
+
+/**
+ * @brief Returns a const iterator to the first element with a key not less
+ * than key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::const_iterator
+BTreeMap<Key, Value, Compare, Allocator>::lower_bound(
+    const key_type &key) const {
+  return this->tree_.lower_bound(key);
+}
+
+/**
+ * @brief Returns an iterator to the first element with a key greater than
+ * key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::iterator
+BTreeMap<Key, Value, Compare, Allocator>::upper_bound(const key_type &key) {
+  return this->tree_.upper_bound(key);
+}
+
+/**
+ * @brief Returns a const iterator to the first element with a key greater
+ * than key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename BTreeMap<Key, Value, Compare, Allocator>::const_iterator
+BTreeMap<Key, Value, Compare, Allocator>::upper_bound(
+    const key_type &key) const {
+  return this->tree_.upper_bound(key);
+}
+
+/**
+ * @brief Returns the range of elements with the key.
+ * @param key Key to search for.
+ * @return Pair of iterators: the element and the one after it, or two equal
+ * iterators if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename BTreeMap<Key, Value, Compare, Allocator>::iterator,
+          typename BTreeMap<Key, Value, Compare, Allocator>::iterator>
+BTreeMap<Key, Value, Compare, Allocator>::equal_range(const key_type &key) {
+  return {this->tree_.lower_bound(key), this->tree_.upper_bound(key)};
+}
+
+/**
+ * @brief Returns the range of elements with the key.
+ * @param key Key to search for.
+ * @return Pair of const iterators bounding the element with the key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename BTreeMap<Key, Value, Compare, Allocator>::const_iterator,
+          typename BTreeMap<Key, Value, Compare, Allocator>::const_iterator>
+BTreeMap<Key, Value, Compare, Allocator>::equal_range(
+    const key_type &key) const {
+  return {this->tree_.lower_bound(key), this->tree_.upper_bound(key)};
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks the structure of the B-tree (see BTree::checkInvariants).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool BTreeMap<Key, Value, Compare, Allocator>::checkInvariants() const {
+  return this->tree_.checkInvariants();
+}
+
+/******************************************************************************
+ * NON-MEMBER FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * @brief Erases all elements that satisfy pred.
+ *
+ * @param map The container to erase from.
+ * @param pred Predicate called once for every element in key order.
+ * @return size_type Number of erased elements.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator,
+          typename Pred>
+typename BTreeMap<Key, Value, Compare, Allocator>::size_type
+erase_if(BTreeMap<Key, Value, Compare, Allocator> &map, Pred pred) {
+  return map.tree_.eraseIf(pred);
+}
+
+} // namespace s21
@@ -0,0 +1,121 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_btree_multiset.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-07-27
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_BTREE_MULTISET_H_
+#define CPP2_S21_CONTAINERS_BTREE_MULTISET_H_
+
+#include "../SUPPORT_FUNCTIONS/b_tree.h"
+
+namespace s21 {
+
+/**
+ * @brief Ordered multiset stored in a B+ tree.
+ *
+ * Has the interface of MultiSet, but keeps up to a few dozen keys per node, so
+ * lookups and in-order scans touch far fewer cache lines and the memory
+ * overhead per key is a fraction of a red-black tree node. Unlike MultiSet,
+ * every insertion and erasure invalidates all iterators.
+ */
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class BTreeMultiSet {
+public:
+  // BTreeMultiSet Member type:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using b_tree =
+      s21::BTree<Key, Key, Identity<Key>, Compare, Allocator>;
+  // ключи множества неизменяемы: оба итератора константные
+  using iterator = typename b_tree::const_iterator;
+  using const_iterator = typename b_tree::const_iterator;
+  using reverse_iterator = typename b_tree::const_reverse_iterator;
+  using const_reverse_iterator = typename b_tree::const_reverse_iterator;
+
+  // BTreeMultiSet Member functions:
+  BTreeMultiSet();
+  explicit BTreeMultiSet(const allocator_type &alloc);
+  BTreeMultiSet(std::initializer_list<value_type> const &items);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  BTreeMultiSet(InputIt first, InputIt last);
+  BTreeMultiSet(const BTreeMultiSet &s);
+  BTreeMultiSet(BTreeMultiSet &&s) noexcept;
+  ~BTreeMultiSet();
+  BTreeMultiSet &operator=(const BTreeMultiSet &s);
+  BTreeMultiSet &operator=(BTreeMultiSet &&s) noexcept;
+  allocator_type get_allocator() const noexcept;
+
+  // BTreeMultiSet Iterators:
+  iterator begin() const noexcept;
+  iterator end() const noexcept;
+  reverse_iterator rbegin() const noexcept;
+  reverse_iterator rend() const noexcept;
+
+  // BTreeMultiSet Capacity:
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  size_type memory_usage() const noexcept; // байты узлов дерева
+
+  // BTreeMultiSet Modifiers:
+  void clear() noexcept;
+  iterator insert(const value_type &value);
+  iterator insert(value_type &&value);
+  iterator insert(const_iterator hint, const value_type &value);
+  iterator insert(const_iterator hint, value_type &&value);
+  template <typename... Args>
+  void insert_many(Args &&...args);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type &key); // возвращает число удалённых
+  void swap(BTreeMultiSet &other) noexcept;
+  void merge(BTreeMultiSet &other);
+  template <typename... Args>
+  iterator emplace(Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args);
+
+  // BTreeMultiSet Lookup:
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  iterator find(const key_type &key) const;
+  iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key) const;
+  std::pair<iterator, iterator> equal_range(const key_type &key) const;
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  template <typename K, typename C, typename A, typename Pred>
+  friend typename BTreeMultiSet<K, C, A>::size_type
+  erase_if(BTreeMultiSet<K, C, A> &set, Pred pred);
+
+  b_tree tree_;
+};
+
+template <typename Key, typename Compare, typename Allocator, typename Pred>
+typename BTreeMultiSet<Key, Compare, Allocator>::size_type
+erase_if(BTreeMultiSet<Key, Compare, Allocator> &set, Pred pred);
+
+} // namespace s21
+
+#include "s21_btree_multiset.tpp"
+
+#endif // CPP2_S21_CONTAINERS_BTREE_MULTISET_H_
@@ -0,0 +1,453 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_btree_multiset.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-07-27
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor.
+ */
+template <typename Key, typename Compare, typename Allocator>
+BTreeMultiSet<Key, Compare, Allocator>::BTreeMultiSet() : tree_() {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator used for all nodes of the BTreeMultiSet.
+ */
+template <typename Key, typename Compare, typename Allocator>
+BTreeMultiSet<Key, Compare, Allocator>::BTreeMultiSet(
+    const allocator_type &alloc)
+    : tree_(alloc) {}
+
+/**
+ * @brief Constructor with initializer list.
+ * @param items Initializer list of value_type.
+ */
+template <typename Key, typename Compare, typename Allocator>
+BTreeMultiSet<Key, Compare, Allocator>::BTreeMultiSet(
+    std::initializer_list<value_type> const &items)
+    : BTreeMultiSet(items.begin(), items.end()) {}
+
+/**
+ * @brief Range constructor. All keys are stored, equivalent ones in the
+ * order of the range.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+BTreeMultiSet<Key, Compare, Allocator>::BTreeMultiSet(InputIt first,
+                                                      InputIt last)
+    : tree_() {
+  for (; first != last; ++first) {
+    this->tree_.insertHint(this->tree_.end(), *first, false);
+  }
+}
+
+/**
+ * @brief Copy constructor.
+ * @param s BTreeMultiSet to copy.
+ */
+template <typename Key, typename Compare, typename Allocator>
+BTreeMultiSet<Key, Compare, Allocator>::BTreeMultiSet(const BTreeMultiSet &s)
+    : tree_(s.tree_) {}
+
+/**
+ * @brief Move constructor.
+ * @param s BTreeMultiSet to move.
+ */
+template <typename Key, typename Compare, typename Allocator>
+BTreeMultiSet<Key, Compare, Allocator>::BTreeMultiSet(
+    BTreeMultiSet &&s) noexcept
+    : tree_(std::move(s.tree_)) {}
+
+/**
+ * @brief Destructor.
+ */
+template <typename Key, typename Compare, typename Allocator>
+BTreeMultiSet<Key, Compare, Allocator>::~BTreeMultiSet() = default;
+
+/**
+ * @brief Copy assignment operator.
+ * @param s BTreeMultiSet to copy.
+ * @return Reference to this BTreeMultiSet.
+ */
+template <typename Key, typename Compare, typename Allocator>
+BTreeMultiSet<Key, Compare, Allocator> &
+BTreeMultiSet<Key, Compare, Allocator>::operator=(const BTreeMultiSet &s) {
+  this->tree_ = s.tree_;
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator.
+ * @param s BTreeMultiSet to move.
+ * @return Reference to this BTreeMultiSet.
+ */
+template <typename Key, typename Compare, typename Allocator>
+BTreeMultiSet<Key, Compare, Allocator> &
+BTreeMultiSet<Key, Compare, Allocator>::operator=(BTreeMultiSet &&s) noexcept {
+  this->tree_ = std::move(s.tree_);
+  return *this;
+}
+
+/**
+ * @brief Returns the allocator associated with the BTreeMultiSet.
+ * @return Copy of the allocator.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::allocator_type
+BTreeMultiSet<Key, Compare, Allocator>::get_allocator() const noexcept {
+  return this->tree_.get_allocator();
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+// BTreeMultiSet Iterators
+/**
+ * @brief Returns an iterator to the beginning.
+ * @return Iterator to the smallest key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::iterator
+BTreeMultiSet<Key, Compare, Allocator>::begin() const noexcept {
+  return this->tree_.begin();
+}
+
+/**
+ * @brief Returns an iterator to the end.
+ * @return Iterator past the largest key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::iterator
+BTreeMultiSet<Key, Compare, Allocator>::end() const noexcept {
+  return this->tree_.end();
+}
+
+/**
+ * @brief Returns a reverse iterator to the largest key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::reverse_iterator
+BTreeMultiSet<Key, Compare, Allocator>::rbegin() const noexcept {
+  return reverse_iterator(end());
+}
+
+/**
+ * @brief Returns a reverse iterator past the smallest key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::reverse_iterator
+BTreeMultiSet<Key, Compare, Allocator>::rend() const noexcept {
+  return reverse_iterator(begin());
+}
+
+// BTreeMultiSet Capacity
+/**
+ * @brief Checks whether the container is empty.
+ */
+template <typename Key, typename Compare, typename Allocator>
+bool BTreeMultiSet<Key, Compare, Allocator>::empty() const noexcept {
+  return this->tree_.empty();
+}
+
+/**
+ * @brief Returns the number of elements.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::size_type
+BTreeMultiSet<Key, Compare, Allocator>::size() const noexcept {
+  return this->tree_.size();
+}
+
+/**
+ * @brief Returns the maximum possible number of elements.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::size_type
+BTreeMultiSet<Key, Compare, Allocator>::max_size() const noexcept {
+  return this->tree_.max_size();
+}
+
+/**
+ * @brief Returns the number of bytes taken by the nodes of the tree.
+ *
+ * Counts whole nodes, including their free slots; allocator overhead is not
+ * included.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::size_type
+BTreeMultiSet<Key, Compare, Allocator>::memory_usage() const noexcept {
+  return this->tree_.memoryUsage();
+}
+
+// BTreeMultiSet Modifiers
+/**
+ * @brief Clears the contents.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void BTreeMultiSet<Key, Compare, Allocator>::clear() noexcept {
+  this->tree_.clear();
+}
+
+/**
+ * @brief Inserts a key after all equivalent ones.
+ * @param value Key to insert.
+ * @return Iterator to the inserted key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::iterator
+BTreeMultiSet<Key, Compare, Allocator>::insert(const value_type &value) {
+  return this->tree_.insert(value, false).first;
+}
+
+/**
+ * @brief Inserts a key after all equivalent ones, moving it into the tree.
+ * @param value Key to insert.
+ * @return Iterator to the inserted key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::iterator
+BTreeMultiSet<Key, Compare, Allocator>::insert(value_type &&value) {
+  return this->tree_.insert(std::move(value), false).first;
+}
+
+/**
+ * @brief Inserts a key as close as possible to the position before hint.
+ *
+ * If the key belongs right before hint in the same leaf, it is inserted
+ * without a search from the root.
+ * @param hint Iterator to the position before which the key should go.
+ * @param value Key to insert.
+ * @return Iterator to the inserted key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::iterator
+BTreeMultiSet<Key, Compare, Allocator>::insert(const_iterator hint,
+                                               const value_type &value) {
+  return this->tree_.insertHint(hint, value, false);
+}
+
+/**
+ * @brief Inserts a key before hint, moving it into the tree.
+ * @param hint Iterator to the position before which the key should go.
+ * @param value Key to insert.
+ * @return Iterator to the inserted key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::iterator
+BTreeMultiSet<Key, Compare, Allocator>::insert(const_iterator hint,
+                                               value_type &&value) {
+  return this->tree_.insertHint(hint, std::move(value), false);
+}
+
+/**
+ * @brief Inserts multiple keys.
+ *
+ * Each insertion invalidates the iterators returned by the previous ones,
+ * so nothing is returned: every key is inserted.
+ * @param args The keys to insert.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+void BTreeMultiSet<Key, Compare, Allocator>::insert_many(Args &&...args) {
+  (insert(std::forward<Args>(args)), ...);
+}
+
+/**
+ * @brief Erases a key.
+ * @param pos Iterator to the key to erase.
+ * @return Iterator to the key that followed the erased one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::iterator
+BTreeMultiSet<Key, Compare, Allocator>::erase(const_iterator pos) {
+  return this->tree_.erase(pos);
+}
+
+/**
+ * @brief Erases the keys in [first, last).
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @return Iterator to the key that followed the erased range.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::iterator
+BTreeMultiSet<Key, Compare, Allocator>::erase(const_iterator first,
+                                              const_iterator last) {
+  return this->tree_.erase(first, last);
+}
+
+/**
+ * @brief Erases all keys equivalent to key.
+ * @param key Key to erase.
+ * @return Number of erased keys.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::size_type
+BTreeMultiSet<Key, Compare, Allocator>::erase(const key_type &key) {
+  return this->tree_.eraseEqual(key);
+}
+
+/**
+ * @brief Swaps the contents.
+ * @param other BTreeMultiSet to swap with.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void BTreeMultiSet<Key, Compare, Allocator>::swap(
+    BTreeMultiSet &other) noexcept {
+  this->tree_.swap(other.tree_);
+}
+
+/**
+ * @brief Moves all keys of other into this multiset.
+ *
+ * B-tree elements live inside nodes, so the keys are moved one by one;
+ * other is left empty.
+ * @param other BTreeMultiSet to merge from.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void BTreeMultiSet<Key, Compare, Allocator>::merge(BTreeMultiSet &other) {
+  if (this == &other) {
+    return;
+  }
+  for (auto it = other.tree_.begin(); it != other.tree_.end(); ++it) {
+    this->tree_.insert(std::move(*it), false);
+  }
+  other.clear();
+}
+
+/**
+ * @brief Builds a key from args and inserts it after equivalent ones.
+ * @param args Arguments of the key constructor.
+ * @return Iterator to the inserted key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename BTreeMultiSet<Key, Compare, Allocator>::iterator
+BTreeMultiSet<Key, Compare, Allocator>::emplace(Args &&...args) {
+  return this->tree_.emplace(false, std::forward<Args>(args)...).first;
+}
+
+/**
+ * @brief Builds a key from args and inserts it before hint if possible.
+ * @param hint Iterator to the position before which the key should go.
+ * @param args Arguments of the key constructor.
+ * @return Iterator to the inserted key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename BTreeMultiSet<Key, Compare, Allocator>::iterator
+BTreeMultiSet<Key, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                                     Args &&...args) {
+  return this->tree_.insertHint(hint, value_type(std::forward<Args>(args)...),
+                                false);
+}
+
+// BTreeMultiSet Lookup
+/**
+ * @brief Checks if the container contains key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+bool BTreeMultiSet<Key, Compare, Allocator>::contains(
+    const key_type &key) const {
+  return this->tree_.find(key) != this->tree_.end();
+}
+
+/**
+ * @brief Returns the number of keys equivalent to key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::size_type
+BTreeMultiSet<Key, Compare, Allocator>::count(const key_type &key) const {
+  return this->tree_.count(key);
+}
+
+/**
+ * @brief Finds a key.
+ * @param key Key to search for.
+ * @return Iterator to the first equivalent key, or end() if it is absent.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::iterator
+BTreeMultiSet<Key, Compare, Allocator>::find(const key_type &key) const {
+  return this->tree_.find(key);
+}
+
+/**
+ * @brief Returns an iterator to the first key not less than key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::iterator
+BTreeMultiSet<Key, Compare, Allocator>::lower_bound(const key_type &key) const {
+  return this->tree_.lower_bound(key);
+}
+
+/**
+ * @brief Returns an iterator to the first key greater than key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename BTreeMultiSet<Key, Compare, Allocator>::iterator
+BTreeMultiSet<Key, Compare, Allocator>::upper_bound(const key_type &key) const {
+  return this->tree_.upper_bound(key);
+}
+
+/**
+ * @brief Returns the range of keys equivalent to key.
+ * @param key Key to search for.
+ * @return Pair of iterators bounding the equivalent keys.
+ */
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename BTreeMultiSet<Key, Compare, Allocator>::iterator,
+          typename BTreeMultiSet<Key, Compare, Allocator>::iterator>
+BTreeMultiSet<Key, Compare, Allocator>::equal_range(const key_type &key) const {
+  return {this->tree_.lower_bound(key), this->tree_.upper_bound(key)};
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks the structure of the B-tree (see BTree::checkInvariants).
+ */
+template <typename Key, typename Compare, typename Allocator>
+bool BTreeMultiSet<Key, Compare, Allocator>::checkInvariants() const {
+  return this->tree_.checkInvariants();
+}
+
+/******************************************************************************
+ * NON-MEMBER FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * @brief Erases all keys that satisfy pred, O(n log n) in the worst case.
+ *
+ * @param set The container to erase from.
+ * @param pred Predicate called once for every key in key order.
+ * @return size_type Number of erased elements.
+ */
+template <typename Key, typename Compare, typename Allocator, typename Pred>
+typename BTreeMultiSet<Key, Compare, Allocator>::size_type
+erase_if(BTreeMultiSet<Key, Compare, Allocator> &set, Pred pred) {
+  return set.tree_.eraseIf(pred);
+}
+
+} // namespace s21
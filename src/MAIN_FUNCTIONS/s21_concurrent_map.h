@@ -0,0 +1,136 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_concurrent_map.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-10
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_CONCURRENT_MAP_H_
+#define CPP2_S21_CONTAINERS_CONCURRENT_MAP_H_
+
+#include <array>
+#include <cstdint>
+#include <functional> // std::hash
+#include <mutex>      // std::unique_lock
+#include <optional>
+#include <shared_mutex>
+#include <utility> // std::index_sequence
+
+#include "s21_map.h"
+
+// Выравнивание шарда: мьютексы соседних шардов не делят кэш-линию
+#ifndef S21_CONCURRENT_MAP_ALIGN
+#define S21_CONCURRENT_MAP_ALIGN 64
+#endif
+
+namespace s21 {
+
+/**
+ * @brief Thread-safe map with unique keys, split into Shards independently
+ * locked Map shards.
+ *
+ * A key always lives in the shard chosen by its hash, so operations on keys
+ * of different shards do not wait for each other. Every shard has its own
+ * std::shared_mutex: lookups take it shared, modifications exclusive.
+ *
+ * The interface has no iterators and returns no references: an element may
+ * be changed or erased by another thread as soon as the shard is unlocked.
+ * Values are read as copies (find) or inside a callback that runs under the
+ * shard lock (visit, modify, for_each); a callback must not call methods of
+ * the same ConcurrentMap.
+ *
+ * @tparam Key Type of the keys.
+ * @tparam Value Type of the mapped values.
+ * @tparam Shards Number of shards, usually a few times the number of
+ * threads.
+ * @tparam Hash Hash of keys that chooses the shard.
+ * @tparam Compare Order of keys inside a shard.
+ * @tparam Allocator Allocator of the shards.
+ */
+template <typename Key, typename Value, std::size_t Shards = 16,
+          typename Hash = std::hash<Key>, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class ConcurrentMap {
+public:
+  static_assert(Shards > 0, "ConcurrentMap needs at least one shard");
+
+  // ConcurrentMap Member type:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using shard_map = s21::Map<Key, Value, Compare, Allocator>;
+
+  // ConcurrentMap Member functions:
+  ConcurrentMap();
+  explicit ConcurrentMap(const allocator_type &alloc,
+                         const hasher &hash = hasher());
+  ConcurrentMap(std::initializer_list<value_type> const &items);
+  ConcurrentMap(const ConcurrentMap &) = delete;
+  ConcurrentMap &operator=(const ConcurrentMap &) = delete;
+  ~ConcurrentMap();
+
+  // ConcurrentMap Capacity:
+  bool empty() const;
+  size_type size() const; // сумма по шардам, каждый читается отдельно
+  static constexpr size_type shard_count() noexcept { return Shards; }
+
+  // ConcurrentMap Modifiers:
+  void clear();
+  bool insert(const value_type &value);
+  bool insert(value_type &&value);
+  bool insert(const key_type &key, const mapped_type &obj);
+  template <typename M> bool insert_or_assign(const key_type &key, M &&obj);
+  template <typename... Args>
+  bool try_emplace(const key_type &key, Args &&...args);
+  size_type erase(const key_type &key); // возвращает число удалённых
+  template <typename Fn> bool modify(const key_type &key, Fn &&fn);
+
+  // ConcurrentMap Lookup:
+  std::optional<mapped_type> find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  template <typename Fn> bool visit(const key_type &key, Fn &&fn) const;
+  template <typename Fn> void for_each(Fn &&fn) const;
+
+  // Conversion:
+  shard_map to_map() const;
+
+private:
+  using read_lock = std::shared_lock<std::shared_mutex>;
+  using write_lock = std::unique_lock<std::shared_mutex>;
+
+  // шард: дерево и его мьютекс в отдельных кэш-линиях от соседей
+  struct alignas(S21_CONCURRENT_MAP_ALIGN) Shard {
+    explicit Shard(const allocator_type &alloc) : map(alloc) {}
+
+    mutable std::shared_mutex mutex;
+    shard_map map;
+  };
+
+  template <std::size_t... I>
+  ConcurrentMap(const allocator_type &alloc, const hasher &hash,
+                std::index_sequence<I...>);
+
+  Shard &shardOf(const key_type &key);
+  const Shard &shardOf(const key_type &key) const;
+
+  std::array<Shard, Shards> shards_;
+  hasher hash_;
+};
+
+} // namespace s21
+
+#include "s21_concurrent_map.tpp"
+
+#endif // CPP2_S21_CONTAINERS_CONCURRENT_MAP_H_
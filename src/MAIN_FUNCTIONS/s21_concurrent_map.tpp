@@ -0,0 +1,379 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_concurrent_map.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-10
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor. Creates Shards empty shards.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::ConcurrentMap()
+    : ConcurrentMap(allocator_type()) {}
+
+/**
+ * @brief Constructor with an allocator and a hash of keys.
+ * @param alloc Allocator copied into every shard.
+ * @param hash Hash of keys that chooses the shard.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::ConcurrentMap(
+    const allocator_type &alloc, const hasher &hash)
+    : ConcurrentMap(alloc, hash, std::make_index_sequence<Shards>()) {}
+
+/**
+ * @brief Builds every shard in place: Shard holds a mutex and can be neither
+ * copied nor moved.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+template <std::size_t... I>
+ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::ConcurrentMap(
+    const allocator_type &alloc, const hasher &hash, std::index_sequence<I...>)
+    : shards_{{((void)I, Shard(alloc))...}}, hash_(hash) {}
+
+/**
+ * @brief Constructor with initializer list. Repeated keys keep the first
+ * value.
+ * @param items Initializer list of value_type.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::ConcurrentMap(
+    std::initializer_list<value_type> const &items)
+    : ConcurrentMap() {
+  for (const value_type &item : items) {
+    insert(item);
+  }
+}
+
+/**
+ * @brief Destructor. Must not run while other threads use the map.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::~ConcurrentMap() =
+    default;
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+// ConcurrentMap Capacity
+/**
+ * @brief Checks whether every shard is empty.
+ *
+ * The shards are checked one by one, so under concurrent modifications the
+ * answer describes no single moment.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+bool ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::empty()
+    const {
+  for (const Shard &shard : this->shards_) {
+    read_lock lock(shard.mutex);
+    if (!shard.map.empty()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Returns the number of elements, summed shard by shard.
+ *
+ * Exact when no other thread modifies the map; otherwise each shard is
+ * counted at its own moment.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+typename ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::size_type
+ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::size() const {
+  size_type total = 0;
+  for (const Shard &shard : this->shards_) {
+    read_lock lock(shard.mutex);
+    total += shard.map.size();
+  }
+  return total;
+}
+
+// ConcurrentMap Modifiers
+/**
+ * @brief Erases all elements, locking one shard at a time.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+void ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::clear() {
+  for (Shard &shard : this->shards_) {
+    write_lock lock(shard.mutex);
+    shard.map.clear();
+  }
+}
+
+/**
+ * @brief Inserts an element if its key is absent.
+ * @param value Element to insert.
+ * @return true if the element was inserted.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+bool ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::insert(
+    const value_type &value) {
+  Shard &shard = shardOf(value.first);
+  write_lock lock(shard.mutex);
+  return shard.map.insert(value).second;
+}
+
+/**
+ * @brief Inserts an element if its key is absent, moving it into the shard.
+ * @param value Element to insert.
+ * @return true if the element was inserted.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+bool ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::insert(
+    value_type &&value) {
+  Shard &shard = shardOf(value.first);
+  write_lock lock(shard.mutex);
+  return shard.map.insert(std::move(value)).second;
+}
+
+/**
+ * @brief Inserts a key with a value if the key is absent.
+ * @param key Key of the element.
+ * @param obj Value of the element.
+ * @return true if the element was inserted.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+bool ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::insert(
+    const key_type &key, const mapped_type &obj) {
+  Shard &shard = shardOf(key);
+  write_lock lock(shard.mutex);
+  return shard.map.insert(key, obj).second;
+}
+
+/**
+ * @brief Inserts a key with a value, or assigns the value if the key is
+ * present.
+ * @param key Key of the element.
+ * @param obj Value to insert or assign.
+ * @return true if the element was inserted, false if it was assigned.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+template <typename M>
+bool ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::
+    insert_or_assign(const key_type &key, M &&obj) {
+  Shard &shard = shardOf(key);
+  write_lock lock(shard.mutex);
+  return shard.map.insert_or_assign(key, std::forward<M>(obj)).second;
+}
+
+/**
+ * @brief Builds the value from args and inserts it if the key is absent;
+ * otherwise args are not used.
+ * @param key Key of the element.
+ * @param args Arguments of the value constructor.
+ * @return true if the element was inserted.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+template <typename... Args>
+bool ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::try_emplace(
+    const key_type &key, Args &&...args) {
+  Shard &shard = shardOf(key);
+  write_lock lock(shard.mutex);
+  return shard.map.try_emplace(key, std::forward<Args>(args)...).second;
+}
+
+/**
+ * @brief Erases the element with the key.
+ * @param key Key to erase.
+ * @return Number of erased elements (0 or 1).
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+typename ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::size_type
+ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::erase(
+    const key_type &key) {
+  Shard &shard = shardOf(key);
+  write_lock lock(shard.mutex);
+  return shard.map.erase(key);
+}
+
+/**
+ * @brief Calls fn(value) for the value of the key under the exclusive lock
+ * of its shard.
+ *
+ * Use it for read-modify-write updates (counters, appends) that must not
+ * interleave with other writers of the same key.
+ * @param key Key of the element.
+ * @param fn Callable taking mapped_type &; must not use this map.
+ * @return true if the key was found and fn was called.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+template <typename Fn>
+bool ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::modify(
+    const key_type &key, Fn &&fn) {
+  Shard &shard = shardOf(key);
+  write_lock lock(shard.mutex);
+  auto it = shard.map.find(key);
+  if (it == shard.map.end()) {
+    return false;
+  }
+  std::forward<Fn>(fn)(it->second);
+  return true;
+}
+
+// ConcurrentMap Lookup
+/**
+ * @brief Returns a copy of the value of the key.
+ * @param key Key to search for.
+ * @return The value, or std::nullopt if the key is absent.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+std::optional<Value>
+ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::find(
+    const key_type &key) const {
+  const Shard &shard = shardOf(key);
+  read_lock lock(shard.mutex);
+  auto it = shard.map.find(key);
+  if (it == shard.map.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+/**
+ * @brief Checks if the map contains the key.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+bool ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::contains(
+    const key_type &key) const {
+  const Shard &shard = shardOf(key);
+  read_lock lock(shard.mutex);
+  return shard.map.contains(key);
+}
+
+/**
+ * @brief Calls fn(value) for the value of the key under the shared lock of
+ * its shard, without copying the value.
+ * @param key Key of the element.
+ * @param fn Callable taking const mapped_type &; must not use this map.
+ * @return true if the key was found and fn was called.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+template <typename Fn>
+bool ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::visit(
+    const key_type &key, Fn &&fn) const {
+  const Shard &shard = shardOf(key);
+  read_lock lock(shard.mutex);
+  auto it = shard.map.find(key);
+  if (it == shard.map.end()) {
+    return false;
+  }
+  std::forward<Fn>(fn)(static_cast<const mapped_type &>(it->second));
+  return true;
+}
+
+/**
+ * @brief Calls fn(key, value) for every element.
+ *
+ * The shards are visited one by one, each under its shared lock, and in key
+ * order inside a shard. Elements changed in an already visited shard are not
+ * seen again, so the walk is not a snapshot of the whole map.
+ * @param fn Callable taking (const key_type &, const mapped_type &); must
+ * not use this map.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+template <typename Fn>
+void ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::for_each(
+    Fn &&fn) const {
+  for (const Shard &shard : this->shards_) {
+    read_lock lock(shard.mutex);
+    for (auto it = shard.map.begin(); it != shard.map.end(); ++it) {
+      fn(static_cast<const key_type &>(it->first),
+         static_cast<const mapped_type &>(it->second));
+    }
+  }
+}
+
+// Conversion
+/**
+ * @brief Copies all elements into an ordinary Map.
+ *
+ * Every shard is copied under its shared lock; see for_each for the
+ * consistency of the result.
+ * @return Map with the elements of all shards and the allocator of the
+ * shards.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+typename ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::shard_map
+ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::to_map() const {
+  // аллокатор шарда задан при создании и не меняется - блокировка не нужна
+  shard_map result(this->shards_[0].map.get_allocator());
+  for (const Shard &shard : this->shards_) {
+    read_lock lock(shard.mutex);
+    for (auto it = shard.map.begin(); it != shard.map.end(); ++it) {
+      result.insert(*it);
+    }
+  }
+  return result;
+}
+
+/******************************************************************************
+ * SUPPORT METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Returns the shard of the key.
+ *
+ * The hash is mixed before taking the remainder: std::hash of integers is
+ * the identity, and keys with a common stride would otherwise pile up in a
+ * few shards.
+ */
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+typename ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::Shard &
+ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::shardOf(
+    const key_type &key) {
+  const ConcurrentMap &self = *this;
+  return const_cast<Shard &>(self.shardOf(key));
+}
+
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+const typename ConcurrentMap<Key, Value, Shards, Hash, Compare,
+                             Allocator>::Shard &
+ConcurrentMap<Key, Value, Shards, Hash, Compare, Allocator>::shardOf(
+    const key_type &key) const {
+  std::uint64_t h = static_cast<std::uint64_t>(this->hash_(key));
+  h *= 0x9E3779B97F4A7C15ULL;
+  return this->shards_[static_cast<std::size_t>(h >> 32) % Shards];
+}
+
+} // namespace s21
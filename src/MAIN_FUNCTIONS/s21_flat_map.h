@@ -0,0 +1,301 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_flat_map.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-07-27
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_FLAT_MAP_H_
+#define CPP2_S21_CONTAINERS_FLAT_MAP_H_
+
+#include <vector>
+
+#include "s21_map.h"
+#include "../SUPPORT_FUNCTIONS/flat_tree.h"
+
+namespace s21 {
+
+/**
+ * @brief Ordered map with unique keys stored as a sorted s21::vector of
+ * pairs.
+ *
+ * Has the interface of Map and is meant for read-mostly lookup tables:
+ * lookups are binary searches over one contiguous array and the container
+ * spends no memory per pair beyond the pair itself. A single insertion or
+ * erasure shifts the tail of the array, so batches should go through
+ * insert(first, last), which sorts and merges them once. Every insertion
+ * invalidates all iterators.
+ *
+ * Pairs are moved inside the array, so the stored value_type is
+ * std::pair<Key, Value> with a non-constant key. Iterators do not expose
+ * it: dereferencing gives a pair of references with a constant key, as in
+ * std::flat_map, so only the mapped value can be changed in place.
+ *
+ * A Map is converted to a FlatMap and back in O(n): both are already in
+ * key order, nothing is sorted again.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<Key, Value>>>
+class FlatMap {
+public:
+  // FlatMap Member type:
+  using key_type = Key;
+  using mapped_type = Value;
+  // ключ не константный: пары сдвигаются внутри массива
+  using value_type = std::pair<key_type, mapped_type>;
+  // итераторы отдают пару ссылок с константным ключом
+  using reference = std::pair<const key_type &, mapped_type &>;
+  using const_reference = std::pair<const key_type &, const mapped_type &>;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using flat_tree =
+      s21::FlatTree<Key, value_type, SelectFirst<Key>, Compare, Allocator>;
+
+  template <bool IsConst> class FlatMapIterator;
+  using iterator = FlatMapIterator<false>;
+  using const_iterator = FlatMapIterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  // FlatMap Member functions:
+  FlatMap();
+  explicit FlatMap(const allocator_type &alloc);
+  FlatMap(std::initializer_list<value_type> const &items);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  FlatMap(InputIt first, InputIt last);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  FlatMap(sorted_unique_t, InputIt first, InputIt last);
+  template <typename MapAllocator>
+  explicit FlatMap(const Map<Key, Value, Compare, MapAllocator> &map,
+                   const allocator_type &alloc = allocator_type());
+  FlatMap(const FlatMap &m);
+  FlatMap(FlatMap &&m) noexcept;
+  ~FlatMap();
+  FlatMap &operator=(const FlatMap &m);
+  FlatMap &operator=(FlatMap &&m) noexcept;
+  allocator_type get_allocator() const noexcept;
+
+  // FlatMap Conversion:
+  template <typename MapAllocator =
+                std::allocator<std::pair<const Key, Value>>>
+  Map<Key, Value, Compare, MapAllocator>
+  to_map(const MapAllocator &alloc = MapAllocator()) const;
+
+  // FlatMap Element access:
+  mapped_type &at(const key_type &key);
+  const mapped_type &at(const key_type &key) const;
+  mapped_type &operator[](const key_type &key);
+
+  // FlatMap Iterators:
+  iterator begin() noexcept;
+  iterator end() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+  reverse_iterator rbegin() noexcept;
+  reverse_iterator rend() noexcept;
+  const_reverse_iterator rbegin() const noexcept;
+  const_reverse_iterator rend() const noexcept;
+
+  // FlatMap Capacity:
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  size_type capacity() const noexcept;
+  void reserve(size_type count);
+  void shrink_to_fit();
+  size_type memory_usage() const noexcept; // байты массива пар
+
+  // FlatMap Modifiers:
+  void clear() noexcept;
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  iterator insert(const_iterator hint, const value_type &value);
+  iterator insert(const_iterator hint, value_type &&value);
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &obj);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  void insert(InputIt first, InputIt last);
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <typename... Args>
+  std::vector<bool> insert_many(Args &&...args); // true - пара вставлена
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type &key); // возвращает число удалённых
+  void swap(FlatMap &other) noexcept;
+  void merge(FlatMap &other);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args);
+
+  // FlatMap Lookup:
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  size_type count_range(const key_type &lo, const key_type &hi) const;
+  iterator find(const key_type &key);
+  const_iterator find(const key_type &key) const;
+  iterator lower_bound(const key_type &key);
+  const_iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key);
+  const_iterator upper_bound(const key_type &key) const;
+  std::pair<iterator, iterator> equal_range(const key_type &key);
+  std::pair<const_iterator, const_iterator>
+  equal_range(const key_type &key) const;
+
+  // FlatMap Order statistics:
+  size_type rank(const key_type &key) const;
+  iterator nth(size_type k) noexcept;
+  const_iterator nth(size_type k) const noexcept;
+  const_reference select(size_type k) const;
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+  /**
+   * @brief Iterator over the pair array that hides the non-constant key.
+   *
+   * Dereferencing gives a pair of references, the key one constant, and
+   * operator-> returns it wrapped in a small proxy. Since the reference is
+   * not a real reference, the iterator is an input iterator for the
+   * standard algorithms, although it supports all random access operations.
+   */
+  template <bool IsConst> class FlatMapIterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = FlatMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = typename std::conditional<IsConst, const_reference,
+                                                FlatMap::reference>::type;
+
+    // operator-> не может вернуть адрес пары ссылок - она временная
+    class pointer {
+    public:
+      explicit pointer(reference ref) noexcept : ref_(ref) {}
+      const reference *operator->() const noexcept { return &ref_; }
+
+    private:
+      reference ref_;
+    };
+
+    FlatMapIterator() noexcept = default;
+    template <bool C = IsConst, typename = typename std::enable_if<C>::type>
+    FlatMapIterator(const FlatMapIterator<false> &other) noexcept
+        : pair_(other.pair_) {} // iterator -> const_iterator
+
+    reference operator*() const noexcept {
+      return {pair_->first, pair_->second};
+    }
+    pointer operator->() const noexcept { return pointer(**this); }
+    reference operator[](difference_type n) const noexcept {
+      return *(*this + n);
+    }
+    const key_type &key() const noexcept { return pair_->first; }
+
+    FlatMapIterator &operator++() noexcept {
+      ++pair_;
+      return *this;
+    }
+    FlatMapIterator operator++(int) noexcept {
+      return FlatMapIterator(pair_++);
+    }
+    FlatMapIterator &operator--() noexcept {
+      --pair_;
+      return *this;
+    }
+    FlatMapIterator operator--(int) noexcept {
+      return FlatMapIterator(pair_--);
+    }
+    FlatMapIterator &operator+=(difference_type n) noexcept {
+      pair_ += n;
+      return *this;
+    }
+    FlatMapIterator &operator-=(difference_type n) noexcept {
+      pair_ -= n;
+      return *this;
+    }
+    FlatMapIterator operator+(difference_type n) const noexcept {
+      return FlatMapIterator(pair_ + n);
+    }
+    FlatMapIterator operator-(difference_type n) const noexcept {
+      return FlatMapIterator(pair_ - n);
+    }
+
+    // сравнение и разность итератора с const_iterator в любом порядке
+    template <bool C>
+    difference_type operator-(const FlatMapIterator<C> &other) const noexcept {
+      return pair_ - other.pair_;
+    }
+    template <bool C>
+    bool operator==(const FlatMapIterator<C> &other) const noexcept {
+      return pair_ == other.pair_;
+    }
+    template <bool C>
+    bool operator!=(const FlatMapIterator<C> &other) const noexcept {
+      return pair_ != other.pair_;
+    }
+    template <bool C>
+    bool operator<(const FlatMapIterator<C> &other) const noexcept {
+      return pair_ < other.pair_;
+    }
+    template <bool C>
+    bool operator>(const FlatMapIterator<C> &other) const noexcept {
+      return pair_ > other.pair_;
+    }
+    template <bool C>
+    bool operator<=(const FlatMapIterator<C> &other) const noexcept {
+      return pair_ <= other.pair_;
+    }
+    template <bool C>
+    bool operator>=(const FlatMapIterator<C> &other) const noexcept {
+      return pair_ >= other.pair_;
+    }
+
+  private:
+    using pair_pointer =
+        typename std::conditional<IsConst, const FlatMap::value_type *,
+                                  FlatMap::value_type *>::type;
+
+    explicit FlatMapIterator(pair_pointer pair) noexcept : pair_(pair) {}
+
+    friend class FlatMap;
+    template <bool C> friend class FlatMapIterator;
+
+    pair_pointer pair_ = nullptr;
+  };
+
+private:
+  static iterator makeIterator(typename flat_tree::iterator it) noexcept;
+  static const_iterator
+  makeIterator(typename flat_tree::const_iterator it) noexcept;
+  static std::pair<iterator, bool>
+  makeResult(std::pair<typename flat_tree::iterator, bool> result) noexcept;
+
+  template <typename K, typename V, typename C, typename A, typename Pred>
+  friend typename FlatMap<K, V, C, A>::size_type
+  erase_if(FlatMap<K, V, C, A> &map, Pred pred);
+
+  flat_tree tree_;
+};
+
+template <typename Key, typename Value, typename Compare, typename Allocator,
+          typename Pred>
+typename FlatMap<Key, Value, Compare, Allocator>::size_type
+erase_if(FlatMap<Key, Value, Compare, Allocator> &map, Pred pred);
+
+} // namespace s21
+
+#include "s21_flat_map.tpp"
+
+#endif // CPP2_S21_CONTAINERS_FLAT_MAP_H_
@@ -0,0 +1,800 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_flat_map.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-07-27
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FlatMap<Key, Value, Compare, Allocator>::FlatMap() : tree_() {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator of the pair array.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FlatMap<Key, Value, Compare, Allocator>::FlatMap(const allocator_type &alloc)
+    : tree_(alloc) {}
+
+/**
+ * @brief Constructor with initializer list.
+ * @param items Initializer list of value_type.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FlatMap<Key, Value, Compare, Allocator>::FlatMap(
+    std::initializer_list<value_type> const &items)
+    : FlatMap(items.begin(), items.end()) {}
+
+/**
+ * @brief Range constructor: the pairs are sorted once. Only the first pair
+ * with each key is stored.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+FlatMap<Key, Value, Compare, Allocator>::FlatMap(InputIt first, InputIt last)
+    : tree_() {
+  this->tree_.insertRange(first, last, true);
+}
+
+/**
+ * @brief Constructor from a range sorted by key without duplicate keys,
+ * O(n).
+ *
+ * The order is checked in one pass; an unsorted range is still accepted
+ * and sorted.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+FlatMap<Key, Value, Compare, Allocator>::FlatMap(sorted_unique_t,
+                                                 InputIt first, InputIt last)
+    : tree_() {
+  this->tree_.insertRange(first, last, true);
+}
+
+/**
+ * @brief Copies the pairs of a Map, O(n): they are already in order.
+ * @param map Map with the same comparator.
+ * @param alloc Allocator of the pair array.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename MapAllocator>
+FlatMap<Key, Value, Compare, Allocator>::FlatMap(
+    const Map<Key, Value, Compare, MapAllocator> &map,
+    const allocator_type &alloc)
+    : tree_(alloc) {
+  this->tree_.reserve(map.size());
+  this->tree_.insertRange(map.begin(), map.end(), true);
+}
+
+/**
+ * @brief Copy constructor.
+ * @param m FlatMap to copy.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FlatMap<Key, Value, Compare, Allocator>::FlatMap(const FlatMap &m)
+    : tree_(m.tree_) {}
+
+/**
+ * @brief Move constructor.
+ * @param m FlatMap to move.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FlatMap<Key, Value, Compare, Allocator>::FlatMap(FlatMap &&m) noexcept
+    : tree_(std::move(m.tree_)) {}
+
+/**
+ * @brief Destructor.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FlatMap<Key, Value, Compare, Allocator>::~FlatMap() = default;
+
+/**
+ * @brief Copy assignment operator.
+ * @param m FlatMap to copy.
+ * @return Reference to this FlatMap.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FlatMap<Key, Value, Compare, Allocator> &
+FlatMap<Key, Value, Compare, Allocator>::operator=(const FlatMap &m) {
+  this->tree_ = m.tree_;
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator.
+ * @param m FlatMap to move.
+ * @return Reference to this FlatMap.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FlatMap<Key, Value, Compare, Allocator> &
+FlatMap<Key, Value, Compare, Allocator>::operator=(FlatMap &&m) noexcept {
+  this->tree_ = std::move(m.tree_);
+  return *this;
+}
+
+/**
+ * @brief Returns the allocator associated with the FlatMap.
+ * @return Copy of the allocator.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::allocator_type
+FlatMap<Key, Value, Compare, Allocator>::get_allocator() const noexcept {
+  return this->tree_.get_allocator();
+}
+
+/**
+ * @brief Builds a Map with the same pairs, O(n).
+ *
+ * The pairs go to Map::assign(sorted_unique, ...), which builds the tree
+ * from the sorted array instead of inserting the pairs one by one.
+ * @param alloc Allocator of the new Map.
+ * @return The Map.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename MapAllocator>
+Map<Key, Value, Compare, MapAllocator>
+FlatMap<Key, Value, Compare, Allocator>::to_map(
+    const MapAllocator &alloc) const {
+  Map<Key, Value, Compare, MapAllocator> result(alloc);
+  result.assign(sorted_unique, this->tree_.begin(), this->tree_.end());
+  return result;
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+// FlatMap Element access
+/**
+ * @brief Access specified element with bounds checking.
+ * @param key Key of the element to access.
+ * @return Reference to the mapped value.
+ * @throws std::out_of_range if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::mapped_type &
+FlatMap<Key, Value, Compare, Allocator>::at(const key_type &key) {
+  return const_cast<mapped_type &>(
+      static_cast<const FlatMap *>(this)->at(key));
+}
+
+/**
+ * @brief Access specified element with bounds checking.
+ * @param key Key of the element to access.
+ * @return Const reference to the mapped value.
+ * @throws std::out_of_range if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+const typename FlatMap<Key, Value, Compare, Allocator>::mapped_type &
+FlatMap<Key, Value, Compare, Allocator>::at(const key_type &key) const {
+  auto it = this->tree_.find(key);
+  if (it == this->tree_.end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+/**
+ * @brief Access or insert value.
+ *
+ * One binary search: a value-initialized element is inserted only if the
+ * key is absent.
+ * @param key Key of the element to access.
+ * @return Reference to the mapped value.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::mapped_type &
+FlatMap<Key, Value, Compare, Allocator>::operator[](const key_type &key) {
+  return this->tree_.tryEmplace(key).first->second;
+}
+
+// FlatMap Iterators
+/**
+ * @brief Returns an iterator to the beginning.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::iterator
+FlatMap<Key, Value, Compare, Allocator>::begin() noexcept {
+  return makeIterator(this->tree_.begin());
+}
+
+/**
+ * @brief Returns an iterator to the end.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::iterator
+FlatMap<Key, Value, Compare, Allocator>::end() noexcept {
+  return makeIterator(this->tree_.end());
+}
+
+/**
+ * @brief Returns a const iterator to the beginning.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::const_iterator
+FlatMap<Key, Value, Compare, Allocator>::begin() const noexcept {
+  return makeIterator(this->tree_.begin());
+}
+
+/**
+ * @brief Returns a const iterator to the end.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::const_iterator
+FlatMap<Key, Value, Compare, Allocator>::end() const noexcept {
+  return makeIterator(this->tree_.end());
+}
+
+/**
+ * @brief Returns a reverse iterator to the largest key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::reverse_iterator
+FlatMap<Key, Value, Compare, Allocator>::rbegin() noexcept {
+  return reverse_iterator(end());
+}
+
+/**
+ * @brief Returns a reverse iterator past the smallest key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::reverse_iterator
+FlatMap<Key, Value, Compare, Allocator>::rend() noexcept {
+  return reverse_iterator(begin());
+}
+
+/**
+ * @brief Returns a const reverse iterator to the largest key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::const_reverse_iterator
+FlatMap<Key, Value, Compare, Allocator>::rbegin() const noexcept {
+  return const_reverse_iterator(end());
+}
+
+/**
+ * @brief Returns a const reverse iterator past the smallest key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::const_reverse_iterator
+FlatMap<Key, Value, Compare, Allocator>::rend() const noexcept {
+  return const_reverse_iterator(begin());
+}
+
+// FlatMap Capacity
+/**
+ * @brief Checks whether the container is empty.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool FlatMap<Key, Value, Compare, Allocator>::empty() const noexcept {
+  return this->tree_.empty();
+}
+
+/**
+ * @brief Returns the number of elements.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::size_type
+FlatMap<Key, Value, Compare, Allocator>::size() const noexcept {
+  return this->tree_.size();
+}
+
+/**
+ * @brief Returns the maximum possible number of elements.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::size_type
+FlatMap<Key, Value, Compare, Allocator>::max_size() const noexcept {
+  return this->tree_.max_size();
+}
+
+/**
+ * @brief Returns the number of pairs the array holds without reallocation.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::size_type
+FlatMap<Key, Value, Compare, Allocator>::capacity() const noexcept {
+  return this->tree_.capacity();
+}
+
+/**
+ * @brief Makes room for count pairs.
+ * @param count Number of pairs.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void FlatMap<Key, Value, Compare, Allocator>::reserve(size_type count) {
+  this->tree_.reserve(count);
+}
+
+/**
+ * @brief Returns the unused capacity to the allocator.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void FlatMap<Key, Value, Compare, Allocator>::shrink_to_fit() {
+  this->tree_.shrinkToFit();
+}
+
+/**
+ * @brief Returns the number of bytes of the pair array, capacity() pairs.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::size_type
+FlatMap<Key, Value, Compare, Allocator>::memory_usage() const noexcept {
+  return this->tree_.memoryUsage();
+}
+
+// FlatMap Modifiers
+/**
+ * @brief Clears the contents; the capacity stays.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void FlatMap<Key, Value, Compare, Allocator>::clear() noexcept {
+  this->tree_.clear();
+}
+
+/**
+ * @brief Inserts a pair if its key is absent.
+ * @param value Pair to insert.
+ * @return Pair consisting of an iterator to the inserted element (or to the
+ * element that prevented the insertion) and a bool denoting whether the
+ * insertion took place.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename FlatMap<Key, Value, Compare, Allocator>::iterator, bool>
+FlatMap<Key, Value, Compare, Allocator>::insert(const value_type &value) {
+  return makeResult(this->tree_.insert(value, true));
+}
+
+/**
+ * @brief Inserts a pair if its key is absent, moving it into the array.
+ * @param value Pair to insert.
+ * @return Same as insert(const value_type &).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename FlatMap<Key, Value, Compare, Allocator>::iterator, bool>
+FlatMap<Key, Value, Compare, Allocator>::insert(value_type &&value) {
+  return makeResult(this->tree_.insert(std::move(value), true));
+}
+
+/**
+ * @brief Inserts a pair as close as possible to the position before hint.
+ * @param hint Iterator to the position before which the pair should go.
+ * @param value Pair to insert.
+ * @return Iterator to the inserted element or to the one with the same key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::iterator
+FlatMap<Key, Value, Compare, Allocator>::insert(const_iterator hint,
+                                                 const value_type &value) {
+  return makeIterator(this->tree_.insertHint(hint.pair_, value, true));
+}
+
+/**
+ * @brief Inserts a pair before hint, moving it into the array.
+ * @param hint Iterator to the position before which the pair should go.
+ * @param value Pair to insert.
+ * @return Iterator to the inserted element or to the one with the same key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::iterator
+FlatMap<Key, Value, Compare, Allocator>::insert(const_iterator hint,
+                                                 value_type &&value) {
+  return makeIterator(
+      this->tree_.insertHint(hint.pair_, std::move(value), true));
+}
+
+/**
+ * @brief Inserts a pair built from key and obj if the key is absent.
+ * @param key Key of the element to insert.
+ * @param obj Value of the element to insert.
+ * @return Same as insert(const value_type &).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename FlatMap<Key, Value, Compare, Allocator>::iterator, bool>
+FlatMap<Key, Value, Compare, Allocator>::insert(const key_type &key,
+                                                 const mapped_type &obj) {
+  return try_emplace(key, obj);
+}
+
+/**
+ * @brief Inserts the pairs of a range with one sort and merge,
+ * O(n + k log k) for k pairs.
+ *
+ * Pairs whose keys are already present, and repeated keys of the range,
+ * are skipped.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+void FlatMap<Key, Value, Compare, Allocator>::insert(InputIt first,
+                                                     InputIt last) {
+  this->tree_.insertRange(first, last, true);
+}
+
+/**
+ * @brief Inserts a pair or assigns obj if the key already exists.
+ * @param key Key of the element.
+ * @param obj Value to insert or assign.
+ * @return Iterator to the element and whether it was inserted.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename M>
+std::pair<typename FlatMap<Key, Value, Compare, Allocator>::iterator, bool>
+FlatMap<Key, Value, Compare, Allocator>::insert_or_assign(
+    const key_type &key, M &&obj) {
+  // tryEmplace не трогает obj, если ключ уже есть
+  auto result = this->tree_.tryEmplace(key, std::forward<M>(obj));
+  if (!result.second) {
+    result.first->second = std::forward<M>(obj);
+  }
+  return makeResult(result);
+}
+
+/**
+ * @brief Inserts a pair with the value built from args if the key is absent.
+ *
+ * If the key already exists, nothing is constructed and args are not moved
+ * from.
+ * @param key Key of the element to insert.
+ * @param args Arguments forwarded to the constructor of the mapped value.
+ * @return Iterator to the element and whether it was inserted.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename FlatMap<Key, Value, Compare, Allocator>::iterator, bool>
+FlatMap<Key, Value, Compare, Allocator>::try_emplace(const key_type &key,
+                                                      Args &&...args) {
+  return makeResult(this->tree_.tryEmplace(key, std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Inserts multiple pairs.
+ *
+ * Each insertion invalidates the iterators returned by the previous ones,
+ * so only the results are reported.
+ * @param args The pairs to insert.
+ * @return For each pair, whether it was inserted.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+std::vector<bool>
+FlatMap<Key, Value, Compare, Allocator>::insert_many(Args &&...args) {
+  std::vector<bool> results;
+  (results.push_back(insert(std::forward<Args>(args)).second), ...);
+  return results;
+}
+
+/**
+ * @brief Erases an element.
+ * @param pos Iterator to the element to erase.
+ * @return Iterator to the element that followed the erased one.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::iterator
+FlatMap<Key, Value, Compare, Allocator>::erase(const_iterator pos) {
+  return makeIterator(this->tree_.erase(pos.pair_));
+}
+
+/**
+ * @brief Erases the elements in [first, last).
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @return Iterator to the element that followed the erased range.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::iterator
+FlatMap<Key, Value, Compare, Allocator>::erase(const_iterator first,
+                                                const_iterator last) {
+  return makeIterator(this->tree_.erase(first.pair_, last.pair_));
+}
+
+/**
+ * @brief Erases the element with the key.
+ * @param key Key of the element to erase.
+ * @return Number of erased elements (0 or 1).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::size_type
+FlatMap<Key, Value, Compare, Allocator>::erase(const key_type &key) {
+  return this->tree_.eraseEqual(key);
+}
+
+/**
+ * @brief Swaps the contents.
+ * @param other FlatMap to swap with.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void FlatMap<Key, Value, Compare, Allocator>::swap(FlatMap &other) noexcept {
+  this->tree_.swap(other.tree_);
+}
+
+/**
+ * @brief Moves the pairs of other whose keys are absent here into this map
+ * in one merge pass, O(n + m).
+ *
+ * Pairs with keys that are already present stay in other.
+ * @param other FlatMap to merge from.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void FlatMap<Key, Value, Compare, Allocator>::merge(FlatMap &other) {
+  this->tree_.merge(other.tree_, true);
+}
+
+/**
+ * @brief Builds a pair from args and inserts it if its key is absent.
+ * @param args Arguments of the pair constructor.
+ * @return Same as insert(const value_type &).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename FlatMap<Key, Value, Compare, Allocator>::iterator, bool>
+FlatMap<Key, Value, Compare, Allocator>::emplace(Args &&...args) {
+  return makeResult(this->tree_.emplace(true, std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Builds a pair from args and inserts it before hint if possible.
+ * @param hint Iterator to the position before which the pair should go.
+ * @param args Arguments of the pair constructor.
+ * @return Iterator to the inserted element or to the one with the same key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+typename FlatMap<Key, Value, Compare, Allocator>::iterator
+FlatMap<Key, Value, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                                       Args &&...args) {
+  return makeIterator(this->tree_.insertHint(
+      hint.pair_, value_type(std::forward<Args>(args)...), true));
+}
+
+// FlatMap Lookup
+/**
+ * @brief Checks if the container contains an element with the key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool FlatMap<Key, Value, Compare, Allocator>::contains(
+    const key_type &key) const {
+  return this->tree_.find(key) != this->tree_.end();
+}
+
+/**
+ * @brief Returns the number of elements with the key (0 or 1).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::size_type
+FlatMap<Key, Value, Compare, Allocator>::count(const key_type &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Returns the number of elements with keys in [lo, hi), O(log n).
+ * @param lo Lower bound of the range, included.
+ * @param hi Upper bound of the range, excluded.
+ * @return The number of elements, 0 if hi is not greater than lo.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::size_type
+FlatMap<Key, Value, Compare, Allocator>::count_range(
+    const key_type &lo, const key_type &hi) const {
+  return this->tree_.countRange(lo, hi);
+}
+
+/**
+ * @brief Finds the element with the key.
+ * @param key Key to search for.
+ * @return Iterator to the element, or end() if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::iterator
+FlatMap<Key, Value, Compare, Allocator>::find(const key_type &key) {
+  return makeIterator(this->tree_.find(key));
+}
+
+/**
+ * @brief Finds the element with the key.
+ * @param key Key to search for.
+ * @return Const iterator to the element, or end() if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::const_iterator
+FlatMap<Key, Value, Compare, Allocator>::find(const key_type &key) const {
+  return makeIterator(this->tree_.find(key));
+}
+
+/**
+ * @brief Returns an iterator to the first element with a key not less than
+ * key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::iterator
+FlatMap<Key, Value, Compare, Allocator>::lower_bound(const key_type &key) {
+  return makeIterator(this->tree_.lower_bound(key));
+}
+
+/**
+ * @brief Returns a const iterator to the first element with a key not less
+ * than key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::const_iterator
+FlatMap<Key, Value, Compare, Allocator>::lower_bound(
+    const key_type &key) const {
+  return makeIterator(this->tree_.lower_bound(key));
+}
+
+/**
+ * @brief Returns an iterator to the first element with a key greater than
+ * key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::iterator
+FlatMap<Key, Value, Compare, Allocator>::upper_bound(const key_type &key) {
+  return makeIterator(this->tree_.upper_bound(key));
+}
+
+/**
+ * @brief Returns a const iterator to the first element with a key greater
+ * than key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::const_iterator
+FlatMap<Key, Value, Compare, Allocator>::upper_bound(
+    const key_type &key) const {
+  return makeIterator(this->tree_.upper_bound(key));
+}
+
+/**
+ * @brief Returns the range of elements with the key.
+ * @param key Key to search for.
+ * @return Pair of iterators: the element and the one after it, or two equal
+ * iterators if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename FlatMap<Key, Value, Compare, Allocator>::iterator,
+          typename FlatMap<Key, Value, Compare, Allocator>::iterator>
+FlatMap<Key, Value, Compare, Allocator>::equal_range(const key_type &key) {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+/**
+ * @brief Returns the range of elements with the key.
+ * @param key Key to search for.
+ * @return Pair of const iterators bounding the element with the key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename FlatMap<Key, Value, Compare, Allocator>::const_iterator,
+          typename FlatMap<Key, Value, Compare, Allocator>::const_iterator>
+FlatMap<Key, Value, Compare, Allocator>::equal_range(
+    const key_type &key) const {
+  return {lower_bound(key), upper_bound(key)};
+}
+
+// FlatMap Order statistics
+/**
+ * @brief Returns the number of elements with keys less than key, O(log n).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::size_type
+FlatMap<Key, Value, Compare, Allocator>::rank(const key_type &key) const {
+  return this->tree_.rank(key);
+}
+
+/**
+ * @brief Returns an iterator to the element at position k, O(1).
+ * @param k Zero-based position.
+ * @return Iterator to the k-th element, end() if k >= size().
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::iterator
+FlatMap<Key, Value, Compare, Allocator>::nth(size_type k) noexcept {
+  return makeIterator(this->tree_.nth(k));
+}
+
+/**
+ * @brief Returns a const iterator to the element at position k, O(1).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::const_iterator
+FlatMap<Key, Value, Compare, Allocator>::nth(size_type k) const noexcept {
+  return makeIterator(this->tree_.nth(k));
+}
+
+/**
+ * @brief Returns the element at position k, O(1).
+ * @return Pair of references to the key and the mapped value.
+ * @throws std::out_of_range if k >= size()
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::const_reference
+FlatMap<Key, Value, Compare, Allocator>::select(size_type k) const {
+  const value_type &pair = this->tree_.select(k);
+  return {pair.first, pair.second};
+}
+
+/******************************************************************************
+ * AUXILIARY METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Wraps a pointer into the pair array into an iterator.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::iterator
+FlatMap<Key, Value, Compare, Allocator>::makeIterator(
+    typename flat_tree::iterator it) noexcept {
+  return iterator(it);
+}
+
+/**
+ * @brief Wraps a const pointer into the pair array into a const iterator.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FlatMap<Key, Value, Compare, Allocator>::const_iterator
+FlatMap<Key, Value, Compare, Allocator>::makeIterator(
+    typename flat_tree::const_iterator it) noexcept {
+  return const_iterator(it);
+}
+
+/**
+ * @brief Converts the result of an insertion into the array.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename FlatMap<Key, Value, Compare, Allocator>::iterator, bool>
+FlatMap<Key, Value, Compare, Allocator>::makeResult(
+    std::pair<typename flat_tree::iterator, bool> result) noexcept {
+  return {iterator(result.first), result.second};
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks that the pairs are sorted by key and the keys are unique.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool FlatMap<Key, Value, Compare, Allocator>::checkInvariants() const {
+  return this->tree_.checkInvariants(true);
+}
+
+/******************************************************************************
+ * NON-MEMBER FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * @brief Erases all elements that satisfy pred in one pass, O(n).
+ *
+ * @param map The container to erase from.
+ * @param pred Predicate called once for every element in key order.
+ * @return size_type Number of erased elements.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator,
+          typename Pred>
+typename FlatMap<Key, Value, Compare, Allocator>::size_type
+erase_if(FlatMap<Key, Value, Compare, Allocator> &map, Pred pred) {
+  return map.tree_.eraseIf(pred);
+}
+
+} // namespace s21
@@ -0,0 +1 @@
+#include "s21_flat_multiset.h"
\ No newline at end of file
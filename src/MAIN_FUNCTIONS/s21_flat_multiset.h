@@ -0,0 +1,149 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_flat_multiset.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-07-27
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_FLAT_MULTISET_H_
+#define CPP2_S21_CONTAINERS_FLAT_MULTISET_H_
+
+#include "s21_multiset.h"
+#include "../SUPPORT_FUNCTIONS/flat_tree.h"
+
+namespace s21 {
+
+/**
+ * @brief Multiset stored as a sorted s21::vector.
+ *
+ * Has the interface of MultiSet and is meant for read-mostly data: lookups are
+ * binary searches over one contiguous array and the container spends no
+ * memory per key beyond the key itself. A single insertion or erasure
+ * shifts the tail of the array, so batches should go through
+ * insert(first, last), which sorts and merges them once. Every insertion
+ * invalidates all iterators.
+ *
+ * A MultiSet is converted to a FlatMultiSet and back in O(n): both are
+ * already in key order, nothing is sorted again. Equivalent keys keep their
+ * order of insertion.
+ */
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class FlatMultiSet {
+public:
+  // FlatMultiSet Member type:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using flat_tree =
+      s21::FlatTree<Key, Key, Identity<Key>, Compare, Allocator>;
+  // ключи множества неизменяемы: оба итератора константные
+  using iterator = typename flat_tree::const_iterator;
+  using const_iterator = typename flat_tree::const_iterator;
+  using reverse_iterator = typename flat_tree::const_reverse_iterator;
+  using const_reverse_iterator = typename flat_tree::const_reverse_iterator;
+
+  // FlatMultiSet Member functions:
+  FlatMultiSet();
+  explicit FlatMultiSet(const allocator_type &alloc);
+  FlatMultiSet(std::initializer_list<value_type> const &items);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  FlatMultiSet(InputIt first, InputIt last);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  FlatMultiSet(sorted_equivalent_t, InputIt first, InputIt last);
+  template <typename SetAllocator>
+  explicit FlatMultiSet(const MultiSet<Key, Compare, SetAllocator> &set,
+                        const allocator_type &alloc = allocator_type());
+  FlatMultiSet(const FlatMultiSet &s);
+  FlatMultiSet(FlatMultiSet &&s) noexcept;
+  ~FlatMultiSet();
+  FlatMultiSet &operator=(const FlatMultiSet &s);
+  FlatMultiSet &operator=(FlatMultiSet &&s) noexcept;
+  allocator_type get_allocator() const noexcept;
+
+  // FlatMultiSet Conversion:
+  template <typename SetAllocator = std::allocator<Key>>
+  MultiSet<Key, Compare, SetAllocator>
+  to_multiset(const SetAllocator &alloc = SetAllocator()) const;
+
+  // FlatMultiSet Iterators:
+  iterator begin() const noexcept;
+  iterator end() const noexcept;
+  reverse_iterator rbegin() const noexcept;
+  reverse_iterator rend() const noexcept;
+
+  // FlatMultiSet Capacity:
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  size_type capacity() const noexcept;
+  void reserve(size_type count);
+  void shrink_to_fit();
+  size_type memory_usage() const noexcept; // байты массива ключей
+
+  // FlatMultiSet Modifiers:
+  void clear() noexcept;
+  iterator insert(const value_type &value);
+  iterator insert(value_type &&value);
+  iterator insert(const_iterator hint, const value_type &value);
+  iterator insert(const_iterator hint, value_type &&value);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  void insert(InputIt first, InputIt last);
+  template <typename... Args>
+  void insert_many(Args &&...args);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type &key); // возвращает число удалённых
+  void swap(FlatMultiSet &other) noexcept;
+  void merge(FlatMultiSet &other);
+  template <typename... Args>
+  iterator emplace(Args &&...args);
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args);
+
+  // FlatMultiSet Lookup:
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  size_type count_range(const key_type &lo, const key_type &hi) const;
+  iterator find(const key_type &key) const;
+  iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key) const;
+  std::pair<iterator, iterator> equal_range(const key_type &key) const;
+
+  // FlatMultiSet Order statistics:
+  size_type rank(const key_type &key) const;
+  iterator nth(size_type k) const noexcept;
+  const_reference select(size_type k) const;
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  template <typename K, typename C, typename A, typename Pred>
+  friend typename FlatMultiSet<K, C, A>::size_type
+  erase_if(FlatMultiSet<K, C, A> &set, Pred pred);
+
+  flat_tree tree_;
+};
+
+template <typename Key, typename Compare, typename Allocator, typename Pred>
+typename FlatMultiSet<Key, Compare, Allocator>::size_type
+erase_if(FlatMultiSet<Key, Compare, Allocator> &set, Pred pred);
+
+} // namespace s21
+
+#include "s21_flat_multiset.tpp"
+
+#endif // CPP2_S21_CONTAINERS_FLAT_MULTISET_H_
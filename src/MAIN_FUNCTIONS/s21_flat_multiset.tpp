@@ -0,0 +1,573 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_flat_multiset.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-07-27
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FlatMultiSet<Key, Compare, Allocator>::FlatMultiSet() : tree_() {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator of the key array.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FlatMultiSet<Key, Compare, Allocator>::FlatMultiSet(
+    const allocator_type &alloc)
+    : tree_(alloc) {}
+
+/**
+ * @brief Constructor with initializer list.
+ * @param items Initializer list of value_type.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FlatMultiSet<Key, Compare, Allocator>::FlatMultiSet(
+    std::initializer_list<value_type> const &items)
+    : FlatMultiSet(items.begin(), items.end()) {}
+
+/**
+ * @brief Range constructor: the keys are sorted once.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+FlatMultiSet<Key, Compare, Allocator>::FlatMultiSet(InputIt first,
+                                                    InputIt last)
+    : tree_() {
+  this->tree_.insertRange(first, last, false);
+}
+
+/**
+ * @brief Constructor from a sorted range, O(n).
+ *
+ * The order is checked in one pass; an unsorted range is still accepted
+ * and sorted.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+FlatMultiSet<Key, Compare, Allocator>::FlatMultiSet(sorted_equivalent_t,
+                                                    InputIt first,
+                                                    InputIt last)
+    : tree_() {
+  this->tree_.insertRange(first, last, false);
+}
+
+/**
+ * @brief Copies the keys of a MultiSet, O(n): they are already in order.
+ * @param set MultiSet with the same comparator.
+ * @param alloc Allocator of the key array.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename SetAllocator>
+FlatMultiSet<Key, Compare, Allocator>::FlatMultiSet(
+    const MultiSet<Key, Compare, SetAllocator> &set,
+    const allocator_type &alloc)
+    : tree_(alloc) {
+  this->tree_.reserve(set.size());
+  this->tree_.insertRange(set.begin(), set.end(), false);
+}
+
+/**
+ * @brief Copy constructor.
+ * @param s FlatMultiSet to copy.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FlatMultiSet<Key, Compare, Allocator>::FlatMultiSet(const FlatMultiSet &s)
+    : tree_(s.tree_) {}
+
+/**
+ * @brief Move constructor.
+ * @param s FlatMultiSet to move.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FlatMultiSet<Key, Compare, Allocator>::FlatMultiSet(FlatMultiSet &&s) noexcept
+    : tree_(std::move(s.tree_)) {}
+
+/**
+ * @brief Destructor.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FlatMultiSet<Key, Compare, Allocator>::~FlatMultiSet() = default;
+
+/**
+ * @brief Copy assignment operator.
+ * @param s FlatMultiSet to copy.
+ * @return Reference to this FlatMultiSet.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FlatMultiSet<Key, Compare, Allocator> &
+FlatMultiSet<Key, Compare, Allocator>::operator=(const FlatMultiSet &s) {
+  this->tree_ = s.tree_;
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator.
+ * @param s FlatMultiSet to move.
+ * @return Reference to this FlatMultiSet.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FlatMultiSet<Key, Compare, Allocator> &
+FlatMultiSet<Key, Compare, Allocator>::operator=(
+    FlatMultiSet &&s) noexcept {
+  this->tree_ = std::move(s.tree_);
+  return *this;
+}
+
+/**
+ * @brief Returns the allocator associated with the FlatMultiSet.
+ * @return Copy of the allocator.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::allocator_type
+FlatMultiSet<Key, Compare, Allocator>::get_allocator() const noexcept {
+  return this->tree_.get_allocator();
+}
+
+/**
+ * @brief Builds a MultiSet with the same keys, O(n).
+ *
+ * The keys go to MultiSet::assign(sorted_equivalent, ...), which builds the
+ * tree from the sorted array instead of inserting the keys one by one.
+ * @param alloc Allocator of the new MultiSet.
+ * @return The MultiSet.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename SetAllocator>
+MultiSet<Key, Compare, SetAllocator>
+FlatMultiSet<Key, Compare, Allocator>::to_multiset(
+    const SetAllocator &alloc) const {
+  MultiSet<Key, Compare, SetAllocator> result(alloc);
+  result.assign(sorted_equivalent, begin(), end());
+  return result;
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+// FlatMultiSet Iterators
+/**
+ * @brief Returns an iterator to the smallest key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::iterator
+FlatMultiSet<Key, Compare, Allocator>::begin() const noexcept {
+  return this->tree_.begin();
+}
+
+/**
+ * @brief Returns an iterator past the largest key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::iterator
+FlatMultiSet<Key, Compare, Allocator>::end() const noexcept {
+  return this->tree_.end();
+}
+
+/**
+ * @brief Returns a reverse iterator to the largest key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::reverse_iterator
+FlatMultiSet<Key, Compare, Allocator>::rbegin() const noexcept {
+  return reverse_iterator(end());
+}
+
+/**
+ * @brief Returns a reverse iterator past the smallest key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::reverse_iterator
+FlatMultiSet<Key, Compare, Allocator>::rend() const noexcept {
+  return reverse_iterator(begin());
+}
+
+// FlatMultiSet Capacity
+/**
+ * @brief Checks whether the container is empty.
+ */
+template <typename Key, typename Compare, typename Allocator>
+bool FlatMultiSet<Key, Compare, Allocator>::empty() const noexcept {
+  return this->tree_.empty();
+}
+
+/**
+ * @brief Returns the number of elements.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::size_type
+FlatMultiSet<Key, Compare, Allocator>::size() const noexcept {
+  return this->tree_.size();
+}
+
+/**
+ * @brief Returns the maximum possible number of elements.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::size_type
+FlatMultiSet<Key, Compare, Allocator>::max_size() const noexcept {
+  return this->tree_.max_size();
+}
+
+/**
+ * @brief Returns the number of keys the array holds without reallocation.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::size_type
+FlatMultiSet<Key, Compare, Allocator>::capacity() const noexcept {
+  return this->tree_.capacity();
+}
+
+/**
+ * @brief Makes room for count keys.
+ * @param count Number of keys.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void FlatMultiSet<Key, Compare, Allocator>::reserve(size_type count) {
+  this->tree_.reserve(count);
+}
+
+/**
+ * @brief Returns the unused capacity to the allocator.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void FlatMultiSet<Key, Compare, Allocator>::shrink_to_fit() {
+  this->tree_.shrinkToFit();
+}
+
+/**
+ * @brief Returns the number of bytes of the key array, capacity() keys.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::size_type
+FlatMultiSet<Key, Compare, Allocator>::memory_usage() const noexcept {
+  return this->tree_.memoryUsage();
+}
+
+// FlatMultiSet Modifiers
+/**
+ * @brief Clears the contents; the capacity stays.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void FlatMultiSet<Key, Compare, Allocator>::clear() noexcept {
+  this->tree_.clear();
+}
+
+/**
+ * @brief Inserts a key after the equivalent ones, O(n) because of the shift
+ * of the tail.
+ * @param value Key to insert.
+ * @return Iterator to the inserted key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::iterator
+FlatMultiSet<Key, Compare, Allocator>::insert(const value_type &value) {
+  return this->tree_.insert(value, false).first;
+}
+
+/**
+ * @brief Inserts a key, moving it into the array.
+ * @param value Key to insert.
+ * @return Iterator to the inserted key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::iterator
+FlatMultiSet<Key, Compare, Allocator>::insert(value_type &&value) {
+  return this->tree_.insert(std::move(value), false).first;
+}
+
+/**
+ * @brief Inserts a key right before hint if it belongs there, skipping the
+ * binary search.
+ * @param hint Iterator to the position before which the key should go.
+ * @param value Key to insert.
+ * @return Iterator to the inserted key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::iterator
+FlatMultiSet<Key, Compare, Allocator>::insert(const_iterator hint,
+                                              const value_type &value) {
+  return this->tree_.insertHint(hint, value, false);
+}
+
+/**
+ * @brief Inserts a key before hint, moving it into the array.
+ * @param hint Iterator to the position before which the key should go.
+ * @param value Key to insert.
+ * @return Iterator to the inserted key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::iterator
+FlatMultiSet<Key, Compare, Allocator>::insert(const_iterator hint,
+                                              value_type &&value) {
+  return this->tree_.insertHint(hint, std::move(value), false);
+}
+
+/**
+ * @brief Inserts the keys of a range with one sort and merge,
+ * O(n + k log k) for k keys.
+ *
+ * The new keys go after the equivalent keys already present and keep their
+ * order of the range among themselves.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+void FlatMultiSet<Key, Compare, Allocator>::insert(InputIt first,
+                                                   InputIt last) {
+  this->tree_.insertRange(first, last, false);
+}
+
+/**
+ * @brief Inserts multiple keys.
+ * @param args The keys to insert.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+void FlatMultiSet<Key, Compare, Allocator>::insert_many(Args &&...args) {
+  (insert(std::forward<Args>(args)), ...);
+}
+
+/**
+ * @brief Erases a key.
+ * @param pos Iterator to the key to erase.
+ * @return Iterator to the key that followed the erased one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::iterator
+FlatMultiSet<Key, Compare, Allocator>::erase(const_iterator pos) {
+  return this->tree_.erase(pos);
+}
+
+/**
+ * @brief Erases the keys in [first, last) with one shift of the tail.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @return Iterator to the key that followed the erased range.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::iterator
+FlatMultiSet<Key, Compare, Allocator>::erase(const_iterator first,
+                                             const_iterator last) {
+  return this->tree_.erase(first, last);
+}
+
+/**
+ * @brief Erases all keys equivalent to key.
+ * @param key Key to erase.
+ * @return Number of erased keys.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::size_type
+FlatMultiSet<Key, Compare, Allocator>::erase(const key_type &key) {
+  return this->tree_.eraseEqual(key);
+}
+
+/**
+ * @brief Swaps the contents.
+ * @param other FlatMultiSet to swap with.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void FlatMultiSet<Key, Compare, Allocator>::swap(
+    FlatMultiSet &other) noexcept {
+  this->tree_.swap(other.tree_);
+}
+
+/**
+ * @brief Moves all keys of other into this multiset in one merge pass,
+ * O(n + m); other becomes empty.
+ * @param other FlatMultiSet to merge from.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void FlatMultiSet<Key, Compare, Allocator>::merge(FlatMultiSet &other) {
+  this->tree_.merge(other.tree_, false);
+}
+
+/**
+ * @brief Builds a key from args and inserts it.
+ * @param args Arguments of the key constructor.
+ * @return Iterator to the inserted key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename FlatMultiSet<Key, Compare, Allocator>::iterator
+FlatMultiSet<Key, Compare, Allocator>::emplace(Args &&...args) {
+  return this->tree_.emplace(false, std::forward<Args>(args)...).first;
+}
+
+/**
+ * @brief Builds a key from args and inserts it before hint if possible.
+ * @param hint Iterator to the position before which the key should go.
+ * @param args Arguments of the key constructor.
+ * @return Iterator to the inserted key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename FlatMultiSet<Key, Compare, Allocator>::iterator
+FlatMultiSet<Key, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                                    Args &&...args) {
+  return this->tree_.insertHint(hint, value_type(std::forward<Args>(args)...),
+                                false);
+}
+
+// FlatMultiSet Lookup
+/**
+ * @brief Checks if the container contains key, O(log n).
+ */
+template <typename Key, typename Compare, typename Allocator>
+bool FlatMultiSet<Key, Compare, Allocator>::contains(
+    const key_type &key) const {
+  return this->tree_.find(key) != this->tree_.end();
+}
+
+/**
+ * @brief Returns the number of keys equivalent to key, O(log n).
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::size_type
+FlatMultiSet<Key, Compare, Allocator>::count(const key_type &key) const {
+  return this->tree_.count(key);
+}
+
+/**
+ * @brief Returns the number of keys in [lo, hi), O(log n).
+ * @param lo Lower bound of the range, included.
+ * @param hi Upper bound of the range, excluded.
+ * @return The number of keys, 0 if hi is not greater than lo.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::size_type
+FlatMultiSet<Key, Compare, Allocator>::count_range(const key_type &lo,
+                                                   const key_type &hi) const {
+  return this->tree_.countRange(lo, hi);
+}
+
+/**
+ * @brief Finds the first key equivalent to key by binary search.
+ * @param key Key to search for.
+ * @return Iterator to the key, or end() if it is absent.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::iterator
+FlatMultiSet<Key, Compare, Allocator>::find(const key_type &key) const {
+  return this->tree_.find(key);
+}
+
+/**
+ * @brief Returns an iterator to the first key not less than key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::iterator
+FlatMultiSet<Key, Compare, Allocator>::lower_bound(
+    const key_type &key) const {
+  return this->tree_.lower_bound(key);
+}
+
+/**
+ * @brief Returns an iterator to the first key greater than key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::iterator
+FlatMultiSet<Key, Compare, Allocator>::upper_bound(
+    const key_type &key) const {
+  return this->tree_.upper_bound(key);
+}
+
+/**
+ * @brief Returns the range of keys equivalent to key.
+ * @param key Key to search for.
+ * @return Pair of iterators: the first such key and the one after the
+ * last, or two equal iterators if the key is absent.
+ */
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename FlatMultiSet<Key, Compare, Allocator>::iterator,
+          typename FlatMultiSet<Key, Compare, Allocator>::iterator>
+FlatMultiSet<Key, Compare, Allocator>::equal_range(
+    const key_type &key) const {
+  return {this->tree_.lower_bound(key), this->tree_.upper_bound(key)};
+}
+
+// FlatMultiSet Order statistics
+/**
+ * @brief Returns the number of keys less than key, O(log n).
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::size_type
+FlatMultiSet<Key, Compare, Allocator>::rank(const key_type &key) const {
+  return this->tree_.rank(key);
+}
+
+/**
+ * @brief Returns an iterator to the key at position k, O(1).
+ * @param k Zero-based position.
+ * @return Iterator to the k-th key, end() if k >= size().
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::iterator
+FlatMultiSet<Key, Compare, Allocator>::nth(size_type k) const noexcept {
+  return this->tree_.nth(k);
+}
+
+/**
+ * @brief Returns the key at position k, O(1).
+ * @throws std::out_of_range if k >= size()
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FlatMultiSet<Key, Compare, Allocator>::const_reference
+FlatMultiSet<Key, Compare, Allocator>::select(size_type k) const {
+  return this->tree_.select(k);
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks that the keys are sorted.
+ */
+template <typename Key, typename Compare, typename Allocator>
+bool FlatMultiSet<Key, Compare, Allocator>::checkInvariants() const {
+  return this->tree_.checkInvariants(false);
+}
+
+/******************************************************************************
+ * NON-MEMBER FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * @brief Erases all keys that satisfy pred in one pass, O(n).
+ *
+ * @param set The container to erase from.
+ * @param pred Predicate called once for every key in key order.
+ * @return size_type Number of erased elements.
+ */
+template <typename Key, typename Compare, typename Allocator, typename Pred>
+typename FlatMultiSet<Key, Compare, Allocator>::size_type
+erase_if(FlatMultiSet<Key, Compare, Allocator> &set, Pred pred) {
+  return set.tree_.eraseIf(pred);
+}
+
+} // namespace s21
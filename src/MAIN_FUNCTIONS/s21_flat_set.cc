@@ -0,0 +1 @@
+#include "s21_flat_set.h"
\ No newline at end of file
@@ -0,0 +1,102 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_frozen_map.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-31
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_FROZEN_MAP_H_
+#define CPP2_S21_CONTAINERS_FROZEN_MAP_H_
+
+#include <algorithm> // std::stable_sort, std::unique
+#include <initializer_list>
+#include <stdexcept> // std::out_of_range
+#include <vector>
+
+#include "s21_map.h"
+#include "../SUPPORT_FUNCTIONS/eytzinger_tree.h"
+
+namespace s21 {
+
+/**
+ * @brief Immutable map with unique keys laid out for fast lookups.
+ *
+ * The keys are kept in an EytzingerTree, the values in a parallel array at
+ * the same positions, so a lookup touches only keys until it has found the
+ * element. Built once (usually by Map::freeze()); there are no iterators,
+ * for_each() walks the elements in key order. Keys and values must be
+ * default-constructible and copy-assignable.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class FrozenMap {
+public:
+  // FrozenMap Member type:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using key_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Key>;
+  using mapped_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Value>;
+  using eytzinger_tree = s21::EytzingerTree<Key, Compare, key_allocator>;
+
+  // FrozenMap Member functions:
+  FrozenMap();
+  explicit FrozenMap(const allocator_type &alloc);
+  FrozenMap(std::initializer_list<value_type> const &items);
+  template <typename MapAllocator>
+  explicit FrozenMap(const Map<Key, Value, Compare, MapAllocator> &map,
+                     const allocator_type &alloc = allocator_type());
+  FrozenMap(const FrozenMap &m);
+  FrozenMap(FrozenMap &&m) noexcept;
+  ~FrozenMap();
+  FrozenMap &operator=(const FrozenMap &m);
+  FrozenMap &operator=(FrozenMap &&m) noexcept;
+  allocator_type get_allocator() const noexcept;
+
+  // FrozenMap Conversion:
+  template <typename MapAllocator = std::allocator<value_type>>
+  Map<Key, Value, Compare, MapAllocator>
+  to_map(const MapAllocator &alloc = MapAllocator()) const;
+
+  // FrozenMap Capacity:
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type memory_usage() const noexcept; // байты ключей, индекса и значений
+
+  // FrozenMap Lookup:
+  const mapped_type &at(const key_type &key) const;
+  const mapped_type *find(const key_type &key) const; // nullptr - нет ключа
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  template <typename Fn> void for_each(Fn &&fn) const;
+
+  void swap(FrozenMap &other) noexcept;
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  template <typename It> void assignSorted(It first, It last);
+
+  eytzinger_tree tree_;
+  s21::vector<Value, mapped_allocator> values_; // по позициям ключей в tree_
+};
+
+} // namespace s21
+
+#include "s21_frozen_map.tpp"
+
+#endif // CPP2_S21_CONTAINERS_FROZEN_MAP_H_
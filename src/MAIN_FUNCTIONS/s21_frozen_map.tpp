@@ -0,0 +1,313 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_frozen_map.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-31
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor: an empty map.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FrozenMap<Key, Value, Compare, Allocator>::FrozenMap() : tree_(), values_() {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator, rebound to the keys and to the values.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FrozenMap<Key, Value, Compare, Allocator>::FrozenMap(
+    const allocator_type &alloc)
+    : tree_(key_allocator(alloc)), values_(mapped_allocator(alloc)) {}
+
+/**
+ * @brief Constructor with initializer list. Repeated keys keep the first
+ * value, as Map::insert does.
+ * @param items Initializer list of elements in any order.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FrozenMap<Key, Value, Compare, Allocator>::FrozenMap(
+    std::initializer_list<value_type> const &items)
+    : tree_(), values_() {
+  std::vector<std::pair<Key, Value>> elements(items.begin(), items.end());
+  Compare compare;
+  auto less = [&compare](const std::pair<Key, Value> &a,
+                         const std::pair<Key, Value> &b) {
+    return compare(a.first, b.first);
+  };
+  std::stable_sort(elements.begin(), elements.end(), less);
+  elements.erase(std::unique(elements.begin(), elements.end(),
+                             [&less](const std::pair<Key, Value> &a,
+                                     const std::pair<Key, Value> &b) {
+                               return !less(a, b) && !less(b, a);
+                             }),
+                 elements.end());
+  assignSorted(elements.begin(), elements.end());
+}
+
+/**
+ * @brief Constructor from a Map. The elements are already in order: O(n).
+ * @param map Map to freeze.
+ * @param alloc Allocator, rebound to the keys and to the values.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename MapAllocator>
+FrozenMap<Key, Value, Compare, Allocator>::FrozenMap(
+    const Map<Key, Value, Compare, MapAllocator> &map,
+    const allocator_type &alloc)
+    : tree_(key_allocator(alloc)), values_(mapped_allocator(alloc)) {
+  assignSorted(map.begin(), map.end());
+}
+
+/**
+ * @brief Copy constructor.
+ * @param m FrozenMap to copy.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FrozenMap<Key, Value, Compare, Allocator>::FrozenMap(const FrozenMap &m)
+    : tree_(m.tree_), values_(m.values_) {}
+
+/**
+ * @brief Move constructor.
+ * @param m FrozenMap to move.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FrozenMap<Key, Value, Compare, Allocator>::FrozenMap(FrozenMap &&m) noexcept
+    : tree_(std::move(m.tree_)), values_(std::move(m.values_)) {}
+
+/**
+ * @brief Destructor.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FrozenMap<Key, Value, Compare, Allocator>::~FrozenMap() = default;
+
+/**
+ * @brief Copy assignment operator.
+ * @param m FrozenMap to copy.
+ * @return Reference to this FrozenMap.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FrozenMap<Key, Value, Compare, Allocator> &
+FrozenMap<Key, Value, Compare, Allocator>::operator=(const FrozenMap &m) {
+  if (this != &m) {
+    FrozenMap copy(m);
+    swap(copy);
+  }
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator.
+ * @param m FrozenMap to move.
+ * @return Reference to this FrozenMap.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FrozenMap<Key, Value, Compare, Allocator> &
+FrozenMap<Key, Value, Compare, Allocator>::operator=(FrozenMap &&m) noexcept {
+  this->tree_ = std::move(m.tree_);
+  this->values_ = std::move(m.values_);
+  return *this;
+}
+
+/**
+ * @brief Returns the allocator associated with the FrozenMap.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FrozenMap<Key, Value, Compare, Allocator>::allocator_type
+FrozenMap<Key, Value, Compare, Allocator>::get_allocator() const noexcept {
+  return allocator_type(this->tree_.get_allocator());
+}
+
+/**
+ * @brief Copies the elements into a Map, built in linear time from the
+ * sorted walk.
+ * @param alloc Allocator of the Map.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename MapAllocator>
+Map<Key, Value, Compare, MapAllocator>
+FrozenMap<Key, Value, Compare, Allocator>::to_map(
+    const MapAllocator &alloc) const {
+  std::vector<value_type> elements;
+  elements.reserve(size());
+  for_each([&elements](const Key &key, const Value &value) {
+    elements.emplace_back(key, value);
+  });
+  Map<Key, Value, Compare, MapAllocator> map(alloc);
+  map.assign(sorted_unique, elements.begin(), elements.end());
+  return map;
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+// FrozenMap Capacity
+/**
+ * @brief Checks whether the map is empty.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool FrozenMap<Key, Value, Compare, Allocator>::empty() const noexcept {
+  return this->tree_.empty();
+}
+
+/**
+ * @brief Returns the number of elements.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FrozenMap<Key, Value, Compare, Allocator>::size_type
+FrozenMap<Key, Value, Compare, Allocator>::size() const noexcept {
+  return this->tree_.size();
+}
+
+/**
+ * @brief Returns the number of bytes taken by the keys, the block index and
+ * the values.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FrozenMap<Key, Value, Compare, Allocator>::size_type
+FrozenMap<Key, Value, Compare, Allocator>::memory_usage() const noexcept {
+  return this->tree_.memoryUsage() + this->values_.capacity() * sizeof(Value);
+}
+
+// FrozenMap Lookup
+/**
+ * @brief Returns the value of the key.
+ * @param key Key of the element.
+ * @return Reference to the value.
+ * @throws std::out_of_range if key not found.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+const Value &
+FrozenMap<Key, Value, Compare, Allocator>::at(const key_type &key) const {
+  const Value *value = find(key);
+  if (!value) {
+    throw std::out_of_range("Key not found");
+  }
+  return *value;
+}
+
+/**
+ * @brief Finds the value of the key.
+ * @param key Key to search for.
+ * @return Pointer to the value, or nullptr if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+const Value *
+FrozenMap<Key, Value, Compare, Allocator>::find(const key_type &key) const {
+  std::size_t position = this->tree_.find(key);
+  return position == eytzinger_tree::npos ? nullptr
+                                          : this->values_.data() + position;
+}
+
+/**
+ * @brief Checks if the map contains the key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool FrozenMap<Key, Value, Compare, Allocator>::contains(
+    const key_type &key) const {
+  return this->tree_.find(key) != eytzinger_tree::npos;
+}
+
+/**
+ * @brief Returns the number of elements with the key (0 or 1).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename FrozenMap<Key, Value, Compare, Allocator>::size_type
+FrozenMap<Key, Value, Compare, Allocator>::count(const key_type &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Calls fn(key, value) for every element in key order.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename Fn>
+void FrozenMap<Key, Value, Compare, Allocator>::for_each(Fn &&fn) const {
+  this->tree_.forEachPosition([this, &fn](std::size_t position) {
+    fn(this->tree_.keyAt(position), this->values_.data()[position]);
+  });
+}
+
+/**
+ * @brief Swaps the contents.
+ * @param other FrozenMap to swap with.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void FrozenMap<Key, Value, Compare, Allocator>::swap(
+    FrozenMap &other) noexcept {
+  this->tree_.swap(other.tree_);
+  this->values_.swap(other.values_);
+}
+
+/******************************************************************************
+ * SUPPORT METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Builds the map from elements in increasing key order without
+ * equivalent keys; the range is read twice.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename It>
+void FrozenMap<Key, Value, Compare, Allocator>::assignSorted(It first,
+                                                             It last) {
+  std::vector<Key> keys;
+  for (It it = first; it != last; ++it) {
+    keys.push_back(it->first);
+  }
+  eytzinger_tree tree(this->tree_.get_allocator());
+  tree.assign(keys.data(), keys.size());
+  s21::vector<Value, mapped_allocator> values(tree.positions(),
+                                              this->values_.get_allocator());
+  Value *out = values.data();
+  tree.forEachPosition([&first, out](std::size_t position) {
+    out[position] = first->second;
+    ++first;
+  });
+  this->tree_.swap(tree);
+  this->values_.swap(values);
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks the layout of the keys and the size of the value array.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool FrozenMap<Key, Value, Compare, Allocator>::checkInvariants() const {
+  return this->tree_.checkInvariants() &&
+         this->values_.size() == this->tree_.positions();
+}
+
+/******************************************************************************
+ * MAP FREEZING
+ ******************************************************************************/
+
+/**
+ * @brief Builds an immutable copy of the map for fast lookups, O(n).
+ * @return FrozenMap with the elements of this map and its allocator.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+FrozenMap<Key, Value, Compare, Allocator>
+Map<Key, Value, Compare, Allocator>::freeze() const {
+  return FrozenMap<Key, Value, Compare, Allocator>(*this, get_allocator());
+}
+
+} // namespace s21
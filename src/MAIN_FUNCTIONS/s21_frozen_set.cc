@@ -0,0 +1 @@
+#include "s21_frozen_set.h"
\ No newline at end of file
@@ -0,0 +1,91 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_frozen_set.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-31
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_FROZEN_SET_H_
+#define CPP2_S21_CONTAINERS_FROZEN_SET_H_
+
+#include <algorithm> // std::sort, std::unique
+#include <initializer_list>
+#include <vector>
+
+#include "s21_set.h"
+#include "../SUPPORT_FUNCTIONS/eytzinger_tree.h"
+
+namespace s21 {
+
+/**
+ * @brief Immutable set of unique keys laid out for fast membership tests.
+ *
+ * Built once (usually by Set::freeze()) and then only probed: contains()
+ * descends an Eytzinger-ordered block index without branches and compares
+ * one cache-line block of keys at once (see EytzingerTree). There are no
+ * iterators; for_each() walks the keys in order. Keys must be
+ * default-constructible and copy-assignable.
+ */
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class FrozenSet {
+public:
+  // FrozenSet Member type:
+  using key_type = Key;
+  using value_type = Key;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using eytzinger_tree = s21::EytzingerTree<Key, Compare, Allocator>;
+
+  // FrozenSet Member functions:
+  FrozenSet();
+  explicit FrozenSet(const allocator_type &alloc);
+  FrozenSet(std::initializer_list<value_type> const &items);
+  template <typename SetAllocator>
+  explicit FrozenSet(const Set<Key, Compare, SetAllocator> &set,
+                     const allocator_type &alloc = allocator_type());
+  FrozenSet(const FrozenSet &s);
+  FrozenSet(FrozenSet &&s) noexcept;
+  ~FrozenSet();
+  FrozenSet &operator=(const FrozenSet &s);
+  FrozenSet &operator=(FrozenSet &&s) noexcept;
+  allocator_type get_allocator() const noexcept;
+
+  // FrozenSet Conversion:
+  template <typename SetAllocator = std::allocator<Key>>
+  Set<Key, Compare, SetAllocator>
+  to_set(const SetAllocator &alloc = SetAllocator()) const;
+
+  // FrozenSet Capacity:
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type memory_usage() const noexcept; // байты ключей и индекса
+
+  // FrozenSet Lookup:
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  template <typename Fn> void for_each(Fn &&fn) const;
+
+  void swap(FrozenSet &other) noexcept;
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  eytzinger_tree tree_;
+};
+
+} // namespace s21
+
+#include "s21_frozen_set.tpp"
+
+#endif // CPP2_S21_CONTAINERS_FROZEN_SET_H_
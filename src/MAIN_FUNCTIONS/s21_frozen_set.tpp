@@ -0,0 +1,240 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_frozen_set.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-31
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor: an empty set.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FrozenSet<Key, Compare, Allocator>::FrozenSet() : tree_() {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator of the keys.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FrozenSet<Key, Compare, Allocator>::FrozenSet(const allocator_type &alloc)
+    : tree_(alloc) {}
+
+/**
+ * @brief Constructor with initializer list. Repeated keys are skipped.
+ * @param items Initializer list of keys in any order.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FrozenSet<Key, Compare, Allocator>::FrozenSet(
+    std::initializer_list<value_type> const &items)
+    : tree_() {
+  std::vector<Key> keys(items.begin(), items.end());
+  Compare compare;
+  std::sort(keys.begin(), keys.end(), compare);
+  keys.erase(std::unique(keys.begin(), keys.end(),
+                         [&compare](const Key &a, const Key &b) {
+                           return !compare(a, b) && !compare(b, a);
+                         }),
+             keys.end());
+  this->tree_.assign(keys.data(), keys.size());
+}
+
+/**
+ * @brief Constructor from a Set. The keys are already in order: O(n).
+ * @param set Set to freeze.
+ * @param alloc Allocator of the keys.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename SetAllocator>
+FrozenSet<Key, Compare, Allocator>::FrozenSet(
+    const Set<Key, Compare, SetAllocator> &set, const allocator_type &alloc)
+    : tree_(alloc) {
+  std::vector<Key> keys;
+  keys.reserve(set.size());
+  for (const Key &key : set) {
+    keys.push_back(key);
+  }
+  this->tree_.assign(keys.data(), keys.size());
+}
+
+/**
+ * @brief Copy constructor.
+ * @param s FrozenSet to copy.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FrozenSet<Key, Compare, Allocator>::FrozenSet(const FrozenSet &s)
+    : tree_(s.tree_) {}
+
+/**
+ * @brief Move constructor.
+ * @param s FrozenSet to move.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FrozenSet<Key, Compare, Allocator>::FrozenSet(FrozenSet &&s) noexcept
+    : tree_(std::move(s.tree_)) {}
+
+/**
+ * @brief Destructor.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FrozenSet<Key, Compare, Allocator>::~FrozenSet() = default;
+
+/**
+ * @brief Copy assignment operator.
+ * @param s FrozenSet to copy.
+ * @return Reference to this FrozenSet.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FrozenSet<Key, Compare, Allocator> &
+FrozenSet<Key, Compare, Allocator>::operator=(const FrozenSet &s) {
+  this->tree_ = s.tree_;
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator.
+ * @param s FrozenSet to move.
+ * @return Reference to this FrozenSet.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FrozenSet<Key, Compare, Allocator> &
+FrozenSet<Key, Compare, Allocator>::operator=(FrozenSet &&s) noexcept {
+  this->tree_ = std::move(s.tree_);
+  return *this;
+}
+
+/**
+ * @brief Returns the allocator associated with the FrozenSet.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FrozenSet<Key, Compare, Allocator>::allocator_type
+FrozenSet<Key, Compare, Allocator>::get_allocator() const noexcept {
+  return this->tree_.get_allocator();
+}
+
+/**
+ * @brief Copies the keys into a Set, built in linear time from the sorted
+ * walk.
+ * @param alloc Allocator of the Set.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename SetAllocator>
+Set<Key, Compare, SetAllocator>
+FrozenSet<Key, Compare, Allocator>::to_set(const SetAllocator &alloc) const {
+  std::vector<Key> keys;
+  keys.reserve(size());
+  for_each([&keys](const Key &key) { keys.push_back(key); });
+  Set<Key, Compare, SetAllocator> set(alloc);
+  set.assign(sorted_unique, keys.begin(), keys.end());
+  return set;
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+// FrozenSet Capacity
+/**
+ * @brief Checks whether the set is empty.
+ */
+template <typename Key, typename Compare, typename Allocator>
+bool FrozenSet<Key, Compare, Allocator>::empty() const noexcept {
+  return this->tree_.empty();
+}
+
+/**
+ * @brief Returns the number of keys.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FrozenSet<Key, Compare, Allocator>::size_type
+FrozenSet<Key, Compare, Allocator>::size() const noexcept {
+  return this->tree_.size();
+}
+
+/**
+ * @brief Returns the number of bytes taken by the keys and the block index.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FrozenSet<Key, Compare, Allocator>::size_type
+FrozenSet<Key, Compare, Allocator>::memory_usage() const noexcept {
+  return this->tree_.memoryUsage();
+}
+
+// FrozenSet Lookup
+/**
+ * @brief Checks if the set contains the key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+bool FrozenSet<Key, Compare, Allocator>::contains(const key_type &key) const {
+  return this->tree_.find(key) != eytzinger_tree::npos;
+}
+
+/**
+ * @brief Returns the number of keys equivalent to key (0 or 1).
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename FrozenSet<Key, Compare, Allocator>::size_type
+FrozenSet<Key, Compare, Allocator>::count(const key_type &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Calls fn(key) for every key in order.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename Fn>
+void FrozenSet<Key, Compare, Allocator>::for_each(Fn &&fn) const {
+  this->tree_.forEachPosition([this, &fn](std::size_t position) {
+    fn(this->tree_.keyAt(position));
+  });
+}
+
+/**
+ * @brief Swaps the contents.
+ * @param other FrozenSet to swap with.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void FrozenSet<Key, Compare, Allocator>::swap(FrozenSet &other) noexcept {
+  this->tree_.swap(other.tree_);
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks the layout (see EytzingerTree::checkInvariants).
+ */
+template <typename Key, typename Compare, typename Allocator>
+bool FrozenSet<Key, Compare, Allocator>::checkInvariants() const {
+  return this->tree_.checkInvariants();
+}
+
+/******************************************************************************
+ * SET FREEZING
+ ******************************************************************************/
+
+/**
+ * @brief Builds an immutable copy of the set for fast lookups, O(n).
+ * @return FrozenSet with the keys of this set and its allocator.
+ */
+template <typename Key, typename Compare, typename Allocator>
+FrozenSet<Key, Compare, Allocator>
+Set<Key, Compare, Allocator>::freeze() const {
+  return FrozenSet<Key, Compare, Allocator>(*this, get_allocator());
+}
+
+} // namespace s21
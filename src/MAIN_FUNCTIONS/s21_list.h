@@ -23,11 +23,13 @@
 
 #include "../s21_common.h" // на случай, если будем собирать только этот контейнер без остальных
 
+#include <memory> // нужно для std::allocator и std::allocator_traits
+
 #include "s21_vector.h"
 
 namespace s21 {
 
-template <typename T> // любой тип входных данных
+template <typename T, typename Allocator = std::allocator<T>> // любой тип входных данных и его аллокатор
 class list {
 
 
@@ -39,14 +41,24 @@ public:
     using reference = value_type&; // defines the type of the reference to an element
     using const_reference = const value_type&; // defines the type of the constant reference
     using size_type	= size_t; // defines the type of the container size (standard type is size_t)
+    using allocator_type = Allocator; // defines the type of the allocator used for the nodes
 
 private:
 
     struct BaseNode;
     struct Node;
 
+    // аллокатор элементов перепривязывается (rebind) к типу ноды
+    using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+
     BaseNode fakeNode_;  // граничный узел для циклического двусвязного списка
     size_type sz_;  // количество узлов в списке
+    node_allocator alloc_;  // аллокатор, из которого берётся память под ноды
+
+    template <typename Arg>
+    Node* createNode(BaseNode* prev, BaseNode* next, Arg&& value); // выделяет и создаёт ноду
+    void destroyNode(BaseNode* node) noexcept; // разрушает ноду и возвращает память аллокатору
 
 public:
 
@@ -61,17 +73,27 @@ public:
 
     // перечислены основные публичные методы для взаимодействия с классом:
     list();	// default constructor, creates empty list
-    list(size_type n);	// parameterized constructor, creates the list of size n
-    list(std::initializer_list<value_type> const &items); // initializer list constructor
+    explicit list(const allocator_type &alloc); // creates empty list with the given allocator
+    list(size_type n, const allocator_type &alloc = allocator_type());	// parameterized constructor, creates the list of size n
+    list(std::initializer_list<value_type> const &items,
+         const allocator_type &alloc = allocator_type()); // initializer list constructor
     list(const list &other); // copy constructor
     list(list &&other) noexcept; // move constructor
     ~list(); //	destructor
 
 
-    list& operator=(list &&other) noexcept; // assignment operator overload for moving object
+    // перемещение не бросает, если ноды можно просто перевесить
+    static constexpr bool kNothrowMoveAssign =
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value;
+
+    list& operator=(list &&other) noexcept(kNothrowMoveAssign); // assignment operator overload for moving object
     bool operator!=(const list &other) const;
 
+    allocator_type get_allocator() const noexcept; // returns the associated allocator
+
     void push_back(const_reference value); // adds an element to the end
+    void push_back(value_type &&value); // adds an element to the end by moving it
     void pop_back(); // removes the last element
     void push_front(const_reference value); // adds an element to the head
     void pop_front(); // removes the first element
@@ -108,6 +130,9 @@ public:
     void reverse(); // reverses the order of the elements
     void unique(); // removes consecutive duplicate elements
     void sort(); // sorts the elements
+    // двоичные снимки (формат описан в SUPPORT_FUNCTIONS/snapshot.h):
+    void save(int fd) const; // writes the elements to the file descriptor
+    void load(int fd); // replaces the contents with a snapshot read from the file descriptor
 
     const Node* get_end() const;
     const Node* get_begin() const;
@@ -31,8 +31,8 @@ namespace s21 {
  ******************************************************/
 
 
-                template <typename value_type>
-struct          list<value_type>::
+                template <typename value_type, typename Allocator>
+struct          list<value_type, Allocator>::
        BaseNode {
         BaseNode* prev_;
         BaseNode* next_;
@@ -42,14 +42,15 @@ struct          list<value_type>::
     };
 
 
-                    template <typename value_type>
-struct              list<value_type>::
+                    template <typename value_type, typename Allocator>
+struct              list<value_type, Allocator>::
         Node : public BaseNode {
 
         value_type value_;
 
-        Node(BaseNode* prev, BaseNode* next, const value_type& val)
-            : BaseNode(prev, next), value_(val) {}
+        template <typename Arg>
+        Node(BaseNode* prev, BaseNode* next, Arg&& val)
+            : BaseNode(prev, next), value_(std::forward<Arg>(val)) {}
     };
 
 
@@ -59,33 +60,40 @@ struct              list<value_type>::
  *                                                    *
  ******************************************************/
 
-            template <typename value_type>
-            list<value_type>::
-    list() : fakeNode_{&fakeNode_, &fakeNode_}, sz_(0) {}
+            template <typename value_type, typename Allocator>
+            list<value_type, Allocator>::
+    list() : list(allocator_type()) {}
 
 
 
-            template <typename value_type>
-            list<value_type>::
-    list(size_type n) : list() {
+            template <typename value_type, typename Allocator>
+            list<value_type, Allocator>::
+    list(const allocator_type &alloc) : fakeNode_{&fakeNode_, &fakeNode_}, sz_(0), alloc_(alloc) {}
+
+
+
+            template <typename value_type, typename Allocator>
+            list<value_type, Allocator>::
+    list(size_type n, const allocator_type &alloc) : list(alloc) {
         for (size_type i = 0; i < n; ++i) {
             push_back(value_type());
         }
     }
 
 
-            template <typename value_type>
-            list<value_type>::
-    list(std::initializer_list<value_type> const& items) : list() {
+            template <typename value_type, typename Allocator>
+            list<value_type, Allocator>::
+    list(std::initializer_list<value_type> const& items, const allocator_type &alloc) : list(alloc) {
         for (const auto& item : items) {
             push_back(item);
         }
     }
 
 
-            template <typename value_type>
-            list<value_type>::
-    list(const list& other) : list() {
+            template <typename value_type, typename Allocator>
+            list<value_type, Allocator>::
+    list(const list& other)
+        : list(allocator_type(node_traits::select_on_container_copy_construction(other.alloc_))) {
 
         const Node* from = other.get_begin();
 
@@ -97,9 +105,9 @@ struct              list<value_type>::
     } // copy constructor
 
 
-            template <typename value_type>
-            list<value_type>::
-    list(list&& other) noexcept : list() {
+            template <typename value_type, typename Allocator>
+            list<value_type, Allocator>::
+    list(list&& other) noexcept : list(allocator_type(other.alloc_)) {
 
         // std::cout <<  RED_ALERT_COLOR <<  "\nВызван конструктор"
         // " перемещения\n" << NORMAL_COLOR <<std::endl;
@@ -110,8 +118,8 @@ struct              list<value_type>::
     } // Реализация конструктора перемещения
 
 
-            template <typename value_type>
-            list<value_type>::
+            template <typename value_type, typename Allocator>
+            list<value_type, Allocator>::
     ~list() {
         clear();
         } //	destructor
@@ -124,14 +132,25 @@ struct              list<value_type>::
  ******************************************************/
 
 
-                         template <typename value_type>
-list<value_type>&        list<value_type>::
-         operator=(list &&other) noexcept {
+                         template <typename value_type, typename Allocator>
+list<value_type, Allocator>&        list<value_type, Allocator>::
+         operator=(list &&other) noexcept(kNothrowMoveAssign) {
 
         // std::cout <<  RED_ALERT_COLOR <<  "\nВызван оператор "
         // "присваивания перемещением (=) \n" << NORMAL_COLOR <<std::endl;
 
         clear();
+
+        if constexpr (node_traits::propagate_on_container_move_assignment::value) {
+            alloc_ = other.alloc_; // список пуст, поэтому аллокатор можно заменить
+        } else if constexpr (!node_traits::is_always_equal::value) {
+            if (alloc_ != other.alloc_) {
+                // чужие ноды забрать нельзя - перемещаем значения в свои ноды
+                for (iterator it = other.begin(); it != other.end(); ++it) push_back(std::move(*it));
+                other.clear();
+                return *this;
+            }
+        }
         swap(other);
 
         return *this;
@@ -139,13 +158,21 @@ list<value_type>&        list<value_type>::
     } // assignment operator overload for moving object
 
 
-                        template <typename value_type>
-bool                    list<value_type>::
+                        template <typename value_type, typename Allocator>
+bool                    list<value_type, Allocator>::
      operator!=(const list& other) const {
             return &fakeNode_ != &other.fakeNode_;
         }
 
 
+                        template <typename value_type, typename Allocator>
+                        typename list<value_type, Allocator>::
+allocator_type          list<value_type, Allocator>::
+     get_allocator() const noexcept {
+            return allocator_type(alloc_);
+        } // returns the associated allocator
+
+
 
 /******************************************************
  *                                                    *
@@ -155,20 +182,61 @@ bool                    list<value_type>::
 
 
 
-                        template <typename value_type>
-                        typename list<value_type>::
-size_type               list<value_type>::
+                        template <typename value_type, typename Allocator>
+                        typename list<value_type, Allocator>::
+size_type               list<value_type, Allocator>::
           size() const {
             return sz_;
     }
 
 
 
-                                            template <typename value_type>
-void                                        list<value_type>::
+                                            template <typename value_type, typename Allocator>
+                                            template <typename Arg>
+                                            typename list<value_type, Allocator>::
+Node*                                       list<value_type, Allocator>::
+      createNode(BaseNode* prev, BaseNode* next, Arg&& value) {
+
+        Node* node = node_traits::allocate(alloc_, 1); // память под ноду берётся у аллокатора
+        try {
+            node_traits::construct(alloc_, node, prev, next, std::forward<Arg>(value));
+        } catch (...) {
+            node_traits::deallocate(alloc_, node, 1);
+            throw;
+        }
+        return node;
+    } // allocates and constructs a node
+
+
+
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
+     destroyNode(BaseNode* node) noexcept {
+
+        Node* value_node = reinterpret_cast<Node*>(node);
+        node_traits::destroy(alloc_, value_node);
+        node_traits::deallocate(alloc_, value_node, 1);
+    } // destroys a node and returns its memory to the allocator
+
+
+
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
      push_back(const_reference value) {
 
-        Node* newNode = new Node(fakeNode_.prev_, &fakeNode_, value);
+        Node* newNode = createNode(fakeNode_.prev_, &fakeNode_, value);
+        fakeNode_.prev_->next_ = newNode;
+        fakeNode_.prev_ = newNode;
+        ++sz_;
+    }
+
+
+
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
+     push_back(value_type &&value) {
+
+        Node* newNode = createNode(fakeNode_.prev_, &fakeNode_, std::move(value));
         fakeNode_.prev_->next_ = newNode;
         fakeNode_.prev_ = newNode;
         ++sz_;
@@ -176,8 +244,8 @@ void                                        list<value_type>::
 
 
 
-                                            template <typename value_type>
-void                                        list<value_type>::
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
      pop_back() {
 
         erase(fakeNode_.prev_);
@@ -186,10 +254,10 @@ void                                        list<value_type>::
 
 
 
-                                            template <typename value_type>
-void                                        list<value_type>::
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
      push_front(const_reference value) {
-        Node* newNode = new Node(&fakeNode_, fakeNode_.next_, value);
+        Node* newNode = createNode(&fakeNode_, fakeNode_.next_, value);
         fakeNode_.next_->prev_ = newNode;
         fakeNode_.next_ = newNode;
         ++sz_;
@@ -198,8 +266,8 @@ void                                        list<value_type>::
 
 
 
-                                            template <typename value_type>
-void                                        list<value_type>::
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
      pop_front() {
 
         erase(fakeNode_.next_);
@@ -208,8 +276,8 @@ void                                        list<value_type>::
 
 
 
-                                            template <typename value_type>
-void                                        list<value_type>::
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
      swap(list& other) noexcept {
 
         if (sz_ > 0 && other.sz_ > 0) {
@@ -221,23 +289,27 @@ void                                        list<value_type>::
         else if (sz_ == 0 && other.sz_ > 0) {
         other.fakeNode_.prev_->next_ =  other.fakeNode_.next_->prev_ = &fakeNode_;
 
-        fakeNode_.prev_ = exchange(other.fakeNode_.prev_, &other.fakeNode_);
-        fakeNode_.next_ = exchange(other.fakeNode_.next_, &other.fakeNode_);
+        fakeNode_.prev_ = std::exchange(other.fakeNode_.prev_, &other.fakeNode_);
+        fakeNode_.next_ = std::exchange(other.fakeNode_.next_, &other.fakeNode_);
 
         } else if (sz_ > 0 && other.sz_ == 0)  {
         fakeNode_.prev_->next_ = fakeNode_.next_->prev_ = &other.fakeNode_;
 
-        other.fakeNode_.prev_ = exchange(fakeNode_.prev_, &fakeNode_);
-        other.fakeNode_.next_ = exchange(fakeNode_.next_, &fakeNode_);
+        other.fakeNode_.prev_ = std::exchange(fakeNode_.prev_, &fakeNode_);
+        other.fakeNode_.next_ = std::exchange(fakeNode_.next_, &fakeNode_);
         }
 
         std::swap(sz_, other.sz_);
 
+        if constexpr (node_traits::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        }
+
     } // swaps the contents
 
 
-                                            template <typename value_type>
-void                                        list<value_type>::
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
      reverse() {
 
         BaseNode* current = fakeNode_.next_;
@@ -250,20 +322,20 @@ void                                        list<value_type>::
     } // reverses the order of the elements
 
 
-                                            template <typename value_type>
-void                                        list<value_type>::
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
      erase (iterator pos) {
         if (sz_ > 0) {
             pos.ptr_->prev_->next_ = pos.ptr_->next_;
             pos.ptr_->next_->prev_ = pos.ptr_->prev_;
-            delete reinterpret_cast<Node*>(pos.ptr_);
+            destroyNode(pos.ptr_);
             --sz_;
         }
     }
 
 
-                                            template <typename value_type>
-void                                        list<value_type>::
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
      unique() {
 
         if (size() >= 2) {
@@ -288,8 +360,8 @@ void                                        list<value_type>::
     // указатели по принципу где меньше значение value_ в ноде
     // В соответствии с отсортированным вектором указателей меняются поля
     // prev_ и next_ уже непосредственно в самих нодах
-                                            template <typename value_type>
-void                                        list<value_type>::
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
      sort() {
 
         s21::vector<BaseNode*> nodes;
@@ -344,8 +416,8 @@ void                                        list<value_type>::
     } // sorts the elements
 
 
-                                            template <typename value_type>
-void                                        list<value_type>::
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
      clear() {
 
         while (sz_ > 0) pop_back();
@@ -354,8 +426,8 @@ void                                        list<value_type>::
 
 
 
-                                            template <typename value_type>
-bool                                        list<value_type>::
+                                            template <typename value_type, typename Allocator>
+bool                                        list<value_type, Allocator>::
      empty() const {
 
         return sz_ == 0;
@@ -363,9 +435,9 @@ bool                                        list<value_type>::
 
 
 
-                                            template <typename value_type>
-                                            typename list<value_type>::
-const_reference                             list<value_type>::
+                                            template <typename value_type, typename Allocator>
+                                            typename list<value_type, Allocator>::
+const_reference                             list<value_type, Allocator>::
                 front() const {
 
         return reinterpret_cast<const Node*>(fakeNode_.next_)->value_;
@@ -375,9 +447,9 @@ const_reference                             list<value_type>::
 
 
 
-                                            template <typename value_type>
-                                            typename list<value_type>::
-const_reference                             list<value_type>::
+                                            template <typename value_type, typename Allocator>
+                                            typename list<value_type, Allocator>::
+const_reference                             list<value_type, Allocator>::
                 back() const {
 
         return reinterpret_cast<const Node*>(fakeNode_.prev_)->value_;
@@ -387,12 +459,12 @@ const_reference                             list<value_type>::
 
 
 
-                                            template <typename value_type>
-                                            typename list<value_type>::
-iterator                                    list<value_type>::
+                                            template <typename value_type, typename Allocator>
+                                            typename list<value_type, Allocator>::
+iterator                                    list<value_type, Allocator>::
          insert(iterator pos, const_reference value) {
 
-        Node* newNode = new Node(pos.ptr_->prev_, pos.ptr_, value);
+        Node* newNode = createNode(pos.ptr_->prev_, pos.ptr_, value);
         pos.ptr_->prev_->next_ = newNode;
         pos.ptr_->prev_ = newNode;
         ++sz_;
@@ -403,8 +475,8 @@ iterator                                    list<value_type>::
 
 
 
-                                            template <typename value_type>
-void                                        list<value_type>::
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
      merge(list& other) {
 
         if (*this != other) {
@@ -416,7 +488,7 @@ void                                        list<value_type>::
 // Создайте пустой список result, который будет содержать
 // отсортированную последовательность.
 
-    s21::list<value_type> result;
+    s21::list<value_type, Allocator> result(get_allocator());
 
 
 //    Пока it1 не достиг конца первой отсортированной последовательности и
@@ -458,8 +530,8 @@ void                                        list<value_type>::
     } // merges two sorted lists
 
 
-// template <typename value_type>
-// void list<value_type>::merge(list& other) {
+// template <typename value_type, typename Allocator>
+// void list<value_type, Allocator>::merge(list& other) {
 //     if (this != &other) {
 //         iterator it1 = begin();
 //         iterator it2 = other.begin();
@@ -487,30 +559,30 @@ void                                        list<value_type>::
 
 
 
-                                            template <typename value_type>
-const                                       typename list<value_type>::
-      Node*         list<value_type>::
+                                            template <typename value_type, typename Allocator>
+const                                       typename list<value_type, Allocator>::
+      Node*         list<value_type, Allocator>::
             get_end() const {
         return reinterpret_cast<const Node*>(&fakeNode_);
     }
 
-                                            template <typename value_type>
-const                                       typename list<value_type>::
-      Node*         list<value_type>::
+                                            template <typename value_type, typename Allocator>
+const                                       typename list<value_type, Allocator>::
+      Node*         list<value_type, Allocator>::
             get_begin() const {
         return reinterpret_cast<const Node*>(fakeNode_.next_);
     }
 
-                                            template <typename value_type>
-const                                       typename list<value_type>::
-      Node*         list<value_type>::
+                                            template <typename value_type, typename Allocator>
+const                                       typename list<value_type, Allocator>::
+      Node*         list<value_type, Allocator>::
             get_next(const BaseNode* node) const {
     return reinterpret_cast<const Node*>(node->next_);
 }
 
-                                            template <typename value_type>
-                                            typename list<value_type>::
-size_type                                   list<value_type>::
+                                            template <typename value_type, typename Allocator>
+                                            typename list<value_type, Allocator>::
+size_type                                   list<value_type, Allocator>::
           max_size() const {
 
         return static_cast<size_type>(-1)/ (sizeof(list(1))); // Число (-1) преобразуется в size_t, что даёт
@@ -521,8 +593,8 @@ size_type                                   list<value_type>::
     } // returns the maximum possible number of elements
 
 
-                                            template <typename value_type>
-void                                        list<value_type>::
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
      splice(iterator pos, list& other) {
 
         auto previous_node = pos.ptr_->prev_; // обозначаем ноду, после которой будет вставка другого листа
@@ -544,39 +616,39 @@ void                                        list<value_type>::
     } //transfers elements from list other starting from pos
 
 
-                                            template <typename value_type>
-                                            typename list<value_type>::
-iterator                                    list<value_type>::
+                                            template <typename value_type, typename Allocator>
+                                            typename list<value_type, Allocator>::
+iterator                                    list<value_type, Allocator>::
          begin() {
     return iterator(fakeNode_.next_);
 }
 
-                                            template <typename value_type>
-                                            typename list<value_type>::
-iterator                                    list<value_type>::
+                                            template <typename value_type, typename Allocator>
+                                            typename list<value_type, Allocator>::
+iterator                                    list<value_type, Allocator>::
          begin() const {
     return iterator(fakeNode_.next_);
 }
 
-                                            template <typename value_type>
-                                            typename list<value_type>::
-iterator                                    list<value_type>::
+                                            template <typename value_type, typename Allocator>
+                                            typename list<value_type, Allocator>::
+iterator                                    list<value_type, Allocator>::
          end() {
     return iterator(&fakeNode_);
 }
 
-                                            template <typename value_type>
-                                            typename list<value_type>::
-iterator                                    list<value_type>::
+                                            template <typename value_type, typename Allocator>
+                                            typename list<value_type, Allocator>::
+iterator                                    list<value_type, Allocator>::
          end() const {
     return iterator(&fakeNode_);
 }
 
 
-                                            template <typename value_type>
+                                            template <typename value_type, typename Allocator>
                                             template <typename... Args>
-s21::vector<typename list<value_type>::iterator>
-                                            list<value_type>::
+s21::vector<typename list<value_type, Allocator>::iterator>
+                                            list<value_type, Allocator>::
             insert_many(iterator pos, Args &&...args) {
 
                 s21::vector<iterator> results; // создаём вектор с типом указателей на ноды листа (итераторы)
@@ -588,22 +660,54 @@ s21::vector<typename list<value_type>::iterator>
             return results;  // возвращает вектор с указателями
 }                            // на адреса вставленных нод
 
-                                            template <typename value_type>
+                                            template <typename value_type, typename Allocator>
                                             template <typename... Args>
 void
-     list<value_type>::insert_many_back(Args &&...args) {
+     list<value_type, Allocator>::insert_many_back(Args &&...args) {
         insert_many(end(), args...);
 }
 
-                                            template <typename value_type>
+                                            template <typename value_type, typename Allocator>
                                             template <typename... Args>
 void
-     list<value_type>::insert_many_front(Args &&...args) {
+     list<value_type, Allocator>::insert_many_front(Args &&...args) {
         insert_many(begin(), args...);
 }
 
 
 
+
+/******************************************************
+ *                                                    *
+ *                      СНИМКИ                        *
+ *                                                    *
+ ******************************************************/
+
+
+
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
+     save(int fd) const {
+        saveSnapshot<value_type>(fd, SnapshotKind::kList, begin(), sz_);
+} // writes the elements to the file descriptor
+
+                                            template <typename value_type, typename Allocator>
+void                                        list<value_type, Allocator>::
+     load(int fd) {
+
+        SnapshotReader reader = openSnapshot<value_type>(fd, SnapshotKind::kList);
+        list Temp(get_allocator()); // при ошибке чтения текущий список не меняется
+
+        SnapshotInputIterator<value_type> it(reader, reader.count());
+        for (size_type i = 0; i < reader.count(); ++i, ++it) {
+            Temp.push_back(*it);
+        }
+        reader.finish();
+        swap(Temp);
+} // replaces the contents with a snapshot read from the file descriptor
+
+
+
 }  // namespace s21
 
 #endif  // S21_LIST_TPP_
\ No newline at end of file
@@ -26,8 +26,8 @@
 namespace s21 {
 
 
-    template <typename T>
-        class list<T>::iterator {
+    template <typename T, typename Allocator>
+        class list<T, Allocator>::iterator {
 
     public:
         using value_type = T;
@@ -39,7 +39,7 @@ namespace s21 {
 
         iterator (BaseNode* ptr): ptr_(reinterpret_cast<BaseNode*>(ptr)) {}
 
-        friend class list<value_type>;
+        friend class list<value_type, Allocator>;
 
     public:
         iterator() : ptr_(nullptr) {} // Конструктор по умолчанию необходим для insert_many
@@ -19,11 +19,18 @@
 #include <iostream>
 
 #include "../SUPPORT_FUNCTIONS/rb_tree.h"
+#include "../SUPPORT_FUNCTIONS/snapshot.h"
 #include "../s21_common.h" // на случай, если будем собирать только этот контейнер без остальных
 
 namespace s21 {
 
-template <typename Key, typename Value> class Map {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+class FrozenMap;
+
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator =
+              std::allocator<std::pair<const Key, Value>>>
+class Map {
 public:
   // Map Member type:
   using key_type = Key;
@@ -32,27 +39,61 @@ public:
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
 
   class MapComparator {
   public:
+    // прозрачный: дерево ищет по ключу, не строя пару с mapped_type
+    using is_transparent = void;
+
     bool operator()(const_reference key_1,
-                    const_reference key_2) const noexcept {
-      return key_1.first < key_2.first;
+                    const_reference key_2) const {
+      return comp_(key_1.first, key_2.first); // сравниваем только ключи
+    }
+
+    // K — ключ или сравнимый с ним тип; пары (в том числе с неконстантным
+    // ключом) сравнивает перегрузка выше
+    template <typename K>
+    using RequireKey = typename std::enable_if<
+        !std::is_convertible<const K &, const_reference>::value>::type;
+
+    template <typename K, typename = RequireKey<K>>
+    bool operator()(const_reference value, const K &key) const {
+      return comp_(value.first, key);
+    }
+
+    template <typename K, typename = RequireKey<K>>
+    bool operator()(const K &key, const_reference value) const {
+      return comp_(key, value.first);
     }
+
+  private:
+    Compare comp_;
   };
 
-  using rb_tree = s21::RBTree<value_type, MapComparator>;
+  using rb_tree = s21::RBTree<value_type, MapComparator, Allocator>;
   using iterator = typename rb_tree::iterator;
   using const_iterator = typename rb_tree::const_iterator;
+  using reverse_iterator = typename rb_tree::reverse_iterator;
+  using const_reverse_iterator = typename rb_tree::const_reverse_iterator;
+  using node_type = typename rb_tree::node_handle;
+  using insert_return_type = s21::RBTInsertReturn<iterator, node_type>;
 
   // Map Member functions:
   Map();
+  explicit Map(const allocator_type &alloc);
   Map(std::initializer_list<value_type> const &items);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  Map(InputIt first, InputIt last);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  Map(sorted_unique_t, InputIt first, InputIt last);
   Map(const Map &m);
   Map(Map &&m) noexcept;
   ~Map();
   Map &operator=(const Map &m);
-  Map &operator=(Map &&m) noexcept;
+  Map &operator=(Map &&m) noexcept(rb_tree::kNothrowMoveAssign);
+  allocator_type get_allocator() const noexcept;
 
   // Map Element access:
   mapped_type &at(const key_type &key);
@@ -63,18 +104,31 @@ public:
   iterator end() noexcept;
   const_iterator begin() const noexcept;
   const_iterator end() const noexcept;
+  reverse_iterator rbegin() noexcept;
+  reverse_iterator rend() noexcept;
+  const_reverse_iterator rbegin() const noexcept;
+  const_reverse_iterator rend() const noexcept;
 
   // Map Capacity:
   bool empty() const noexcept;
   size_type size() const noexcept;
   size_type max_size() const noexcept;
+  void reserve(size_type count);
 
   // Map Modifiers:
   void clear() noexcept;
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  void assign(InputIt first, InputIt last);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  void assign(sorted_unique_t, InputIt first, InputIt last);
   std::pair<iterator, bool> insert(
       const value_type &value); // вставляет узел и возвращает итератор
                                 // до места расположения элемента в контейнере
                                 // и bool обозначающий, произошла ли вставка
+  std::pair<iterator, bool> insert(value_type &&value);
+  iterator insert(const_iterator hint, const value_type &value);
+  iterator insert(const_iterator hint, value_type &&value);
+  insert_return_type insert(node_type &&node);
 
   std::pair<iterator, bool>
   insert(const key_type &key,
@@ -83,39 +137,118 @@ public:
                     // по месту расположения элемента в контейнере и bool,
                     // обозначающий, произошла ли вставка
 
+  template <typename M>
   std::pair<iterator, bool> insert_or_assign(
       const key_type &key,
-      const mapped_type &obj); // вставляет элемент или присваивает
-                               // текущему элементу, если ключ уже существует
+      M &&obj); // вставляет элемент или присваивает
+                // текущему элементу, если ключ уже существует
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(key_type &&key, M &&obj);
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(
+      const key_type &key,
+      Args &&...args); // строит значение из args, только если ключа ещё нет
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(key_type &&key, Args &&...args);
 
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
 
   void erase(iterator pos) noexcept;
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type &key); // возвращает число удалённых
+  node_type extract(const_iterator pos); // забирает узел из дерева
+  node_type extract(const key_type &key);
   void swap(Map &other) noexcept;
   void merge(Map &other);
+  template <typename... Args>
   std::pair<iterator, bool>
-  emplace(Key &&key,
-          Value &&value); // метод emplace предназначен для вставки элемента
-                          // в контейнер, используя перемещение (move semantics)
-                          // вместо копирования
+  emplace(Args &&...args); // строит пару прямо в узле дерева из аргументов
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args);
 
   // Map Lookup:
   bool
   contains(const key_type &key) const; // проверяет, есть ли в контейнере
                                        // элемент с ключом, эквивалентным ключу
+  size_type count(const Key &key) const;
+  size_type count_range(const Key &lo, const Key &hi) const;
   iterator find(const Key &key);
   const_iterator find(const Key &key) const;
+  std::pair<iterator, iterator> equal_range(const Key &key);
+  std::pair<const_iterator, const_iterator> equal_range(const Key &key) const;
+
+  // Map Heterogeneous lookup (only if Compare::is_transparent):
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  bool contains(const K &key) const;
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  size_type count(const K &key) const;
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  iterator find(const K &key);
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  const_iterator find(const K &key) const;
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  std::pair<iterator, iterator> equal_range(const K &key);
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  std::pair<const_iterator, const_iterator> equal_range(const K &key) const;
+
+  // Map Batched lookup (descents of several keys are interleaved):
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out);
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+
+  // Map Order statistics:
+  size_type rank(const Key &key) const;
+  iterator nth(size_type k) noexcept;
+  const_iterator nth(size_type k) const noexcept;
+  const_reference select(size_type k) const;
+
+  // Map Set algebra (O(n + m), in parallel for large operands):
+  Map set_union(const Map &other) const;
+  Map set_intersection(const Map &other) const;
+  Map set_difference(const Map &other) const;
+  Map symmetric_difference(const Map &other) const;
+
+  // Map Split and join (O(log n)):
+  Map split(const key_type &key); // забирает ключи не меньше key
+  void join(Map &other);
+
+  // Map Freezing (immutable copy for lookups only, see s21_frozen_map.h):
+  FrozenMap<Key, Value, Compare, Allocator> freeze() const;
+
+  // Map Snapshots (binary, in key order, see snapshot.h):
+  void save(int fd) const;
+  void load(int fd); // O(n): строит дерево из упорядоченных ключей
 
   // Debugging methods:
   void drawMap() const;
 
 private:
+  template <typename K, typename V, typename C, typename A, typename Pred>
+  friend typename Map<K, V, C, A>::size_type
+  erase_if(Map<K, V, C, A> &map, Pred pred);
+
   rb_tree tree_;
 };
 
+template <typename Key, typename Value, typename Compare, typename Allocator,
+          typename Pred>
+typename Map<Key, Value, Compare, Allocator>::size_type
+erase_if(Map<Key, Value, Compare, Allocator> &map, Pred pred);
+
 } // namespace s21
 
 #include "s21_map.tpp"
+#include "s21_frozen_map.h" // определение Map::freeze
 
 #endif // CPP2_S21_CONTAINERS_MAP_H_
@@ -22,60 +22,120 @@ namespace s21 {
 /**
  * @brief Default constructor.
  */
-template <typename Key, typename Value> Map<Key, Value>::Map() : tree_() {}
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Map<Key, Value, Compare, Allocator>::Map() : tree_() {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator used for all nodes of the Map.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Map<Key, Value, Compare, Allocator>::Map(const allocator_type &alloc)
+    : tree_(alloc) {}
 
 /**
  * @brief Constructor with initializer list.
  * @param items Initializer list of value_type.
  */
-template <typename Key, typename Value>
-Map<Key, Value>::Map(std::initializer_list<value_type> const &items) : tree_() {
-  for (auto item : items) {
-    this->tree_.insertUnique(item);
-  }
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Map<Key, Value, Compare, Allocator>::Map(
+    std::initializer_list<value_type> const &items)
+    : tree_() {
+  this->tree_.assign(items.begin(), items.end(), true);
+}
+
+/**
+ * @brief Range constructor.
+ *
+ * A sorted forward range is built in O(n), any other range is inserted
+ * element by element. Equivalent keys are stored once.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+Map<Key, Value, Compare, Allocator>::Map(InputIt first, InputIt last)
+    : tree_() {
+  this->tree_.assign(first, last, true);
+}
+
+/**
+ * @brief Range constructor for input that is already sorted by key and
+ * has no duplicates.
+ *
+ * The order is not checked, the tree is built in O(n).
+ * @param first Beginning of the sorted range.
+ * @param last End of the sorted range.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+Map<Key, Value, Compare, Allocator>::Map(sorted_unique_t, InputIt first,
+                                         InputIt last)
+    : tree_() {
+  this->tree_.assignSorted(first, last, true);
 }
 
 /**
  * @brief Copy constructor.
  * @param m Map to copy.
  */
-template <typename Key, typename Value>
-Map<Key, Value>::Map(const Map &m) : tree_(m.tree_) {}
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Map<Key, Value, Compare, Allocator>::Map(const Map &m) : tree_(m.tree_) {}
 
 /**
  * @brief Move constructor.
  * @param m Map to move.
  */
-template <typename Key, typename Value>
-Map<Key, Value>::Map(Map &&m) noexcept : tree_(std::move(m.tree_)) {}
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Map<Key, Value, Compare, Allocator>::Map(Map &&m) noexcept
+    : tree_(std::move(m.tree_)) {}
 
 /**
  * @brief Destructor.
  */
-template <typename Key, typename Value> Map<Key, Value>::~Map() = default;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Map<Key, Value, Compare, Allocator>::~Map() = default;
 
 /**
  * @brief Copy assignment operator.
  * @param m Map to copy.
  * @return Reference to this Map.
  */
-template <typename Key, typename Value>
-Map<Key, Value> &Map<Key, Value>::operator=(const Map &m) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Map<Key, Value, Compare, Allocator> &
+Map<Key, Value, Compare, Allocator>::operator=(const Map &m) {
   this->tree_ = m.tree_;
   return *this;
 }
 
 /**
  * @brief Move assignment operator.
+ *
+ * The nodes are taken over unless the allocators differ and do not
+ * propagate; then the elements are moved into new nodes (see RBTree).
  * @param m Map to move.
  * @return Reference to this Map.
+ * @throws std::bad_alloc and exceptions of the element constructor, only
+ * if the allocator neither propagates nor is always equal.
  */
-template <typename Key, typename Value>
-Map<Key, Value> &Map<Key, Value>::operator=(Map &&m) noexcept {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Map<Key, Value, Compare, Allocator> &
+Map<Key, Value, Compare, Allocator>::operator=(Map &&m) noexcept(
+    rb_tree::kNothrowMoveAssign) {
   this->tree_ = std::move(m.tree_);
   return *this;
 }
 
+/**
+ * @brief Returns the allocator associated with the Map.
+ * @return Copy of the allocator.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::allocator_type
+Map<Key, Value, Compare, Allocator>::get_allocator() const noexcept {
+  return tree_.get_allocator();
+}
+
 /******************************************************************************
  * MAIN METHODS
  ******************************************************************************/
@@ -87,9 +147,9 @@ Map<Key, Value> &Map<Key, Value>::operator=(Map &&m) noexcept {
  * @return Reference to the mapped value.
  * @throws std::out_of_range if key not found.
  */
-template <typename Key, typename Value>
-typename Map<Key, Value>::mapped_type &
-Map<Key, Value>::at(const key_type &key) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::mapped_type &
+Map<Key, Value, Compare, Allocator>::at(const key_type &key) {
   auto it = this->find(key);
   if (it == this->end()) {
     throw std::out_of_range("Key not found");
@@ -102,9 +162,9 @@ Map<Key, Value>::at(const key_type &key) {
  * @param key Key of the element to access.
  * @return Reference to the mapped value.
  */
-template <typename Key, typename T>
-typename Map<Key, T>::mapped_type &
-Map<Key, T>::operator[](const key_type &key) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::mapped_type &
+Map<Key, Value, Compare, Allocator>::operator[](const key_type &key) {
   auto it = this->find(key);
 
   // если элемент найден, вернуть его значение
@@ -114,8 +174,7 @@ Map<Key, T>::operator[](const key_type &key) {
 
   // если элемент не найден,
   // вставить новый элемент с ключом `key` и значением по умолчанию
-  auto [new_it, inserted] = this->tree_.insertUnique({key, mapped_type{}});
-  return new_it->second;
+  return try_emplace(key).first->second;
 }
 
 // Map Iterators
@@ -123,8 +182,9 @@ Map<Key, T>::operator[](const key_type &key) {
  * @brief Returns an iterator to the beginning.
  * @return Iterator to the beginning.
  */
-template <typename Key, typename Value>
-typename Map<Key, Value>::iterator Map<Key, Value>::begin() noexcept {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::iterator
+Map<Key, Value, Compare, Allocator>::begin() noexcept {
   return this->tree_.begin();
 }
 
@@ -132,8 +192,9 @@ typename Map<Key, Value>::iterator Map<Key, Value>::begin() noexcept {
  * @brief Returns an iterator to the end.
  * @return Iterator to the end.
  */
-template <typename Key, typename Value>
-typename Map<Key, Value>::iterator Map<Key, Value>::end() noexcept {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::iterator
+Map<Key, Value, Compare, Allocator>::end() noexcept {
   return this->tree_.end();
 }
 
@@ -141,9 +202,9 @@ typename Map<Key, Value>::iterator Map<Key, Value>::end() noexcept {
  * @brief Returns a const iterator to the beginning.
  * @return Const iterator to the beginning.
  */
-template <typename Key, typename Value>
-typename Map<Key, Value>::const_iterator
-Map<Key, Value>::begin() const noexcept {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::const_iterator
+Map<Key, Value, Compare, Allocator>::begin() const noexcept {
   return this->tree_.begin();
 }
 
@@ -151,18 +212,59 @@ Map<Key, Value>::begin() const noexcept {
  * @brief Returns a const iterator to the end.
  * @return Const iterator to the end.
  */
-template <typename Key, typename Value>
-typename Map<Key, Value>::const_iterator Map<Key, Value>::end() const noexcept {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::const_iterator
+Map<Key, Value, Compare, Allocator>::end() const noexcept {
   return this->tree_.end();
 }
 
+/**
+ * @brief Returns a reverse iterator to the last element.
+ * @return A reverse iterator to the last element.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::reverse_iterator
+Map<Key, Value, Compare, Allocator>::rbegin() noexcept {
+  return this->tree_.rbegin();
+}
+
+/**
+ * @brief Returns a reverse iterator to the reverse end.
+ * @return A reverse iterator to the reverse end.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::reverse_iterator
+Map<Key, Value, Compare, Allocator>::rend() noexcept {
+  return this->tree_.rend();
+}
+
+/**
+ * @brief Returns a const reverse iterator to the last element.
+ * @return A const reverse iterator to the last element.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::const_reverse_iterator
+Map<Key, Value, Compare, Allocator>::rbegin() const noexcept {
+  return this->tree_.rbegin();
+}
+
+/**
+ * @brief Returns a const reverse iterator to the reverse end.
+ * @return A const reverse iterator to the reverse end.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::const_reverse_iterator
+Map<Key, Value, Compare, Allocator>::rend() const noexcept {
+  return this->tree_.rend();
+}
+
 // Map Capacity
 /**
  * @brief Checks whether the container is empty.
  * @return True if the container is empty, false otherwise.
  */
-template <typename Key, typename Value>
-bool Map<Key, Value>::empty() const noexcept {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool Map<Key, Value, Compare, Allocator>::empty() const noexcept {
   return this->tree_.empty();
 }
 
@@ -170,8 +272,8 @@ bool Map<Key, Value>::empty() const noexcept {
  * @brief Returns the number of elements.
  * @return The number of elements.
  */
-template <typename Key, typename Value>
-size_t Map<Key, Value>::size() const noexcept {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+size_t Map<Key, Value, Compare, Allocator>::size() const noexcept {
   return this->tree_.size();
 }
 
@@ -179,19 +281,58 @@ size_t Map<Key, Value>::size() const noexcept {
  * @brief Returns the maximum possible number of elements.
  * @return The maximum possible number of elements.
  */
-template <typename Key, typename Value>
-size_t Map<Key, Value>::max_size() const noexcept {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+size_t Map<Key, Value, Compare, Allocator>::max_size() const noexcept {
   return this->tree_.max_size();
 }
 
+/**
+ * @brief Preallocates nodes for count elements.
+ * @param count Number of elements to reserve memory for.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void Map<Key, Value, Compare, Allocator>::reserve(size_type count) {
+  this->tree_.reserve(count);
+}
+
 // Map Modifiers
 /**
  * @brief Clears the contents.
  */
-template <typename Key, typename Value> void Map<Key, Value>::clear() noexcept {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void Map<Key, Value, Compare, Allocator>::clear() noexcept {
   return this->tree_.clear();
 }
 
+/**
+ * @brief Replaces the contents with the keys from [first, last).
+ *
+ * A sorted forward range is built in O(n), any other range is inserted
+ * element by element. Equivalent keys are stored once.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+void Map<Key, Value, Compare, Allocator>::assign(InputIt first, InputIt last) {
+  this->tree_.assign(first, last, true);
+}
+
+/**
+ * @brief Replaces the contents with a range that is already sorted by key
+ * and has no duplicates.
+ *
+ * The order is not checked, the tree is built in O(n).
+ * @param first Beginning of the sorted range.
+ * @param last End of the sorted range.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+void Map<Key, Value, Compare, Allocator>::assign(sorted_unique_t, InputIt first,
+                                                InputIt last) {
+  this->tree_.assignSorted(first, last, true);
+}
+
 /**
  * @brief Inserts elements.
  * @param value Value to insert.
@@ -199,30 +340,159 @@ template <typename Key, typename Value> void Map<Key, Value>::clear() noexcept {
  * element that prevented the insertion) and a bool denoting whether the
  * insertion took place.
  */
-template <typename Key, typename Value>
-std::pair<typename Map<Key, Value>::iterator, bool>
-Map<Key, Value>::insert(const value_type &value) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename Map<Key, Value, Compare, Allocator>::iterator, bool>
+Map<Key, Value, Compare, Allocator>::insert(const value_type &value) {
   return this->tree_.insertUnique(value);
 }
 
+/**
+ * @brief Inserts an element, moving it into the container.
+ * @param value Value to insert; left untouched if the key already exists.
+ * @return Pair consisting of an iterator to the inserted element (or to the
+ * element that prevented the insertion) and a bool denoting whether the
+ * insertion took place.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename Map<Key, Value, Compare, Allocator>::iterator, bool>
+Map<Key, Value, Compare, Allocator>::insert(value_type &&value) {
+  return this->tree_.insertUnique(std::move(value));
+}
+
+/**
+ * @brief Inserts an element, using hint as a suggestion for its place.
+ *
+ * If the key belongs right before hint (or after the last element for
+ * end()), the element is linked without a search from the root.
+ * @param hint Iterator to the element before which value is expected.
+ * @param value Value to insert.
+ * @return Iterator to the inserted element or to the element that prevented
+ * the insertion.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::iterator
+Map<Key, Value, Compare, Allocator>::insert(const_iterator hint,
+                                            const value_type &value) {
+  return this->tree_.insertUnique(hint, value);
+}
+
+/**
+ * @brief Inserts an element moved into the container, using hint as a
+ * suggestion for its place.
+ * @param hint Iterator to the element before which value is expected.
+ * @param value Value to insert; left untouched if the key already exists.
+ * @return Iterator to the inserted element or to the element that prevented
+ * the insertion.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::iterator
+Map<Key, Value, Compare, Allocator>::insert(const_iterator hint,
+                                            value_type &&value) {
+  return this->tree_.insertUnique(hint, std::move(value));
+}
+
+/**
+ * @brief Inserts a value by key.
+ * @param key Key of the element to insert.
+ * @param obj Value to insert.
+ * @return Pair consisting of an iterator to the inserted element (or to the
+ * element that prevented the insertion) and a bool denoting whether the
+ * insertion took place.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename Map<Key, Value, Compare, Allocator>::iterator, bool>
+Map<Key, Value, Compare, Allocator>::insert(const key_type &key,
+                                             const mapped_type &obj) {
+  return try_emplace(key, obj);
+}
+
 /**
  * @brief Inserts elements or assigns if the key already exists.
+ *
+ * One descent of the tree: the node is created only if the key is absent,
+ * otherwise obj is assigned (moved if it is an rvalue) to the existing value.
  * @param key Key of the element to insert.
  * @param obj Value to insert or assign.
  * @return Pair consisting of an iterator to the inserted element (or to the
  * element that prevented the insertion) and a bool denoting whether the
  * insertion took place.
  */
-template <typename Key, typename Value>
-std::pair<typename Map<Key, Value>::iterator, bool>
-Map<Key, Value>::insert_or_assign(const key_type &key, const mapped_type &obj) {
-  auto it = this->find(key);
-  if (it != this->end()) {
-    it->second = obj;
-    return {it, false};
-  } else {
-    return this->tree_.insertUnique({key, obj});
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename M>
+std::pair<typename Map<Key, Value, Compare, Allocator>::iterator, bool>
+Map<Key, Value, Compare, Allocator>::insert_or_assign(const key_type &key,
+                                                       M &&obj) {
+  // tryEmplace не трогает obj, если ключ уже есть
+  auto result = this->tree_.tryEmplace(
+      key, std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<M>(obj)));
+  if (!result.second) {
+    result.first->second = std::forward<M>(obj);
+  }
+  return result;
+}
+
+/**
+ * @brief Inserts elements or assigns if the key already exists.
+ * @param key Key of the element to insert, moved into the new node.
+ * @param obj Value to insert or assign.
+ * @return Pair consisting of an iterator to the inserted element (or to the
+ * element that prevented the insertion) and a bool denoting whether the
+ * insertion took place.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename M>
+std::pair<typename Map<Key, Value, Compare, Allocator>::iterator, bool>
+Map<Key, Value, Compare, Allocator>::insert_or_assign(key_type &&key, M &&obj) {
+  auto result = this->tree_.tryEmplace(
+      key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+      std::forward_as_tuple(std::forward<M>(obj)));
+  if (!result.second) {
+    result.first->second = std::forward<M>(obj);
   }
+  return result;
+}
+
+/**
+ * @brief Inserts an element with the value constructed in-place from args
+ * if the key does not exist.
+ *
+ * If the key already exists, nothing is allocated or constructed and args
+ * are not moved from.
+ * @param key Key of the element to insert.
+ * @param args Arguments forwarded to the constructor of the mapped value.
+ * @return Pair consisting of an iterator to the inserted element (or to the
+ * element that prevented the insertion) and a bool denoting whether the
+ * insertion took place.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename Map<Key, Value, Compare, Allocator>::iterator, bool>
+Map<Key, Value, Compare, Allocator>::try_emplace(const key_type &key,
+                                                  Args &&...args) {
+  return this->tree_.tryEmplace(
+      key, std::piecewise_construct, std::forward_as_tuple(key),
+      std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Inserts an element with the value constructed in-place from args
+ * if the key does not exist.
+ * @param key Key of the element to insert, moved into the new node only if
+ * the insertion takes place.
+ * @param args Arguments forwarded to the constructor of the mapped value.
+ * @return Pair consisting of an iterator to the inserted element (or to the
+ * element that prevented the insertion) and a bool denoting whether the
+ * insertion took place.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename Map<Key, Value, Compare, Allocator>::iterator, bool>
+Map<Key, Value, Compare, Allocator>::try_emplace(key_type &&key,
+                                                  Args &&...args) {
+  return this->tree_.tryEmplace(
+      key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+      std::forward_as_tuple(std::forward<Args>(args)...));
 }
 
 /**
@@ -232,10 +502,11 @@ Map<Key, Value>::insert_or_assign(const key_type &key, const mapped_type &obj) {
  * @return A vector of pairs, where each pair contains an iterator to the
  * inserted element and a boolean indicating success.
  */
-template <typename Key, typename Value>
+template <typename Key, typename Value, typename Compare, typename Allocator>
 template <typename... Args>
-std::vector<std::pair<typename Map<Key, Value>::iterator, bool>>
-Map<Key, Value>::insert_many(Args &&...args) {
+std::vector<
+    std::pair<typename Map<Key, Value, Compare, Allocator>::iterator, bool>>
+Map<Key, Value, Compare, Allocator>::insert_many(Args &&...args) {
   std::vector<std::pair<iterator, bool>> results;
   (results.push_back(insert(std::forward<Args>(args))), ...);
   return results;
@@ -245,54 +516,193 @@ Map<Key, Value>::insert_many(Args &&...args) {
  * @brief Erases an element.
  * @param pos Iterator to the element to erase.
  */
-template <typename Key, typename Value>
-void Map<Key, Value>::erase(iterator pos) noexcept {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void Map<Key, Value, Compare, Allocator>::erase(iterator pos) noexcept {
   this->tree_.erase(pos);
 }
 
+/**
+ * @brief Erases the elements in [first, last).
+ *
+ * Long ranges are cut out of the tree as a whole and the tree is rebalanced
+ * once, in O(log n).
+ *
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @return iterator Iterator to last.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::iterator
+Map<Key, Value, Compare, Allocator>::erase(const_iterator first,
+                                           const_iterator last) {
+  return this->tree_.erase(first, last);
+}
+
+/**
+ * @brief Erases the element with the key equivalent to key, if any.
+ * @param key Key to erase.
+ * @return size_type Number of erased elements.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::size_type
+Map<Key, Value, Compare, Allocator>::erase(const key_type &key) {
+  return this->tree_.eraseEqual(key);
+}
+
 /**
  * @brief Swaps the contents.
  * @param other Map to swap with.
  */
-template <typename Key, typename Value>
-void Map<Key, Value>::swap(Map &other) noexcept {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void Map<Key, Value, Compare, Allocator>::swap(Map &other) noexcept {
   std::swap(this->tree_, other.tree_);
 }
 
 /**
  * @brief Merges elements from another map.
+ *
+ * The nodes are moved between the trees without copying the elements; with
+ * equal allocators no memory is allocated. Elements whose keys are already
+ * present stay in other.
  * @param other Map to merge from.
  */
-template <typename Key, typename Value>
-void Map<Key, Value>::merge(Map &other) {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void Map<Key, Value, Compare, Allocator>::merge(Map &other) {
   this->tree_.mergeUnique(other.tree_);
 }
 
+/**
+ * @brief Inserts the node owned by a node handle.
+ *
+ * The node is linked as is: no memory is allocated and the element is not
+ * copied.
+ * @param node Node handle, obtained from extract() of a container with an
+ * equal allocator.
+ * @return Iterator to the inserted element (or to the element that prevented
+ * the insertion), whether the insertion took place, and the node handle,
+ * which keeps the node if the key already exists.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::insert_return_type
+Map<Key, Value, Compare, Allocator>::insert(node_type &&node) {
+  auto result = this->tree_.insertUnique(std::move(node));
+  return {result.first, result.second, std::move(node)};
+}
+
+/**
+ * @brief Removes the element at pos and returns its node.
+ * @param pos Iterator to the element to extract, must be dereferenceable.
+ * @return Node handle owning the element.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::node_type
+Map<Key, Value, Compare, Allocator>::extract(const_iterator pos) {
+  return this->tree_.extract(pos);
+}
+
+/**
+ * @brief Removes the element with the given key and returns its node.
+ * @param key Key of the element to extract.
+ * @return Node handle owning the element, empty if there is no such key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::node_type
+Map<Key, Value, Compare, Allocator>::extract(const key_type &key) {
+  auto it = this->tree_.find(key); // дерево хранит пары - ищем по ключу
+  return it == this->tree_.end() ? node_type() : this->tree_.extract(it);
+}
+
 /**
  * @brief Checks if the container contains an element with a specific key.
  * @param key Key of the element to search for.
  * @return True if the container contains an element with the key, false
  * otherwise.
  */
-template <typename Key, typename Value>
-bool Map<Key, Value>::contains(const Key &key) const {
-  return find(key) != end();
-  // return this->tree_.contains(key);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool Map<Key, Value, Compare, Allocator>::contains(const Key &key) const {
+  return this->tree_.contains(key);
+}
+
+/**
+ * @brief Returns the number of elements with a specific key.
+ * @param key Key of the elements to count.
+ * @return 1 if the container contains the key, 0 otherwise.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::size_type
+Map<Key, Value, Compare, Allocator>::count(const Key &key) const {
+  return this->tree_.contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Returns the number of elements with keys in [lo, hi).
+ *
+ * Uses the subtree sizes stored in the tree, O(log n).
+ * @param lo Lower bound of the range, included.
+ * @param hi Upper bound of the range, excluded.
+ * @return The number of elements, 0 if hi is not greater than lo.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::size_type
+Map<Key, Value, Compare, Allocator>::count_range(const Key &lo,
+                                                 const Key &hi) const {
+  return this->tree_.count_range(lo, hi);
 }
 
 /**
  * @brief Inserts a new element constructed in-place.
- * @param key Key of the element to insert.
- * @param value Value of the element to insert.
+ *
+ * The pair is constructed once, directly in the tree node. For the
+ * (key, value) form with a key_type key the lookup is done first, so an
+ * existing key costs no allocation.
+ * @param args Arguments forwarded to the constructor of value_type.
  * @return Pair consisting of an iterator to the inserted element (or to the
  * element that prevented the insertion) and a bool denoting whether the
  * insertion took place.
  */
-template <typename Key, typename Value>
-std::pair<typename Map<Key, Value>::iterator, bool>
-Map<Key, Value>::emplace(Key &&key, Value &&value) {
-  value_type new_value(std::forward<Key>(key), std::forward<Value>(value));
-  return tree_.insertUnique(new_value);
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename Map<Key, Value, Compare, Allocator>::iterator, bool>
+Map<Key, Value, Compare, Allocator>::emplace(Args &&...args) {
+  if constexpr (sizeof...(Args) == 2) {
+    using First = typename std::decay<
+        typename std::tuple_element<0, std::tuple<Args...>>::type>::type;
+    if constexpr (std::is_same<First, key_type>::value) {
+      // ключ известен до построения пары — ищем его без выделения узла
+      const key_type &key = std::get<0>(std::forward_as_tuple(args...));
+      return this->tree_.tryEmplace(key, std::forward<Args>(args)...);
+    }
+  }
+  return this->tree_.emplaceUnique(std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Inserts a new element constructed in-place, using hint as a
+ * suggestion for its place.
+ *
+ * As in emplace(), for the (key, value) form the key is looked up before
+ * the pair is constructed.
+ * @param hint Iterator to the element before which the key is expected.
+ * @param args Arguments forwarded to the constructor of value_type.
+ * @return Iterator to the inserted element or to the element that prevented
+ * the insertion.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+typename Map<Key, Value, Compare, Allocator>::iterator
+Map<Key, Value, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                                  Args &&...args) {
+  if constexpr (sizeof...(Args) == 2) {
+    using First = typename std::decay<
+        typename std::tuple_element<0, std::tuple<Args...>>::type>::type;
+    if constexpr (std::is_same<First, key_type>::value) {
+      const key_type &key = std::get<0>(std::forward_as_tuple(args...));
+      return this->tree_
+          .tryEmplaceHint(hint, key, std::forward<Args>(args)...)
+          .first;
+    }
+  }
+  return this->tree_.emplaceHintUnique(hint, std::forward<Args>(args)...);
 }
 
 /**
@@ -300,9 +710,10 @@ Map<Key, Value>::emplace(Key &&key, Value &&value) {
  * @param key Key of the element to find.
  * @return Iterator to the element if found, otherwise end().
  */
-template <typename Key, typename Value>
-typename Map<Key, Value>::iterator Map<Key, Value>::find(const Key &key) {
-  return this->tree_.find({key, mapped_type{}});
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::iterator
+Map<Key, Value, Compare, Allocator>::find(const Key &key) {
+  return this->tree_.find(key);
 }
 
 /**
@@ -310,10 +721,353 @@ typename Map<Key, Value>::iterator Map<Key, Value>::find(const Key &key) {
  * @param key Key of the element to find.
  * @return Const iterator to the element if found, otherwise end().
  */
-template <typename Key, typename Value>
-typename Map<Key, Value>::const_iterator
-Map<Key, Value>::find(const Key &key) const {
-  return this->tree_.find({key, mapped_type{}});
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::const_iterator
+Map<Key, Value, Compare, Allocator>::find(const Key &key) const {
+  return this->tree_.find(key);
+}
+
+/**
+ * @brief Returns the range of elements with a specific key.
+ * @param key Key of the elements to search for.
+ * @return Pair of iterators: the element with the key and the one after it,
+ * or two equal iterators if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename Map<Key, Value, Compare, Allocator>::iterator,
+          typename Map<Key, Value, Compare, Allocator>::iterator>
+Map<Key, Value, Compare, Allocator>::equal_range(const Key &key) {
+  return {this->tree_.lower_bound(key), this->tree_.upper_bound(key)};
+}
+
+/**
+ * @brief Returns the range of elements with a specific key.
+ * @param key Key of the elements to search for.
+ * @return Pair of const iterators bounding the elements with the key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::pair<typename Map<Key, Value, Compare, Allocator>::const_iterator,
+          typename Map<Key, Value, Compare, Allocator>::const_iterator>
+Map<Key, Value, Compare, Allocator>::equal_range(const Key &key) const {
+  return {this->tree_.lower_bound(key), this->tree_.upper_bound(key)};
+}
+
+/******************************************************************************
+ * HETEROGENEOUS LOOKUP
+ ******************************************************************************/
+
+// Поиск по значению любого типа K, сравнимого с Key прозрачным Compare
+// (например, std::string_view для Map<std::string, T, std::less<>>):
+// ни Key, ни mapped_type при этом не создаются.
+
+/**
+ * @brief Checks if the container contains an element with a key equivalent
+ * to key.
+ * @param key Value comparable with Key.
+ * @return True if such an element exists, false otherwise.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+bool Map<Key, Value, Compare, Allocator>::contains(const K &key) const {
+  return this->tree_.contains(key);
+}
+
+/**
+ * @brief Returns the number of elements with a key equivalent to key.
+ * @param key Value comparable with Key.
+ * @return 1 if such an element exists, 0 otherwise.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename Map<Key, Value, Compare, Allocator>::size_type
+Map<Key, Value, Compare, Allocator>::count(const K &key) const {
+  return this->tree_.contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Finds an element with a key equivalent to key.
+ * @param key Value comparable with Key.
+ * @return Iterator to the element if found, otherwise end().
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename Map<Key, Value, Compare, Allocator>::iterator
+Map<Key, Value, Compare, Allocator>::find(const K &key) {
+  return this->tree_.find(key);
+}
+
+/**
+ * @brief Finds an element with a key equivalent to key.
+ * @param key Value comparable with Key.
+ * @return Const iterator to the element if found, otherwise end().
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename Map<Key, Value, Compare, Allocator>::const_iterator
+Map<Key, Value, Compare, Allocator>::find(const K &key) const {
+  return this->tree_.find(key);
+}
+
+/**
+ * @brief Returns the range of elements with a key equivalent to key.
+ * @param key Value comparable with Key.
+ * @return Pair of iterators bounding the matching elements.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+std::pair<typename Map<Key, Value, Compare, Allocator>::iterator,
+          typename Map<Key, Value, Compare, Allocator>::iterator>
+Map<Key, Value, Compare, Allocator>::equal_range(const K &key) {
+  return {this->tree_.lower_bound(key), this->tree_.upper_bound(key)};
+}
+
+/**
+ * @brief Returns the range of elements with a key equivalent to key.
+ * @param key Value comparable with Key.
+ * @return Pair of const iterators bounding the matching elements.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+std::pair<typename Map<Key, Value, Compare, Allocator>::const_iterator,
+          typename Map<Key, Value, Compare, Allocator>::const_iterator>
+Map<Key, Value, Compare, Allocator>::equal_range(const K &key) const {
+  return {this->tree_.lower_bound(key), this->tree_.upper_bound(key)};
+}
+
+/******************************************************************************
+ * BATCHED LOOKUP
+ ******************************************************************************/
+
+// Поиск пачки ключей: спуски по дереву идут вперемешку, промахи кэша
+// разных ключей перекрываются (см. RBTree::findMany).
+
+/**
+ * @brief Finds every key of a range, like find() called for each key.
+ * @param first, last Range of keys (forward iterators).
+ * @param out Receives an iterator to the found element or end() for each
+ * key, in the order of the range.
+ * @return Output iterator past the last written one.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt Map<Key, Value, Compare, Allocator>::find_many(
+    ForwardIt first, ForwardIt last, OutputIt out) {
+  return this->tree_.findMany(first, last, out);
+}
+
+/**
+ * @brief Finds every key of a range, like find() called for each key.
+ * @param first, last Range of keys (forward iterators).
+ * @param out Receives a const iterator to the found element or end() for
+ * each key, in the order of the range.
+ * @return Output iterator past the last written one.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt Map<Key, Value, Compare, Allocator>::find_many(
+    ForwardIt first, ForwardIt last, OutputIt out) const {
+  return this->tree_.findMany(first, last, out);
+}
+
+/**
+ * @brief Checks every key of a range, like contains() called for each key.
+ * @param first, last Range of keys (forward iterators).
+ * @param out Receives true or false for each key, in the order of the range.
+ * @return Output iterator past the last written one.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt Map<Key, Value, Compare, Allocator>::contains_many(
+    ForwardIt first, ForwardIt last, OutputIt out) const {
+  return this->tree_.containsMany(first, last, out);
+}
+
+/******************************************************************************
+ * ORDER STATISTICS
+ ******************************************************************************/
+
+/**
+ * @brief Returns the number of elements with keys less than key, O(log n).
+ * @param key Key to rank.
+ * @return Position of the first element not less than key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::size_type
+Map<Key, Value, Compare, Allocator>::rank(const Key &key) const {
+  return this->tree_.rank(key);
+}
+
+/**
+ * @brief Returns an iterator to the element at position k in key order,
+ * O(log n).
+ * @param k Zero-based position.
+ * @return Iterator to the k-th element, end() if k >= size().
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::iterator
+Map<Key, Value, Compare, Allocator>::nth(size_type k) noexcept {
+  return this->tree_.nth(k);
+}
+
+/**
+ * @brief Returns a const iterator to the element at position k in key order,
+ * O(log n).
+ * @param k Zero-based position.
+ * @return Const iterator to the k-th element, end() if k >= size().
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::const_iterator
+Map<Key, Value, Compare, Allocator>::nth(size_type k) const noexcept {
+  return this->tree_.nth(k);
+}
+
+/**
+ * @brief Returns the element at position k in key order, O(log n).
+ * @param k Zero-based position.
+ * @return The k-th smallest element.
+ * @throws std::out_of_range if k >= size().
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename Map<Key, Value, Compare, Allocator>::const_reference
+Map<Key, Value, Compare, Allocator>::select(size_type k) const {
+  return this->tree_.select(k);
+}
+
+/**
+ * @brief Returns the elements that are in this map or in other.
+ *
+ * Both maps are walked once in key order and the result is built from
+ * the sorted sequence in O(n + m); large operands are merged by several
+ * threads. For a key present in both maps the element of this map is
+ * taken.
+ * @param other The second operand.
+ * @return A new map with the allocator of this one.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Map<Key, Value, Compare, Allocator>
+Map<Key, Value, Compare, Allocator>::set_union(const Map &other) const {
+  Map result(get_allocator());
+  result.tree_ = this->tree_.setUnion(other.tree_);
+  return result;
+}
+
+/**
+ * @brief Returns the elements whose keys are both in this map and in other.
+ *
+ * For a key present in both maps the element of this map is taken.
+ * O(n + m).
+ * @param other The second operand.
+ * @return A new map with the allocator of this one.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Map<Key, Value, Compare, Allocator>
+Map<Key, Value, Compare, Allocator>::set_intersection(const Map &other) const {
+  Map result(get_allocator());
+  result.tree_ = this->tree_.setIntersection(other.tree_);
+  return result;
+}
+
+/**
+ * @brief Returns the elements of this map whose keys are not in other.
+ *
+ * O(n + m).
+ * @param other The second operand.
+ * @return A new map with the allocator of this one.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Map<Key, Value, Compare, Allocator>
+Map<Key, Value, Compare, Allocator>::set_difference(const Map &other) const {
+  Map result(get_allocator());
+  result.tree_ = this->tree_.setDifference(other.tree_);
+  return result;
+}
+
+/**
+ * @brief Returns the elements whose keys are in exactly one of the two maps.
+ *
+ * O(n + m).
+ * @param other The second operand.
+ * @return A new map with the allocator of this one.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Map<Key, Value, Compare, Allocator>
+Map<Key, Value, Compare, Allocator>::symmetric_difference(
+    const Map &other) const {
+  Map result(get_allocator());
+  result.tree_ = this->tree_.symmetricDifference(other.tree_);
+  return result;
+}
+
+/**
+ * @brief Moves the elements with keys not less than key into a new map.
+ *
+ * The tree is cut along one path in O(log n); elements are neither copied
+ * nor reallocated.
+ * @param key The split key.
+ * @return A map with the keys not less than key; this map keeps the
+ * smaller ones.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+Map<Key, Value, Compare, Allocator>
+Map<Key, Value, Compare, Allocator>::split(const key_type &key) {
+  Map result(get_allocator());
+  result.tree_ = this->tree_.split(key);
+  return result;
+}
+
+/**
+ * @brief Moves all elements of other into this map in O(log n).
+ *
+ * The keys of other must be entirely before or entirely after the keys
+ * of this map.
+ * @param other Map to take the elements from, left empty.
+ * @throws std::invalid_argument if the key ranges overlap.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void Map<Key, Value, Compare, Allocator>::join(Map &other) {
+  this->tree_.joinUnique(other.tree_);
+}
+
+/******************************************************************************
+ * SNAPSHOTS
+ ******************************************************************************/
+
+/**
+ * @brief Writes a binary snapshot of the map to a file descriptor.
+ *
+ * The elements are written in key order, so load() can build the
+ * tree in O(n). The format is described in SUPPORT_FUNCTIONS/snapshot.h.
+ * @param fd Descriptor open for writing; it is not closed.
+ * @throws std::system_error if the descriptor cannot be written.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void Map<Key, Value, Compare, Allocator>::save(int fd) const {
+  saveSnapshot<value_type>(fd, SnapshotKind::kMap, this->tree_.cbegin(),
+                       this->tree_.size());
+}
+
+/**
+ * @brief Replaces the contents with a snapshot written by save().
+ *
+ * The elements are decoded straight into the nodes of a tree built in
+ * O(n), without inserting them one by one; then one pass checks that they
+ * are in order. If anything fails the map is not changed.
+ * @param fd Descriptor open for reading, positioned at the snapshot; the
+ * data after the snapshot is not read.
+ * @throws std::runtime_error if the data is not a snapshot of this
+ * container, std::invalid_argument if the keys are out of order,
+ * std::system_error if the descriptor cannot be read.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void Map<Key, Value, Compare, Allocator>::load(int fd) {
+  SnapshotReader reader = openSnapshot<value_type>(fd, SnapshotKind::kMap);
+  Map loaded(get_allocator());
+  loaded.tree_.assignSortedN(
+      std::make_move_iterator(
+          SnapshotInputIterator<value_type>(reader, reader.count())),
+      reader.count(), reader.reserveCount(), true);
+  reader.finish();
+  swap(loaded);
 }
 
 /******************************************************************************
@@ -323,14 +1077,15 @@ Map<Key, Value>::find(const Key &key) const {
 /**
  * @brief Prints the map structure for debugging purposes.
  */
-template <typename Key, typename Value> void Map<Key, Value>::drawMap() const {
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void Map<Key, Value, Compare, Allocator>::drawMap() const {
   auto printMapNode =
-      [&](const typename s21::RBTree<value_type, MapComparator>::Node *node,
+      [&](const typename rb_tree::Node *node,
           int depth) {
-        std::string color = (node->red_) ? "R" : "B";
+        std::string color = (node->isRed()) ? "R" : "B";
         int black_height = tree_.blackHeight(node);
         std::cout << std::string(depth * 4, ' ') << "[" << color
-                  << (!node->red_ ? std::to_string(black_height + 1) : "")
+                  << (!node->isRed() ? std::to_string(black_height + 1) : "")
                   << "]"
                   << "{" << node->key_.first << ", " << node->key_.second << "}"
                   << std::endl;
@@ -339,4 +1094,25 @@ template <typename Key, typename Value> void Map<Key, Value>::drawMap() const {
   tree_.printMap(tree_.getRoot(), 0, printMapNode);
 }
 
+/******************************************************************************
+ * NON-MEMBER FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * @brief Erases all elements that satisfy pred, O(n).
+ *
+ * Runs of consecutive matching elements are erased as whole ranges, so
+ * long runs are cut out of the tree at once.
+ *
+ * @param map The container to erase from.
+ * @param pred Predicate called once for every element in key order.
+ * @return size_type Number of erased elements.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator,
+          typename Pred>
+typename Map<Key, Value, Compare, Allocator>::size_type
+erase_if(Map<Key, Value, Compare, Allocator> &map, Pred pred) {
+  return map.tree_.eraseIf(pred);
+}
+
 } // namespace s21
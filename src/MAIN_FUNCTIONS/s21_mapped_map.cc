@@ -0,0 +1 @@
+#include "s21_mapped_map.h"
\ No newline at end of file
@@ -0,0 +1,164 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_mapped_map.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-09-09
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_MAPPED_MAP_H_
+#define CPP2_S21_CONTAINERS_MAPPED_MAP_H_
+
+#include <iterator>
+#include <stdexcept> // std::out_of_range
+#include <string>
+#include <utility> // std::pair
+
+#include "s21_map.h"
+#include "../SUPPORT_FUNCTIONS/mapped_index.h"
+
+namespace s21 {
+
+/**
+ * @brief Read-only map with unique trivially copyable keys and values that
+ * lives in a file mapped into memory.
+ *
+ * The file is written once from a Map by save() and then opened by any
+ * number of processes in O(1) (see MappedSet). The keys and the search
+ * index come first, the values follow in a parallel array, so a lookup
+ * touches only keys until it has found the element. Iterators walk both
+ * arrays and give the element as a pair of references.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class MappedMap {
+public:
+  static_assert(std::is_trivially_copyable<Value>::value,
+                "values of a MappedMap must be trivially copyable");
+  static_assert(alignof(Value) <= 64, "sections are aligned to 64 bytes");
+
+  // MappedMap Member type:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = std::pair<const key_type &, const mapped_type &>;
+  using const_reference = reference;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using mapped_index = s21::MappedIndex<Key, Compare>;
+
+  class MappedMapIterator;
+  using iterator = MappedMapIterator;
+  using const_iterator = MappedMapIterator;
+
+  // MappedMap Member functions:
+  MappedMap() noexcept;
+  explicit MappedMap(const std::string &path);
+  explicit MappedMap(int fd);
+  MappedMap(const MappedMap &m) = delete;
+  MappedMap(MappedMap &&m) noexcept;
+  ~MappedMap();
+  MappedMap &operator=(const MappedMap &m) = delete;
+  MappedMap &operator=(MappedMap &&m) noexcept;
+
+  // MappedMap Writing:
+  template <typename Allocator>
+  static void save(int fd, const Map<Key, Value, Compare, Allocator> &map);
+
+  // MappedMap Iterators:
+  iterator begin() const noexcept;
+  iterator end() const noexcept;
+  const_iterator cbegin() const noexcept;
+  const_iterator cend() const noexcept;
+
+  // MappedMap Capacity:
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type mapped_bytes() const noexcept; // размер отображённого файла
+
+  // MappedMap Lookup:
+  const mapped_type &at(const key_type &key) const;
+  iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key) const;
+
+  void swap(MappedMap &other) noexcept;
+
+  // Debugging methods:
+  bool checkInvariants() const; // читает весь файл
+
+  /**
+   * @brief Iterator over the parallel arrays of keys and values.
+   *
+   * Dereferencing gives a pair of references into the mapping, so the
+   * iterator is an input iterator for the standard algorithms, although it
+   * can also move backwards.
+   */
+  class MappedMapIterator {
+  public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = MappedMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = MappedMap::reference;
+
+    MappedMapIterator() noexcept = default;
+    MappedMapIterator(const Key *key, const Value *value) noexcept
+        : key_(key), value_(value) {}
+
+    reference operator*() const noexcept { return {*key_, *value_}; }
+    const key_type &key() const noexcept { return *key_; }
+    const mapped_type &value() const noexcept { return *value_; }
+
+    MappedMapIterator &operator++() noexcept {
+      ++key_;
+      ++value_;
+      return *this;
+    }
+    MappedMapIterator operator++(int) noexcept {
+      MappedMapIterator previous = *this;
+      ++*this;
+      return previous;
+    }
+    MappedMapIterator &operator--() noexcept {
+      --key_;
+      --value_;
+      return *this;
+    }
+    MappedMapIterator operator--(int) noexcept {
+      MappedMapIterator previous = *this;
+      --*this;
+      return previous;
+    }
+
+    bool operator==(const MappedMapIterator &other) const noexcept {
+      return key_ == other.key_;
+    }
+    bool operator!=(const MappedMapIterator &other) const noexcept {
+      return key_ != other.key_;
+    }
+
+  private:
+    const Key *key_ = nullptr;
+    const Value *value_ = nullptr;
+  };
+
+private:
+  iterator iteratorAt(size_type position) const noexcept;
+
+  mapped_index index_;
+};
+
+} // namespace s21
+
+#include "s21_mapped_map.tpp"
+
+#endif // CPP2_S21_CONTAINERS_MAPPED_MAP_H_
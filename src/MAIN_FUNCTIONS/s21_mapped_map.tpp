@@ -0,0 +1,269 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_mapped_map.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-09-09
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor: an empty map without a file.
+ */
+template <typename Key, typename Value, typename Compare>
+MappedMap<Key, Value, Compare>::MappedMap() noexcept : index_() {}
+
+/**
+ * @brief Opens and maps a file written by save().
+ * @param path Path of the file.
+ * @throws std::system_error if the file cannot be opened or mapped,
+ * std::runtime_error if it is not a MappedMap file of these key and value
+ * types.
+ */
+template <typename Key, typename Value, typename Compare>
+MappedMap<Key, Value, Compare>::MappedMap(const std::string &path)
+    : index_(path, SnapshotKind::kMappedMap, sizeof(Value)) {}
+
+/**
+ * @brief Maps a file written by save() from an open descriptor, which may
+ * be closed afterwards.
+ * @param fd Descriptor open for reading.
+ * @throws std::system_error if the file cannot be mapped,
+ * std::runtime_error if it is not a MappedMap file of these key and value
+ * types.
+ */
+template <typename Key, typename Value, typename Compare>
+MappedMap<Key, Value, Compare>::MappedMap(int fd)
+    : index_(fd, SnapshotKind::kMappedMap, sizeof(Value)) {}
+
+/**
+ * @brief Move constructor: the mapping passes to the new map.
+ * @param m MappedMap to move; it becomes empty.
+ */
+template <typename Key, typename Value, typename Compare>
+MappedMap<Key, Value, Compare>::MappedMap(MappedMap &&m) noexcept
+    : index_(std::move(m.index_)) {}
+
+/**
+ * @brief Destructor: unmaps the file.
+ */
+template <typename Key, typename Value, typename Compare>
+MappedMap<Key, Value, Compare>::~MappedMap() = default;
+
+/**
+ * @brief Move assignment operator: the old mapping is released.
+ * @param m MappedMap to move; it becomes empty.
+ * @return Reference to this MappedMap.
+ */
+template <typename Key, typename Value, typename Compare>
+MappedMap<Key, Value, Compare> &
+MappedMap<Key, Value, Compare>::operator=(MappedMap &&m) noexcept {
+  this->index_ = std::move(m.index_);
+  return *this;
+}
+
+/**
+ * @brief Writes the elements of a Map as a file that MappedMap can map,
+ * O(n).
+ * @param fd Descriptor open for writing, positioned at the start of the
+ * file (the sections are aligned relative to it).
+ * @param map Map to write.
+ * @throws std::system_error if the descriptor cannot be written.
+ */
+template <typename Key, typename Value, typename Compare>
+template <typename Allocator>
+void MappedMap<Key, Value, Compare>::save(
+    int fd, const Map<Key, Value, Compare, Allocator> &map) {
+  mapped_index::write(
+      fd, SnapshotKind::kMappedMap, map.begin(), map.size(), sizeof(Value),
+      [](const value_type &item) -> const Key & { return item.first; },
+      [](const value_type &item) -> const void * { return &item.second; });
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+// MappedMap Iterators
+/**
+ * @brief Returns an iterator to the element with the smallest key.
+ */
+template <typename Key, typename Value, typename Compare>
+typename MappedMap<Key, Value, Compare>::iterator
+MappedMap<Key, Value, Compare>::begin() const noexcept {
+  return iteratorAt(0);
+}
+
+/**
+ * @brief Returns an iterator past the element with the largest key.
+ */
+template <typename Key, typename Value, typename Compare>
+typename MappedMap<Key, Value, Compare>::iterator
+MappedMap<Key, Value, Compare>::end() const noexcept {
+  return iteratorAt(size());
+}
+
+template <typename Key, typename Value, typename Compare>
+typename MappedMap<Key, Value, Compare>::const_iterator
+MappedMap<Key, Value, Compare>::cbegin() const noexcept {
+  return begin();
+}
+
+template <typename Key, typename Value, typename Compare>
+typename MappedMap<Key, Value, Compare>::const_iterator
+MappedMap<Key, Value, Compare>::cend() const noexcept {
+  return end();
+}
+
+// MappedMap Capacity
+/**
+ * @brief Checks whether the map is empty.
+ */
+template <typename Key, typename Value, typename Compare>
+bool MappedMap<Key, Value, Compare>::empty() const noexcept {
+  return this->index_.size() == 0;
+}
+
+/**
+ * @brief Returns the number of elements.
+ */
+template <typename Key, typename Value, typename Compare>
+typename MappedMap<Key, Value, Compare>::size_type
+MappedMap<Key, Value, Compare>::size() const noexcept {
+  return this->index_.size();
+}
+
+/**
+ * @brief Returns the size of the mapped file; its pages are in the shared
+ * page cache, not on the heap of the process.
+ */
+template <typename Key, typename Value, typename Compare>
+typename MappedMap<Key, Value, Compare>::size_type
+MappedMap<Key, Value, Compare>::mapped_bytes() const noexcept {
+  return this->index_.mappedBytes();
+}
+
+// MappedMap Lookup
+/**
+ * @brief Returns the value of the key.
+ * @param key Key of the element.
+ * @return Reference to the value in the mapping.
+ * @throws std::out_of_range if key not found.
+ */
+template <typename Key, typename Value, typename Compare>
+const Value &
+MappedMap<Key, Value, Compare>::at(const key_type &key) const {
+  iterator it = find(key);
+  if (it == end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it.value();
+}
+
+/**
+ * @brief Finds the element with the key.
+ * @param key Key to search for.
+ * @return Iterator to the element, or end() if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare>
+typename MappedMap<Key, Value, Compare>::iterator
+MappedMap<Key, Value, Compare>::find(const key_type &key) const {
+  size_type position = this->index_.lowerBound(key);
+  if (position == size() ||
+      Compare()(key, this->index_.keys()[position])) {
+    return end();
+  }
+  return iteratorAt(position);
+}
+
+/**
+ * @brief Checks if the map contains the key.
+ */
+template <typename Key, typename Value, typename Compare>
+bool MappedMap<Key, Value, Compare>::contains(const key_type &key) const {
+  return find(key) != end();
+}
+
+/**
+ * @brief Returns the number of elements with the key (0 or 1).
+ */
+template <typename Key, typename Value, typename Compare>
+typename MappedMap<Key, Value, Compare>::size_type
+MappedMap<Key, Value, Compare>::count(const key_type &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Returns an iterator to the first element whose key is not less
+ * than key, or end().
+ */
+template <typename Key, typename Value, typename Compare>
+typename MappedMap<Key, Value, Compare>::iterator
+MappedMap<Key, Value, Compare>::lower_bound(const key_type &key) const {
+  return iteratorAt(this->index_.lowerBound(key));
+}
+
+/**
+ * @brief Returns an iterator to the first element whose key is greater
+ * than key, or end().
+ */
+template <typename Key, typename Value, typename Compare>
+typename MappedMap<Key, Value, Compare>::iterator
+MappedMap<Key, Value, Compare>::upper_bound(const key_type &key) const {
+  return iteratorAt(this->index_.upperBound(key));
+}
+
+/**
+ * @brief Swaps the mappings.
+ * @param other MappedMap to swap with.
+ */
+template <typename Key, typename Value, typename Compare>
+void MappedMap<Key, Value, Compare>::swap(MappedMap &other) noexcept {
+  this->index_.swap(other.index_);
+}
+
+/******************************************************************************
+ * SUPPORT METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Returns an iterator to the element of the given rank.
+ */
+template <typename Key, typename Value, typename Compare>
+typename MappedMap<Key, Value, Compare>::iterator
+MappedMap<Key, Value, Compare>::iteratorAt(
+    size_type position) const noexcept {
+  if (this->index_.keys() == nullptr) {
+    return iterator(); // без файла begin() == end()
+  }
+  return iterator(this->index_.keys() + position,
+                  static_cast<const Value *>(this->index_.values()) +
+                      position);
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks the order of the keys and the search index (see
+ * MappedIndex::checkInvariants); reads the whole file.
+ */
+template <typename Key, typename Value, typename Compare>
+bool MappedMap<Key, Value, Compare>::checkInvariants() const {
+  return this->index_.checkInvariants();
+}
+
+} // namespace s21
@@ -0,0 +1,99 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_mapped_set.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-09-09
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_MAPPED_SET_H_
+#define CPP2_S21_CONTAINERS_MAPPED_SET_H_
+
+#include <string>
+#include <utility> // std::pair
+
+#include "s21_set.h"
+#include "../SUPPORT_FUNCTIONS/mapped_index.h"
+
+namespace s21 {
+
+/**
+ * @brief Read-only set of trivially copyable keys that lives in a file
+ * mapped into memory.
+ *
+ * The file is written once from a Set by save() and then opened by any
+ * number of processes: opening maps it and checks the header in O(1), the
+ * keys are not copied to the heap, and the pages read by lookups stay in
+ * the page cache shared by all processes. The keys lie in increasing order,
+ * so iterators are plain pointers into the mapping; lookups use the search
+ * index of MappedIndex. The set is movable but not copyable, and it must
+ * be opened with the Compare it was written with.
+ */
+template <typename Key, typename Compare = std::less<Key>>
+class MappedSet {
+public:
+  // MappedSet Member type:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = const value_type &;
+  using const_reference = const value_type &;
+  using iterator = const value_type *;
+  using const_iterator = const value_type *;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using mapped_index = s21::MappedIndex<Key, Compare>;
+
+  // MappedSet Member functions:
+  MappedSet() noexcept;
+  explicit MappedSet(const std::string &path);
+  explicit MappedSet(int fd);
+  MappedSet(const MappedSet &s) = delete;
+  MappedSet(MappedSet &&s) noexcept;
+  ~MappedSet();
+  MappedSet &operator=(const MappedSet &s) = delete;
+  MappedSet &operator=(MappedSet &&s) noexcept;
+
+  // MappedSet Writing:
+  template <typename Allocator>
+  static void save(int fd, const Set<Key, Compare, Allocator> &set);
+
+  // MappedSet Iterators:
+  iterator begin() const noexcept;
+  iterator end() const noexcept;
+  const_iterator cbegin() const noexcept;
+  const_iterator cend() const noexcept;
+
+  // MappedSet Capacity:
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type mapped_bytes() const noexcept; // размер отображённого файла
+
+  // MappedSet Lookup:
+  iterator find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  iterator lower_bound(const key_type &key) const;
+  iterator upper_bound(const key_type &key) const;
+  std::pair<iterator, iterator> equal_range(const key_type &key) const;
+
+  void swap(MappedSet &other) noexcept;
+
+  // Debugging methods:
+  bool checkInvariants() const; // читает весь файл
+
+private:
+  mapped_index index_;
+};
+
+} // namespace s21
+
+#include "s21_mapped_set.tpp"
+
+#endif // CPP2_S21_CONTAINERS_MAPPED_SET_H_
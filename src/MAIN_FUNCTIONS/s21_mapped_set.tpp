@@ -0,0 +1,237 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_mapped_set.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-09-09
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor: an empty set without a file.
+ */
+template <typename Key, typename Compare>
+MappedSet<Key, Compare>::MappedSet() noexcept : index_() {}
+
+/**
+ * @brief Opens and maps a file written by save().
+ * @param path Path of the file.
+ * @throws std::system_error if the file cannot be opened or mapped,
+ * std::runtime_error if it is not a MappedSet file of this key type.
+ */
+template <typename Key, typename Compare>
+MappedSet<Key, Compare>::MappedSet(const std::string &path)
+    : index_(path, SnapshotKind::kMappedSet, 0) {}
+
+/**
+ * @brief Maps a file written by save() from an open descriptor, which may
+ * be closed afterwards.
+ * @param fd Descriptor open for reading.
+ * @throws std::system_error if the file cannot be mapped,
+ * std::runtime_error if it is not a MappedSet file of this key type.
+ */
+template <typename Key, typename Compare>
+MappedSet<Key, Compare>::MappedSet(int fd)
+    : index_(fd, SnapshotKind::kMappedSet, 0) {}
+
+/**
+ * @brief Move constructor: the mapping passes to the new set.
+ * @param s MappedSet to move; it becomes empty.
+ */
+template <typename Key, typename Compare>
+MappedSet<Key, Compare>::MappedSet(MappedSet &&s) noexcept
+    : index_(std::move(s.index_)) {}
+
+/**
+ * @brief Destructor: unmaps the file.
+ */
+template <typename Key, typename Compare>
+MappedSet<Key, Compare>::~MappedSet() = default;
+
+/**
+ * @brief Move assignment operator: the old mapping is released.
+ * @param s MappedSet to move; it becomes empty.
+ * @return Reference to this MappedSet.
+ */
+template <typename Key, typename Compare>
+MappedSet<Key, Compare> &
+MappedSet<Key, Compare>::operator=(MappedSet &&s) noexcept {
+  this->index_ = std::move(s.index_);
+  return *this;
+}
+
+/**
+ * @brief Writes the keys of a Set as a file that MappedSet can map, O(n).
+ * @param fd Descriptor open for writing, positioned at the start of the
+ * file (the sections are aligned relative to it).
+ * @param set Set to write.
+ * @throws std::system_error if the descriptor cannot be written.
+ */
+template <typename Key, typename Compare>
+template <typename Allocator>
+void MappedSet<Key, Compare>::save(int fd,
+                                   const Set<Key, Compare, Allocator> &set) {
+  mapped_index::write(
+      fd, SnapshotKind::kMappedSet, set.begin(), set.size(), 0,
+      [](const Key &key) -> const Key & { return key; },
+      [](const Key &key) -> const void * { return &key; });
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+// MappedSet Iterators
+/**
+ * @brief Returns a pointer to the smallest key.
+ */
+template <typename Key, typename Compare>
+typename MappedSet<Key, Compare>::iterator
+MappedSet<Key, Compare>::begin() const noexcept {
+  return this->index_.keys();
+}
+
+/**
+ * @brief Returns a pointer past the largest key.
+ */
+template <typename Key, typename Compare>
+typename MappedSet<Key, Compare>::iterator
+MappedSet<Key, Compare>::end() const noexcept {
+  return this->index_.keys() + this->index_.size();
+}
+
+template <typename Key, typename Compare>
+typename MappedSet<Key, Compare>::const_iterator
+MappedSet<Key, Compare>::cbegin() const noexcept {
+  return begin();
+}
+
+template <typename Key, typename Compare>
+typename MappedSet<Key, Compare>::const_iterator
+MappedSet<Key, Compare>::cend() const noexcept {
+  return end();
+}
+
+// MappedSet Capacity
+/**
+ * @brief Checks whether the set is empty.
+ */
+template <typename Key, typename Compare>
+bool MappedSet<Key, Compare>::empty() const noexcept {
+  return this->index_.size() == 0;
+}
+
+/**
+ * @brief Returns the number of keys.
+ */
+template <typename Key, typename Compare>
+typename MappedSet<Key, Compare>::size_type
+MappedSet<Key, Compare>::size() const noexcept {
+  return this->index_.size();
+}
+
+/**
+ * @brief Returns the size of the mapped file; its pages are in the shared
+ * page cache, not on the heap of the process.
+ */
+template <typename Key, typename Compare>
+typename MappedSet<Key, Compare>::size_type
+MappedSet<Key, Compare>::mapped_bytes() const noexcept {
+  return this->index_.mappedBytes();
+}
+
+// MappedSet Lookup
+/**
+ * @brief Finds the key.
+ * @param key Key to search for.
+ * @return Pointer to the key in the mapping, or end() if it is absent.
+ */
+template <typename Key, typename Compare>
+typename MappedSet<Key, Compare>::iterator
+MappedSet<Key, Compare>::find(const key_type &key) const {
+  iterator it = lower_bound(key);
+  return it != end() && !Compare()(key, *it) ? it : end();
+}
+
+/**
+ * @brief Checks if the set contains the key.
+ */
+template <typename Key, typename Compare>
+bool MappedSet<Key, Compare>::contains(const key_type &key) const {
+  return find(key) != end();
+}
+
+/**
+ * @brief Returns the number of keys equivalent to key (0 or 1).
+ */
+template <typename Key, typename Compare>
+typename MappedSet<Key, Compare>::size_type
+MappedSet<Key, Compare>::count(const key_type &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Returns a pointer to the first key not less than key, or end().
+ */
+template <typename Key, typename Compare>
+typename MappedSet<Key, Compare>::iterator
+MappedSet<Key, Compare>::lower_bound(const key_type &key) const {
+  return begin() + this->index_.lowerBound(key);
+}
+
+/**
+ * @brief Returns a pointer to the first key greater than key, or end().
+ */
+template <typename Key, typename Compare>
+typename MappedSet<Key, Compare>::iterator
+MappedSet<Key, Compare>::upper_bound(const key_type &key) const {
+  return begin() + this->index_.upperBound(key);
+}
+
+/**
+ * @brief Returns the range of keys equivalent to key (empty or one key).
+ */
+template <typename Key, typename Compare>
+std::pair<typename MappedSet<Key, Compare>::iterator,
+          typename MappedSet<Key, Compare>::iterator>
+MappedSet<Key, Compare>::equal_range(const key_type &key) const {
+  iterator first = lower_bound(key);
+  iterator last = first != end() && !Compare()(key, *first) ? first + 1 : first;
+  return {first, last};
+}
+
+/**
+ * @brief Swaps the mappings.
+ * @param other MappedSet to swap with.
+ */
+template <typename Key, typename Compare>
+void MappedSet<Key, Compare>::swap(MappedSet &other) noexcept {
+  this->index_.swap(other.index_);
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks the order of the keys and the search index (see
+ * MappedIndex::checkInvariants); reads the whole file.
+ */
+template <typename Key, typename Compare>
+bool MappedSet<Key, Compare>::checkInvariants() const {
+  return this->index_.checkInvariants();
+}
+
+} // namespace s21
@@ -19,11 +19,14 @@
 #include <iostream>
 
 #include "../SUPPORT_FUNCTIONS/rb_tree.h"
+#include "../SUPPORT_FUNCTIONS/snapshot.h"
 #include "../s21_common.h" // на случай, если будем собирать только этот контейнер без остальных
 
 namespace s21 {
 
-template <typename Key> class MultiSet {
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class MultiSet {
 public:
   // MultiSet Member type:
   using key_type = Key;
@@ -31,53 +34,83 @@ public:
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = std::size_t;
-  using rb_tree = s21::RBTree<Key>;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using rb_tree = s21::RBTree<Key, Compare, Allocator>;
   using iterator = typename rb_tree::iterator;
   using const_iterator = typename rb_tree::const_iterator;
+  using reverse_iterator = typename rb_tree::reverse_iterator;
+  using const_reverse_iterator = typename rb_tree::const_reverse_iterator;
+  using node_type = typename rb_tree::node_handle;
 
   // MultiSet Member functions:
   MultiSet();
+  explicit MultiSet(const allocator_type &alloc);
   MultiSet(std::initializer_list<value_type> const &items);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  MultiSet(InputIt first, InputIt last);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  MultiSet(sorted_equivalent_t, InputIt first, InputIt last);
   MultiSet(const MultiSet &s);
   MultiSet(MultiSet &&s) noexcept;
   ~MultiSet();
   MultiSet &operator=(const MultiSet &s);
-  MultiSet &operator=(MultiSet &&s) noexcept;
+  MultiSet &operator=(MultiSet &&s) noexcept(rb_tree::kNothrowMoveAssign);
+  allocator_type get_allocator() const noexcept;
 
   // MultiSet Iterators:
   iterator begin() noexcept;
   iterator end() noexcept;
   const_iterator begin() const noexcept;
   const_iterator end() const noexcept;
+  reverse_iterator rbegin() noexcept;
+  reverse_iterator rend() noexcept;
+  const_reverse_iterator rbegin() const noexcept;
+  const_reverse_iterator rend() const noexcept;
 
   // MultiSet Capacity:
   bool empty() const noexcept;
   size_type size() const noexcept;
   size_type max_size() const noexcept;
+  void reserve(size_type count);
 
   // MultiSet Modifiers:
   void clear() noexcept;
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  void assign(InputIt first, InputIt last);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  void assign(sorted_equivalent_t, InputIt first, InputIt last);
   iterator insert(const value_type &value);
+  iterator insert(value_type &&value);
+  iterator insert(const_iterator hint, const value_type &value);
+  iterator insert(const_iterator hint, value_type &&value);
+  iterator insert(node_type &&node);
   template <typename... Args> std::vector<iterator> insert_many(Args &&...args);
   void erase(iterator pos) noexcept;
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type &key); // возвращает число удалённых
+  node_type extract(const_iterator pos); // забирает узел из дерева
+  node_type extract(const key_type &key);
   void swap(MultiSet &other) noexcept;
   void merge(MultiSet &other);
   size_type
-  count(const Key &key) const noexcept; // Возвращает количество элементов,
-                                        // соответствующих заданному ключу.
-  iterator emplace(Key &&key); // метод emplace предназначен для вставки
-                               // элемента в контейнер, используя перемещение
-                               // (move semantics) вместо копирования
+  count(const Key &key) const; // Возвращает количество элементов,
+                               // соответствующих заданному ключу.
+  size_type count_range(const Key &lo, const Key &hi) const;
+  template <typename... Args>
+  iterator emplace(Args &&...args); // строит ключ прямо в узле дерева
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args);
   std::pair<iterator, iterator> equal_range(const Key &key);
   std::pair<const_iterator, const_iterator> equal_range(const Key &key) const;
   iterator lower_bound(
-      const Key &key) noexcept; // используется для поиска первого элемента с
-                                // ключом, большим или равным данному
-  const_iterator lower_bound(const Key &key) const noexcept;
+      const Key &key); // используется для поиска первого элемента с
+                       // ключом, большим или равным данному
+  const_iterator lower_bound(const Key &key) const;
   iterator upper_bound(
-      const Key &key) noexcept; // используется для поиска первого элемента с
-                                // ключом, меньшим или равным данному
-  const_iterator upper_bound(const Key &key) const noexcept;
+      const Key &key); // используется для поиска первого элемента с
+                       // ключом, меньшим или равным данному
+  const_iterator upper_bound(const Key &key) const;
 
   // MultiSet Lookup:
   bool
@@ -86,13 +119,81 @@ public:
   iterator find(const Key &key);
   const_iterator find(const Key &key) const;
 
+  // MultiSet Heterogeneous lookup (only if Compare::is_transparent):
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  bool contains(const K &key) const;
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  size_type count(const K &key) const;
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  iterator find(const K &key);
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  const_iterator find(const K &key) const;
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  std::pair<iterator, iterator> equal_range(const K &key);
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  std::pair<const_iterator, const_iterator> equal_range(const K &key) const;
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  iterator lower_bound(const K &key);
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  iterator upper_bound(const K &key);
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  const_iterator lower_bound(const K &key) const;
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  const_iterator upper_bound(const K &key) const;
+
+  // MultiSet Batched lookup (descents of several keys are interleaved):
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out);
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+
+  // MultiSet Order statistics:
+  size_type rank(const Key &key) const;
+  iterator nth(size_type k) noexcept;
+  const_iterator nth(size_type k) const noexcept;
+  const_reference select(size_type k) const;
+
+  // MultiSet Set algebra (O(n + m), in parallel for large operands):
+  MultiSet set_union(const MultiSet &other) const;
+  MultiSet set_intersection(const MultiSet &other) const;
+  MultiSet set_difference(const MultiSet &other) const;
+  MultiSet symmetric_difference(const MultiSet &other) const;
+
+  // MultiSet Split and join (O(log n)):
+  MultiSet split(const key_type &key); // забирает ключи не меньше key
+  void join(MultiSet &other);
+
+  // MultiSet Snapshots (binary, in key order, see snapshot.h):
+  void save(int fd) const;
+  void load(int fd); // O(n): строит дерево из упорядоченных ключей
+
   // Debugging methods:
   void drawMultiSet();
 
 private:
+  template <typename K, typename C, typename A, typename Pred>
+  friend typename MultiSet<K, C, A>::size_type
+  erase_if(MultiSet<K, C, A> &multiset, Pred pred);
+
   rb_tree tree_;
 };
 
+template <typename Key, typename Compare, typename Allocator, typename Pred>
+typename MultiSet<Key, Compare, Allocator>::size_type
+erase_if(MultiSet<Key, Compare, Allocator> &multiset, Pred pred);
+
 } // namespace s21
 
 #include "s21_multiset.tpp"
@@ -18,39 +18,80 @@ namespace s21 {
 /**
  * @brief Default constructor.
  */
-template <typename Key> MultiSet<Key>::MultiSet() : tree_() {}
+template <typename Key, typename Compare, typename Allocator>
+MultiSet<Key, Compare, Allocator>::MultiSet() : tree_() {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator used for all nodes of the MultiSet.
+ */
+template <typename Key, typename Compare, typename Allocator>
+MultiSet<Key, Compare, Allocator>::MultiSet(const allocator_type &alloc)
+    : tree_(alloc) {}
 
 /**
  * @brief Constructor with initializer list.
  * @param items Initializer list of value_type.
  */
-template <typename Key>
-MultiSet<Key>::MultiSet(std::initializer_list<value_type> const &items)
+template <typename Key, typename Compare, typename Allocator>
+MultiSet<Key, Compare, Allocator>::MultiSet(
+    std::initializer_list<value_type> const &items)
+    : tree_() {
+  this->tree_.assign(items.begin(), items.end(), false);
+}
+
+/**
+ * @brief Range constructor.
+ *
+ * A sorted forward range is built in O(n), any other range is inserted
+ * element by element.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+MultiSet<Key, Compare, Allocator>::MultiSet(InputIt first, InputIt last)
     : tree_() {
-  for (auto item : items) {
-    this->tree_.insert(item);
-  }
+  this->tree_.assign(first, last, false);
+}
+
+/**
+ * @brief Range constructor for input that is already sorted (equivalent
+ * keys are allowed).
+ *
+ * The order is not checked, the tree is built in O(n).
+ * @param first Beginning of the sorted range.
+ * @param last End of the sorted range.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+MultiSet<Key, Compare, Allocator>::MultiSet(sorted_equivalent_t, InputIt first,
+                                            InputIt last)
+    : tree_() {
+  this->tree_.assignSorted(first, last, false);
 }
 
 /**
  * @brief Copy constructor.
  * @param s MultiSet to copy.
  */
-template <typename Key>
-MultiSet<Key>::MultiSet(const MultiSet &s) : tree_(s.tree_) {}
+template <typename Key, typename Compare, typename Allocator>
+MultiSet<Key, Compare, Allocator>::MultiSet(const MultiSet &s)
+    : tree_(s.tree_) {}
 
 /**
  * @brief Move constructor.
  * @param s MultiSet to move.
  */
-template <typename Key>
-MultiSet<Key>::MultiSet(MultiSet &&s) noexcept : tree_(std::move(s.tree_)) {}
+template <typename Key, typename Compare, typename Allocator>
+MultiSet<Key, Compare, Allocator>::MultiSet(MultiSet &&s) noexcept
+    : tree_(std::move(s.tree_)) {}
 
 /**
  * @brief Destructor.
  */
-template <typename Key>
-MultiSet<Key>::~MultiSet() =
+template <typename Key, typename Compare, typename Allocator>
+MultiSet<Key, Compare, Allocator>::~MultiSet() =
     default; // tree_ сам себя очистит, у него есть свой деструктор
 
 /**
@@ -58,23 +99,41 @@ MultiSet<Key>::~MultiSet() =
  * @param s MultiSet to copy.
  * @return Reference to this MultiSet.
  */
-template <typename Key>
-MultiSet<Key> &MultiSet<Key>::operator=(const MultiSet &s) {
+template <typename Key, typename Compare, typename Allocator>
+MultiSet<Key, Compare, Allocator> &
+MultiSet<Key, Compare, Allocator>::operator=(const MultiSet &s) {
   this->tree_ = s.tree_;
   return *this;
 }
 
 /**
  * @brief Move assignment operator.
+ *
+ * The nodes are taken over unless the allocators differ and do not
+ * propagate; then the elements are moved into new nodes (see RBTree).
  * @param s MultiSet to move.
  * @return Reference to this MultiSet.
+ * @throws std::bad_alloc and exceptions of the element constructor, only
+ * if the allocator neither propagates nor is always equal.
  */
-template <typename Key>
-MultiSet<Key> &MultiSet<Key>::operator=(MultiSet &&s) noexcept {
+template <typename Key, typename Compare, typename Allocator>
+MultiSet<Key, Compare, Allocator> &
+MultiSet<Key, Compare, Allocator>::operator=(MultiSet &&s) noexcept(
+    rb_tree::kNothrowMoveAssign) {
   this->tree_ = std::move(s.tree_);
   return *this;
 }
 
+/**
+ * @brief Returns the allocator associated with the MultiSet.
+ * @return Copy of the allocator.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::allocator_type
+MultiSet<Key, Compare, Allocator>::get_allocator() const noexcept {
+  return tree_.get_allocator();
+}
+
 /******************************************************************************
  * MAIN METHODS
  ******************************************************************************/
@@ -84,8 +143,9 @@ MultiSet<Key> &MultiSet<Key>::operator=(MultiSet &&s) noexcept {
  * @brief Returns an iterator to the beginning.
  * @return Iterator to the beginning.
  */
-template <typename Key>
-typename MultiSet<Key>::iterator MultiSet<Key>::begin() noexcept {
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::begin() noexcept {
   return this->tree_.begin();
 }
 
@@ -93,8 +153,9 @@ typename MultiSet<Key>::iterator MultiSet<Key>::begin() noexcept {
  * @brief Returns an iterator to the end.
  * @return Iterator to the end.
  */
-template <typename Key>
-typename MultiSet<Key>::iterator MultiSet<Key>::end() noexcept {
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::end() noexcept {
   return this->tree_.end();
 }
 
@@ -102,8 +163,9 @@ typename MultiSet<Key>::iterator MultiSet<Key>::end() noexcept {
  * @brief Returns a const iterator to the beginning.
  * @return Const iterator to the beginning.
  */
-template <typename Key>
-typename MultiSet<Key>::const_iterator MultiSet<Key>::begin() const noexcept {
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::const_iterator
+MultiSet<Key, Compare, Allocator>::begin() const noexcept {
   return this->tree_.begin();
 }
 
@@ -111,17 +173,59 @@ typename MultiSet<Key>::const_iterator MultiSet<Key>::begin() const noexcept {
  * @brief Returns a const iterator to the end.
  * @return Const iterator to the end.
  */
-template <typename Key>
-typename MultiSet<Key>::const_iterator MultiSet<Key>::end() const noexcept {
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::const_iterator
+MultiSet<Key, Compare, Allocator>::end() const noexcept {
   return this->tree_.end();
 }
 
+/**
+ * @brief Returns a reverse iterator to the last element.
+ * @return A reverse iterator to the last element.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::reverse_iterator
+MultiSet<Key, Compare, Allocator>::rbegin() noexcept {
+  return this->tree_.rbegin();
+}
+
+/**
+ * @brief Returns a reverse iterator to the reverse end.
+ * @return A reverse iterator to the reverse end.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::reverse_iterator
+MultiSet<Key, Compare, Allocator>::rend() noexcept {
+  return this->tree_.rend();
+}
+
+/**
+ * @brief Returns a const reverse iterator to the last element.
+ * @return A const reverse iterator to the last element.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::const_reverse_iterator
+MultiSet<Key, Compare, Allocator>::rbegin() const noexcept {
+  return this->tree_.rbegin();
+}
+
+/**
+ * @brief Returns a const reverse iterator to the reverse end.
+ * @return A const reverse iterator to the reverse end.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::const_reverse_iterator
+MultiSet<Key, Compare, Allocator>::rend() const noexcept {
+  return this->tree_.rend();
+}
+
 // MultiSet Capacity
 /**
  * @brief Checks whether the container is empty.
  * @return True if the container is empty, false otherwise.
  */
-template <typename Key> bool MultiSet<Key>::empty() const noexcept {
+template <typename Key, typename Compare, typename Allocator>
+bool MultiSet<Key, Compare, Allocator>::empty() const noexcept {
   return this->tree_.empty();
 }
 
@@ -129,7 +233,8 @@ template <typename Key> bool MultiSet<Key>::empty() const noexcept {
  * @brief Returns the number of elements.
  * @return The number of elements.
  */
-template <typename Key> size_t MultiSet<Key>::size() const noexcept {
+template <typename Key, typename Compare, typename Allocator>
+size_t MultiSet<Key, Compare, Allocator>::size() const noexcept {
   return this->tree_.size();
 }
 
@@ -137,39 +242,122 @@ template <typename Key> size_t MultiSet<Key>::size() const noexcept {
  * @brief Returns the maximum possible number of elements.
  * @return The maximum possible number of elements.
  */
-template <typename Key> size_t MultiSet<Key>::max_size() const noexcept {
+template <typename Key, typename Compare, typename Allocator>
+size_t MultiSet<Key, Compare, Allocator>::max_size() const noexcept {
   return this->tree_.max_size();
 }
 
+/**
+ * @brief Preallocates nodes for count elements.
+ * @param count Number of elements to reserve memory for.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void MultiSet<Key, Compare, Allocator>::reserve(size_type count) {
+  this->tree_.reserve(count);
+}
+
 // MultiSet Modifiers
 /**
  * @brief Clears the contents.
  */
-template <typename Key> void MultiSet<Key>::clear() noexcept {
+template <typename Key, typename Compare, typename Allocator>
+void MultiSet<Key, Compare, Allocator>::clear() noexcept {
   this->tree_.clear();
 }
 
+/**
+ * @brief Replaces the contents with the keys from [first, last).
+ *
+ * A sorted forward range is built in O(n), any other range is inserted
+ * element by element.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+void MultiSet<Key, Compare, Allocator>::assign(InputIt first, InputIt last) {
+  this->tree_.assign(first, last, false);
+}
+
+/**
+ * @brief Replaces the contents with a range that is already sorted
+ * (equivalent keys are allowed).
+ *
+ * The order is not checked, the tree is built in O(n).
+ * @param first Beginning of the sorted range.
+ * @param last End of the sorted range.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+void MultiSet<Key, Compare, Allocator>::assign(sorted_equivalent_t,
+                                              InputIt first,
+                                              InputIt last) {
+  this->tree_.assignSorted(first, last, false);
+}
+
 /**
  * @brief Inserts elements.
  * @param value Value to insert.
  * @return Iterator to the inserted element.
  */
-template <typename Key>
-typename MultiSet<Key>::iterator
-MultiSet<Key>::insert(const value_type &value) {
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::insert(const value_type &value) {
   return this->tree_.insert(value).first;
 }
 
+/**
+ * @brief Inserts an element, moving it into the container.
+ * @param value Value to insert.
+ * @return Iterator to the inserted element.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::insert(value_type &&value) {
+  return this->tree_.insert(std::move(value)).first;
+}
+
+/**
+ * @brief Inserts an element, using hint as a suggestion for its place.
+ *
+ * If the value belongs right before hint (or after the last element for
+ * end()), it is linked without a search from the root. Among equivalent
+ * elements the new one is placed as close as possible before hint.
+ * @param hint Iterator to the element before which value is expected.
+ * @param value Value to insert.
+ * @return Iterator to the inserted element.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::insert(const_iterator hint,
+                                          const value_type &value) {
+  return this->tree_.insert(hint, value);
+}
+
+/**
+ * @brief Inserts an element moved into the container, using hint as a
+ * suggestion for its place.
+ * @param hint Iterator to the element before which value is expected.
+ * @param value Value to insert.
+ * @return Iterator to the inserted element.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::insert(const_iterator hint,
+                                          value_type &&value) {
+  return this->tree_.insert(hint, std::move(value));
+}
+
 /**
  * @brief Inserts multiple elements into the multiset.
  * @tparam Args The types of the elements to insert.
  * @param args The elements to insert.
  * @return A vector of iterators to the inserted elements.
  */
-template <typename Key>
+template <typename Key, typename Compare, typename Allocator>
 template <typename... Args>
-std::vector<typename MultiSet<Key>::iterator>
-MultiSet<Key>::insert_many(Args &&...args) {
+std::vector<typename MultiSet<Key, Compare, Allocator>::iterator>
+MultiSet<Key, Compare, Allocator>::insert_many(Args &&...args) {
   std::vector<iterator> results;
   (results.push_back(this->insert(std::forward<Args>(args))), ...);
   return results;
@@ -179,45 +367,149 @@ MultiSet<Key>::insert_many(Args &&...args) {
  * @brief Erases an element.
  * @param pos Iterator to the element to erase.
  */
-template <typename Key> void MultiSet<Key>::erase(iterator pos) noexcept {
+template <typename Key, typename Compare, typename Allocator>
+void MultiSet<Key, Compare, Allocator>::erase(iterator pos) noexcept {
   this->tree_.erase(pos);
 }
 
+/**
+ * @brief Erases the keys in [first, last).
+ *
+ * Long ranges are cut out of the tree as a whole and the tree is rebalanced
+ * once, in O(log n).
+ *
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @return iterator Iterator to last.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::erase(const_iterator first,
+                                         const_iterator last) {
+  return this->tree_.erase(first, last);
+}
+
+/**
+ * @brief Erases all elements with a key equivalent to key.
+ * @param key Key to erase.
+ * @return size_type Number of erased elements.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::size_type
+MultiSet<Key, Compare, Allocator>::erase(const key_type &key) {
+  return this->tree_.eraseEqual(key);
+}
+
 /**
  * @brief Swaps the contents.
  * @param other MultiSet to swap with.
  */
-template <typename Key> void MultiSet<Key>::swap(MultiSet &other) noexcept {
+template <typename Key, typename Compare, typename Allocator>
+void MultiSet<Key, Compare, Allocator>::swap(MultiSet &other) noexcept {
   std::swap(this->tree_, other.tree_);
 }
 
 /**
  * @brief Merges elements from another multiset.
+ *
+ * All nodes are moved to this multiset and other becomes empty; with equal
+ * allocators no memory is allocated and no key is copied.
  * @param other MultiSet to merge from.
  */
-template <typename Key> void MultiSet<Key>::merge(MultiSet &other) {
+template <typename Key, typename Compare, typename Allocator>
+void MultiSet<Key, Compare, Allocator>::merge(MultiSet &other) {
   this->tree_.merge(other.tree_);
 }
 
+/**
+ * @brief Inserts the node owned by a node handle.
+ *
+ * The node is linked as is: no memory is allocated and the element is not
+ * copied.
+ * @param node Node handle, obtained from extract() of a container with an
+ * equal allocator.
+ * @return Iterator to the inserted element, or end() for an empty handle.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::insert(node_type &&node) {
+  return this->tree_.insert(std::move(node)).first;
+}
+
+/**
+ * @brief Removes the element at pos and returns its node.
+ * @param pos Iterator to the element to extract, must be dereferenceable.
+ * @return Node handle owning the element.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::node_type
+MultiSet<Key, Compare, Allocator>::extract(const_iterator pos) {
+  return this->tree_.extract(pos);
+}
+
+/**
+ * @brief Removes the element with the given key and returns its node.
+ * @param key Key of the element to extract.
+ * @return Node handle owning the element, empty if there is no such key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::node_type
+MultiSet<Key, Compare, Allocator>::extract(const key_type &key) {
+  return this->tree_.extract(key);
+}
+
 /**
  * @brief Returns the number of elements with a specific key.
  * @param key Key of the element to count.
  * @return The number of elements with the key.
  */
-template <typename Key>
-size_t MultiSet<Key>::count(const Key &key) const noexcept {
+template <typename Key, typename Compare, typename Allocator>
+size_t MultiSet<Key, Compare, Allocator>::count(const Key &key) const {
   return this->tree_.count(key);
 }
 
+/**
+ * @brief Returns the number of elements with keys in [lo, hi).
+ *
+ * Uses the subtree sizes stored in the tree, O(log n).
+ * @param lo Lower bound of the range, included.
+ * @param hi Upper bound of the range, excluded.
+ * @return The number of elements, 0 if hi is not greater than lo.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::size_type
+MultiSet<Key, Compare, Allocator>::count_range(const Key &lo,
+                                               const Key &hi) const {
+  return this->tree_.count_range(lo, hi);
+}
+
 /**
  * @brief Inserts a new element constructed in-place.
- * @param key Key of the element to insert.
+ *
+ * The key is constructed once, directly in the tree node.
+ * @param args Arguments forwarded to the constructor of the key.
  * @return Iterator to the inserted element.
  */
-template <typename Key>
-typename MultiSet<Key>::iterator MultiSet<Key>::emplace(Key &&key) {
-  value_type new_value(std::forward<Key>(key));
-  return tree_.insert(new_value).first;
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::emplace(Args &&...args) {
+  return this->tree_.emplace(std::forward<Args>(args)...).first;
+}
+
+/**
+ * @brief Inserts a new element constructed in-place, using hint as a
+ * suggestion for its place.
+ * @param hint Iterator to the element before which the key is expected.
+ * @param args Arguments forwarded to the constructor of the key.
+ * @return Iterator to the inserted element.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                                Args &&...args) {
+  return this->tree_.emplaceHint(hint, std::forward<Args>(args)...);
 }
 
 /**
@@ -225,9 +517,10 @@ typename MultiSet<Key>::iterator MultiSet<Key>::emplace(Key &&key) {
  * @param key Key of the elements to find.
  * @return Pair of iterators to the lower and upper bounds of the range.
  */
-template <typename Key>
-std::pair<typename MultiSet<Key>::iterator, typename MultiSet<Key>::iterator>
-MultiSet<Key>::equal_range(const key_type &key) {
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename MultiSet<Key, Compare, Allocator>::iterator,
+          typename MultiSet<Key, Compare, Allocator>::iterator>
+MultiSet<Key, Compare, Allocator>::equal_range(const key_type &key) {
   return {lower_bound(key), upper_bound(key)};
 }
 
@@ -236,10 +529,10 @@ MultiSet<Key>::equal_range(const key_type &key) {
  * @param key Key of the elements to find.
  * @return Pair of const iterators to the lower and upper bounds of the range.
  */
-template <typename Key>
-std::pair<typename MultiSet<Key>::const_iterator,
-          typename MultiSet<Key>::const_iterator>
-MultiSet<Key>::equal_range(const key_type &key) const {
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename MultiSet<Key, Compare, Allocator>::const_iterator,
+          typename MultiSet<Key, Compare, Allocator>::const_iterator>
+MultiSet<Key, Compare, Allocator>::equal_range(const key_type &key) const {
   return {lower_bound(key), upper_bound(key)};
 }
 
@@ -248,9 +541,9 @@ MultiSet<Key>::equal_range(const key_type &key) const {
  * @param key Key to compare.
  * @return Iterator to the first element not less than the key.
  */
-template <typename Key>
-typename MultiSet<Key>::iterator
-MultiSet<Key>::lower_bound(const Key &key) noexcept {
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::lower_bound(const Key &key) {
   return this->tree_.lower_bound(key);
 }
 
@@ -259,9 +552,9 @@ MultiSet<Key>::lower_bound(const Key &key) noexcept {
  * @param key Key to compare.
  * @return Iterator to the first element greater than the key.
  */
-template <typename Key>
-typename MultiSet<Key>::iterator
-MultiSet<Key>::upper_bound(const Key &key) noexcept {
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::upper_bound(const Key &key) {
   return this->tree_.upper_bound(key);
 }
 
@@ -271,9 +564,9 @@ MultiSet<Key>::upper_bound(const Key &key) noexcept {
  * @param key Key to compare.
  * @return Const iterator to the first element not less than the key.
  */
-template <typename Key>
-typename MultiSet<Key>::const_iterator
-MultiSet<Key>::lower_bound(const Key &key) const noexcept {
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::const_iterator
+MultiSet<Key, Compare, Allocator>::lower_bound(const Key &key) const {
   return this->tree_.lower_bound(key);
 }
 
@@ -283,9 +576,9 @@ MultiSet<Key>::lower_bound(const Key &key) const noexcept {
  * @param key Key to compare.
  * @return Const iterator to the first element greater than the key.
  */
-template <typename Key>
-typename MultiSet<Key>::const_iterator
-MultiSet<Key>::upper_bound(const Key &key) const noexcept {
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::const_iterator
+MultiSet<Key, Compare, Allocator>::upper_bound(const Key &key) const {
   return this->tree_.upper_bound(key);
 }
 
@@ -295,7 +588,8 @@ MultiSet<Key>::upper_bound(const Key &key) const noexcept {
  * @return True if the container contains an element with the key, false
  * otherwise.
  */
-template <typename Key> bool MultiSet<Key>::contains(const Key &key) const {
+template <typename Key, typename Compare, typename Allocator>
+bool MultiSet<Key, Compare, Allocator>::contains(const Key &key) const {
   return this->tree_.contains(key);
 }
 
@@ -304,8 +598,9 @@ template <typename Key> bool MultiSet<Key>::contains(const Key &key) const {
  * @param key Key of the element to find.
  * @return Iterator to the element if found, otherwise end().
  */
-template <typename Key>
-typename MultiSet<Key>::iterator MultiSet<Key>::find(const Key &key) {
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::find(const Key &key) {
   return this->tree_.find(key);
 }
 
@@ -314,12 +609,381 @@ typename MultiSet<Key>::iterator MultiSet<Key>::find(const Key &key) {
  * @param key Key of the element to find.
  * @return Const iterator to the element if found, otherwise end().
  */
-template <typename Key>
-typename MultiSet<Key>::const_iterator
-MultiSet<Key>::find(const Key &key) const {
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::const_iterator
+MultiSet<Key, Compare, Allocator>::find(const Key &key) const {
   return this->tree_.find(key);
 }
 
+/******************************************************************************
+ * HETEROGENEOUS LOOKUP
+ ******************************************************************************/
+
+// Поиск по значению любого типа K, сравнимого с Key прозрачным Compare
+// (например, std::string_view при Compare = std::less<>), без построения
+// временного Key.
+
+/**
+ * @brief Checks if the container contains an element equivalent to key.
+ * @param key Value comparable with Key.
+ * @return True if such an element exists, false otherwise.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+bool MultiSet<Key, Compare, Allocator>::contains(const K &key) const {
+  return this->tree_.contains(key);
+}
+
+/**
+ * @brief Returns the number of elements equivalent to key.
+ * @param key Value comparable with Key.
+ * @return The number of matching elements.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename MultiSet<Key, Compare, Allocator>::size_type
+MultiSet<Key, Compare, Allocator>::count(const K &key) const {
+  return this->tree_.count(key);
+}
+
+/**
+ * @brief Finds an element equivalent to key.
+ * @param key Value comparable with Key.
+ * @return Iterator to the element if found, otherwise end().
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::find(const K &key) {
+  return this->tree_.find(key);
+}
+
+/**
+ * @brief Finds an element equivalent to key.
+ * @param key Value comparable with Key.
+ * @return Const iterator to the element if found, otherwise end().
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename MultiSet<Key, Compare, Allocator>::const_iterator
+MultiSet<Key, Compare, Allocator>::find(const K &key) const {
+  return this->tree_.find(key);
+}
+
+/**
+ * @brief Returns the range of elements equivalent to key.
+ * @param key Value comparable with Key.
+ * @return Pair of iterators bounding the matching elements.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+std::pair<typename MultiSet<Key, Compare, Allocator>::iterator,
+          typename MultiSet<Key, Compare, Allocator>::iterator>
+MultiSet<Key, Compare, Allocator>::equal_range(const K &key) {
+  return {this->tree_.lower_bound(key), this->tree_.upper_bound(key)};
+}
+
+/**
+ * @brief Returns the range of elements equivalent to key.
+ * @param key Value comparable with Key.
+ * @return Pair of const iterators bounding the matching elements.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+std::pair<typename MultiSet<Key, Compare, Allocator>::const_iterator,
+          typename MultiSet<Key, Compare, Allocator>::const_iterator>
+MultiSet<Key, Compare, Allocator>::equal_range(const K &key) const {
+  return {this->tree_.lower_bound(key), this->tree_.upper_bound(key)};
+}
+
+/**
+ * @brief Returns an iterator to the first element not less than key.
+ * @param key Value comparable with Key.
+ * @return Iterator to the first element not less than key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::lower_bound(const K &key) {
+  return this->tree_.lower_bound(key);
+}
+
+/**
+ * @brief Returns an iterator to the first element greater than key.
+ * @param key Value comparable with Key.
+ * @return Iterator to the first element greater than key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::upper_bound(const K &key) {
+  return this->tree_.upper_bound(key);
+}
+
+/**
+ * @brief Returns a const iterator to the first element not less than key.
+ * @param key Value comparable with Key.
+ * @return Const iterator to the first element not less than key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename MultiSet<Key, Compare, Allocator>::const_iterator
+MultiSet<Key, Compare, Allocator>::lower_bound(const K &key) const {
+  return this->tree_.lower_bound(key);
+}
+
+/**
+ * @brief Returns a const iterator to the first element greater than key.
+ * @param key Value comparable with Key.
+ * @return Const iterator to the first element greater than key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename MultiSet<Key, Compare, Allocator>::const_iterator
+MultiSet<Key, Compare, Allocator>::upper_bound(const K &key) const {
+  return this->tree_.upper_bound(key);
+}
+
+/******************************************************************************
+ * BATCHED LOOKUP
+ ******************************************************************************/
+
+// Поиск пачки ключей: спуски по дереву идут вперемешку, промахи кэша
+// разных ключей перекрываются (см. RBTree::findMany).
+
+/**
+ * @brief Finds every key of a range, like find() called for each key.
+ * @param first, last Range of keys (forward iterators).
+ * @param out Receives an iterator to the first element equal to the key
+ * (as lower_bound() does) or end() for each key, in the order of the range.
+ * @return Output iterator past the last written one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt MultiSet<Key, Compare, Allocator>::find_many(
+    ForwardIt first, ForwardIt last, OutputIt out) {
+  return this->tree_.findMany(first, last, out);
+}
+
+/**
+ * @brief Finds every key of a range, like find() called for each key.
+ * @param first, last Range of keys (forward iterators).
+ * @param out Receives a const iterator to the first element equal to the
+ * key or end() for each key, in the order of the range.
+ * @return Output iterator past the last written one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt MultiSet<Key, Compare, Allocator>::find_many(
+    ForwardIt first, ForwardIt last, OutputIt out) const {
+  return this->tree_.findMany(first, last, out);
+}
+
+/**
+ * @brief Checks every key of a range, like contains() called for each key.
+ * @param first, last Range of keys (forward iterators).
+ * @param out Receives true or false for each key, in the order of the range.
+ * @return Output iterator past the last written one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt MultiSet<Key, Compare, Allocator>::contains_many(
+    ForwardIt first, ForwardIt last, OutputIt out) const {
+  return this->tree_.containsMany(first, last, out);
+}
+
+/******************************************************************************
+ * ORDER STATISTICS
+ ******************************************************************************/
+
+/**
+ * @brief Returns the number of elements with keys less than key, O(log n).
+ * @param key Key to rank.
+ * @return Position of the first element not less than key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::size_type
+MultiSet<Key, Compare, Allocator>::rank(const Key &key) const {
+  return this->tree_.rank(key);
+}
+
+/**
+ * @brief Returns an iterator to the element at position k in key order,
+ * O(log n).
+ * @param k Zero-based position.
+ * @return Iterator to the k-th element, end() if k >= size().
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::iterator
+MultiSet<Key, Compare, Allocator>::nth(size_type k) noexcept {
+  return this->tree_.nth(k);
+}
+
+/**
+ * @brief Returns a const iterator to the element at position k in key order,
+ * O(log n).
+ * @param k Zero-based position.
+ * @return Const iterator to the k-th element, end() if k >= size().
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::const_iterator
+MultiSet<Key, Compare, Allocator>::nth(size_type k) const noexcept {
+  return this->tree_.nth(k);
+}
+
+/**
+ * @brief Returns the element at position k in key order, O(log n).
+ * @param k Zero-based position.
+ * @return The k-th smallest element.
+ * @throws std::out_of_range if k >= size().
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename MultiSet<Key, Compare, Allocator>::const_reference
+MultiSet<Key, Compare, Allocator>::select(size_type k) const {
+  return this->tree_.select(k);
+}
+
+/**
+ * @brief Returns the keys that are in this multiset or in other.
+ *
+ * Both multisets are walked once in key order and the result is built from
+ * the sorted sequence in O(n + m); large operands are merged by several
+ * threads. A key present k times here and m times in other is taken
+ * max(k, m) times.
+ * @param other The second operand.
+ * @return A new multiset with the allocator of this one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+MultiSet<Key, Compare, Allocator>
+MultiSet<Key, Compare, Allocator>::set_union(const MultiSet &other) const {
+  MultiSet result(get_allocator());
+  result.tree_ = this->tree_.setUnion(other.tree_);
+  return result;
+}
+
+/**
+ * @brief Returns the keys that are both in this multiset and in other.
+ *
+ * A key present k times here and m times in other is taken min(k, m)
+ * times. O(n + m).
+ * @param other The second operand.
+ * @return A new multiset with the allocator of this one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+MultiSet<Key, Compare, Allocator>
+MultiSet<Key, Compare, Allocator>::set_intersection(
+    const MultiSet &other) const {
+  MultiSet result(get_allocator());
+  result.tree_ = this->tree_.setIntersection(other.tree_);
+  return result;
+}
+
+/**
+ * @brief Returns the keys of this multiset that are not in other.
+ *
+ * A key present k times here and m times in other is taken
+ * max(k - m, 0) times. O(n + m).
+ * @param other The second operand.
+ * @return A new multiset with the allocator of this one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+MultiSet<Key, Compare, Allocator>
+MultiSet<Key, Compare, Allocator>::set_difference(const MultiSet &other) const {
+  MultiSet result(get_allocator());
+  result.tree_ = this->tree_.setDifference(other.tree_);
+  return result;
+}
+
+/**
+ * @brief Returns the keys that are in exactly one of the two multisets.
+ *
+ * A key present k times here and m times in other is taken |k - m|
+ * times. O(n + m).
+ * @param other The second operand.
+ * @return A new multiset with the allocator of this one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+MultiSet<Key, Compare, Allocator>
+MultiSet<Key, Compare, Allocator>::symmetric_difference(
+    const MultiSet &other) const {
+  MultiSet result(get_allocator());
+  result.tree_ = this->tree_.symmetricDifference(other.tree_);
+  return result;
+}
+
+/**
+ * @brief Moves the keys with keys not less than key into a new multiset.
+ *
+ * The tree is cut along one path in O(log n); elements are neither copied
+ * nor reallocated.
+ * @param key The split key.
+ * @return A multiset with the keys not less than key; this multiset keeps the
+ * smaller ones.
+ */
+template <typename Key, typename Compare, typename Allocator>
+MultiSet<Key, Compare, Allocator>
+MultiSet<Key, Compare, Allocator>::split(const key_type &key) {
+  MultiSet result(get_allocator());
+  result.tree_ = this->tree_.split(key);
+  return result;
+}
+
+/**
+ * @brief Moves all elements of other into this multiset in O(log n).
+ *
+ * Every key of other must be not less than every key of this multiset, or
+ * every key of other not greater than every key of this multiset.
+ * @param other MultiSet to take the elements from, left empty.
+ * @throws std::invalid_argument if the key ranges overlap.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void MultiSet<Key, Compare, Allocator>::join(MultiSet &other) {
+  this->tree_.join(other.tree_);
+}
+
+/******************************************************************************
+ * SNAPSHOTS
+ ******************************************************************************/
+
+/**
+ * @brief Writes a binary snapshot of the multiset to a file descriptor.
+ *
+ * The elements are written in key order (equal keys included), so load()
+ * can build the tree in O(n). The format is described in
+ * SUPPORT_FUNCTIONS/snapshot.h.
+ * @param fd Descriptor open for writing; it is not closed.
+ * @throws std::system_error if the descriptor cannot be written.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void MultiSet<Key, Compare, Allocator>::save(int fd) const {
+  saveSnapshot<key_type>(fd, SnapshotKind::kMultiSet, this->tree_.cbegin(),
+                       this->tree_.size());
+}
+
+/**
+ * @brief Replaces the contents with a snapshot written by save().
+ *
+ * The elements are decoded straight into the nodes of a tree built in
+ * O(n), without inserting them one by one; then one pass checks that they
+ * are in order. If anything fails the multiset is not changed.
+ * @param fd Descriptor open for reading, positioned at the snapshot; the
+ * data after the snapshot is not read.
+ * @throws std::runtime_error if the data is not a snapshot of this
+ * container, std::invalid_argument if the keys are out of order,
+ * std::system_error if the descriptor cannot be read.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void MultiSet<Key, Compare, Allocator>::load(int fd) {
+  SnapshotReader reader = openSnapshot<key_type>(fd, SnapshotKind::kMultiSet);
+  MultiSet loaded(get_allocator());
+  loaded.tree_.assignSortedN(
+      std::make_move_iterator(
+          SnapshotInputIterator<key_type>(reader, reader.count())),
+      reader.count(), reader.reserveCount(), false);
+  reader.finish();
+  swap(loaded);
+}
+
 /******************************************************************************
  * DEBUGGING METHODS
  ******************************************************************************/
@@ -327,6 +991,27 @@ MultiSet<Key>::find(const Key &key) const {
 /**
  * @brief Prints the multiset structure for debugging purposes.
  */
-template <typename Key> void MultiSet<Key>::drawMultiSet() { tree_.drawTree(); }
+template <typename Key, typename Compare, typename Allocator>
+void MultiSet<Key, Compare, Allocator>::drawMultiSet() { tree_.drawTree(); }
+
+/******************************************************************************
+ * NON-MEMBER FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * @brief Erases all keys that satisfy pred, O(n).
+ *
+ * Runs of consecutive matching elements are erased as whole ranges, so
+ * long runs are cut out of the tree at once.
+ *
+ * @param multiset The container to erase from.
+ * @param pred Predicate called once for every key in key order.
+ * @return size_type Number of erased elements.
+ */
+template <typename Key, typename Compare, typename Allocator, typename Pred>
+typename MultiSet<Key, Compare, Allocator>::size_type
+erase_if(MultiSet<Key, Compare, Allocator> &multiset, Pred pred) {
+  return multiset.tree_.eraseIf(pred);
+}
 
 } // namespace s21
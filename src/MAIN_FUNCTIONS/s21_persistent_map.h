@@ -0,0 +1,104 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_persistent_map.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-24
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_PERSISTENT_MAP_H_
+#define CPP2_S21_CONTAINERS_PERSISTENT_MAP_H_
+
+#include <initializer_list>
+#include <stdexcept> // std::out_of_range
+#include <vector>
+
+#include "../SUPPORT_FUNCTIONS/persistent_tree.h"
+#include "s21_map.h"
+
+namespace s21 {
+
+/**
+ * @brief Immutable map with unique keys; every modification returns a new
+ * version that shares unchanged nodes with the old one.
+ *
+ * insert, insert_or_assign and erase take O(log n) time and allocate
+ * O(log n) nodes; the map they are called on does not change. snapshot()
+ * and copying are O(1), so a writer can keep a current version
+ * (m = m.insert(...)) and hand point-in-time views to readers. Different
+ * versions can be used and destroyed by different threads.
+ *
+ * Pointers returned by find stay valid while some version contains the
+ * element.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class PersistentMap {
+public:
+  // PersistentMap Member type:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using persistent_tree =
+      s21::PersistentTree<Key, value_type, SelectFirst<Key>, Compare, Allocator>;
+
+  // PersistentMap Member functions:
+  PersistentMap();
+  explicit PersistentMap(const allocator_type &alloc);
+  PersistentMap(std::initializer_list<value_type> const &items);
+  PersistentMap(const PersistentMap &m) noexcept;
+  PersistentMap(PersistentMap &&m) noexcept;
+  ~PersistentMap();
+  PersistentMap &operator=(const PersistentMap &m) noexcept;
+  PersistentMap &operator=(PersistentMap &&m) noexcept;
+  allocator_type get_allocator() const noexcept;
+
+  // PersistentMap Capacity:
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+
+  // PersistentMap New versions (this map is not changed):
+  [[nodiscard]] PersistentMap insert(const value_type &value) const;
+  [[nodiscard]] PersistentMap insert(const key_type &key,
+                                     const mapped_type &obj) const;
+  template <typename M>
+  [[nodiscard]] PersistentMap insert_or_assign(const key_type &key,
+                                               M &&obj) const;
+  [[nodiscard]] PersistentMap erase(const key_type &key) const;
+  PersistentMap snapshot() const noexcept; // O(1)
+  void swap(PersistentMap &other) noexcept;
+
+  // PersistentMap Lookup:
+  const mapped_type &at(const key_type &key) const;
+  const mapped_type *find(const key_type &key) const; // nullptr - нет ключа
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+
+  // PersistentMap Traversal:
+  template <typename Fn> void for_each(Fn &&fn) const;
+  s21::Map<Key, Value, Compare, Allocator> to_map() const;
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  explicit PersistentMap(persistent_tree tree) noexcept;
+
+  persistent_tree tree_;
+};
+
+} // namespace s21
+
+#include "s21_persistent_map.tpp"
+
+#endif // CPP2_S21_CONTAINERS_PERSISTENT_MAP_H_
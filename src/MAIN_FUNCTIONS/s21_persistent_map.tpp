@@ -0,0 +1,302 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_persistent_map.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-24
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor: an empty map.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+PersistentMap<Key, Value, Compare, Allocator>::PersistentMap() : tree_() {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator used for the nodes of all versions.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+PersistentMap<Key, Value, Compare, Allocator>::PersistentMap(
+    const allocator_type &alloc)
+    : tree_(alloc) {}
+
+/**
+ * @brief Constructor with initializer list. Repeated keys keep the first
+ * value.
+ * @param items Initializer list of value_type.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+PersistentMap<Key, Value, Compare, Allocator>::PersistentMap(
+    std::initializer_list<value_type> const &items)
+    : tree_() {
+  for (const value_type &item : items) {
+    this->tree_ = this->tree_.insert(item.first, item).first;
+  }
+}
+
+/**
+ * @brief Copy constructor. Shares all nodes with m: O(1).
+ * @param m PersistentMap to copy.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+PersistentMap<Key, Value, Compare, Allocator>::PersistentMap(
+    const PersistentMap &m) noexcept
+    : tree_(m.tree_) {}
+
+/**
+ * @brief Move constructor.
+ * @param m PersistentMap to move, left empty.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+PersistentMap<Key, Value, Compare, Allocator>::PersistentMap(
+    PersistentMap &&m) noexcept
+    : tree_(std::move(m.tree_)) {}
+
+/**
+ * @brief Constructor of a version from its tree.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+PersistentMap<Key, Value, Compare, Allocator>::PersistentMap(
+    persistent_tree tree) noexcept
+    : tree_(std::move(tree)) {}
+
+/**
+ * @brief Destructor. Frees the nodes that no other version refers to.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+PersistentMap<Key, Value, Compare, Allocator>::~PersistentMap() = default;
+
+/**
+ * @brief Copy assignment operator. O(1).
+ * @param m PersistentMap to copy.
+ * @return Reference to this PersistentMap.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+PersistentMap<Key, Value, Compare, Allocator> &
+PersistentMap<Key, Value, Compare, Allocator>::operator=(
+    const PersistentMap &m) noexcept {
+  this->tree_ = m.tree_;
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator.
+ * @param m PersistentMap to move.
+ * @return Reference to this PersistentMap.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+PersistentMap<Key, Value, Compare, Allocator> &
+PersistentMap<Key, Value, Compare, Allocator>::operator=(
+    PersistentMap &&m) noexcept {
+  this->tree_ = std::move(m.tree_);
+  return *this;
+}
+
+/**
+ * @brief Returns the allocator associated with the PersistentMap.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename PersistentMap<Key, Value, Compare, Allocator>::allocator_type
+PersistentMap<Key, Value, Compare, Allocator>::get_allocator() const noexcept {
+  return this->tree_.get_allocator();
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+// PersistentMap Capacity
+/**
+ * @brief Checks whether the map is empty.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool PersistentMap<Key, Value, Compare, Allocator>::empty() const noexcept {
+  return this->tree_.empty();
+}
+
+/**
+ * @brief Returns the number of elements.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename PersistentMap<Key, Value, Compare, Allocator>::size_type
+PersistentMap<Key, Value, Compare, Allocator>::size() const noexcept {
+  return this->tree_.size();
+}
+
+// PersistentMap New versions
+/**
+ * @brief Returns the version with an element inserted if its key is absent.
+ * @param value Element to insert.
+ * @return New version, or a copy of this one if the key is present.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+PersistentMap<Key, Value, Compare, Allocator>
+PersistentMap<Key, Value, Compare, Allocator>::insert(
+    const value_type &value) const {
+  return PersistentMap(this->tree_.insert(value.first, value).first);
+}
+
+/**
+ * @brief Returns the version with a key and a value inserted if the key is
+ * absent.
+ * @param key Key of the element.
+ * @param obj Value of the element.
+ * @return New version, or a copy of this one if the key is present.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+PersistentMap<Key, Value, Compare, Allocator>
+PersistentMap<Key, Value, Compare, Allocator>::insert(
+    const key_type &key, const mapped_type &obj) const {
+  return PersistentMap(this->tree_.insert(key, key, obj).first);
+}
+
+/**
+ * @brief Returns the version in which the key has the value obj.
+ * @param key Key of the element.
+ * @param obj Value to insert or assign.
+ * @return New version.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename M>
+PersistentMap<Key, Value, Compare, Allocator>
+PersistentMap<Key, Value, Compare, Allocator>::insert_or_assign(
+    const key_type &key, M &&obj) const {
+  return PersistentMap(
+      this->tree_.assign(key, key, std::forward<M>(obj)).first);
+}
+
+/**
+ * @brief Returns the version without the key.
+ * @param key Key to erase.
+ * @return New version, or a copy of this one if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+PersistentMap<Key, Value, Compare, Allocator>
+PersistentMap<Key, Value, Compare, Allocator>::erase(
+    const key_type &key) const {
+  return PersistentMap(this->tree_.erase(key).first);
+}
+
+/**
+ * @brief Returns a point-in-time view of the map in O(1); it is not
+ * affected by later versions.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+PersistentMap<Key, Value, Compare, Allocator>
+PersistentMap<Key, Value, Compare, Allocator>::snapshot() const noexcept {
+  return *this;
+}
+
+/**
+ * @brief Swaps the contents.
+ * @param other PersistentMap to swap with.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void PersistentMap<Key, Value, Compare, Allocator>::swap(
+    PersistentMap &other) noexcept {
+  this->tree_.swap(other.tree_);
+}
+
+// PersistentMap Lookup
+/**
+ * @brief Returns the value of the key.
+ * @param key Key of the element.
+ * @return Reference to the value, valid while this version lives.
+ * @throws std::out_of_range if key not found.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+const Value &
+PersistentMap<Key, Value, Compare, Allocator>::at(const key_type &key) const {
+  const value_type *element = this->tree_.find(key);
+  if (!element) {
+    throw std::out_of_range("Key not found");
+  }
+  return element->second;
+}
+
+/**
+ * @brief Finds the value of the key.
+ * @param key Key to search for.
+ * @return Pointer to the value, or nullptr if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+const Value *
+PersistentMap<Key, Value, Compare, Allocator>::find(const key_type &key) const {
+  const value_type *element = this->tree_.find(key);
+  return element ? &element->second : nullptr;
+}
+
+/**
+ * @brief Checks if the map contains the key.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool PersistentMap<Key, Value, Compare, Allocator>::contains(
+    const key_type &key) const {
+  return this->tree_.find(key) != nullptr;
+}
+
+/**
+ * @brief Returns the number of elements with the key (0 or 1).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename PersistentMap<Key, Value, Compare, Allocator>::size_type
+PersistentMap<Key, Value, Compare, Allocator>::count(
+    const key_type &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+// PersistentMap Traversal
+/**
+ * @brief Calls fn(key, value) for every element in key order.
+ * @param fn Callable taking (const key_type &, const mapped_type &).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename Fn>
+void PersistentMap<Key, Value, Compare, Allocator>::for_each(Fn &&fn) const {
+  this->tree_.forEach(
+      [&fn](const value_type &value) { fn(value.first, value.second); });
+}
+
+/**
+ * @brief Copies the elements into an ordinary Map, built in linear time
+ * from the sorted walk.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+s21::Map<Key, Value, Compare, Allocator>
+PersistentMap<Key, Value, Compare, Allocator>::to_map() const {
+  std::vector<value_type> items;
+  items.reserve(size());
+  this->tree_.forEach(
+      [&items](const value_type &value) { items.push_back(value); });
+  return s21::Map<Key, Value, Compare, Allocator>(
+      sorted_unique, items.begin(), items.end());
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks the structure of the tree (see
+ * PersistentTree::checkInvariants).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool PersistentMap<Key, Value, Compare, Allocator>::checkInvariants() const {
+  return this->tree_.checkInvariants();
+}
+
+} // namespace s21
@@ -0,0 +1,89 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_persistent_set.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-24
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_PERSISTENT_SET_H_
+#define CPP2_S21_CONTAINERS_PERSISTENT_SET_H_
+
+#include <initializer_list>
+#include <vector>
+
+#include "../SUPPORT_FUNCTIONS/persistent_tree.h"
+#include "s21_set.h"
+
+namespace s21 {
+
+/**
+ * @brief Immutable set of unique keys; every modification returns a new
+ * version that shares unchanged nodes with the old one.
+ *
+ * insert and erase take O(log n) time and allocate O(log n) nodes;
+ * snapshot() and copying are O(1). See PersistentMap.
+ */
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class PersistentSet {
+public:
+  // PersistentSet Member type:
+  using key_type = Key;
+  using value_type = Key;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using persistent_tree =
+      s21::PersistentTree<Key, value_type, Identity<Key>, Compare, Allocator>;
+
+  // PersistentSet Member functions:
+  PersistentSet();
+  explicit PersistentSet(const allocator_type &alloc);
+  PersistentSet(std::initializer_list<value_type> const &items);
+  PersistentSet(const PersistentSet &s) noexcept;
+  PersistentSet(PersistentSet &&s) noexcept;
+  ~PersistentSet();
+  PersistentSet &operator=(const PersistentSet &s) noexcept;
+  PersistentSet &operator=(PersistentSet &&s) noexcept;
+  allocator_type get_allocator() const noexcept;
+
+  // PersistentSet Capacity:
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+
+  // PersistentSet New versions (this set is not changed):
+  [[nodiscard]] PersistentSet insert(const value_type &value) const;
+  [[nodiscard]] PersistentSet erase(const key_type &key) const;
+  PersistentSet snapshot() const noexcept; // O(1)
+  void swap(PersistentSet &other) noexcept;
+
+  // PersistentSet Lookup:
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+
+  // PersistentSet Traversal:
+  template <typename Fn> void for_each(Fn &&fn) const;
+  s21::Set<Key, Compare, Allocator> to_set() const;
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  explicit PersistentSet(persistent_tree tree) noexcept;
+
+  persistent_tree tree_;
+};
+
+} // namespace s21
+
+#include "s21_persistent_set.tpp"
+
+#endif // CPP2_S21_CONTAINERS_PERSISTENT_SET_H_
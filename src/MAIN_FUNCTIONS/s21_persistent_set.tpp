@@ -0,0 +1,236 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_persistent_set.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-24
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor: an empty set.
+ */
+template <typename Key, typename Compare, typename Allocator>
+PersistentSet<Key, Compare, Allocator>::PersistentSet() : tree_() {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator used for the nodes of all versions.
+ */
+template <typename Key, typename Compare, typename Allocator>
+PersistentSet<Key, Compare, Allocator>::PersistentSet(
+    const allocator_type &alloc)
+    : tree_(alloc) {}
+
+/**
+ * @brief Constructor with initializer list. Repeated keys are skipped.
+ * @param items Initializer list of keys.
+ */
+template <typename Key, typename Compare, typename Allocator>
+PersistentSet<Key, Compare, Allocator>::PersistentSet(
+    std::initializer_list<value_type> const &items)
+    : tree_() {
+  for (const value_type &item : items) {
+    this->tree_ = this->tree_.insert(item, item).first;
+  }
+}
+
+/**
+ * @brief Copy constructor. Shares all nodes with s: O(1).
+ * @param s PersistentSet to copy.
+ */
+template <typename Key, typename Compare, typename Allocator>
+PersistentSet<Key, Compare, Allocator>::PersistentSet(
+    const PersistentSet &s) noexcept
+    : tree_(s.tree_) {}
+
+/**
+ * @brief Move constructor.
+ * @param s PersistentSet to move, left empty.
+ */
+template <typename Key, typename Compare, typename Allocator>
+PersistentSet<Key, Compare, Allocator>::PersistentSet(
+    PersistentSet &&s) noexcept
+    : tree_(std::move(s.tree_)) {}
+
+/**
+ * @brief Constructor of a version from its tree.
+ */
+template <typename Key, typename Compare, typename Allocator>
+PersistentSet<Key, Compare, Allocator>::PersistentSet(
+    persistent_tree tree) noexcept
+    : tree_(std::move(tree)) {}
+
+/**
+ * @brief Destructor. Frees the nodes that no other version refers to.
+ */
+template <typename Key, typename Compare, typename Allocator>
+PersistentSet<Key, Compare, Allocator>::~PersistentSet() = default;
+
+/**
+ * @brief Copy assignment operator. O(1).
+ * @param s PersistentSet to copy.
+ * @return Reference to this PersistentSet.
+ */
+template <typename Key, typename Compare, typename Allocator>
+PersistentSet<Key, Compare, Allocator> &
+PersistentSet<Key, Compare, Allocator>::operator=(
+    const PersistentSet &s) noexcept {
+  this->tree_ = s.tree_;
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator.
+ * @param s PersistentSet to move.
+ * @return Reference to this PersistentSet.
+ */
+template <typename Key, typename Compare, typename Allocator>
+PersistentSet<Key, Compare, Allocator> &
+PersistentSet<Key, Compare, Allocator>::operator=(PersistentSet &&s) noexcept {
+  this->tree_ = std::move(s.tree_);
+  return *this;
+}
+
+/**
+ * @brief Returns the allocator associated with the PersistentSet.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename PersistentSet<Key, Compare, Allocator>::allocator_type
+PersistentSet<Key, Compare, Allocator>::get_allocator() const noexcept {
+  return this->tree_.get_allocator();
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+// PersistentSet Capacity
+/**
+ * @brief Checks whether the set is empty.
+ */
+template <typename Key, typename Compare, typename Allocator>
+bool PersistentSet<Key, Compare, Allocator>::empty() const noexcept {
+  return this->tree_.empty();
+}
+
+/**
+ * @brief Returns the number of elements.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename PersistentSet<Key, Compare, Allocator>::size_type
+PersistentSet<Key, Compare, Allocator>::size() const noexcept {
+  return this->tree_.size();
+}
+
+// PersistentSet New versions
+/**
+ * @brief Returns the version with the key inserted.
+ * @param value Key to insert.
+ * @return New version, or a copy of this one if the key is present.
+ */
+template <typename Key, typename Compare, typename Allocator>
+PersistentSet<Key, Compare, Allocator>
+PersistentSet<Key, Compare, Allocator>::insert(const value_type &value) const {
+  return PersistentSet(this->tree_.insert(value, value).first);
+}
+
+/**
+ * @brief Returns the version without the key.
+ * @param key Key to erase.
+ * @return New version, or a copy of this one if the key is absent.
+ */
+template <typename Key, typename Compare, typename Allocator>
+PersistentSet<Key, Compare, Allocator>
+PersistentSet<Key, Compare, Allocator>::erase(const key_type &key) const {
+  return PersistentSet(this->tree_.erase(key).first);
+}
+
+/**
+ * @brief Returns a point-in-time view of the set in O(1).
+ */
+template <typename Key, typename Compare, typename Allocator>
+PersistentSet<Key, Compare, Allocator>
+PersistentSet<Key, Compare, Allocator>::snapshot() const noexcept {
+  return *this;
+}
+
+/**
+ * @brief Swaps the contents.
+ * @param other PersistentSet to swap with.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void PersistentSet<Key, Compare, Allocator>::swap(
+    PersistentSet &other) noexcept {
+  this->tree_.swap(other.tree_);
+}
+
+// PersistentSet Lookup
+/**
+ * @brief Checks if the set contains the key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+bool PersistentSet<Key, Compare, Allocator>::contains(
+    const key_type &key) const {
+  return this->tree_.find(key) != nullptr;
+}
+
+/**
+ * @brief Returns the number of elements equal to the key (0 or 1).
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename PersistentSet<Key, Compare, Allocator>::size_type
+PersistentSet<Key, Compare, Allocator>::count(const key_type &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+// PersistentSet Traversal
+/**
+ * @brief Calls fn(key) for every key in order.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename Fn>
+void PersistentSet<Key, Compare, Allocator>::for_each(Fn &&fn) const {
+  this->tree_.forEach(fn);
+}
+
+/**
+ * @brief Copies the keys into an ordinary Set, built in linear time from
+ * the sorted walk.
+ */
+template <typename Key, typename Compare, typename Allocator>
+s21::Set<Key, Compare, Allocator>
+PersistentSet<Key, Compare, Allocator>::to_set() const {
+  std::vector<value_type> items;
+  items.reserve(size());
+  this->tree_.forEach(
+      [&items](const value_type &value) { items.push_back(value); });
+  return s21::Set<Key, Compare, Allocator>(sorted_unique, items.begin(),
+                                           items.end());
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks the structure of the tree.
+ */
+template <typename Key, typename Compare, typename Allocator>
+bool PersistentSet<Key, Compare, Allocator>::checkInvariants() const {
+  return this->tree_.checkInvariants();
+}
+
+} // namespace s21
@@ -35,7 +35,7 @@
 
 namespace s21 {
 
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>>
 class queue {
 
 public:
@@ -43,9 +43,10 @@ using value_type = T; // the template parameter T
 using reference	= value_type&; // defines the type of the reference to an element
 using const_reference	= const value_type&; // defines the type of the constant reference
 using size_type	= size_t; // defines the type of the container size (standard type is size_t)
+using allocator_type = Allocator; // аллокатор передаётся нижележащему list
 
 private:
-list<value_type> list_; // Используем контейнер s21::list<T> для эмуляции работы очереди (queue).
+list<value_type, Allocator> list_; // Используем контейнер s21::list<T> для эмуляции работы очереди (queue).
                         // Это нам позволит использовать конструкторы, операторы и методы list для queue
                         // Такой вид наследования в ООП называется "композиция"
 
@@ -60,6 +61,7 @@ public:
 
 
 queue() : list_() {}; //	default constructor, creates empty queue
+explicit queue(const allocator_type &alloc) : list_(alloc) {}; // creates empty queue with the given allocator
 queue(std::initializer_list<value_type> const &items) : list_(items) {}; //	initializer list constructor, creates queue initizialized using std::initializer_list
 queue(const queue &other) : list_(other.list_) {}; //	copy constructor
 queue(queue &&other) noexcept : list_(std::move(other.list_)) {}; //	move constructor
@@ -106,6 +108,10 @@ void swap(queue& other){
     list_.swap(other.list_);
 }	// swaps the contents
 
+allocator_type get_allocator() const noexcept {
+    return list_.get_allocator();
+} // returns the allocator of the underlying list
+
 template <typename... Args>
 void insert_many_back(Args &&...args) {
     list_.insert_many_back(args...);
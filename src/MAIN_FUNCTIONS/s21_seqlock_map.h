@@ -0,0 +1,96 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_seqlock_map.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-17
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_SEQLOCK_MAP_H_
+#define CPP2_S21_CONTAINERS_SEQLOCK_MAP_H_
+
+#include <vector>
+
+#include "../SUPPORT_FUNCTIONS/seqlock_tree.h"
+#include "s21_map.h"
+
+namespace s21 {
+
+/**
+ * @brief Map for read-mostly workloads: lookups take no lock, writers are
+ * serialized.
+ *
+ * find and contains descend the tree optimistically and retry if a writer
+ * changed it meanwhile (see SeqlockTree), so readers never write to a
+ * shared cache line and never wait for each other. Writes are serialized by
+ * one mutex and are more expensive than in Map: every assignment allocates a
+ * new node, and removed nodes are freed only after the readers that might
+ * reach them have finished.
+ *
+ * Like ConcurrentMap, the interface has no iterators and returns no
+ * references; values are returned as copies.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class SeqlockMap {
+public:
+  // SeqlockMap Member type:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using seqlock_tree = s21::SeqlockTree<Key, Value, Compare, Allocator>;
+
+  // SeqlockMap Member functions:
+  SeqlockMap();
+  explicit SeqlockMap(const allocator_type &alloc);
+  SeqlockMap(std::initializer_list<value_type> const &items);
+  SeqlockMap(const SeqlockMap &) = delete;
+  SeqlockMap &operator=(const SeqlockMap &) = delete;
+  ~SeqlockMap();
+
+  // SeqlockMap Capacity:
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+
+  // SeqlockMap Modifiers (serialized):
+  void clear();
+  bool insert(const value_type &value);
+  bool insert(value_type &&value);
+  bool insert(const key_type &key, const mapped_type &obj);
+  template <typename M> bool insert_or_assign(const key_type &key, M &&obj);
+  size_type erase(const key_type &key); // возвращает число удалённых
+
+  // SeqlockMap Lookup (lock-free):
+  std::optional<mapped_type> find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+
+  // SeqlockMap Traversal (holds the writer mutex):
+  template <typename Fn> void for_each(Fn &&fn) const;
+  s21::Map<Key, Value, Compare, Allocator> to_map() const;
+
+  // SeqlockMap Reclamation:
+  bool reclaim();
+  size_type pending_reclaim() const; // удалённые, но ещё не освобождённые
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  seqlock_tree tree_;
+};
+
+} // namespace s21
+
+#include "s21_seqlock_map.tpp"
+
+#endif // CPP2_S21_CONTAINERS_SEQLOCK_MAP_H_
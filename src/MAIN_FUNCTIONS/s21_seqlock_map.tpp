@@ -0,0 +1,234 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_seqlock_map.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-17
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+SeqlockMap<Key, Value, Compare, Allocator>::SeqlockMap() : tree_() {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator used for the nodes of the SeqlockMap.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+SeqlockMap<Key, Value, Compare, Allocator>::SeqlockMap(
+    const allocator_type &alloc)
+    : tree_(alloc) {}
+
+/**
+ * @brief Constructor with initializer list. Repeated keys keep the first
+ * value.
+ * @param items Initializer list of value_type.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+SeqlockMap<Key, Value, Compare, Allocator>::SeqlockMap(
+    std::initializer_list<value_type> const &items)
+    : tree_() {
+  for (const value_type &item : items) {
+    insert(item);
+  }
+}
+
+/**
+ * @brief Destructor. Must not run while other threads use the map.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+SeqlockMap<Key, Value, Compare, Allocator>::~SeqlockMap() = default;
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+// SeqlockMap Capacity
+/**
+ * @brief Checks whether the map is empty.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool SeqlockMap<Key, Value, Compare, Allocator>::empty() const noexcept {
+  return this->tree_.size() == 0;
+}
+
+/**
+ * @brief Returns the number of elements after the last completed write.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename SeqlockMap<Key, Value, Compare, Allocator>::size_type
+SeqlockMap<Key, Value, Compare, Allocator>::size() const noexcept {
+  return this->tree_.size();
+}
+
+// SeqlockMap Modifiers
+/**
+ * @brief Erases all elements.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockMap<Key, Value, Compare, Allocator>::clear() {
+  this->tree_.clear();
+}
+
+/**
+ * @brief Inserts an element if its key is absent.
+ * @param value Element to insert.
+ * @return true if the element was inserted.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool SeqlockMap<Key, Value, Compare, Allocator>::insert(
+    const value_type &value) {
+  return this->tree_.emplaceUnique(value.first, value);
+}
+
+/**
+ * @brief Inserts an element if its key is absent, moving it into the node.
+ * @param value Element to insert.
+ * @return true if the element was inserted.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool SeqlockMap<Key, Value, Compare, Allocator>::insert(value_type &&value) {
+  // ключ ищется до перемещения: элемент строится, только если ключа нет
+  return this->tree_.emplaceUnique(value.first, std::move(value));
+}
+
+/**
+ * @brief Inserts a key with a value if the key is absent.
+ * @param key Key of the element.
+ * @param obj Value of the element.
+ * @return true if the element was inserted.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool SeqlockMap<Key, Value, Compare, Allocator>::insert(
+    const key_type &key, const mapped_type &obj) {
+  return this->tree_.emplaceUnique(key, key, obj);
+}
+
+/**
+ * @brief Inserts a key with a value, or replaces the value of the key.
+ *
+ * The old value is not assigned: a new node replaces the old one, so
+ * concurrent readers copy a whole value.
+ * @param key Key of the element.
+ * @param obj Value to insert or assign.
+ * @return true if the element was inserted, false if it was replaced.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename M>
+bool SeqlockMap<Key, Value, Compare, Allocator>::insert_or_assign(
+    const key_type &key, M &&obj) {
+  return this->tree_.assign(key, std::forward<M>(obj));
+}
+
+/**
+ * @brief Erases the element with the key.
+ * @param key Key to erase.
+ * @return Number of erased elements (0 or 1).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename SeqlockMap<Key, Value, Compare, Allocator>::size_type
+SeqlockMap<Key, Value, Compare, Allocator>::erase(const key_type &key) {
+  return this->tree_.eraseKey(key);
+}
+
+// SeqlockMap Lookup
+/**
+ * @brief Returns a copy of the value of the key without taking a lock.
+ * @param key Key to search for.
+ * @return The value, or std::nullopt if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::optional<Value>
+SeqlockMap<Key, Value, Compare, Allocator>::find(const key_type &key) const {
+  return this->tree_.find(key);
+}
+
+/**
+ * @brief Checks if the map contains the key without taking a lock.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool SeqlockMap<Key, Value, Compare, Allocator>::contains(
+    const key_type &key) const {
+  return this->tree_.contains(key);
+}
+
+// SeqlockMap Traversal
+/**
+ * @brief Calls fn(key, value) for every element in key order.
+ *
+ * Writers wait until the walk ends; readers are not delayed.
+ * @param fn Callable taking (const key_type &, const mapped_type &); must
+ * not modify this map.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename Fn>
+void SeqlockMap<Key, Value, Compare, Allocator>::for_each(Fn &&fn) const {
+  this->tree_.forEach([&fn](const value_type &value) {
+    fn(value.first, static_cast<const mapped_type &>(value.second));
+  });
+}
+
+/**
+ * @brief Copies all elements into an ordinary Map, built in linear time
+ * from the sorted walk.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+s21::Map<Key, Value, Compare, Allocator>
+SeqlockMap<Key, Value, Compare, Allocator>::to_map() const {
+  std::vector<value_type> items;
+  items.reserve(size());
+  this->tree_.forEach(
+      [&items](const value_type &value) { items.push_back(value); });
+  return s21::Map<Key, Value, Compare, Allocator>(
+      sorted_unique, items.begin(), items.end());
+}
+
+// SeqlockMap Reclamation
+/**
+ * @brief Frees the removed nodes that no reader can reach any more; never
+ * waits for readers.
+ * @return true if no removed node is left.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool SeqlockMap<Key, Value, Compare, Allocator>::reclaim() {
+  return this->tree_.reclaim();
+}
+
+/**
+ * @brief Returns the number of removed nodes that are not freed yet.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename SeqlockMap<Key, Value, Compare, Allocator>::size_type
+SeqlockMap<Key, Value, Compare, Allocator>::pending_reclaim() const {
+  return this->tree_.retiredCount();
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks the structure of the tree (see
+ * SeqlockTree::checkInvariants).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool SeqlockMap<Key, Value, Compare, Allocator>::checkInvariants() const {
+  return this->tree_.checkInvariants();
+}
+
+} // namespace s21
@@ -17,11 +17,17 @@
 #define CPP2_S21_CONTAINERS_SAT_H_
 
 #include "../SUPPORT_FUNCTIONS/rb_tree.h"
+#include "../SUPPORT_FUNCTIONS/snapshot.h"
 #include "../s21_common.h" // на случай, если будем собирать только этот контейнер без остальных
 
 namespace s21 {
 
-template <typename Key> class Set {
+template <typename Key, typename Compare, typename Allocator>
+class FrozenSet;
+
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class Set {
 public:
   // Set Member type:
   using key_type = Key;
@@ -29,58 +35,153 @@ public:
   using reference = value_type &;
   using const_reference = const value_type &;
   using size_type = std::size_t;
-  using rb_tree = s21::RBTree<Key>;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using rb_tree = s21::RBTree<Key, Compare, Allocator>;
   using iterator = typename rb_tree::iterator;
   using const_iterator = typename rb_tree::const_iterator;
+  using reverse_iterator = typename rb_tree::reverse_iterator;
+  using const_reverse_iterator = typename rb_tree::const_reverse_iterator;
+  using node_type = typename rb_tree::node_handle;
+  using insert_return_type = s21::RBTInsertReturn<iterator, node_type>;
 
   // Set Member functions:
   Set();
+  explicit Set(const allocator_type &alloc);
   Set(std::initializer_list<value_type> const &items);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  Set(InputIt first, InputIt last);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  Set(sorted_unique_t, InputIt first, InputIt last);
   Set(const Set &s);
   Set(Set &&s) noexcept;
   ~Set();
   Set &operator=(const Set &s);
-  Set &operator=(Set &&s) noexcept;
+  Set &operator=(Set &&s) noexcept(rb_tree::kNothrowMoveAssign);
+  allocator_type get_allocator() const noexcept;
 
   // Set Iterators:
   iterator begin() noexcept;
   iterator end() noexcept;
   const_iterator begin() const noexcept;
   const_iterator end() const noexcept;
+  reverse_iterator rbegin() noexcept;
+  reverse_iterator rend() noexcept;
+  const_reverse_iterator rbegin() const noexcept;
+  const_reverse_iterator rend() const noexcept;
 
   // Set Capacity:
   bool empty() const noexcept;
   size_type size() const noexcept;
   size_type max_size() const noexcept;
+  void reserve(size_type count);
 
   // Set Modifiers:
   void clear() noexcept;
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  void assign(InputIt first, InputIt last);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  void assign(sorted_unique_t, InputIt first, InputIt last);
   std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  iterator insert(const_iterator hint, const value_type &value);
+  iterator insert(const_iterator hint, value_type &&value);
+  insert_return_type insert(node_type &&node);
   template <typename... Args>
   std::vector<std::pair<iterator, bool>> insert_many(Args &&...args);
   void erase(iterator pos) noexcept;
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type &key); // возвращает число удалённых
+  node_type extract(const_iterator pos); // забирает узел из дерева
+  node_type extract(const key_type &key);
   void swap(Set &other) noexcept;
   void merge(Set &other);
+  template <typename... Args>
   std::pair<iterator, bool>
-  emplace(Key &&key); // метод emplace предназначен для вставки элемента
-                      // в контейнер, используя перемещение (move semantics)
-                      // вместо копирования
+  emplace(Args &&...args); // строит ключ прямо в узле дерева из аргументов
+  template <typename... Args>
+  iterator emplace_hint(const_iterator hint, Args &&...args);
 
   // Set Lookup:
   bool
   contains(const key_type &key) const; // проверяет, есть ли в контейнере
                                        // элемент с ключом, эквивалентным ключу
+  size_type count_range(const Key &lo, const Key &hi) const;
   iterator find(const Key &key);
   const_iterator find(const Key &key) const;
+  size_type count(const Key &key) const;
+  std::pair<iterator, iterator> equal_range(const Key &key);
+  std::pair<const_iterator, const_iterator> equal_range(const Key &key) const;
+
+  // Set Heterogeneous lookup (only if Compare::is_transparent):
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  bool contains(const K &key) const;
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  size_type count(const K &key) const;
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  iterator find(const K &key);
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  const_iterator find(const K &key) const;
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  std::pair<iterator, iterator> equal_range(const K &key);
+  template <typename K, typename C = Compare,
+            typename = RequireTransparent<C>>
+  std::pair<const_iterator, const_iterator> equal_range(const K &key) const;
+
+  // Set Batched lookup (descents of several keys are interleaved):
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out);
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt find_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt contains_many(ForwardIt first, ForwardIt last, OutputIt out) const;
+
+  // Set Order statistics:
+  size_type rank(const Key &key) const;
+  iterator nth(size_type k) noexcept;
+  const_iterator nth(size_type k) const noexcept;
+  const_reference select(size_type k) const;
+
+  // Set Set algebra (O(n + m), in parallel for large operands):
+  Set set_union(const Set &other) const;
+  Set set_intersection(const Set &other) const;
+  Set set_difference(const Set &other) const;
+  Set symmetric_difference(const Set &other) const;
+
+  // Set Split and join (O(log n)):
+  Set split(const key_type &key); // забирает ключи не меньше key
+  void join(Set &other);
+
+  // Set Freezing (immutable copy for lookups only, see s21_frozen_set.h):
+  FrozenSet<Key, Compare, Allocator> freeze() const;
+
+  // Set Snapshots (binary, in key order, see snapshot.h):
+  void save(int fd) const;
+  void load(int fd); // O(n): строит дерево из упорядоченных ключей
 
   // Debugging methods:
   void drawSet();
 
 private:
+  template <typename K, typename C, typename A, typename Pred>
+  friend typename Set<K, C, A>::size_type
+  erase_if(Set<K, C, A> &set, Pred pred);
+
   rb_tree tree_;
 };
+
+template <typename Key, typename Compare, typename Allocator, typename Pred>
+typename Set<Key, Compare, Allocator>::size_type
+erase_if(Set<Key, Compare, Allocator> &set, Pred pred);
+
 } // namespace s21
 
 #include "s21_set.tpp"
+#include "s21_frozen_set.h" // определение Set::freeze
 
 #endif // CPP2_S21_CONTAINERS_SAT_H_
@@ -22,37 +22,79 @@ namespace s21 {
 /**
  * @brief Default constructor.
  */
-template <typename Key> Set<Key>::Set() : tree_() {}
+template <typename Key, typename Compare, typename Allocator>
+Set<Key, Compare, Allocator>::Set() : tree_() {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator used for all nodes of the Set.
+ */
+template <typename Key, typename Compare, typename Allocator>
+Set<Key, Compare, Allocator>::Set(const allocator_type &alloc)
+    : tree_(alloc) {}
 
 /**
  * @brief Constructor with initializer list.
  * @param items Initializer list of value_type.
  */
-template <typename Key>
-Set<Key>::Set(std::initializer_list<value_type> const &items) : tree_() {
-  for (auto item : items) {
-    this->tree_.insertUnique(item);
-  }
+template <typename Key, typename Compare, typename Allocator>
+Set<Key, Compare, Allocator>::Set(
+    std::initializer_list<value_type> const &items)
+    : tree_() {
+  this->tree_.assign(items.begin(), items.end(), true);
+}
+
+/**
+ * @brief Range constructor.
+ *
+ * A sorted forward range is built in O(n), any other range is inserted
+ * element by element. Equivalent keys are stored once.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+Set<Key, Compare, Allocator>::Set(InputIt first, InputIt last)
+    : tree_() {
+  this->tree_.assign(first, last, true);
+}
+
+/**
+ * @brief Range constructor for input that is already sorted by key and
+ * has no duplicates.
+ *
+ * The order is not checked, the tree is built in O(n).
+ * @param first Beginning of the sorted range.
+ * @param last End of the sorted range.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+Set<Key, Compare, Allocator>::Set(sorted_unique_t, InputIt first,
+                                  InputIt last)
+    : tree_() {
+  this->tree_.assignSorted(first, last, true);
 }
 
 /**
  * @brief Copy constructor.
  * @param s Set to copy.
  */
-template <typename Key> Set<Key>::Set(const Set &s) : tree_(s.tree_) {}
+template <typename Key, typename Compare, typename Allocator>
+Set<Key, Compare, Allocator>::Set(const Set &s) : tree_(s.tree_) {}
 
 /**
  * @brief Move constructor.
  * @param s Set to move.
  */
-template <typename Key>
-Set<Key>::Set(Set &&s) noexcept : tree_(std::move(s.tree_)) {}
+template <typename Key, typename Compare, typename Allocator>
+Set<Key, Compare, Allocator>::Set(Set &&s) noexcept
+    : tree_(std::move(s.tree_)) {}
 
 /**
  * @brief Destructor.
  */
-template <typename Key>
-Set<Key>::~Set() =
+template <typename Key, typename Compare, typename Allocator>
+Set<Key, Compare, Allocator>::~Set() =
     default; // tree_ сам себя очистит, у него есть свой деструктор
 
 /**
@@ -60,21 +102,41 @@ Set<Key>::~Set() =
  * @param s Set to copy.
  * @return Reference to this Set.
  */
-template <typename Key> Set<Key> &Set<Key>::operator=(const Set &s) {
+template <typename Key, typename Compare, typename Allocator>
+Set<Key, Compare, Allocator> &
+Set<Key, Compare, Allocator>::operator=(const Set &s) {
   this->tree_ = s.tree_;
   return *this;
 }
 
 /**
  * @brief Move assignment operator.
+ *
+ * The nodes are taken over unless the allocators differ and do not
+ * propagate; then the elements are moved into new nodes (see RBTree).
  * @param s Set to move.
  * @return Reference to this Set.
+ * @throws std::bad_alloc and exceptions of the element constructor, only
+ * if the allocator neither propagates nor is always equal.
  */
-template <typename Key> Set<Key> &Set<Key>::operator=(Set &&s) noexcept {
+template <typename Key, typename Compare, typename Allocator>
+Set<Key, Compare, Allocator> &
+Set<Key, Compare, Allocator>::operator=(Set &&s) noexcept(
+    rb_tree::kNothrowMoveAssign) {
   this->tree_ = std::move(s.tree_);
   return *this;
 }
 
+/**
+ * @brief Returns the allocator associated with the Set.
+ * @return Copy of the allocator.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::allocator_type
+Set<Key, Compare, Allocator>::get_allocator() const noexcept {
+  return tree_.get_allocator();
+}
+
 /******************************************************************************
  * MAIN METHODS
  ******************************************************************************/
@@ -84,7 +146,9 @@ template <typename Key> Set<Key> &Set<Key>::operator=(Set &&s) noexcept {
  * @brief Returns an iterator to the beginning.
  * @return Iterator to the beginning.
  */
-template <typename Key> typename Set<Key>::iterator Set<Key>::begin() noexcept {
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::iterator
+Set<Key, Compare, Allocator>::begin() noexcept {
   return this->tree_.begin();
 }
 
@@ -92,7 +156,9 @@ template <typename Key> typename Set<Key>::iterator Set<Key>::begin() noexcept {
  * @brief Returns an iterator to the end.
  * @return Iterator to the end.
  */
-template <typename Key> typename Set<Key>::iterator Set<Key>::end() noexcept {
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::iterator
+Set<Key, Compare, Allocator>::end() noexcept {
   return this->tree_.end();
 }
 
@@ -100,8 +166,9 @@ template <typename Key> typename Set<Key>::iterator Set<Key>::end() noexcept {
  * @brief Returns a const iterator to the beginning.
  * @return Const iterator to the beginning.
  */
-template <typename Key>
-typename Set<Key>::const_iterator Set<Key>::begin() const noexcept {
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::const_iterator
+Set<Key, Compare, Allocator>::begin() const noexcept {
   return this->tree_.begin();
 }
 
@@ -109,17 +176,59 @@ typename Set<Key>::const_iterator Set<Key>::begin() const noexcept {
  * @brief Returns a const iterator to the end.
  * @return Const iterator to the end.
  */
-template <typename Key>
-typename Set<Key>::const_iterator Set<Key>::end() const noexcept {
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::const_iterator
+Set<Key, Compare, Allocator>::end() const noexcept {
   return this->tree_.end();
 }
 
+/**
+ * @brief Returns a reverse iterator to the last element.
+ * @return A reverse iterator to the last element.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::reverse_iterator
+Set<Key, Compare, Allocator>::rbegin() noexcept {
+  return this->tree_.rbegin();
+}
+
+/**
+ * @brief Returns a reverse iterator to the reverse end.
+ * @return A reverse iterator to the reverse end.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::reverse_iterator
+Set<Key, Compare, Allocator>::rend() noexcept {
+  return this->tree_.rend();
+}
+
+/**
+ * @brief Returns a const reverse iterator to the last element.
+ * @return A const reverse iterator to the last element.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::const_reverse_iterator
+Set<Key, Compare, Allocator>::rbegin() const noexcept {
+  return this->tree_.rbegin();
+}
+
+/**
+ * @brief Returns a const reverse iterator to the reverse end.
+ * @return A const reverse iterator to the reverse end.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::const_reverse_iterator
+Set<Key, Compare, Allocator>::rend() const noexcept {
+  return this->tree_.rend();
+}
+
 // Set Capacity
 /**
  * @brief Checks whether the container is empty.
  * @return True if the container is empty, false otherwise.
  */
-template <typename Key> bool Set<Key>::empty() const noexcept {
+template <typename Key, typename Compare, typename Allocator>
+bool Set<Key, Compare, Allocator>::empty() const noexcept {
   return this->tree_.empty();
 }
 
@@ -127,7 +236,8 @@ template <typename Key> bool Set<Key>::empty() const noexcept {
  * @brief Returns the number of elements.
  * @return The number of elements.
  */
-template <typename Key> size_t Set<Key>::size() const noexcept {
+template <typename Key, typename Compare, typename Allocator>
+size_t Set<Key, Compare, Allocator>::size() const noexcept {
   return this->tree_.size();
 }
 
@@ -135,16 +245,56 @@ template <typename Key> size_t Set<Key>::size() const noexcept {
  * @brief Returns the maximum possible number of elements.
  * @return The maximum possible number of elements.
  */
-template <typename Key> size_t Set<Key>::max_size() const noexcept {
+template <typename Key, typename Compare, typename Allocator>
+size_t Set<Key, Compare, Allocator>::max_size() const noexcept {
   return this->tree_.max_size();
 }
 
+/**
+ * @brief Preallocates nodes for count elements.
+ * @param count Number of elements to reserve memory for.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void Set<Key, Compare, Allocator>::reserve(size_type count) {
+  this->tree_.reserve(count);
+}
+
 // Set Modifiers
 /**
  * @brief Clears the contents.
  */
-template <typename Key> void Set<Key>::clear() noexcept { this->tree_.clear(); }
+template <typename Key, typename Compare, typename Allocator>
+void Set<Key, Compare, Allocator>::clear() noexcept { this->tree_.clear(); }
+
 
+/**
+ * @brief Replaces the contents with the keys from [first, last).
+ *
+ * A sorted forward range is built in O(n), any other range is inserted
+ * element by element. Equivalent keys are stored once.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+void Set<Key, Compare, Allocator>::assign(InputIt first, InputIt last) {
+  this->tree_.assign(first, last, true);
+}
+
+/**
+ * @brief Replaces the contents with a range that is already sorted by key
+ * and has no duplicates.
+ *
+ * The order is not checked, the tree is built in O(n).
+ * @param first Beginning of the sorted range.
+ * @param last End of the sorted range.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename InputIt, typename>
+void Set<Key, Compare, Allocator>::assign(sorted_unique_t, InputIt first,
+                                         InputIt last) {
+  this->tree_.assignSorted(first, last, true);
+}
 /**
  * @brief Inserts elements.
  * @param value Value to insert.
@@ -152,12 +302,56 @@ template <typename Key> void Set<Key>::clear() noexcept { this->tree_.clear(); }
  * element that prevented the insertion) and a bool denoting whether the
  * insertion took place.
  */
-template <typename Key>
-std::pair<typename Set<Key>::iterator, bool>
-Set<Key>::insert(const value_type &value) {
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename Set<Key, Compare, Allocator>::iterator, bool>
+Set<Key, Compare, Allocator>::insert(const value_type &value) {
   return this->tree_.insertUnique(value);
 }
 
+/**
+ * @brief Inserts an element, moving it into the container.
+ * @param value Value to insert; left untouched if the key already exists.
+ * @return Pair consisting of an iterator to the inserted element (or to the
+ * element that prevented the insertion) and a bool denoting whether the
+ * insertion took place.
+ */
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename Set<Key, Compare, Allocator>::iterator, bool>
+Set<Key, Compare, Allocator>::insert(value_type &&value) {
+  return this->tree_.insertUnique(std::move(value));
+}
+
+/**
+ * @brief Inserts an element, using hint as a suggestion for its place.
+ *
+ * If the value belongs right before hint (or after the last element for
+ * end()), it is linked without a search from the root.
+ * @param hint Iterator to the element before which value is expected.
+ * @param value Value to insert.
+ * @return Iterator to the inserted element or to the element that prevented
+ * the insertion.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::iterator
+Set<Key, Compare, Allocator>::insert(const_iterator hint,
+                                     const value_type &value) {
+  return this->tree_.insertUnique(hint, value);
+}
+
+/**
+ * @brief Inserts an element moved into the container, using hint as a
+ * suggestion for its place.
+ * @param hint Iterator to the element before which value is expected.
+ * @param value Value to insert; left untouched if the key already exists.
+ * @return Iterator to the inserted element or to the element that prevented
+ * the insertion.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::iterator
+Set<Key, Compare, Allocator>::insert(const_iterator hint, value_type &&value) {
+  return this->tree_.insertUnique(hint, std::move(value));
+}
+
 /**
  * @brief Inserts multiple elements into the set.
  * @tparam Args The types of the elements to insert.
@@ -165,10 +359,10 @@ Set<Key>::insert(const value_type &value) {
  * @return A vector of pairs, where each pair contains an iterator to the
  * inserted element and a boolean indicating success.
  */
-template <typename Key>
+template <typename Key, typename Compare, typename Allocator>
 template <typename... Args>
-std::vector<std::pair<typename Set<Key>::iterator, bool>>
-Set<Key>::insert_many(Args &&...args) {
+std::vector<std::pair<typename Set<Key, Compare, Allocator>::iterator, bool>>
+Set<Key, Compare, Allocator>::insert_many(Args &&...args) {
   std::vector<std::pair<iterator, bool>> results;
   (results.push_back(insert(std::forward<Args>(args))), ...);
   return results;
@@ -178,47 +372,156 @@ Set<Key>::insert_many(Args &&...args) {
  * @brief Erases an element.
  * @param pos Iterator to the element to erase.
  */
-template <typename Key> void Set<Key>::erase(iterator pos) noexcept {
+template <typename Key, typename Compare, typename Allocator>
+void Set<Key, Compare, Allocator>::erase(iterator pos) noexcept {
   this->tree_.erase(pos);
 }
 
+/**
+ * @brief Erases the keys in [first, last).
+ *
+ * Long ranges are cut out of the tree as a whole and the tree is rebalanced
+ * once, in O(log n).
+ *
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @return iterator Iterator to last.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::iterator
+Set<Key, Compare, Allocator>::erase(const_iterator first, const_iterator last) {
+  return this->tree_.erase(first, last);
+}
+
+/**
+ * @brief Erases the element with the key equivalent to key, if any.
+ * @param key Key to erase.
+ * @return size_type Number of erased elements.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::size_type
+Set<Key, Compare, Allocator>::erase(const key_type &key) {
+  return this->tree_.eraseEqual(key);
+}
+
 /**
  * @brief Swaps the contents.
  * @param other Set to swap with.
  */
-template <typename Key> void Set<Key>::swap(Set &other) noexcept {
+template <typename Key, typename Compare, typename Allocator>
+void Set<Key, Compare, Allocator>::swap(Set &other) noexcept {
   std::swap(this->tree_, other.tree_);
 }
 
 /**
  * @brief Merges elements from another set.
+ *
+ * The nodes are moved between the trees without copying the keys; with
+ * equal allocators no memory is allocated. Elements whose keys are already
+ * present stay in other.
  * @param other Set to merge from.
  */
-template <typename Key> void Set<Key>::merge(Set &other) {
+template <typename Key, typename Compare, typename Allocator>
+void Set<Key, Compare, Allocator>::merge(Set &other) {
   this->tree_.mergeUnique(other.tree_);
 }
 
+/**
+ * @brief Inserts the node owned by a node handle.
+ *
+ * The node is linked as is: no memory is allocated and the element is not
+ * copied.
+ * @param node Node handle, obtained from extract() of a container with an
+ * equal allocator.
+ * @return Iterator to the inserted element (or to the element that prevented
+ * the insertion), whether the insertion took place, and the node handle,
+ * which keeps the node if the key already exists.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::insert_return_type
+Set<Key, Compare, Allocator>::insert(node_type &&node) {
+  auto result = this->tree_.insertUnique(std::move(node));
+  return {result.first, result.second, std::move(node)};
+}
+
+/**
+ * @brief Removes the element at pos and returns its node.
+ * @param pos Iterator to the element to extract, must be dereferenceable.
+ * @return Node handle owning the element.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::node_type
+Set<Key, Compare, Allocator>::extract(const_iterator pos) {
+  return this->tree_.extract(pos);
+}
+
+/**
+ * @brief Removes the element with the given key and returns its node.
+ * @param key Key of the element to extract.
+ * @return Node handle owning the element, empty if there is no such key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::node_type
+Set<Key, Compare, Allocator>::extract(const key_type &key) {
+  return this->tree_.extract(key);
+}
+
 /**
  * @brief Checks if the container contains an element with a specific key.
  * @param key Key of the element to search for.
  * @return True if the container contains an element with the key, false
  * otherwise.
  */
-template <typename Key> bool Set<Key>::contains(const Key &key) const {
+template <typename Key, typename Compare, typename Allocator>
+bool Set<Key, Compare, Allocator>::contains(const Key &key) const {
   return this->tree_.contains(key);
 }
 
+/**
+ * @brief Returns the number of elements with keys in [lo, hi).
+ *
+ * Uses the subtree sizes stored in the tree, O(log n).
+ * @param lo Lower bound of the range, included.
+ * @param hi Upper bound of the range, excluded.
+ * @return The number of elements, 0 if hi is not greater than lo.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::size_type
+Set<Key, Compare, Allocator>::count_range(const Key &lo,
+                                          const Key &hi) const {
+  return this->tree_.count_range(lo, hi);
+}
+
 /**
  * @brief Inserts a new element constructed in-place.
- * @param key Key of the element to insert.
+ *
+ * The key is constructed once, directly in the tree node.
+ * @param args Arguments forwarded to the constructor of the key.
  * @return Pair consisting of an iterator to the inserted element (or to the
  * element that prevented the insertion) and a bool denoting whether the
  * insertion took place.
  */
-template <typename Key>
-std::pair<typename Set<Key>::iterator, bool> Set<Key>::emplace(Key &&key) {
-  value_type new_value(std::forward<Key>(key));
-  return tree_.insertUnique(new_value);
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+std::pair<typename Set<Key, Compare, Allocator>::iterator, bool>
+Set<Key, Compare, Allocator>::emplace(Args &&...args) {
+  return this->tree_.emplaceUnique(std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Inserts a new element constructed in-place, using hint as a
+ * suggestion for its place.
+ * @param hint Iterator to the element before which the key is expected.
+ * @param args Arguments forwarded to the constructor of the key.
+ * @return Iterator to the inserted element or to the element that prevented
+ * the insertion.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename... Args>
+typename Set<Key, Compare, Allocator>::iterator
+Set<Key, Compare, Allocator>::emplace_hint(const_iterator hint,
+                                           Args &&...args) {
+  return this->tree_.emplaceHintUnique(hint, std::forward<Args>(args)...);
 }
 
 /**
@@ -226,8 +529,9 @@ std::pair<typename Set<Key>::iterator, bool> Set<Key>::emplace(Key &&key) {
  * @param key Key of the element to find.
  * @return Iterator to the element if found, otherwise end().
  */
-template <typename Key>
-typename Set<Key>::iterator Set<Key>::find(const Key &key) {
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::iterator
+Set<Key, Compare, Allocator>::find(const Key &key) {
   return this->tree_.find(key);
 }
 
@@ -236,11 +540,362 @@ typename Set<Key>::iterator Set<Key>::find(const Key &key) {
  * @param key Key of the element to find.
  * @return Const iterator to the element if found, otherwise end().
  */
-template <typename Key>
-typename Set<Key>::const_iterator Set<Key>::find(const Key &key) const {
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::const_iterator
+Set<Key, Compare, Allocator>::find(const Key &key) const {
   return this->tree_.find(key);
 }
 
+/**
+ * @brief Returns the number of elements with a specific key.
+ * @param key Key of the elements to count.
+ * @return 1 if the container contains the key, 0 otherwise.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::size_type
+Set<Key, Compare, Allocator>::count(const Key &key) const {
+  return this->tree_.contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Returns the range of elements with a specific key.
+ * @param key Key of the elements to search for.
+ * @return Pair of iterators: the element with the key and the one after it,
+ * or two equal iterators if the key is absent.
+ */
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename Set<Key, Compare, Allocator>::iterator,
+          typename Set<Key, Compare, Allocator>::iterator>
+Set<Key, Compare, Allocator>::equal_range(const Key &key) {
+  return {this->tree_.lower_bound(key), this->tree_.upper_bound(key)};
+}
+
+/**
+ * @brief Returns the range of elements with a specific key.
+ * @param key Key of the elements to search for.
+ * @return Pair of const iterators bounding the elements with the key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+std::pair<typename Set<Key, Compare, Allocator>::const_iterator,
+          typename Set<Key, Compare, Allocator>::const_iterator>
+Set<Key, Compare, Allocator>::equal_range(const Key &key) const {
+  return {this->tree_.lower_bound(key), this->tree_.upper_bound(key)};
+}
+
+/******************************************************************************
+ * HETEROGENEOUS LOOKUP
+ ******************************************************************************/
+
+// Поиск по значению любого типа K, сравнимого с Key прозрачным Compare
+// (например, std::string_view при Compare = std::less<>), без построения
+// временного Key.
+
+/**
+ * @brief Checks if the container contains an element equivalent to key.
+ * @param key Value comparable with Key.
+ * @return True if such an element exists, false otherwise.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+bool Set<Key, Compare, Allocator>::contains(const K &key) const {
+  return this->tree_.contains(key);
+}
+
+/**
+ * @brief Returns the number of elements equivalent to key.
+ * @param key Value comparable with Key.
+ * @return 1 if such an element exists, 0 otherwise.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename Set<Key, Compare, Allocator>::size_type
+Set<Key, Compare, Allocator>::count(const K &key) const {
+  return this->tree_.count(key);
+}
+
+/**
+ * @brief Finds an element equivalent to key.
+ * @param key Value comparable with Key.
+ * @return Iterator to the element if found, otherwise end().
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename Set<Key, Compare, Allocator>::iterator
+Set<Key, Compare, Allocator>::find(const K &key) {
+  return this->tree_.find(key);
+}
+
+/**
+ * @brief Finds an element equivalent to key.
+ * @param key Value comparable with Key.
+ * @return Const iterator to the element if found, otherwise end().
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+typename Set<Key, Compare, Allocator>::const_iterator
+Set<Key, Compare, Allocator>::find(const K &key) const {
+  return this->tree_.find(key);
+}
+
+/**
+ * @brief Returns the range of elements equivalent to key.
+ * @param key Value comparable with Key.
+ * @return Pair of iterators bounding the matching elements.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+std::pair<typename Set<Key, Compare, Allocator>::iterator,
+          typename Set<Key, Compare, Allocator>::iterator>
+Set<Key, Compare, Allocator>::equal_range(const K &key) {
+  return {this->tree_.lower_bound(key), this->tree_.upper_bound(key)};
+}
+
+/**
+ * @brief Returns the range of elements equivalent to key.
+ * @param key Value comparable with Key.
+ * @return Pair of const iterators bounding the matching elements.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename K, typename C, typename>
+std::pair<typename Set<Key, Compare, Allocator>::const_iterator,
+          typename Set<Key, Compare, Allocator>::const_iterator>
+Set<Key, Compare, Allocator>::equal_range(const K &key) const {
+  return {this->tree_.lower_bound(key), this->tree_.upper_bound(key)};
+}
+
+/******************************************************************************
+ * BATCHED LOOKUP
+ ******************************************************************************/
+
+// Поиск пачки ключей: спуски по дереву идут вперемешку, промахи кэша
+// разных ключей перекрываются (см. RBTree::findMany).
+
+/**
+ * @brief Finds every key of a range, like find() called for each key.
+ * @param first, last Range of keys (forward iterators).
+ * @param out Receives an iterator to the found element or end() for each
+ * key, in the order of the range.
+ * @return Output iterator past the last written one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt Set<Key, Compare, Allocator>::find_many(
+    ForwardIt first, ForwardIt last, OutputIt out) {
+  return this->tree_.findMany(first, last, out);
+}
+
+/**
+ * @brief Finds every key of a range, like find() called for each key.
+ * @param first, last Range of keys (forward iterators).
+ * @param out Receives a const iterator to the found element or end() for
+ * each key, in the order of the range.
+ * @return Output iterator past the last written one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt Set<Key, Compare, Allocator>::find_many(
+    ForwardIt first, ForwardIt last, OutputIt out) const {
+  return this->tree_.findMany(first, last, out);
+}
+
+/**
+ * @brief Checks every key of a range, like contains() called for each key.
+ * @param first, last Range of keys (forward iterators).
+ * @param out Receives true or false for each key, in the order of the range.
+ * @return Output iterator past the last written one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt Set<Key, Compare, Allocator>::contains_many(
+    ForwardIt first, ForwardIt last, OutputIt out) const {
+  return this->tree_.containsMany(first, last, out);
+}
+
+/******************************************************************************
+ * ORDER STATISTICS
+ ******************************************************************************/
+
+/**
+ * @brief Returns the number of elements with keys less than key, O(log n).
+ * @param key Key to rank.
+ * @return Position of the first element not less than key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::size_type
+Set<Key, Compare, Allocator>::rank(const Key &key) const {
+  return this->tree_.rank(key);
+}
+
+/**
+ * @brief Returns an iterator to the element at position k in key order,
+ * O(log n).
+ * @param k Zero-based position.
+ * @return Iterator to the k-th element, end() if k >= size().
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::iterator
+Set<Key, Compare, Allocator>::nth(size_type k) noexcept {
+  return this->tree_.nth(k);
+}
+
+/**
+ * @brief Returns a const iterator to the element at position k in key order,
+ * O(log n).
+ * @param k Zero-based position.
+ * @return Const iterator to the k-th element, end() if k >= size().
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::const_iterator
+Set<Key, Compare, Allocator>::nth(size_type k) const noexcept {
+  return this->tree_.nth(k);
+}
+
+/**
+ * @brief Returns the element at position k in key order, O(log n).
+ * @param k Zero-based position.
+ * @return The k-th smallest element.
+ * @throws std::out_of_range if k >= size().
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename Set<Key, Compare, Allocator>::const_reference
+Set<Key, Compare, Allocator>::select(size_type k) const {
+  return this->tree_.select(k);
+}
+
+/**
+ * @brief Returns the keys that are in this set or in other.
+ *
+ * Both sets are walked once in key order and the result is built from
+ * the sorted sequence in O(n + m); large operands are merged by several
+ * threads.
+ * @param other The second operand.
+ * @return A new set with the allocator of this one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+Set<Key, Compare, Allocator>
+Set<Key, Compare, Allocator>::set_union(const Set &other) const {
+  Set result(get_allocator());
+  result.tree_ = this->tree_.setUnion(other.tree_);
+  return result;
+}
+
+/**
+ * @brief Returns the keys that are both in this set and in other.
+ *
+ * O(n + m).
+ * @param other The second operand.
+ * @return A new set with the allocator of this one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+Set<Key, Compare, Allocator>
+Set<Key, Compare, Allocator>::set_intersection(const Set &other) const {
+  Set result(get_allocator());
+  result.tree_ = this->tree_.setIntersection(other.tree_);
+  return result;
+}
+
+/**
+ * @brief Returns the keys of this set that are not in other.
+ *
+ * O(n + m).
+ * @param other The second operand.
+ * @return A new set with the allocator of this one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+Set<Key, Compare, Allocator>
+Set<Key, Compare, Allocator>::set_difference(const Set &other) const {
+  Set result(get_allocator());
+  result.tree_ = this->tree_.setDifference(other.tree_);
+  return result;
+}
+
+/**
+ * @brief Returns the keys that are in exactly one of the two sets.
+ *
+ * O(n + m).
+ * @param other The second operand.
+ * @return A new set with the allocator of this one.
+ */
+template <typename Key, typename Compare, typename Allocator>
+Set<Key, Compare, Allocator>
+Set<Key, Compare, Allocator>::symmetric_difference(const Set &other) const {
+  Set result(get_allocator());
+  result.tree_ = this->tree_.symmetricDifference(other.tree_);
+  return result;
+}
+
+/**
+ * @brief Moves the keys with keys not less than key into a new set.
+ *
+ * The tree is cut along one path in O(log n); elements are neither copied
+ * nor reallocated.
+ * @param key The split key.
+ * @return A set with the keys not less than key; this set keeps the
+ * smaller ones.
+ */
+template <typename Key, typename Compare, typename Allocator>
+Set<Key, Compare, Allocator>
+Set<Key, Compare, Allocator>::split(const key_type &key) {
+  Set result(get_allocator());
+  result.tree_ = this->tree_.split(key);
+  return result;
+}
+
+/**
+ * @brief Moves all elements of other into this set in O(log n).
+ *
+ * The keys of other must be entirely before or entirely after the keys
+ * of this set.
+ * @param other Set to take the elements from, left empty.
+ * @throws std::invalid_argument if the key ranges overlap.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void Set<Key, Compare, Allocator>::join(Set &other) {
+  this->tree_.joinUnique(other.tree_);
+}
+
+/******************************************************************************
+ * SNAPSHOTS
+ ******************************************************************************/
+
+/**
+ * @brief Writes a binary snapshot of the set to a file descriptor.
+ *
+ * The elements are written in key order, so load() can build the
+ * tree in O(n). The format is described in SUPPORT_FUNCTIONS/snapshot.h.
+ * @param fd Descriptor open for writing; it is not closed.
+ * @throws std::system_error if the descriptor cannot be written.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void Set<Key, Compare, Allocator>::save(int fd) const {
+  saveSnapshot<key_type>(fd, SnapshotKind::kSet, this->tree_.cbegin(),
+                       this->tree_.size());
+}
+
+/**
+ * @brief Replaces the contents with a snapshot written by save().
+ *
+ * The elements are decoded straight into the nodes of a tree built in
+ * O(n), without inserting them one by one; then one pass checks that they
+ * are in order. If anything fails the set is not changed.
+ * @param fd Descriptor open for reading, positioned at the snapshot; the
+ * data after the snapshot is not read.
+ * @throws std::runtime_error if the data is not a snapshot of this
+ * container, std::invalid_argument if the keys are out of order,
+ * std::system_error if the descriptor cannot be read.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void Set<Key, Compare, Allocator>::load(int fd) {
+  SnapshotReader reader = openSnapshot<key_type>(fd, SnapshotKind::kSet);
+  Set loaded(get_allocator());
+  loaded.tree_.assignSortedN(
+      std::make_move_iterator(
+          SnapshotInputIterator<key_type>(reader, reader.count())),
+      reader.count(), reader.reserveCount(), true);
+  reader.finish();
+  swap(loaded);
+}
+
 /******************************************************************************
  * DEBUGGING METHODS
  ******************************************************************************/
@@ -248,6 +903,27 @@ typename Set<Key>::const_iterator Set<Key>::find(const Key &key) const {
 /**
  * @brief Prints the set structure for debugging purposes.
  */
-template <typename Key> void Set<Key>::drawSet() { tree_.drawTree(); }
+template <typename Key, typename Compare, typename Allocator>
+void Set<Key, Compare, Allocator>::drawSet() { tree_.drawTree(); }
+
+/******************************************************************************
+ * NON-MEMBER FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * @brief Erases all keys that satisfy pred, O(n).
+ *
+ * Runs of consecutive matching elements are erased as whole ranges, so
+ * long runs are cut out of the tree at once.
+ *
+ * @param set The container to erase from.
+ * @param pred Predicate called once for every key in key order.
+ * @return size_type Number of erased elements.
+ */
+template <typename Key, typename Compare, typename Allocator, typename Pred>
+typename Set<Key, Compare, Allocator>::size_type
+erase_if(Set<Key, Compare, Allocator> &set, Pred pred) {
+  return set.tree_.eraseIf(pred);
+}
 
 } // namespace s21
@@ -39,14 +39,15 @@
 
 namespace s21 {
 
-template <typename T>
-class stack : private vector<T> {
+template <typename T, typename Allocator = std::allocator<T>>
+class stack : private vector<T, Allocator> {
 
 public:
 using value_type = T; // the template parameter T
 using reference = value_type&; // defines the type of the reference to an element
 using const_reference = const value_type&; // defines the type of the constant reference
 using size_type = size_t; // defines the type of the container size (standard type is size_t)
+using allocator_type = Allocator; // аллокатор передаётся нижележащему vector
 
 
 /******************************************************
@@ -57,16 +58,17 @@ using size_type = size_t; // defines the type of the container size (standard ty
 
 
 
-stack() : vector<value_type>() {}; // default constructor, creates empty stack
-stack(std::initializer_list<value_type> const &items) : vector<value_type>(items) {}; // initializer stack constructor
-stack(const stack &other) : vector<value_type>(other) {};// copy constructor
-stack(stack &&other) noexcept : vector<value_type>(std::move(other)) {}; //	move constructor
+stack() : vector<value_type, Allocator>() {}; // default constructor, creates empty stack
+explicit stack(const allocator_type &alloc) : vector<value_type, Allocator>(alloc) {}; // creates empty stack with the given allocator
+stack(std::initializer_list<value_type> const &items) : vector<value_type, Allocator>(items) {}; // initializer stack constructor
+stack(const stack &other) : vector<value_type, Allocator>(other) {};// copy constructor
+stack(stack &&other) noexcept : vector<value_type, Allocator>(std::move(other)) {}; //	move constructor
 
 
     // Оператор присваивания копированием
     stack& operator=(const stack& other) {
         if (this != &other) {
-            vector<value_type>::operator=(other);
+            vector<value_type, Allocator>::operator=(other);
         }
         return *this;
     }
@@ -74,7 +76,7 @@ stack(stack &&other) noexcept : vector<value_type>(std::move(other)) {}; //	move
     // Оператор присваивания перемещением
     stack& operator=(stack&& other) noexcept {
             if (this != &other) {
-                vector<value_type>::operator=(std::move(other));
+                vector<value_type, Allocator>::operator=(std::move(other));
             }
     return *this;
         }
@@ -90,35 +92,39 @@ stack(stack &&other) noexcept : vector<value_type>(std::move(other)) {}; //	move
 
 
 const_reference top() {
-    return vector<value_type>::back();
+    return vector<value_type, Allocator>::back();
 } // accesses the top element
 
 
 void push(const_reference value) {
-    vector<value_type>::push_back(value);
+    vector<value_type, Allocator>::push_back(value);
 } // inserts element at the top
 
 void pop() {
-    vector<value_type>::pop_back();
+    vector<value_type, Allocator>::pop_back();
 } // removes the top element
 
 
 bool empty(){
-    return vector<value_type>::empty();
+    return vector<value_type, Allocator>::empty();
 } // checks whether the container is empty
 
 size_type size() {
-    return vector<value_type>::size();
+    return vector<value_type, Allocator>::size();
 } // returns the number of elements
 
 void swap(stack& other){
-    vector<value_type>::swap(other);
+    vector<value_type, Allocator>::swap(other);
 } // swaps the contents
 
+allocator_type get_allocator() const noexcept {
+    return vector<value_type, Allocator>::get_allocator();
+} // returns the allocator of the underlying vector
+
 
 template <typename... Args>
 void insert_many_back(Args &&...args) {
-    vector<value_type>::insert_many(vector<value_type>::end(), args...);
+    vector<value_type, Allocator>::insert_many(vector<value_type, Allocator>::end(), args...);
 } // вставка списка элементов
 
 
@@ -0,0 +1,160 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_unordered_map.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-03
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_UNORDERED_MAP_H_
+#define CPP2_S21_CONTAINERS_UNORDERED_MAP_H_
+
+#include <vector>
+
+#include "../SUPPORT_FUNCTIONS/hash_table.h"
+
+namespace s21 {
+
+/**
+ * @brief Unordered map with unique keys stored in an open-addressing hash
+ * table.
+ *
+ * Has the lookup and insertion interface of Map, but finds a key in O(1) on
+ * average: 16 one-byte fingerprints are compared at once before any key is.
+ * The pairs are stored directly in the slot array, in no particular order.
+ * Erasure does not move other elements; every insertion may rebuild the
+ * table and invalidate all iterators and references.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class UnorderedMap {
+public:
+  // UnorderedMap Member type:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const key_type, mapped_type>;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using hash_table = s21::HashTable<Key, value_type, SelectFirst<Key>,
+                                    Hash, KeyEqual, Allocator>;
+  using iterator = typename hash_table::iterator;
+  using const_iterator = typename hash_table::const_iterator;
+
+  // UnorderedMap Member functions:
+  UnorderedMap();
+  explicit UnorderedMap(const allocator_type &alloc);
+  explicit UnorderedMap(size_type count, const hasher &hash = hasher(),
+                        const key_equal &equal = key_equal(),
+                        const allocator_type &alloc = allocator_type());
+  UnorderedMap(std::initializer_list<value_type> const &items);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  UnorderedMap(InputIt first, InputIt last);
+  UnorderedMap(const UnorderedMap &m);
+  UnorderedMap(UnorderedMap &&m) noexcept;
+  ~UnorderedMap();
+  UnorderedMap &operator=(const UnorderedMap &m);
+  UnorderedMap &operator=(UnorderedMap &&m) noexcept;
+  allocator_type get_allocator() const noexcept;
+  hasher hash_function() const;
+  key_equal key_eq() const;
+
+  // UnorderedMap Element access:
+  mapped_type &at(const key_type &key);
+  const mapped_type &at(const key_type &key) const;
+  mapped_type &operator[](const key_type &key);
+
+  // UnorderedMap Iterators:
+  iterator begin() noexcept;
+  iterator end() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+
+  // UnorderedMap Capacity:
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  size_type capacity() const noexcept; // число ячеек таблицы
+  float load_factor() const noexcept;
+  void reserve(size_type count);
+  size_type memory_usage() const noexcept; // байты ячеек и управляющих байтов
+
+  // UnorderedMap Modifiers:
+  void clear() noexcept;
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  std::pair<iterator, bool> insert(const key_type &key,
+                                   const mapped_type &obj);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  void insert(InputIt first, InputIt last);
+  template <typename M>
+  std::pair<iterator, bool> insert_or_assign(const key_type &key, M &&obj);
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const key_type &key, Args &&...args);
+  template <typename... Args>
+  std::vector<bool> insert_many(Args &&...args); // true - пара вставлена
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type &key); // возвращает число удалённых
+  void swap(UnorderedMap &other) noexcept;
+  void merge(UnorderedMap &other);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+
+  // UnorderedMap Lookup:
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  iterator find(const key_type &key);
+  const_iterator find(const key_type &key) const;
+  std::pair<iterator, iterator> equal_range(const key_type &key);
+  std::pair<const_iterator, const_iterator>
+  equal_range(const key_type &key) const;
+
+  // UnorderedMap Heterogeneous lookup (only if Hash and KeyEqual are
+  // transparent):
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = RequireTransparentHash<H, E>>
+  bool contains(const K &key) const;
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = RequireTransparentHash<H, E>>
+  size_type count(const K &key) const;
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = RequireTransparentHash<H, E>>
+  iterator find(const K &key);
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = RequireTransparentHash<H, E>>
+  const_iterator find(const K &key) const;
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  template <typename K, typename V, typename H, typename E, typename A,
+            typename Pred>
+  friend typename UnorderedMap<K, V, H, E, A>::size_type
+  erase_if(UnorderedMap<K, V, H, E, A> &map, Pred pred);
+
+  hash_table table_;
+};
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator, typename Pred>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::size_type
+erase_if(UnorderedMap<Key, Value, Hash, KeyEqual, Allocator> &map, Pred pred);
+
+} // namespace s21
+
+#include "s21_unordered_map.tpp"
+
+#endif // CPP2_S21_CONTAINERS_UNORDERED_MAP_H_
@@ -0,0 +1,742 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_unordered_map.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-03
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor. No memory is allocated until the first
+ * insertion.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::UnorderedMap()
+    : table_() {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator used for the arrays of the UnorderedMap.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::UnorderedMap(
+    const allocator_type &alloc)
+    : table_(alloc) {}
+
+/**
+ * @brief Creates an empty map with room for count pairs.
+ * @param count Number of pairs that can be inserted without rebuilding.
+ * @param hash Hash function of keys.
+ * @param equal Equality of keys.
+ * @param alloc Allocator used for the arrays of the UnorderedMap.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::UnorderedMap(
+    size_type count, const hasher &hash, const key_equal &equal,
+    const allocator_type &alloc)
+    : table_(hash, equal, alloc) {
+  this->table_.reserve(count);
+}
+
+/**
+ * @brief Constructor with initializer list.
+ * @param items Initializer list of value_type.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::UnorderedMap(
+    std::initializer_list<value_type> const &items)
+    : UnorderedMap(items.begin(), items.end()) {}
+
+/**
+ * @brief Range constructor. Only the first pair with each key is stored.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename InputIt, typename>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::UnorderedMap(
+    InputIt first, InputIt last)
+    : table_() {
+  insert(first, last);
+}
+
+/**
+ * @brief Copy constructor.
+ * @param m UnorderedMap to copy.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::UnorderedMap(
+    const UnorderedMap &m)
+    : table_(m.table_) {}
+
+/**
+ * @brief Move constructor.
+ * @param m UnorderedMap to move.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::UnorderedMap(
+    UnorderedMap &&m) noexcept
+    : table_(std::move(m.table_)) {}
+
+/**
+ * @brief Destructor.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::~UnorderedMap() =
+    default;
+
+/**
+ * @brief Copy assignment operator.
+ * @param m UnorderedMap to copy.
+ * @return Reference to this UnorderedMap.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator> &
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::operator=(
+    const UnorderedMap &m) {
+  this->table_ = m.table_;
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator.
+ * @param m UnorderedMap to move.
+ * @return Reference to this UnorderedMap.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator> &
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::operator=(
+    UnorderedMap &&m) noexcept {
+  this->table_ = std::move(m.table_);
+  return *this;
+}
+
+/**
+ * @brief Returns the allocator associated with the UnorderedMap.
+ * @return Copy of the allocator.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::allocator_type
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::get_allocator()
+    const noexcept {
+  return this->table_.get_allocator();
+}
+
+/**
+ * @brief Returns the hash function of keys.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::hasher
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::hash_function() const {
+  return this->table_.hash_function();
+}
+
+/**
+ * @brief Returns the equality of keys.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::key_equal
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::key_eq() const {
+  return this->table_.key_eq();
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+// UnorderedMap Element access
+/**
+ * @brief Access specified element with bounds checking.
+ * @param key Key of the element to access.
+ * @return Reference to the mapped value.
+ * @throws std::out_of_range if the key is absent.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::mapped_type &
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::at(const key_type &key) {
+  return const_cast<mapped_type &>(
+      static_cast<const UnorderedMap *>(this)->at(key));
+}
+
+/**
+ * @brief Access specified element with bounds checking.
+ * @param key Key of the element to access.
+ * @return Const reference to the mapped value.
+ * @throws std::out_of_range if the key is absent.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+const typename UnorderedMap<Key, Value, Hash, KeyEqual,
+                            Allocator>::mapped_type &
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::at(
+    const key_type &key) const {
+  auto it = this->find(key);
+  if (it == this->end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+/**
+ * @brief Access or insert value.
+ *
+ * The key is hashed once: a value-initialized element is inserted only if
+ * the key is absent.
+ * @param key Key of the element to access.
+ * @return Reference to the mapped value.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::mapped_type &
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::operator[](
+    const key_type &key) {
+  return try_emplace(key).first->second;
+}
+
+// UnorderedMap Iterators
+/**
+ * @brief Returns an iterator to the first element (in slot order).
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::iterator
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::begin() noexcept {
+  return this->table_.begin();
+}
+
+/**
+ * @brief Returns an iterator to the end.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::iterator
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::end() noexcept {
+  return this->table_.end();
+}
+
+/**
+ * @brief Returns a const iterator to the first element (in slot order).
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::const_iterator
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::begin() const noexcept {
+  return this->table_.begin();
+}
+
+/**
+ * @brief Returns a const iterator to the end.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::const_iterator
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::end() const noexcept {
+  return this->table_.end();
+}
+
+// UnorderedMap Capacity
+/**
+ * @brief Checks whether the container is empty.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+bool UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::empty()
+    const noexcept {
+  return this->table_.empty();
+}
+
+/**
+ * @brief Returns the number of elements.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::size_type
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::size() const noexcept {
+  return this->table_.size();
+}
+
+/**
+ * @brief Returns the maximum possible number of elements.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::size_type
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::max_size()
+    const noexcept {
+  return this->table_.max_size();
+}
+
+/**
+ * @brief Returns the number of slots of the table; at most 7/8 of them are
+ * used before the table grows.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::size_type
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::capacity()
+    const noexcept {
+  return this->table_.capacity();
+}
+
+/**
+ * @brief Returns the number of elements divided by the number of slots.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+float UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::load_factor()
+    const noexcept {
+  return this->table_.loadFactor();
+}
+
+/**
+ * @brief Makes room for count pairs, so that inserting up to count pairs
+ * does not rebuild the table.
+ * @param count Number of pairs.
+ * @throws std::length_error if count exceeds max_size().
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+void UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::reserve(
+    size_type count) {
+  this->table_.reserve(count);
+}
+
+/**
+ * @brief Returns the number of bytes of the slot and control arrays.
+ *
+ * Counts all slots, including the free ones; allocator overhead and memory
+ * owned by the keys and values themselves are not included.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::size_type
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::memory_usage()
+    const noexcept {
+  return this->table_.memoryUsage();
+}
+
+// UnorderedMap Modifiers
+/**
+ * @brief Clears the contents; the slots stay allocated.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+void UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::clear() noexcept {
+  this->table_.clear();
+}
+
+/**
+ * @brief Inserts a pair if its key is absent.
+ * @param value Pair to insert.
+ * @return Pair consisting of an iterator to the inserted element (or to the
+ * element that prevented the insertion) and a bool denoting whether the
+ * insertion took place.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+std::pair<typename UnorderedMap<Key, Value, Hash, KeyEqual,
+                                Allocator>::iterator,
+          bool>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::insert(
+    const value_type &value) {
+  return this->table_.insert(value);
+}
+
+/**
+ * @brief Inserts a pair if its key is absent, moving it into the table.
+ * @param value Pair to insert.
+ * @return Same as insert(const value_type &).
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+std::pair<typename UnorderedMap<Key, Value, Hash, KeyEqual,
+                                Allocator>::iterator,
+          bool>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::insert(
+    value_type &&value) {
+  return this->table_.insert(std::move(value));
+}
+
+/**
+ * @brief Inserts a pair built from key and obj if the key is absent.
+ * @param key Key of the element to insert.
+ * @param obj Value of the element to insert.
+ * @return Same as insert(const value_type &).
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+std::pair<typename UnorderedMap<Key, Value, Hash, KeyEqual,
+                                Allocator>::iterator,
+          bool>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::insert(
+    const key_type &key, const mapped_type &obj) {
+  return try_emplace(key, obj);
+}
+
+/**
+ * @brief Inserts the pairs of [first, last) whose keys are absent.
+ *
+ * For forward ranges the table is grown once for the whole range.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename InputIt, typename>
+void UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::insert(
+    InputIt first, InputIt last) {
+  using category = typename std::iterator_traits<InputIt>::iterator_category;
+  if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+    this->table_.reserve(size() +
+                         static_cast<size_type>(std::distance(first, last)));
+  }
+  for (; first != last; ++first) {
+    this->table_.insert(*first);
+  }
+}
+
+/**
+ * @brief Inserts a pair or assigns obj if the key already exists.
+ * @param key Key of the element.
+ * @param obj Value to insert or assign.
+ * @return Iterator to the element and whether it was inserted.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename M>
+std::pair<typename UnorderedMap<Key, Value, Hash, KeyEqual,
+                                Allocator>::iterator,
+          bool>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::insert_or_assign(
+    const key_type &key, M &&obj) {
+  // tryEmplace не трогает obj, если ключ уже есть
+  auto result = this->table_.tryEmplace(key, std::forward<M>(obj));
+  if (!result.second) {
+    result.first->second = std::forward<M>(obj);
+  }
+  return result;
+}
+
+/**
+ * @brief Inserts a pair with the value built from args if the key is absent.
+ *
+ * If the key already exists, nothing is constructed and args are not moved
+ * from.
+ * @param key Key of the element to insert.
+ * @param args Arguments forwarded to the constructor of the mapped value.
+ * @return Iterator to the element and whether it was inserted.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename... Args>
+std::pair<typename UnorderedMap<Key, Value, Hash, KeyEqual,
+                                Allocator>::iterator,
+          bool>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::try_emplace(
+    const key_type &key, Args &&...args) {
+  return this->table_.tryEmplace(key, std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Inserts multiple pairs.
+ *
+ * Each insertion may invalidate the iterators returned by the previous
+ * ones, so only the results are reported.
+ * @param args The pairs to insert.
+ * @return For each pair, whether it was inserted.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename... Args>
+std::vector<bool>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::insert_many(
+    Args &&...args) {
+  std::vector<bool> results;
+  results.reserve(sizeof...(args));
+  this->table_.reserve(size() + sizeof...(args));
+  (results.push_back(insert(std::forward<Args>(args)).second), ...);
+  return results;
+}
+
+/**
+ * @brief Erases an element; the other elements stay in place.
+ * @param pos Iterator to the element to erase.
+ * @return Iterator to the next element in slot order.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::iterator
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::erase(
+    const_iterator pos) {
+  return this->table_.erase(pos);
+}
+
+/**
+ * @brief Erases the elements in [first, last).
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @return Iterator last.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::iterator
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::erase(
+    const_iterator first, const_iterator last) {
+  return this->table_.erase(first, last);
+}
+
+/**
+ * @brief Erases the element with the key.
+ * @param key Key of the element to erase.
+ * @return Number of erased elements (0 or 1).
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::size_type
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::erase(
+    const key_type &key) {
+  return this->table_.eraseKey(key);
+}
+
+/**
+ * @brief Swaps the contents.
+ * @param other UnorderedMap to swap with.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+void UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::swap(
+    UnorderedMap &other) noexcept {
+  this->table_.swap(other.table_);
+}
+
+/**
+ * @brief Moves the pairs of other whose keys are absent here into this map.
+ *
+ * Elements live inside the slot array, so the pairs are moved one by one.
+ * Pairs with keys that are already present stay in other.
+ * @param other UnorderedMap to merge from.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+void UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::merge(
+    UnorderedMap &other) {
+  if (this == &other) {
+    return;
+  }
+  for (auto it = other.table_.begin(); it != other.table_.end();) {
+    if (this->table_.insert(std::move(*it)).second) {
+      it = other.table_.erase(it);
+    } else {
+      ++it; // пара не перемещена: insert не трогает её при совпадении
+    }
+  }
+}
+
+/**
+ * @brief Builds a pair from args and inserts it if its key is absent.
+ * @param args Arguments of the pair constructor.
+ * @return Same as insert(const value_type &).
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename... Args>
+std::pair<typename UnorderedMap<Key, Value, Hash, KeyEqual,
+                                Allocator>::iterator,
+          bool>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::emplace(Args &&...args) {
+  return this->table_.emplace(std::forward<Args>(args)...);
+}
+
+// UnorderedMap Lookup
+/**
+ * @brief Checks if the container contains an element with the key.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+bool UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::contains(
+    const key_type &key) const {
+  return this->table_.find(key) != this->table_.end();
+}
+
+/**
+ * @brief Returns the number of elements with the key (0 or 1).
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::size_type
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::count(
+    const key_type &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Finds the element with the key.
+ * @param key Key to search for.
+ * @return Iterator to the element, or end() if the key is absent.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::iterator
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::find(
+    const key_type &key) {
+  return this->table_.find(key);
+}
+
+/**
+ * @brief Finds the element with the key.
+ * @param key Key to search for.
+ * @return Const iterator to the element, or end() if the key is absent.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::const_iterator
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::find(
+    const key_type &key) const {
+  return this->table_.find(key);
+}
+
+/**
+ * @brief Returns the range of elements with the key.
+ * @param key Key to search for.
+ * @return Pair of iterators: the element and the one after it, or two end()
+ * iterators if the key is absent.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+std::pair<
+    typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::iterator,
+    typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::iterator>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::equal_range(
+    const key_type &key) {
+  iterator it = find(key);
+  return {it, it == end() ? it : std::next(it)};
+}
+
+/**
+ * @brief Returns the range of elements with the key.
+ * @param key Key to search for.
+ * @return Pair of const iterators bounding the element with the key.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+std::pair<typename UnorderedMap<Key, Value, Hash, KeyEqual,
+                                Allocator>::const_iterator,
+          typename UnorderedMap<Key, Value, Hash, KeyEqual,
+                                Allocator>::const_iterator>
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::equal_range(
+    const key_type &key) const {
+  const_iterator it = find(key);
+  return {it, it == end() ? it : std::next(it)};
+}
+
+// UnorderedMap Heterogeneous lookup
+/**
+ * @brief Checks if the container contains an element whose key is equal to
+ * key of another type; the key is not converted to key_type.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename K, typename H, typename E, typename>
+bool UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::contains(
+    const K &key) const {
+  return this->table_.find(key) != this->table_.end();
+}
+
+/**
+ * @brief Returns the number of elements whose key is equal to key of
+ * another type (0 or 1).
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename K, typename H, typename E, typename>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::size_type
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::count(
+    const K &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Finds the element whose key is equal to key of another type.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename K, typename H, typename E, typename>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::iterator
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::find(const K &key) {
+  return this->table_.find(key);
+}
+
+/**
+ * @brief Finds the element whose key is equal to key of another type.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+template <typename K, typename H, typename E, typename>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::const_iterator
+UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::find(
+    const K &key) const {
+  return this->table_.find(key);
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks the structure of the hash table (see
+ * HashTable::checkInvariants).
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+bool UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::checkInvariants()
+    const {
+  return this->table_.checkInvariants();
+}
+
+/******************************************************************************
+ * NON-MEMBER FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * @brief Erases all elements that satisfy pred.
+ *
+ * @param map The container to erase from.
+ * @param pred Predicate called once for every element in slot order.
+ * @return size_type Number of erased elements.
+ */
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator, typename Pred>
+typename UnorderedMap<Key, Value, Hash, KeyEqual, Allocator>::size_type
+erase_if(UnorderedMap<Key, Value, Hash, KeyEqual, Allocator> &map,
+         Pred pred) {
+  return map.table_.eraseIf(pred);
+}
+
+} // namespace s21
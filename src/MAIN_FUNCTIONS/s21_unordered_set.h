@@ -0,0 +1,139 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_unordered_set.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-03
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_UNORDERED_SET_H_
+#define CPP2_S21_CONTAINERS_UNORDERED_SET_H_
+
+#include <vector>
+
+#include "../SUPPORT_FUNCTIONS/hash_table.h"
+
+namespace s21 {
+
+/**
+ * @brief Unordered set of unique keys stored in an open-addressing hash
+ * table.
+ *
+ * Has the lookup and insertion interface of Set without the ordered
+ * operations; membership tests take O(1) on average. The keys are stored
+ * directly in the slot array. Erasure does not move other keys; every
+ * insertion may rebuild the table and invalidate all iterators.
+ */
+template <typename Key, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>,
+          typename Allocator = std::allocator<Key>>
+class UnorderedSet {
+public:
+  // UnorderedSet Member type:
+  using key_type = Key;
+  using value_type = Key;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using hash_table =
+      s21::HashTable<Key, Key, Identity<Key>, Hash, KeyEqual, Allocator>;
+  // ключи множества неизменяемы: оба итератора константные
+  using iterator = typename hash_table::const_iterator;
+  using const_iterator = typename hash_table::const_iterator;
+
+  // UnorderedSet Member functions:
+  UnorderedSet();
+  explicit UnorderedSet(const allocator_type &alloc);
+  explicit UnorderedSet(size_type count, const hasher &hash = hasher(),
+                        const key_equal &equal = key_equal(),
+                        const allocator_type &alloc = allocator_type());
+  UnorderedSet(std::initializer_list<value_type> const &items);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  UnorderedSet(InputIt first, InputIt last);
+  UnorderedSet(const UnorderedSet &s);
+  UnorderedSet(UnorderedSet &&s) noexcept;
+  ~UnorderedSet();
+  UnorderedSet &operator=(const UnorderedSet &s);
+  UnorderedSet &operator=(UnorderedSet &&s) noexcept;
+  allocator_type get_allocator() const noexcept;
+  hasher hash_function() const;
+  key_equal key_eq() const;
+
+  // UnorderedSet Iterators:
+  iterator begin() const noexcept;
+  iterator end() const noexcept;
+
+  // UnorderedSet Capacity:
+  bool empty() const noexcept;
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  size_type capacity() const noexcept; // число ячеек таблицы
+  float load_factor() const noexcept;
+  void reserve(size_type count);
+  size_type memory_usage() const noexcept; // байты ячеек и управляющих байтов
+
+  // UnorderedSet Modifiers:
+  void clear() noexcept;
+  std::pair<iterator, bool> insert(const value_type &value);
+  std::pair<iterator, bool> insert(value_type &&value);
+  template <typename InputIt, typename = RequireInputIter<InputIt>>
+  void insert(InputIt first, InputIt last);
+  template <typename... Args>
+  std::vector<bool> insert_many(Args &&...args); // true - ключ вставлен
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  size_type erase(const key_type &key); // возвращает число удалённых
+  void swap(UnorderedSet &other) noexcept;
+  void merge(UnorderedSet &other);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+
+  // UnorderedSet Lookup:
+  bool contains(const key_type &key) const;
+  size_type count(const key_type &key) const;
+  iterator find(const key_type &key) const;
+  std::pair<iterator, iterator> equal_range(const key_type &key) const;
+
+  // UnorderedSet Heterogeneous lookup (only if Hash and KeyEqual are
+  // transparent):
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = RequireTransparentHash<H, E>>
+  bool contains(const K &key) const;
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = RequireTransparentHash<H, E>>
+  size_type count(const K &key) const;
+  template <typename K, typename H = Hash, typename E = KeyEqual,
+            typename = RequireTransparentHash<H, E>>
+  iterator find(const K &key) const;
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  template <typename K, typename H, typename E, typename A, typename Pred>
+  friend typename UnorderedSet<K, H, E, A>::size_type
+  erase_if(UnorderedSet<K, H, E, A> &set, Pred pred);
+
+  hash_table table_;
+};
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator,
+          typename Pred>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::size_type
+erase_if(UnorderedSet<Key, Hash, KeyEqual, Allocator> &set, Pred pred);
+
+} // namespace s21
+
+#include "s21_unordered_set.tpp"
+
+#endif // CPP2_S21_CONTAINERS_UNORDERED_SET_H_
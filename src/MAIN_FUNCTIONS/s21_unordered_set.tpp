@@ -0,0 +1,507 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file s21_unordered_set.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-03
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor. No memory is allocated until the first
+ * insertion.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::UnorderedSet() : table_() {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator used for the arrays of the UnorderedSet.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::UnorderedSet(
+    const allocator_type &alloc)
+    : table_(alloc) {}
+
+/**
+ * @brief Creates an empty set with room for count keys.
+ * @param count Number of keys that can be inserted without rebuilding.
+ * @param hash Hash function of keys.
+ * @param equal Equality of keys.
+ * @param alloc Allocator used for the arrays of the UnorderedSet.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::UnorderedSet(
+    size_type count, const hasher &hash, const key_equal &equal,
+    const allocator_type &alloc)
+    : table_(hash, equal, alloc) {
+  this->table_.reserve(count);
+}
+
+/**
+ * @brief Constructor with initializer list.
+ * @param items Initializer list of value_type.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::UnorderedSet(
+    std::initializer_list<value_type> const &items)
+    : UnorderedSet(items.begin(), items.end()) {}
+
+/**
+ * @brief Range constructor. Repeated keys are stored once.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+template <typename InputIt, typename>
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::UnorderedSet(InputIt first,
+                                                           InputIt last)
+    : table_() {
+  insert(first, last);
+}
+
+/**
+ * @brief Copy constructor.
+ * @param s UnorderedSet to copy.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::UnorderedSet(
+    const UnorderedSet &s)
+    : table_(s.table_) {}
+
+/**
+ * @brief Move constructor.
+ * @param s UnorderedSet to move.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::UnorderedSet(
+    UnorderedSet &&s) noexcept
+    : table_(std::move(s.table_)) {}
+
+/**
+ * @brief Destructor.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::~UnorderedSet() = default;
+
+/**
+ * @brief Copy assignment operator.
+ * @param s UnorderedSet to copy.
+ * @return Reference to this UnorderedSet.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+UnorderedSet<Key, Hash, KeyEqual, Allocator> &
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::operator=(
+    const UnorderedSet &s) {
+  this->table_ = s.table_;
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator.
+ * @param s UnorderedSet to move.
+ * @return Reference to this UnorderedSet.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+UnorderedSet<Key, Hash, KeyEqual, Allocator> &
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::operator=(
+    UnorderedSet &&s) noexcept {
+  this->table_ = std::move(s.table_);
+  return *this;
+}
+
+/**
+ * @brief Returns the allocator associated with the UnorderedSet.
+ * @return Copy of the allocator.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::allocator_type
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::get_allocator() const noexcept {
+  return this->table_.get_allocator();
+}
+
+/**
+ * @brief Returns the hash function of keys.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::hasher
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::hash_function() const {
+  return this->table_.hash_function();
+}
+
+/**
+ * @brief Returns the equality of keys.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::key_equal
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::key_eq() const {
+  return this->table_.key_eq();
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+// UnorderedSet Iterators
+/**
+ * @brief Returns an iterator to the first key (in slot order).
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::iterator
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::begin() const noexcept {
+  return this->table_.begin();
+}
+
+/**
+ * @brief Returns an iterator to the end.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::iterator
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::end() const noexcept {
+  return this->table_.end();
+}
+
+// UnorderedSet Capacity
+/**
+ * @brief Checks whether the container is empty.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+bool UnorderedSet<Key, Hash, KeyEqual, Allocator>::empty() const noexcept {
+  return this->table_.empty();
+}
+
+/**
+ * @brief Returns the number of keys.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::size_type
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::size() const noexcept {
+  return this->table_.size();
+}
+
+/**
+ * @brief Returns the maximum possible number of keys.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::size_type
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::max_size() const noexcept {
+  return this->table_.max_size();
+}
+
+/**
+ * @brief Returns the number of slots of the table; at most 7/8 of them are
+ * used before the table grows.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::size_type
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::capacity() const noexcept {
+  return this->table_.capacity();
+}
+
+/**
+ * @brief Returns the number of keys divided by the number of slots.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+float UnorderedSet<Key, Hash, KeyEqual, Allocator>::load_factor()
+    const noexcept {
+  return this->table_.loadFactor();
+}
+
+/**
+ * @brief Makes room for count keys, so that inserting up to count keys does
+ * not rebuild the table.
+ * @param count Number of keys.
+ * @throws std::length_error if count exceeds max_size().
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+void UnorderedSet<Key, Hash, KeyEqual, Allocator>::reserve(size_type count) {
+  this->table_.reserve(count);
+}
+
+/**
+ * @brief Returns the number of bytes of the slot and control arrays.
+ *
+ * Counts all slots, including the free ones; allocator overhead is not
+ * included.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::size_type
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::memory_usage() const noexcept {
+  return this->table_.memoryUsage();
+}
+
+// UnorderedSet Modifiers
+/**
+ * @brief Clears the contents; the slots stay allocated.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+void UnorderedSet<Key, Hash, KeyEqual, Allocator>::clear() noexcept {
+  this->table_.clear();
+}
+
+/**
+ * @brief Inserts a key if it is absent.
+ * @param value Key to insert.
+ * @return Pair consisting of an iterator to the inserted key (or to the key
+ * that prevented the insertion) and a bool denoting whether the insertion
+ * took place.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+std::pair<typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::insert(const value_type &value) {
+  return this->table_.insert(value);
+}
+
+/**
+ * @brief Inserts a key if it is absent, moving it into the table.
+ * @param value Key to insert.
+ * @return Same as insert(const value_type &).
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+std::pair<typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::insert(value_type &&value) {
+  return this->table_.insert(std::move(value));
+}
+
+/**
+ * @brief Inserts the keys of [first, last) that are absent.
+ *
+ * For forward ranges the table is grown once for the whole range.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+template <typename InputIt, typename>
+void UnorderedSet<Key, Hash, KeyEqual, Allocator>::insert(InputIt first,
+                                                          InputIt last) {
+  using category = typename std::iterator_traits<InputIt>::iterator_category;
+  if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+    this->table_.reserve(size() +
+                         static_cast<size_type>(std::distance(first, last)));
+  }
+  for (; first != last; ++first) {
+    this->table_.insert(*first);
+  }
+}
+
+/**
+ * @brief Inserts multiple keys.
+ *
+ * Each insertion may invalidate the iterators returned by the previous
+ * ones, so only the results are reported.
+ * @param args The keys to insert.
+ * @return For each key, whether it was inserted.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+template <typename... Args>
+std::vector<bool>
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::insert_many(Args &&...args) {
+  std::vector<bool> results;
+  results.reserve(sizeof...(args));
+  this->table_.reserve(size() + sizeof...(args));
+  (results.push_back(insert(std::forward<Args>(args)).second), ...);
+  return results;
+}
+
+/**
+ * @brief Erases a key; the other keys stay in place.
+ * @param pos Iterator to the key to erase.
+ * @return Iterator to the next key in slot order.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::iterator
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::erase(const_iterator pos) {
+  return this->table_.erase(pos);
+}
+
+/**
+ * @brief Erases the keys in [first, last).
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @return Iterator last.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::iterator
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::erase(const_iterator first,
+                                                    const_iterator last) {
+  return this->table_.erase(first, last);
+}
+
+/**
+ * @brief Erases the key.
+ * @param key Key to erase.
+ * @return Number of erased keys (0 or 1).
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::size_type
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::erase(const key_type &key) {
+  return this->table_.eraseKey(key);
+}
+
+/**
+ * @brief Swaps the contents.
+ * @param other UnorderedSet to swap with.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+void UnorderedSet<Key, Hash, KeyEqual, Allocator>::swap(
+    UnorderedSet &other) noexcept {
+  this->table_.swap(other.table_);
+}
+
+/**
+ * @brief Moves the keys of other that are absent here into this set.
+ *
+ * Keys that are already present stay in other.
+ * @param other UnorderedSet to merge from.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+void UnorderedSet<Key, Hash, KeyEqual, Allocator>::merge(UnorderedSet &other) {
+  if (this == &other) {
+    return;
+  }
+  for (auto it = other.table_.begin(); it != other.table_.end();) {
+    if (this->table_.insert(std::move(*it)).second) {
+      it = other.table_.erase(it);
+    } else {
+      ++it; // ключ не перемещён: insert не трогает его при совпадении
+    }
+  }
+}
+
+/**
+ * @brief Builds a key from args and inserts it if it is absent.
+ * @param args Arguments of the key constructor.
+ * @return Same as insert(const value_type &).
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+template <typename... Args>
+std::pair<typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::iterator,
+          bool>
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::emplace(Args &&...args) {
+  return this->table_.emplace(std::forward<Args>(args)...);
+}
+
+// UnorderedSet Lookup
+/**
+ * @brief Checks if the container contains the key.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+bool UnorderedSet<Key, Hash, KeyEqual, Allocator>::contains(
+    const key_type &key) const {
+  return this->table_.find(key) != this->table_.end();
+}
+
+/**
+ * @brief Returns the number of keys equal to key (0 or 1).
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::size_type
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::count(
+    const key_type &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Finds the key.
+ * @param key Key to search for.
+ * @return Iterator to the key, or end() if it is absent.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::iterator
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::find(const key_type &key) const {
+  return this->table_.find(key);
+}
+
+/**
+ * @brief Returns the range of keys equal to key.
+ * @param key Key to search for.
+ * @return Pair of iterators: the key and the one after it, or two end()
+ * iterators if the key is absent.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+std::pair<typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::iterator,
+          typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::iterator>
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::equal_range(
+    const key_type &key) const {
+  iterator it = find(key);
+  return {it, it == end() ? it : std::next(it)};
+}
+
+// UnorderedSet Heterogeneous lookup
+/**
+ * @brief Checks if the container contains a key equal to key of another
+ * type; the key is not converted to key_type.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+template <typename K, typename H, typename E, typename>
+bool UnorderedSet<Key, Hash, KeyEqual, Allocator>::contains(
+    const K &key) const {
+  return this->table_.find(key) != this->table_.end();
+}
+
+/**
+ * @brief Returns the number of keys equal to key of another type (0 or 1).
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+template <typename K, typename H, typename E, typename>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::size_type
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::count(const K &key) const {
+  return contains(key) ? 1 : 0;
+}
+
+/**
+ * @brief Finds the key equal to key of another type.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+template <typename K, typename H, typename E, typename>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::iterator
+UnorderedSet<Key, Hash, KeyEqual, Allocator>::find(const K &key) const {
+  return this->table_.find(key);
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks the structure of the hash table (see
+ * HashTable::checkInvariants).
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+bool UnorderedSet<Key, Hash, KeyEqual, Allocator>::checkInvariants() const {
+  return this->table_.checkInvariants();
+}
+
+/******************************************************************************
+ * NON-MEMBER FUNCTIONS
+ ******************************************************************************/
+
+/**
+ * @brief Erases all keys that satisfy pred.
+ *
+ * @param set The container to erase from.
+ * @param pred Predicate called once for every key in slot order.
+ * @return size_type Number of erased keys.
+ */
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator,
+          typename Pred>
+typename UnorderedSet<Key, Hash, KeyEqual, Allocator>::size_type
+erase_if(UnorderedSet<Key, Hash, KeyEqual, Allocator> &set, Pred pred) {
+  return set.table_.eraseIf(pred);
+}
+
+} // namespace s21
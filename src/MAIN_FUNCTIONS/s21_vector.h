@@ -20,12 +20,13 @@
 
 
 #include "../s21_common.h" // на случай, если будем собирать только этот контейнер или его наследник без остальных
-#include <memory> // нужно для умных указателей
+#include <memory> // нужно для std::allocator и std::allocator_traits
+#include "../SUPPORT_FUNCTIONS/snapshot.h" // двоичные снимки save / load
 
 
 namespace s21 {
 
-template <typename T> // любой тип входных данных
+template <typename T, typename Allocator = std::allocator<T>> // любой тип входных данных и его аллокатор
 class vector{
 
 public:
@@ -39,24 +40,33 @@ public:
     using iterator = value_type*;              // defines the type for iterating through the container
     using const_iterator = const value_type*;  // defines the constant type for iterating through the container
     using size_type	= size_t;                  // defines the type of the container size (standard type is size_t)
+    using allocator_type = Allocator;          // defines the type of the allocator used for the storage
 
     //В этой таблице перечислены основные публичные методы для взаимодействия с классом:
     vector() = default;                                      //default constructor, creates empty vector
-    vector(size_type n);                                     //parameterized constructor, creates the vector of size n
-    vector(std::initializer_list<value_type> const &items);  //initializer list constructor
+    explicit vector(const allocator_type &alloc) noexcept;   //creates empty vector with the given allocator
+    vector(size_type n, const allocator_type &alloc = allocator_type());  //parameterized constructor, creates the vector of size n
+    vector(std::initializer_list<value_type> const &items,
+           const allocator_type &alloc = allocator_type());  //initializer list constructor
 
     // Шаблонный конструктор для незаданного в <> типа , например s21::vector num{1,2,3};
     template <typename NoTypeIn>
-    vector(NoTypeIn first, NoTypeIn last);
+    vector(NoTypeIn first, NoTypeIn last, const allocator_type &alloc = allocator_type());
 
     vector(const vector &v);       //copy constructor
     vector(vector &&v) noexcept;   //move constructor
 
-    // ~vector() noexcept;  //destructor для случая обычного указателя
-    ~vector() = default;    // при использовании умных указателей они очищаются самостоятельно
+    ~vector() noexcept;  //destructor, возвращает память аллокатору
+
+    allocator_type get_allocator() const noexcept;  //returns the associated allocator
 
     vector& operator=(const vector &v);      // оператор присвоения копированием
-    vector& operator=(vector &&v) noexcept;  //assignment operator overload for moving object
+    // перемещение не бросает, если память можно просто забрать
+    static constexpr bool kNothrowMoveAssign =
+        std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+        std::allocator_traits<Allocator>::is_always_equal::value;
+
+    vector& operator=(vector &&v) noexcept(kNothrowMoveAssign);  //assignment operator overload for moving object
 
     // В этой таблице перечислены публичные методы для доступа к элементам класса:
     reference at(size_type pos);          //access specified element with bounds checking
@@ -66,24 +76,30 @@ public:
     const_reference front();    //access the first element
     const_reference back();     //access the last element
     iterator data();            //direct access to the underlying arrayVector Iterators
+    const_iterator data() const;  //константный доступ к массиву (нужен FlatSet / FlatMap)
 
     // В этой таблице перечислены публичные методы для итерирования по элементам класса (доступ к итераторам):
     iterator begin();   //returns an iterator to the beginning
     iterator end();     //returns an iterator to the end
+    const_iterator begin() const;  //returns a constant iterator to the beginning
+    const_iterator end() const;    //returns a constant iterator to the end
 
     // В этой таблице перечислены публичные методы для доступа к информации о наполнении контейнера:
-    bool empty();                         //checks whether the container is empty
-    size_type size();                     //returns the number of elements
+    bool empty() const;                   //checks whether the container is empty
+    size_type size() const;               //returns the number of elements
     size_type max_size() const noexcept;  //returns the maximum possible number of elements
     void reserve(size_type size);         //allocate storage of size elements and copies current array elements to a newly allocated array
-    size_type capacity();                 //returns the number of elements that can be held in currently allocated storage
+    size_type capacity() const;           //returns the number of elements that can be held in currently allocated storage
     void shrink_to_fit();                 //reduces memory usage by freeing unused memory
 
     // В этой таблице перечислены публичные методы для изменения контейнера:
     void clear();                                           //clears the contents
     iterator insert(iterator pos, const_reference value);	//inserts elements into concrete pos and returns the iterator that points to the new element НЕТ В СТАНДАРТНОМ ВЕКТОРЕ
+    iterator insert(iterator pos, value_type &&value);     //то же, но элемент перемещается, а не копируется
     void erase(iterator pos);                               //erases element at pos НЕТ В СТАНДАРТНОМ ВЕКТОРЕ
+    iterator erase(iterator first, iterator last);          //erases elements in [first, last), returns first
     void push_back(const_reference value);                  //adds an element to the end
+    void push_back(value_type &&value);                     //adds an element to the end by moving it
     void pop_back();                                        //removes the last element
     void swap(vector& other);                               //swaps the contents
 
@@ -93,11 +109,22 @@ public:
     template <typename... Args>
     void insert_many_back(Args &&...args);  // Appends new elements to the end of the container.
 
+    // Двоичные снимки (формат описан в SUPPORT_FUNCTIONS/snapshot.h):
+    void save(int fd) const;  //writes the elements to the file descriptor, trivially copyable ones as one block
+    void load(int fd);        //replaces the contents with a snapshot read from the file descriptor
+
 private:
+    using alloc_traits = std::allocator_traits<allocator_type>;
+
+    iterator openGap(iterator pos);            // сдвигает хвост с pos на +1 (при нехватке места удваивает память), возвращает новый pos
+
+    value_type* allocateStorage(size_type n);  // выделяет память под n элементов и создаёт их (value-initialized)
+    void deallocateStorage() noexcept;         // разрушает все capacity_ элементов и возвращает память аллокатору
+
+    allocator_type alloc_ = allocator_type();      // аллокатор, из которого берётся память под элементы
     size_type size_ = 0;                           // размер вектора
     size_type capacity_ = 0;                       // ёмкость вектора
-    // value_type* data_ = nullptr;                   // обычный опасный указатель на массив элементов
-    std::unique_ptr<value_type[]> data_ = nullptr; // умный указатель на массив (не нужно писать деструктор. Очищается сам)
+    value_type* data_ = nullptr;                   // указатель на массив из capacity_ созданных элементов
 
 
 
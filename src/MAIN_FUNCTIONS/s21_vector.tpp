@@ -32,48 +32,64 @@ namespace s21 {
 // template<typename value_type>
 // vector<value_type>::vector() : size_(0), capacity_(0), data_(nullptr) {} // конструктор по умолчанию оказался не нужен
 
-template<typename value_type>
-vector<value_type>::vector(size_type n)
-                  : size_(n),
+template <typename value_type, typename Allocator>
+vector<value_type, Allocator>::vector(const allocator_type &alloc) noexcept
+                  : alloc_(alloc)
+                    {}	//allocator constructor, creates empty vector
+
+template <typename value_type, typename Allocator>
+vector<value_type, Allocator>::vector(size_type n, const allocator_type &alloc)
+                  : alloc_(alloc),
+                    size_(n),
                     capacity_(size_),
                     data_(
-                        std::make_unique<value_type[]>(capacity_) // вызывается метод для объекта умного указателя, выделяющий память
-                        // new value_type[capacity_] // для использования с обычными опасными указателями
+                        allocateStorage(capacity_) // память берётся у аллокатора, все элементы создаются сразу
                     )
                     {}	//parameterized constructor
 
 
-template<typename value_type>
-vector<value_type>::vector(std::initializer_list<value_type> const &items)
-                    : vector(items.begin(), items.begin() + items.size())
+template <typename value_type, typename Allocator>
+vector<value_type, Allocator>::vector(std::initializer_list<value_type> const &items,
+                                      const allocator_type &alloc)
+                    : vector(items.begin(), items.begin() + items.size(), alloc)
                     {}	//initializer list constructor
 
-template <typename value_type>
+template <typename value_type, typename Allocator>
 template <typename NoTypeIn>
-vector<value_type>::vector(NoTypeIn first, NoTypeIn last)
-                    : vector(last - first) // сначала вызывает параметризированный конструктор в котором создается объект
+vector<value_type, Allocator>::vector(NoTypeIn first, NoTypeIn last, const allocator_type &alloc)
+                    : vector(last - first, alloc) // сначала вызывает параметризированный конструктор в котором создается объект
                     {
-                    copy(first, last, data_.get()); //потом копирует данные в область памяти объекта
+                    copy(first, last, data_); //потом копирует данные в область памяти объекта
                     } // универсальный конструктор копирования области данных с first по last
 
 
-template<typename value_type>
-vector<value_type>::vector(const vector &v)
-                    : vector(v.data_.get(), v.data_.get() + v.size_)
+template <typename value_type, typename Allocator>
+vector<value_type, Allocator>::vector(const vector &v)
+                    : vector(v.data_, v.data_ + v.size_,
+                             alloc_traits::select_on_container_copy_construction(v.alloc_))
                     {}	//copy constructor
 
-template<typename value_type>
-vector<value_type>::vector(vector &&v) noexcept
-                    : size_(exchange(v.size_, 0)),
-                    capacity_(exchange(v.capacity_, 0)),
-                    data_(exchange(v.data_, nullptr))
+template <typename value_type, typename Allocator>
+vector<value_type, Allocator>::vector(vector &&v) noexcept
+                    : alloc_(std::move(v.alloc_)),
+                    size_(std::exchange(v.size_, 0)),
+                    capacity_(std::exchange(v.capacity_, 0)),
+                    data_(std::exchange(v.data_, nullptr))
                     {}	//move constructor
 
 
 
 
-// template<typename value_type>
-// vector<value_type>::~vector() noexcept { if (data_) delete[] data_; } // для случая обычного указателя
+template <typename value_type, typename Allocator>
+vector<value_type, Allocator>::~vector() noexcept {
+    deallocateStorage();
+}	//destructor
+
+// возвращает копию аллокатора вектора
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::get_allocator() const noexcept -> allocator_type {
+    return alloc_;
+}
 
 
 /******************************************************
@@ -82,27 +98,46 @@ vector<value_type>::vector(vector &&v) noexcept
  *                                                    *
  ******************************************************/
 
-template<typename value_type>
-auto vector<value_type>::operator=(const vector &v) -> vector& {
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::operator=(const vector &v) -> vector& {
     if (this != &v) {
-        vector Temp(v);  // создаем временную копию
-        this->swap(Temp);
+        // аллокатор копируется вместе с данными, только если он это разрешает
+        vector Temp(v.data_, v.data_ + v.size_,
+                    alloc_traits::propagate_on_container_copy_assignment::value ? v.alloc_ : alloc_);
+        std::swap(size_, Temp.size_);
+        std::swap(capacity_, Temp.capacity_);
+        std::swap(data_, Temp.data_);
+        std::swap(alloc_, Temp.alloc_);
     }
     return *this;
 }  // copy assignment operator
 
-template<typename value_type>
-auto vector<value_type>::operator=(vector &&v) noexcept -> vector& {
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::operator=(vector &&v) noexcept(kNothrowMoveAssign) -> vector& {
     if (this != &v) {
-        this->swap(v);
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+            std::swap(alloc_, v.alloc_);
+        } else if constexpr (!alloc_traits::is_always_equal::value) {
+            if (alloc_ != v.alloc_) {
+                // чужую память забрать нельзя - перемещаем элементы в память своего аллокатора
+                vector Temp(std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()), alloc_);
+                std::swap(size_, Temp.size_);
+                std::swap(capacity_, Temp.capacity_);
+                std::swap(data_, Temp.data_);
+                return *this;
+            }
+        }
+        std::swap(size_, v.size_);
+        std::swap(capacity_, v.capacity_);
+        std::swap(data_, v.data_);
     }
     return *this;
 }  // move assignment operator
 
 
 // квадратные скобки с позицией pos элемента возвращают значение без проверки выхода pos за пределы
-template <typename value_type>
-auto vector<value_type>::operator[](size_type pos) -> reference {
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::operator[](size_type pos) -> reference {
     return data_[pos]; // неконтролируемый доступ к памяти, возможен выход за пределы и как следствие падение программы
 }
 
@@ -115,76 +150,110 @@ auto vector<value_type>::operator[](size_type pos) -> reference {
 
 
 // возвращает текущее значение элемента по позиции pos с проверкой pos на выход за пределы области памяти
-template <typename value_type>
-auto vector<value_type>::at(size_type pos) -> reference {
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::at(size_type pos) -> reference {
     return (pos > size_-1)
            ? (throw std::out_of_range("at(): выход за пределы элементов объекта\n"))
            : data_[pos];
 }
 
 // возвращает количество элементов, находящееся сейчас в векторе
-template <typename value_type>
-auto vector<value_type>::size() -> size_type {
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::size() const -> size_type {
     return size_;
 }
 
 // возвращает ёмкость - количество элементов, которые могут быть записаны в вектор без дополнительного выделения памяти
-template <typename value_type>
-auto vector<value_type>::capacity() -> size_type {
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::capacity() const -> size_type {
     return capacity_;
 }
 
 // возвращает значение нулевого(изначального) элемента вектора
-template <typename value_type>
-auto vector<value_type>::front() -> const_reference {
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::front() -> const_reference {
     return !empty() ? data_[0] : throw std::out_of_range("front(): объект пустой, невозможно прочитать первый элемент\n");
 }
 
 // возвращает значение последнего элемента вектора
-template <typename value_type>
-auto vector<value_type>::back() -> const_reference {
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::back() -> const_reference {
     return at(size_-1);
 }
 
 // возвращает указатель на начало области данных вектора
-template <typename value_type>
-auto vector<value_type>::data() -> iterator {
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::data() -> iterator {
+    return begin();
+}
+
+// константный указатель на начало области данных вектора
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::data() const -> const_iterator {
     return begin();
 }
 
 // возвращает, выделена ли память под вектор
-template <typename value_type>
-bool vector<value_type>::empty() {
+template <typename value_type, typename Allocator>
+bool vector<value_type, Allocator>::empty() const {
     return size_ == 0;
 }
 
 // очищает вектор (на самом деле просто делает невидимыми элементы, но память при этом остаётся)
-template <typename value_type>
-void vector<value_type>::clear() {
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::clear() {
     size_ = 0;
 }
 
 // удаляет последний элемент
-template <typename value_type>
-void vector<value_type>::pop_back() {
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::pop_back() {
     if (!empty()) --size_;
 }
 
 // возвращает указатель на первый элемент
-template <typename value_type>
-auto vector<value_type>::begin() -> iterator {
-    return data_.get();
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::begin() -> iterator {
+    return data_;
 }
 
 // возвращает указатель на последний элемент + 1
-template <typename value_type>
-auto vector<value_type>::end() -> iterator {
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::end() -> iterator {
+    return begin() + size_;
+}
+
+// константные варианты begin() и end() для константного вектора
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::begin() const -> const_iterator {
+    return data_;
+}
+
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::end() const -> const_iterator {
     return begin() + size_;
 }
 
 // вставляет новый элемент на позицию pos, при необходимости выделяется удвоенная память
-template <typename value_type>
-auto vector<value_type>::insert(iterator pos, const_reference value) -> iterator {
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::insert(iterator pos, const_reference value) -> iterator {
+    pos = openGap(pos);
+    *pos = value;
+    return pos;
+}
+
+// вставляет новый элемент на позицию pos перемещением (без копии строки, вектора и т. п.)
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::insert(iterator pos, value_type &&value) -> iterator {
+    pos = openGap(pos);
+    *pos = std::move(value);
+    return pos;
+}
+
+// освобождает ячейку на позиции pos: элементы правее сдвигаются на +1,
+// при необходимости выделяется удвоенная память; возвращает новый адрес pos
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::openGap(iterator pos) -> iterator {
     if (pos < begin() || pos > end()) {
         throw std::out_of_range("insert(): выход за границы элементов объекта\n");
     }
@@ -207,52 +276,72 @@ auto vector<value_type>::insert(iterator pos, const_reference value) -> iterator
 
         ++size_;
 
-        *pos = value;
-
     return pos;
 }
 
 
 
 // удаление элемента в позиции pos со смещением тех что правее от него на -1 позицию влево
-template <typename value_type>
-void vector<value_type>::erase(iterator pos) {
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::erase(iterator pos) {
     if(pos < end() && pos >=begin()) {
         std::move(pos+1, end(), pos);
         pop_back();
       } else std::cerr << "erase(): выход за границы элементов объекта\n";
 }
 
+// удаление элементов [first, last) одним сдвигом хвоста влево; возвращает first
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::erase(iterator first, iterator last) -> iterator {
+    if (first < begin() || last > end() || first > last) {
+        throw std::out_of_range("erase(): выход за границы элементов объекта\n");
+    }
+    if (first == last) {
+        return first; // сдвиг на месте опустошил бы, например, строки хвоста
+    }
+    iterator new_end = std::move(last, end(), first);
+    // освободившиеся ячейки сбрасываем, чтобы удалённые элементы отдали ресурсы
+    for (iterator it = new_end; it != end(); ++it) {
+        *it = value_type();
+    }
+    size_ -= static_cast<size_type>(last - first);
+    return first;
+}
+
 // обмен объектов данными, когда данные первого становятся данными второго и наоборот
-template <typename value_type>
-void vector<value_type>::swap(vector& other) {
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::swap(vector& other) {
 
     if (this != &other) {
         std::swap(other.size_, size_);
         std::swap(other.capacity_, capacity_);
         std::swap(other.data_, data_);
+        if constexpr (alloc_traits::propagate_on_container_swap::value) {
+            std::swap(other.alloc_, alloc_);
+        }
     }
 }
 
 // подрезание незаполненной памяти до последнего элемента, чтобы size = capacity
 // на самом деле выделяется новая область памяти, куда перемещаются элементы
-template <typename value_type>
-void vector<value_type>::shrink_to_fit() {
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::shrink_to_fit() {
         if (   size_ > 0
             &&
                size_ < capacity_
            ) {
-                capacity_ = size_ - 1; // временно делаем capacity_ < size_ , иначе reserve не сработает
-                reserve(size_);
+                vector Temp(size_, alloc_); // новая память ровно под size_ элементов
+                std::move(begin(), end(), Temp.begin());
+                *this = std::move(Temp); // capacity_ не трогаем: аллокатору нужен точный размер старого блока
              } else std::cerr << "shrink_to_fit(): оптимизировать нечего\n";
 }
 
 // выделяется новая область памяти большего чем сейчас размера, куда перемещаются элементы
-template <typename value_type>
-void vector<value_type>::reserve(size_type size) {
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::reserve(size_type size) {
     if (size > capacity_) {
 
-        vector Temp(size); // Создаем временный вектор с новой емкостью size
+        vector Temp(size, alloc_); // Создаем временный вектор с новой емкостью size тем же аллокатором
         std::move(begin(), end(), Temp.begin()); // перемещаем данные data_ в Temp.data_
 
         // Перемещаем временный вектор в текущий с использованием оператора перемещения
@@ -263,22 +352,59 @@ void vector<value_type>::reserve(size_type size) {
 
 
 // добавляется новый элемент в конец. При необходимости выделяется новая удвоенная память, куда копируются все элементы
-template <typename value_type>
-void vector<value_type>::push_back(const_reference value) {
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::push_back(const_reference value) {
     insert(end(), value);
 }
 
+// добавляется новый элемент в конец перемещением
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::push_back(value_type &&value) {
+    insert(end(), std::move(value));
+}
+
+// выделяет у аллокатора память под n элементов и создаёт в ней все n элементов
+// (как new value_type[n]()); если конструктор бросит исключение, уже созданные
+// элементы разрушаются, а память возвращается аллокатору
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::allocateStorage(size_type n) -> value_type* {
+    if (n == 0) return nullptr;
+
+    value_type* storage = alloc_traits::allocate(alloc_, n);
+    size_type constructed = 0;
+    try {
+        for (; constructed < n; ++constructed) {
+            alloc_traits::construct(alloc_, storage + constructed);
+        }
+    } catch (...) {
+        while (constructed > 0) alloc_traits::destroy(alloc_, storage + --constructed);
+        alloc_traits::deallocate(alloc_, storage, n);
+        throw;
+    }
+    return storage;
+}
+
+// разрушает все capacity_ элементов и возвращает память аллокатору
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::deallocateStorage() noexcept {
+    if (data_) {
+        for (size_type i = 0; i < capacity_; ++i) alloc_traits::destroy(alloc_, data_ + i);
+        alloc_traits::deallocate(alloc_, data_, capacity_);
+        data_ = nullptr;
+    }
+}
+
 // возвращает максимальное теоретическое количество элементов, которые могут быть записаны в вектор для этого типа данных
-template <typename value_type>
-auto vector<value_type>::max_size() const noexcept -> size_type {
+template <typename value_type, typename Allocator>
+auto vector<value_type, Allocator>::max_size() const noexcept -> size_type {
         return static_cast<size_type>(-1) / sizeof(value_type);
 }
 
 
-                                            template <typename value_type>
+                                            template <typename value_type, typename Allocator>
                                             template <typename... Args>
-vector<typename vector<value_type>::iterator>
-                                            vector<value_type>::
+vector<typename vector<value_type, Allocator>::iterator>
+                                            vector<value_type, Allocator>::
             insert_many(iterator pos, Args &&...args) {
 
                 vector<iterator> results(sizeof...(args)); // создаём вектор для вставки адресов на все новые элементы
@@ -304,14 +430,50 @@ vector<typename vector<value_type>::iterator>
 }                            // на адреса вставленных элементов
 
 
-                                            template <typename value_type>
+                                            template <typename value_type, typename Allocator>
                                             template <typename... Args>
 void
-     vector<value_type>::insert_many_back(Args &&...args) {
+     vector<value_type, Allocator>::insert_many_back(Args &&...args) {
         insert_many(end(), args...);
 }
 
 
+
+/******************************************************
+ *                                                    *
+ *                      СНИМКИ                        *
+ *                                                    *
+ ******************************************************/
+
+
+// запись снимка в файловый дескриптор: заголовок и элементы;
+// тривиально копируемые элементы уходят одним вызовом write прямо из data_
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::save(int fd) const {
+    saveSnapshotBlock<value_type>(fd, SnapshotKind::kVector, data_, size_);
+}
+
+// чтение снимка: элементы читаются прямо в память нового вектора
+// (тривиально копируемые - одним вызовом read), при ошибке исключение,
+// а текущее содержимое не меняется; память сверх reserveCount() растёт
+// вдвое по мере прихода данных, а не по числу из заголовка
+template <typename value_type, typename Allocator>
+void vector<value_type, Allocator>::load(int fd) {
+    SnapshotReader reader = openSnapshot<value_type>(fd, SnapshotKind::kVector);
+    vector Temp(alloc_);
+    size_type count = reader.count();
+    while (Temp.size_ < count) {
+        size_type step = std::max(Temp.size_, reader.reserveCount());
+        step = std::min(std::max<size_type>(step, 1), count - Temp.size_);
+        Temp.reserve(Temp.size_ + step);
+        readSnapshotElements(reader, Temp.data_ + Temp.size_, step);
+        Temp.size_ += step;
+    }
+    reader.finish();
+    swap(Temp);
+}
+
+
 } // namespace s21
 
 
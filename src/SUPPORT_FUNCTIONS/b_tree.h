@@ -0,0 +1,308 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file b_tree.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-07-21
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_B_TREE_H_
+#define CPP2_S21_CONTAINERS_B_TREE_H_
+
+#include <cstddef>
+#include <cstring> // std::memcpy для загрузки ключей в SIMD-регистр
+#include <functional> // std::less, std::greater
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory> // std::allocator_traits
+#include <new>
+#include <stdexcept> // std::out_of_range
+#include <type_traits>
+#include <utility> // std::pair
+
+#include "../s21_common.h" // RequireInputIter, Identity, SelectFirst
+
+// Размер узла B-дерева в байтах: 256 байт - четыре кэш-линии по 64 байта,
+// число ключей в узле выводится из него и из размера элемента
+#ifndef S21_BTREE_NODE_BYTES
+#define S21_BTREE_NODE_BYTES 256
+#endif
+
+namespace s21 {
+
+template <typename Tree, bool IsConst> class BTreeIterator;
+
+/**
+ * @brief Ordered B+ tree: the storage behind BTreeSet, BTreeMultiSet and
+ * BTreeMap.
+ *
+ * Elements are kept sorted in leaves of S21_BTREE_NODE_BYTES bytes, which
+ * are linked into a list for in-order scans. Inner nodes hold only copies of
+ * keys (separators) and child pointers, so a lookup touches one small node
+ * per level instead of one heap node per key. For arithmetic keys compared
+ * with std::less or std::greater the position inside a node is found by a
+ * SIMD comparison of the whole key array (see nodeSearch()).
+ *
+ * Separator i of an inner node satisfies: every key in child i is not
+ * greater than it and every key in child i + 1 is not less than it.
+ * Separators are not updated when elements are erased, they only have to
+ * keep this order.
+ *
+ * Elements move between slots and nodes when the tree changes, so every
+ * insertion and erasure invalidates all iterators. Moving an element must
+ * not throw, and an element of the tree must not be passed to its own
+ * insertion methods.
+ *
+ * @tparam Key Type of the keys.
+ * @tparam Value Type of the stored elements.
+ * @tparam KeyOfValue Function object returning the key of an element.
+ * @tparam Comparator Strict weak ordering of keys.
+ * @tparam Allocator Allocator of elements, rebound to the node types.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+class BTree {
+public:
+  using key_type = Key;
+  using value_type = Value;
+  using reference = Value &;
+  using const_reference = const Value &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
+  using iterator = BTreeIterator<BTree, false>;
+  using const_iterator = BTreeIterator<BTree, true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  struct Inner;
+
+  // общая часть листа и внутреннего узла
+  struct NodeBase {
+    Inner *parent_ = nullptr;
+    unsigned short position_ = 0; // номер в массиве детей родителя
+    unsigned short count_ = 0;    // элементов в листе, ключей во внутреннем
+    bool leaf_;
+
+    explicit NodeBase(bool leaf) noexcept : leaf_(leaf) {}
+  };
+
+  static constexpr size_type kNodeBytes = S21_BTREE_NODE_BYTES;
+  static constexpr size_type kLeafHeader =
+      sizeof(NodeBase) + 2 * sizeof(void *);
+  static constexpr size_type kInnerHeader = sizeof(NodeBase) + sizeof(void *);
+  // не меньше трёх элементов в узле, даже если элемент больше узла
+  static constexpr size_type kLeafSlots =
+      kNodeBytes > kLeafHeader + 3 * sizeof(Value)
+          ? (kNodeBytes - kLeafHeader) / sizeof(Value)
+          : 3;
+  static constexpr size_type kInnerSlots =
+      kNodeBytes > kInnerHeader + 3 * (sizeof(Key) + sizeof(void *))
+          ? (kNodeBytes - kInnerHeader) / (sizeof(Key) + sizeof(void *))
+          : 3;
+  static constexpr size_type kMinLeaf = kLeafSlots / 2;
+  static constexpr size_type kMinInner = kInnerSlots / 2;
+
+  static_assert(kLeafSlots <= std::numeric_limits<unsigned short>::max() &&
+                    kInnerSlots < std::numeric_limits<unsigned short>::max(),
+                "S21_BTREE_NODE_BYTES is too large");
+
+  struct Leaf : NodeBase {
+    Leaf *prev_ = nullptr;
+    Leaf *next_ = nullptr;
+    alignas(Value) unsigned char storage_[kLeafSlots * sizeof(Value)];
+
+    Leaf() noexcept : NodeBase(true) {}
+    Value *values() noexcept { return reinterpret_cast<Value *>(storage_); }
+    const Value *values() const noexcept {
+      return reinterpret_cast<const Value *>(storage_);
+    }
+  };
+
+  struct Inner : NodeBase {
+    alignas(Key) unsigned char storage_[kInnerSlots * sizeof(Key)];
+    NodeBase *children_[kInnerSlots + 1];
+
+    Inner() noexcept : NodeBase(false) {}
+    Key *keys() noexcept { return reinterpret_cast<Key *>(storage_); }
+    const Key *keys() const noexcept {
+      return reinterpret_cast<const Key *>(storage_);
+    }
+  };
+
+  BTree();
+  explicit BTree(const allocator_type &alloc);
+  BTree(const BTree &other);
+  BTree(BTree &&other) noexcept;
+  ~BTree();
+  BTree &operator=(const BTree &other);
+  BTree &operator=(BTree &&other) noexcept;
+
+  allocator_type get_allocator() const noexcept;
+
+  // Main methods:
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  bool empty() const noexcept;
+  size_type height() const noexcept;
+  size_type memoryUsage() const noexcept;
+  void clear() noexcept;
+  void swap(BTree &other) noexcept;
+
+  iterator begin() noexcept;
+  iterator end() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+
+  // Lookup:
+  template <typename K> iterator find(const K &key);
+  template <typename K> const_iterator find(const K &key) const;
+  template <typename K> iterator lower_bound(const K &key);
+  template <typename K> const_iterator lower_bound(const K &key) const;
+  template <typename K> iterator upper_bound(const K &key);
+  template <typename K> const_iterator upper_bound(const K &key) const;
+  template <typename K> size_type count(const K &key) const;
+
+  // Modifiers:
+  template <typename Arg>
+  std::pair<iterator, bool> insert(Arg &&value, bool unique);
+  template <typename Arg>
+  iterator insertHint(const_iterator hint, Arg &&value, bool unique);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(bool unique, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> tryEmplace(const Key &key, Args &&...args);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  template <typename K> size_type eraseEqual(const K &key);
+  template <typename Pred> size_type eraseIf(Pred pred);
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  using leaf_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Leaf>;
+  using inner_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Inner>;
+
+  // высота дерева из узлов с минимум двумя детьми ограничена битами size_t
+  static constexpr size_type kMaxHeight =
+      std::numeric_limits<size_type>::digits + 1;
+
+  // Auxiliary search methods:
+  template <typename K>
+  size_type nodeSearch(const Key *keys, size_type count, const K &key,
+                       bool upper) const;
+  template <typename K>
+  size_type leafSearch(const Leaf *leaf, const K &key, bool upper) const;
+  template <typename K> Leaf *descend(const K &key, bool upper) const;
+  template <typename K> const_iterator bound(const K &key, bool upper) const;
+  const_iterator makeIterator(const Leaf *leaf, size_type pos) const noexcept;
+  iterator makeMutable(const_iterator it) const noexcept;
+
+  // Auxiliary insertion methods:
+  template <typename... Args>
+  iterator insertAt(Leaf *leaf, size_type pos, Args &&...args);
+  void reserveSplits(Leaf *leaf, Leaf *&right, Inner **spare,
+                     size_type &spares);
+  void splitLeaf(Leaf *&leaf, Leaf *right, size_type &pos, Inner **spare,
+                 size_type &spares);
+  void insertIntoParent(NodeBase *left, Key &&separator, NodeBase *right,
+                        Inner **spare, size_type &spares) noexcept;
+  static void insertChild(Inner *node, size_type index, Key &&separator,
+                          NodeBase *right) noexcept;
+
+  // Auxiliary erasure methods:
+  void rebalanceLeaf(Leaf *&leaf, size_type &pos) noexcept;
+  bool borrowToLeaf(Leaf *leaf, Leaf *left, Leaf *right);
+  void rebalanceInner(Inner *node) noexcept;
+  static void removeChild(Inner *node, size_type index) noexcept;
+  void mergeLeaves(Leaf *left, Leaf *right) noexcept;
+  void mergeInners(Inner *left, Inner *right) noexcept;
+
+  // Auxiliary node methods:
+  Leaf *createLeaf();
+  Inner *createInner();
+  void destroyLeaf(Leaf *leaf) noexcept;
+  void destroyInner(Inner *node) noexcept;
+  void destroySubtree(NodeBase *node) noexcept;
+  void copyFrom(const BTree &other);
+  static void adoptChildren(Inner *node, size_type from) noexcept;
+  template <typename T>
+  static void relocate(T *first, T *last, T *dest) noexcept;
+  size_type nodeCount(const NodeBase *node, bool leaves) const noexcept;
+  bool checkNode(const NodeBase *node, const Key *low, const Key *high,
+                 size_type depth, size_type &leaf_depth,
+                 const Leaf *&prev_leaf, size_type &elements) const;
+
+  NodeBase *root_ = nullptr;
+  Leaf *first_ = nullptr; // самый левый лист - begin()
+  Leaf *last_ = nullptr;  // самый правый лист - end()
+  size_type size_ = 0;
+  Comparator comparator_;
+  KeyOfValue key_of_;
+  allocator_type alloc_;
+};
+
+/**
+ * @brief Bidirectional iterator of BTree: a leaf and a slot in it.
+ *
+ * end() is the slot past the last element of the rightmost leaf. Any other
+ * position is never the slot past the end of a leaf: such a position is
+ * always moved to the first slot of the next leaf.
+ */
+template <typename Tree, bool IsConst> class BTreeIterator {
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type =
+      typename std::conditional<IsConst, const typename Tree::value_type,
+                                typename Tree::value_type>::type;
+  using pointer = value_type *;
+  using reference = value_type &;
+  using difference_type = std::ptrdiff_t;
+  using Leaf = typename Tree::Leaf;
+  using size_type = typename Tree::size_type;
+
+  BTreeIterator() noexcept = default;
+  BTreeIterator(Leaf *leaf, size_type pos) noexcept : leaf_(leaf), pos_(pos) {}
+  template <bool C = IsConst, typename = typename std::enable_if<C>::type>
+  BTreeIterator(const BTreeIterator<Tree, false> &other) noexcept
+      : leaf_(other.leaf()), pos_(other.pos()) {} // iterator -> const_iterator
+
+  reference operator*() const noexcept { return leaf_->values()[pos_]; }
+  pointer operator->() const noexcept { return leaf_->values() + pos_; }
+
+  BTreeIterator &operator++() noexcept;
+  BTreeIterator operator++(int) noexcept;
+  BTreeIterator &operator--() noexcept;
+  BTreeIterator operator--(int) noexcept;
+
+  bool operator==(const BTreeIterator &other) const noexcept {
+    return leaf_ == other.leaf_ && pos_ == other.pos_;
+  }
+  bool operator!=(const BTreeIterator &other) const noexcept {
+    return !(*this == other);
+  }
+
+  Leaf *leaf() const noexcept { return leaf_; }
+  size_type pos() const noexcept { return pos_; }
+
+private:
+  Leaf *leaf_ = nullptr;
+  size_type pos_ = 0;
+};
+
+} //  namespace s21
+
+#include "b_tree.tpp" // Подключаем файл с определениями шаблонов
+
+#endif // CPP2_S21_CONTAINERS_B_TREE_H_
@@ -0,0 +1,1567 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file b_tree.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-07-21
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#include "b_tree.h"
+
+namespace s21 {
+
+/******************************************************************************
+ * SIMD KEY SEARCH
+ ******************************************************************************/
+
+// Ключи, которые сравниваются векторными инструкциями: встроенные числа,
+// упорядоченные std::less или std::greater (bool и long double - нет)
+template <typename Key, typename Comparator, typename K>
+struct BTreeSimdSearch {
+  static constexpr bool kLess =
+      std::is_same<Comparator, std::less<Key>>::value ||
+      std::is_same<Comparator, std::less<>>::value;
+  static constexpr bool kGreater =
+      std::is_same<Comparator, std::greater<Key>>::value ||
+      std::is_same<Comparator, std::greater<>>::value;
+  static constexpr bool value =
+      std::is_arithmetic<Key>::value && !std::is_same<Key, bool>::value &&
+      std::is_same<K, Key>::value && (kLess || kGreater) &&
+      (sizeof(Key) == 1 || sizeof(Key) == 2 || sizeof(Key) == 4 ||
+       sizeof(Key) == 8);
+};
+
+/**
+ * @brief Counts the keys of a sorted node array that go before key.
+ *
+ * The array is compared 16 bytes at a time with GCC/Clang vector
+ * extensions (SSE2 or NEON code, without intrinsics), the comparison masks
+ * are summed up and the remaining keys are compared one by one. There are
+ * no branches on the key values, so the cost does not depend on where the
+ * key lies; for node sizes of a few cache lines this beats a binary search.
+ *
+ * @tparam T Arithmetic key type of 1, 2, 4 or 8 bytes.
+ * @tparam Greater True if the keys are sorted in descending order.
+ * @param keys The keys, sorted.
+ * @param count Number of keys.
+ * @param key The key to look for.
+ * @param or_equal If true, keys equal to key are counted as well.
+ *
+ * @return std::size_t Number of keys before key (the lower or the upper
+ * bound position).
+ */
+template <typename T, bool Greater>
+std::size_t btreeSimdCount(const T *keys, std::size_t count, T key,
+                           bool or_equal) noexcept {
+  std::size_t result = 0;
+  std::size_t i = 0;
+#if defined(__GNUC__)
+  constexpr std::size_t kLanes = 16 / sizeof(T);
+  typedef T Vector __attribute__((vector_size(16)));
+  Vector needle = Vector{} + key;
+  std::size_t blocks_end = count - count % kLanes;
+  while (i < blocks_end) {
+    decltype(needle < needle) hits = {}; // в каждой полосе - число совпадений
+    // не больше 127 блоков за проход: счётчик полосы-байта не переполнится
+    std::size_t chunk_end =
+        blocks_end - i > 127 * kLanes ? i + 127 * kLanes : blocks_end;
+    for (; i < chunk_end; i += kLanes) {
+      Vector block;
+      std::memcpy(&block, keys + i, sizeof(block));
+      if (Greater) {
+        hits -= or_equal ? (block >= needle) : (block > needle); // маска = -1
+      } else {
+        hits -= or_equal ? (block <= needle) : (block < needle);
+      }
+    }
+    for (std::size_t lane = 0; lane < kLanes; ++lane) {
+      result += static_cast<std::size_t>(hits[lane]);
+    }
+  }
+#endif
+  for (; i < count; ++i) {
+    T k = keys[i];
+    if (Greater) {
+      result += or_equal ? !(k < key) : k > key;
+    } else {
+      result += or_equal ? !(k > key) : k < key;
+    }
+  }
+  return result;
+}
+
+/******************************************************************************
+ * CONSTRUCTORS & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Creates an empty tree with a default-constructed allocator.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::BTree()
+    : BTree(allocator_type()) {}
+
+/**
+ * @brief Creates an empty tree that allocates nodes with alloc.
+ *
+ * @param alloc The allocator. No memory is allocated until the first
+ * insertion.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::BTree(
+    const allocator_type &alloc)
+    : alloc_(alloc) {}
+
+/**
+ * @brief Copies other element by element, filling the leaves from the left.
+ *
+ * @param other The tree to copy.
+ *
+ * @throws std::bad_alloc, anything thrown by the element copy constructor
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::BTree(const BTree &other)
+    : comparator_(other.comparator_), key_of_(other.key_of_),
+      alloc_(std::allocator_traits<Allocator>::
+                 select_on_container_copy_construction(other.alloc_)) {
+  copyFrom(other);
+}
+
+/**
+ * @brief Takes over the nodes of other, which is left empty.
+ *
+ * @param other The tree to move from.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::BTree(
+    BTree &&other) noexcept
+    : root_(other.root_), first_(other.first_), last_(other.last_),
+      size_(other.size_), comparator_(other.comparator_),
+      key_of_(other.key_of_), alloc_(other.alloc_) {
+  other.root_ = nullptr;
+  other.first_ = other.last_ = nullptr;
+  other.size_ = 0;
+}
+
+/**
+ * @brief Destroys all elements and frees the nodes.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::~BTree() {
+  clear();
+}
+
+/**
+ * @brief Replaces the contents with a copy of other.
+ *
+ * @param other The tree to copy.
+ * @return BTree& This tree.
+ *
+ * @throws std::bad_alloc, anything thrown by the element copy constructor;
+ * the tree is left empty then
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+BTree<Key, Value, KeyOfValue, Comparator, Allocator> &
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::operator=(
+    const BTree &other) {
+  if (this != &other) {
+    clear();
+    comparator_ = other.comparator_;
+    key_of_ = other.key_of_;
+    copyFrom(other);
+  }
+  return *this;
+}
+
+/**
+ * @brief Replaces the contents with the nodes of other.
+ *
+ * @param other The tree to move from, left empty.
+ * @return BTree& This tree.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+BTree<Key, Value, KeyOfValue, Comparator, Allocator> &
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::operator=(
+    BTree &&other) noexcept {
+  if (this != &other) {
+    BTree moved(std::move(other));
+    swap(moved);
+  }
+  return *this;
+}
+
+/**
+ * @brief Returns a copy of the allocator.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::allocator_type
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::get_allocator()
+    const noexcept {
+  return alloc_;
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Returns the number of elements.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::size() const noexcept {
+  return size_;
+}
+
+/**
+ * @brief Returns the maximum possible number of elements.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::max_size()
+    const noexcept {
+  leaf_allocator alloc(alloc_);
+  return std::allocator_traits<leaf_allocator>::max_size(alloc) * kMinLeaf;
+}
+
+/**
+ * @brief Checks whether the tree is empty.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+bool BTree<Key, Value, KeyOfValue, Comparator, Allocator>::empty()
+    const noexcept {
+  return size_ == 0;
+}
+
+/**
+ * @brief Returns the number of levels (0 for an empty tree, 1 for a single
+ * leaf).
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::height() const noexcept {
+  size_type levels = 0;
+  for (const NodeBase *node = root_; node != nullptr; ++levels) {
+    node = node->leaf_ ? nullptr
+                       : static_cast<const Inner *>(node)->children_[0];
+  }
+  return levels;
+}
+
+/**
+ * @brief Returns the number of bytes taken by the nodes, O(number of nodes).
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::memoryUsage()
+    const noexcept {
+  return nodeCount(root_, true) * sizeof(Leaf) +
+         nodeCount(root_, false) * sizeof(Inner);
+}
+
+/**
+ * @brief Destroys all elements and frees all nodes.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::clear() noexcept {
+  destroySubtree(root_);
+  root_ = nullptr;
+  first_ = last_ = nullptr;
+  size_ = 0;
+}
+
+/**
+ * @brief Swaps the contents and the allocators of two trees.
+ *
+ * @param other The tree to swap with.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::swap(
+    BTree &other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(first_, other.first_);
+  std::swap(last_, other.last_);
+  std::swap(size_, other.size_);
+  std::swap(comparator_, other.comparator_);
+  std::swap(key_of_, other.key_of_);
+  std::swap(alloc_, other.alloc_);
+}
+
+/**
+ * @brief Returns an iterator to the smallest element, O(1).
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::begin() noexcept {
+  return makeMutable(makeIterator(first_, 0));
+}
+
+/**
+ * @brief Returns the iterator past the largest element, O(1).
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::end() noexcept {
+  return last_ != nullptr ? iterator(last_, last_->count_) : iterator();
+}
+
+/**
+ * @brief Returns a const iterator to the smallest element, O(1).
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::const_iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::begin() const noexcept {
+  return makeIterator(first_, 0);
+}
+
+/**
+ * @brief Returns the const iterator past the largest element, O(1).
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::const_iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::end() const noexcept {
+  return last_ != nullptr ? const_iterator(last_, last_->count_)
+                          : const_iterator();
+}
+
+/******************************************************************************
+ * LOOKUP
+ ******************************************************************************/
+
+/**
+ * @brief Finds an element with a key equivalent to key, O(log n).
+ *
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param key The key to find.
+ * @return iterator The first such element, or end().
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::find(const K &key) {
+  return makeMutable(static_cast<const BTree *>(this)->find(key));
+}
+
+/**
+ * @brief Finds an element with a key equivalent to key, O(log n).
+ *
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param key The key to find.
+ * @return const_iterator The first such element, or end().
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::const_iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::find(
+    const K &key) const {
+  const_iterator it = bound(key, false);
+  if (it != end() && !comparator_(key, key_of_(*it))) {
+    return it;
+  }
+  return end();
+}
+
+/**
+ * @brief Returns an iterator to the first element not less than key.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::lower_bound(
+    const K &key) {
+  return makeMutable(bound(key, false));
+}
+
+/**
+ * @brief Returns a const iterator to the first element not less than key.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::const_iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::lower_bound(
+    const K &key) const {
+  return bound(key, false);
+}
+
+/**
+ * @brief Returns an iterator to the first element greater than key.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::upper_bound(
+    const K &key) {
+  return makeMutable(bound(key, true));
+}
+
+/**
+ * @brief Returns a const iterator to the first element greater than key.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::const_iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::upper_bound(
+    const K &key) const {
+  return bound(key, true);
+}
+
+/**
+ * @brief Counts the elements with keys equivalent to key, O(log n + count).
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::count(
+    const K &key) const {
+  size_type result = 0;
+  for (const_iterator it = bound(key, false);
+       it != end() && !comparator_(key, key_of_(*it)); ++it) {
+    ++result;
+  }
+  return result;
+}
+
+/**
+ * @brief Finds the position of key in a sorted key array of a node.
+ *
+ * Arithmetic keys are compared with btreeSimdCount(), other keys with a
+ * binary search.
+ *
+ * @param keys The keys of the node.
+ * @param count Number of keys.
+ * @param key The key to look for.
+ * @param upper If true, the position after the keys equivalent to key is
+ * returned, otherwise the position before them.
+ *
+ * @return size_type Number of keys before the position.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::nodeSearch(
+    const Key *keys, size_type count, const K &key, bool upper) const {
+  using Simd = BTreeSimdSearch<Key, Comparator, K>;
+  if constexpr (Simd::value) {
+    return btreeSimdCount<Key, Simd::kGreater>(keys, count, key, upper);
+  } else {
+    size_type low = 0;
+    size_type high = count;
+    while (low < high) {
+      size_type middle = low + (high - low) / 2;
+      bool before = upper ? !comparator_(key, keys[middle])
+                          : comparator_(keys[middle], key);
+      if (before) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    return low;
+  }
+}
+
+/**
+ * @brief Finds the position of key in a leaf.
+ *
+ * The elements of set leaves are the keys themselves and go to
+ * nodeSearch(); map elements are searched by their keys.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::leafSearch(
+    const Leaf *leaf, const K &key, bool upper) const {
+  if constexpr (std::is_same<Key, Value>::value) {
+    return nodeSearch(leaf->values(), leaf->count_, key, upper);
+  } else {
+    const Value *values = leaf->values();
+    size_type low = 0;
+    size_type high = leaf->count_;
+    while (low < high) {
+      size_type middle = low + (high - low) / 2;
+      const Key &current = key_of_(values[middle]);
+      bool before =
+          upper ? !comparator_(key, current) : comparator_(current, key);
+      if (before) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    return low;
+  }
+}
+
+/**
+ * @brief Descends from the root to the leaf where key belongs.
+ *
+ * With upper set the leaf of the upper bound of key is found, otherwise
+ * the leaf of the lower bound (the bound itself may be the first element of
+ * the next leaf).
+ *
+ * @return Leaf* The leaf; the tree must not be empty.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::Leaf *
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::descend(
+    const K &key, bool upper) const {
+  NodeBase *node = root_;
+  while (!node->leaf_) {
+    Inner *inner = static_cast<Inner *>(node);
+    node = inner->children_[nodeSearch(inner->keys(), inner->count_, key,
+                                       upper)];
+  }
+  return static_cast<Leaf *>(node);
+}
+
+/**
+ * @brief Returns the lower (or with upper set the upper) bound of key.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::const_iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::bound(const K &key,
+                                                           bool upper) const {
+  if (root_ == nullptr) {
+    return end();
+  }
+  Leaf *leaf = descend(key, upper);
+  return makeIterator(leaf, leafSearch(leaf, key, upper));
+}
+
+/**
+ * @brief Makes an iterator from a leaf and a slot, moving the slot past the
+ * end of a leaf to the first slot of the next leaf.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::const_iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::makeIterator(
+    const Leaf *leaf, size_type pos) const noexcept {
+  if (leaf == nullptr) {
+    return const_iterator();
+  }
+  while (pos == leaf->count_ && leaf->next_ != nullptr) {
+    leaf = leaf->next_;
+    pos = 0;
+  }
+  return const_iterator(const_cast<Leaf *>(leaf), pos);
+}
+
+/**
+ * @brief Converts a const iterator of this tree to an iterator.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::makeMutable(
+    const_iterator it) const noexcept {
+  return iterator(it.leaf(), it.pos());
+}
+
+/******************************************************************************
+ * INSERTION
+ ******************************************************************************/
+
+/**
+ * @brief Inserts a copy of (or moves) value, O(log n).
+ *
+ * An element equivalent to existing ones goes after them.
+ *
+ * @tparam Arg Value or a reference to it.
+ * @param value The element.
+ * @param unique If true, nothing is inserted when an equivalent key exists.
+ *
+ * @return std::pair<iterator, bool> The inserted or the existing element,
+ * and whether the insertion took place.
+ *
+ * @throws std::bad_alloc, anything thrown by the comparator or by the
+ * element constructor; the elements are not changed then
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename Arg>
+std::pair<typename BTree<Key, Value, KeyOfValue, Comparator,
+                         Allocator>::iterator,
+          bool>
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::insert(Arg &&value,
+                                                            bool unique) {
+  const Key &key = key_of_(value);
+  if (root_ == nullptr) {
+    root_ = first_ = last_ = createLeaf();
+  }
+  Leaf *leaf = descend(key, !unique);
+  size_type pos = leafSearch(leaf, key, !unique);
+  if (unique) {
+    const_iterator it = makeIterator(leaf, pos);
+    if (it != end() && !comparator_(key, key_of_(*it))) {
+      return {makeMutable(it), false};
+    }
+  }
+  return {insertAt(leaf, pos, std::forward<Arg>(value)), true};
+}
+
+/**
+ * @brief Inserts value right before hint if that keeps the order, without
+ * descending from the root.
+ *
+ * The hint is used when it is end() or not the first slot of its leaf: the
+ * element then lands in the same leaf as its neighbours and the separators
+ * above stay valid. Otherwise the element is inserted as by insert().
+ *
+ * @param hint Position before which value should be inserted.
+ * @param value The element.
+ * @param unique If true, nothing is inserted when an equivalent key exists.
+ *
+ * @return iterator The inserted element or the existing equivalent one.
+ *
+ * @throws std::bad_alloc, anything thrown by the comparator or by the
+ * element constructor
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename Arg>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::insertHint(
+    const_iterator hint, Arg &&value, bool unique) {
+  Leaf *leaf = hint.leaf();
+  size_type pos = hint.pos();
+  if (leaf != nullptr && pos > 0) {
+    const Key &key = key_of_(value);
+    const Key &prev = key_of_(leaf->values()[pos - 1]);
+    bool after_prev = unique ? comparator_(prev, key) : !comparator_(key, prev);
+    bool before_next = hint == end();
+    if (!before_next) {
+      const Key &next = key_of_(*hint);
+      before_next =
+          unique ? comparator_(key, next) : !comparator_(next, key);
+    }
+    if (after_prev && before_next) {
+      return insertAt(leaf, pos, std::forward<Arg>(value));
+    }
+  }
+  return insert(std::forward<Arg>(value), unique).first;
+}
+
+/**
+ * @brief Builds an element from args and inserts it.
+ *
+ * The element is built before its key is known, so one temporary is moved
+ * into the tree.
+ *
+ * @param unique If true, nothing is inserted when an equivalent key exists.
+ * @param args Arguments of the element constructor.
+ *
+ * @return std::pair<iterator, bool> As for insert().
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename... Args>
+std::pair<typename BTree<Key, Value, KeyOfValue, Comparator,
+                         Allocator>::iterator,
+          bool>
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::emplace(
+    bool unique, Args &&...args) {
+  Value value(std::forward<Args>(args)...);
+  return insert(std::move(value), unique);
+}
+
+/**
+ * @brief Inserts a map element with key and a mapped value built from args
+ * if the key is absent; otherwise nothing is built.
+ *
+ * @param key The key.
+ * @param args Arguments of the mapped value constructor.
+ *
+ * @return std::pair<iterator, bool> The inserted or the existing element,
+ * and whether the insertion took place.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename... Args>
+std::pair<typename BTree<Key, Value, KeyOfValue, Comparator,
+                         Allocator>::iterator,
+          bool>
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::tryEmplace(
+    const Key &key, Args &&...args) {
+  if (root_ == nullptr) {
+    root_ = first_ = last_ = createLeaf();
+  }
+  Leaf *leaf = descend(key, false);
+  size_type pos = leafSearch(leaf, key, false);
+  const_iterator it = makeIterator(leaf, pos);
+  if (it != end() && !comparator_(key, key_of_(*it))) {
+    return {makeMutable(it), false};
+  }
+  return {insertAt(leaf, pos, std::piecewise_construct,
+                   std::forward_as_tuple(key),
+                   std::forward_as_tuple(std::forward<Args>(args)...)),
+          true};
+}
+
+/**
+ * @brief Builds an element from args in slot pos of leaf.
+ *
+ * A full leaf is split first; the nodes for all splits up to the root are
+ * allocated before anything is changed. When appending to the rightmost
+ * leaf it keeps all its elements but one, so sorted input fills the leaves
+ * almost completely.
+ *
+ * @param leaf The leaf, pos its slot; the order must stay sorted.
+ * @param args Arguments of the element constructor.
+ *
+ * @return iterator The new element.
+ *
+ * @throws std::bad_alloc, anything thrown by the key copy or the element
+ * constructor; the elements are not changed then
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename... Args>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::insertAt(
+    Leaf *leaf, size_type pos, Args &&...args) {
+  if (leaf->count_ == kLeafSlots) {
+    Leaf *right = nullptr;
+    Inner *spare[kMaxHeight];
+    size_type spares = 0;
+    reserveSplits(leaf, right, spare, spares);
+    try {
+      splitLeaf(leaf, right, pos, spare, spares);
+    } catch (...) {
+      destroyLeaf(right);
+      while (spares > 0) {
+        destroyInner(spare[--spares]);
+      }
+      throw;
+    }
+  }
+
+  Value *values = leaf->values();
+  relocate(values + pos, values + leaf->count_, values + pos + 1);
+  try {
+    new (values + pos) Value(std::forward<Args>(args)...);
+  } catch (...) {
+    relocate(values + pos + 1, values + leaf->count_ + 1, values + pos);
+    if (size_ == 0) {
+      clear(); // пустой корневой лист, созданный для этой вставки
+    }
+    throw;
+  }
+  ++leaf->count_;
+  ++size_;
+  return iterator(leaf, pos);
+}
+
+/**
+ * @brief Allocates the nodes needed to split a full leaf: a new leaf, one
+ * inner node per full ancestor and a new root if all of them are full.
+ *
+ * @throws std::bad_alloc, nothing stays allocated then
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::reserveSplits(
+    Leaf *leaf, Leaf *&right, Inner **spare, size_type &spares) {
+  try {
+    right = createLeaf();
+    for (Inner *node = leaf->parent_;; node = node->parent_) {
+      if (node != nullptr && node->count_ < kInnerSlots) {
+        break;
+      }
+      spare[spares++] = createInner();
+      if (node == nullptr) {
+        break; // новый корень
+      }
+    }
+  } catch (...) {
+    if (right != nullptr) {
+      destroyLeaf(right);
+    }
+    while (spares > 0) {
+      destroyInner(spare[--spares]);
+    }
+    throw;
+  }
+}
+
+/**
+ * @brief Moves the upper part of a full leaf into right and links right
+ * into the tree.
+ *
+ * @param leaf The full leaf; receives the leaf where slot pos now lies.
+ * @param right An empty leaf.
+ * @param pos The slot of the coming element, updated.
+ * @param spare Inner nodes reserved by reserveSplits().
+ * @param spares Number of reserved nodes, decreased.
+ *
+ * @throws anything thrown by the key copy; nothing is changed then
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::splitLeaf(
+    Leaf *&leaf, Leaf *right, size_type &pos, Inner **spare,
+    size_type &spares) {
+  size_type count = leaf->count_;
+  // дописывание в конец: в левом листе остаётся всё, кроме одного элемента
+  size_type middle =
+      pos == count && leaf->next_ == nullptr ? count - 1 : count / 2;
+  Key separator(key_of_(leaf->values()[middle])); // единственное исключение
+
+  relocate(leaf->values() + middle, leaf->values() + count, right->values());
+  right->count_ = static_cast<unsigned short>(count - middle);
+  leaf->count_ = static_cast<unsigned short>(middle);
+  right->prev_ = leaf;
+  right->next_ = leaf->next_;
+  if (leaf->next_ != nullptr) {
+    leaf->next_->prev_ = right;
+  } else {
+    last_ = right;
+  }
+  leaf->next_ = right;
+  insertIntoParent(leaf, std::move(separator), right, spare, spares);
+
+  // элемент на границе остаётся в левом листе: он не больше разделителя
+  if (pos > middle) {
+    leaf = right;
+    pos -= middle;
+  }
+}
+
+/**
+ * @brief Links right after left into their parent, splitting full inner
+ * nodes up to the root with the reserved nodes.
+ *
+ * @param left A node of the tree.
+ * @param separator Key between left and right.
+ * @param right The new node.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::insertIntoParent(
+    NodeBase *left, Key &&separator, NodeBase *right, Inner **spare,
+    size_type &spares) noexcept {
+  Inner *parent = left->parent_;
+  if (parent == nullptr) {
+    Inner *root = spare[--spares];
+    new (root->keys()) Key(std::move(separator));
+    root->children_[0] = left;
+    root->children_[1] = right;
+    root->count_ = 1;
+    adoptChildren(root, 0);
+    root_ = root;
+    return;
+  }
+
+  size_type index = left->position_;
+  if (parent->count_ < kInnerSlots) {
+    insertChild(parent, index, std::move(separator), right);
+    return;
+  }
+
+  // узел полон: верхняя часть ключей и детей уходит в sibling
+  Inner *sibling = spare[--spares];
+  size_type count = parent->count_;
+  size_type middle = index == count ? count - 1 : count / 2;
+  relocate(parent->keys() + middle + 1, parent->keys() + count,
+           sibling->keys());
+  for (size_type i = middle + 1; i <= count; ++i) {
+    sibling->children_[i - middle - 1] = parent->children_[i];
+  }
+  Key up(std::move(parent->keys()[middle]));
+  parent->keys()[middle].~Key();
+  parent->count_ = static_cast<unsigned short>(middle);
+  sibling->count_ = static_cast<unsigned short>(count - middle - 1);
+  adoptChildren(sibling, 0);
+
+  if (index <= middle) {
+    insertChild(parent, index, std::move(separator), right);
+  } else {
+    insertChild(sibling, index - middle - 1, std::move(separator), right);
+  }
+  insertIntoParent(parent, std::move(up), sibling, spare, spares);
+}
+
+/**
+ * @brief Inserts separator at index and right as child index + 1 of a node
+ * that has room for them.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::insertChild(
+    Inner *node, size_type index, Key &&separator, NodeBase *right) noexcept {
+  size_type count = node->count_;
+  relocate(node->keys() + index, node->keys() + count,
+           node->keys() + index + 1);
+  new (node->keys() + index) Key(std::move(separator));
+  for (size_type i = count + 1; i > index + 1; --i) {
+    node->children_[i] = node->children_[i - 1];
+  }
+  node->children_[index + 1] = right;
+  ++node->count_;
+  adoptChildren(node, index + 1);
+}
+
+/******************************************************************************
+ * ERASURE
+ ******************************************************************************/
+
+/**
+ * @brief Erases the element at pos, O(log n).
+ *
+ * A leaf that falls below half full borrows an element from a sibling or is
+ * merged with it; merges may go up to the root, which is removed when it
+ * has a single child left.
+ *
+ * @param pos Iterator to the element, must be dereferenceable.
+ * @return iterator The element that followed the erased one.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::erase(
+    const_iterator pos) {
+  Leaf *leaf = pos.leaf();
+  size_type slot = pos.pos();
+  Value *values = leaf->values();
+  values[slot].~Value();
+  relocate(values + slot + 1, values + leaf->count_, values + slot);
+  --leaf->count_;
+  --size_;
+
+  if (leaf == root_) {
+    if (leaf->count_ == 0) {
+      clear();
+      return end();
+    }
+  } else if (leaf->count_ < kMinLeaf) {
+    rebalanceLeaf(leaf, slot);
+  }
+  return makeMutable(makeIterator(leaf, slot));
+}
+
+/**
+ * @brief Erases the elements in [first, last), O(k log n).
+ *
+ * @return iterator The element that followed the erased range.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::erase(
+    const_iterator first, const_iterator last) {
+  size_type count = 0; // erase() сдвигает элементы, last после него неверен
+  for (const_iterator it = first; it != last; ++it) {
+    ++count;
+  }
+  iterator it = makeMutable(first);
+  for (; count > 0; --count) {
+    it = erase(it);
+  }
+  return it;
+}
+
+/**
+ * @brief Erases all elements with keys equivalent to key.
+ *
+ * @return size_type The number of erased elements.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::eraseEqual(
+    const K &key) {
+  size_type erased = 0;
+  iterator it = lower_bound(key);
+  while (it != end() && !comparator_(key, key_of_(*it))) {
+    it = erase(it);
+    ++erased;
+  }
+  return erased;
+}
+
+/**
+ * @brief Erases all elements for which pred returns true, in one pass.
+ *
+ * @param pred Predicate called once per element in key order.
+ * @return size_type The number of erased elements.
+ *
+ * @throws Anything thrown by pred; the elements checked before stay erased
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename Pred>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::eraseIf(Pred pred) {
+  size_type erased = 0;
+  for (iterator it = begin(); it != end();) {
+    if (pred(static_cast<const Value &>(*it))) {
+      it = erase(it);
+      ++erased;
+    } else {
+      ++it;
+    }
+  }
+  return erased;
+}
+
+/**
+ * @brief Restores the fill of a leaf that fell below kMinLeaf.
+ *
+ * @param leaf The leaf; receives the leaf that now holds slot pos.
+ * @param pos A slot of leaf, followed to its new place.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::rebalanceLeaf(
+    Leaf *&leaf, size_type &pos) noexcept {
+  Inner *parent = leaf->parent_;
+  size_type index = leaf->position_;
+  Leaf *left = index > 0 ? static_cast<Leaf *>(parent->children_[index - 1])
+                         : nullptr;
+  Leaf *right = index < parent->count_
+                    ? static_cast<Leaf *>(parent->children_[index + 1])
+                    : nullptr;
+  // пустой лист всегда сливается: слияние не копирует ключи и не бросает
+  if (leaf->count_ > 0 && ((left != nullptr && left->count_ > kMinLeaf) ||
+                           (right != nullptr && right->count_ > kMinLeaf))) {
+    try {
+      if (borrowToLeaf(leaf, left, right)) {
+        ++pos; // элемент добавлен в начало листа
+      }
+    } catch (...) {
+      // копия разделителя не удалась - лист остаётся заполненным меньше
+      // чем наполовину, порядок ключей при этом не нарушен
+    }
+    return;
+  }
+
+  if (left != nullptr) {
+    pos += left->count_;
+    mergeLeaves(left, leaf);
+    leaf = left;
+  } else {
+    mergeLeaves(leaf, right);
+  }
+  rebalanceInner(parent);
+}
+
+/**
+ * @brief Moves one element from a sibling that has more than kMinLeaf of
+ * them into leaf and updates the separator between them.
+ *
+ * @return bool True if the element came from the left sibling.
+ *
+ * @throws anything thrown by the key copy; nothing is changed then
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+bool BTree<Key, Value, KeyOfValue, Comparator, Allocator>::borrowToLeaf(
+    Leaf *leaf, Leaf *left, Leaf *right) {
+  Inner *parent = leaf->parent_;
+  size_type index = leaf->position_;
+  if (left != nullptr && left->count_ > kMinLeaf) {
+    Value *donor = left->values() + left->count_ - 1;
+    Key separator(key_of_(*donor));
+    relocate(leaf->values(), leaf->values() + leaf->count_,
+             leaf->values() + 1);
+    relocate(donor, donor + 1, leaf->values());
+    --left->count_;
+    ++leaf->count_;
+    parent->keys()[index - 1] = std::move(separator);
+    return true;
+  }
+
+  Value *donor = right->values();
+  Key separator(key_of_(donor[1])); // новый первый элемент правого листа
+  relocate(donor, donor + 1, leaf->values() + leaf->count_);
+  relocate(donor + 1, donor + right->count_, donor);
+  --right->count_;
+  ++leaf->count_;
+  parent->keys()[index] = std::move(separator);
+  return false;
+}
+
+/**
+ * @brief Restores the fill of inner nodes from node up to the root.
+ *
+ * A node below kMinInner keys takes a child from a sibling through the
+ * parent separator or is merged with a sibling, which takes a key from the
+ * parent. A root left without keys is replaced by its only child.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::rebalanceInner(
+    Inner *node) noexcept {
+  while (node != root_) {
+    if (node->count_ >= kMinInner) {
+      return;
+    }
+    Inner *parent = node->parent_;
+    size_type index = node->position_;
+    Inner *left = index > 0
+                      ? static_cast<Inner *>(parent->children_[index - 1])
+                      : nullptr;
+    Inner *right = index < parent->count_
+                       ? static_cast<Inner *>(parent->children_[index + 1])
+                       : nullptr;
+
+    if (left != nullptr && left->count_ > kMinInner) {
+      // последний ребёнок left переходит в начало node через родителя
+      size_type count = node->count_;
+      relocate(node->keys(), node->keys() + count, node->keys() + 1);
+      for (size_type i = count + 1; i > 0; --i) {
+        node->children_[i] = node->children_[i - 1];
+      }
+      new (node->keys()) Key(std::move(parent->keys()[index - 1]));
+      parent->keys()[index - 1] = std::move(left->keys()[left->count_ - 1]);
+      left->keys()[left->count_ - 1].~Key();
+      node->children_[0] = left->children_[left->count_];
+      --left->count_;
+      ++node->count_;
+      adoptChildren(node, 0);
+      return;
+    }
+    if (right != nullptr && right->count_ > kMinInner) {
+      // первый ребёнок right переходит в конец node через родителя
+      size_type count = node->count_;
+      new (node->keys() + count) Key(std::move(parent->keys()[index]));
+      node->children_[count + 1] = right->children_[0];
+      parent->keys()[index] = std::move(right->keys()[0]);
+      right->keys()[0].~Key();
+      relocate(right->keys() + 1, right->keys() + right->count_,
+               right->keys());
+      for (size_type i = 0; i < right->count_; ++i) {
+        right->children_[i] = right->children_[i + 1];
+      }
+      --right->count_;
+      ++node->count_;
+      adoptChildren(node, count + 1);
+      adoptChildren(right, 0);
+      return;
+    }
+
+    if (left != nullptr) {
+      mergeInners(left, node);
+    } else {
+      mergeInners(node, right);
+    }
+    node = parent;
+  }
+
+  if (node->count_ == 0) {
+    root_ = node->children_[0];
+    root_->parent_ = nullptr;
+    root_->position_ = 0;
+    destroyInner(node);
+  }
+}
+
+/**
+ * @brief Removes separator index - 1 and child index from an inner node.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::removeChild(
+    Inner *node, size_type index) noexcept {
+  size_type count = node->count_;
+  node->keys()[index - 1].~Key();
+  relocate(node->keys() + index, node->keys() + count,
+           node->keys() + index - 1);
+  for (size_type i = index; i < count; ++i) {
+    node->children_[i] = node->children_[i + 1];
+  }
+  --node->count_;
+  adoptChildren(node, index);
+}
+
+/**
+ * @brief Appends the elements of right to left and frees right.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::mergeLeaves(
+    Leaf *left, Leaf *right) noexcept {
+  relocate(right->values(), right->values() + right->count_,
+           left->values() + left->count_);
+  left->count_ = static_cast<unsigned short>(left->count_ + right->count_);
+  right->count_ = 0;
+  left->next_ = right->next_;
+  if (right->next_ != nullptr) {
+    right->next_->prev_ = left;
+  } else {
+    last_ = left;
+  }
+  removeChild(right->parent_, right->position_);
+  destroyLeaf(right);
+}
+
+/**
+ * @brief Appends the parent separator, the keys and the children of right
+ * to left and frees right.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::mergeInners(
+    Inner *left, Inner *right) noexcept {
+  Inner *parent = right->parent_;
+  size_type index = right->position_;
+  size_type count = left->count_;
+  new (left->keys() + count) Key(std::move(parent->keys()[index - 1]));
+  relocate(right->keys(), right->keys() + right->count_,
+           left->keys() + count + 1);
+  for (size_type i = 0; i <= right->count_; ++i) {
+    left->children_[count + 1 + i] = right->children_[i];
+  }
+  left->count_ = static_cast<unsigned short>(count + 1 + right->count_);
+  right->count_ = 0;
+  adoptChildren(left, count + 1);
+  removeChild(parent, index);
+  destroyInner(right);
+}
+
+/******************************************************************************
+ * NODES
+ ******************************************************************************/
+
+/**
+ * @brief Allocates an empty leaf.
+ *
+ * @throws std::bad_alloc
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::Leaf *
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::createLeaf() {
+  leaf_allocator alloc(alloc_);
+  Leaf *leaf = std::allocator_traits<leaf_allocator>::allocate(alloc, 1);
+  return new (leaf) Leaf();
+}
+
+/**
+ * @brief Allocates an empty inner node.
+ *
+ * @throws std::bad_alloc
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::Inner *
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::createInner() {
+  inner_allocator alloc(alloc_);
+  Inner *node = std::allocator_traits<inner_allocator>::allocate(alloc, 1);
+  return new (node) Inner();
+}
+
+/**
+ * @brief Destroys the elements of a leaf and frees it.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::destroyLeaf(
+    Leaf *leaf) noexcept {
+  for (size_type i = 0; i < leaf->count_; ++i) {
+    leaf->values()[i].~Value();
+  }
+  leaf->~Leaf();
+  leaf_allocator alloc(alloc_);
+  std::allocator_traits<leaf_allocator>::deallocate(alloc, leaf, 1);
+}
+
+/**
+ * @brief Destroys the separators of an inner node and frees it.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::destroyInner(
+    Inner *node) noexcept {
+  for (size_type i = 0; i < node->count_; ++i) {
+    node->keys()[i].~Key();
+  }
+  node->~Inner();
+  inner_allocator alloc(alloc_);
+  std::allocator_traits<inner_allocator>::deallocate(alloc, node, 1);
+}
+
+/**
+ * @brief Frees a subtree; the recursion depth is the tree height.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::destroySubtree(
+    NodeBase *node) noexcept {
+  if (node == nullptr) {
+    return;
+  }
+  if (node->leaf_) {
+    destroyLeaf(static_cast<Leaf *>(node));
+    return;
+  }
+  Inner *inner = static_cast<Inner *>(node);
+  for (size_type i = 0; i <= inner->count_; ++i) {
+    destroySubtree(inner->children_[i]);
+  }
+  destroyInner(inner);
+}
+
+/**
+ * @brief Appends copies of the elements of other to this empty tree.
+ *
+ * @throws std::bad_alloc, anything thrown by the element copy constructor;
+ * the tree is left empty then
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::copyFrom(
+    const BTree &other) {
+  try {
+    for (const Value &value : other) {
+      if (root_ == nullptr) {
+        root_ = first_ = last_ = createLeaf();
+      }
+      insertAt(last_, last_->count_, value);
+    }
+  } catch (...) {
+    clear();
+    throw;
+  }
+}
+
+/**
+ * @brief Points the children of node from index from on back to it.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::adoptChildren(
+    Inner *node, size_type from) noexcept {
+  for (size_type i = from; i <= node->count_; ++i) {
+    node->children_[i]->parent_ = node;
+    node->children_[i]->position_ = static_cast<unsigned short>(i);
+  }
+}
+
+/**
+ * @brief Moves the objects of [first, last) to raw memory at dest and
+ * destroys the originals; the ranges may overlap.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename T>
+void BTree<Key, Value, KeyOfValue, Comparator, Allocator>::relocate(
+    T *first, T *last, T *dest) noexcept {
+  if (first == last || first == dest) {
+    return;
+  }
+  if constexpr (std::is_trivially_copyable<T>::value) {
+    std::memmove(static_cast<void *>(dest), static_cast<const void *>(first),
+                 static_cast<size_type>(last - first) * sizeof(T));
+  } else if (dest < first) {
+    for (; first != last; ++first, ++dest) {
+      new (dest) T(std::move(*first));
+      first->~T();
+    }
+  } else {
+    dest += last - first;
+    while (last != first) {
+      --last;
+      --dest;
+      new (dest) T(std::move(*last));
+      last->~T();
+    }
+  }
+}
+
+/**
+ * @brief Counts the leaves (or the inner nodes) of a subtree.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename BTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+BTree<Key, Value, KeyOfValue, Comparator, Allocator>::nodeCount(
+    const NodeBase *node, bool leaves) const noexcept {
+  if (node == nullptr) {
+    return 0;
+  }
+  if (node->leaf_) {
+    return leaves ? 1 : 0;
+  }
+  const Inner *inner = static_cast<const Inner *>(node);
+  size_type result = leaves ? 0 : 1;
+  for (size_type i = 0; i <= inner->count_; ++i) {
+    result += nodeCount(inner->children_[i], leaves);
+  }
+  return result;
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks the structure of the tree: key order and separator bounds,
+ * parent links, equal depth of all leaves, the leaf list and the element
+ * count.
+ *
+ * @return bool True if the tree is consistent.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+bool BTree<Key, Value, KeyOfValue, Comparator, Allocator>::checkInvariants()
+    const {
+  if (root_ == nullptr) {
+    return size_ == 0 && first_ == nullptr && last_ == nullptr;
+  }
+  size_type leaf_depth = 0;
+  const Leaf *prev_leaf = nullptr;
+  size_type elements = 0;
+  return root_->parent_ == nullptr &&
+         checkNode(root_, nullptr, nullptr, 1, leaf_depth, prev_leaf,
+                   elements) &&
+         prev_leaf == last_ && last_->next_ == nullptr &&
+         first_->prev_ == nullptr && elements == size_;
+}
+
+/**
+ * @brief Checks a subtree whose keys must lie within [low, high] (nullptr
+ * for no bound); the leaves are visited in order and compared with the
+ * leaf list.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+bool BTree<Key, Value, KeyOfValue, Comparator, Allocator>::checkNode(
+    const NodeBase *node, const Key *low, const Key *high, size_type depth,
+    size_type &leaf_depth, const Leaf *&prev_leaf,
+    size_type &elements) const {
+  auto inside = [&](const Key &key) {
+    return (low == nullptr || !comparator_(key, *low)) &&
+           (high == nullptr || !comparator_(*high, key));
+  };
+  if (node->leaf_) {
+    const Leaf *leaf = static_cast<const Leaf *>(node);
+    bool ok = leaf->count_ <= kLeafSlots && leaf->count_ > 0 &&
+              leaf->prev_ == prev_leaf &&
+              (prev_leaf != nullptr ? prev_leaf->next_ == leaf
+                                    : first_ == leaf) &&
+              (leaf_depth == 0 || leaf_depth == depth);
+    leaf_depth = depth;
+    for (size_type i = 0; ok && i < leaf->count_; ++i) {
+      const Key &key = key_of_(leaf->values()[i]);
+      ok = inside(key) &&
+           (i == 0 || !comparator_(key, key_of_(leaf->values()[i - 1])));
+    }
+    prev_leaf = leaf;
+    elements += leaf->count_;
+    return ok;
+  }
+
+  const Inner *inner = static_cast<const Inner *>(node);
+  bool ok = inner->count_ <= kInnerSlots &&
+            (inner->count_ > 0 || inner != root_);
+  for (size_type i = 0; ok && i < inner->count_; ++i) {
+    ok = inside(inner->keys()[i]) &&
+         (i == 0 || !comparator_(inner->keys()[i], inner->keys()[i - 1]));
+  }
+  for (size_type i = 0; ok && i <= inner->count_; ++i) {
+    const NodeBase *child = inner->children_[i];
+    ok = child->parent_ == inner && child->position_ == i &&
+         checkNode(child, i > 0 ? inner->keys() + i - 1 : low,
+                   i < inner->count_ ? inner->keys() + i : high, depth + 1,
+                   leaf_depth, prev_leaf, elements);
+  }
+  return ok;
+}
+
+/******************************************************************************
+ * ITERATOR
+ ******************************************************************************/
+
+/**
+ * @brief Moves to the next element; the end of a leaf continues in the next
+ * leaf.
+ */
+template <typename Tree, bool IsConst>
+BTreeIterator<Tree, IsConst> &
+BTreeIterator<Tree, IsConst>::operator++() noexcept {
+  ++pos_;
+  if (pos_ == leaf_->count_ && leaf_->next_ != nullptr) {
+    leaf_ = leaf_->next_;
+    pos_ = 0;
+  }
+  return *this;
+}
+
+/**
+ * @brief Moves to the next element and returns the previous position.
+ */
+template <typename Tree, bool IsConst>
+BTreeIterator<Tree, IsConst>
+BTreeIterator<Tree, IsConst>::operator++(int) noexcept {
+  BTreeIterator old = *this;
+  ++*this;
+  return old;
+}
+
+/**
+ * @brief Moves to the previous element (end() moves to the last one).
+ */
+template <typename Tree, bool IsConst>
+BTreeIterator<Tree, IsConst> &
+BTreeIterator<Tree, IsConst>::operator--() noexcept {
+  if (pos_ == 0) {
+    leaf_ = leaf_->prev_;
+    pos_ = leaf_->count_;
+  }
+  --pos_;
+  return *this;
+}
+
+/**
+ * @brief Moves to the previous element and returns the previous position.
+ */
+template <typename Tree, bool IsConst>
+BTreeIterator<Tree, IsConst>
+BTreeIterator<Tree, IsConst>::operator--(int) noexcept {
+  BTreeIterator old = *this;
+  --*this;
+  return old;
+}
+
+} // namespace s21
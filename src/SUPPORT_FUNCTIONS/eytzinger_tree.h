@@ -0,0 +1,142 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file eytzinger_tree.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-31
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_EYTZINGER_TREE_H_
+#define CPP2_S21_CONTAINERS_EYTZINGER_TREE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>    // std::memcpy
+#include <functional> // std::less, std::greater
+#include <memory>     // std::allocator
+#include <type_traits>
+
+#include "../MAIN_FUNCTIONS/s21_vector.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Размер листового блока в байтах: блок из kLeaf ключей просматривается
+// целиком, по умолчанию это одна кэш-линия
+#ifndef S21_EYTZINGER_LEAF_BYTES
+#define S21_EYTZINGER_LEAF_BYTES 64
+#endif
+
+namespace s21 {
+
+/**
+ * @brief Immutable search structure over sorted unique keys: an implicit
+ * binary tree of key blocks in Eytzinger (breadth-first) order.
+ *
+ * The sorted keys are cut into blocks of kLeaf keys (one cache line for
+ * small keys). Block i of the breadth-first order is the node i of a
+ * complete binary tree whose children are 2i and 2i + 1 (counting from 1),
+ * and index_ keeps the largest key of every block in the same order. A
+ * lookup descends index_ without branches (the comparison result is added
+ * to the child number), prefetching the line of its descendants a few
+ * levels below, finds the block that may hold the key and then compares the
+ * whole block at once: with SSE2 for integral keys ordered by std::less or
+ * std::greater, otherwise key by key.
+ *
+ * The top levels of index_ are shared by all lookups and stay in cache,
+ * a lookup touches one line per level below them plus one block, and there
+ * are no pointers: the structure costs the keys themselves plus one key per
+ * block. The last block is padded with copies of the largest key. Keys
+ * must be default-constructible and copy-assignable, as s21::vector
+ * requires.
+ *
+ * Storage positions (block * kLeaf + offset) are not in key order;
+ * forEachPosition() lists them in key order, so that a map can keep its
+ * values in a parallel array.
+ *
+ * @tparam Key Type of the keys.
+ * @tparam Compare Strict weak ordering of keys.
+ * @tparam Allocator Allocator of keys.
+ */
+template <typename Key, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class EytzingerTree {
+public:
+  using key_type = Key;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+  using storage_type = s21::vector<Key, Allocator>;
+
+  static constexpr size_type npos = static_cast<size_type>(-1);
+  static constexpr size_type kLeaf =
+      sizeof(Key) < S21_EYTZINGER_LEAF_BYTES
+          ? S21_EYTZINGER_LEAF_BYTES / sizeof(Key)
+          : 1;
+
+  EytzingerTree() = default;
+  explicit EytzingerTree(const allocator_type &alloc);
+  EytzingerTree(const EytzingerTree &other) = default;
+  EytzingerTree(EytzingerTree &&other) noexcept = default;
+  ~EytzingerTree() = default;
+  EytzingerTree &operator=(const EytzingerTree &other) = default;
+  EytzingerTree &operator=(EytzingerTree &&other) noexcept = default;
+
+  allocator_type get_allocator() const noexcept;
+
+  // Main methods:
+  size_type size() const noexcept;
+  bool empty() const noexcept;
+  size_type positions() const noexcept;
+  size_type memoryUsage() const noexcept;
+  void assign(const Key *sorted, size_type count);
+  void clear() noexcept;
+  void swap(EytzingerTree &other) noexcept;
+
+  // Lookup:
+  size_type find(const key_type &key) const;
+  const key_type &keyAt(size_type position) const noexcept;
+  template <typename Fn> void forEachPosition(Fn &&fn) const;
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  // сравнение блока SSE2 допустимо, если равенство ключей - побайтовое
+  static constexpr bool kSimdBlock =
+      std::is_integral<Key>::value && !std::is_same<Key, bool>::value &&
+      (sizeof(Key) == 1 || sizeof(Key) == 2 || sizeof(Key) == 4 ||
+       sizeof(Key) == 8) &&
+      (kLeaf * sizeof(Key)) % 16 == 0 &&
+      (std::is_same<Compare, std::less<Key>>::value ||
+       std::is_same<Compare, std::less<>>::value ||
+       std::is_same<Compare, std::greater<Key>>::value ||
+       std::is_same<Compare, std::greater<>>::value);
+
+  static constexpr size_type prefetchStride() noexcept;
+
+  size_type blocks() const noexcept;
+  size_type findBlock(const key_type &key) const;
+  size_type findInBlock(size_type block, const key_type &key) const;
+  size_type matchBlock(const Key *block, const key_type &key) const noexcept;
+  template <typename Fn> static void walkBlocks(size_type count, Fn &&fn);
+
+  storage_type keys_;  // блоки по kLeaf ключей в порядке обхода в ширину
+  storage_type index_; // наибольший ключ каждого блока, тот же порядок
+  size_type size_ = 0;
+  key_compare compare_;
+};
+
+} // namespace s21
+
+#include "eytzinger_tree.tpp"
+
+#endif // CPP2_S21_CONTAINERS_EYTZINGER_TREE_H_
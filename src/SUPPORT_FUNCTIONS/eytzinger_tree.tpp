@@ -0,0 +1,372 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file eytzinger_tree.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-31
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator of the keys and of the block index.
+ */
+template <typename Key, typename Compare, typename Allocator>
+EytzingerTree<Key, Compare, Allocator>::EytzingerTree(
+    const allocator_type &alloc)
+    : keys_(alloc), index_(alloc) {}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Returns a copy of the allocator.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename EytzingerTree<Key, Compare, Allocator>::allocator_type
+EytzingerTree<Key, Compare, Allocator>::get_allocator() const noexcept {
+  return keys_.get_allocator();
+}
+
+/**
+ * @brief Returns the number of keys.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename EytzingerTree<Key, Compare, Allocator>::size_type
+EytzingerTree<Key, Compare, Allocator>::size() const noexcept {
+  return size_;
+}
+
+/**
+ * @brief Checks whether the tree has no keys.
+ */
+template <typename Key, typename Compare, typename Allocator>
+bool EytzingerTree<Key, Compare, Allocator>::empty() const noexcept {
+  return size_ == 0;
+}
+
+/**
+ * @brief Returns the number of storage positions, padding included: a
+ * parallel array of values must have this size.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename EytzingerTree<Key, Compare, Allocator>::size_type
+EytzingerTree<Key, Compare, Allocator>::positions() const noexcept {
+  return keys_.size();
+}
+
+/**
+ * @brief Returns the number of bytes taken by the keys and the block index.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename EytzingerTree<Key, Compare, Allocator>::size_type
+EytzingerTree<Key, Compare, Allocator>::memoryUsage() const noexcept {
+  return (keys_.capacity() + index_.capacity()) * sizeof(Key);
+}
+
+/**
+ * @brief Builds the tree from sorted unique keys.
+ * @param sorted Keys in increasing order of Compare without equivalent
+ * keys.
+ * @param count Number of keys.
+ * @throws std::bad_alloc, anything thrown by copying a key; the tree is
+ * unchanged then.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void EytzingerTree<Key, Compare, Allocator>::assign(const Key *sorted,
+                                                    size_type count) {
+  size_type block_count = (count + kLeaf - 1) / kLeaf;
+  storage_type keys(block_count * kLeaf, keys_.get_allocator());
+  storage_type index(block_count, index_.get_allocator());
+  Key *key_data = keys.data();
+  Key *index_data = index.data();
+  size_type rank = 0;
+  walkBlocks(block_count, [&](size_type block) {
+    Key *out = key_data + block * kLeaf;
+    for (size_type i = 0; i < kLeaf; ++i, ++rank) {
+      // последний блок дополняется копиями наибольшего ключа
+      out[i] = sorted[rank < count ? rank : count - 1];
+    }
+    index_data[block] = out[kLeaf - 1];
+  });
+  keys_ = std::move(keys);
+  index_ = std::move(index);
+  size_ = count;
+}
+
+/**
+ * @brief Removes all keys.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void EytzingerTree<Key, Compare, Allocator>::clear() noexcept {
+  keys_.clear();
+  index_.clear();
+  size_ = 0;
+}
+
+/**
+ * @brief Swaps the contents with other.
+ */
+template <typename Key, typename Compare, typename Allocator>
+void EytzingerTree<Key, Compare, Allocator>::swap(
+    EytzingerTree &other) noexcept {
+  keys_.swap(other.keys_);
+  index_.swap(other.index_);
+  std::swap(size_, other.size_);
+  std::swap(compare_, other.compare_);
+}
+
+/**
+ * @brief Finds the storage position of a key.
+ * @param key Key to search for.
+ * @return Position of the key (see keyAt), or npos if it is absent.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename EytzingerTree<Key, Compare, Allocator>::size_type
+EytzingerTree<Key, Compare, Allocator>::find(const key_type &key) const {
+  size_type block = findBlock(key);
+  return block == npos ? npos : findInBlock(block, key);
+}
+
+/**
+ * @brief Returns the key stored at a position returned by find or passed to
+ * the callback of forEachPosition.
+ */
+template <typename Key, typename Compare, typename Allocator>
+const Key &EytzingerTree<Key, Compare, Allocator>::keyAt(
+    size_type position) const noexcept {
+  return keys_.data()[position];
+}
+
+/**
+ * @brief Calls fn(position) for the position of every key in key order.
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename Fn>
+void EytzingerTree<Key, Compare, Allocator>::forEachPosition(Fn &&fn) const {
+  size_type left = size_;
+  walkBlocks(blocks(), [&](size_type block) {
+    size_type count = left < kLeaf ? left : kLeaf;
+    for (size_type i = 0; i < count; ++i) {
+      fn(block * kLeaf + i);
+    }
+    left -= count;
+  });
+}
+
+/******************************************************************************
+ * SUPPORT METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Number of index entries that fill one cache line: the descendants
+ * of node k that many levels below are the entries stride * k ...
+ * stride * k + stride - 1, so one prefetch brings them all.
+ */
+template <typename Key, typename Compare, typename Allocator>
+constexpr typename EytzingerTree<Key, Compare, Allocator>::size_type
+EytzingerTree<Key, Compare, Allocator>::prefetchStride() noexcept {
+  size_type stride = 1;
+  while (stride * 2 * sizeof(Key) <= 64) {
+    stride *= 2;
+  }
+  return stride;
+}
+
+template <typename Key, typename Compare, typename Allocator>
+typename EytzingerTree<Key, Compare, Allocator>::size_type
+EytzingerTree<Key, Compare, Allocator>::blocks() const noexcept {
+  return index_.size();
+}
+
+/**
+ * @brief Descends the block index without branches.
+ * @return The first block in key order whose largest key is not less than
+ * key, or npos if there is none.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename EytzingerTree<Key, Compare, Allocator>::size_type
+EytzingerTree<Key, Compare, Allocator>::findBlock(
+    const key_type &key) const {
+  const Key *index = index_.data();
+  const size_type count = blocks();
+  // узлы нумеруются с единицы: потомки узла k - 2k и 2k + 1
+  size_type node = 1;
+  while (node <= count) {
+#if defined(__GNUC__)
+    size_type ahead = prefetchStride() * node;
+    if (ahead <= count) {
+      __builtin_prefetch(index + ahead - 1);
+    }
+#endif
+    node = 2 * node + static_cast<size_type>(compare_(index[node - 1], key));
+  }
+  // путь после нужного узла: один шаг налево и затем только направо,
+  // отбрасываем эти шаги вместе с завершающими единицами
+#if defined(__GNUC__)
+  node >>= __builtin_ctzll(~static_cast<unsigned long long>(node)) + 1;
+#else
+  while (node & 1) {
+    node >>= 1;
+  }
+  node >>= 1;
+#endif
+  return node == 0 ? npos : node - 1;
+}
+
+/**
+ * @brief Looks for a key in a block whose largest key is not less than it.
+ * @return Position of the key, or npos.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename EytzingerTree<Key, Compare, Allocator>::size_type
+EytzingerTree<Key, Compare, Allocator>::findInBlock(
+    size_type block, const key_type &key) const {
+  const Key *keys = keys_.data() + block * kLeaf;
+  if constexpr (kSimdBlock) {
+    size_type offset = matchBlock(keys, key);
+    return offset == npos ? npos : block * kLeaf + offset;
+  } else {
+    size_type offset = 0;
+    while (compare_(keys[offset], key)) {
+      ++offset; // наибольший ключ блока не меньше key
+    }
+    return compare_(key, keys[offset]) ? npos : block * kLeaf + offset;
+  }
+}
+
+/**
+ * @brief Compares every key of a block with key for equality: with SSE2
+ * 16 bytes at a time, otherwise key by key.
+ * @return Offset of the first equal key, or npos.
+ */
+template <typename Key, typename Compare, typename Allocator>
+typename EytzingerTree<Key, Compare, Allocator>::size_type
+EytzingerTree<Key, Compare, Allocator>::matchBlock(
+    const Key *block, const key_type &key) const noexcept {
+#if defined(__SSE2__)
+  constexpr size_type kLanes = 16 / sizeof(Key);
+  // маска первых байтов каждого ключа в 16-байтовой группе
+  constexpr std::uint32_t kFirstBytes =
+      sizeof(Key) == 1   ? 0xFFFFu
+      : sizeof(Key) == 2 ? 0x5555u
+      : sizeof(Key) == 4 ? 0x1111u
+                         : 0x0101u;
+  unsigned char pattern[16];
+  for (size_type lane = 0; lane < kLanes; ++lane) {
+    std::memcpy(pattern + lane * sizeof(Key), &key, sizeof(Key));
+  }
+  const __m128i needle =
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern));
+  const unsigned char *bytes = reinterpret_cast<const unsigned char *>(block);
+  for (size_type group = 0; group < kLeaf / kLanes; ++group) {
+    __m128i data =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + 16 * group));
+    auto mask = static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(data, needle)));
+    // ключ совпал, если совпали все его байты
+    for (size_type width = 1; width < sizeof(Key); width *= 2) {
+      mask &= mask >> width;
+    }
+    mask &= kFirstBytes;
+    if (mask != 0) {
+      return group * kLanes +
+             static_cast<size_type>(__builtin_ctz(mask)) / sizeof(Key);
+    }
+  }
+  return npos;
+#else
+  for (size_type offset = 0; offset < kLeaf; ++offset) {
+    if (block[offset] == key) {
+      return offset;
+    }
+  }
+  return npos;
+#endif
+}
+
+/**
+ * @brief Calls fn(block) for every block of a tree of count blocks in key
+ * order (in-order walk of the implicit tree).
+ */
+template <typename Key, typename Compare, typename Allocator>
+template <typename Fn>
+void EytzingerTree<Key, Compare, Allocator>::walkBlocks(size_type count,
+                                                        Fn &&fn) {
+  if (count == 0) {
+    return;
+  }
+  size_type node = 1;
+  while (2 * node <= count) {
+    node *= 2;
+  }
+  for (size_type visited = 0; visited < count; ++visited) {
+    fn(node - 1);
+    if (2 * node + 1 <= count) {
+      // следующий - самый левый узел правого поддерева
+      node = 2 * node + 1;
+      while (2 * node <= count) {
+        node *= 2;
+      }
+    } else {
+      // иначе - первый предок, в левом поддереве которого мы были
+      while (node & 1) {
+        node >>= 1;
+      }
+      node >>= 1;
+    }
+  }
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks that the keys are strictly increasing in key order, that
+ * every index entry is the largest key of its block and that the padding
+ * repeats the largest key.
+ */
+template <typename Key, typename Compare, typename Allocator>
+bool EytzingerTree<Key, Compare, Allocator>::checkInvariants() const {
+  if (keys_.size() != blocks() * kLeaf ||
+      size_ > keys_.size() || keys_.size() - size_ >= kLeaf + (size_ == 0)) {
+    return false;
+  }
+  const Key *keys = keys_.data();
+  const Key *prev = nullptr;
+  size_type left = size_;
+  bool ordered = true;
+  walkBlocks(blocks(), [&](size_type block) {
+    const Key *first = keys + block * kLeaf;
+    for (size_type i = 0; i < kLeaf; ++i) {
+      if (i < left) {
+        ordered = ordered && (!prev || compare_(*prev, first[i]));
+        prev = first + i;
+      } else {
+        ordered = ordered && !compare_(*prev, first[i]) &&
+                  !compare_(first[i], *prev);
+      }
+    }
+    const Key &largest = index_.data()[block];
+    ordered = ordered && !compare_(largest, first[kLeaf - 1]) &&
+              !compare_(first[kLeaf - 1], largest);
+    left -= left < kLeaf ? left : kLeaf;
+  });
+  return ordered;
+}
+
+} // namespace s21
@@ -0,0 +1,151 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file flat_tree.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-07-27
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_FLAT_TREE_H_
+#define CPP2_S21_CONTAINERS_FLAT_TREE_H_
+
+#include <algorithm> // std::lower_bound, std::stable_sort, std::inplace_merge
+#include <cstddef>
+#include <functional> // std::less
+#include <iterator>
+#include <memory> // std::allocator
+#include <stdexcept> // std::out_of_range
+#include <tuple>     // std::forward_as_tuple
+#include <type_traits>
+#include <utility> // std::pair, std::piecewise_construct
+
+#include "../MAIN_FUNCTIONS/s21_vector.h"
+#include "../s21_common.h" // RequireInputIter, Identity, SelectFirst
+
+namespace s21 {
+
+/**
+ * @brief Sorted array: the storage behind FlatSet, FlatMultiSet and FlatMap.
+ *
+ * Elements are kept in key order in one s21::vector, so the container adds
+ * nothing per element: its memory is the capacity of the vector. Lookups are
+ * binary searches over contiguous memory, order statistics are pointer
+ * arithmetic. An insertion or erasure in the middle shifts the tail, O(n),
+ * so a batch of elements should be added with insertRange(): the batch is
+ * appended, sorted and merged with the old elements once.
+ *
+ * Iterators are pointers into the vector. Every insertion may reallocate it
+ * and invalidates all iterators; an erasure invalidates the iterators from
+ * the erased position on. An element of the container must not be passed
+ * to its own insertion methods. Elements must be default-constructible and
+ * move-assignable, as s21::vector requires.
+ *
+ * @tparam Key Type of the keys.
+ * @tparam Value Type of the stored elements.
+ * @tparam KeyOfValue Function object returning the key of an element.
+ * @tparam Comparator Strict weak ordering of keys.
+ * @tparam Allocator Allocator of elements.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+class FlatTree {
+public:
+  using key_type = Key;
+  using value_type = Value;
+  using reference = Value &;
+  using const_reference = const Value &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using allocator_type = Allocator;
+  using storage_type = s21::vector<Value, Allocator>;
+  using iterator = Value *;
+  using const_iterator = const Value *;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  FlatTree() = default;
+  explicit FlatTree(const allocator_type &alloc);
+  FlatTree(const FlatTree &other) = default;
+  FlatTree(FlatTree &&other) noexcept = default;
+  ~FlatTree() = default;
+  FlatTree &operator=(const FlatTree &other) = default;
+  FlatTree &operator=(FlatTree &&other) noexcept = default;
+
+  allocator_type get_allocator() const noexcept;
+
+  // Main methods:
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  bool empty() const noexcept;
+  size_type capacity() const noexcept;
+  size_type memoryUsage() const noexcept;
+  void reserve(size_type count);
+  void shrinkToFit();
+  void clear() noexcept;
+  void swap(FlatTree &other) noexcept;
+
+  iterator begin() noexcept;
+  iterator end() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+
+  // Lookup:
+  template <typename K> iterator find(const K &key);
+  template <typename K> const_iterator find(const K &key) const;
+  template <typename K> iterator lower_bound(const K &key);
+  template <typename K> const_iterator lower_bound(const K &key) const;
+  template <typename K> iterator upper_bound(const K &key);
+  template <typename K> const_iterator upper_bound(const K &key) const;
+  template <typename K> size_type count(const K &key) const;
+
+  // Order statistics (O(log n) or O(1), the array is already in order):
+  template <typename K> size_type rank(const K &key) const;
+  size_type countRange(const Key &lo, const Key &hi) const;
+  iterator nth(size_type k) noexcept;
+  const_iterator nth(size_type k) const noexcept;
+  const_reference select(size_type k) const;
+
+  // Modifiers:
+  template <typename Arg>
+  std::pair<iterator, bool> insert(Arg &&value, bool unique);
+  template <typename Arg>
+  iterator insertHint(const_iterator hint, Arg &&value, bool unique);
+  template <typename InputIt>
+  void insertRange(InputIt first, InputIt last, bool unique);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(bool unique, Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> tryEmplace(const Key &key, Args &&...args);
+  iterator erase(const_iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  template <typename K> size_type eraseEqual(const K &key);
+  template <typename Pred> size_type eraseIf(Pred pred);
+  void merge(FlatTree &other, bool unique);
+
+  // Debugging methods:
+  bool checkInvariants(bool unique) const;
+
+private:
+  // Auxiliary methods:
+  bool valueLess(const Value &left, const Value &right) const;
+  template <typename Arg> iterator insertAt(iterator pos, Arg &&value);
+  void mergeTail(size_type old_size, bool unique);
+  iterator makeMutable(const_iterator it) noexcept;
+
+  storage_type data_;
+  Comparator comparator_;
+  KeyOfValue key_of_;
+};
+
+} // namespace s21
+
+#include "flat_tree.tpp"
+
+#endif // CPP2_S21_CONTAINERS_FLAT_TREE_H_
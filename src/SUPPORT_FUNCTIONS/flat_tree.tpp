@@ -0,0 +1,726 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file flat_tree.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-07-27
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#include "flat_tree.h"
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTORS
+ ******************************************************************************/
+
+/**
+ * @brief Creates an empty array that takes memory from alloc.
+ *
+ * @param alloc The allocator of elements.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::FlatTree(
+    const allocator_type &alloc)
+    : data_(alloc) {}
+
+/**
+ * @brief Returns a copy of the allocator of elements.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator,
+                  Allocator>::allocator_type
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::get_allocator()
+    const noexcept {
+  return data_.get_allocator();
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::size()
+    const noexcept {
+  return data_.size();
+}
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::max_size()
+    const noexcept {
+  return data_.max_size();
+}
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+bool FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::empty()
+    const noexcept {
+  return data_.empty();
+}
+
+/**
+ * @brief Returns the number of elements the array holds without
+ * reallocation.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::capacity()
+    const noexcept {
+  return data_.capacity();
+}
+
+/**
+ * @brief Returns the number of bytes of the element array.
+ *
+ * There is nothing else to count: no nodes, links or per-element headers.
+ * The free slots up to capacity() are included, the allocator overhead is
+ * not.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::memoryUsage()
+    const noexcept {
+  return data_.capacity() * sizeof(Value);
+}
+
+/**
+ * @brief Makes room for count elements, so that inserting up to count
+ * elements does not reallocate.
+ *
+ * @param count The number of elements.
+ *
+ * @throws std::bad_alloc, anything thrown by the element constructor
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::reserve(
+    size_type count) {
+  data_.reserve(count);
+}
+
+/**
+ * @brief Returns the free slots of the array to the allocator.
+ *
+ * @throws std::bad_alloc, anything thrown by the element constructor
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::shrinkToFit() {
+  if (data_.size() == data_.capacity()) {
+    return; // вектор сообщил бы в std::cerr, что сжимать нечего
+  }
+  if (data_.empty()) {
+    data_ = storage_type(data_.get_allocator()); // пустой вектор не сжимается
+  } else {
+    data_.shrink_to_fit();
+  }
+}
+
+/**
+ * @brief Removes all elements; the capacity stays.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::clear() noexcept {
+  data_.clear();
+}
+
+/**
+ * @brief Exchanges the elements and the comparators with other.
+ *
+ * @param other The other array.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::swap(
+    FlatTree &other) noexcept {
+  data_.swap(other.data_);
+  std::swap(comparator_, other.comparator_);
+}
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::begin() noexcept {
+  return data_.begin();
+}
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::end() noexcept {
+  return data_.end();
+}
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator,
+                  Allocator>::const_iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::begin()
+    const noexcept {
+  return data_.begin();
+}
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator,
+                  Allocator>::const_iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::end()
+    const noexcept {
+  return data_.end();
+}
+
+/******************************************************************************
+ * LOOKUP
+ ******************************************************************************/
+
+/**
+ * @brief Finds an element with a key equivalent to key, O(log n).
+ *
+ * @param key The key to look for.
+ *
+ * @return iterator The first such element, or end().
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::find(const K &key) {
+  return makeMutable(static_cast<const FlatTree *>(this)->find(key));
+}
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename FlatTree<Key, Value, KeyOfValue, Comparator,
+                  Allocator>::const_iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::find(
+    const K &key) const {
+  const_iterator it = lower_bound(key);
+  if (it != end() && !comparator_(key, key_of_(*it))) {
+    return it;
+  }
+  return end();
+}
+
+/**
+ * @brief Returns the first element whose key is not less than key,
+ * O(log n).
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::lower_bound(
+    const K &key) {
+  return makeMutable(static_cast<const FlatTree *>(this)->lower_bound(key));
+}
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename FlatTree<Key, Value, KeyOfValue, Comparator,
+                  Allocator>::const_iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::lower_bound(
+    const K &key) const {
+  return std::lower_bound(begin(), end(), key,
+                          [this](const Value &value, const K &k) {
+                            return comparator_(key_of_(value), k);
+                          });
+}
+
+/**
+ * @brief Returns the first element whose key is greater than key,
+ * O(log n).
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::upper_bound(
+    const K &key) {
+  return makeMutable(static_cast<const FlatTree *>(this)->upper_bound(key));
+}
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename FlatTree<Key, Value, KeyOfValue, Comparator,
+                  Allocator>::const_iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::upper_bound(
+    const K &key) const {
+  return std::upper_bound(begin(), end(), key,
+                          [this](const K &k, const Value &value) {
+                            return comparator_(k, key_of_(value));
+                          });
+}
+
+/**
+ * @brief Returns the number of elements with a key equivalent to key,
+ * O(log n).
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::count(
+    const K &key) const {
+  return static_cast<size_type>(upper_bound(key) - lower_bound(key));
+}
+
+/******************************************************************************
+ * ORDER STATISTICS
+ ******************************************************************************/
+
+/**
+ * @brief Returns the number of elements whose key is less than key.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::rank(
+    const K &key) const {
+  return static_cast<size_type>(lower_bound(key) - begin());
+}
+
+/**
+ * @brief Returns the number of elements with keys in [lo, hi).
+ *
+ * @return size_type The number of elements, 0 if hi is not greater than lo.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::countRange(
+    const Key &lo, const Key &hi) const {
+  if (!comparator_(lo, hi)) {
+    return 0;
+  }
+  return static_cast<size_type>(lower_bound(hi) - lower_bound(lo));
+}
+
+/**
+ * @brief Returns the element at position k in key order, O(1).
+ *
+ * @return iterator The element, end() if k >= size().
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::nth(
+    size_type k) noexcept {
+  return k < size() ? begin() + k : end();
+}
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator,
+                  Allocator>::const_iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::nth(
+    size_type k) const noexcept {
+  return k < size() ? begin() + k : end();
+}
+
+/**
+ * @brief Returns the element at position k in key order, O(1).
+ *
+ * @throws std::out_of_range if k >= size()
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator,
+                  Allocator>::const_reference
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::select(
+    size_type k) const {
+  if (k >= size()) {
+    throw std::out_of_range("Index out of range");
+  }
+  return begin()[k];
+}
+
+/******************************************************************************
+ * INSERTION
+ ******************************************************************************/
+
+/**
+ * @brief Inserts a copy of (or moves) value, O(log n) to find the place
+ * and O(n) to shift the tail.
+ *
+ * An element equivalent to existing ones goes after them.
+ *
+ * @tparam Arg Value or a reference to it.
+ * @param value The element.
+ * @param unique If true, nothing is inserted when an equivalent key exists.
+ *
+ * @return std::pair<iterator, bool> The inserted or the existing element,
+ * and whether the insertion took place.
+ *
+ * @throws std::bad_alloc, anything thrown by the comparator or by the
+ * element constructor
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename Arg>
+std::pair<typename FlatTree<Key, Value, KeyOfValue, Comparator,
+                            Allocator>::iterator,
+          bool>
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::insert(Arg &&value,
+                                                               bool unique) {
+  const Key &key = key_of_(value);
+  iterator pos = unique ? lower_bound(key) : upper_bound(key);
+  if (unique && pos != end() && !comparator_(key, key_of_(*pos))) {
+    return {pos, false};
+  }
+  return {insertAt(pos, std::forward<Arg>(value)), true};
+}
+
+/**
+ * @brief Inserts value right before hint if that keeps the order, without
+ * a binary search.
+ *
+ * Otherwise the element is inserted as by insert().
+ *
+ * @param hint Position before which value should be inserted.
+ * @param value The element.
+ * @param unique If true, nothing is inserted when an equivalent key exists.
+ *
+ * @return iterator The inserted element or the equivalent existing one.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename Arg>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::insertHint(
+    const_iterator hint, Arg &&value, bool unique) {
+  const Key &key = key_of_(value);
+  iterator pos = makeMutable(hint);
+  bool fits = false;
+  if (unique) {
+    fits = (pos == begin() || comparator_(key_of_(pos[-1]), key)) &&
+           (pos == end() || comparator_(key, key_of_(*pos)));
+  } else {
+    fits = (pos == begin() || !comparator_(key, key_of_(pos[-1]))) &&
+           (pos == end() || !comparator_(key_of_(*pos), key));
+  }
+  if (fits) {
+    return insertAt(pos, std::forward<Arg>(value));
+  }
+  return insert(std::forward<Arg>(value), unique).first;
+}
+
+/**
+ * @brief Inserts the elements of [first, last) with one sort and merge.
+ *
+ * The elements are appended to the array, the appended part is sorted
+ * (skipped if it already is), merged with the old elements (skipped if it
+ * goes after them) and, for unique keys, the duplicates are dropped: of
+ * equivalent elements the one already present, or else the first one in
+ * the range, is kept. That is O(n + k log k) for k new elements instead of
+ * O(n k) for k separate insertions, and O(n + k) for a sorted range.
+ *
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @param unique If true, equivalent keys are stored once.
+ *
+ * @throws std::bad_alloc, anything thrown by the comparator or by the
+ * element constructor; if the sort or the merge throws, the array is
+ * cleared
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename InputIt>
+void FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::insertRange(
+    InputIt first, InputIt last, bool unique) {
+  using category = typename std::iterator_traits<InputIt>::iterator_category;
+  size_type old_size = size();
+  // длина известна сразу только у random access: обход дерева ради
+  // std::distance стоил бы столько же, сколько само копирование
+  if constexpr (std::is_base_of<std::random_access_iterator_tag,
+                                category>::value) {
+    reserve(old_size + static_cast<size_type>(last - first));
+  }
+  try {
+    for (; first != last; ++first) {
+      data_.push_back(Value(*first));
+    }
+  } catch (...) {
+    data_.erase(begin() + old_size, end()); // старые элементы не тронуты
+    throw;
+  }
+  mergeTail(old_size, unique);
+}
+
+/**
+ * @brief Builds an element from args and inserts it.
+ *
+ * @return std::pair<iterator, bool> Same as insert().
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename... Args>
+std::pair<typename FlatTree<Key, Value, KeyOfValue, Comparator,
+                            Allocator>::iterator,
+          bool>
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::emplace(
+    bool unique, Args &&...args) {
+  return insert(Value(std::forward<Args>(args)...), unique);
+}
+
+/**
+ * @brief Inserts an element built from key and args if key is absent.
+ *
+ * Used by FlatMap: Value is a pair, its second member is built from args.
+ * Nothing is constructed when the key exists.
+ *
+ * @return std::pair<iterator, bool> Same as insert() with unique keys.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename... Args>
+std::pair<typename FlatTree<Key, Value, KeyOfValue, Comparator,
+                            Allocator>::iterator,
+          bool>
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::tryEmplace(
+    const Key &key, Args &&...args) {
+  iterator pos = lower_bound(key);
+  if (pos != end() && !comparator_(key, key_of_(*pos))) {
+    return {pos, false};
+  }
+  return {insertAt(pos, Value(std::piecewise_construct,
+                              std::forward_as_tuple(key),
+                              std::forward_as_tuple(
+                                  std::forward<Args>(args)...))),
+          true};
+}
+
+/******************************************************************************
+ * ERASURE
+ ******************************************************************************/
+
+/**
+ * @brief Erases the element at pos, O(n) to shift the tail.
+ *
+ * @return iterator The element that followed the erased one.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::erase(
+    const_iterator pos) {
+  return erase(pos, pos + 1);
+}
+
+/**
+ * @brief Erases the elements of [first, last) with one shift of the tail.
+ *
+ * @return iterator The element that followed the erased range.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::erase(
+    const_iterator first, const_iterator last) {
+  return data_.erase(makeMutable(first), makeMutable(last));
+}
+
+/**
+ * @brief Erases the elements with a key equivalent to key.
+ *
+ * @return size_type The number of erased elements.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename K>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::eraseEqual(
+    const K &key) {
+  iterator first = lower_bound(key);
+  iterator last = upper_bound(key);
+  erase(first, last);
+  return static_cast<size_type>(last - first);
+}
+
+/**
+ * @brief Erases the elements for which pred returns true, in one pass.
+ *
+ * The kept elements are moved to the front in order, so the array stays
+ * sorted.
+ *
+ * @return size_type The number of erased elements.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename Pred>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::size_type
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::eraseIf(Pred pred) {
+  iterator kept_end = std::remove_if(begin(), end(), [&pred](Value &value) {
+    return pred(static_cast<const Value &>(value));
+  });
+  size_type erased = static_cast<size_type>(end() - kept_end);
+  erase(kept_end, end());
+  return erased;
+}
+
+/**
+ * @brief Moves the elements of other into this array in one merge pass,
+ * O(n + m).
+ *
+ * With unique keys, the elements of other whose keys are already present
+ * stay in other.
+ *
+ * @param other The array to take the elements from.
+ * @param unique If true, equivalent keys are stored once.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::merge(
+    FlatTree &other, bool unique) {
+  if (this == &other || other.empty()) {
+    return;
+  }
+  if (!unique) {
+    size_type old_size = size();
+    reserve(old_size + other.size());
+    for (Value &value : other.data_) {
+      data_.push_back(std::move(value));
+    }
+    other.clear();
+    mergeTail(old_size, false);
+    return;
+  }
+
+  // память берётся заранее: при переносе push_back не выделяет её
+  storage_type merged(data_.get_allocator());
+  storage_type rest(other.data_.get_allocator());
+  merged.reserve(size() + other.size());
+  rest.reserve(other.size());
+  iterator left = begin();
+  for (Value &value : other.data_) {
+    while (left != end() && valueLess(*left, value)) {
+      merged.push_back(std::move(*left++));
+    }
+    if (left != end() && !valueLess(value, *left)) {
+      rest.push_back(std::move(value)); // такой ключ уже есть
+    } else {
+      merged.push_back(std::move(value));
+    }
+  }
+  for (; left != end(); ++left) {
+    merged.push_back(std::move(*left));
+  }
+  data_ = std::move(merged);
+  other.data_ = std::move(rest);
+}
+
+/******************************************************************************
+ * DEBUGGING
+ ******************************************************************************/
+
+/**
+ * @brief Checks that the elements are in key order.
+ *
+ * @param unique If true, equivalent neighbours are an error as well.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+bool FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::checkInvariants(
+    bool unique) const {
+  for (const_iterator it = begin(); it != end() && it + 1 != end(); ++it) {
+    if (unique ? !valueLess(it[0], it[1]) : valueLess(it[1], it[0])) {
+      return false;
+    }
+  }
+  return data_.size() <= data_.capacity();
+}
+
+/******************************************************************************
+ * AUXILIARY METHODS
+ ******************************************************************************/
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+bool FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::valueLess(
+    const Value &left, const Value &right) const {
+  return comparator_(key_of_(left), key_of_(right));
+}
+
+/**
+ * @brief Puts value into the array before pos.
+ *
+ * An argument of the element type goes to the vector as it is, anything
+ * else (for example, a pair with a constant key) is converted first.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+template <typename Arg>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::insertAt(
+    iterator pos, Arg &&value) {
+  if constexpr (std::is_same<typename std::decay<Arg>::type, Value>::value) {
+    return data_.insert(pos, std::forward<Arg>(value));
+  } else {
+    return data_.insert(pos, Value(std::forward<Arg>(value)));
+  }
+}
+
+/**
+ * @brief Restores the order after elements were appended to a sorted
+ * array.
+ *
+ * @param old_size The number of elements that were there before, sorted.
+ * @param unique If true, equivalent neighbours are dropped after the merge.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+void FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::mergeTail(
+    size_type old_size, bool unique) {
+  auto less = [this](const Value &left, const Value &right) {
+    return valueLess(left, right);
+  };
+  iterator middle = begin() + old_size;
+  try {
+    // stable: из равных новых элементов первым остаётся первый по порядку
+    if (!std::is_sorted(middle, end(), less)) {
+      std::stable_sort(middle, end(), less);
+    }
+    if (middle != begin() && middle != end() && less(*middle, middle[-1])) {
+      std::inplace_merge(begin(), middle, end(), less);
+    }
+    if (unique) {
+      iterator kept_end =
+          std::unique(begin(), end(), [&less](const Value &a, const Value &b) {
+            return !less(a, b);
+          });
+      erase(kept_end, end());
+    }
+  } catch (...) {
+    clear(); // порядок мог нарушиться на середине сортировки
+    throw;
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Comparator, typename Allocator>
+typename FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::iterator
+FlatTree<Key, Value, KeyOfValue, Comparator, Allocator>::makeMutable(
+    const_iterator it) noexcept {
+  return begin() + (it - data_.begin());
+}
+
+} // namespace s21
@@ -0,0 +1,357 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file hash_table.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-03
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_HASH_TABLE_H_
+#define CPP2_S21_CONTAINERS_HASH_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy, std::memset для управляющих байтов
+#include <functional> // std::hash, std::equal_to
+#include <initializer_list>
+#include <iterator>
+#include <memory> // std::allocator_traits
+#include <new>
+#include <stdexcept> // std::out_of_range, std::length_error
+#include <tuple>     // std::forward_as_tuple
+#include <type_traits>
+#include <utility> // std::pair
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "../s21_common.h" // RequireInputIter, Identity, SelectFirst
+
+namespace s21 {
+
+template <typename Hash, typename KeyEqual, typename = void>
+struct HashIsTransparent : std::false_type {};
+
+template <typename Hash, typename KeyEqual>
+struct HashIsTransparent<Hash, KeyEqual,
+                         std::void_t<typename Hash::is_transparent,
+                                     typename KeyEqual::is_transparent>>
+    : std::true_type {};
+
+// Поиск по ключу другого типа - только если и хеш, и сравнение прозрачные
+// (как в std::unordered_map C++20): иначе хеш K и хеш Key могут не совпасть
+template <typename Hash, typename KeyEqual>
+using RequireTransparentHash = typename std::enable_if<
+    HashIsTransparent<Hash, KeyEqual>::value>::type;
+
+/**
+ * @brief kWidth control bytes of a hash table compared at once.
+ *
+ * A control byte is kEmpty, kDeleted (a tombstone left by erasure) or, for
+ * an occupied slot, the low 7 bits of the hash of its key (0..127). The
+ * group is compared with SSE2 instructions, on other targets byte by byte.
+ * Every match method returns a mask whose bit i is set if byte i of the
+ * group satisfies the condition.
+ */
+class HashGroup {
+public:
+  static constexpr std::size_t kWidth = 16;
+  static constexpr signed char kEmpty = -128;
+  static constexpr signed char kDeleted = -2;
+
+  explicit HashGroup(const signed char *ctrl) noexcept {
+#if defined(__SSE2__)
+    ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+#else
+    std::memcpy(ctrl_, ctrl, kWidth);
+#endif
+  }
+
+  // занятые ячейки, у которых те же 7 бит хеша
+  std::uint32_t match(signed char h2) const noexcept {
+#if defined(__SSE2__)
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_)));
+#else
+    return matchIf([h2](signed char c) { return c == h2; });
+#endif
+  }
+
+  std::uint32_t matchEmpty() const noexcept {
+#if defined(__SSE2__)
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(kEmpty), ctrl_)));
+#else
+    return matchIf([](signed char c) { return c == kEmpty; });
+#endif
+  }
+
+  std::uint32_t matchEmptyOrDeleted() const noexcept {
+#if defined(__SSE2__)
+    // kEmpty и kDeleted - единственные значения меньше -1
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl_)));
+#else
+    return matchIf([](signed char c) { return c < -1; });
+#endif
+  }
+
+  std::uint32_t matchFull() const noexcept {
+#if defined(__SSE2__)
+    // у занятой ячейки старший бит сброшен
+    return static_cast<std::uint32_t>(~_mm_movemask_epi8(ctrl_)) & 0xFFFFu;
+#else
+    return matchIf([](signed char c) { return c >= 0; });
+#endif
+  }
+
+  // номер младшего установленного бита, mask != 0
+  static std::size_t trailingZeros(std::uint32_t mask) noexcept {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctz(mask));
+#else
+    std::size_t bits = 0;
+    for (; (mask & 1u) == 0; mask >>= 1) ++bits;
+    return bits;
+#endif
+  }
+
+  // число нулевых старших битов из kWidth младших, mask != 0
+  static std::size_t leadingZeros(std::uint32_t mask) noexcept {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_clz(mask)) - (32 - kWidth);
+#else
+    std::size_t bits = 0;
+    for (std::uint32_t bit = 1u << (kWidth - 1); (mask & bit) == 0;
+         bit >>= 1) {
+      ++bits;
+    }
+    return bits;
+#endif
+  }
+
+private:
+#if defined(__SSE2__)
+  __m128i ctrl_;
+#else
+  template <typename Pred>
+  std::uint32_t matchIf(Pred pred) const noexcept {
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<std::uint32_t>(pred(ctrl_[i])) << i;
+    }
+    return mask;
+  }
+
+  signed char ctrl_[kWidth];
+#endif
+};
+
+template <typename Table, bool IsConst> class HashTableIterator;
+
+/**
+ * @brief Hash table with open addressing: the storage behind UnorderedSet
+ * and UnorderedMap.
+ *
+ * Elements are stored directly in one array of slots whose size is a power
+ * of two, next to a parallel array of one-byte control codes (see
+ * HashGroup). The hash of a key is split in two: the high bits give the
+ * slot where probing starts, the low 7 bits are stored in the control byte.
+ * A lookup loads 16 control bytes at once, compares them with the 7 bits in
+ * one instruction and compares keys only for the matching slots, so a miss
+ * usually costs no key comparison at all. Groups are probed quadratically
+ * until a group with an empty slot is found.
+ *
+ * At most 7/8 of the slots are occupied or tombstones; the table is rebuilt
+ * when an insertion would exceed that. Erasure leaves a tombstone only if
+ * the slot lies in a run of 16 non-empty slots, otherwise the slot becomes
+ * empty again. The first 16 control bytes are repeated after the last one,
+ * so a group may start at any slot.
+ *
+ * Elements do not move on erasure, but every insertion may rebuild the
+ * table and invalidate all iterators and references.
+ *
+ * @tparam Key Type of the keys.
+ * @tparam Value Type of the stored elements.
+ * @tparam KeyOfValue Function object returning the key of an element.
+ * @tparam Hash Hash function of keys.
+ * @tparam KeyEqual Equality of keys.
+ * @tparam Allocator Allocator of elements, rebound to the control bytes.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+class HashTable {
+public:
+  using key_type = Key;
+  using value_type = Value;
+  using reference = Value &;
+  using const_reference = const Value &;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using hasher = Hash;
+  using key_equal = KeyEqual;
+  using allocator_type = Allocator;
+  using iterator = HashTableIterator<HashTable, false>;
+  using const_iterator = HashTableIterator<HashTable, true>;
+
+  static constexpr size_type kGroupWidth = HashGroup::kWidth;
+
+  HashTable();
+  explicit HashTable(const allocator_type &alloc);
+  HashTable(const Hash &hash, const KeyEqual &equal,
+            const allocator_type &alloc);
+  HashTable(const HashTable &other);
+  HashTable(HashTable &&other) noexcept;
+  ~HashTable();
+  HashTable &operator=(const HashTable &other);
+  HashTable &operator=(HashTable &&other) noexcept;
+
+  allocator_type get_allocator() const noexcept;
+  hasher hash_function() const;
+  key_equal key_eq() const;
+
+  // Main methods:
+  size_type size() const noexcept;
+  size_type max_size() const noexcept;
+  bool empty() const noexcept;
+  size_type capacity() const noexcept;
+  float loadFactor() const noexcept;
+  size_type memoryUsage() const noexcept;
+  void reserve(size_type count);
+  void clear() noexcept;
+  void swap(HashTable &other) noexcept;
+
+  iterator begin() noexcept;
+  iterator end() noexcept;
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+
+  // Lookup:
+  template <typename K> iterator find(const K &key);
+  template <typename K> const_iterator find(const K &key) const;
+
+  // Modifiers:
+  template <typename Arg> std::pair<iterator, bool> insert(Arg &&value);
+  template <typename... Args> std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> tryEmplace(const Key &key, Args &&...args);
+  iterator erase(const_iterator pos) noexcept;
+  iterator erase(const_iterator first, const_iterator last) noexcept;
+  template <typename K> size_type eraseKey(const K &key);
+  template <typename Pred> size_type eraseIf(Pred pred);
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  using ctrl_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<signed char>;
+  using slot_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Value>;
+
+  // Auxiliary hashing methods:
+  template <typename K> std::size_t hashOf(const K &key) const;
+  static size_type probeStart(std::size_t hash, size_type mask) noexcept;
+  static signed char controlOf(std::size_t hash) noexcept;
+  static size_type maxLoad(size_type capacity) noexcept;
+
+  // Auxiliary search methods:
+  template <typename K>
+  size_type findIndex(const K &key, std::size_t hash) const;
+  static size_type findFree(const signed char *ctrl, size_type capacity,
+                            std::size_t hash) noexcept;
+  iterator iteratorAt(size_type index) const noexcept;
+
+  // Auxiliary modification methods:
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> insertKey(const K &key, Args &&...args);
+  size_type prepareInsert(std::size_t hash);
+  void resize(size_type new_capacity);
+  void eraseAt(size_type index) noexcept;
+  static void setCtrl(signed char *ctrl, size_type capacity, size_type index,
+                      signed char value) noexcept;
+
+  // Auxiliary memory methods:
+  void allocate(size_type capacity, signed char *&ctrl, Value *&slots);
+  void deallocate(signed char *ctrl, Value *slots,
+                  size_type capacity) noexcept;
+  void destroyElements() noexcept;
+  void release() noexcept;
+  void copyFrom(const HashTable &other);
+
+  signed char *ctrl_ = nullptr; // capacity_ + kGroupWidth байтов
+  Value *slots_ = nullptr;
+  size_type capacity_ = 0; // 0 или степень двойки не меньше kGroupWidth
+  size_type size_ = 0;
+  size_type growth_left_ = 0; // вставок в пустые ячейки до перестройки
+  Hash hash_;
+  KeyEqual equal_;
+  KeyOfValue key_of_;
+  allocator_type alloc_;
+};
+
+/**
+ * @brief Forward iterator of HashTable: a control byte and its slot.
+ *
+ * Any position other than end() is an occupied slot; end() is the control
+ * byte past the last slot.
+ */
+template <typename Table, bool IsConst> class HashTableIterator {
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type =
+      typename std::conditional<IsConst, const typename Table::value_type,
+                                typename Table::value_type>::type;
+  using pointer = value_type *;
+  using reference = value_type &;
+  using difference_type = std::ptrdiff_t;
+  using slot_type = typename Table::value_type;
+
+  HashTableIterator() noexcept = default;
+  HashTableIterator(const signed char *ctrl, slot_type *slot,
+                    const signed char *end) noexcept
+      : ctrl_(ctrl), slot_(slot), end_(end) {}
+  template <bool C = IsConst, typename = typename std::enable_if<C>::type>
+  HashTableIterator(const HashTableIterator<Table, false> &other) noexcept
+      : ctrl_(other.ctrl()), slot_(other.slot()),
+        end_(other.end()) {} // iterator -> const_iterator
+
+  reference operator*() const noexcept { return *slot_; }
+  pointer operator->() const noexcept { return slot_; }
+
+  HashTableIterator &operator++() noexcept;
+  HashTableIterator operator++(int) noexcept;
+
+  bool operator==(const HashTableIterator &other) const noexcept {
+    return ctrl_ == other.ctrl_;
+  }
+  bool operator!=(const HashTableIterator &other) const noexcept {
+    return !(*this == other);
+  }
+
+  // пропускает пустые ячейки и надгробия до занятой ячейки или end()
+  void skipFree() noexcept;
+
+  const signed char *ctrl() const noexcept { return ctrl_; }
+  slot_type *slot() const noexcept { return slot_; }
+  const signed char *end() const noexcept { return end_; }
+
+private:
+  const signed char *ctrl_ = nullptr;
+  slot_type *slot_ = nullptr;
+  const signed char *end_ = nullptr;
+};
+
+} //  namespace s21
+
+#include "hash_table.tpp" // Подключаем файл с определениями шаблонов
+
+#endif // CPP2_S21_CONTAINERS_HASH_TABLE_H_
@@ -0,0 +1,999 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file hash_table.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-03
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#include "hash_table.h"
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTORS & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Creates an empty table with a default-constructed allocator.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::HashTable()
+    : HashTable(allocator_type()) {}
+
+/**
+ * @brief Creates an empty table that allocates its arrays with alloc.
+ *
+ * @param alloc The allocator. No memory is allocated until the first
+ * insertion.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::HashTable(
+    const allocator_type &alloc)
+    : alloc_(alloc) {}
+
+/**
+ * @brief Creates an empty table with the given hash function and equality.
+ *
+ * @param hash The hash function.
+ * @param equal The equality of keys.
+ * @param alloc The allocator.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::HashTable(
+    const Hash &hash, const KeyEqual &equal, const allocator_type &alloc)
+    : hash_(hash), equal_(equal), alloc_(alloc) {}
+
+/**
+ * @brief Copies other slot by slot: the copy has the same capacity and the
+ * elements in the same slots, nothing is hashed again.
+ *
+ * @param other The table to copy.
+ *
+ * @throws std::bad_alloc, anything thrown by the element copy constructor
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::HashTable(
+    const HashTable &other)
+    : hash_(other.hash_), equal_(other.equal_), key_of_(other.key_of_),
+      alloc_(std::allocator_traits<Allocator>::
+                 select_on_container_copy_construction(other.alloc_)) {
+  copyFrom(other);
+}
+
+/**
+ * @brief Takes over the arrays of other, which is left empty.
+ *
+ * @param other The table to move from.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::HashTable(
+    HashTable &&other) noexcept
+    : ctrl_(other.ctrl_), slots_(other.slots_), capacity_(other.capacity_),
+      size_(other.size_), growth_left_(other.growth_left_),
+      hash_(other.hash_), equal_(other.equal_), key_of_(other.key_of_),
+      alloc_(other.alloc_) {
+  other.ctrl_ = nullptr;
+  other.slots_ = nullptr;
+  other.capacity_ = other.size_ = other.growth_left_ = 0;
+}
+
+/**
+ * @brief Destroys all elements and frees the arrays.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::~HashTable() {
+  release();
+}
+
+/**
+ * @brief Replaces the contents with a copy of other.
+ *
+ * @param other The table to copy.
+ * @return HashTable& This table.
+ *
+ * @throws std::bad_alloc, anything thrown by the element copy constructor;
+ * the table is left empty then
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator> &
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::operator=(
+    const HashTable &other) {
+  if (this != &other) {
+    release();
+    hash_ = other.hash_;
+    equal_ = other.equal_;
+    key_of_ = other.key_of_;
+    copyFrom(other);
+  }
+  return *this;
+}
+
+/**
+ * @brief Replaces the contents with the arrays of other.
+ *
+ * @param other The table to move from, left empty.
+ * @return HashTable& This table.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator> &
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::operator=(
+    HashTable &&other) noexcept {
+  if (this != &other) {
+    HashTable moved(std::move(other));
+    swap(moved);
+  }
+  return *this;
+}
+
+/**
+ * @brief Returns a copy of the allocator.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual,
+                   Allocator>::allocator_type
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::get_allocator()
+    const noexcept {
+  return alloc_;
+}
+
+/**
+ * @brief Returns a copy of the hash function.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::hasher
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::hash_function()
+    const {
+  return hash_;
+}
+
+/**
+ * @brief Returns a copy of the equality of keys.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual,
+                   Allocator>::key_equal
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::key_eq() const {
+  return equal_;
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Returns the number of elements.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::size()
+    const noexcept {
+  return size_;
+}
+
+/**
+ * @brief Returns the maximum possible number of elements.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::max_size()
+    const noexcept {
+  slot_allocator alloc(alloc_);
+  return maxLoad(std::allocator_traits<slot_allocator>::max_size(alloc) / 2);
+}
+
+/**
+ * @brief Checks whether the table is empty.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+bool HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::empty()
+    const noexcept {
+  return size_ == 0;
+}
+
+/**
+ * @brief Returns the number of slots (0 before the first insertion).
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::capacity()
+    const noexcept {
+  return capacity_;
+}
+
+/**
+ * @brief Returns the share of occupied slots.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+float HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::loadFactor()
+    const noexcept {
+  return capacity_ == 0 ? 0.0f
+                        : static_cast<float>(size_) /
+                              static_cast<float>(capacity_);
+}
+
+/**
+ * @brief Returns the number of bytes of the slot and control arrays.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::memoryUsage()
+    const noexcept {
+  return capacity_ == 0
+             ? 0
+             : capacity_ * sizeof(Value) + capacity_ + kGroupWidth;
+}
+
+/**
+ * @brief Makes room for count elements, so that inserting up to count
+ * elements does not rebuild the table.
+ *
+ * @param count The number of elements.
+ *
+ * @throws std::length_error if count exceeds max_size(), std::bad_alloc,
+ * anything thrown by the hash function or the element move constructor
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::reserve(
+    size_type count) {
+  if (count <= size_ + growth_left_) {
+    return;
+  }
+  if (count > max_size()) {
+    throw std::length_error("HashTable::reserve: count exceeds max_size()");
+  }
+  size_type new_capacity = kGroupWidth;
+  while (maxLoad(new_capacity) < count) {
+    new_capacity *= 2;
+  }
+  resize(new_capacity);
+}
+
+/**
+ * @brief Destroys all elements; the slots stay allocated.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::clear()
+    noexcept {
+  if (capacity_ == 0) {
+    return;
+  }
+  destroyElements();
+  std::memset(ctrl_, HashGroup::kEmpty, capacity_ + kGroupWidth);
+  size_ = 0;
+  growth_left_ = maxLoad(capacity_);
+}
+
+/**
+ * @brief Swaps the contents, the function objects and the allocators of two
+ * tables.
+ *
+ * @param other The table to swap with.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::swap(
+    HashTable &other) noexcept {
+  std::swap(ctrl_, other.ctrl_);
+  std::swap(slots_, other.slots_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(size_, other.size_);
+  std::swap(growth_left_, other.growth_left_);
+  std::swap(hash_, other.hash_);
+  std::swap(equal_, other.equal_);
+  std::swap(key_of_, other.key_of_);
+  std::swap(alloc_, other.alloc_);
+}
+
+/**
+ * @brief Returns an iterator to the first occupied slot.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::iterator
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::begin() noexcept {
+  iterator it(ctrl_, slots_, ctrl_ + capacity_);
+  it.skipFree();
+  return it;
+}
+
+/**
+ * @brief Returns the iterator past the last slot, O(1).
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::iterator
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::end() noexcept {
+  return iteratorAt(capacity_);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual,
+                   Allocator>::const_iterator
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::begin()
+    const noexcept {
+  return const_cast<HashTable *>(this)->begin();
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual,
+                   Allocator>::const_iterator
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::end()
+    const noexcept {
+  return iteratorAt(capacity_);
+}
+
+/******************************************************************************
+ * LOOKUP
+ ******************************************************************************/
+
+/**
+ * @brief Finds the element with a key equal to key, O(1) on average.
+ *
+ * @param key The key to look for (of another type only with a transparent
+ * hash and equality).
+ *
+ * @return iterator The element, or end().
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename K>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::iterator
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::find(
+    const K &key) {
+  if (size_ == 0) {
+    return end(); // пустая таблица: хеш не считаем
+  }
+  return iteratorAt(findIndex(key, hashOf(key)));
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename K>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual,
+                   Allocator>::const_iterator
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::find(
+    const K &key) const {
+  return const_cast<HashTable *>(this)->find(key);
+}
+
+/******************************************************************************
+ * MODIFIERS
+ ******************************************************************************/
+
+/**
+ * @brief Inserts value if no element has an equal key.
+ *
+ * @param value The element to copy or move.
+ *
+ * @return std::pair<iterator, bool> The inserted or the existing element,
+ * and whether the insertion took place.
+ *
+ * @throws std::bad_alloc, anything thrown by the hash function or the
+ * element constructor; the elements are not changed then
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Arg>
+std::pair<typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual,
+                             Allocator>::iterator,
+          bool>
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::insert(
+    Arg &&value) {
+  return insertKey(key_of_(value), std::forward<Arg>(value));
+}
+
+/**
+ * @brief Builds an element from args and inserts it if no element has an
+ * equal key.
+ *
+ * @param args Arguments of the element constructor.
+ *
+ * @return std::pair<iterator, bool> The inserted or the existing element,
+ * and whether the insertion took place.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename... Args>
+std::pair<typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual,
+                             Allocator>::iterator,
+          bool>
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::emplace(
+    Args &&...args) {
+  Value value(std::forward<Args>(args)...);
+  return insert(std::move(value));
+}
+
+/**
+ * @brief Inserts a map element with key and a mapped value built from args
+ * if the key is absent; otherwise nothing is built.
+ *
+ * @param key The key.
+ * @param args Arguments of the mapped value constructor.
+ *
+ * @return std::pair<iterator, bool> The inserted or the existing element,
+ * and whether the insertion took place.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename... Args>
+std::pair<typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual,
+                             Allocator>::iterator,
+          bool>
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::tryEmplace(
+    const Key &key, Args &&...args) {
+  return insertKey(key, std::piecewise_construct, std::forward_as_tuple(key),
+                   std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+/**
+ * @brief Erases the element at pos; no other element moves.
+ *
+ * @param pos An iterator to an element of the table.
+ *
+ * @return iterator The element after pos.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::iterator
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::erase(
+    const_iterator pos) noexcept {
+  size_type index = static_cast<size_type>(pos.ctrl() - ctrl_);
+  eraseAt(index);
+  iterator next = iteratorAt(index);
+  ++next; // ячейка уже не занята: переходим к следующей занятой
+  return next;
+}
+
+/**
+ * @brief Erases the elements in [first, last).
+ *
+ * @return iterator last.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::iterator
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::erase(
+    const_iterator first, const_iterator last) noexcept {
+  while (first != last) {
+    first = erase(first);
+  }
+  return iteratorAt(static_cast<size_type>(last.ctrl() - ctrl_));
+}
+
+/**
+ * @brief Erases the element with a key equal to key.
+ *
+ * @return size_type The number of erased elements (0 or 1).
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename K>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::eraseKey(
+    const K &key) {
+  if (size_ == 0) {
+    return 0;
+  }
+  size_type index = findIndex(key, hashOf(key));
+  if (index == capacity_) {
+    return 0;
+  }
+  eraseAt(index);
+  return 1;
+}
+
+/**
+ * @brief Erases every element for which pred returns true, in one pass over
+ * the slots.
+ *
+ * @param pred Predicate taking a const reference to an element.
+ *
+ * @return size_type The number of erased elements.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename Pred>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::eraseIf(
+    Pred pred) {
+  size_type erased = 0;
+  for (iterator it = begin(); it != end();) {
+    if (pred(static_cast<const Value &>(*it))) {
+      it = erase(it);
+      ++erased;
+    } else {
+      ++it;
+    }
+  }
+  return erased;
+}
+
+/******************************************************************************
+ * AUXILIARY METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Hashes key and mixes the bits of the result.
+ *
+ * std::hash of integers is the identity in libstdc++, and probing starts at
+ * the high bits, so without mixing consecutive keys would all start in the
+ * same group. The multiplication spreads the low bits upwards and the shift
+ * brings the high bits down into the 7 control bits.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename K>
+std::size_t
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::hashOf(
+    const K &key) const {
+  std::uint64_t mixed =
+      static_cast<std::uint64_t>(hash_(key)) * 0x9E3779B97F4A7C15ULL;
+  return static_cast<std::size_t>(mixed ^ (mixed >> 32));
+}
+
+// Слот, с которого начинается поиск: старшие биты хеша
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::probeStart(
+    std::size_t hash, size_type mask) noexcept {
+  return (hash >> 7) & mask;
+}
+
+// Управляющий байт занятой ячейки: младшие 7 бит хеша
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+signed char
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::controlOf(
+    std::size_t hash) noexcept {
+  return static_cast<signed char>(hash & 0x7F);
+}
+
+// Сколько ячеек может быть занято или быть надгробиями: 7/8 таблицы
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::maxLoad(
+    size_type capacity) noexcept {
+  return capacity - capacity / 8;
+}
+
+/**
+ * @brief Returns the slot of the element with a key equal to key, or
+ * capacity_.
+ *
+ * Groups are probed at offsets 0, 16, 48, 96, ... from the start slot.
+ * Since the number of groups is a power of two, this sequence visits every
+ * group once; it ends at the first group with an empty slot, and the load
+ * limit guarantees that there is one.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename K>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::findIndex(
+    const K &key, std::size_t hash) const {
+  size_type mask = capacity_ - 1;
+  size_type pos = probeStart(hash, mask);
+  signed char control = controlOf(hash);
+  for (size_type step = kGroupWidth;; step += kGroupWidth) {
+    HashGroup group(ctrl_ + pos);
+    for (std::uint32_t hits = group.match(control); hits != 0;
+         hits &= hits - 1) {
+      size_type index = (pos + HashGroup::trailingZeros(hits)) & mask;
+      if (equal_(key_of_(slots_[index]), key)) {
+        return index;
+      }
+    }
+    if (group.matchEmpty() != 0) {
+      return capacity_;
+    }
+    pos = (pos + step) & mask;
+  }
+}
+
+/**
+ * @brief Returns the first empty slot or tombstone on the probe sequence of
+ * hash in a table of capacity slots.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::findFree(
+    const signed char *ctrl, size_type capacity, std::size_t hash) noexcept {
+  size_type mask = capacity - 1;
+  size_type pos = probeStart(hash, mask);
+  for (size_type step = kGroupWidth;; step += kGroupWidth) {
+    std::uint32_t free = HashGroup(ctrl + pos).matchEmptyOrDeleted();
+    if (free != 0) {
+      return (pos + HashGroup::trailingZeros(free)) & mask;
+    }
+    pos = (pos + step) & mask;
+  }
+}
+
+/**
+ * @brief Returns an iterator to slot index (end() for capacity_).
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::iterator
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::iteratorAt(
+    size_type index) const noexcept {
+  return iterator(ctrl_ + index, slots_ + index, ctrl_ + capacity_);
+}
+
+/**
+ * @brief Inserts an element built from args unless an element with a key
+ * equal to key exists.
+ *
+ * The key is hashed once: the same hash finds the existing element and the
+ * free slot. The control byte is written only after the element has been
+ * built, so a throwing constructor leaves the table unchanged.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+template <typename K, typename... Args>
+std::pair<typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual,
+                             Allocator>::iterator,
+          bool>
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::insertKey(
+    const K &key, Args &&...args) {
+  std::size_t hash = hashOf(key);
+  if (size_ != 0) {
+    size_type found = findIndex(key, hash);
+    if (found != capacity_) {
+      return {iteratorAt(found), false};
+    }
+  }
+  size_type index = prepareInsert(hash);
+  ::new (static_cast<void *>(slots_ + index))
+      Value(std::forward<Args>(args)...);
+  growth_left_ -= ctrl_[index] == HashGroup::kEmpty;
+  setCtrl(ctrl_, capacity_, index, controlOf(hash));
+  ++size_;
+  return {iteratorAt(index), true};
+}
+
+/**
+ * @brief Returns the slot for a new element with the given hash.
+ *
+ * A tombstone on the probe sequence is reused for free. An empty slot is
+ * used only while the load limit allows it; otherwise the table is rebuilt:
+ * at the same capacity if at least half of the limit is taken by
+ * tombstones, at the double capacity otherwise.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+typename HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::size_type
+HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::prepareInsert(
+    std::size_t hash) {
+  if (capacity_ != 0) {
+    size_type index = findFree(ctrl_, capacity_, hash);
+    if (growth_left_ > 0 || ctrl_[index] == HashGroup::kDeleted) {
+      return index;
+    }
+  }
+  if (capacity_ == 0) {
+    resize(kGroupWidth);
+  } else if (size_ * 16 <= capacity_ * 7) {
+    resize(capacity_); // в основном надгробия: только перестраиваем
+  } else {
+    resize(capacity_ * 2);
+  }
+  return findFree(ctrl_, capacity_, hash);
+}
+
+/**
+ * @brief Moves all elements to new arrays of new_capacity slots, which
+ * removes the tombstones.
+ *
+ * Elements are moved only if their move constructor does not throw,
+ * otherwise copied.
+ *
+ * @throws std::bad_alloc, anything thrown by the hash function or the
+ * element constructor; the table is not changed then
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::resize(
+    size_type new_capacity) {
+  signed char *new_ctrl = nullptr;
+  Value *new_slots = nullptr;
+  allocate(new_capacity, new_ctrl, new_slots);
+  try {
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] >= 0) {
+        std::size_t hash = hashOf(key_of_(slots_[i]));
+        size_type index = findFree(new_ctrl, new_capacity, hash);
+        ::new (static_cast<void *>(new_slots + index))
+            Value(std::move_if_noexcept(slots_[i]));
+        setCtrl(new_ctrl, new_capacity, index, controlOf(hash));
+      }
+    }
+  } catch (...) {
+    for (size_type i = 0; i < new_capacity; ++i) {
+      if (new_ctrl[i] >= 0) {
+        new_slots[i].~Value();
+      }
+    }
+    deallocate(new_ctrl, new_slots, new_capacity);
+    throw;
+  }
+  size_type size = size_;
+  release();
+  ctrl_ = new_ctrl;
+  slots_ = new_slots;
+  capacity_ = new_capacity;
+  size_ = size;
+  growth_left_ = maxLoad(new_capacity) - size;
+}
+
+/**
+ * @brief Destroys the element in slot index.
+ *
+ * The slot becomes empty again unless it lies inside a run of kGroupWidth
+ * non-empty slots: a lookup may have passed a full group there, so the
+ * slot has to stay a tombstone to keep the probe sequences going.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::eraseAt(
+    size_type index) noexcept {
+  slots_[index].~Value();
+  --size_;
+  size_type before = (index - kGroupWidth) & (capacity_ - 1);
+  std::uint32_t empty_after = HashGroup(ctrl_ + index).matchEmpty();
+  std::uint32_t empty_before = HashGroup(ctrl_ + before).matchEmpty();
+  bool was_never_full =
+      empty_before != 0 && empty_after != 0 &&
+      HashGroup::trailingZeros(empty_after) +
+              HashGroup::leadingZeros(empty_before) <
+          kGroupWidth;
+  setCtrl(ctrl_, capacity_, index,
+          was_never_full ? HashGroup::kEmpty : HashGroup::kDeleted);
+  growth_left_ += was_never_full;
+}
+
+/**
+ * @brief Writes a control byte and its copy past the end of the array.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::setCtrl(
+    signed char *ctrl, size_type capacity, size_type index,
+    signed char value) noexcept {
+  ctrl[index] = value;
+  if (index < kGroupWidth) {
+    ctrl[capacity + index] = value; // группа может начинаться у конца
+  }
+}
+
+/**
+ * @brief Allocates a slot array of capacity slots and a control array of
+ * empty bytes.
+ *
+ * @throws std::bad_alloc
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::allocate(
+    size_type capacity, signed char *&ctrl, Value *&slots) {
+  ctrl_allocator ctrl_alloc(alloc_);
+  slot_allocator slot_alloc(alloc_);
+  ctrl = std::allocator_traits<ctrl_allocator>::allocate(
+      ctrl_alloc, capacity + kGroupWidth);
+  try {
+    slots = std::allocator_traits<slot_allocator>::allocate(slot_alloc,
+                                                            capacity);
+  } catch (...) {
+    std::allocator_traits<ctrl_allocator>::deallocate(
+        ctrl_alloc, ctrl, capacity + kGroupWidth);
+    throw;
+  }
+  std::memset(ctrl, HashGroup::kEmpty, capacity + kGroupWidth);
+}
+
+/**
+ * @brief Frees the arrays of a table of capacity slots.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::deallocate(
+    signed char *ctrl, Value *slots, size_type capacity) noexcept {
+  ctrl_allocator ctrl_alloc(alloc_);
+  slot_allocator slot_alloc(alloc_);
+  std::allocator_traits<ctrl_allocator>::deallocate(ctrl_alloc, ctrl,
+                                                    capacity + kGroupWidth);
+  std::allocator_traits<slot_allocator>::deallocate(slot_alloc, slots,
+                                                    capacity);
+}
+
+/**
+ * @brief Destroys the elements of all occupied slots.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOfValue, Hash, KeyEqual,
+               Allocator>::destroyElements() noexcept {
+  if (!std::is_trivially_destructible<Value>::value) {
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (ctrl_[i] >= 0) {
+        slots_[i].~Value();
+      }
+    }
+  }
+}
+
+/**
+ * @brief Destroys all elements and frees the arrays.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::release()
+    noexcept {
+  if (capacity_ != 0) {
+    destroyElements();
+    deallocate(ctrl_, slots_, capacity_);
+  }
+  ctrl_ = nullptr;
+  slots_ = nullptr;
+  capacity_ = size_ = growth_left_ = 0;
+}
+
+/**
+ * @brief Fills this empty table with copies of the elements of other in
+ * the same slots.
+ *
+ * Tombstones are copied too: an element may sit in its slot only because
+ * its probe sequence passed a tombstone, and an empty byte there would end
+ * the lookup of that element early.
+ *
+ * @throws std::bad_alloc, anything thrown by the element copy constructor;
+ * the table is left empty then
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+void HashTable<Key, Value, KeyOfValue, Hash, KeyEqual, Allocator>::copyFrom(
+    const HashTable &other) {
+  if (other.size_ == 0) {
+    return;
+  }
+  allocate(other.capacity_, ctrl_, slots_);
+  capacity_ = other.capacity_;
+  try {
+    for (size_type i = 0; i < capacity_; ++i) {
+      if (other.ctrl_[i] >= 0) {
+        ::new (static_cast<void *>(slots_ + i)) Value(other.slots_[i]);
+        setCtrl(ctrl_, capacity_, i, other.ctrl_[i]);
+        ++size_;
+      } else if (other.ctrl_[i] == HashGroup::kDeleted) {
+        setCtrl(ctrl_, capacity_, i, HashGroup::kDeleted);
+      }
+    }
+    growth_left_ = other.growth_left_; // надгробия те же, что у other
+  } catch (...) {
+    release();
+    throw;
+  }
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks the structure of the table.
+ *
+ * The capacity is 0 or a power of two of at least kGroupWidth, the copied
+ * control bytes match the first ones, every occupied slot holds the 7 bits
+ * of the hash of its key and is found by a lookup of that key, and the
+ * counters match the number of occupied slots and tombstones.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Hash,
+          typename KeyEqual, typename Allocator>
+bool HashTable<Key, Value, KeyOfValue, Hash, KeyEqual,
+               Allocator>::checkInvariants() const {
+  if (capacity_ == 0) {
+    return ctrl_ == nullptr && size_ == 0 && growth_left_ == 0;
+  }
+  if (capacity_ < kGroupWidth || (capacity_ & (capacity_ - 1)) != 0) {
+    return false;
+  }
+  bool ok = true;
+  size_type full = 0;
+  size_type deleted = 0;
+  for (size_type i = 0; i < kGroupWidth; ++i) {
+    ok = ok && ctrl_[capacity_ + i] == ctrl_[i];
+  }
+  for (size_type i = 0; ok && i < capacity_; ++i) {
+    if (ctrl_[i] >= 0) {
+      ++full;
+      std::size_t hash = hashOf(key_of_(slots_[i]));
+      ok = ctrl_[i] == controlOf(hash) &&
+           findIndex(key_of_(slots_[i]), hash) == i;
+    } else if (ctrl_[i] == HashGroup::kDeleted) {
+      ++deleted;
+    } else {
+      ok = ctrl_[i] == HashGroup::kEmpty;
+    }
+  }
+  return ok && full == size_ && full + deleted + growth_left_ ==
+                                     maxLoad(capacity_);
+}
+
+/******************************************************************************
+ * ITERATOR
+ ******************************************************************************/
+
+template <typename Table, bool IsConst>
+HashTableIterator<Table, IsConst> &
+HashTableIterator<Table, IsConst>::operator++() noexcept {
+  ++ctrl_;
+  ++slot_;
+  skipFree();
+  return *this;
+}
+
+template <typename Table, bool IsConst>
+HashTableIterator<Table, IsConst>
+HashTableIterator<Table, IsConst>::operator++(int) noexcept {
+  HashTableIterator old = *this;
+  ++*this;
+  return old;
+}
+
+/**
+ * @brief Moves to the next occupied slot, looking at 16 control bytes at a
+ * time; stays at end().
+ */
+template <typename Table, bool IsConst>
+void HashTableIterator<Table, IsConst>::skipFree() noexcept {
+  while (ctrl_ != end_) {
+    std::size_t left = static_cast<std::size_t>(end_ - ctrl_);
+    std::uint32_t full = HashGroup(ctrl_).matchFull();
+    if (left < HashGroup::kWidth) {
+      full &= (1u << left) - 1; // копии первых байтов - не ячейки
+    }
+    if (full != 0) {
+      std::size_t shift = HashGroup::trailingZeros(full);
+      ctrl_ += shift;
+      slot_ += shift;
+      return;
+    }
+    std::size_t shift = left < HashGroup::kWidth ? left : HashGroup::kWidth;
+    ctrl_ += shift;
+    slot_ += shift;
+  }
+}
+
+} //  namespace s21
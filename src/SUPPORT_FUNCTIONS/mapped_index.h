@@ -0,0 +1,158 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file mapped_index.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-09-09
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_MAPPED_INDEX_H_
+#define CPP2_S21_CONTAINERS_MAPPED_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional> // std::less
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>    // open
+#include <sys/mman.h> // mmap, munmap
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // close
+
+#include "snapshot.h"
+
+// Размер блока ключей в байтах у новых файлов: блок последовательно
+// просматривается в конце поиска, по умолчанию это одна кэш-линия
+#ifndef S21_MAPPED_LEAF_BYTES
+#define S21_MAPPED_LEAF_BYTES 64
+#endif
+
+namespace s21 {
+
+/**
+ * @brief Read-only sorted index of trivially copyable keys in a file that
+ * is mapped into memory.
+ *
+ * The file starts with a SnapshotHeader (kind kMappedSet or kMappedMap)
+ * and has three sections, each aligned to 64 bytes:
+ * - the keys in increasing order, so a position in this array is the rank
+ *   of a key and iteration is a walk over contiguous memory;
+ * - the search index: the sorted keys are cut into blocks of leaf keys,
+ *   and the largest key of every block is stored at the node of a perfect
+ *   binary tree in Eytzinger (breadth-first) order, counting from 1;
+ *   missing blocks up to the next power of two repeat the largest key;
+ * - the values of a map, parallel to the keys (the caller reads them).
+ *
+ * A lookup descends the index without branches, prefetching the line of
+ * its descendants a few levels below. In a perfect tree the path itself is
+ * the number of the first block whose largest key is not less than the
+ * key, so no rank has to be computed; the block is then scanned. The top
+ * levels of the index are shared by all lookups and stay in cache, and the
+ * index holds one key per block, so most lookups read one line per level
+ * below them plus one line of keys.
+ *
+ * Opening maps the file and checks the header and the section sizes in
+ * O(1); the pages are read on first access and stay in the page cache,
+ * shared by every process that maps the file. The order of the keys is not
+ * checked on opening (that would read the whole file); checkInvariants()
+ * does it.
+ *
+ * @tparam Key Trivially copyable key type.
+ * @tparam Compare Strict weak ordering of keys, default-constructible; it
+ * must be the ordering the file was written with.
+ */
+template <typename Key, typename Compare = std::less<Key>>
+class MappedIndex {
+public:
+  static_assert(std::is_trivially_copyable<Key>::value,
+                "keys of a mapped index must be trivially copyable");
+  static_assert(alignof(Key) <= 64, "sections are aligned to 64 bytes");
+
+  using key_type = Key;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+
+  static constexpr std::size_t kAlign = 64;
+  static constexpr std::uint32_t kLeaf =
+      sizeof(Key) < S21_MAPPED_LEAF_BYTES ? S21_MAPPED_LEAF_BYTES / sizeof(Key)
+                                          : 1;
+
+  // Смещения секций от начала файла
+  struct Layout {
+    std::uint64_t blocks;     // блоки по leaf ключей
+    std::uint64_t index_size; // узлы индекса, включая неиспользуемый нулевой
+    std::uint64_t keys;
+    std::uint64_t index;
+    std::uint64_t values;
+    std::uint64_t bytes; // размер файла
+  };
+
+  MappedIndex() noexcept = default;
+  MappedIndex(int fd, SnapshotKind kind, std::uint32_t value_size);
+  MappedIndex(const std::string &path, SnapshotKind kind,
+              std::uint32_t value_size);
+  MappedIndex(const MappedIndex &) = delete;
+  MappedIndex(MappedIndex &&other) noexcept;
+  ~MappedIndex();
+  MappedIndex &operator=(const MappedIndex &) = delete;
+  MappedIndex &operator=(MappedIndex &&other) noexcept;
+
+  // Writing:
+  static Layout layout(std::uint64_t count, std::uint32_t leaf,
+                       std::uint32_t value_size) noexcept;
+  template <typename ForwardIt, typename KeyOf, typename ValueOf>
+  static void write(int fd, SnapshotKind kind, ForwardIt first,
+                    size_type count, std::uint32_t value_size, KeyOf key_of,
+                    ValueOf value_of);
+
+  // Access:
+  size_type size() const noexcept { return count_; }
+  const Key *keys() const noexcept { return keys_; }
+  const void *values() const noexcept { return values_; }
+  size_type mappedBytes() const noexcept { return bytes_; }
+  size_type lowerBound(const key_type &key) const;
+  size_type upperBound(const key_type &key) const;
+  void swap(MappedIndex &other) noexcept;
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  static constexpr size_type prefetchStride() noexcept;
+  static std::uint64_t blockOf(std::uint64_t node,
+                               std::uint64_t index_size) noexcept;
+  static void writeZeros(SnapshotWriter &writer, std::uint64_t bytes);
+  void attach(SnapshotKind kind, std::uint32_t value_size);
+  void unmap() noexcept;
+  template <bool Upper> size_type bound(const key_type &key) const;
+  // Upper ? x <= key : x < key - ключ x стоит до искомой позиции
+  template <bool Upper> bool before(const Key &x, const Key &key) const {
+    return Upper ? !compare_(key, x) : compare_(x, key);
+  }
+
+  void *data_ = nullptr; // начало отображения
+  size_type bytes_ = 0;
+  const Key *keys_ = nullptr;
+  const Key *index_ = nullptr; // узел k - index_[k], k >= 1
+  const void *values_ = nullptr;
+  size_type count_ = 0;
+  size_type blocks_ = 0;
+  size_type index_size_ = 1;
+  size_type leaf_ = kLeaf;
+  key_compare compare_;
+};
+
+} // namespace s21
+
+#include "mapped_index.tpp"
+
+#endif // CPP2_S21_CONTAINERS_MAPPED_INDEX_H_
@@ -0,0 +1,432 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file mapped_index.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-09-09
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Maps a file written by write() and checks its header.
+ * @param fd Descriptor open for reading; it may be closed afterwards, the
+ * mapping stays valid.
+ * @param kind Container that is opening the file.
+ * @param value_size Size of a mapped value, 0 for a set.
+ * @throws std::runtime_error if the file is not a mapped index of this
+ * kind, key type and value size or its size does not match the header,
+ * std::system_error if the file cannot be mapped.
+ */
+template <typename Key, typename Compare>
+MappedIndex<Key, Compare>::MappedIndex(int fd, SnapshotKind kind,
+                                       std::uint32_t value_size) {
+  struct stat info;
+  if (::fstat(fd, &info) != 0) {
+    throw std::system_error(errno, std::generic_category(),
+                            "s21::mapped_index: fstat");
+  }
+  if (info.st_size < static_cast<off_t>(sizeof(SnapshotHeader))) {
+    throw std::runtime_error("s21::mapped_index: not a mapped index");
+  }
+  bytes_ = static_cast<size_type>(info.st_size);
+  void *data = ::mmap(nullptr, bytes_, PROT_READ, MAP_SHARED, fd, 0);
+  if (data == MAP_FAILED) {
+    throw std::system_error(errno, std::generic_category(),
+                            "s21::mapped_index: mmap");
+  }
+  data_ = data;
+  try {
+    attach(kind, value_size);
+  } catch (...) {
+    unmap(); // деструктор не будет вызван
+    throw;
+  }
+}
+
+/**
+ * @brief Opens and maps a file written by write(); the descriptor is
+ * closed before returning.
+ * @param path Path of the file.
+ * @param kind Container that is opening the file.
+ * @param value_size Size of a mapped value, 0 for a set.
+ * @throws std::system_error if the file cannot be opened or mapped,
+ * std::runtime_error if it is not a mapped index of this kind.
+ */
+template <typename Key, typename Compare>
+MappedIndex<Key, Compare>::MappedIndex(const std::string &path,
+                                       SnapshotKind kind,
+                                       std::uint32_t value_size) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(),
+                            "s21::mapped_index: " + path);
+  }
+  try {
+    MappedIndex(fd, kind, value_size).swap(*this);
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+  ::close(fd);
+}
+
+/**
+ * @brief Move constructor: the mapping passes to the new index.
+ * @param other Index to move; it becomes empty.
+ */
+template <typename Key, typename Compare>
+MappedIndex<Key, Compare>::MappedIndex(MappedIndex &&other) noexcept {
+  swap(other);
+}
+
+/**
+ * @brief Destructor: unmaps the file.
+ */
+template <typename Key, typename Compare>
+MappedIndex<Key, Compare>::~MappedIndex() {
+  unmap();
+}
+
+/**
+ * @brief Move assignment operator: the old mapping is released.
+ * @param other Index to move; it becomes empty.
+ * @return Reference to this index.
+ */
+template <typename Key, typename Compare>
+MappedIndex<Key, Compare> &
+MappedIndex<Key, Compare>::operator=(MappedIndex &&other) noexcept {
+  if (this != &other) {
+    MappedIndex(std::move(other)).swap(*this);
+  }
+  return *this;
+}
+
+/******************************************************************************
+ * WRITING
+ ******************************************************************************/
+
+/**
+ * @brief Computes the offsets of the sections of a file.
+ * @param count Number of keys.
+ * @param leaf Keys per search block.
+ * @param value_size Size of a mapped value, 0 for a set.
+ * @return Layout Offsets from the start of the file and its size.
+ */
+template <typename Key, typename Compare>
+typename MappedIndex<Key, Compare>::Layout
+MappedIndex<Key, Compare>::layout(std::uint64_t count, std::uint32_t leaf,
+                                  std::uint32_t value_size) noexcept {
+  auto align = [](std::uint64_t offset) {
+    return (offset + kAlign - 1) / kAlign * kAlign;
+  };
+  Layout result;
+  result.blocks = (count + leaf - 1) / leaf;
+  // совершенное дерево: 2^d - 1 узлов не меньше числа блоков
+  result.index_size = 1;
+  while (result.index_size - 1 < result.blocks) {
+    result.index_size *= 2;
+  }
+  result.keys = align(sizeof(SnapshotHeader));
+  result.index = align(result.keys + count * sizeof(Key));
+  result.values = align(result.index + result.index_size * sizeof(Key));
+  result.bytes = result.values + count * value_size;
+  return result;
+}
+
+/**
+ * @brief Writes a mapped index file of count keys taken in increasing
+ * order from a range.
+ * @param fd Descriptor open for writing.
+ * @param kind kMappedSet or kMappedMap.
+ * @param first Beginning of the range (a forward iterator, passed twice
+ * if there are values).
+ * @param count Number of elements.
+ * @param value_size Size of a mapped value, 0 for a set.
+ * @param key_of Returns the key of an element.
+ * @param value_of Returns the address of the value_size bytes of the
+ * value of an element; not called if value_size is 0.
+ * @throws std::system_error if the descriptor cannot be written,
+ * std::bad_alloc.
+ */
+template <typename Key, typename Compare>
+template <typename ForwardIt, typename KeyOf, typename ValueOf>
+void MappedIndex<Key, Compare>::write(int fd, SnapshotKind kind,
+                                      ForwardIt first, size_type count,
+                                      std::uint32_t value_size, KeyOf key_of,
+                                      ValueOf value_of) {
+  const Layout sections = layout(count, kLeaf, value_size);
+  SnapshotHeader header{};
+  std::memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+  header.version = kSnapshotVersion;
+  header.byte_order = kSnapshotByteOrder;
+  header.kind = static_cast<std::uint32_t>(kind);
+  header.key_size = sizeof(Key);
+  header.value_size = value_size;
+  header.leaf = kLeaf;
+  header.count = count;
+  header.payload = sections.bytes - sizeof(header);
+
+  SnapshotWriter writer(fd);
+  writer.write(&header, sizeof(header));
+  writeZeros(writer, sections.keys - sizeof(header));
+  std::vector<Key> largest; // наибольший ключ каждого блока
+  largest.reserve(static_cast<size_type>(sections.blocks));
+  ForwardIt it = first;
+  for (size_type i = 0; i < count; ++i, ++it) {
+    const Key &key = key_of(*it);
+    writer.write(&key, sizeof(Key));
+    if ((i + 1) % kLeaf == 0 || i + 1 == count) {
+      largest.push_back(key);
+    }
+  }
+
+  writeZeros(writer, sections.index - sections.keys - count * sizeof(Key));
+  writeZeros(writer, sizeof(Key)); // нулевой узел не используется
+  for (std::uint64_t node = 1; node < sections.index_size; ++node) {
+    std::uint64_t rank = blockOf(node, sections.index_size);
+    writer.write(&largest[rank < sections.blocks ? rank : sections.blocks - 1],
+                 sizeof(Key));
+  }
+
+  writeZeros(writer, sections.values - sections.index -
+                         sections.index_size * sizeof(Key));
+  if (value_size != 0) {
+    for (size_type i = 0; i < count; ++i, ++first) {
+      writer.write(value_of(*first), value_size);
+    }
+  }
+  writer.flush();
+}
+
+/******************************************************************************
+ * ACCESS
+ ******************************************************************************/
+
+/**
+ * @brief Returns the position of the first key not less than key.
+ * @param key Key to search for.
+ * @return Position in key order, size() if there is none.
+ */
+template <typename Key, typename Compare>
+typename MappedIndex<Key, Compare>::size_type
+MappedIndex<Key, Compare>::lowerBound(const key_type &key) const {
+  return bound<false>(key);
+}
+
+/**
+ * @brief Returns the position of the first key greater than key.
+ * @param key Key to search for.
+ * @return Position in key order, size() if there is none.
+ */
+template <typename Key, typename Compare>
+typename MappedIndex<Key, Compare>::size_type
+MappedIndex<Key, Compare>::upperBound(const key_type &key) const {
+  return bound<true>(key);
+}
+
+/**
+ * @brief Swaps the mappings of two indexes.
+ */
+template <typename Key, typename Compare>
+void MappedIndex<Key, Compare>::swap(MappedIndex &other) noexcept {
+  std::swap(data_, other.data_);
+  std::swap(bytes_, other.bytes_);
+  std::swap(keys_, other.keys_);
+  std::swap(index_, other.index_);
+  std::swap(values_, other.values_);
+  std::swap(count_, other.count_);
+  std::swap(blocks_, other.blocks_);
+  std::swap(index_size_, other.index_size_);
+  std::swap(leaf_, other.leaf_);
+  std::swap(compare_, other.compare_);
+}
+
+/******************************************************************************
+ * SUPPORT METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Number of index entries that fill one cache line: the descendants
+ * of node k that many levels below are the entries stride * k ...
+ * stride * k + stride - 1, so one prefetch brings them all.
+ */
+template <typename Key, typename Compare>
+constexpr typename MappedIndex<Key, Compare>::size_type
+MappedIndex<Key, Compare>::prefetchStride() noexcept {
+  size_type stride = 1;
+  while (stride * 2 * sizeof(Key) <= 64) {
+    stride *= 2;
+  }
+  return stride;
+}
+
+/**
+ * @brief Returns the number of the block, in key order, whose largest key
+ * is kept at a node: the in-order rank of the node in a perfect tree.
+ * @param node Node number, from 1.
+ * @param index_size Number of nodes plus one, a power of two.
+ */
+template <typename Key, typename Compare>
+std::uint64_t
+MappedIndex<Key, Compare>::blockOf(std::uint64_t node,
+                                   std::uint64_t index_size) noexcept {
+  std::uint64_t level = 1; // старший бит номера узла
+  while (level * 2 <= node) {
+    level *= 2;
+  }
+  // поддеревья узлов этого уровня содержат по subtree - 1 узлов и идут
+  // подряд; узел стоит в середине своего
+  std::uint64_t subtree = index_size / level;
+  return (node - level) * subtree + subtree / 2 - 1;
+}
+
+template <typename Key, typename Compare>
+void MappedIndex<Key, Compare>::writeZeros(SnapshotWriter &writer,
+                                           std::uint64_t bytes) {
+  static const char kZeros[kAlign] = {};
+  while (bytes > 0) {
+    std::uint64_t part = bytes < kAlign ? bytes : kAlign;
+    writer.write(kZeros, static_cast<size_type>(part));
+    bytes -= part;
+  }
+}
+
+/**
+ * @brief Checks the header of the mapped file and sets up the sections.
+ * @throws std::runtime_error if the header does not match.
+ */
+template <typename Key, typename Compare>
+void MappedIndex<Key, Compare>::attach(SnapshotKind kind,
+                                       std::uint32_t value_size) {
+  SnapshotHeader header;
+  std::memcpy(&header, data_, sizeof(header));
+  if (std::memcmp(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0) {
+    throw std::runtime_error("s21::mapped_index: not a mapped index");
+  }
+  if (header.byte_order != kSnapshotByteOrder) {
+    throw std::runtime_error(
+        "s21::mapped_index: written with another byte order");
+  }
+  if (header.version != kSnapshotVersion) {
+    throw std::runtime_error("s21::mapped_index: unsupported version");
+  }
+  if (header.kind != static_cast<std::uint32_t>(kind)) {
+    throw std::runtime_error(
+        "s21::mapped_index: written by another container");
+  }
+  if (header.key_size != sizeof(Key) || header.value_size != value_size) {
+    throw std::runtime_error("s21::mapped_index: element types do not match");
+  }
+  // проверки до вычисления смещений, чтобы они не переполнились
+  if (header.leaf == 0 || header.count > bytes_ / sizeof(Key)) {
+    throw std::runtime_error("s21::mapped_index: corrupted header");
+  }
+  const Layout sections = layout(header.count, header.leaf, value_size);
+  if (sections.bytes != bytes_ ||
+      header.payload != bytes_ - sizeof(header)) {
+    throw std::runtime_error(
+        "s21::mapped_index: file size does not match the header");
+  }
+
+  const char *base = static_cast<const char *>(data_);
+  keys_ = reinterpret_cast<const Key *>(base + sections.keys);
+  index_ = reinterpret_cast<const Key *>(base + sections.index);
+  values_ = base + sections.values;
+  count_ = static_cast<size_type>(header.count);
+  blocks_ = static_cast<size_type>(sections.blocks);
+  index_size_ = static_cast<size_type>(sections.index_size);
+  leaf_ = header.leaf;
+}
+
+/**
+ * @brief Releases the mapping and leaves an empty index.
+ */
+template <typename Key, typename Compare>
+void MappedIndex<Key, Compare>::unmap() noexcept {
+  if (data_ != nullptr) {
+    ::munmap(data_, bytes_);
+  }
+  data_ = nullptr;
+  bytes_ = 0;
+  keys_ = index_ = nullptr;
+  values_ = nullptr;
+  count_ = blocks_ = 0;
+  index_size_ = 1;
+  leaf_ = kLeaf;
+}
+
+/**
+ * @brief Descends the index without branches and scans the block found.
+ * @tparam Upper false for the first key not less than key, true for the
+ * first key greater than key.
+ * @return Position in key order, count_ if there is none.
+ */
+template <typename Key, typename Compare>
+template <bool Upper>
+typename MappedIndex<Key, Compare>::size_type
+MappedIndex<Key, Compare>::bound(const key_type &key) const {
+  size_type node = 1;
+  while (node < index_size_) {
+#if defined(__GNUC__)
+    size_type ahead = prefetchStride() * node;
+    if (ahead < index_size_) {
+      __builtin_prefetch(index_ + ahead);
+    }
+#endif
+    node = 2 * node + static_cast<size_type>(before<Upper>(index_[node], key));
+  }
+  // в совершенном дереве путь - это номер нужного блока в порядке ключей
+  size_type block = node - index_size_;
+  if (block >= blocks_) {
+    return count_;
+  }
+  size_type first = block * leaf_;
+  size_type last = first + leaf_ < count_ ? first + leaf_ : count_;
+  size_type position = first;
+  for (size_type i = first; i < last; ++i) {
+    position += static_cast<size_type>(before<Upper>(keys_[i], key));
+  }
+  return position;
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Reads the whole file and checks that the keys strictly increase
+ * and that every index node holds the largest key of its block.
+ */
+template <typename Key, typename Compare>
+bool MappedIndex<Key, Compare>::checkInvariants() const {
+  for (size_type i = 1; i < count_; ++i) {
+    if (!compare_(keys_[i - 1], keys_[i])) {
+      return false;
+    }
+  }
+  for (size_type node = 1; node < index_size_; ++node) {
+    size_type rank = static_cast<size_type>(blockOf(node, index_size_));
+    size_type block = rank < blocks_ ? rank : blocks_ - 1;
+    size_type last = (block + 1) * leaf_;
+    last = last < count_ ? last : count_;
+    const Key &largest = keys_[last - 1];
+    if (compare_(index_[node], largest) || compare_(largest, index_[node])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace s21
@@ -0,0 +1,173 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file persistent_tree.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-24
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_PERSISTENT_TREE_H_
+#define CPP2_S21_CONTAINERS_PERSISTENT_TREE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional> // std::less
+#include <memory>     // std::allocator_traits
+#include <utility>    // std::pair
+
+#include "../s21_common.h" // Identity, SelectFirst
+
+namespace s21 {
+
+/**
+ * @brief Immutable red-black tree with unique keys whose versions share
+ * nodes.
+ *
+ * A tree is never changed after it is built. insert, assign and erase copy
+ * only the nodes on the path to the key (and the few nodes recolored or
+ * rotated by the rebalancing) and return a new tree that shares all other
+ * subtrees with the old one, so every modification costs O(log n) time and
+ * memory and copying a tree is O(1).
+ *
+ * Nodes are reference-counted: a node is freed when the last tree or node
+ * referring to it is gone. The counters are atomic, so different versions
+ * can be used and destroyed by different threads; one tree object is not
+ * synchronized, like std::shared_ptr.
+ *
+ * Insertion uses the balancing of Okasaki, erasure the algorithm of Kahrs;
+ * both work on immutable nodes.
+ *
+ * @tparam Key Type of the keys.
+ * @tparam Value Type of the elements (Key or std::pair<const Key, T>).
+ * @tparam KeyOfValue Function object that returns the key of an element.
+ * @tparam Compare Order of keys.
+ * @tparam Allocator Allocator of Value, rebound to the node type.
+ */
+template <typename Key, typename Value, typename KeyOfValue,
+          typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<Value>>
+class PersistentTree {
+public:
+  using key_type = Key;
+  using value_type = Value;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  PersistentTree();
+  explicit PersistentTree(const allocator_type &alloc);
+  PersistentTree(const PersistentTree &other) noexcept;
+  PersistentTree(PersistentTree &&other) noexcept;
+  ~PersistentTree();
+  PersistentTree &operator=(const PersistentTree &other) noexcept;
+  PersistentTree &operator=(PersistentTree &&other) noexcept;
+
+  allocator_type get_allocator() const noexcept;
+  size_type size() const noexcept;
+  bool empty() const noexcept;
+  void swap(PersistentTree &other) noexcept;
+
+  // New versions:
+  template <typename... Args>
+  std::pair<PersistentTree, bool> insert(const key_type &key,
+                                         Args &&...args) const;
+  template <typename... Args>
+  std::pair<PersistentTree, bool> assign(const key_type &key,
+                                         Args &&...args) const;
+  std::pair<PersistentTree, bool> erase(const key_type &key) const;
+
+  // Lookup:
+  const value_type *find(const key_type &key) const;
+  template <typename Fn> void forEach(Fn &&fn) const;
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  struct Node {
+    template <typename... Args>
+    explicit Node(bool is_red, Args &&...args)
+        : value(std::forward<Args>(args)...), red(is_red) {}
+
+    value_type value;
+    Node *left = nullptr; // каждый узел держит по ссылке на своих потомков
+    Node *right = nullptr;
+    mutable std::atomic<std::uint32_t> refs{1};
+    bool red;
+  };
+
+  using node_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+  // владеющая ссылка на узел во время построения новой версии: при
+  // исключении уже построенные узлы освобождаются
+  class Ref {
+  public:
+    Ref(Node *node, node_allocator *alloc) noexcept;
+    Ref(Ref &&other) noexcept;
+    Ref(const Ref &) = delete;
+    Ref &operator=(const Ref &) = delete;
+    ~Ref();
+
+    Node *get() const noexcept { return node_; }
+    Node *operator->() const noexcept { return node_; }
+    Node *release() noexcept;
+
+  private:
+    Node *node_;
+    node_allocator *alloc_;
+  };
+
+  PersistentTree(Node *root, size_type size, const node_allocator &alloc);
+
+  // Node management:
+  template <typename... Args>
+  Ref makeNode(bool red, Ref left, Ref right, Args &&...args) const;
+  Ref share(const Node *node) const noexcept;
+  Ref recolor(Ref node, bool red) const;
+  static void releaseNode(Node *node, node_allocator &alloc) noexcept;
+  const key_type &keyOf(const Node *node) const noexcept;
+  static bool isRed(const Node *node) noexcept;
+  static bool isBlack(const Node *node) noexcept;
+
+  // Insertion:
+  template <typename... Args>
+  Ref insertPath(const Node *node, const key_type &key,
+                 Args &&...args) const;
+  template <typename... Args>
+  Ref assignPath(const Node *node, const key_type &key,
+                 Args &&...args) const;
+  Ref balance(Ref left, const value_type &value, Ref right) const;
+
+  // Erasure:
+  Ref erasePath(const Node *node, const key_type &key) const;
+  Ref balanceLeft(Ref left, const value_type &value, Ref right) const;
+  Ref balanceRight(Ref left, const value_type &value, Ref right) const;
+  Ref fuse(const Node *left, const Node *right) const;
+  PersistentTree withRoot(Ref root, size_type size) const;
+
+  template <typename Fn> static void visitSubtree(const Node *node, Fn &fn);
+  int checkSubtree(const Node *node, const Node *&prev,
+                   size_type &count) const;
+
+  Node *root_ = nullptr;
+  size_type size_ = 0;
+  mutable node_allocator alloc_; // новые версии строятся из const-методов
+  key_compare compare_;
+  KeyOfValue key_of_;
+};
+
+} // namespace s21
+
+#include "persistent_tree.tpp"
+
+#endif // CPP2_S21_CONTAINERS_PERSISTENT_TREE_H_
@@ -0,0 +1,709 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file persistent_tree.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-24
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor: an empty tree.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::PersistentTree()
+    : PersistentTree(allocator_type()) {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator of the elements, rebound to the node type.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::PersistentTree(
+    const allocator_type &alloc)
+    : alloc_(alloc), compare_(), key_of_() {}
+
+/**
+ * @brief Copy constructor. Shares the root with other: O(1).
+ * @param other The tree to copy.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::PersistentTree(
+    const PersistentTree &other) noexcept
+    : root_(other.root_), size_(other.size_), alloc_(other.alloc_),
+      compare_(other.compare_), key_of_(other.key_of_) {
+  if (root_) {
+    root_->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+/**
+ * @brief Move constructor.
+ * @param other The tree to move from, left empty.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::PersistentTree(
+    PersistentTree &&other) noexcept
+    : root_(other.root_), size_(other.size_), alloc_(other.alloc_),
+      compare_(other.compare_), key_of_(other.key_of_) {
+  other.root_ = nullptr;
+  other.size_ = 0;
+}
+
+/**
+ * @brief Constructor of a new version from its root.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::PersistentTree(
+    Node *root, size_type size, const node_allocator &alloc)
+    : root_(root), size_(size), alloc_(alloc), compare_(), key_of_() {}
+
+/**
+ * @brief Destructor. Frees the nodes that no other version refers to.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::~PersistentTree() {
+  releaseNode(root_, alloc_);
+}
+
+/**
+ * @brief Copy assignment operator. O(1).
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator> &
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::operator=(
+    const PersistentTree &other) noexcept {
+  PersistentTree copy(other);
+  swap(copy);
+  return *this;
+}
+
+/**
+ * @brief Move assignment operator.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator> &
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::operator=(
+    PersistentTree &&other) noexcept {
+  PersistentTree moved(std::move(other));
+  swap(moved);
+  return *this;
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Returns a copy of the allocator.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+typename PersistentTree<Key, Value, KeyOfValue, Compare,
+                        Allocator>::allocator_type
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::get_allocator()
+    const noexcept {
+  return allocator_type(alloc_);
+}
+
+/**
+ * @brief Returns the number of elements.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+typename PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::size_type
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::size()
+    const noexcept {
+  return size_;
+}
+
+/**
+ * @brief Checks whether the tree is empty.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+bool PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::empty()
+    const noexcept {
+  return size_ == 0;
+}
+
+/**
+ * @brief Swaps the contents with other.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+void PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::swap(
+    PersistentTree &other) noexcept {
+  std::swap(root_, other.root_);
+  std::swap(size_, other.size_);
+  std::swap(alloc_, other.alloc_);
+  std::swap(compare_, other.compare_);
+}
+
+/**
+ * @brief Builds the version with an element inserted.
+ *
+ * Copies the O(log n) nodes of the search path; the rest of the tree is
+ * shared with this version, which stays unchanged.
+ * @param key Key of the new element.
+ * @param args Arguments of the element constructor; the element must have
+ * the key key.
+ * @return The new version and true, or this version and false if the key
+ * is present.
+ * @throws std::bad_alloc, anything thrown by the element constructors; this
+ * version is unaffected then.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+template <typename... Args>
+std::pair<PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>, bool>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::insert(
+    const key_type &key, Args &&...args) const {
+  if (find(key)) {
+    return {*this, false};
+  }
+  Ref root = recolor(insertPath(root_, key, std::forward<Args>(args)...),
+                     false); // корень всегда чёрный
+  return {withRoot(std::move(root), size_ + 1), true};
+}
+
+/**
+ * @brief Builds the version in which the element with the key is replaced
+ * by (or, if absent, inserted as) an element built from args.
+ * @param key Key of the element.
+ * @param args Arguments of the element constructor.
+ * @return The new version and true if the element was inserted, false if
+ * it was replaced.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+template <typename... Args>
+std::pair<PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>, bool>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::assign(
+    const key_type &key, Args &&...args) const {
+  if (!find(key)) {
+    return insert(key, std::forward<Args>(args)...);
+  }
+  // форма дерева не меняется: копируется только путь до ключа
+  return {withRoot(assignPath(root_, key, std::forward<Args>(args)...), size_),
+          false};
+}
+
+/**
+ * @brief Builds the version without the element with the key.
+ * @param key Key to erase.
+ * @return The new version and true, or this version and false if the key
+ * is absent.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+std::pair<PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>, bool>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::erase(
+    const key_type &key) const {
+  // erasePath рассчитан на присутствующий ключ: иначе он перекрасил бы путь
+  if (!find(key)) {
+    return {*this, false};
+  }
+  Ref root = erasePath(root_, key);
+  if (!root.get()) {
+    return {withRoot(std::move(root), 0), true};
+  }
+  return {withRoot(recolor(std::move(root), false), size_ - 1), true};
+}
+
+/**
+ * @brief Finds the element with the key.
+ * @return Pointer to the element, valid while some version holds it, or
+ * nullptr.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+const typename PersistentTree<Key, Value, KeyOfValue, Compare,
+                              Allocator>::value_type *
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::find(
+    const key_type &key) const {
+  const Node *node = root_;
+  while (node) {
+    if (compare_(key, keyOf(node))) {
+      node = node->left;
+    } else if (compare_(keyOf(node), key)) {
+      node = node->right;
+    } else {
+      return &node->value;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Calls fn(element) for every element in key order.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+template <typename Fn>
+void PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::forEach(
+    Fn &&fn) const {
+  visitSubtree(root_, fn);
+}
+
+/******************************************************************************
+ * SUPPORT METHODS
+ ******************************************************************************/
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::Ref::Ref(
+    Node *node, node_allocator *alloc) noexcept
+    : node_(node), alloc_(alloc) {}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::Ref::Ref(
+    Ref &&other) noexcept
+    : node_(other.node_), alloc_(other.alloc_) {
+  other.node_ = nullptr;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::Ref::~Ref() {
+  releaseNode(node_, *alloc_);
+}
+
+/**
+ * @brief Gives up the reference without releasing the node.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+typename PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::Node *
+PersistentTree<Key, Value, KeyOfValue, Compare,
+               Allocator>::Ref::release() noexcept {
+  Node *node = node_;
+  node_ = nullptr;
+  return node;
+}
+
+/**
+ * @brief Allocates a node that takes over the references left and right.
+ * @param red Color of the node.
+ * @param left Left subtree.
+ * @param right Right subtree.
+ * @param args Arguments of the element constructor.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+template <typename... Args>
+typename PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::Ref
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::makeNode(
+    bool red, Ref left, Ref right, Args &&...args) const {
+  Node *node = node_traits::allocate(alloc_, 1);
+  try {
+    node_traits::construct(alloc_, node, red, std::forward<Args>(args)...);
+  } catch (...) {
+    node_traits::deallocate(alloc_, node, 1);
+    throw;
+  }
+  node->left = left.release();
+  node->right = right.release();
+  return Ref(node, &alloc_);
+}
+
+/**
+ * @brief Takes one more reference to an existing node (or nullptr).
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+typename PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::Ref
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::share(
+    const Node *node) const noexcept {
+  if (node) {
+    node->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+  return Ref(const_cast<Node *>(node), &alloc_);
+}
+
+/**
+ * @brief Returns the node with the given color.
+ *
+ * A node referred to only by this reference was just built and is not
+ * visible to any version, so it is recolored in place; a shared node is
+ * copied.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+typename PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::Ref
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::recolor(
+    Ref node, bool red) const {
+  if (node->red == red) {
+    return node;
+  }
+  if (node->refs.load(std::memory_order_acquire) == 1) {
+    node->red = red;
+    return node;
+  }
+  return makeNode(red, share(node->left), share(node->right), node->value);
+}
+
+/**
+ * @brief Drops one reference to a node and frees the nodes whose last
+ * reference it was.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+void PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::releaseNode(
+    Node *node, node_allocator &alloc) noexcept {
+  // acq_rel: поток, освобождающий узел, видит все записи других владельцев
+  while (node && node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    releaseNode(node->left, alloc);
+    Node *next = node->right;
+    node_traits::destroy(alloc, node);
+    node_traits::deallocate(alloc, node, 1);
+    node = next;
+  }
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+const Key &PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::keyOf(
+    const Node *node) const noexcept {
+  return key_of_(node->value);
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+bool PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::isRed(
+    const Node *node) noexcept {
+  return node && node->red;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+bool PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::isBlack(
+    const Node *node) noexcept {
+  return node && !node->red;
+}
+
+/**
+ * @brief Copies the search path of an absent key and hangs a new red leaf
+ * at its end (Okasaki). Red nodes are copied as they are; a black node
+ * rebalances a red-red pair below it.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+template <typename... Args>
+typename PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::Ref
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::insertPath(
+    const Node *node, const key_type &key, Args &&...args) const {
+  if (!node) {
+    return makeNode(true, share(nullptr), share(nullptr),
+                    std::forward<Args>(args)...);
+  }
+  if (compare_(key, keyOf(node))) {
+    Ref left = insertPath(node->left, key, std::forward<Args>(args)...);
+    if (node->red) {
+      return makeNode(true, std::move(left), share(node->right), node->value);
+    }
+    return balance(std::move(left), node->value, share(node->right));
+  }
+  Ref right = insertPath(node->right, key, std::forward<Args>(args)...);
+  if (node->red) {
+    return makeNode(true, share(node->left), std::move(right), node->value);
+  }
+  return balance(share(node->left), node->value, std::move(right));
+}
+
+/**
+ * @brief Copies the search path of a present key, building a new element
+ * in place of the old one.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+template <typename... Args>
+typename PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::Ref
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::assignPath(
+    const Node *node, const key_type &key, Args &&...args) const {
+  if (compare_(key, keyOf(node))) {
+    return makeNode(node->red,
+                    assignPath(node->left, key, std::forward<Args>(args)...),
+                    share(node->right), node->value);
+  }
+  if (compare_(keyOf(node), key)) {
+    return makeNode(node->red, share(node->left),
+                    assignPath(node->right, key, std::forward<Args>(args)...),
+                    node->value);
+  }
+  return makeNode(node->red, share(node->left), share(node->right),
+                  std::forward<Args>(args)...);
+}
+
+/**
+ * @brief Builds a black node from value and two subtrees, removing a pair
+ * of red nodes in a row in either subtree (Okasaki) or making a red node
+ * with two black children if both subtrees are red (Kahrs).
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+typename PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::Ref
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::balance(
+    Ref left, const value_type &value, Ref right) const {
+  if (isRed(left.get()) && isRed(right.get())) {
+    return makeNode(true, recolor(std::move(left), false),
+                    recolor(std::move(right), false), value);
+  }
+  if (isRed(left.get())) {
+    if (isRed(left->left)) {
+      return makeNode(true, recolor(share(left->left), false),
+                      makeNode(false, share(left->right), std::move(right),
+                               value),
+                      left->value);
+    }
+    if (isRed(left->right)) {
+      const Node *middle = left->right;
+      return makeNode(
+          true,
+          makeNode(false, share(left->left), share(middle->left),
+                   left->value),
+          makeNode(false, share(middle->right), std::move(right), value),
+          middle->value);
+    }
+  }
+  if (isRed(right.get())) {
+    if (isRed(right->right)) {
+      return makeNode(true,
+                      makeNode(false, std::move(left), share(right->left),
+                               value),
+                      recolor(share(right->right), false), right->value);
+    }
+    if (isRed(right->left)) {
+      const Node *middle = right->left;
+      return makeNode(
+          true,
+          makeNode(false, std::move(left), share(middle->left), value),
+          makeNode(false, share(middle->right), share(right->right),
+                   right->value),
+          middle->value);
+    }
+  }
+  return makeNode(false, std::move(left), std::move(right), value);
+}
+
+/**
+ * @brief Copies the search path of a present key without its node (Kahrs).
+ *
+ * Leaving a black child makes its subtree one black node shorter, which
+ * balanceLeft / balanceRight repair on the way back.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+typename PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::Ref
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::erasePath(
+    const Node *node, const key_type &key) const {
+  if (compare_(key, keyOf(node))) {
+    if (isBlack(node->left)) {
+      return balanceLeft(erasePath(node->left, key), node->value,
+                         share(node->right));
+    }
+    return makeNode(true, erasePath(node->left, key), share(node->right),
+                    node->value);
+  }
+  if (compare_(keyOf(node), key)) {
+    if (isBlack(node->right)) {
+      return balanceRight(share(node->left), node->value,
+                          erasePath(node->right, key));
+    }
+    return makeNode(true, share(node->left), erasePath(node->right, key),
+                    node->value);
+  }
+  return fuse(node->left, node->right);
+}
+
+/**
+ * @brief Builds a node whose left subtree is one black node shorter than
+ * the right one.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+typename PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::Ref
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::balanceLeft(
+    Ref left, const value_type &value, Ref right) const {
+  if (isRed(left.get())) {
+    return makeNode(true, recolor(std::move(left), false), std::move(right),
+                    value);
+  }
+  if (isBlack(right.get())) {
+    return balance(std::move(left), value, recolor(std::move(right), true));
+  }
+  // правое поддерево красное, его левый потомок чёрный
+  const Node *middle = right->left;
+  return makeNode(
+      true, makeNode(false, std::move(left), share(middle->left), value),
+      balance(share(middle->right), right->value,
+              recolor(share(right->right), true)),
+      middle->value);
+}
+
+/**
+ * @brief Builds a node whose right subtree is one black node shorter than
+ * the left one.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+typename PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::Ref
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::balanceRight(
+    Ref left, const value_type &value, Ref right) const {
+  if (isRed(right.get())) {
+    return makeNode(true, std::move(left), recolor(std::move(right), false),
+                    value);
+  }
+  if (isBlack(left.get())) {
+    return balance(recolor(std::move(left), true), value, std::move(right));
+  }
+  // левое поддерево красное, его правый потомок чёрный
+  const Node *middle = left->right;
+  return makeNode(true,
+                  balance(recolor(share(left->left), true), left->value,
+                          share(middle->left)),
+                  makeNode(false, share(middle->right), std::move(right),
+                           value),
+                  middle->value);
+}
+
+/**
+ * @brief Joins the two subtrees of an erased node, all keys of left being
+ * less than those of right (Kahrs).
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+typename PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::Ref
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::fuse(
+    const Node *left, const Node *right) const {
+  if (!left) {
+    return share(right);
+  }
+  if (!right) {
+    return share(left);
+  }
+  if (isRed(left) != isRed(right)) {
+    if (isRed(right)) {
+      return makeNode(true, fuse(left, right->left), share(right->right),
+                      right->value);
+    }
+    return makeNode(true, share(left->left), fuse(left->right, right),
+                    left->value);
+  }
+  bool red = isRed(left);
+  Ref middle = fuse(left->right, right->left);
+  if (isRed(middle.get())) {
+    return makeNode(
+        true,
+        makeNode(red, share(left->left), share(middle->left), left->value),
+        makeNode(red, share(middle->right), share(right->right),
+                 right->value),
+        middle->value);
+  }
+  if (red) {
+    return makeNode(true, share(left->left),
+                    makeNode(true, std::move(middle), share(right->right),
+                             right->value),
+                    left->value);
+  }
+  return balanceLeft(share(left->left), left->value,
+                     makeNode(false, std::move(middle), share(right->right),
+                              right->value));
+}
+
+/**
+ * @brief Wraps a new root into a version with the allocator and the order
+ * of this one.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>
+PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::withRoot(
+    Ref root, size_type size) const {
+  PersistentTree tree(root.release(), size, alloc_);
+  tree.compare_ = compare_;
+  return tree;
+}
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+template <typename Fn>
+void PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::visitSubtree(
+    const Node *node, Fn &fn) {
+  while (node) {
+    visitSubtree(node->left, fn);
+    fn(static_cast<const value_type &>(node->value));
+    node = node->right;
+  }
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks the order of keys, the red-black properties, the reference
+ * counters and the element counter.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+bool PersistentTree<Key, Value, KeyOfValue, Compare,
+                    Allocator>::checkInvariants() const {
+  if (isRed(root_)) {
+    return false;
+  }
+  const Node *prev = nullptr;
+  size_type count = 0;
+  return checkSubtree(root_, prev, count) > 0 && count == size_;
+}
+
+/**
+ * @brief Checks a subtree in key order.
+ * @return Black height of the subtree, or -1 if it is broken.
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+          typename Allocator>
+int PersistentTree<Key, Value, KeyOfValue, Compare, Allocator>::checkSubtree(
+    const Node *node, const Node *&prev, size_type &count) const {
+  if (!node) {
+    return 1;
+  }
+  if (node->refs.load(std::memory_order_relaxed) == 0 ||
+      (node->red && (isRed(node->left) || isRed(node->right)))) {
+    return -1;
+  }
+  int left_height = checkSubtree(node->left, prev, count);
+  if (left_height < 0 || (prev && !compare_(keyOf(prev), keyOf(node)))) {
+    return -1;
+  }
+  prev = node;
+  ++count;
+  int right_height = checkSubtree(node->right, prev, count);
+  if (right_height != left_height) {
+    return -1;
+  }
+  return left_height + (node->red ? 0 : 1);
+}
+
+} // namespace s21
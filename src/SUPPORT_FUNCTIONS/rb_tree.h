@@ -16,34 +16,145 @@
 #ifndef CPP2_S21_CONTAINERS_RB_TREE_H_
 #define CPP2_S21_CONTAINERS_RB_TREE_H_
 
+#include <algorithm> // std::sort, std::upper_bound: чужие слэбы пула
+#include <atomic>    // счётчик заданий копирования, ссылки на слэб
+#include <cstdint>   // std::uintptr_t: цвет в адресе родителя
+#include <exception> // std::exception_ptr
 #include <functional> // printMap
 #include <initializer_list>
 #include <iostream>
-#include <stack> // (нужно подключить наш стек и исправить в коде std::) для реализации метода count, deleteSubtree
-#include <utility> // std::pair
+#include <iterator> // std::iterator_traits для построения из диапазона
+#include <limits>   // глубина пути в split
+#include <memory> // std::allocator, std::allocator_traits
+#include <new>
+#include <optional>  // аллокатор пустого node handle
+#include <stdexcept> // std::out_of_range
+#include <thread>
+#include <tuple> // std::piecewise_construct для узлов Map
+#include <type_traits>
+#include <utility> // std::pair, std::in_place
+#include <vector>  // буфер для однопроходных итераторов
+
+#include "../s21_common.h" // RequireInputIter
+
+// S21_RBTREE_NODE_POOL=0 возвращает поштучное выделение узлов через
+// new/delete (используется бенчмарком для сравнения с пулом)
+#ifndef S21_RBTREE_NODE_POOL
+#define S21_RBTREE_NODE_POOL 1
+#endif
+
+// Начиная с этого числа узлов копия дерева строится несколькими потоками
+// (0 отключает параллельное копирование в конструкторе копирования и operator=)
+#ifndef S21_RBTREE_PARALLEL_COPY_MIN
+#define S21_RBTREE_PARALLEL_COPY_MIN 65536
+#endif
+
+// Цвет узла хранится в младшем бите указателя на родителя (0 - отдельное
+// поле bool, узел на одно слово больше)
+#ifndef S21_RBTREE_PACKED_COLOR
+#define S21_RBTREE_PACKED_COLOR 1
+#endif
+
+// Сколько поисков findMany/containsMany ведёт одновременно (1 - по одному,
+// без перекрытия промахов кэша)
+#ifndef S21_RBTREE_BATCH_WIDTH
+#define S21_RBTREE_BATCH_WIDTH 16
+#endif
+
+// Дерево меньше этого размера в байтах обычно лежит в кэше: тогда findMany
+// ищет ключи по одному, перекрывать нечего
+#ifndef S21_RBTREE_BATCH_MIN_BYTES
+#define S21_RBTREE_BATCH_MIN_BYTES (512 * 1024)
+#endif
 
 namespace s21 {
 
 enum how_many_children { no_children, one_child, two_children };
 
-template <typename Key, typename Comparator, bool IsConst>
+/**
+ * @brief Tag type: the range is sorted and contains no equivalent keys.
+ */
+struct sorted_unique_t {
+  explicit sorted_unique_t() = default;
+};
+inline constexpr sorted_unique_t sorted_unique{};
+
+/**
+ * @brief Tag type: the range is sorted, equivalent keys are allowed.
+ */
+struct sorted_equivalent_t {
+  explicit sorted_equivalent_t() = default;
+};
+inline constexpr sorted_equivalent_t sorted_equivalent{};
+
+// Разрешает перегрузку поиска по ключу другого типа только для прозрачного
+// компаратора (например, std::less<>)
+template <typename Compare>
+using RequireTransparent = typename Compare::is_transparent;
+
+template <typename Key, typename Comparator, typename Allocator, bool IsConst>
 class RBTreeBaseIterator;
 
-template <typename Key, typename Comparator> class RBTreeIterator;
+template <typename Key, typename Comparator, typename Allocator>
+class RBTreeIterator;
 
-template <typename Key, typename Comparator> class ConstRBTreeIterator;
+template <typename Key, typename Comparator, typename Allocator>
+class ConstRBTreeIterator;
 
+/**
+ * @brief Links and color of a tree node.
+ *
+ * With S21_RBTREE_PACKED_COLOR the color is kept in the lowest bit of the
+ * parent address, which is always zero because nodes are aligned to at
+ * least two bytes. This saves the padded bool: three words per node instead
+ * of four.
+ */
 template <typename Key, typename Comparator> struct RBTBaseNode {
-  RBTBaseNode *parent_;
+#if S21_RBTREE_PACKED_COLOR
+  static constexpr std::uintptr_t kRedBit = 1;
+#endif
+
   RBTBaseNode *left_;
   RBTBaseNode *right_;
-  bool red_;
 
-  RBTBaseNode()
-      : parent_(nullptr), left_(nullptr), right_(nullptr), red_(false) {}
+  RBTBaseNode() : left_(nullptr), right_(nullptr) {}
 
   RBTBaseNode(RBTBaseNode *parent, RBTBaseNode *left, RBTBaseNode *right)
-      : parent_(parent), left_(left), right_(right), red_(false) {}
+      : left_(left), right_(right) {
+    setParent(parent);
+  }
+
+#if S21_RBTREE_PACKED_COLOR
+  RBTBaseNode *parent() const noexcept {
+    return reinterpret_cast<RBTBaseNode *>(parent_ & ~kRedBit);
+  }
+  void setParent(RBTBaseNode *parent) noexcept {
+    parent_ = reinterpret_cast<std::uintptr_t>(parent) | (parent_ & kRedBit);
+  }
+  bool isRed() const noexcept { return (parent_ & kRedBit) != 0; }
+  void setRed(bool red) noexcept {
+    parent_ = (parent_ & ~kRedBit) | static_cast<std::uintptr_t>(red);
+  }
+#else
+  RBTBaseNode *parent() const noexcept { return parent_; }
+  void setParent(RBTBaseNode *parent) noexcept { parent_ = parent; }
+  bool isRed() const noexcept { return red_; }
+  void setRed(bool red) noexcept { red_ = red; }
+#endif
+
+  static void swapColors(RBTBaseNode *a, RBTBaseNode *b) noexcept {
+    bool red = a->isRed();
+    a->setRed(b->isRed());
+    b->setRed(red);
+  }
+
+private:
+#if S21_RBTREE_PACKED_COLOR
+  std::uintptr_t parent_ = 0; // адрес родителя, младший бит - цвет
+#else
+  RBTBaseNode *parent_ = nullptr;
+  bool red_ = false;
+#endif
 };
 
 template <typename Key, typename Comparator>
@@ -52,15 +163,217 @@ struct RBTNode : public RBTBaseNode<Key, Comparator> {
   using reference = Key &;
   using const_reference = const Key &;
   Key key_;
+  std::size_t size_ = 1; // число узлов в поддереве с корнем в этом узле
+
+#if S21_RBTREE_PACKED_COLOR
+  // заголовок дерева - сам RBTBaseNode, его адрес тоже хранится в parent_
+  static_assert(alignof(RBTBaseNode<Key, Comparator>) >
+                    RBTBaseNode<Key, Comparator>::kRedBit,
+                "the lowest bit of a node address must be free");
+#endif
 
   RBTNode(const_reference key) : key_(key) {
-    this->red_ = true; // цвет узла красный
+    this->setRed(true); // цвет узла красный
+  }
+
+  // перемещение pair<const K, V> копирует K и может бросить
+  RBTNode(key_type &&key) noexcept(
+      std::is_nothrow_move_constructible<key_type>::value)
+      : key_(std::move(key)) {
+    this->setRed(true);
   }
 
-  RBTNode(key_type &&key) noexcept : key_(std::move(key)) { this->red_ = true; }
+  // ключ строится прямо в узле из аргументов emplace
+  template <typename... Args>
+  explicit RBTNode(std::in_place_t, Args &&...args)
+      : key_(std::forward<Args>(args)...) {
+    this->setRed(true);
+  }
+};
+
+/**
+ * @brief Slab allocator for tree nodes.
+ *
+ * Nodes are carved out of large slabs, freed nodes go to an intrusive free
+ * list and are reused by the next allocation. All slabs are returned to the
+ * allocator at once by release(). Slabs (or single nodes when the pool is
+ * disabled) are obtained from Allocator rebound to the slot type.
+ *
+ * Every slab counts the pools and node handles that refer to it and is
+ * freed by the last of them. When a tree is split, both halves keep nodes
+ * in the same slabs: the second pool takes a reference to each of them. A
+ * node handle references only the slab its node lives in, so an extracted
+ * node stays in its slot without keeping the rest of the tree's memory.
+ */
+template <typename Node, typename Allocator> class RBTNodePool {
+private:
+  // ячейка памяти под один узел
+  struct alignas(Node) Slot {
+    unsigned char bytes_[sizeof(Node)];
+  };
+
+  using slot_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Slot>;
+  using slot_traits = std::allocator_traits<slot_allocator>;
+  using node_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+  static_assert(std::is_same<typename slot_traits::pointer, Slot *>::value &&
+                    std::is_same<typename node_traits::pointer, Node *>::value,
+                "allocators with fancy pointers are not supported");
+#if S21_RBTREE_PACKED_COLOR
+  static_assert(alignof(Node) > Node::kRedBit && alignof(Slot) > Node::kRedBit,
+                "the lowest bit of a node address must be free");
+#endif
+
+public:
+  using size_type = std::size_t;
+  using allocator_type = Allocator;
+
+  static constexpr bool kPooled = S21_RBTREE_NODE_POOL != 0;
+
+  explicit RBTNodePool(const allocator_type &alloc) noexcept;
+  RBTNodePool(const RBTNodePool &) = delete;
+  RBTNodePool(RBTNodePool &&other) noexcept;
+  ~RBTNodePool() noexcept;
+  RBTNodePool &operator=(const RBTNodePool &) = delete;
+  RBTNodePool &operator=(RBTNodePool &&other) noexcept;
+
+  Node *allocate();
+  Node *allocateBulk(size_type count);
+  void deallocate(Node *node) noexcept;
+  void reserve(size_type count);
+  void release() noexcept;
+  void swap(RBTNodePool &other) noexcept;
+
+  // Nodes living outside of the tree (node handles) and moving between trees:
+  void *pinSlab(const Node *node) noexcept;
+  void adoptSlab(void *slab);
+  static void deallocateDetached(const allocator_type &alloc, Node *node,
+                                 void *slab) noexcept;
+  void splice(RBTNodePool &other);
+  void spliceShared(RBTNodePool &other);
+  void share(RBTNodePool &other);
+
+  allocator_type get_allocator() const noexcept;
+  bool canAdopt(const RBTNodePool &other) const noexcept;
+  bool canSplice(const RBTNodePool &other) const noexcept;
+  void copyAllocator(const RBTNodePool &other) noexcept;
+
+  size_type capacity() const noexcept;
+  size_type available() const noexcept;
+
+private:
+  // свободная ячейка хранит указатель на следующую свободную
+  struct FreeSlot {
+    FreeSlot *next_;
+  };
+  // нулевая ячейка каждого слэба хранит его заголовок
+  struct SlabHeader {
+    explicit SlabHeader(size_type slots) noexcept
+        : next_(nullptr), slots_(slots), refs_(1) {}
+
+    Slot *next_; // следующий слэб этого же пула
+    size_type slots_;
+    std::atomic<size_type> refs_; // пулы и node handle, которые держат слэб
+  };
+
+  using pin_allocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<Slot *>;
+  using pin_traits = std::allocator_traits<pin_allocator>;
+
+  static_assert(std::is_same<typename pin_traits::pointer, Slot **>::value,
+                "allocators with fancy pointers are not supported");
+  static_assert(sizeof(FreeSlot) <= sizeof(Slot), "node is too small");
+  static_assert(sizeof(SlabHeader) <= sizeof(Slot), "node is too small");
+
+  static constexpr size_type kMinSlab = 32;
+  static constexpr size_type kMaxSlab = 1 << 16;
+  static constexpr size_type kMinPins = 8;
+
+  void addSlab(size_type slots);
+  Slot *findSlab(const Slot *slot) const noexcept;
+  bool ownsSlab(const Slot *slab) const noexcept;
+  bool holdsSlab(const Slot *slab) const noexcept;
+  size_type countSlabs() const noexcept;
+  void reservePins(size_type count);
+  void insertPin(Slot *slab) noexcept;
+  void releasePins() noexcept;
+  static void unrefSlab(slot_allocator &alloc, Slot *slab) noexcept;
+  static void freeSlabs(slot_allocator &alloc, Slot *slabs) noexcept;
+
+  slot_allocator alloc_;
+  Slot *slabs_; // слэбы, выделенные этим пулом
+  Slot **pins_; // слэбы других пулов с нашими узлами, по адресам
+  size_type pin_count_;
+  size_type pin_room_;
+  FreeSlot *free_list_;
+  Slot *bump_;
+  Slot *bump_end_;
+  size_type capacity_;
+    size_type available_;
+};
+
+/**
+ * @brief Node handle: owns a node extracted from an RBTree.
+ *
+ * The node can be inserted into another tree with an equal allocator without
+ * copying the key. A handle that is destroyed still owning a node destroys
+ * it. With the node pool the node stays in a slab of the tree it was
+ * extracted from, and the handle keeps that one slab alive.
+ */
+template <typename Key, typename Comparator, typename Allocator>
+class RBTNodeHandle {
+public:
+  using value_type = Key;
+  using allocator_type = Allocator;
+
+  RBTNodeHandle() noexcept : node_(nullptr), slab_(nullptr) {}
+  RBTNodeHandle(RBTNodeHandle &&other) noexcept;
+  RBTNodeHandle &operator=(RBTNodeHandle &&other) noexcept;
+  RBTNodeHandle(const RBTNodeHandle &) = delete;
+  RBTNodeHandle &operator=(const RBTNodeHandle &) = delete;
+  ~RBTNodeHandle() noexcept;
+
+  bool empty() const noexcept { return node_ == nullptr; }
+  explicit operator bool() const noexcept { return node_ != nullptr; }
+  allocator_type get_allocator() const { return *alloc_; }
+
+  value_type &value() const { return node_->key_; }
+  // ключ и значение узла Map (value_type - std::pair<const Key, T>)
+  template <typename V = Key>
+  typename std::remove_const<typename V::first_type>::type &key() const;
+  template <typename V = Key> typename V::second_type &mapped() const;
+
+  void swap(RBTNodeHandle &other) noexcept;
+
+private:
+  template <typename, typename, typename> friend class RBTree;
+  using Node = RBTNode<Key, Comparator>;
+  using node_pool = RBTNodePool<Node, Allocator>;
+
+  RBTNodeHandle(Node *node, const allocator_type &alloc, void *slab) noexcept
+      : node_(node), alloc_(alloc), slab_(slab) {}
+  Node *release() noexcept;
+
+  Node *node_;
+  std::optional<allocator_type> alloc_;
+  void *slab_; // слэб, в котором лежит узел (с пулом)
 };
 
-template <typename Key, typename Comparator = std::less<Key>> class RBTree {
+/**
+ * @brief Result of inserting a node handle into a container with unique keys.
+ */
+template <typename Iterator, typename NodeHandle> struct RBTInsertReturn {
+  Iterator position;
+  bool inserted;
+  NodeHandle node; // узел, если вставка не произошла
+};
+
+template <typename Key, typename Comparator = std::less<Key>,
+          typename Allocator = std::allocator<Key>>
+class RBTree {
 public:
   // RBTree Member type:
   using key_type = Key;
@@ -68,29 +381,58 @@ public:
   using reference = Key &;
   using const_reference = const key_type &;
   using size_type = std::size_t;
+  using allocator_type = Allocator;
   using Node = RBTNode<Key, Comparator>;
   using BaseNode = RBTBaseNode<Key, Comparator>;
-  using iterator = RBTreeIterator<Key, Comparator>;
-  using const_iterator = ConstRBTreeIterator<Key, Comparator>;
+  using node_pool = RBTNodePool<Node, Allocator>;
+  using iterator = RBTreeIterator<Key, Comparator, Allocator>;
+  using const_iterator = ConstRBTreeIterator<Key, Comparator, Allocator>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+  using node_handle = RBTNodeHandle<Key, Comparator, Allocator>;
+
+  static_assert(std::is_same<typename Allocator::value_type, Key>::value,
+                "Allocator::value_type must be the same as Key");
+
+  // перемещающее присваивание только перевешивает узлы, если аллокатор
+  // переходит вместе с ними или любые два аллокатора равны
+  static constexpr bool kNothrowMoveAssign =
+      std::allocator_traits<
+          Allocator>::propagate_on_container_move_assignment::value ||
+      std::allocator_traits<Allocator>::is_always_equal::value;
+
+  static constexpr size_type kParallelCopyMin = S21_RBTREE_PARALLEL_COPY_MIN;
+  // с какой длины диапазон стирается через split/join, а не по одному
+  static constexpr size_type kBulkEraseMin = 32;
+  // сколько спусков по дереву выполняются вперемешку в findMany
+  static constexpr size_type kBatchWidth = S21_RBTREE_BATCH_WIDTH;
+  static_assert(kBatchWidth > 0, "S21_RBTREE_BATCH_WIDTH must be positive");
+  static constexpr size_type kBatchMinBytes = S21_RBTREE_BATCH_MIN_BYTES;
 
   RBTree();
+  explicit RBTree(const allocator_type &alloc);
   RBTree(std::initializer_list<node_type> const &items);
   RBTree(const RBTree &other);
   RBTree(RBTree &&other) noexcept;
   ~RBTree() noexcept;
-  RBTree &operator=(const RBTree<Key, Comparator> &other);
-  RBTree &operator=(RBTree<Key, Comparator> &&other) noexcept;
+  RBTree &operator=(const RBTree &other);
+  RBTree &operator=(RBTree &&other) noexcept(kNothrowMoveAssign);
+
+  allocator_type get_allocator() const noexcept;
 
   // Main methods:
   size_type size() const noexcept;
   size_type max_size() const;
   bool empty() const;
-  size_type count(const Key &key) const noexcept;
+  size_type count(const Key &key) const;
+  size_type count_range(const Key &lo, const Key &hi) const;
 
+  void reserve(size_type count);
   void clear();
+  void copyFrom(const RBTree &other, unsigned threads = 0);
   void swap(RBTree &other) noexcept;
-  void merge(RBTree &other) noexcept;
-  void mergeUnique(RBTree &other) noexcept;
+  void merge(RBTree &other);
+  void mergeUnique(RBTree &other);
   bool contains(const key_type &key) const;
   iterator find(const_reference key);
   const_iterator find(const_reference key) const;
@@ -99,35 +441,243 @@ public:
   iterator upper_bound(const Key &key);
   const_iterator upper_bound(const Key &key) const;
 
+  // Heterogeneous lookup (transparent comparators only):
+  template <typename K, typename C = Comparator,
+            typename = RequireTransparent<C>>
+  size_type count(const K &key) const;
+  template <typename K, typename C = Comparator,
+            typename = RequireTransparent<C>>
+  size_type count_range(const K &lo, const K &hi) const;
+  template <typename K, typename C = Comparator,
+            typename = RequireTransparent<C>>
+  bool contains(const K &key) const;
+  template <typename K, typename C = Comparator,
+            typename = RequireTransparent<C>>
+  iterator find(const K &key);
+  template <typename K, typename C = Comparator,
+            typename = RequireTransparent<C>>
+  const_iterator find(const K &key) const;
+  template <typename K, typename C = Comparator,
+            typename = RequireTransparent<C>>
+  iterator lower_bound(const K &key);
+  template <typename K, typename C = Comparator,
+            typename = RequireTransparent<C>>
+  const_iterator lower_bound(const K &key) const;
+  template <typename K, typename C = Comparator,
+            typename = RequireTransparent<C>>
+  iterator upper_bound(const K &key);
+  template <typename K, typename C = Comparator,
+            typename = RequireTransparent<C>>
+  const_iterator upper_bound(const K &key) const;
+  template <typename K, typename C = Comparator,
+            typename = RequireTransparent<C>>
+  size_type rank(const K &key) const;
+
+  // Batched lookup (the descents of several keys are interleaved):
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt findMany(ForwardIt first, ForwardIt last, OutputIt out);
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt findMany(ForwardIt first, ForwardIt last, OutputIt out) const;
+  template <typename ForwardIt, typename OutputIt>
+  OutputIt containsMany(ForwardIt first, ForwardIt last, OutputIt out) const;
+
   Node *getMinNode(Node *node) const;
   Node *getMaxNode(Node *node) const;
   const Node *getRoot() const;
 
+  // Node navigation (iterators work without a pointer to the tree):
+  static bool isHeader(const BaseNode *node) noexcept;
+  static BaseNode *nextNode(const BaseNode *node) noexcept;
+  static BaseNode *prevNode(const BaseNode *node) noexcept;
+  static Node *getNthNode(const BaseNode *root, size_type k) noexcept;
+  static size_type getNodeIndex(const BaseNode *node) noexcept;
+
+  // Order statistics:
+  size_type rank(const Key &key) const;
+  iterator nth(size_type k) noexcept;
+  const_iterator nth(size_type k) const noexcept;
+  const_reference select(size_type k) const;
+
   iterator begin() noexcept;
   iterator end() noexcept;
   const_iterator begin() const noexcept;
   const_iterator end() const noexcept;
   const_iterator cbegin() const noexcept;
   const_iterator cend() const noexcept;
+  reverse_iterator rbegin() noexcept;
+  reverse_iterator rend() noexcept;
+  const_reverse_iterator rbegin() const noexcept;
+  const_reverse_iterator rend() const noexcept;
 
   void erase(iterator pos);
+  iterator erase(const_iterator first, const_iterator last);
+  template <typename K> size_type eraseEqual(const K &key);
+  template <typename Pred> size_type eraseIf(Pred pred);
   std::pair<iterator, bool> insert(const key_type &key);
+  std::pair<iterator, bool> insert(key_type &&key);
   std::pair<iterator, bool> insertUnique(const key_type &key);
+  std::pair<iterator, bool> insertUnique(key_type &&key);
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args);
+  template <typename... Args>
+  std::pair<iterator, bool> emplaceUnique(Args &&...args);
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> tryEmplace(const K &key, Args &&...args);
+
+  // Node handles:
+  node_handle extract(const_iterator pos);
+  node_handle extract(const key_type &key);
+  std::pair<iterator, bool> insert(node_handle &&handle);
+  std::pair<iterator, bool> insertUnique(node_handle &&handle);
+
+  // Hinted insertion (O(1) comparisons when hint is next to the place):
+  iterator insert(const_iterator hint, const key_type &key);
+  iterator insert(const_iterator hint, key_type &&key);
+  iterator insertUnique(const_iterator hint, const key_type &key);
+  iterator insertUnique(const_iterator hint, key_type &&key);
+  template <typename... Args>
+  iterator emplaceHint(const_iterator hint, Args &&...args);
+  template <typename... Args>
+  iterator emplaceHintUnique(const_iterator hint, Args &&...args);
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> tryEmplaceHint(const_iterator hint, const K &key,
+                                           Args &&...args);
+
+  // Bulk construction:
+  template <typename InputIt>
+  void assign(InputIt first, InputIt last, bool unique);
+  template <typename InputIt>
+  void assignSorted(InputIt first, InputIt last, bool unique);
+  template <typename InputIt>
+  void assignSortedN(InputIt first, size_type count, size_type reserve,
+                     bool unique);
+
+  // Set algebra (one pass over both sorted trees, O(n + m)):
+  RBTree setUnion(const RBTree &other, unsigned threads = 0) const;
+  RBTree setIntersection(const RBTree &other, unsigned threads = 0) const;
+  RBTree setDifference(const RBTree &other, unsigned threads = 0) const;
+  RBTree symmetricDifference(const RBTree &other, unsigned threads = 0) const;
+
+  // Split and join (O(log n), nodes are relinked, not copied):
+  template <typename K> RBTree split(const K &key);
+  void join(RBTree &other);
+  void joinUnique(RBTree &other);
 
 private:
   // Auxiliary methods:
-  void countUniqueKey(const Key &key, Node *node,
-                      size_type &count) const noexcept;
+  template <typename K>
+  size_type countLess(const K &key, bool or_equal) const;
+  static size_type subtreeSize(const BaseNode *node) noexcept;
+  static void updateSize(Node *node) noexcept;
+  void decrementSizes(BaseNode *node) noexcept;
+
+  // Header node:
+  Node *root() const noexcept;
+  void setRoot(Node *node) noexcept;
+  void resetHeader() noexcept;
+  void adoptHeader() noexcept;
+  void updateExtremes() noexcept;
+  iterator makeIterator(BaseNode *node) noexcept;
+  const_iterator makeIterator(const BaseNode *node) const noexcept;
   std::pair<iterator, bool> insert(const key_type &key, bool unique);
+  std::pair<iterator, bool> insert(key_type &&key, bool unique);
+  template <typename Arg>
+  std::pair<iterator, bool> insertKey(Arg &&key, bool unique);
+  template <typename Arg>
+  iterator insertKeyHint(const_iterator hint, Arg &&key, bool unique);
+  std::pair<iterator, bool> insertHandle(node_handle &&handle, bool unique);
+  void mergeNodes(RBTree &other, bool unique);
+  Node *detachAll() noexcept;
+  static void resetNode(Node *node) noexcept;
   void deleteSubtree(Node *node);
 
-  Node *findNode(const key_type &key) const;
+  template <typename... Args> Node *createNode(Args &&...args);
+  void destroyNode(Node *node) noexcept;
+
+  template <typename K> Node *findNode(const K &key) const;
+  template <typename K> Node *lowerBoundNode(const K &key) const;
+  template <typename K> Node *upperBoundNode(const K &key) const;
+  template <typename ForwardIt, typename Fn>
+  void findBatch(ForwardIt first, ForwardIt last, Fn &&fn) const;
   Node *findMinNode(Node *node) const;
   Node *findMaxNode(Node *node) const;
-  Node *CopyTree(Node *node, Node &fake_node);
+
+  // Auxiliary copy methods:
+  // поддерево other, которое копирует один рабочий поток
+  struct CopyTask {
+    const Node *source;
+    Node *parent;
+    BaseNode **link;
+    size_type size;
+    Node *slots;
+    std::exception_ptr error;
+  };
+
+  static unsigned copyThreads(size_type count, unsigned threads);
+  void copyNodes(const RBTree &other, unsigned threads);
+  void copyTop(const Node *node, Node *parent, BaseNode **link,
+               size_type depth, size_type split_depth, Node *&slots,
+               std::vector<CopyTask> &tasks);
+  void CopyTree(const Node *node, Node *parent, BaseNode **link,
+                Node *&slots);
+  template <typename Fn>
+  static void runParallel(size_type tasks, unsigned threads, Fn fn);
+
+  // Auxiliary bulk construction methods:
+  template <typename ForwardIt>
+  bool sortedCount(ForwardIt first, ForwardIt last, bool unique,
+                   size_type &count) const;
+  template <typename ForwardIt>
+  void buildSorted(ForwardIt first, ForwardIt last, size_type count,
+                   size_type reserve, bool unique);
+  template <typename ForwardIt>
+  Node *buildSubtree(ForwardIt &it, ForwardIt last, size_type count,
+                     size_type depth, size_type red_depth, bool unique);
+
+  // Auxiliary set algebra methods:
+  // какие ключи попадают в результат: только из this, только из other и
+  // общие (из this)
+  enum SetPart : unsigned { kOnlyThis = 1, kOnlyOther = 2, kInBoth = 4 };
+
+  // обходит указатели на ключи как сами ключи - для buildSorted()
+  struct KeyRefIterator {
+    const Key *const *ptr;
+
+    const Key &operator*() const noexcept { return **ptr; }
+    KeyRefIterator &operator++() noexcept {
+      ++ptr;
+      return *this;
+    }
+    bool operator!=(const KeyRefIterator &other) const noexcept {
+      return ptr != other.ptr;
+    }
+  };
+
+  RBTree setOperation(const RBTree &other, unsigned parts,
+                      unsigned threads) const;
+  void collectSetPart(const_iterator first1, const_iterator last1,
+                      const_iterator first2, const_iterator last2,
+                      unsigned parts, std::vector<const Key *> &out) const;
+  void buildPieces(const std::vector<std::vector<const Key *>> &pieces,
+                   unsigned threads);
+  static Node *linkSorted(Node *nodes, size_type count, size_type depth,
+                          size_type red_depth) noexcept;
+
+  // Auxiliary split and join methods:
+  void splitAt(size_type index, RBTree &right) noexcept;
+  void eraseRun(const_iterator first, const_iterator last, size_type count);
+  void joinTrees(RBTree &other, bool unique);
+  void joinWith(Node *mid, Node *subtree, size_type subtree_height,
+                bool to_right, size_type &height) noexcept;
 
   // Auxiliary insertion and balancing methods:
-  void insertNode(Node *root, Node *new_node);
+  template <typename K>
+  Node *findInsertPosition(const K &key, bool unique, Node *&parent,
+                           bool &to_left) const;
+  template <typename K>
+  Node *findHintPosition(const_iterator hint, const K &key, bool unique,
+                         Node *&parent, bool &to_left) const;
+  iterator linkNode(Node *new_node, Node *parent, bool to_left);
   void insertFixup(Node *node);
 
   bool leftDadRightSon(Node *node);
@@ -136,8 +686,6 @@ private:
   bool rightDadRightSon(Node *node);
 
   bool redUncle(Node *node);
-  bool doubleRed(Node *node);
-  void doubleRedFixup(Node *node);
   void redUncleChangeColors(Node *node);
 
   void blackUncleFixup(Node *node);
@@ -175,21 +723,22 @@ private:
   void mirrorRNephewsRedLNephewsAny(Node *node);     // (case_3b)
   void mirrorRedSibling(Node *node);                 // (case_4b)
 
-  void eraseFixup(Node *node);
+  void eraseFixup(Node *node, Node *parent);
 
-  void noChildren(Node *eraised_node, Node *&to_fix);
-  void oneChildren(Node *eraised_node, Node *&to_fix, bool *color);
-  void twoChildren(Node *eraised_node, Node *&to_fix, bool *color);
+  void noChildren(Node *eraised_node, Node *&to_fix, Node *&to_fix_parent);
+  void oneChildren(Node *eraised_node, Node *&to_fix, Node *&to_fix_parent);
+  void twoChildren(Node *eraised_node, Node *&to_fix, Node *&to_fix_parent,
+                   bool *color);
   char howManyChildren(Node *node);
 
-  void swapNodes(Node *eraised_node, Node *successor);
   void transplant(Node *eraised_node, Node *successor);
-  void eraseNode(Node *node, Node *&to_fix, bool *color);
+  void unlinkNode(Node *node) noexcept;
+  void eraseNode(Node *node, Node *&to_fix, Node *&to_fix_parent, bool *color);
 
   // Debugging methods:
 public:
-  void printTree() const { printNode(root_); }
-  void drawTree() { printRBTree(root_, 0); }
+  void printTree() const { printNode(root()); }
+  void drawTree() { printRBTree(root(), 0); }
 
   void printMap(const Node *node, int depth,
                 std::function<void(const Node *, int)> printNodeFunc) const;
@@ -203,14 +752,16 @@ private:
   void printNILNode(int depth, int blackHeight);
 
 private:
-  Node *root_;
-  BaseNode fake_node_;
+  // заголовок: parent() - корень, left_/right_ - минимальный и максимальный
+  // узлы (в пустом дереве - сам заголовок); он же позиция end()
+  BaseNode header_;
   size_type size_ = 0;
   Comparator comparator_;
+  node_pool pool_;
 };
 
 // Base iterator:
-template <typename Key, typename Comparator, bool IsConst>
+template <typename Key, typename Comparator, typename Allocator, bool IsConst>
 class RBTreeBaseIterator {
 public:
   using iterator_category =
@@ -224,24 +775,14 @@ public:
       std::ptrdiff_t; // difference_type - это тип,
                       // представляющий расстояние между двумя итераторами,
                       // используется в арифметических операциях с итераторами
-  using tree_reference =
-      typename std::conditional<IsConst, const RBTree<Key, Comparator> &,
-                                RBTree<Key, Comparator> &>::
-          type; // Псевдоним 'tree_ref' представляет тип, который является
-                // ссылкой на const или non-const объект RBTree,
-                //  в зависимости от значения параметра шаблона 'IsConst'.
-                // Это позволяет классу RBTreeBaseIterator работать
-                // как с const, так и с non-const итераторами.
-
-  RBTreeBaseIterator() = delete; // не нужен конструктор по умолчанию
-                                 // для пустого итератора - удаляем его
 
-  explicit RBTreeBaseIterator(tree_reference tree,
-                              typename RBTree<Key, Comparator>::Node *node)
-      : tree_(tree), current_(node) {}
+  // итератор хранит только указатель на узел (или заголовок для end()),
+  // поэтому его можно создать пустым, копировать и присваивать
+  RBTreeBaseIterator() noexcept : current_(nullptr) {}
 
-  RBTreeBaseIterator(const RBTreeBaseIterator &other)
-      : tree_(other.tree_), current_(other.current_) {} // copy constructor
+  explicit RBTreeBaseIterator(
+      typename RBTree<Key, Comparator, Allocator>::BaseNode *node) noexcept
+      : current_(node) {}
 
   reference operator*() const;
   pointer operator->() const;
@@ -250,36 +791,32 @@ public:
   bool operator==(const RBTreeBaseIterator &other) const noexcept;
 
 protected:
-  using Node = typename RBTree<Key, Comparator>::Node;
+  using Tree = RBTree<Key, Comparator, Allocator>;
+  using Node = typename Tree::Node;
+  using BaseNode = typename Tree::BaseNode;
 
-  Node *getCurrentNode() const {
-    return const_cast<Node *>(static_cast<const Node *>(current_));
-  }
+  Node *getCurrentNode() const { return static_cast<Node *>(current_); }
 
-  void increment();
-  void decrement();
+  void increment() noexcept;
+  void decrement() noexcept;
+  void jump(difference_type n) noexcept;
 
-  tree_reference tree_;
-  Node *current_; // указатель на текущий узел
+  BaseNode *current_; // указатель на текущий узел
 };
 
 // Iterator:
-template <typename Key, typename Comparator>
-class RBTreeIterator : public RBTreeBaseIterator<Key, Comparator, false> {
+template <typename Key, typename Comparator, typename Allocator>
+class RBTreeIterator
+    : public RBTreeBaseIterator<Key, Comparator, Allocator, false> {
 public:
-  using Base = RBTreeBaseIterator<Key, Comparator, false>;
+  using Base = RBTreeBaseIterator<Key, Comparator, Allocator, false>;
   using Node = typename Base::Node;
+  using BaseNode = typename Base::BaseNode;
   using iterator = RBTreeIterator;
 
-  explicit RBTreeIterator(RBTree<Key, Comparator> &tree,
-                          typename RBTree<Key, Comparator>::Node *node)
-      : Base(tree, node) {
-  } // конструктор инициализирует новый объект RBTree и указатель на Node
-    // для доступа к полям RBTree через объект tree_
-    // explicit запрещает неявное преобразование типов
-
-  RBTreeIterator(const RBTreeIterator &other)
-      : Base(other) {} // copy constructor
+  RBTreeIterator() noexcept = default;
+  explicit RBTreeIterator(BaseNode *node) noexcept
+      : Base(node) {} // explicit запрещает неявное преобразование типов
 
   Node *getCurrentNode() const { return Base::getCurrentNode(); }
 
@@ -287,29 +824,25 @@ public:
   iterator operator++(int);
   iterator &operator--();
   iterator operator--(int);
-
-  iterator &operator=(const iterator &other) {
-    if (this != &other) {
-      this->tree_ = other.tree_;
-      this->current_ = other.current_;
-    }
-    return *this;
-  }
+  iterator &advance(typename Base::difference_type n) noexcept;
 };
 
 // Constant iterator:
-template <typename Key, typename Comparator>
-class ConstRBTreeIterator : public RBTreeBaseIterator<Key, Comparator, true> {
+template <typename Key, typename Comparator, typename Allocator>
+class ConstRBTreeIterator
+    : public RBTreeBaseIterator<Key, Comparator, Allocator, true> {
 public:
-  using Base = RBTreeBaseIterator<Key, Comparator, true>;
+  using Base = RBTreeBaseIterator<Key, Comparator, Allocator, true>;
   using Node = typename Base::Node;
+  using BaseNode = typename Base::BaseNode;
   using iterator = ConstRBTreeIterator;
 
-  explicit ConstRBTreeIterator(const RBTree<Key, Comparator> &tree, Node *node)
-      : RBTreeBaseIterator<Key, Comparator, true>(tree, node) {}
-
-  ConstRBTreeIterator(const ConstRBTreeIterator &other)
-      : Base(other) {} // copy constructor
+  ConstRBTreeIterator() noexcept = default;
+  explicit ConstRBTreeIterator(const BaseNode *node) noexcept
+      : Base(const_cast<BaseNode *>(node)) {}
+  ConstRBTreeIterator(
+      const RBTreeIterator<Key, Comparator, Allocator> &other) noexcept
+      : Base(other.getCurrentNode()) {} // iterator -> const_iterator
 
   const Node *getCurrentNode() const { return Base::getCurrentNode(); }
 
@@ -317,14 +850,7 @@ public:
   iterator operator++(int);
   iterator &operator--();
   iterator operator--(int);
-
-  iterator &operator=(const iterator &other) {
-    if (this != &other) {
-      this->tree_ = other.tree_;
-      this->current_ = other.current_;
-    }
-    return *this;
-  }
+  iterator &advance(typename Base::difference_type n) noexcept;
 };
 
 } //  namespace s21
@@ -16,885 +16,4454 @@
 namespace s21 {
 
 /******************************************************************************
- * CONSTRUCTOR & DESTRUCTOR
+ * NODE POOL
  ******************************************************************************/
 
 /**
- * The default constructor for the RBTree class.
- *
- * @param N/A
+ * @brief Constructor, the pool owns no memory until the first allocation.
  *
- * @return N/A
+ * @param alloc Allocator the slabs are obtained from
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-RBTree<Key, Comparator>::RBTree()
-    : root_(nullptr), size_(0), comparator_(Comparator()) {
-  fake_node_.left_ = nullptr; // sentinel node
-  fake_node_.right_ = nullptr;
-  fake_node_.parent_ = nullptr;
-  fake_node_.red_ = false;
-}
+template <typename Node, typename Allocator>
+RBTNodePool<Node, Allocator>::RBTNodePool(const allocator_type &alloc) noexcept
+    : alloc_(alloc), slabs_(nullptr), pins_(nullptr), pin_count_(0),
+      pin_room_(0), free_list_(nullptr), bump_(nullptr), bump_end_(nullptr),
+      capacity_(0), available_(0) {}
 
 /**
- * Initializer list constructor.
+ * @brief Move constructor, takes over the allocator and all slabs of other.
  *
- * @brief initializer list constructor,
- * creates the RBTree initialized using std::initializer_list
+ * @param other Pool to be moved
  *
- * @param items List of lists of value_type
- * for initializing the RBTree
+ * @throws N/A
+ */
+template <typename Node, typename Allocator>
+RBTNodePool<Node, Allocator>::RBTNodePool(RBTNodePool &&other) noexcept
+    : alloc_(std::move(other.alloc_)), slabs_(nullptr), pins_(nullptr),
+      pin_count_(0), pin_room_(0), free_list_(nullptr), bump_(nullptr),
+      bump_end_(nullptr), capacity_(0), available_(0) {
+  std::swap(slabs_, other.slabs_);
+  std::swap(pins_, other.pins_);
+  std::swap(pin_count_, other.pin_count_);
+  std::swap(pin_room_, other.pin_room_);
+  std::swap(free_list_, other.free_list_);
+  std::swap(bump_, other.bump_);
+  std::swap(bump_end_, other.bump_end_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(available_, other.available_);
+}
+
+/**
+ * @brief Destructor, returns all slabs to the allocator.
  *
- * @throws None
+ * @throws N/A
  */
-template <typename Key, typename Comparator>
-RBTree<Key, Comparator>::RBTree(std::initializer_list<node_type> const &items)
-    : RBTree() {
-  for (const auto &item : items) {
-    insert(item);
-  }
+template <typename Node, typename Allocator>
+RBTNodePool<Node, Allocator>::~RBTNodePool() noexcept {
+  release();
 }
 
 /**
- * @brief Constructor for creating a copy of the RBTree object.
+ * @brief Move assignment operator.
  *
- * @param other RBTree object to be copied
+ * The allocator is taken from other only if it propagates on move
+ * assignment, the caller must check canAdopt() beforehand.
  *
- * @return N/A
+ * @param other Pool to be moved
+ *
+ * @return *this
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-RBTree<Key, Comparator>::RBTree(const RBTree &other) : RBTree() {
-  for (const auto item : other) {
-    insert(item);
+template <typename Node, typename Allocator>
+RBTNodePool<Node, Allocator> &
+RBTNodePool<Node, Allocator>::operator=(RBTNodePool &&other) noexcept {
+  if (this != &other) {
+    release();
+    if constexpr (slot_traits::propagate_on_container_move_assignment::value) {
+      alloc_ = std::move(other.alloc_);
+    }
+    std::swap(slabs_, other.slabs_);
+    std::swap(pins_, other.pins_);
+    std::swap(pin_count_, other.pin_count_);
+    std::swap(pin_room_, other.pin_room_);
+    std::swap(free_list_, other.free_list_);
+    std::swap(bump_, other.bump_);
+    std::swap(bump_end_, other.bump_end_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(available_, other.available_);
   }
+  return *this;
 }
 
 /**
- * @brief Constructor for moving RBTree object.
+ * @brief Returns raw memory for one node.
  *
- * @param other RBTree object to be moved
+ * The free list is used first, then the unused tail of the current slab. A
+ * new slab is allocated only when both are exhausted. The node itself is not
+ * constructed.
  *
- * @return N/A
+ * @return Node* Uninitialized memory for one node.
  *
- * @throws N/A
+ * @throws std::bad_alloc
  */
-template <typename Key, typename Comparator>
-RBTree<Key, Comparator>::RBTree(RBTree &&other) noexcept
-    : root_(other.root_), fake_node_(), size_(other.size_),
-      comparator_(other.comparator_) {
-  other.root_ = nullptr;
-  other.fake_node_ = BaseNode();
-  other.size_ = 0;
-  other.comparator_ = Comparator();
+template <typename Node, typename Allocator>
+Node *RBTNodePool<Node, Allocator>::allocate() {
+  if constexpr (!kPooled) {
+    node_allocator node_alloc(alloc_);
+    return node_traits::allocate(node_alloc, 1);
+  } else {
+    if (free_list_) {
+      FreeSlot *slot = free_list_;
+      free_list_ = slot->next_;
+      --available_;
+      return reinterpret_cast<Node *>(slot);
+    }
+
+    if (bump_ == bump_end_) {
+      // слэбы растут геометрически, но не больше kMaxSlab узлов
+      size_type slots = capacity_ < kMinSlab ? kMinSlab : capacity_;
+      addSlab(slots < kMaxSlab ? slots : kMaxSlab);
+    }
+
+    --available_;
+    return reinterpret_cast<Node *>(bump_++);
+  }
 }
 
 /**
- * @brief Destructor.
+ * @brief Returns raw memory for count nodes laid out one after another.
  *
- * @param N/A
+ * The nodes are cut from the current bump region; if it is too short, a
+ * dedicated slab of exactly count nodes is added. Each node may later be
+ * returned by deallocate() on its own. Available only when the pool is
+ * enabled.
  *
- * @return N/A
+ * @param count Number of nodes, must be greater than zero
  *
- * @throws N/A
+ * @return Node* Uninitialized memory for count consecutive nodes.
+ *
+ * @throws std::bad_alloc
  */
-template <typename Key, typename Comparator>
-RBTree<Key, Comparator>::~RBTree() noexcept {
-  clear();
+template <typename Node, typename Allocator>
+Node *RBTNodePool<Node, Allocator>::allocateBulk(size_type count) {
+  static_assert(kPooled || sizeof(Node) == 0,
+                "bulk allocation requires the node pool");
+  if (static_cast<size_type>(bump_end_ - bump_) < count) {
+    addSlab(count);
+  }
+  Node *nodes = reinterpret_cast<Node *>(bump_);
+  bump_ += count;
+  available_ -= count;
+  return nodes;
 }
 
 /**
- * @brief Copy assignment operator.
- *
- * @param other RBTree object to be copy
+ * @brief Returns the memory of an already destroyed node to the free list.
  *
- * @return *this
+ * @param node Node memory previously obtained from allocate()
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-RBTree<Key, Comparator> &
-RBTree<Key, Comparator>::operator=(const RBTree<Key, Comparator> &other) {
-  if (this != &other) {
-    deleteSubtree(root_);
-    root_ = CopyTree(other.root_, reinterpret_cast<Node &>(fake_node_));
-    fake_node_.red_ = false;
-    comparator_ = other.comparator_;
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::deallocate(Node *node) noexcept {
+  if constexpr (!kPooled) {
+    node_allocator node_alloc(alloc_);
+    node_traits::deallocate(node_alloc, node, 1);
+  } else {
+    FreeSlot *slot = reinterpret_cast<FreeSlot *>(node);
+    slot->next_ = free_list_;
+    free_list_ = slot;
+    ++available_;
   }
-  return *this;
 }
 
 /**
- * @brief Assignment operator overload for moving object.
+ * @brief Makes sure that count nodes can be allocated without touching the
+ * allocator.
  *
- * @param other RBTree object to be moved
+ * The missing nodes are allocated as one contiguous slab.
  *
- * @return *this
+ * @param count Number of nodes to preallocate
  *
- * @throws N/A
+ * @throws std::bad_alloc
  */
-template <typename Key, typename Comparator>
-RBTree<Key, Comparator> &
-RBTree<Key, Comparator>::operator=(RBTree<Key, Comparator> &&other) noexcept {
-  if (this != &other) {
-    deleteSubtree(root_);
-    root_ = other.root_;
-    fake_node_ = other.fake_node_;
-    size_ = other.size_;
-    comparator_ = other.comparator_;
-    other.root_ = nullptr;
-    other.fake_node_ = BaseNode();
-    other.size_ = 0;
-    other.comparator_ = Comparator();
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::reserve(size_type count) {
+  if constexpr (kPooled) {
+    if (count > available_) {
+      addSlab(count - available_);
+    }
   }
-  return *this;
 }
 
-/******************************************************************************
- * MAIN METHODS
- ******************************************************************************/
-
 /**
- * @brief Returns the number of elements in the RBTree.
+ * @brief Returns all slabs to the allocator at once.
  *
- * @return size_type The number of elements in the RBTree.
+ * Nodes that are still alive are not destroyed, the caller must destroy
+ * non-trivial keys beforehand. Slabs shared with other pools or held by
+ * node handles are freed only by the last of them.
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::size_type
-RBTree<Key, Comparator>::size() const noexcept {
-  return size_;
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::release() noexcept {
+  freeSlabs(alloc_, slabs_);
+  slabs_ = nullptr;
+  releasePins();
+  free_list_ = nullptr;
+  bump_ = bump_end_ = nullptr;
+  capacity_ = available_ = 0;
 }
 
 /**
- * @brief Returns the maximum possible number of elements.
+ * @brief Swaps the slabs of two pools.
  *
- * @return size_t The maximum possible number of elements.
+ * Allocators are swapped only if they propagate on container swap.
+ *
+ * @param other Pool to swap with
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-size_t RBTree<Key, Comparator>::max_size() const {
-  return static_cast<size_type>(-1);
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::swap(RBTNodePool &other) noexcept {
+  if constexpr (slot_traits::propagate_on_container_swap::value) {
+    std::swap(alloc_, other.alloc_);
+  }
+  std::swap(slabs_, other.slabs_);
+  std::swap(pins_, other.pins_);
+  std::swap(pin_count_, other.pin_count_);
+  std::swap(pin_room_, other.pin_room_);
+  std::swap(free_list_, other.free_list_);
+  std::swap(bump_, other.bump_);
+  std::swap(bump_end_, other.bump_end_);
+  std::swap(capacity_, other.capacity_);
+  std::swap(available_, other.available_);
 }
 
 /**
- * @brief Counts the number of occurrences of a specific key in the Red-Black
- * Tree.
- *
- * This function iteratively traverses the Red-Black Tree to count the number of
- * nodes that have the specified key. It uses a stack to avoid recursion.
+ * @brief Takes a reference to the slab that holds a node leaving the tree.
  *
- * @tparam Key The type of the keys in the tree.
- * @tparam Comparator The type of the comparator used to compare keys.
- * @param key The key to search for in the tree.
- * @param node The root node of the tree or subtree to search.
- * @param count A reference to a variable that will store the count of
- * occurrences.
+ * Used by extract(): the node handle keeps the node in its slot and holds
+ * the reference, so only this slab outlives the tree. The slab is looked
+ * up among the own slabs of the pool and then among the slabs it shares
+ * with other pools, O(number of slabs).
  *
- * @note This function assumes that the tree is not empty and that the
- *       root node is not null. If the tree is empty, the count will remain
- * unchanged.
+ * @param node Node of the tree owning this pool
  *
- * @warning This function does not handle the case where the tree is empty.
- *          The caller is responsible for ensuring that the tree is not empty.
+ * @return void* The slab, nullptr without the pool.
  *
- * @see RBTree
+ * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::countUniqueKey(const Key &key, Node *node,
-                                             size_type &count) const noexcept {
-  if (!node) {
-    return;
-  }
-
-  std::stack<Node *> stack;
-  stack.push(node);
-
-  while (!stack.empty()) {
-    Node *current = stack.top();
-    stack.pop();
-
-    if (key == current->key_) {
-      count++;
-    }
-
-    if (current->right_) {
-      stack.push(reinterpret_cast<Node *>(current->right_));
-    }
-
-    if (current->left_) {
-      stack.push(reinterpret_cast<Node *>(current->left_));
-    }
+template <typename Node, typename Allocator>
+void *RBTNodePool<Node, Allocator>::pinSlab(const Node *node) noexcept {
+  if constexpr (kPooled) {
+    Slot *slab = findSlab(reinterpret_cast<const Slot *>(node));
+    reinterpret_cast<SlabHeader *>(slab)->refs_.fetch_add(
+        1, std::memory_order_relaxed);
+    return slab;
+  } else {
+    return nullptr;
   }
 }
 
 /**
- * @brief Returns the number of elements with the specified key.
+ * @brief Takes over the slab reference of a node handle before its node is
+ * linked into the tree.
  *
- * @param key The key to count.
+ * If the pool already holds the slab (the node comes back to the tree it
+ * was extracted from, or the slabs are shared after split or merge), the
+ * reference of the handle is dropped. Otherwise the slab is added to the
+ * slabs shared with other pools, which allocates only when that list is
+ * full. The allocator of the handle must compare equal to the allocator of
+ * the pool.
  *
- * @return size_t The number of elements with the specified key.
+ * @param slab Slab returned by pinSlab(), may be nullptr
  *
- * @throws N/A
+ * @throws std::bad_alloc, nothing is changed then and the reference stays
+ * with the handle
  */
-template <typename Key, typename Comparator>
-size_t RBTree<Key, Comparator>::count(
-    const Key &key) const noexcept { // возвращает количество элементов,
-                                     // соответствующих заданному ключу
-  Node *current = root_;
-  size_t count = 0;
-
-  countUniqueKey(key, current, count);
-
-  return count;
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::adoptSlab(void *slab) {
+  if constexpr (kPooled) {
+    Slot *pinned = static_cast<Slot *>(slab);
+    if (holdsSlab(pinned)) {
+      unrefSlab(alloc_, pinned); // наша ссылка остаётся - слэб не освободится
+    } else {
+      reservePins(pin_count_ + 1);
+      insertPin(pinned);
+    }
+  }
 }
 
 /**
- * @brief Clears all nodes in the tree and frees memory.
+ * @brief Finishes with a node that a node handle destroyed.
+ *
+ * Without the pool the node memory is returned to the allocator. With the
+ * pool the slot is not reused: the handle drops its reference to the slab,
+ * which is freed if nothing else refers to it.
+ *
+ * @param alloc Allocator the node was allocated with
+ * @param node Node memory, the node must already be destroyed
+ * @param slab Slab returned by pinSlab()
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::clear() { // очищает все узлы дерева
-                                        // и освобождает память
-  deleteSubtree(root_);
-  root_ = nullptr;
-  size_ = 0;
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::deallocateDetached(
+    const allocator_type &alloc, Node *node, void *slab) noexcept {
+  if constexpr (!kPooled) {
+    node_allocator node_alloc(alloc);
+    node_traits::deallocate(node_alloc, node, 1);
+  } else {
+    slot_allocator slot_alloc(alloc);
+    unrefSlab(slot_alloc, static_cast<Slot *>(slab));
+  }
 }
 
 /**
- * @brief Swaps the contents of two RBTree objects.
+ * @brief Takes over all slabs of other, which is left empty.
  *
- * @param other The RBTree object to swap with.
+ * Live nodes of other keep their addresses and can be linked into the tree
+ * that owns this pool. The allocators must compare equal, see canSplice().
  *
- * @throws N/A
+ * @param other Pool whose memory is taken over
+ *
+ * @throws std::bad_alloc only if other shares slabs that this pool does not
+ * hold yet and the list of shared slabs is full; nothing is changed then.
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::swap(
-    RBTree &other) noexcept { // метод обмена содержимым двух деревьев
-  std::swap(root_, other.root_);
-  std::swap(size_, other.size_);
-  std::swap(this->fake_node_, other.fake_node_);
-  std::swap(comparator_, other.comparator_);
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::splice(RBTNodePool &other) {
+  if constexpr (kPooled) {
+    if (this == &other) {
+      return;
+    }
+    size_type missing = 0; // после split и join обратно таких слэбов нет
+    for (size_type i = 0; i < other.pin_count_; ++i) {
+      if (!holdsSlab(other.pins_[i]) && !other.ownsSlab(other.pins_[i])) {
+        ++missing;
+      }
+    }
+    reservePins(pin_count_ + missing); // до изменения пулов
+
+    if (other.slabs_ != nullptr) {
+      Slot *last = other.slabs_; // подвешиваем список слэбов other перед нашим
+      while (reinterpret_cast<SlabHeader *>(last)->next_ != nullptr) {
+        last = reinterpret_cast<SlabHeader *>(last)->next_;
+      }
+      reinterpret_cast<SlabHeader *>(last)->next_ = slabs_;
+      slabs_ = other.slabs_;
+    }
+    for (size_type i = 0; i < other.pin_count_; ++i) {
+      if (holdsSlab(other.pins_[i])) {
+        unrefSlab(alloc_, other.pins_[i]); // у нас уже есть ссылка
+      } else {
+        insertPin(other.pins_[i]);
+      }
+    }
+    other.pin_count_ = 0;
+    // свободные ячейки other могут лежать и в чужих слэбах - они тоже наши
+
+    while (other.free_list_ != nullptr) {
+      FreeSlot *slot = other.free_list_;
+      other.free_list_ = slot->next_;
+      slot->next_ = free_list_;
+      free_list_ = slot;
+    }
+    if (bump_ == bump_end_) {
+      bump_ = other.bump_;
+      bump_end_ = other.bump_end_;
+    } else {
+      while (other.bump_ != other.bump_end_) {
+        FreeSlot *slot = reinterpret_cast<FreeSlot *>(other.bump_++);
+        slot->next_ = free_list_;
+        free_list_ = slot;
+      }
+    }
+    capacity_ += other.capacity_;
+    available_ += other.available_;
+
+    other.slabs_ = nullptr;
+    other.bump_ = other.bump_end_ = nullptr;
+    other.capacity_ = other.available_ = 0;
+  }
 }
 
 /**
- * @brief Merges the contents of another RBTree into this RBTree.
+ * @brief Takes over the memory of other like splice(), but other keeps a
+ * reference to every slab of this pool.
  *
- * @param other The RBTree to merge into this RBTree.
+ * Used by merge with unique keys: the nodes of other whose keys are already
+ * present go back to other without being moved. The only allocations, the
+ * lists of shared slabs, happen before anything is changed.
  *
- * @throws N/A
+ * @param other Pool whose memory is taken over
+ *
+ * @throws std::bad_alloc, nothing is changed then
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::merge(RBTree &other) noexcept {
-  if (!other.empty() && this != &other) {
-    for (const auto &item : other) {
-      insert(item);
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::spliceShared(RBTNodePool &other) {
+  if constexpr (kPooled) {
+    if (this == &other) {
+      return;
     }
-    other.clear();
-  } // for (auto it = other.cbegin() : it != other.cend(); ++it) {insert(*it);}
+    // места хватит на все слэбы обоих пулов - share() уже не выделяет
+    other.reservePins(countSlabs() + other.countSlabs());
+    splice(other);
+    share(other);
+  }
 }
 
 /**
- * @brief Merges the contents of another RBTree into this RBTree, ensuring
- * unique keys.
+ * @brief Makes the slabs of this pool shared with other.
  *
- * @param other The RBTree to merge into this RBTree.
+ * Used by split: both trees keep nodes in the slabs of this pool. Other
+ * takes a reference to each of them, so every slab is freed when the last
+ * pool or node handle that refers to it is gone. The free slots stay with
+ * this pool, other only gets the right to the memory. New nodes of either
+ * pool come from new slabs or from its own free list.
  *
- * @throws N/A
+ * @param other Pool of the second tree, with an equal allocator; it must
+ * not hold any slabs yet
+ *
+ * @throws std::bad_alloc, nothing is changed then
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::mergeUnique(RBTree &other) noexcept {
-  if (!other.empty() && this != &other) {
-    for (const auto &item : other) {
-      insertUnique(item);
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::share(RBTNodePool &other) {
+  if constexpr (kPooled) {
+    other.reservePins(countSlabs());
+    Slot **out = other.pins_;
+    for (Slot *slab = slabs_; slab != nullptr;
+         slab = reinterpret_cast<SlabHeader *>(slab)->next_) {
+      *out++ = slab;
     }
-    other.clear();
+    out = std::copy(pins_, pins_ + pin_count_, out);
+    std::sort(other.pins_, out, std::less<const Slot *>());
+    out = std::unique(other.pins_, out);
+    for (Slot **pin = other.pins_; pin != out; ++pin) {
+      reinterpret_cast<SlabHeader *>(*pin)->refs_.fetch_add(
+          1, std::memory_order_relaxed);
+    }
+    other.pin_count_ = static_cast<size_type>(out - other.pins_);
   }
 }
 
 /**
- * @brief Checks if the RBTree is empty.
- *
- * @return bool True if the RBTree is empty, false otherwise.
+ * @brief Returns a copy of the allocator rebound to the container value type.
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::empty() const {
-  return size_ == 0;
+template <typename Node, typename Allocator>
+typename RBTNodePool<Node, Allocator>::allocator_type
+RBTNodePool<Node, Allocator>::get_allocator() const noexcept {
+  return allocator_type(alloc_);
 }
 
 /**
- * @brief Checks if the RBTree contains the specified key.
+ * @brief Checks whether the nodes of other may be taken over on move
+ * assignment.
  *
- * @param key The key to check.
+ * @param other Pool to be moved from
  *
- * @return bool True if the key is found, false otherwise.
+ * @return true if the allocator propagates or both allocators are equal.
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::contains(
-    const key_type &key) const { // проверка присутствия ключа в дереве
-  return findNode(key) != nullptr;
+template <typename Node, typename Allocator>
+bool RBTNodePool<Node, Allocator>::canAdopt(
+    const RBTNodePool &other) const noexcept {
+  return slot_traits::propagate_on_container_move_assignment::value ||
+         alloc_ == other.alloc_;
 }
 
 /**
- * @brief Finds an iterator to the element with the specified key.
+ * @brief Checks whether nodes of other may be moved into this pool.
  *
- * @param key The key to find.
+ * Slabs can change owner only if either allocator can free the memory of
+ * the other.
  *
- * @return iterator An iterator to the element with the specified key, or end()
- * if not found.
+ * @param other Pool the nodes come from
+ *
+ * @return true if both allocators are equal.
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::iterator
-RBTree<Key, Comparator>::find(const_reference key) {
-  Node *node = findNode(key);
-  if (node == nullptr) {
-    return end();
-  }
-  return iterator(*this, node);
-}
-
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::const_iterator
-RBTree<Key, Comparator>::find(const_reference key) const {
-  Node *node = findNode(key);
-  if (node == nullptr) {
-    return end();
-  }
-  return iterator(*this, node);
+template <typename Node, typename Allocator>
+bool RBTNodePool<Node, Allocator>::canSplice(
+    const RBTNodePool &other) const noexcept {
+  return alloc_ == other.alloc_;
 }
 
 /**
- * @brief Finds an iterator to the first element with a key greater than or
- * equal to the specified key.
+ * @brief Takes the allocator of other on copy assignment if it propagates.
  *
- * @param key The key to find.
+ * Must be called only when the pool owns no slabs.
  *
- * @return iterator An iterator to the first element with a key greater than or
- * equal to the specified key.
+ * @param other Pool to be copied from
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::iterator RBTree<Key, Comparator>::lower_bound(
-    const Key &key) { // используется для поиска первого элемента с ключом,
-                      // большим или равным данному
-  Node *current = root_;
-  Node *result = nullptr;
-
-  while (current != nullptr) {
-    if (comparator_(current->key_, key)) {
-      current = reinterpret_cast<Node *>(current->right_);
-    } else {
-      result = current;
-      current = reinterpret_cast<Node *>(current->left_);
-    }
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::copyAllocator(
+    const RBTNodePool &other) noexcept {
+  if constexpr (slot_traits::propagate_on_container_copy_assignment::value) {
+    alloc_ = other.alloc_;
   }
-
-  return iterator(*this, result);
 }
 
 /**
- * @brief Finds a const_iterator to the first element with a key greater than or
- * equal to the specified key.
- *
- * @param key The key to find.
- *
- * @return const_iterator A const_iterator to the first element with a key
- * greater than or equal to the specified key.
+ * @brief Returns the number of nodes held by all slabs.
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::const_iterator
-RBTree<Key, Comparator>::lower_bound(const Key &key) const {
-  Node *current = root_;
-  Node *result = nullptr;
-
-  while (current != nullptr) {
-    if (comparator_(current->key_, key)) {
-      current = reinterpret_cast<Node *>(current->right_);
-    } else {
-      result = current;
-      current = reinterpret_cast<Node *>(current->left_);
-    }
-  }
+template <typename Node, typename Allocator>
+typename RBTNodePool<Node, Allocator>::size_type
+RBTNodePool<Node, Allocator>::capacity() const noexcept {
+  return capacity_;
+}
 
-  return const_iterator(*this, result);
+/**
+ * @brief Returns the number of nodes that can be allocated without a new
+ * slab.
+ *
+ * @throws N/A
+ */
+template <typename Node, typename Allocator>
+typename RBTNodePool<Node, Allocator>::size_type
+RBTNodePool<Node, Allocator>::available() const noexcept {
+  return available_;
 }
 
 /**
- * @brief Finds an iterator to the first element with a key greater than the
- * specified key.
+ * @brief Finds the slab that contains a slot.
  *
- * @param key The key to find.
+ * The own slabs are checked one by one, the shared ones are sorted by
+ * address and found by binary search.
  *
- * @return iterator An iterator to the first element with a key greater than the
- * specified key.
+ * @param slot Slot of a node
+ *
+ * @return Slot* The slab, nullptr if the pool does not hold it.
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::iterator
-RBTree<Key, Comparator>::upper_bound(const Key &key) {
-  Node *current = root_;
-  Node *result = nullptr;
-
-  while (current != nullptr) {
-    if (comparator_(key, current->key_)) {
-      current = reinterpret_cast<Node *>(current->left_);
-    } else {
-      result = current;
-      current = reinterpret_cast<Node *>(current->right_);
+template <typename Node, typename Allocator>
+typename RBTNodePool<Node, Allocator>::Slot *
+RBTNodePool<Node, Allocator>::findSlab(const Slot *slot) const noexcept {
+  std::less<const Slot *> less;
+  auto contains = [&less, slot](Slot *slab) {
+    const SlabHeader *header = reinterpret_cast<const SlabHeader *>(slab);
+    return less(slab, slot) && less(slot, slab + 1 + header->slots_);
+  };
+  for (Slot *slab = slabs_; slab != nullptr;
+       slab = reinterpret_cast<SlabHeader *>(slab)->next_) {
+    if (contains(slab)) {
+      return slab;
     }
   }
-
-  return iterator(*this, result);
+  Slot **pin = std::upper_bound(pins_, pins_ + pin_count_, slot, less);
+  if (pin != pins_ && contains(pin[-1])) {
+    return pin[-1];
+  }
+  return nullptr;
 }
 
 /**
- * @brief Finds a const_iterator to the first element with a key greater than
- * the specified key.
- *
- * @param key The key to find.
- *
- * @return const_iterator A const_iterator to the first element with a key
- * greater than the specified key.
+ * @brief Checks whether a slab was allocated by this pool.
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::const_iterator
-RBTree<Key, Comparator>::upper_bound(const Key &key) const {
-  Node *current = root_;
-  Node *result = nullptr;
-
-  while (current != nullptr) {
-    if (comparator_(key, current->key_)) {
-      current = reinterpret_cast<Node *>(current->left_);
-    } else {
-      result = current;
-      current = reinterpret_cast<Node *>(current->right_);
+template <typename Node, typename Allocator>
+bool RBTNodePool<Node, Allocator>::ownsSlab(const Slot *slab) const noexcept {
+  for (Slot *own = slabs_; own != nullptr;
+       own = reinterpret_cast<SlabHeader *>(own)->next_) {
+    if (own == slab) {
+      return true;
     }
   }
-
-  return const_iterator(*this, result);
+  return false;
 }
 
 /**
- * @brief Gets the node with the minimum key in the subtree rooted at the
- * specified node.
- *
- * @param node The root of the subtree.
- *
- * @return Node* The node with the minimum key in the subtree.
+ * @brief Checks whether the pool holds a reference to a slab, its own or a
+ * shared one.
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::Node *
-RBTree<Key, Comparator>::getMinNode(Node *node) const {
-  return findMinNode(node);
+template <typename Node, typename Allocator>
+bool RBTNodePool<Node, Allocator>::holdsSlab(const Slot *slab) const noexcept {
+  return ownsSlab(slab) || std::binary_search(pins_, pins_ + pin_count_, slab,
+                                              std::less<const Slot *>());
 }
 
 /**
- * @brief Gets the node with the maximum key in the subtree rooted at the
- * specified node.
- *
- * @param node The root of the subtree.
- *
- * @return Node* The node with the maximum key in the subtree.
+ * @brief Returns the number of slabs the pool holds, its own and shared.
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::Node *
-RBTree<Key, Comparator>::getMaxNode(Node *node) const {
-  return findMaxNode(node);
+template <typename Node, typename Allocator>
+typename RBTNodePool<Node, Allocator>::size_type
+RBTNodePool<Node, Allocator>::countSlabs() const noexcept {
+  size_type count = pin_count_;
+  for (Slot *slab = slabs_; slab != nullptr;
+       slab = reinterpret_cast<SlabHeader *>(slab)->next_) {
+    ++count;
+  }
+  return count;
 }
 
 /**
- * @brief Gets the root node of the RBTree.
+ * @brief Makes room for count shared slabs.
  *
- * @return const Node* The root node of the RBTree.
+ * @param count Number of shared slabs the list must be able to hold
  *
- * @throws N/A
+ * @throws std::bad_alloc, nothing is changed then
  */
-template <typename Key, typename Comparator>
-const typename RBTree<Key, Comparator>::Node *
-RBTree<Key, Comparator>::getRoot() const {
-  return root_;
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::reservePins(size_type count) {
+  if (count <= pin_room_) {
+    return;
+  }
+  size_type room = pin_room_ * 2 < kMinPins ? kMinPins : pin_room_ * 2;
+  if (room < count) {
+    room = count;
+  }
+  pin_allocator pin_alloc(alloc_);
+  Slot **pins = pin_traits::allocate(pin_alloc, room);
+  std::copy(pins_, pins_ + pin_count_, pins);
+  if (pins_ != nullptr) {
+    pin_traits::deallocate(pin_alloc, pins_, pin_room_);
+  }
+  pins_ = pins;
+  pin_room_ = room;
 }
 
 /**
- * @brief Gets an iterator to the first element in the RBTree.
+ * @brief Adds a shared slab to the list, keeping it sorted by address.
  *
- * @return iterator An iterator to the first element in the RBTree.
+ * The reference to the slab passes to the pool. The list must have room
+ * for it and must not contain it yet.
+ *
+ * @param slab Slab of another pool
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-RBTreeIterator<Key, Comparator> RBTree<Key, Comparator>::begin() noexcept {
-  Node *min = findMinNode(root_);
-  return iterator(*this, min);
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::insertPin(Slot *slab) noexcept {
+  Slot **pos = std::upper_bound(pins_, pins_ + pin_count_, slab,
+                                std::less<const Slot *>());
+  std::copy_backward(pos, pins_ + pin_count_, pins_ + pin_count_ + 1);
+  *pos = slab;
+  ++pin_count_;
 }
 
 /**
- * @brief Gets an iterator to the end of the RBTree.
- *
- * @return iterator An iterator to the end of the RBTree.
+ * @brief Drops the references to all shared slabs and frees their list.
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-RBTreeIterator<Key, Comparator> RBTree<Key, Comparator>::end() noexcept {
-  return iterator(*this, nullptr);
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::releasePins() noexcept {
+  for (size_type i = 0; i < pin_count_; ++i) {
+    unrefSlab(alloc_, pins_[i]);
+  }
+  if (pins_ != nullptr) {
+    pin_allocator pin_alloc(alloc_);
+    pin_traits::deallocate(pin_alloc, pins_, pin_room_);
+  }
+  pins_ = nullptr;
+  pin_count_ = pin_room_ = 0;
 }
 
 /**
- * @brief Gets a const_iterator to the first element in the RBTree.
+ * @brief Drops one reference to a slab and frees it with the last one.
  *
- * @return const_iterator A const_iterator to the first element in the RBTree.
+ * @param alloc Allocator the slab was obtained from
+ * @param slab The slab
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::const_iterator
-RBTree<Key, Comparator>::begin() const noexcept {
-  return const_iterator(*this, getMinNode(root_));
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::unrefSlab(slot_allocator &alloc,
+                                             Slot *slab) noexcept {
+  SlabHeader *header = reinterpret_cast<SlabHeader *>(slab);
+  if (header->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    size_type slots = header->slots_;
+    header->~SlabHeader();
+    slot_traits::deallocate(alloc, slab, slots + 1);
+  }
 }
 
 /**
- * @brief Gets a const_iterator to the end of the RBTree.
+ * @brief Drops the references of a pool to a list of its own slabs.
  *
- * @return const_iterator A const_iterator to the end of the RBTree.
+ * A slab that is still shared with another pool or held by a node handle
+ * is freed later by the last of them.
+ *
+ * @param alloc Allocator the slabs were obtained from
+ * @param slabs First slab of the list, may be nullptr
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::const_iterator
-RBTree<Key, Comparator>::end() const noexcept {
-  return const_iterator(*this, nullptr);
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::freeSlabs(slot_allocator &alloc,
+                                             Slot *slabs) noexcept {
+  while (slabs) {
+    Slot *next = reinterpret_cast<SlabHeader *>(slabs)->next_;
+    unrefSlab(alloc, slabs);
+    slabs = next;
+  }
 }
 
 /**
- * @brief Gets a const_iterator to the first element in the RBTree.
+ * @brief Allocates a new slab and makes it the current bump region.
  *
- * @return const_iterator A const_iterator to the first element in the RBTree.
+ * The rest of the previous bump region is moved to the free list so that no
+ * memory is lost.
  *
- * @throws N/A
+ * @param slots Number of nodes in the new slab
+ *
+ * @throws std::bad_alloc
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::const_iterator
-RBTree<Key, Comparator>::cbegin() const noexcept {
-  return const_iterator(*this, findMinNode(root_));
+template <typename Node, typename Allocator>
+void RBTNodePool<Node, Allocator>::addSlab(size_type slots) {
+  Slot *slab = slot_traits::allocate(alloc_, slots + 1);
+  SlabHeader *header = new (static_cast<void *>(slab)) SlabHeader(slots);
+  header->next_ = slabs_;
+  slabs_ = slab;
+
+  while (bump_ != bump_end_) {
+    FreeSlot *slot = reinterpret_cast<FreeSlot *>(bump_++);
+    slot->next_ = free_list_;
+    free_list_ = slot;
+  }
+
+  bump_ = slab + 1;
+  bump_end_ = bump_ + slots;
+  capacity_ += slots;
+  available_ += slots;
 }
 
+/******************************************************************************
+ * NODE HANDLE
+ ******************************************************************************/
+
 /**
- * @brief Gets a const_iterator to the end of the RBTree.
+ * @brief Move constructor, takes over the node of other.
  *
- * @return const_iterator A const_iterator to the end of the RBTree.
+ * @param other Node handle to be moved, left empty
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::const_iterator
-RBTree<Key, Comparator>::cend() const noexcept {
-  return const_iterator(*this, nullptr);
+template <typename Key, typename Comparator, typename Allocator>
+RBTNodeHandle<Key, Comparator, Allocator>::RBTNodeHandle(
+    RBTNodeHandle &&other) noexcept
+    : node_(other.node_), alloc_(std::move(other.alloc_)), slab_(other.slab_) {
+  other.node_ = nullptr;
+  other.alloc_.reset();
+  other.slab_ = nullptr;
 }
 
 /**
- * @brief Inserts a new element with the specified key into the RBTree.
+ * @brief Move assignment, destroys the own node and takes over the node of
+ * other.
  *
- * @param key The key of the element to insert.
+ * @param other Node handle to be moved, left empty
  *
- * @return std::pair<iterator, bool> A pair consisting of an iterator to the
- * inserted element (or to the element that prevented the insertion) and a bool
- * denoting whether the insertion took place.
+ * @return *this
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-std::pair<typename RBTree<Key, Comparator>::iterator, bool>
-RBTree<Key, Comparator>::insert(const key_type &key) {
-  return insert(key, false);
+template <typename Key, typename Comparator, typename Allocator>
+RBTNodeHandle<Key, Comparator, Allocator> &
+RBTNodeHandle<Key, Comparator, Allocator>::operator=(
+    RBTNodeHandle &&other) noexcept {
+  if (this != &other) {
+    RBTNodeHandle old(std::move(*this)); // освободит прежний узел
+    node_ = other.node_;
+    alloc_ = std::move(other.alloc_);
+    slab_ = other.slab_;
+    other.node_ = nullptr;
+    other.alloc_.reset();
+    other.slab_ = nullptr;
+  }
+  return *this;
 }
 
 /**
- * @brief Inserts a new element with the specified key into the RBTree, ensuring
- * unique keys.
- *
- * @param key The key of the element to insert.
+ * @brief Destructor, destroys the node if the handle still owns one.
  *
- * @return std::pair<iterator, bool> A pair consisting of an iterator to the
- * inserted element (or to the element that prevented the insertion) and a bool
- * denoting whether the insertion took place.
+ * With the node pool the slot of the node is not reused; the handle drops
+ * its reference to the slab, which is freed when no tree or handle refers
+ * to it any more.
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-std::pair<typename RBTree<Key, Comparator>::iterator, bool>
-RBTree<Key, Comparator>::insertUnique(const key_type &key) {
-  return insert(key, true);
+template <typename Key, typename Comparator, typename Allocator>
+RBTNodeHandle<Key, Comparator, Allocator>::~RBTNodeHandle() noexcept {
+  if (node_ != nullptr) {
+    node_->~Node();
+    node_pool::deallocateDetached(*alloc_, node_, slab_);
+  }
 }
 
 /**
- * @brief Erases a node from the Red-Black Tree.
+ * @brief Returns the key of a Map node.
  *
- * This function erases the node pointed to by the given iterator from the
- * Red-Black Tree. It handles the rebalancing of the tree after the node is
- * removed and ensures that the Red-Black Tree properties are maintained.
+ * The key may be modified before the node is inserted again, as with
+ * std::map::node_type::key().
  *
- * @tparam Key The type of the keys in the tree.
- * @tparam Comparator The type of the comparator used to compare keys.
- * @param pos An iterator pointing to the node to be erased.
+ * @return Reference to the key; the handle must not be empty.
  *
- * @note This function assumes that the tree is not empty and that the
- *       iterator is valid. The caller is responsible for ensuring that
- *       the iterator is valid.
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename V>
+typename std::remove_const<typename V::first_type>::type &
+RBTNodeHandle<Key, Comparator, Allocator>::key() const {
+  // узел вне дерева - менять ключ безопасно
+  using key_type = typename std::remove_const<typename V::first_type>::type;
+  return const_cast<key_type &>(node_->key_.first);
+}
+
+/**
+ * @brief Returns the mapped value of a Map node.
  *
- * @warning This function does not handle the case where the tree is empty or
- * the iterator is invalid. The caller is responsible for ensuring that the tree
- * is not empty and the iterator is valid.
+ * @return Reference to the mapped value; the handle must not be empty.
  *
- * @see RBTree
- * @see eraseNode
- * @see eraseFixup
+ * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::erase(iterator pos) {
-  Node *eraised_node = pos.getCurrentNode();
-  if (!eraised_node) {
-    return;
-  }
-
-  Node *to_fix = nullptr;
-  bool original_color = eraised_node->red_;
-
-  eraseNode(eraised_node, to_fix, &original_color);
+template <typename Key, typename Comparator, typename Allocator>
+template <typename V>
+typename V::second_type &
+RBTNodeHandle<Key, Comparator, Allocator>::mapped() const {
+  return node_->key_.second;
+}
 
-  if (!original_color && to_fix) {
-    eraseFixup(to_fix);
-  }
+/**
+ * @brief Swaps the nodes of two handles.
+ *
+ * @param other Node handle to swap with
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTNodeHandle<Key, Comparator, Allocator>::swap(
+    RBTNodeHandle &other) noexcept {
+  std::swap(node_, other.node_);
+  std::swap(alloc_, other.alloc_);
+  std::swap(slab_, other.slab_);
+}
 
-  delete eraised_node;
-  --size_;
+/**
+ * @brief Gives up the node without destroying it, the handle becomes empty.
+ *
+ * The reference to the slab of the node passes to the caller, which must
+ * have handed it to its pool (RBTNodePool::adoptSlab()).
+ *
+ * @return Node* The node that was owned by the handle.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTNodeHandle<Key, Comparator, Allocator>::Node *
+RBTNodeHandle<Key, Comparator, Allocator>::release() noexcept {
+  Node *node = node_;
+  node_ = nullptr;
+  alloc_.reset();
+  slab_ = nullptr;
+  return node;
 }
 
 /******************************************************************************
- * AUXILIARY PRIVATE BASIC METHODS
+ * CONSTRUCTOR & DESTRUCTOR
  ******************************************************************************/
 
 /**
- * @brief Inserts a new node with the given key into the Red-Black Tree.
+ * The default constructor for the RBTree class.
  *
- * This function inserts a new node with the given key into the Red-Black Tree.
- * If the tree is empty, the new node becomes the root. If the key already
- * exists in the tree and the `unique` flag is set to true, the insertion is
- * aborted. Otherwise, the new node is inserted and the tree is rebalanced.
+ * @param N/A
  *
- * @tparam Key The type of the keys in the tree.
- * @tparam Comparator The type of the comparator used to compare keys.
- * @param key The key to be inserted.
- * @param unique A flag indicating whether the keys should be unique. If set to
- * true, the insertion will be aborted if the key already exists.
- * @return A pair consisting of an iterator to the inserted node and a boolean
- * indicating whether the insertion was successful.
+ * @return N/A
  *
- * @note This function assumes that the tree is not empty and that the
- *       root node is not null. The caller is responsible for ensuring that
- *       the tree is not empty.
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+RBTree<Key, Comparator, Allocator>::RBTree() : RBTree(Allocator()) {}
+
+/**
+ * @brief Constructor with an allocator, creates an empty RBTree whose nodes
+ * are allocated by alloc.
  *
- * @warning This function does not handle the case where the tree is empty.
- *          The caller is responsible for ensuring that the tree is not empty.
+ * @param alloc Allocator used for all nodes of the tree
  *
- * @see RBTree
- * @see insertNode
- * @see insertFixup
+ * @throws N/A
  */
-template <typename Key, typename Comparator>
-std::pair<typename RBTree<Key, Comparator>::iterator, bool>
-RBTree<Key, Comparator>::insert(const key_type &key, bool unique) {
-  Node *new_node = new Node(key);
-  if (!root_) {
-    root_ = new_node;
-    root_->red_ = false; // корень должен быть чёрный
-    size_ = 1;
-    return {iterator(*this, new_node), true};
-  }
+template <typename Key, typename Comparator, typename Allocator>
+RBTree<Key, Comparator, Allocator>::RBTree(const allocator_type &alloc)
+    : header_(), size_(0), comparator_(Comparator()), pool_(alloc) {
+  resetHeader();
+}
 
-  if (findNode(new_node->key_) &&
-      unique) { // unique - даёт возможность отключить
-                // проверку на уникальный ключ
-    delete new_node;
-    return {iterator(*this, new_node), false};
+/**
+ * Initializer list constructor.
+ *
+ * @brief initializer list constructor,
+ * creates the RBTree initialized using std::initializer_list
+ *
+ * @param items List of lists of value_type
+ * for initializing the RBTree
+ *
+ * @throws None
+ */
+template <typename Key, typename Comparator, typename Allocator>
+RBTree<Key, Comparator, Allocator>::RBTree(
+    std::initializer_list<node_type> const &items)
+    : RBTree() {
+  for (const auto &item : items) {
+    insert(item);
   }
+}
 
-  insertNode(root_, new_node);
-
-  insertFixup(new_node);
-
-  // увеличиваем размер дерева
-  ++size_;
+/**
+ * @brief Constructor for creating a copy of the RBTree object.
+ *
+ * Large trees are copied by several threads, see copyFrom().
+ *
+ * @param other RBTree object to be copied
+ *
+ * @return N/A
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+RBTree<Key, Comparator, Allocator>::RBTree(const RBTree &other)
+    : RBTree(std::allocator_traits<Allocator>::
+                 select_on_container_copy_construction(other.get_allocator())) {
+  copyFrom(other);
+}
 
-  return {iterator(*this, new_node), true};
+/**
+ * @brief Constructor for moving RBTree object.
+ *
+ * @param other RBTree object to be moved
+ *
+ * @return N/A
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+RBTree<Key, Comparator, Allocator>::RBTree(RBTree &&other) noexcept
+    : header_(other.header_), size_(other.size_),
+      comparator_(other.comparator_), pool_(std::move(other.pool_)) {
+  adoptHeader();
+  other.resetHeader();
+  other.size_ = 0;
+  other.comparator_ = Comparator();
 }
 
 /**
- * @brief Deletes all nodes in the subtree starting from the given node.
+ * @brief Destructor.
  *
- * This function iteratively deletes all nodes in the subtree starting from the
- * given node. It uses a stack to avoid recursion and ensures that all nodes are
- * properly deleted and memory is freed.
+ * @param N/A
  *
- * @tparam Key The type of the keys in the tree.
- * @tparam Comparator The type of the comparator used to compare keys.
- * @param node The root node of the subtree to be deleted.
+ * @return N/A
  *
- * @note This function assumes that the tree is not empty and that the
- *       root node is not null. The caller is responsible for ensuring that
- *       the tree is not empty.
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+RBTree<Key, Comparator, Allocator>::~RBTree() noexcept {
+  clear();
+}
+
+/**
+ * @brief Copy assignment operator.
  *
- * @warning This function does not handle the case where the tree is empty.
- *          The caller is responsible for ensuring that the tree is not empty.
+ * Large trees are copied by several threads, see copyFrom().
  *
- * @see RBTree
+ * @param other RBTree object to be copy
+ *
+ * @return *this
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor. The tree
+ * is left empty in that case.
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::deleteSubtree(Node *node) {
-  // Итеративно удаляет все узлы в поддереве,
-  // начиная с заданного узла.
-  // Очищает все узлы дерева и освобождает память.
+template <typename Key, typename Comparator, typename Allocator>
+RBTree<Key, Comparator, Allocator> &
+RBTree<Key, Comparator, Allocator>::operator=(const RBTree &other) {
+  if (this != &other) {
+    clear();
+    pool_.copyAllocator(other.pool_); // после clear() слэбов нет
+    copyFrom(other);
+  }
+  return *this;
+}
 
-  if (!node) {
-    // Если узел равен nullptr, нет необходимости в удалении
-    return;
+/**
+ * @brief Assignment operator overload for moving object.
+ *
+ * The nodes of other are taken over if the allocator propagates on move
+ * assignment or both allocators are equal. Otherwise the keys are
+ * move-constructed into new nodes of this tree in one O(n) sorted build;
+ * moving a Map element copies its const key.
+ *
+ * @param other RBTree object to be moved, left empty
+ *
+ * @return *this
+ *
+ * @throws N/A if kNothrowMoveAssign; otherwise std::bad_alloc or anything
+ * thrown by the key constructor, this tree is left empty then
+ */
+template <typename Key, typename Comparator, typename Allocator>
+RBTree<Key, Comparator, Allocator> &
+RBTree<Key, Comparator, Allocator>::operator=(RBTree &&other) noexcept(
+    kNothrowMoveAssign) {
+  if (this != &other && !pool_.canAdopt(other.pool_)) {
+    // узлы другого аллокатора забрать нельзя - перемещаем ключи в новые
+    comparator_ = other.comparator_;
+    buildSorted(std::make_move_iterator(other.begin()),
+                std::make_move_iterator(other.end()), other.size_,
+                other.size_, false);
+    other.clear();
+  } else if (this != &other) {
+    clear();
+    header_ = other.header_;
+    adoptHeader();
+    size_ = other.size_;
+    comparator_ = other.comparator_;
+    pool_ = std::move(other.pool_);
+    other.resetHeader();
+    other.size_ = 0;
+    other.comparator_ = Comparator();
   }
+  return *this;
+}
 
-  std::stack<Node *> stack;
-  stack.push(node);
+/**
+ * @brief Returns the allocator associated with the RBTree.
+ *
+ * @return allocator_type Copy of the allocator
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::allocator_type
+RBTree<Key, Comparator, Allocator>::get_allocator() const noexcept {
+  return pool_.get_allocator();
+}
 
-  while (!stack.empty()) {
-    Node *current = stack.top();
-    stack.pop();
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
 
-    // Если у текущего узла есть левый потомок, добавляем его в стек
-    if (current->left_) {
-      stack.push(reinterpret_cast<Node *>(current->left_));
-    }
+/**
+ * @brief Returns the number of elements in the RBTree.
+ *
+ * @return size_type The number of elements in the RBTree.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::size_type
+RBTree<Key, Comparator, Allocator>::size() const noexcept {
+  return size_;
+}
 
-    // Если у текущего узла есть правый потомок, добавляем его в стек
-    if (current->right_) {
-      stack.push(reinterpret_cast<Node *>(current->right_));
-    }
+/**
+ * @brief Returns the maximum possible number of elements.
+ *
+ * @return size_t The maximum possible number of elements.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+size_t RBTree<Key, Comparator, Allocator>::max_size() const {
+  return static_cast<size_type>(-1);
+}
 
-    // Удаляем текущий узел и освобождаем память
-    delete current;
+/**
+ * @brief Counts the keys that are less than (or not greater than) the
+ * specified key.
+ *
+ * One descent from the root: whenever the path goes right, the node and its
+ * whole left subtree are counted using the stored subtree sizes. O(log n).
+ *
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param key The key to compare with.
+ * @param or_equal If true, keys equivalent to key are counted as well.
+ *
+ * @return size_type The number of such keys.
+ *
+ * @throws anything thrown by the comparator
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K>
+typename RBTree<Key, Comparator, Allocator>::size_type
+RBTree<Key, Comparator, Allocator>::countLess(const K &key,
+                                              bool or_equal) const {
+  size_type count = 0;
+  const Node *current = root();
+  while (current != nullptr) {
+    // узел левее границы: он и его левое поддерево входят в ответ
+    bool before = or_equal ? !comparator_(key, current->key_)
+                           : comparator_(current->key_, key);
+    if (before) {
+      count += subtreeSize(current->left_) + 1;
+      current = static_cast<const Node *>(current->right_);
+    } else {
+      current = static_cast<const Node *>(current->left_);
+    }
   }
+  return count;
 }
 
 /**
- * @brief Finds the node with the specified key in the RBTree.
+ * @brief Returns the number of elements with the specified key.
  *
- * @param key The key to find.
+ * Computed as the difference of two ranks, O(log n) regardless of the number
+ * of equivalent keys.
  *
- * @return Node* The node with the specified key, or nullptr if not found.
+ * @param key The key to count.
  *
- * @throws N/A
+ * @return size_t The number of elements with the specified key.
+ *
+ * @throws anything thrown by the comparator
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::Node *RBTree<Key, Comparator>::findNode(
-    const Key &key) const { // вспомогательный метод для нахождения узла
-  Node *current = root_;
-  bool flag = false;
+template <typename Key, typename Comparator, typename Allocator>
+size_t RBTree<Key, Comparator, Allocator>::count(
+    const Key &key) const { // возвращает количество элементов,
+                            // соответствующих заданному ключу
+  return countLess(key, true) - countLess(key, false);
+}
+
+/**
+ * @brief Returns the number of elements in the half-open key range
+ * [lo, hi).
+ *
+ * @param lo The lower bound, included.
+ * @param hi The upper bound, excluded.
+ *
+ * @return size_t The number of elements that are not less than lo and are
+ * less than hi; 0 if hi is not greater than lo. O(log n).
+ *
+ * @throws anything thrown by the comparator
+ */
+template <typename Key, typename Comparator, typename Allocator>
+size_t RBTree<Key, Comparator, Allocator>::count_range(
+    const Key &lo, const Key &hi) const {
+  // при hi <= lo ранг hi не больше ранга lo, сравнивать границы не нужно
+  size_type less_hi = countLess(hi, false);
+  size_type less_lo = countLess(lo, false);
+  return less_hi > less_lo ? less_hi - less_lo : 0;
+}
+
+/**
+ * @brief Preallocates memory for count elements.
+ *
+ * After the call count elements can be stored in the tree without any call
+ * to the system allocator.
+ *
+ * @param count The number of elements to reserve memory for.
+ *
+ * @throws std::bad_alloc
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::reserve(size_type count) {
+  if (count > size_) {
+    pool_.reserve(count - size_);
+  }
+}
+
+/**
+ * @brief Clears all nodes in the tree and frees memory.
+ *
+ * For trivially destructible keys the nodes are not visited at all: the node
+ * pool returns whole slabs to the system, so the cost does not depend on the
+ * number of elements.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::clear() { // очищает все узлы дерева
+                                        // и освобождает память
+  if (!std::is_trivially_destructible<Key>::value || !node_pool::kPooled) {
+    deleteSubtree(root());
+  }
+  pool_.release();
+  resetHeader();
+  size_ = 0;
+}
+
+/**
+ * @brief Swaps the contents of two RBTree objects.
+ *
+ * @param other The RBTree object to swap with.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::swap(
+    RBTree &other) noexcept { // метод обмена содержимым двух деревьев
+  std::swap(header_, other.header_);
+  adoptHeader(); // узлы ссылаются на заголовок по адресу
+  other.adoptHeader();
+  std::swap(size_, other.size_);
+  std::swap(comparator_, other.comparator_);
+  pool_.swap(other.pool_);
+}
+
+/**
+ * @brief Moves all elements of another RBTree into this RBTree.
+ *
+ * With equal allocators the nodes are relinked: no key is copied and no
+ * memory is allocated. See mergeNodes().
+ *
+ * @param other The RBTree to merge into this RBTree, left empty.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor (different
+ * allocators only)
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::merge(RBTree &other) {
+  mergeNodes(other, false);
+}
+
+/**
+ * @brief Moves the elements of another RBTree whose keys are not present in
+ * this RBTree.
+ *
+ * Elements with keys that already exist here stay in other, as with
+ * std::set::merge. See mergeNodes().
+ *
+ * @param other The RBTree to merge into this RBTree.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::mergeUnique(RBTree &other) {
+  mergeNodes(other, true);
+}
+
+/**
+ * @brief Checks if the RBTree is empty.
+ *
+ * @return bool True if the RBTree is empty, false otherwise.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::empty() const {
+  return size_ == 0;
+}
+
+/**
+ * @brief Checks if the RBTree contains the specified key.
+ *
+ * @param key The key to check.
+ *
+ * @return bool True if the key is found, false otherwise.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::contains(
+    const key_type &key) const { // проверка присутствия ключа в дереве
+  return findNode(key) != nullptr;
+}
+
+/**
+ * @brief Finds an iterator to the element with the specified key.
+ *
+ * @param key The key to find.
+ *
+ * @return iterator An iterator to the element with the specified key, or end()
+ * if not found.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::find(const_reference key) {
+  Node *node = findNode(key);
+  if (node == nullptr) {
+    return end();
+  }
+  return makeIterator(node);
+}
+
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::const_iterator
+RBTree<Key, Comparator, Allocator>::find(const_reference key) const {
+  Node *node = findNode(key);
+  if (node == nullptr) {
+    return end();
+  }
+  return makeIterator(node);
+}
+
+/**
+ * @brief Finds an iterator to the first element with a key greater than or
+ * equal to the specified key.
+ *
+ * @param key The key to find.
+ *
+ * @return iterator An iterator to the first element with a key greater than or
+ * equal to the specified key.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::lower_bound(
+    const Key &key) { // используется для поиска первого элемента с ключом,
+                      // большим или равным данному
+  return makeIterator(lowerBoundNode(key));
+}
+
+/**
+ * @brief Finds a const_iterator to the first element with a key greater than or
+ * equal to the specified key.
+ *
+ * @param key The key to find.
+ *
+ * @return const_iterator A const_iterator to the first element with a key
+ * greater than or equal to the specified key.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::const_iterator
+RBTree<Key, Comparator, Allocator>::lower_bound(const Key &key) const {
+  return makeIterator(lowerBoundNode(key));
+}
+
+/**
+ * @brief Finds an iterator to the first element with a key greater than the
+ * specified key.
+ *
+ * @param key The key to find.
+ *
+ * @return iterator An iterator to the first element with a key greater than the
+ * specified key.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::upper_bound(const Key &key) {
+  return makeIterator(upperBoundNode(key));
+}
+
+/**
+ * @brief Finds a const_iterator to the first element with a key greater than
+ * the specified key.
+ *
+ * @param key The key to find.
+ *
+ * @return const_iterator A const_iterator to the first element with a key
+ * greater than the specified key.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::const_iterator
+RBTree<Key, Comparator, Allocator>::upper_bound(const Key &key) const {
+  return makeIterator(upperBoundNode(key));
+}
+
+/******************************************************************************
+ * HETEROGENEOUS LOOKUP
+ ******************************************************************************/
+
+// Перегрузки ниже доступны только при прозрачном компараторе
+// (Comparator::is_transparent) и ищут по ключу типа K без построения
+// временного Key. Семантика совпадает с одноимёнными методами для Key.
+
+/**
+ * @brief Returns the number of elements whose key is equivalent to key.
+ *
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param key The key to count.
+ *
+ * @return size_type The number of such elements. O(log n).
+ *
+ * @throws anything thrown by the comparator
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K, typename C, typename>
+typename RBTree<Key, Comparator, Allocator>::size_type
+RBTree<Key, Comparator, Allocator>::count(const K &key) const {
+  return countLess(key, true) - countLess(key, false);
+}
+
+/**
+ * @brief Returns the number of elements in the half-open key range
+ * [lo, hi).
+ *
+ * @tparam K Type of the bounds; any type the comparator accepts.
+ * @param lo The lower bound, included.
+ * @param hi The upper bound, excluded.
+ *
+ * @return size_type The number of such elements, 0 if hi is not greater than
+ * lo. O(log n).
+ *
+ * @throws anything thrown by the comparator
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K, typename C, typename>
+typename RBTree<Key, Comparator, Allocator>::size_type
+RBTree<Key, Comparator, Allocator>::count_range(const K &lo,
+                                                const K &hi) const {
+  size_type less_hi = countLess(hi, false);
+  size_type less_lo = countLess(lo, false);
+  return less_hi > less_lo ? less_hi - less_lo : 0;
+}
+
+/**
+ * @brief Checks if the RBTree contains a key equivalent to key.
+ *
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param key The key to check.
+ *
+ * @return bool True if the key is found, false otherwise.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K, typename C, typename>
+bool RBTree<Key, Comparator, Allocator>::contains(const K &key) const {
+  return findNode(key) != nullptr;
+}
+
+/**
+ * @brief Finds an element with a key equivalent to key.
+ *
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param key The key to find.
+ *
+ * @return iterator An iterator to the element, or end() if not found.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K, typename C, typename>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::find(const K &key) {
+  Node *node = findNode(key);
+  if (node == nullptr) {
+    return end();
+  }
+  return makeIterator(node);
+}
+
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K, typename C, typename>
+typename RBTree<Key, Comparator, Allocator>::const_iterator
+RBTree<Key, Comparator, Allocator>::find(const K &key) const {
+  Node *node = findNode(key);
+  if (node == nullptr) {
+    return end();
+  }
+  return makeIterator(node);
+}
+
+/**
+ * @brief Finds the first element with a key not less than key.
+ *
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param key The key to find.
+ *
+ * @return iterator An iterator to the element, or end() if there is none.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K, typename C, typename>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::lower_bound(const K &key) {
+  return makeIterator(lowerBoundNode(key));
+}
+
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K, typename C, typename>
+typename RBTree<Key, Comparator, Allocator>::const_iterator
+RBTree<Key, Comparator, Allocator>::lower_bound(const K &key) const {
+  return makeIterator(lowerBoundNode(key));
+}
+
+/**
+ * @brief Finds the first element with a key greater than key.
+ *
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param key The key to find.
+ *
+ * @return iterator An iterator to the element, or end() if there is none.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K, typename C, typename>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::upper_bound(const K &key) {
+  return makeIterator(upperBoundNode(key));
+}
+
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K, typename C, typename>
+typename RBTree<Key, Comparator, Allocator>::const_iterator
+RBTree<Key, Comparator, Allocator>::upper_bound(const K &key) const {
+  return makeIterator(upperBoundNode(key));
+}
+
+/**
+ * @brief Finds every key of a range and writes one iterator per key.
+ *
+ * Gives the same results as calling find() for each key in turn (among
+ * equal keys the first one is found, like lower_bound()), but up to
+ * kBatchWidth descents advance together and the next node of each one is
+ * prefetched, so the cache misses of different keys overlap instead of
+ * following one another.
+ *
+ * @param first, last Range of keys; the keys must stay in place while the
+ * range is read (forward iterators).
+ * @param out Receives an iterator to the found element, or end(), for each
+ * key in the order of the range.
+ *
+ * @return OutputIt The output iterator past the last written one.
+ *
+ * @throws Whatever the comparator or out throw.
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt RBTree<Key, Comparator, Allocator>::findMany(ForwardIt first,
+                                                      ForwardIt last,
+                                                      OutputIt out) {
+  findBatch(first, last, [&](Node *node) {
+    *out = node != nullptr ? makeIterator(node) : end();
+    ++out;
+  });
+  return out;
+}
+
+template <typename Key, typename Comparator, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt RBTree<Key, Comparator, Allocator>::findMany(ForwardIt first,
+                                                      ForwardIt last,
+                                                      OutputIt out) const {
+  findBatch(first, last, [&](const Node *node) {
+    *out = node != nullptr ? makeIterator(node) : end();
+    ++out;
+  });
+  return out;
+}
+
+/**
+ * @brief Checks every key of a range, see findMany().
+ *
+ * @param first, last Range of keys (forward iterators).
+ * @param out Receives true or false for each key in the order of the range.
+ *
+ * @return OutputIt The output iterator past the last written one.
+ *
+ * @throws Whatever the comparator or out throw.
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename ForwardIt, typename OutputIt>
+OutputIt RBTree<Key, Comparator, Allocator>::containsMany(
+    ForwardIt first, ForwardIt last, OutputIt out) const {
+  findBatch(first, last, [&](const Node *node) {
+    *out = node != nullptr;
+    ++out;
+  });
+  return out;
+}
+
+/**
+ * @brief Returns the number of elements with keys less than key.
+ *
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param key The key to rank.
+ *
+ * @return size_type The number of elements less than key. O(log n).
+ *
+ * @throws anything thrown by the comparator
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K, typename C, typename>
+typename RBTree<Key, Comparator, Allocator>::size_type
+RBTree<Key, Comparator, Allocator>::rank(const K &key) const {
+  return countLess(key, false);
+}
+
+/**
+ * @brief Gets the node with the minimum key in the subtree rooted at the
+ * specified node.
+ *
+ * @param node The root of the subtree.
+ *
+ * @return Node* The node with the minimum key in the subtree.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::getMinNode(Node *node) const {
+  return findMinNode(node);
+}
+
+/**
+ * @brief Gets the node with the maximum key in the subtree rooted at the
+ * specified node.
+ *
+ * @param node The root of the subtree.
+ *
+ * @return Node* The node with the maximum key in the subtree.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::getMaxNode(Node *node) const {
+  return findMaxNode(node);
+}
+
+/**
+ * @brief Gets the root node of the RBTree.
+ *
+ * @return const Node* The root node of the RBTree.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+const typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::getRoot() const {
+  return root();
+}
+
+/**
+ * @brief Checks whether a node is the header node of its tree.
+ *
+ * The header is the only red node that is the parent of its own parent (the
+ * root), or the only node without a parent (the header of an empty tree).
+ *
+ * @param node A node of a tree or its header.
+ *
+ * @return bool true if node is the header (the end() position).
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::isHeader(
+    const BaseNode *node) noexcept {
+  return node->parent() == nullptr ||
+         (node->isRed() && node->parent()->parent() == node);
+}
+
+/**
+ * @brief Gets the in-order successor of a node.
+ *
+ * The successor of the maximum is the header, amortized O(1).
+ *
+ * @param node A node of a tree (not the header).
+ *
+ * @return BaseNode* The next node in key order, or the header.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::BaseNode *
+RBTree<Key, Comparator, Allocator>::nextNode(const BaseNode *node) noexcept {
+  BaseNode *x = const_cast<BaseNode *>(node);
+  if (x->right_ != nullptr) {
+    x = x->right_;
+    while (x->left_ != nullptr) {
+      x = x->left_;
+    }
+    return x;
+  }
+  BaseNode *y = x->parent();
+  while (x == y->right_) {
+    x = y;
+    y = y->parent();
+  }
+  // у дерева из одного узла корень - правый сын заголовка, подъём
+  // останавливается на заголовке, и ответом должен быть он
+  if (x->right_ != y) {
+    x = y;
+  }
+  return x;
+}
+
+/**
+ * @brief Gets the in-order predecessor of a node.
+ *
+ * The predecessor of the header is the maximum, O(1).
+ *
+ * @param node A node of a tree or its header.
+ *
+ * @return BaseNode* The previous node in key order.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::BaseNode *
+RBTree<Key, Comparator, Allocator>::prevNode(const BaseNode *node) noexcept {
+  BaseNode *x = const_cast<BaseNode *>(node);
+  if (isHeader(x)) {
+    return x->right_; // --end() - максимальный узел
+  }
+  if (x->left_ != nullptr) {
+    x = x->left_;
+    while (x->right_ != nullptr) {
+      x = x->right_;
+    }
+    return x;
+  }
+  BaseNode *y = x->parent();
+  while (x == y->left_) {
+    x = y;
+    y = y->parent();
+  }
+  return y;
+}
+
+/**
+ * @brief Gets the node with the k-th smallest key (counting from 0) of a
+ * subtree.
+ *
+ * Descends from the root using the stored subtree sizes, O(log n).
+ *
+ * @param root The root of the subtree, may be nullptr.
+ * @param k The zero-based position in key order.
+ *
+ * @return Node* The node at position k, or nullptr if k is out of range.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::getNthNode(const BaseNode *root,
+                                               size_type k) noexcept {
+  Node *node = static_cast<Node *>(const_cast<BaseNode *>(root));
+  while (node != nullptr) {
+    size_type left = subtreeSize(node->left_);
+    if (k < left) {
+      node = static_cast<Node *>(node->left_);
+    } else if (k == left) {
+      break;
+    } else {
+      k -= left + 1; // пропускаем левое поддерево и сам узел
+      node = static_cast<Node *>(node->right_);
+    }
+  }
+  return node;
+}
+
+/**
+ * @brief Gets the position of a node in key order (counting from 0).
+ *
+ * Walks from the node up to the root, O(log n).
+ *
+ * @param node A node of a tree, or its header for the end position.
+ *
+ * @return size_type The number of nodes before node; size() for the header.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::size_type
+RBTree<Key, Comparator, Allocator>::getNodeIndex(
+    const BaseNode *node) noexcept {
+  if (isHeader(node)) {
+    return subtreeSize(node->parent());
+  }
+  size_type index = subtreeSize(node->left_);
+  for (const BaseNode *child = node; !isHeader(child->parent());
+       child = child->parent()) {
+    // пришли из правого поддерева - родитель и его левая часть раньше нас
+    if (child == child->parent()->right_) {
+      index += subtreeSize(child->parent()->left_) + 1;
+    }
+  }
+  return index;
+}
+
+/**
+ * @brief Gets the root node of the RBTree.
+ *
+ * @return Node* The root node, or nullptr if the tree is empty.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::root() const noexcept {
+  return static_cast<Node *>(header_.parent());
+}
+
+/**
+ * @brief Makes a node the root of the RBTree.
+ *
+ * Only the links between the header and the root are updated; the cached
+ * leftmost and rightmost nodes are left as they are.
+ *
+ * @param node The new root, or nullptr.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::setRoot(Node *node) noexcept {
+  header_.setParent(node);
+  if (node != nullptr) {
+    node->setParent(&header_);
+  }
+}
+
+/**
+ * @brief Resets the header to the state of an empty tree.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::resetHeader() noexcept {
+  header_.setParent(nullptr);
+  header_.left_ = &header_;
+  header_.right_ = &header_;
+  header_.setRed(true); // отличает заголовок от корня в isHeader()
+}
+
+/**
+ * @brief Repairs the links to the header after it was copied or swapped.
+ *
+ * The root points to its header by address, so a header taken over from
+ * another tree has to be reattached.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::adoptHeader() noexcept {
+  if (header_.parent() == nullptr) {
+    resetHeader();
+  } else {
+    header_.parent()->setParent(&header_);
+  }
+}
+
+/**
+ * @brief Recomputes the cached leftmost and rightmost nodes, O(log n).
+ *
+ * Used after a whole tree has been built at once.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::updateExtremes() noexcept {
+  if (root() == nullptr) {
+    resetHeader();
+  } else {
+    header_.left_ = findMinNode(root());
+    header_.right_ = findMaxNode(root());
+  }
+}
+
+/**
+ * @brief Creates an iterator to a node; nullptr means the end position.
+ *
+ * @param node A node of this tree, its header, or nullptr.
+ *
+ * @return iterator An iterator to node, or end().
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::makeIterator(BaseNode *node) noexcept {
+  return iterator(node != nullptr ? node : &header_);
+}
+
+/**
+ * @brief Creates a const_iterator to a node; nullptr means the end position.
+ *
+ * @param node A node of this tree, its header, or nullptr.
+ *
+ * @return const_iterator A const_iterator to node, or end().
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::const_iterator
+RBTree<Key, Comparator, Allocator>::makeIterator(
+    const BaseNode *node) const noexcept {
+  return const_iterator(node != nullptr ? node : &header_);
+}
+
+/**
+ * @brief Gets an iterator to the first element in the RBTree, O(1).
+ *
+ * @return iterator An iterator to the first element in the RBTree.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+RBTreeIterator<Key, Comparator, Allocator>
+RBTree<Key, Comparator, Allocator>::begin() noexcept {
+  return iterator(header_.left_); // в пустом дереве это сам заголовок
+}
+
+/**
+ * @brief Gets an iterator to the end of the RBTree.
+ *
+ * @return iterator An iterator to the end of the RBTree.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+RBTreeIterator<Key, Comparator, Allocator>
+RBTree<Key, Comparator, Allocator>::end() noexcept {
+  return iterator(&header_);
+}
+
+/**
+ * @brief Gets a const_iterator to the first element in the RBTree, O(1).
+ *
+ * @return const_iterator A const_iterator to the first element in the RBTree.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::const_iterator
+RBTree<Key, Comparator, Allocator>::begin() const noexcept {
+  return const_iterator(header_.left_);
+}
+
+/**
+ * @brief Gets a const_iterator to the end of the RBTree.
+ *
+ * @return const_iterator A const_iterator to the end of the RBTree.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::const_iterator
+RBTree<Key, Comparator, Allocator>::end() const noexcept {
+  return const_iterator(&header_);
+}
+
+/**
+ * @brief Gets a const_iterator to the first element in the RBTree, O(1).
+ *
+ * @return const_iterator A const_iterator to the first element in the RBTree.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::const_iterator
+RBTree<Key, Comparator, Allocator>::cbegin() const noexcept {
+  return begin();
+}
+
+/**
+ * @brief Gets a const_iterator to the end of the RBTree.
+ *
+ * @return const_iterator A const_iterator to the end of the RBTree.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::const_iterator
+RBTree<Key, Comparator, Allocator>::cend() const noexcept {
+  return end();
+}
+
+/**
+ * @brief Gets a reverse iterator to the last element in the RBTree, O(1).
+ *
+ * @return reverse_iterator A reverse iterator to the largest element.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::reverse_iterator
+RBTree<Key, Comparator, Allocator>::rbegin() noexcept {
+  return reverse_iterator(end());
+}
+
+/**
+ * @brief Gets a reverse iterator past the first element in the RBTree.
+ *
+ * @return reverse_iterator The reverse end position.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::reverse_iterator
+RBTree<Key, Comparator, Allocator>::rend() noexcept {
+  return reverse_iterator(begin());
+}
+
+/**
+ * @brief Gets a const reverse iterator to the last element, O(1).
+ *
+ * @return const_reverse_iterator A reverse iterator to the largest element.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::const_reverse_iterator
+RBTree<Key, Comparator, Allocator>::rbegin() const noexcept {
+  return const_reverse_iterator(end());
+}
+
+/**
+ * @brief Gets a const reverse iterator past the first element.
+ *
+ * @return const_reverse_iterator The reverse end position.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::const_reverse_iterator
+RBTree<Key, Comparator, Allocator>::rend() const noexcept {
+  return const_reverse_iterator(begin());
+}
+
+/**
+ * @brief Inserts a new element with the specified key into the RBTree.
+ *
+ * @param key The key of the element to insert.
+ *
+ * @return std::pair<iterator, bool> A pair consisting of an iterator to the
+ * inserted element (or to the element that prevented the insertion) and a bool
+ * denoting whether the insertion took place.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+std::pair<typename RBTree<Key, Comparator, Allocator>::iterator, bool>
+RBTree<Key, Comparator, Allocator>::insert(const key_type &key) {
+  return insert(key, false);
+}
+
+/**
+ * @brief Inserts a new element with the specified key into the RBTree, ensuring
+ * unique keys.
+ *
+ * @param key The key of the element to insert.
+ *
+ * @return std::pair<iterator, bool> A pair consisting of an iterator to the
+ * inserted element (or to the element that prevented the insertion) and a bool
+ * denoting whether the insertion took place.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+std::pair<typename RBTree<Key, Comparator, Allocator>::iterator, bool>
+RBTree<Key, Comparator, Allocator>::insertUnique(const key_type &key) {
+  return insert(key, true);
+}
+
+/**
+ * @brief Inserts a new element, moving the key into the new node.
+ *
+ * @param key The key of the element to insert.
+ *
+ * @return std::pair<iterator, bool> A pair consisting of an iterator to the
+ * inserted element and true.
+ *
+ * @throws std::bad_alloc, anything thrown by the key move constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+std::pair<typename RBTree<Key, Comparator, Allocator>::iterator, bool>
+RBTree<Key, Comparator, Allocator>::insert(key_type &&key) {
+  return insert(std::move(key), false);
+}
+
+/**
+ * @brief Inserts a new element moving the key into the new node, ensuring
+ * unique keys.
+ *
+ * If an equivalent key already exists, no node is allocated and key is left
+ * untouched.
+ *
+ * @param key The key of the element to insert.
+ *
+ * @return std::pair<iterator, bool> A pair consisting of an iterator to the
+ * inserted element (or to the element that prevented the insertion) and a bool
+ * denoting whether the insertion took place.
+ *
+ * @throws std::bad_alloc, anything thrown by the key move constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+std::pair<typename RBTree<Key, Comparator, Allocator>::iterator, bool>
+RBTree<Key, Comparator, Allocator>::insertUnique(key_type &&key) {
+  return insert(std::move(key), true);
+}
+
+/**
+ * @brief Inserts a new element whose key is constructed in place from args.
+ *
+ * The node is constructed exactly once; equivalent keys are allowed and the
+ * new element is placed after them.
+ *
+ * @param args Arguments forwarded to the key constructor.
+ *
+ * @return std::pair<iterator, bool> A pair consisting of an iterator to the
+ * inserted element and true.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename... Args>
+std::pair<typename RBTree<Key, Comparator, Allocator>::iterator, bool>
+RBTree<Key, Comparator, Allocator>::emplace(Args &&...args) {
+  Node *new_node = createNode(std::in_place, std::forward<Args>(args)...);
+  Node *parent = nullptr;
+  bool to_left = false;
+  findInsertPosition(new_node->key_, false, parent, to_left);
+  return {linkNode(new_node, parent, to_left), true};
+}
+
+/**
+ * @brief Inserts a new element whose key is constructed in place from args,
+ * ensuring unique keys.
+ *
+ * A single argument of type key_type is looked up before any node is
+ * allocated. Otherwise the key can only be compared once it is built, so the
+ * node is constructed first and released again if an equivalent key exists;
+ * use tryEmplace() to avoid that when the key is known.
+ *
+ * @param args Arguments forwarded to the key constructor.
+ *
+ * @return std::pair<iterator, bool> A pair consisting of an iterator to the
+ * inserted element (or to the element that prevented the insertion) and a bool
+ * denoting whether the insertion took place.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename... Args>
+std::pair<typename RBTree<Key, Comparator, Allocator>::iterator, bool>
+RBTree<Key, Comparator, Allocator>::emplaceUnique(Args &&...args) {
+  if constexpr (sizeof...(Args) == 1 &&
+                (std::is_same<typename std::decay<Args>::type,
+                              key_type>::value && ...)) {
+    return insert(std::forward<Args>(args)..., true);
+  } else {
+    Node *new_node = createNode(std::in_place, std::forward<Args>(args)...);
+    Node *parent = nullptr;
+    bool to_left = false;
+    Node *existing = findInsertPosition(new_node->key_, true, parent, to_left);
+    if (existing != nullptr) {
+      destroyNode(new_node);
+      return {makeIterator(existing), false};
+    }
+    return {linkNode(new_node, parent, to_left), true};
+  }
+}
+
+/**
+ * @brief Inserts an element constructed in place from args if there is no
+ * element equivalent to key.
+ *
+ * The lookup uses key directly, so when the key already exists nothing is
+ * allocated or constructed and args are not touched.
+ *
+ * @param key The key to look up; any type the comparator accepts.
+ * @param args Arguments forwarded to the key constructor of the new element.
+ *
+ * @return std::pair<iterator, bool> A pair consisting of an iterator to the
+ * inserted element (or to the element that prevented the insertion) and a bool
+ * denoting whether the insertion took place.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K, typename... Args>
+std::pair<typename RBTree<Key, Comparator, Allocator>::iterator, bool>
+RBTree<Key, Comparator, Allocator>::tryEmplace(const K &key, Args &&...args) {
+  Node *parent = nullptr;
+  bool to_left = false;
+  Node *existing = findInsertPosition(key, true, parent, to_left);
+  if (existing != nullptr) {
+    return {makeIterator(existing), false};
+  }
+  Node *new_node = createNode(std::in_place, std::forward<Args>(args)...);
+  return {linkNode(new_node, parent, to_left), true};
+}
+
+/**
+ * @brief Inserts a copy of the key, using hint as a suggestion for the place.
+ *
+ * If the key belongs right before hint (or at the end for end()), the node
+ * is linked without a descent from the root; otherwise the usual search is
+ * done. Equivalent keys are allowed, the new one is placed as close as
+ * possible before hint.
+ *
+ * @param hint Iterator to the element before which the key is expected.
+ * @param key The key to insert.
+ *
+ * @return iterator An iterator to the inserted element.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ *
+ * @see findHintPosition
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::insert(const_iterator hint,
+                                           const key_type &key) {
+  return insertKeyHint(hint, key, false);
+}
+
+/**
+ * @brief Inserts the key moved into the new node, using hint as a suggestion
+ * for the place.
+ *
+ * @param hint Iterator to the element before which the key is expected.
+ * @param key The key to insert.
+ *
+ * @return iterator An iterator to the inserted element.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::insert(const_iterator hint,
+                                           key_type &&key) {
+  return insertKeyHint(hint, std::move(key), false);
+}
+
+/**
+ * @brief Inserts a copy of the key if it is not present yet, using hint as a
+ * suggestion for the place.
+ *
+ * @param hint Iterator to the element before which the key is expected.
+ * @param key The key to insert.
+ *
+ * @return iterator An iterator to the inserted element or to the element
+ * that prevented the insertion.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::insertUnique(const_iterator hint,
+                                                 const key_type &key) {
+  return insertKeyHint(hint, key, true);
+}
+
+/**
+ * @brief Inserts the key moved into the new node if it is not present yet,
+ * using hint as a suggestion for the place.
+ *
+ * @param hint Iterator to the element before which the key is expected.
+ * @param key The key to insert; left untouched if it already exists.
+ *
+ * @return iterator An iterator to the inserted element or to the element
+ * that prevented the insertion.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::insertUnique(const_iterator hint,
+                                                 key_type &&key) {
+  return insertKeyHint(hint, std::move(key), true);
+}
+
+/**
+ * @brief Inserts a new element constructed in place from args, using hint as
+ * a suggestion for the place.
+ *
+ * @param hint Iterator to the element before which the key is expected.
+ * @param args Arguments forwarded to the key constructor.
+ *
+ * @return iterator An iterator to the inserted element.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename... Args>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::emplaceHint(const_iterator hint,
+                                                Args &&...args) {
+  Node *new_node = createNode(std::in_place, std::forward<Args>(args)...);
+  Node *parent = nullptr;
+  bool to_left = false;
+  findHintPosition(hint, new_node->key_, false, parent, to_left);
+  return linkNode(new_node, parent, to_left);
+}
+
+/**
+ * @brief Inserts a new element constructed in place from args if its key is
+ * not present yet, using hint as a suggestion for the place.
+ *
+ * As in emplaceUnique(), a single key_type argument is looked up before any
+ * node is allocated.
+ *
+ * @param hint Iterator to the element before which the key is expected.
+ * @param args Arguments forwarded to the key constructor.
+ *
+ * @return iterator An iterator to the inserted element or to the element
+ * that prevented the insertion.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename... Args>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::emplaceHintUnique(const_iterator hint,
+                                                      Args &&...args) {
+  if constexpr (sizeof...(Args) == 1 &&
+                (std::is_same<typename std::decay<Args>::type,
+                              key_type>::value && ...)) {
+    return insertKeyHint(hint, std::forward<Args>(args)..., true);
+  } else {
+    Node *new_node = createNode(std::in_place, std::forward<Args>(args)...);
+    Node *parent = nullptr;
+    bool to_left = false;
+    Node *existing =
+        findHintPosition(hint, new_node->key_, true, parent, to_left);
+    if (existing != nullptr) {
+      destroyNode(new_node);
+      return makeIterator(existing);
+    }
+    return linkNode(new_node, parent, to_left);
+  }
+}
+
+/**
+ * @brief Inserts an element constructed in place from args if there is no
+ * element equivalent to key, using hint as a suggestion for the place.
+ *
+ * @param hint Iterator to the element before which the key is expected.
+ * @param key The key to look up; any type the comparator accepts.
+ * @param args Arguments forwarded to the key constructor of the new element.
+ *
+ * @return std::pair<iterator, bool> A pair consisting of an iterator to the
+ * inserted element (or to the element that prevented the insertion) and a bool
+ * denoting whether the insertion took place.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K, typename... Args>
+std::pair<typename RBTree<Key, Comparator, Allocator>::iterator, bool>
+RBTree<Key, Comparator, Allocator>::tryEmplaceHint(const_iterator hint,
+                                                   const K &key,
+                                                   Args &&...args) {
+  Node *parent = nullptr;
+  bool to_left = false;
+  Node *existing = findHintPosition(hint, key, true, parent, to_left);
+  if (existing != nullptr) {
+    return {makeIterator(existing), false};
+  }
+  Node *new_node = createNode(std::in_place, std::forward<Args>(args)...);
+  return {linkNode(new_node, parent, to_left), true};
+}
+
+/**
+ * @brief Erases a node from the Red-Black Tree.
+ *
+ * This function erases the node pointed to by the given iterator from the
+ * Red-Black Tree. It handles the rebalancing of the tree after the node is
+ * removed and ensures that the Red-Black Tree properties are maintained.
+ *
+ * @tparam Key The type of the keys in the tree.
+ * @tparam Comparator The type of the comparator used to compare keys.
+ * @param pos An iterator pointing to the node to be erased.
+ *
+ * @note This function assumes that the tree is not empty and that the
+ *       iterator is valid. The caller is responsible for ensuring that
+ *       the iterator is valid.
+ *
+ * @warning This function does not handle the case where the tree is empty or
+ * the iterator is invalid. The caller is responsible for ensuring that the tree
+ * is not empty and the iterator is valid.
+ *
+ * @see RBTree
+ * @see eraseNode
+ * @see eraseFixup
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::erase(iterator pos) {
+  Node *eraised_node = pos.getCurrentNode();
+  if (!eraised_node || eraised_node == &header_) {
+    return;
+  }
+  unlinkNode(eraised_node);
+  destroyNode(eraised_node);
+}
+
+/**
+ * @brief Erases the elements in [first, last).
+ *
+ * Short ranges are erased node by node, longer ones are cut out of the tree
+ * as a whole and the tree is rebalanced in O(log n) instead of once per
+ * element (see eraseRun()). The nodes outside the range are not moved and
+ * iterators to them stay valid.
+ *
+ * @param first Beginning of the range, an iterator of this tree.
+ * @param last End of the range, reachable from first.
+ *
+ * @return iterator Iterator to last.
+ *
+ * @throws N/A
+ *
+ * @see eraseRun
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::erase(const_iterator first,
+                                          const_iterator last) {
+  BaseNode *end_node = const_cast<Node *>(last.getCurrentNode());
+  if (first != last) {
+    eraseRun(first, last,
+             getNodeIndex(end_node) - getNodeIndex(first.getCurrentNode()));
+  }
+  return makeIterator(end_node);
+}
+
+/**
+ * @brief Erases count elements starting at first.
+ *
+ * Runs shorter than kBulkEraseMin are erased node by node. A longer run is
+ * cut out as a whole: two splitAt() calls separate it, its nodes are
+ * destroyed without any rebalancing and the rest is joined back, O(log n +
+ * count).
+ *
+ * @param first The first element to erase.
+ * @param last The element after the run.
+ * @param count Number of elements in [first, last).
+ *
+ * @throws N/A
+ *
+ * @see splitAt
+ * @see joinTrees
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::eraseRun(const_iterator first,
+                                                  const_iterator last,
+                                                  size_type count) {
+  if (count < kBulkEraseMin) {
+    while (first != last) {
+      Node *node = const_cast<Node *>(first.getCurrentNode());
+      ++first;
+      unlinkNode(node);
+      destroyNode(node);
+    }
+    return;
+  }
+
+  // узлы всех трёх частей остаются в пуле этого дерева
+  RBTree middle(get_allocator());
+  RBTree tail(get_allocator());
+  splitAt(getNodeIndex(first.getCurrentNode()), middle);
+  middle.splitAt(count, tail);
+  Node *erased = middle.root();
+  middle.resetHeader();
+  middle.size_ = 0;
+  deleteSubtree(erased);
+  joinTrees(tail, false); // пул tail пуст, splice ничего не выделяет
+}
+
+/**
+ * @brief Erases all elements equivalent to key.
+ *
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param key The key to erase.
+ *
+ * @return size_type The number of erased elements.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K>
+typename RBTree<Key, Comparator, Allocator>::size_type
+RBTree<Key, Comparator, Allocator>::eraseEqual(const K &key) {
+  const_iterator first = makeIterator(lowerBoundNode(key));
+  const_iterator last = makeIterator(upperBoundNode(key));
+  size_type count = getNodeIndex(last.getCurrentNode()) -
+                    getNodeIndex(first.getCurrentNode());
+  erase(first, last);
+  return count;
+}
+
+/**
+ * @brief Erases all elements for which pred returns true.
+ *
+ * The tree is walked once in key order. Every run of consecutive matching
+ * elements is erased by eraseRun(), so a long run (expired keys below a
+ * watermark) is cut out as a whole and scattered matches cost the same as
+ * single erases. Iterators to the remaining elements stay valid.
+ *
+ * @tparam Pred Predicate callable with a const reference to a key.
+ * @param pred The predicate, called once per element in key order.
+ *
+ * @return size_type The number of erased elements.
+ *
+ * @throws Anything thrown by pred; the elements found before the exception
+ * are erased and the tree stays valid.
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename Pred>
+typename RBTree<Key, Comparator, Allocator>::size_type
+RBTree<Key, Comparator, Allocator>::eraseIf(Pred pred) {
+  size_type erased = 0;
+  const_iterator it = cbegin();
+  while (it != cend()) {
+    if (!pred(*it)) {
+      ++it;
+      continue;
+    }
+    const_iterator first = it;
+    size_type count = 1;
+    try {
+      for (++it; it != cend() && pred(*it); ++it) {
+        ++count;
+      }
+    } catch (...) {
+      eraseRun(first, it, count);
+      throw;
+    }
+    eraseRun(first, it, count);
+    erased += count;
+  }
+  return erased;
+}
+
+/******************************************************************************
+ * NODE HANDLES
+ ******************************************************************************/
+
+/**
+ * @brief Removes the element at pos and returns its node in a node handle.
+ *
+ * The node itself is handed over, the key is neither moved nor copied. With
+ * the node pool the node stays in a slab of this tree, and the handle takes
+ * a reference to that slab only (RBTNodePool::pinSlab()), so it may outlive
+ * the tree without keeping the rest of its memory. Finding the slab takes
+ * O(number of slabs) besides the O(log n) unlinking.
+ *
+ * @param pos Iterator to the element to extract, must be dereferenceable.
+ *
+ * @return node_handle Handle owning the extracted node.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::node_handle
+RBTree<Key, Comparator, Allocator>::extract(const_iterator pos) {
+  Node *node = const_cast<Node *>(pos.getCurrentNode());
+  void *slab = pool_.pinSlab(node);
+  unlinkNode(node);
+  return node_handle(node, get_allocator(), slab);
+}
+
+/**
+ * @brief Removes the first element with the given key and returns its node.
+ *
+ * @param key The key to look for.
+ *
+ * @return node_handle Handle owning the extracted node, empty if there is no
+ * such key.
+ *
+ * @throws anything thrown by the comparator
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::node_handle
+RBTree<Key, Comparator, Allocator>::extract(const key_type &key) {
+  Node *node = lowerBoundNode(key);
+  if (node == nullptr || comparator_(key, node->key_)) {
+    return node_handle();
+  }
+  return extract(makeIterator(static_cast<const BaseNode *>(node)));
+}
+
+/**
+ * @brief Links the node of a node handle into the tree.
+ *
+ * Equivalent keys are allowed. The key is not copied; the allocator of the
+ * handle must compare equal to the allocator of the tree. With the node pool
+ * the tree takes over the reference of the handle to the slab the node
+ * lives in (RBTNodePool::adoptSlab()); that allocates only when the slab is
+ * new to this tree and its list of shared slabs is full.
+ *
+ * @param handle Node handle, left empty after the insertion.
+ *
+ * @return std::pair<iterator, bool> Iterator to the inserted element and
+ * true, or end() and false for an empty handle.
+ *
+ * @throws std::bad_alloc (node pool only), the handle keeps the node then
+ */
+template <typename Key, typename Comparator, typename Allocator>
+std::pair<typename RBTree<Key, Comparator, Allocator>::iterator, bool>
+RBTree<Key, Comparator, Allocator>::insert(node_handle &&handle) {
+  return insertHandle(std::move(handle), false);
+}
+
+/**
+ * @brief Links the node of a node handle into the tree if its key is not
+ * present yet.
+ *
+ * @param handle Node handle; keeps the node if the key already exists.
+ *
+ * @return std::pair<iterator, bool> Iterator to the inserted element (or to
+ * the element that prevented the insertion, or end() for an empty handle)
+ * and whether the insertion took place.
+ *
+ * @throws std::bad_alloc (node pool only), see insert(node_handle &&)
+ */
+template <typename Key, typename Comparator, typename Allocator>
+std::pair<typename RBTree<Key, Comparator, Allocator>::iterator, bool>
+RBTree<Key, Comparator, Allocator>::insertUnique(node_handle &&handle) {
+  return insertHandle(std::move(handle), true);
+}
+
+/******************************************************************************
+ * ORDER STATISTICS
+ ******************************************************************************/
+
+/**
+ * @brief Returns the number of elements whose keys are less than key.
+ *
+ * This is also the position at which key is or would be inserted.
+ * O(log n).
+ *
+ * @param key The key to rank.
+ *
+ * @return size_type The number of elements less than key.
+ *
+ * @throws anything thrown by the comparator
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::size_type
+RBTree<Key, Comparator, Allocator>::rank(const Key &key) const {
+  return countLess(key, false);
+}
+
+/**
+ * @brief Returns an iterator to the element at position k in key order.
+ *
+ * @param k The zero-based position.
+ *
+ * @return iterator Iterator to the k-th element, or end() if k >= size().
+ * O(log n).
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::nth(size_type k) noexcept {
+  return makeIterator(getNthNode(root(), k));
+}
+
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::const_iterator
+RBTree<Key, Comparator, Allocator>::nth(size_type k) const noexcept {
+  return makeIterator(getNthNode(root(), k));
+}
+
+/**
+ * @brief Returns the element at position k in key order.
+ *
+ * @param k The zero-based position.
+ *
+ * @return const_reference The k-th smallest element. O(log n).
+ *
+ * @throws std::out_of_range if k >= size()
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::const_reference
+RBTree<Key, Comparator, Allocator>::select(size_type k) const {
+  const Node *node = getNthNode(root(), k);
+  if (node == nullptr) {
+    throw std::out_of_range("Index out of range");
+  }
+  return node->key_;
+}
+
+/******************************************************************************
+ * AUXILIARY PRIVATE BASIC METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Inserts a copy of the key into the RBTree.
+ *
+ * @param key The key to be inserted.
+ * @param unique A flag indicating whether the keys should be unique. If set to
+ * true, the insertion will be aborted if the key already exists.
+ * @return A pair consisting of an iterator to the inserted node and a boolean
+ * indicating whether the insertion was successful.
+ *
+ * @see insertKey
+ */
+template <typename Key, typename Comparator, typename Allocator>
+std::pair<typename RBTree<Key, Comparator, Allocator>::iterator, bool>
+RBTree<Key, Comparator, Allocator>::insert(const key_type &key, bool unique) {
+  return insertKey(key, unique);
+}
+
+/**
+ * @brief Inserts the key into the RBTree, moving it into the new node.
+ *
+ * @param key The key to be inserted.
+ * @param unique A flag indicating whether the keys should be unique.
+ * @return A pair consisting of an iterator to the inserted node and a boolean
+ * indicating whether the insertion was successful.
+ *
+ * @see insertKey
+ */
+template <typename Key, typename Comparator, typename Allocator>
+std::pair<typename RBTree<Key, Comparator, Allocator>::iterator, bool>
+RBTree<Key, Comparator, Allocator>::insert(key_type &&key, bool unique) {
+  return insertKey(std::move(key), unique);
+}
+
+/**
+ * @brief Inserts a key into the Red-Black Tree.
+ *
+ * One descent from the root finds the place of the new node and, if unique
+ * is set, an equivalent key. The node is allocated only after that, so a
+ * rejected duplicate costs no allocation and leaves key untouched.
+ *
+ * @tparam Arg const key_type& or key_type.
+ * @param key The key to be inserted, copied or moved into the node.
+ * @param unique A flag indicating whether the keys should be unique. If set to
+ * true, the insertion will be aborted if the key already exists.
+ * @return A pair consisting of an iterator to the inserted node (or to the
+ * node that prevented the insertion) and a boolean indicating whether the
+ * insertion was successful.
+ *
+ * @see findInsertPosition
+ * @see linkNode
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename Arg>
+std::pair<typename RBTree<Key, Comparator, Allocator>::iterator, bool>
+RBTree<Key, Comparator, Allocator>::insertKey(Arg &&key, bool unique) {
+  Node *parent = nullptr;
+  bool to_left = false;
+  Node *existing = findInsertPosition(key, unique, parent, to_left);
+  if (existing != nullptr) { // узел не создаём, возвращаем уже имеющийся
+    return {makeIterator(existing), false};
+  }
+
+  Node *new_node = createNode(std::forward<Arg>(key));
+  return {linkNode(new_node, parent, to_left), true};
+}
+
+/**
+ * @brief Inserts a key into the Red-Black Tree next to hint if possible.
+ *
+ * @tparam Arg const key_type& or key_type.
+ * @param hint Iterator to the element before which the key is expected.
+ * @param key The key to be inserted, copied or moved into the node.
+ * @param unique A flag indicating whether the keys should be unique.
+ * @return An iterator to the inserted node or to the node that prevented the
+ * insertion.
+ *
+ * @see findHintPosition
+ * @see linkNode
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename Arg>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::insertKeyHint(const_iterator hint,
+                                                  Arg &&key, bool unique) {
+  Node *parent = nullptr;
+  bool to_left = false;
+  Node *existing = findHintPosition(hint, key, unique, parent, to_left);
+  if (existing != nullptr) {
+    return makeIterator(existing);
+  }
+  return linkNode(createNode(std::forward<Arg>(key)), parent, to_left);
+}
+
+/**
+ * @brief Links the node of a node handle into the tree.
+ *
+ * @param handle Node handle; emptied only if the node is linked.
+ * @param unique If true, a node with an existing key is not linked.
+ *
+ * @return std::pair<iterator, bool> Iterator to the inserted element (or to
+ * the element that prevented the insertion, or end() for an empty handle)
+ * and whether the insertion took place.
+ *
+ * @see insert(node_handle &&)
+ */
+template <typename Key, typename Comparator, typename Allocator>
+std::pair<typename RBTree<Key, Comparator, Allocator>::iterator, bool>
+RBTree<Key, Comparator, Allocator>::insertHandle(node_handle &&handle,
+                                                 bool unique) {
+  if (handle.empty()) {
+    return {end(), false};
+  }
+  Node *parent = nullptr;
+  bool to_left = false;
+  Node *existing =
+      findInsertPosition(handle.node_->key_, unique, parent, to_left);
+  if (existing != nullptr) {
+    return {makeIterator(existing), false}; // узел остаётся в handle
+  }
+  pool_.adoptSlab(handle.slab_); // может бросить, узел ещё в handle
+  Node *node = handle.release();
+  resetNode(node);
+  return {linkNode(node, parent, to_left), true};
+}
+
+/**
+ * @brief Moves the nodes of other into this tree.
+ *
+ * With equal allocators other is flattened into a sorted list of nodes, its
+ * slabs are taken over by this pool, and every node is relinked here. The
+ * keys come in order, so each one is placed with the hint right after the
+ * previous one (findHintPosition()), mostly without a descent from the root.
+ * No node is allocated and no key is copied; only the list of slabs shared
+ * with other pools may grow.
+ *
+ * With unique keys, nodes whose keys already exist here go back to other
+ * as they are. Unless this tree is empty, other then keeps a reference to
+ * every slab (RBTNodePool::spliceShared()), which costs one small allocation
+ * before anything is changed; other drops them if no node came back.
+ *
+ * With different allocators the nodes cannot change owner, and the moved
+ * keys are moved into new nodes and erased from other. Moving a Map element
+ * copies its const key.
+ *
+ * @param other The tree to take the nodes from.
+ * @param unique If true, only nodes with new keys are moved.
+ *
+ * @throws std::bad_alloc with equal allocators; both trees are unchanged
+ * then. With different allocators also anything thrown by the key
+ * constructor; the elements moved so far stay moved.
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::mergeNodes(RBTree &other,
+                                                    bool unique) {
+  if (this == &other || other.empty()) {
+    return;
+  }
+  if (!pool_.canSplice(other.pool_)) {
+    // узлы чужого аллокатора не переносим - перемещаем ключи в новые узлы
+    for (auto it = other.begin(); it != other.end();) {
+      auto current = it++;
+      if (insert(std::move(*current), unique).second) {
+        other.erase(current);
+      }
+    }
+    return;
+  }
+
+  // до изменения деревьев: может бросить
+  if (unique && !empty()) { // в пустом дереве повторов не бывает
+    pool_.spliceShared(other.pool_);
+  } else {
+    pool_.splice(other.pool_);
+  }
+  Node *list = other.detachAll();
+
+  Node *kept = nullptr; // узлы с уже имеющимися ключами (в обратном порядке)
+  const_iterator hint = end();
+  while (list != nullptr) {
+    Node *node = list;
+    list = static_cast<Node *>(list->right_);
+    Node *parent = nullptr;
+    bool to_left = false;
+    Node *existing = findHintPosition(hint, node->key_, unique, parent,
+                                      to_left);
+    if (existing != nullptr) {
+      node->right_ = kept;
+      kept = node;
+      hint = const_iterator(nextNode(existing));
+      continue;
+    }
+    resetNode(node);
+    linkNode(node, parent, to_left);
+    hint = const_iterator(nextNode(node)); // следующий ключ не меньше
+  }
+
+  if (kept == nullptr) {
+    other.pool_.release(); // other пуст - его доля слэбов не нужна
+  }
+  while (kept != nullptr) { // возвращаем в other от большего к меньшему
+    Node *node = kept;
+    kept = static_cast<Node *>(kept->right_);
+    resetNode(node);
+    Node *min =
+        other.empty() ? nullptr : static_cast<Node *>(other.header_.left_);
+    other.linkNode(node, min, true); // новый минимум other
+  }
+}
+
+/**
+ * @brief Unlinks all nodes at once and returns them as a sorted list.
+ *
+ * Left children are rotated to the top until none is left (as in
+ * deleteSubtree()), which turns the tree into a list linked by right_ in
+ * O(n) without extra memory. The tree is left empty; the nodes stay in the
+ * pool.
+ *
+ * @return Node* The smallest node, each node points to the next one through
+ * right_; nullptr for an empty tree.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::detachAll() noexcept {
+  BaseNode *head = nullptr;
+  BaseNode **link = &head; // куда записать следующий узел списка
+  Node *node = root();
+  while (node) {
+    if (node->left_) {
+      // поворачиваем левого сына наверх
+      Node *left = static_cast<Node *>(node->left_);
+      node->left_ = left->right_;
+      left->right_ = node;
+      node = left;
+    } else {
+      // левого сына нет - узел следующий по порядку
+      *link = node;
+      link = &node->right_;
+      node = static_cast<Node *>(node->right_);
+    }
+  }
+  resetHeader();
+  size_ = 0;
+  return static_cast<Node *>(head);
+}
+
+/**
+ * @brief Prepares a node that left a tree to be linked again.
+ *
+ * @param node The node, becomes red and childless.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::resetNode(Node *node) noexcept {
+  node->left_ = node->right_ = nullptr;
+  node->setParent(nullptr);
+  node->setRed(true);
+  node->size_ = 1;
+}
+
+/**
+ * @brief Deletes all nodes in the subtree starting from the given node.
+ *
+ * This function iteratively deletes all nodes in the subtree starting from the
+ * given node. Instead of an auxiliary stack it rotates the left child of the
+ * current node to the top until there is none, so the subtree is flattened
+ * into a right-leaning list that is freed node by node in O(1) extra memory.
+ * Parent pointers are not used, so the subtree may be partially built.
+ *
+ * @tparam Key The type of the keys in the tree.
+ * @tparam Comparator The type of the comparator used to compare keys.
+ * @param node The root node of the subtree to be deleted.
+ *
+ * @see RBTree
+ * @see destroyNode
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::deleteSubtree(Node *node) {
+  // Итеративно удаляет все узлы в поддереве,
+  // начиная с заданного узла.
+  // Очищает все узлы дерева и освобождает память.
+
+  while (node) {
+    if (node->left_) {
+      // поворачиваем левого сына наверх
+      Node *left = reinterpret_cast<Node *>(node->left_);
+      node->left_ = left->right_;
+      left->right_ = node;
+      node = left;
+    } else {
+      // левого сына нет - удаляем узел и идём направо
+      Node *right = reinterpret_cast<Node *>(node->right_);
+      destroyNode(node);
+      node = right;
+    }
+  }
+}
+
+/**
+ * @brief Constructs a new node in memory taken from the node pool.
+ *
+ * @param args Arguments forwarded to the node constructor
+ *
+ * @return Node* The new red node without links.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename... Args>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::createNode(Args &&...args) {
+  Node *memory = pool_.allocate();
+  try {
+    return new (memory) Node(std::forward<Args>(args)...);
+  } catch (...) {
+    pool_.deallocate(memory);
+    throw;
+  }
+}
+
+/**
+ * @brief Destroys the node and returns its memory to the node pool.
+ *
+ * @param node The node to destroy
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::destroyNode(Node *node) noexcept {
+  node->~Node();
+  pool_.deallocate(node);
+}
+
+/**
+ * @brief Returns the number of nodes in a subtree.
+ *
+ * @param node The root of the subtree, may be nullptr.
+ *
+ * @return size_type The stored size of the subtree, 0 for nullptr.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::size_type
+RBTree<Key, Comparator, Allocator>::subtreeSize(
+    const BaseNode *node) noexcept {
+  return node ? static_cast<const Node *>(node)->size_ : 0;
+}
+
+/**
+ * @brief Recomputes the subtree size of a node from its children.
+ *
+ * @param node The node whose children already have correct sizes.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::updateSize(Node *node) noexcept {
+  node->size_ = subtreeSize(node->left_) + subtreeSize(node->right_) + 1;
+}
+
+/**
+ * @brief Decrements the subtree sizes of a node and all its ancestors.
+ *
+ * Called before a node leaves the tree, with the parent of the removed
+ * position.
+ *
+ * @param node The lowest node that loses a descendant, or the header.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::decrementSizes(
+    BaseNode *node) noexcept {
+  for (; node != &header_; node = node->parent()) {
+    --static_cast<Node *>(node)->size_;
+  }
+}
+
+/**
+ * @brief Finds the node with the specified key in the RBTree.
+ *
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param key The key to find.
+ *
+ * @return Node* The node with the specified key, or nullptr if not found.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::findNode(
+    const K &key) const { // вспомогательный метод для нахождения узла
+  Node *current = root();
+  bool flag = false;
+
+  while (current != nullptr) {
+    if (comparator_(key, current->key_)) {
+      current = reinterpret_cast<Node *>(current->left_);
+    } else if (comparator_(current->key_, key)) {
+      current = reinterpret_cast<Node *>(current->right_);
+    } else {
+      flag = true; // ключ найден, прекращаем цикл.
+      break;
+    }
+  }
+
+  return flag ? current : nullptr;
+}
+
+/**
+ * @brief Finds the first node with a key not less than the specified key.
+ *
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param key The key to find.
+ *
+ * @return Node* The node, or nullptr if all keys are less than key.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::lowerBoundNode(const K &key) const {
+  Node *current = root();
+  Node *result = nullptr;
+
+  while (current != nullptr) {
+    if (comparator_(current->key_, key)) {
+      current = reinterpret_cast<Node *>(current->right_);
+    } else {
+      result = current;
+      current = reinterpret_cast<Node *>(current->left_);
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Looks up the keys of a range in groups of kBatchWidth.
+ *
+ * The descents of one group are advanced one level per round: every
+ * unfinished search compares its key with its current node, steps to a
+ * child and prefetches it. By the time the search comes back to that child
+ * in the next round, the other searches of the group have run, and the
+ * loads of all of them were in flight at the same time.
+ *
+ * Each descent is a lower_bound search: one comparison per level, with
+ * the child and the candidate chosen without branches, and one more
+ * comparison at the end to check equality. So among equal keys the first
+ * one is found, and all searches of a group take about the same number of
+ * rounds. The results of a group are passed to fn in the order of the keys
+ * once the whole group is done.
+ *
+ * A tree smaller than kBatchMinBytes is searched one key at a time: its
+ * nodes are likely cached, and the bookkeeping of the rounds would only
+ * slow the lookups down.
+ *
+ * @tparam ForwardIt Iterator whose dereference is a reference to a stored
+ * key; the addresses of the keys of a group are kept between rounds.
+ * @param first, last Range of keys.
+ * @param fn Called with the found node or nullptr for each key.
+ *
+ * @throws Whatever the comparator or fn throw.
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename ForwardIt, typename Fn>
+void RBTree<Key, Comparator, Allocator>::findBatch(ForwardIt first,
+                                                   ForwardIt last,
+                                                   Fn &&fn) const {
+  using traits = std::iterator_traits<ForwardIt>;
+  static_assert(
+      std::is_base_of<std::forward_iterator_tag,
+                      typename traits::iterator_category>::value &&
+          std::is_lvalue_reference<typename traits::reference>::value,
+      "batched lookup needs forward iterators over stored keys");
+  using key_pointer =
+      const typename std::remove_reference<typename traits::reference>::type *;
+
+  if (size_ * sizeof(Node) < kBatchMinBytes) {
+    for (; first != last; ++first) {
+      Node *bound = lowerBoundNode(*first);
+      fn(bound != nullptr && !comparator_(*first, bound->key_) ? bound
+                                                                : nullptr);
+    }
+    return;
+  }
+
+  key_pointer keys[kBatchWidth];
+  Node *nodes[kBatchWidth];  // текущий узел поиска, nullptr - закончен
+  Node *bounds[kBatchWidth]; // первый узел не меньше ключа из пройденных
+
+  while (first != last) {
+    size_type count = 0;
+    for (; count < kBatchWidth && first != last; ++count, ++first) {
+      keys[count] = std::addressof(*first);
+      nodes[count] = root();
+      bounds[count] = nullptr;
+    }
+
+    size_type active = root() != nullptr ? count : 0;
+    while (active > 0) {
+      for (size_type i = 0; i < count; ++i) {
+        Node *node = nodes[i];
+        if (node == nullptr) {
+          continue;
+        }
+        bool go_left = !comparator_(node->key_, *keys[i]);
+        bounds[i] = go_left ? node : bounds[i];
+        Node *next = static_cast<Node *>(go_left ? node->left_ : node->right_);
+#if defined(__GNUC__)
+        // узел понадобится через круг: первый и последний байт узла (адрес
+        // считается в целых числах - next может быть nullptr, предвыборка
+        // по такому адресу ничего не делает)
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(next);
+        __builtin_prefetch(reinterpret_cast<const void *>(address));
+        __builtin_prefetch(
+            reinterpret_cast<const void *>(address + sizeof(Node) - 1));
+#endif
+        nodes[i] = next;
+        active -= next == nullptr;
+      }
+    }
+
+    for (size_type i = 0; i < count; ++i) {
+      Node *bound = bounds[i];
+      fn(bound != nullptr && !comparator_(*keys[i], bound->key_) ? bound
+                                                                  : nullptr);
+    }
+  }
+}
+
+/**
+ * @brief Finds the first node with a key greater than the specified key.
+ *
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param key The key to find.
+ *
+ * @return Node* The node, or nullptr if no key is greater than key.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::upperBoundNode(const K &key) const {
+  Node *current = root();
+  Node *result = nullptr;
+
+  while (current != nullptr) {
+    if (comparator_(key, current->key_)) {
+      // узел больше ключа — кандидат, ищем меньший кандидат слева
+      result = current;
+      current = reinterpret_cast<Node *>(current->left_);
+    } else {
+      current = reinterpret_cast<Node *>(current->right_);
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Finds the node with the minimum key in the subtree rooted at the
+ * specified node.
+ *
+ * @param node The root of the subtree.
+ *
+ * @return Node* The node with the minimum key in the subtree.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::findMinNode(
+    Node *node) const { // метод находит узел с минимальным значением ключа
+                        // в заданном поддереве
+  while (node->left_ != nullptr) {
+    node = reinterpret_cast<Node *>(node->left_);
+  }
+  return node;
+}
+
+/**
+ * @brief Finds the node with the maximum key in the subtree rooted at the
+ * specified node.
+ *
+ * @param node The root of the subtree.
+ *
+ * @return Node* The node with the maximum key in the subtree.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::findMaxNode(
+    Node *node) const { // метод находит узел с максимальным значением ключа
+                        // в заданном поддереве
+  while (node->right_ != nullptr) {
+    node = reinterpret_cast<Node *>(node->right_);
+  }
+  return node;
+}
+
+/******************************************************************************
+ * COPYING
+ ******************************************************************************/
+
+/**
+ * @brief Replaces the contents of the tree with a copy of other.
+ *
+ * The copy keeps the shape and colors of other. All its nodes are taken
+ * from the pool as one contiguous block beforehand. For large trees the
+ * upper levels are copied by the calling thread and the subtrees below them
+ * are distributed among worker threads, which never touch the allocator.
+ * Without the node pool the copy is rebuilt from the sorted keys of other by
+ * buildSorted().
+ *
+ * @param other RBTree object to be copied
+ * @param threads Number of threads. 0 selects it automatically: the copy is
+ * parallel only if other has at least kParallelCopyMin nodes and the system
+ * has more than one hardware thread.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor. The tree
+ * is left empty in that case.
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::copyFrom(const RBTree &other,
+                                                  unsigned threads) {
+  if (this == &other) {
+    return;
+  }
+  clear();
+  comparator_ = other.comparator_;
+  if constexpr (node_pool::kPooled) {
+    if (other.root() != nullptr) {
+      copyNodes(other, copyThreads(other.size_, threads));
+    }
+  } else {
+    // ключи other уже упорядочены - строим копию за O(n)
+    buildSorted(other.cbegin(), other.cend(), other.size_, other.size_,
+                false);
+  }
+}
 
-  while (current != nullptr) {
-    if (comparator_(key, current->key_)) {
-      current = reinterpret_cast<Node *>(current->left_);
-    } else if (comparator_(current->key_, key)) {
-      current = reinterpret_cast<Node *>(current->right_);
+/**
+ * @brief Chooses the number of threads for copying count nodes.
+ *
+ * @param count Number of nodes to copy
+ * @param threads Requested number of threads, 0 means automatic choice
+ *
+ * @return unsigned Number of threads, 1 means a serial copy.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+unsigned RBTree<Key, Comparator, Allocator>::copyThreads(size_type count,
+                                                         unsigned threads) {
+  if (count == 0) {
+    return 1;
+  }
+  if (threads != 0) {
+    return threads;
+  }
+  if constexpr (kParallelCopyMin == 0) {
+    return 1;
+  } else {
+    if (count < kParallelCopyMin) {
+      return 1;
+    }
+    // не меньше kParallelCopyMin / 2 узлов на поток
+    size_type by_size = count / (kParallelCopyMin / 2 + 1);
+    size_type hardware = std::thread::hardware_concurrency();
+    return static_cast<unsigned>(hardware < by_size ? hardware : by_size);
+  }
+}
+
+/**
+ * @brief Copies other into the empty tree using one or several threads.
+ *
+ * A single thread copies the whole tree with CopyTree(). Otherwise the nodes
+ * of other down to split_depth are copied by the calling thread. Every
+ * subtree hanging below becomes a task that gets its own range of the
+ * preallocated block (sized by the stored subtree size) and is copied there
+ * by one of the workers. There are several tasks per thread so that unequal
+ * subtrees are balanced out. Every copied node is linked to its parent right
+ * after construction, so after an exception the partial copy is a valid tree
+ * and is destroyed by clear().
+ *
+ * @param other Non-empty RBTree object to be copied
+ * @param threads Number of threads, at least 1
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor. The tree
+ * is left empty in that case.
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::copyNodes(const RBTree &other,
+                                                   unsigned threads) {
+  Node *slots = pool_.allocateBulk(other.size_);
+  BaseNode *root = nullptr;
+  try {
+    if (threads == 1) {
+      CopyTree(other.root(), nullptr, &root, slots);
+    } else {
+      size_type split_depth = 0; // примерно 8 поддеревьев на поток
+      while ((size_type{1} << split_depth) < size_type{threads} * 8) {
+        ++split_depth;
+      }
+      std::vector<CopyTask> tasks;
+      copyTop(other.root(), nullptr, &root, 0, split_depth, slots, tasks);
+
+      for (auto &task : tasks) {
+        task.slots = slots;
+        slots += task.size;
+      }
+
+      runParallel(tasks.size(), threads, [this, &tasks](size_type i) {
+        CopyTask &task = tasks[i];
+        try {
+          CopyTree(task.source, task.parent, task.link, task.slots);
+        } catch (...) {
+          task.error = std::current_exception();
+        }
+      });
+      for (const auto &task : tasks) {
+        if (task.error) {
+          std::rethrow_exception(task.error);
+        }
+      }
+    }
+  } catch (...) {
+    setRoot(static_cast<Node *>(root));
+    clear();
+    throw;
+  }
+
+  setRoot(static_cast<Node *>(root));
+  updateExtremes();
+  size_ = other.size_;
+}
+
+/**
+ * @brief Copies the upper levels of a subtree and collects the subtrees
+ * below split_depth as copy tasks.
+ *
+ * @param node Root of the subtree of other
+ * @param parent Parent of the copy
+ * @param link Child pointer of parent (or the root pointer) for the copy
+ * @param depth Depth of node
+ * @param split_depth Depth at which subtrees become tasks
+ * @param slots Next free node of the preallocated block, advanced
+ * @param tasks Collected tasks
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::copyTop(
+    const Node *node, Node *parent, BaseNode **link, size_type depth,
+    size_type split_depth, Node *&slots, std::vector<CopyTask> &tasks) {
+  if (node == nullptr) {
+    return;
+  }
+  if (depth == split_depth) {
+    tasks.push_back(
+        CopyTask{node, parent, link, node->size_, nullptr, nullptr});
+    return;
+  }
+  Node *copy = new (slots) Node(node->key_);
+  ++slots;
+  copy->setRed(node->isRed());
+  copy->size_ = node->size_;
+  copy->setParent(parent);
+  *link = copy;
+  copyTop(static_cast<const Node *>(node->left_), copy, &copy->left_,
+          depth + 1, split_depth, slots, tasks);
+  copyTop(static_cast<const Node *>(node->right_), copy, &copy->right_,
+          depth + 1, split_depth, slots, tasks);
+}
+
+/**
+ * @brief Copies the subtree rooted at the specified node, keeping its shape
+ * and colors.
+ *
+ * The nodes are constructed in the preallocated memory starting at slots,
+ * the pool is not used, so several subtrees may be copied concurrently.
+ *
+ * @param node The root of the subtree to copy.
+ * @param parent The parent of the copied subtree.
+ * @param link Child pointer of parent that receives the copy.
+ * @param slots Next free node of the preallocated memory, advanced.
+ *
+ * @throws anything thrown by the key constructor
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::CopyTree(const Node *node,
+                                                  Node *parent,
+                                                  BaseNode **link,
+                                                  Node *&slots) {
+  while (node != nullptr) {
+    // узел связывается с родителем сразу, поэтому при исключении уже
+    // созданная часть копии остаётся корректным деревом
+    Node *copy = new (slots) Node(node->key_);
+    ++slots;
+    copy->setRed(node->isRed());
+    copy->size_ = node->size_;
+    copy->setParent(parent);
+    *link = copy;
+    CopyTree(static_cast<const Node *>(node->left_), copy, &copy->left_,
+             slots);
+    // правое поддерево копируем в цикле - глубина рекурсии не растёт
+    node = static_cast<const Node *>(node->right_);
+    parent = copy;
+    link = &copy->right_;
+  }
+}
+
+/**
+ * @brief Calls fn(i) for every i in [0, tasks) using up to threads threads.
+ *
+ * The calling thread takes part in the work. If a worker thread cannot be
+ * started, the remaining threads do its share.
+ *
+ * @param tasks Number of tasks
+ * @param threads Maximum number of threads
+ * @param fn Task function, must not throw
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename Fn>
+void RBTree<Key, Comparator, Allocator>::runParallel(size_type tasks,
+                                                     unsigned threads,
+                                                     Fn fn) {
+  std::atomic<size_type> next{0};
+  auto work = [&next, &fn, tasks]() {
+    for (size_type i = next++; i < tasks; i = next++) {
+      fn(i);
+    }
+  };
+
+  std::vector<std::thread> workers;
+  try {
+    for (unsigned i = 1; i < threads && i < tasks; ++i) {
+      workers.emplace_back(work);
+    }
+  } catch (...) {
+    // поток не запустился - работу доделают уже запущенные
+  }
+  work();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+/******************************************************************************
+ * BULK CONSTRUCTION
+ ******************************************************************************/
+
+/**
+ * @brief Replaces the contents of the tree with the keys from [first, last).
+ *
+ * If the range is a forward range that is already sorted by the comparator,
+ * the tree is built in O(n) by buildSorted(). Otherwise (unsorted or
+ * single-pass input) the keys are inserted one by one in O(n log n).
+ *
+ * @tparam InputIt Input iterator over keys.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @param unique If true, equivalent keys are stored only once.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ *
+ * @see assignSorted
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename InputIt>
+void RBTree<Key, Comparator, Allocator>::assign(InputIt first, InputIt last,
+                                                bool unique) {
+  using category = typename std::iterator_traits<InputIt>::iterator_category;
+  if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+    size_type count = 0;
+    if (sortedCount(first, last, unique, count)) {
+      buildSorted(first, last, count, count, unique);
+      return;
+    }
+  }
+
+  clear();
+  for (; first != last; ++first) {
+    insert(*first, unique);
+  }
+}
+
+/**
+ * @brief Replaces the contents of the tree with the keys from a range that
+ * the caller guarantees to be sorted by the comparator.
+ *
+ * The order is not checked. Single-pass ranges are buffered first, because
+ * the number of keys must be known before the tree is built.
+ *
+ * @tparam InputIt Input iterator over sorted keys.
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @param unique If true, runs of equivalent keys are collapsed to one key.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor
+ *
+ * @see buildSorted
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename InputIt>
+void RBTree<Key, Comparator, Allocator>::assignSorted(InputIt first,
+                                                      InputIt last,
+                                                      bool unique) {
+  using category = typename std::iterator_traits<InputIt>::iterator_category;
+  if constexpr (std::is_base_of<std::forward_iterator_tag, category>::value) {
+    size_type count = 0;
+    if (unique) {
+      sortedCount(first, last, unique, count); // считаем различные ключи
+    } else {
+      count = static_cast<size_type>(std::distance(first, last));
+    }
+    buildSorted(first, last, count, count, unique);
+  } else {
+    std::vector<Key> buffer(first, last);
+    assignSorted(buffer.begin(), buffer.end(), unique);
+  }
+}
+
+/**
+ * @brief Replaces the contents of the tree with count keys from a
+ * single-pass range that should be sorted, and checks their order.
+ *
+ * The keys are taken one by one straight into the nodes, without a buffer,
+ * and the tree is built in O(n) by buildSorted(); one in-order pass then
+ * checks that the keys really were sorted. Used to load snapshots, whose
+ * contents cannot be trusted.
+ *
+ * @tparam InputIt Input iterator over keys; exactly count keys are read.
+ * @param first Beginning of the range.
+ * @param count Number of keys.
+ * @param reserve Number of nodes to allocate up front; the rest are taken
+ * from the pool as the keys arrive, so a count that cannot be trusted does
+ * not decide the allocation alone.
+ * @param unique If true, equivalent neighbours are an error as well.
+ *
+ * @throws std::invalid_argument if the keys are out of order,
+ * std::bad_alloc, anything thrown by the key constructor or the iterator.
+ * The tree is left empty in all these cases.
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename InputIt>
+void RBTree<Key, Comparator, Allocator>::assignSortedN(InputIt first,
+                                                       size_type count,
+                                                       size_type reserve,
+                                                       bool unique) {
+  // last не нужен без unique
+  buildSorted(first, first, count, reserve, false);
+
+  if (size_ < 2) {
+    return;
+  }
+  const_iterator prev = cbegin();
+  for (const_iterator it = std::next(prev); it != cend(); ++it) {
+    if (unique ? !comparator_(*prev, *it) : comparator_(*it, *prev)) {
+      clear();
+      throw std::invalid_argument(
+          "s21::RBTree::assignSortedN: keys are not sorted");
+    }
+    prev = it;
+  }
+}
+
+/**
+ * @brief Checks that a forward range is sorted and counts the keys a tree
+ * built from it would hold.
+ *
+ * @param first Beginning of the range.
+ * @param last End of the range.
+ * @param unique If true, equivalent neighbours are counted once.
+ * @param count Receives the number of keys (valid only if true is returned).
+ *
+ * @return true if no key is less than its predecessor.
+ *
+ * @throws anything thrown by the comparator
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename ForwardIt>
+bool RBTree<Key, Comparator, Allocator>::sortedCount(ForwardIt first,
+                                                     ForwardIt last,
+                                                     bool unique,
+                                                     size_type &count) const {
+  count = 0;
+  if (first == last) {
+    return true;
+  }
+
+  ForwardIt next = first;
+  count = 1;
+  for (++next; next != last; ++first, ++next) {
+    if (comparator_(*next, *first)) {
+      return false; // порядок нарушен
+    }
+    if (!unique || comparator_(*first, *next)) {
+      ++count;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Builds a perfectly balanced Red-Black Tree from a sorted range in
+ * O(n).
+ *
+ * The keys are consumed in order by an in-order recursion, each subtree gets
+ * half of the remaining keys, so the depth is floor(log2(n)) and recursion
+ * uses O(log n) stack. All levels are black except the deepest one, which is
+ * red: every path to a leaf then has the same number of black nodes and no
+ * red node has a red child. All nodes come from one reserved slab.
+ *
+ * @param first Beginning of the sorted range.
+ * @param last End of the sorted range.
+ * @param count Number of keys to take (distinct keys if unique is set).
+ * @param reserve Number of nodes to allocate before the first key.
+ * @param unique If true, runs of equivalent keys are collapsed to one key.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor. The tree is
+ * left empty in that case.
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename ForwardIt>
+void RBTree<Key, Comparator, Allocator>::buildSorted(ForwardIt first,
+                                                     ForwardIt last,
+                                                     size_type count,
+                                                     size_type reserve,
+                                                     bool unique) {
+  clear();
+  if (count == 0) {
+    return;
+  }
+
+  pool_.reserve(reserve < count ? reserve : count); // одним слэбом
+
+  size_type height = 0; // floor(log2(count)) + 1
+  for (size_type n = count; n > 0; n >>= 1) {
+    ++height;
+  }
+
+  setRoot(buildSubtree(first, last, count, 0, height - 1, unique));
+  root()->setRed(false); // корень должен быть чёрный
+  updateExtremes();
+  size_ = count;
+}
+
+/**
+ * @brief Recursively builds a balanced subtree of count keys taken from it.
+ *
+ * @param it Current position in the sorted range, advanced past used keys.
+ * @param last End of the sorted range.
+ * @param count Number of keys in the subtree.
+ * @param depth Depth of the subtree root.
+ * @param red_depth Depth of the deepest level, its nodes are red.
+ * @param unique If true, runs of equivalent keys are collapsed to one key.
+ *
+ * @return Node* Root of the subtree (its parent is not set).
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor. Nodes
+ * created by this call are destroyed before the exception is rethrown.
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename ForwardIt>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::buildSubtree(ForwardIt &it,
+                                                 ForwardIt last,
+                                                 size_type count,
+                                                 size_type depth,
+                                                 size_type red_depth,
+                                                 bool unique) {
+  if (count == 0) {
+    return nullptr;
+  }
+
+  size_type left_count = (count - 1) / 2;
+  Node *left = buildSubtree(it, last, left_count, depth + 1, red_depth, unique);
+
+  Node *node = nullptr;
+  try {
+    node = createNode(*it);
+  } catch (...) {
+    deleteSubtree(left);
+    throw;
+  }
+  node->setRed(depth == red_depth);
+  node->size_ = count;
+  node->left_ = left;
+  if (left) {
+    left->setParent(node);
+  }
+
+  // ++it может бросить (чтение снимка): с этого места узел владеет левым
+  // поддеревом, и deleteSubtree(node) освобождает оба
+  try {
+    for (++it; unique && it != last && !comparator_(node->key_, *it); ++it) {
+      // пропускаем ключи, эквивалентные только что взятому
+    }
+    Node *right = buildSubtree(it, last, count - 1 - left_count, depth + 1,
+                               red_depth, unique);
+    node->right_ = right;
+    if (right) {
+      right->setParent(node);
+    }
+  } catch (...) {
+    deleteSubtree(node);
+    throw;
+  }
+  return node;
+}
+
+/******************************************************************************
+ * SET ALGEBRA
+ ******************************************************************************/
+
+/**
+ * @brief Returns the keys that are in this tree or in other.
+ *
+ * Works like std::set_union: a key present k times here and m times in
+ * other is taken max(k, m) times, equivalent keys are taken from this tree
+ * first. Both trees are walked once in order and the result is built from
+ * the sorted sequence in O(n + m).
+ *
+ * @param other The second operand, must use an equivalent comparator.
+ * @param threads Number of threads for the merge pass, 0 means automatic
+ * choice (see copyThreads()).
+ *
+ * @return RBTree A new tree with the allocator of this tree.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor or the
+ * comparator
+ *
+ * @see setOperation
+ */
+template <typename Key, typename Comparator, typename Allocator>
+RBTree<Key, Comparator, Allocator>
+RBTree<Key, Comparator, Allocator>::setUnion(const RBTree &other,
+                                             unsigned threads) const {
+  return setOperation(other, kOnlyThis | kOnlyOther | kInBoth, threads);
+}
+
+/**
+ * @brief Returns the keys that are both in this tree and in other.
+ *
+ * A key present k times here and m times in other is taken min(k, m)
+ * times, from this tree. O(n + m).
+ *
+ * @param other The second operand, must use an equivalent comparator.
+ * @param threads Number of threads for the merge pass, 0 means automatic.
+ *
+ * @return RBTree A new tree with the allocator of this tree.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor or the
+ * comparator
+ */
+template <typename Key, typename Comparator, typename Allocator>
+RBTree<Key, Comparator, Allocator>
+RBTree<Key, Comparator, Allocator>::setIntersection(const RBTree &other,
+                                                    unsigned threads) const {
+  return setOperation(other, kInBoth, threads);
+}
+
+/**
+ * @brief Returns the keys of this tree that are not in other.
+ *
+ * A key present k times here and m times in other is taken max(k - m, 0)
+ * times. O(n + m).
+ *
+ * @param other The second operand, must use an equivalent comparator.
+ * @param threads Number of threads for the merge pass, 0 means automatic.
+ *
+ * @return RBTree A new tree with the allocator of this tree.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor or the
+ * comparator
+ */
+template <typename Key, typename Comparator, typename Allocator>
+RBTree<Key, Comparator, Allocator>
+RBTree<Key, Comparator, Allocator>::setDifference(const RBTree &other,
+                                                  unsigned threads) const {
+  return setOperation(other, kOnlyThis, threads);
+}
+
+/**
+ * @brief Returns the keys that are in exactly one of the two trees.
+ *
+ * A key present k times here and m times in other is taken |k - m| times.
+ * O(n + m).
+ *
+ * @param other The second operand, must use an equivalent comparator.
+ * @param threads Number of threads for the merge pass, 0 means automatic.
+ *
+ * @return RBTree A new tree with the allocator of this tree.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor or the
+ * comparator
+ */
+template <typename Key, typename Comparator, typename Allocator>
+RBTree<Key, Comparator, Allocator>
+RBTree<Key, Comparator, Allocator>::symmetricDifference(
+    const RBTree &other, unsigned threads) const {
+  return setOperation(other, kOnlyThis | kOnlyOther, threads);
+}
+
+/**
+ * @brief Merges both trees in order and builds a tree of the selected keys.
+ *
+ * The merge pass only collects pointers to the keys of the operands, so
+ * every key of the result is copied exactly once.
+ *
+ * With several threads the key range is cut at evenly spaced keys of the
+ * larger tree (found by select() in O(log n)). Each piece is bounded by
+ * lower_bound() of the same two keys in both trees, so equivalent keys
+ * never end up in different pieces, and the pieces are merged
+ * independently, several per thread. With the node pool every piece is then
+ * built into its own subtree by a worker and the subtrees are joined in
+ * order (see buildPieces()); without it the pieces are concatenated and the
+ * tree is built by buildSorted(), as the copy constructor does.
+ *
+ * @param other The second operand.
+ * @param parts Combination of SetPart flags.
+ * @param threads Requested number of threads, 0 means automatic choice.
+ *
+ * @return RBTree The result, balanced.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor or the
+ * comparator
+ */
+template <typename Key, typename Comparator, typename Allocator>
+RBTree<Key, Comparator, Allocator>
+RBTree<Key, Comparator, Allocator>::setOperation(const RBTree &other,
+                                                 unsigned parts,
+                                                 unsigned threads) const {
+  RBTree result(get_allocator());
+  result.comparator_ = comparator_;
+  std::vector<const Key *> keys;
+  unsigned workers = copyThreads(size_ + other.size_, threads);
+  if (workers <= 1) {
+    // верхняя оценка размера результата; пересечение не больше меньшего
+    size_type limit = (parts & kOnlyThis ? size_ : 0) +
+                      (parts & kOnlyOther ? other.size_ : 0);
+    if (limit == 0) {
+      limit = size_ < other.size_ ? size_ : other.size_;
+    }
+    keys.reserve(limit);
+    collectSetPart(begin(), end(), other.begin(), other.end(), parts, keys);
+  } else {
+    const RBTree &larger = size_ < other.size_ ? other : *this;
+    size_type tasks = size_type{workers} * 8;
+    // i-я граница куска в дереве tree
+    auto bound = [&larger, tasks](const RBTree &tree, size_type i) {
+      if (i == 0) {
+        return tree.begin();
+      }
+      if (i == tasks) {
+        return tree.end();
+      }
+      return tree.lower_bound(larger.select(i * larger.size_ / tasks));
+    };
+
+    std::vector<std::vector<const Key *>> pieces(tasks);
+    std::vector<std::exception_ptr> errors(tasks);
+    runParallel(tasks, workers, [&](size_type i) {
+      try {
+        collectSetPart(bound(*this, i), bound(*this, i + 1),
+                       bound(other, i), bound(other, i + 1), parts,
+                       pieces[i]);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+
+    size_type total = 0;
+    for (size_type i = 0; i < tasks; ++i) {
+      if (errors[i]) {
+        std::rethrow_exception(errors[i]);
+      }
+      total += pieces[i].size();
+    }
+    if constexpr (node_pool::kPooled) {
+      result.buildPieces(pieces, workers);
+      return result;
+    }
+    keys.reserve(total);
+    for (const auto &piece : pieces) {
+      keys.insert(keys.end(), piece.begin(), piece.end());
+    }
+  }
+
+  result.buildSorted(KeyRefIterator{keys.data()},
+                     KeyRefIterator{keys.data() + keys.size()}, keys.size(),
+                     keys.size(), false);
+  return result;
+}
+
+/**
+ * @brief Builds the empty tree from sorted pieces of keys in parallel.
+ *
+ * All nodes are taken from the pool as one block by the calling thread,
+ * every piece gets its own range of it, so the workers never touch the
+ * allocator (as in copyNodes()). A worker copies the keys of its piece into
+ * its range and links all but the first one into a balanced subtree by
+ * linkSorted(). The calling thread then appends the pieces in order, the
+ * first node of a piece being the middle node of joinWith(); every join
+ * costs O(1 + difference of the black heights).
+ *
+ * @param pieces Pointers to the keys; the pieces follow each other in
+ * order.
+ * @param threads Number of threads, at least 1.
+ *
+ * @throws std::bad_alloc, anything thrown by the key constructor. The tree
+ * is left empty in that case.
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::buildPieces(
+    const std::vector<std::vector<const Key *>> &pieces, unsigned threads) {
+  size_type total = 0;
+  for (const auto &piece : pieces) {
+    total += piece.size();
+  }
+  if (total == 0) {
+    return;
+  }
+
+  Node *slots = pool_.allocateBulk(total);
+  std::vector<Node *> first(pieces.size());
+  std::vector<Node *> subtrees(pieces.size(), nullptr);
+  std::vector<size_type> built(pieces.size(), 0);
+  std::vector<std::exception_ptr> errors(pieces.size());
+  for (size_type i = 0; i < pieces.size(); ++i) {
+    first[i] = slots;
+    slots += pieces[i].size();
+  }
+
+  runParallel(pieces.size(), threads, [&](size_type i) {
+    const auto &piece = pieces[i];
+    try {
+      for (; built[i] < piece.size(); ++built[i]) {
+        new (first[i] + built[i]) Node(*piece[built[i]]);
+      }
+    } catch (...) {
+      errors[i] = std::current_exception();
+      return;
+    }
+    if (piece.size() > 1) {
+      size_type count = piece.size() - 1;
+      size_type red_depth = 0; // floor(log2(count)) - нижний уровень
+      for (size_type n = count; n > 1; n >>= 1) {
+        ++red_depth;
+      }
+      subtrees[i] = linkSorted(first[i] + 1, count, 0, red_depth);
+    }
+  });
+
+  for (const auto &error : errors) {
+    if (error) {
+      // узлы ещё не связаны: разрушаем созданные ключи, память отдаст пул
+      for (size_type i = 0; i < pieces.size(); ++i) {
+        for (size_type j = 0; j < built[i]; ++j) {
+          first[i][j].~Node();
+        }
+      }
+      std::rethrow_exception(error);
+    }
+  }
+
+  size_type height = 0;
+  for (size_type i = 0; i < pieces.size(); ++i) {
+    if (!pieces[i].empty()) {
+      resetNode(first[i]);
+      joinWith(first[i], subtrees[i],
+               static_cast<size_type>(blackHeight(subtrees[i])), true,
+               height);
+    }
+  }
+  size_ = total;
+  updateExtremes();
+}
+
+/**
+ * @brief Links count constructed nodes lying in key order into a balanced
+ * subtree.
+ *
+ * The colors are set as by buildSubtree(): all levels are black except the
+ * deepest one.
+ *
+ * @param nodes The nodes in key order.
+ * @param count Number of nodes.
+ * @param depth Depth of the subtree root.
+ * @param red_depth Depth of the deepest level, its nodes are red.
+ *
+ * @return Node* Root of the subtree (its parent is not set), nullptr if
+ * count is 0.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::linkSorted(Node *nodes, size_type count,
+                                               size_type depth,
+                                               size_type red_depth) noexcept {
+  if (count == 0) {
+    return nullptr;
+  }
+  size_type left_count = (count - 1) / 2;
+  Node *node = nodes + left_count;
+  Node *left = linkSorted(nodes, left_count, depth + 1, red_depth);
+  Node *right =
+      linkSorted(node + 1, count - 1 - left_count, depth + 1, red_depth);
+  node->left_ = left;
+  node->right_ = right;
+  if (left) {
+    left->setParent(node);
+  }
+  if (right) {
+    right->setParent(node);
+  }
+  node->setRed(depth == red_depth);
+  node->size_ = count;
+  return node;
+}
+
+/**
+ * @brief Merges two sorted ranges and collects the keys of the selected
+ * parts.
+ *
+ * Equivalent keys of the two ranges are paired one to one, as in the
+ * standard set algorithms; a key without a pair belongs to its own range.
+ *
+ * @param first1 Beginning of the range of this tree.
+ * @param last1 End of the range of this tree.
+ * @param first2 Beginning of the range of other.
+ * @param last2 End of the range of other.
+ * @param parts Combination of SetPart flags.
+ * @param out Receives pointers to the selected keys, in order.
+ *
+ * @throws std::bad_alloc, anything thrown by the comparator
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::collectSetPart(
+    const_iterator first1, const_iterator last1, const_iterator first2,
+    const_iterator last2, unsigned parts,
+    std::vector<const Key *> &out) const {
+  while (first1 != last1 && first2 != last2) {
+    if (comparator_(*first1, *first2)) {
+      if (parts & kOnlyThis) {
+        out.push_back(&*first1);
+      }
+      ++first1;
+    } else if (comparator_(*first2, *first1)) {
+      if (parts & kOnlyOther) {
+        out.push_back(&*first2);
+      }
+      ++first2;
+    } else {
+      if (parts & kInBoth) {
+        out.push_back(&*first1);
+      }
+      ++first1;
+      ++first2;
+    }
+  }
+  // хвост одного из диапазонов пар не имеет
+  for (; (parts & kOnlyThis) && first1 != last1; ++first1) {
+    out.push_back(&*first1);
+  }
+  for (; (parts & kOnlyOther) && first2 != last2; ++first2) {
+    out.push_back(&*first2);
+  }
+}
+
+/******************************************************************************
+ * SPLIT & JOIN
+ ******************************************************************************/
+
+/**
+ * @brief Moves all keys not less than key into a new tree, O(log n).
+ *
+ * The tree is cut before the first key not less than key by splitAt(). No
+ * node is allocated or copied.
+ *
+ * With the node pool enabled the nodes of both trees stay in the same
+ * slabs, which become shared by the two pools (see RBTNodePool::share()).
+ *
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param key The split key; equivalent keys go to the returned tree.
+ *
+ * @return RBTree Tree with the keys not less than key, with the allocator
+ * and the comparator of this tree. This tree keeps the smaller keys.
+ *
+ * @throws std::bad_alloc (node pool only), nothing is changed then
+ *
+ * @see splitAt
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K>
+RBTree<Key, Comparator, Allocator>
+RBTree<Key, Comparator, Allocator>::split(const K &key) {
+  RBTree right(get_allocator());
+  right.comparator_ = comparator_;
+  if (empty()) {
+    return right;
+  }
+  pool_.share(right.pool_);
+  splitAt(countLess(key, false), right);
+  return right;
+}
+
+/**
+ * @brief Moves the nodes from position index on into the empty tree right,
+ * O(log n).
+ *
+ * The path from the root to the position is walked once, guided by the
+ * subtree sizes, and taken apart from the bottom up: every node on it,
+ * together with its subtree on the far side, is joined to the left or to
+ * the right result by joinWith(). The cost of a join is the difference of
+ * the black heights, and these differences add up to O(log n) along the
+ * path. Nodes are only relinked, the pools are not touched.
+ *
+ * @param index Position of the first node to move, at most size().
+ * @param right Empty tree that receives the nodes.
+ *
+ * @throws N/A
+ *
+ * @see joinWith
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::splitAt(size_type index,
+                                                 RBTree &right) noexcept {
+  // высота красно-чёрного дерева не больше 2 * log2(n + 1)
+  constexpr size_type kMaxDepth = 2 * std::numeric_limits<size_type>::digits;
+  Node *path[kMaxDepth];
+  size_type heights[kMaxDepth]; // чёрные высоты узлов пути
+  bool to_right[kMaxDepth];     // узел раньше index - уходит в левую часть
+  size_type depth = 0;
+  size_type before = 0; // узлов левее текущего поддерева
+  size_type height = static_cast<size_type>(blackHeight(root()));
+  for (Node *node = root(); node != nullptr; ++depth) {
+    size_type position = before + subtreeSize(node->left_);
+    path[depth] = node;
+    heights[depth] = height;
+    to_right[depth] = position < index;
+    if (to_right[depth]) {
+      before = position + 1;
+    }
+    if (!node->isRed()) {
+      --height;
+    }
+    node = static_cast<Node *>(to_right[depth] ? node->right_ : node->left_);
+  }
+
+  resetHeader();
+  size_type left_height = 0;
+  size_type right_height = 0;
+  while (depth > 0) {
+    --depth;
+    Node *node = path[depth];
+    size_type child_height = heights[depth] - (node->isRed() ? 0 : 1);
+    if (to_right[depth]) {
+      // узел и его левое поддерево раньше всех узлов левой части
+      joinWith(node, static_cast<Node *>(node->left_), child_height, false,
+               left_height);
     } else {
-      flag = true; // ключ найден, прекращаем цикл.
-      break;
+      // узел и его правое поддерево позже всех узлов правой части
+      right.joinWith(node, static_cast<Node *>(node->right_), child_height,
+                     true, right_height);
     }
   }
 
-  return flag ? current : nullptr;
+  size_ = subtreeSize(root());
+  right.size_ = subtreeSize(right.root());
+  updateExtremes();
+  right.updateExtremes();
 }
 
 /**
- * @brief Finds the node with the minimum key in the subtree rooted at the
- * specified node.
+ * @brief Appends or prepends all keys of other, O(log n).
  *
- * @param node The root of the subtree.
+ * The key ranges of the trees must not overlap: either every key of other
+ * is not less than every key of this tree, or the other way round. other is
+ * left empty.
  *
- * @return Node* The node with the minimum key in the subtree.
+ * @param other The tree to take the keys from.
  *
- * @throws N/A
+ * @throws std::invalid_argument if the key ranges overlap, std::bad_alloc
+ *
+ * @see joinTrees
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::Node *RBTree<Key, Comparator>::findMinNode(
-    Node *node) const { // метод находит узел с минимальным значением ключа
-                        // в заданном поддереве
-  while (node->left_ != nullptr) {
-    node = reinterpret_cast<Node *>(node->left_);
-  }
-  return node;
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::join(RBTree &other) {
+  joinTrees(other, false);
 }
 
 /**
- * @brief Finds the node with the maximum key in the subtree rooted at the
- * specified node.
+ * @brief Appends or prepends all keys of other, which must all be greater
+ * (or all less) than the keys of this tree, O(log n).
  *
- * @param node The root of the subtree.
+ * @param other The tree to take the keys from, left empty.
  *
- * @return Node* The node with the maximum key in the subtree.
+ * @throws std::invalid_argument if the key ranges overlap or touch,
+ * std::bad_alloc
  *
- * @throws N/A
+ * @see joinTrees
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::Node *RBTree<Key, Comparator>::findMaxNode(
-    Node *node) const { // метод находит узел с максимальным значением ключа
-                        // в заданном поддереве
-  while (node->right_ != nullptr) {
-    node = reinterpret_cast<Node *>(node->right_);
-  }
-  return node;
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::joinUnique(RBTree &other) {
+  joinTrees(other, true);
 }
 
 /**
- * @brief Copies the subtree rooted at the specified node.
+ * @brief Joins other to this tree on the side its keys belong to.
  *
- * @param node The root of the subtree to copy.
- * @param fake_node The fake node to use as the parent of the copied subtree.
+ * The node of other next to this tree (its minimum when appending, its
+ * maximum when prepending) is unlinked and becomes the middle node of
+ * joinWith(). With equal allocators other's slabs are taken over and no
+ * node is allocated; otherwise the keys are moved into new nodes one by one
+ * with a hint (O(m log n)).
  *
- * @return Node* The root of the copied subtree.
+ * @param other The tree to take the keys from, left empty.
+ * @param unique If true, the ranges must not even share an equivalent key.
+ *
+ * @throws std::invalid_argument if the key ranges overlap, nothing is
+ * changed then; std::bad_alloc
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::joinTrees(RBTree &other,
+                                                   bool unique) {
+  if (this == &other || other.empty()) {
+    return;
+  }
+  bool append = true;
+  if (!empty()) {
+    const Key &min = static_cast<Node *>(header_.left_)->key_;
+    const Key &max = static_cast<Node *>(header_.right_)->key_;
+    const Key &other_min = static_cast<Node *>(other.header_.left_)->key_;
+    const Key &other_max = static_cast<Node *>(other.header_.right_)->key_;
+    append = !comparator_(other_min, max) &&
+             (!unique || comparator_(max, other_min));
+    bool prepend = !comparator_(min, other_max) &&
+                   (!unique || comparator_(other_max, min));
+    if (!append && !prepend) {
+      throw std::invalid_argument("s21::RBTree::join: key ranges overlap");
+    }
+  }
+
+  if (!pool_.canSplice(other.pool_)) {
+    // узлы чужого аллокатора не переносим - перемещаем ключи в новые узлы
+    const_iterator pos = append ? end() : begin();
+    for (auto &key : other) {
+      insert(pos, std::move(key));
+    }
+    other.clear();
+    return;
+  }
+
+  pool_.splice(other.pool_);
+  // крайний узел other со стороны этого дерева связывает два дерева
+  Node *mid = static_cast<Node *>(append ? other.header_.left_
+                                         : other.header_.right_);
+  other.unlinkNode(mid);
+  resetNode(mid);
+  size_type added = other.size_ + 1;
+  Node *subtree = other.root();
+  size_type subtree_height = static_cast<size_type>(blackHeight(subtree));
+  other.resetHeader();
+  other.size_ = 0;
+
+  size_type height = static_cast<size_type>(blackHeight(root()));
+  joinWith(mid, subtree, subtree_height, append, height);
+  size_ += added;
+  updateExtremes();
+}
+
+/**
+ * @brief Joins a detached subtree and a middle node to the tree, O(1 +
+ * difference of the black heights).
+ *
+ * All keys of subtree lie on one side of mid, and all keys of the tree on
+ * the other. The taller of the two trees stays on top: its edge facing the
+ * other one is descended to the first black node with the black height of
+ * the lower tree. mid replaces that node as a red node with the node and
+ * the lower tree as children, and the usual insertion fix-up restores the
+ * Red-Black properties along the walked edge.
+ *
+ * The element count and the cached extreme nodes are not updated, the
+ * caller does it once at the end.
+ *
+ * @param mid Unlinked node between the tree and subtree.
+ * @param subtree Root of a valid Red-Black subtree (it may be red), or
+ * nullptr.
+ * @param subtree_height Black height of subtree.
+ * @param to_right True if the keys of subtree are greater than mid.
+ * @param height Black height of the tree, updated.
  *
  * @throws N/A
+ *
+ * @see split
+ * @see joinTrees
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::Node *
-RBTree<Key, Comparator>::CopyTree(Node *node, Node &fake_node) {
-  if (node == nullptr) {
-    return nullptr;
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::joinWith(Node *mid, Node *subtree,
+                                                  size_type subtree_height,
+                                                  bool to_right,
+                                                  size_type &height) noexcept {
+  if (subtree != nullptr && subtree->isRed()) {
+    subtree->setRed(false); // корень отдельного дерева чёрный
+    ++subtree_height;
+  }
+  if (height < subtree_height) {
+    // сверху остаётся более высокое дерево - меняем их ролями
+    Node *lower = root();
+    setRoot(subtree);
+    subtree = lower;
+    std::swap(height, subtree_height);
+    to_right = !to_right;
+  }
+
+  BaseNode *parent = &header_;
+  Node *node = root();
+  for (size_type h = height;
+       node != nullptr && (node->isRed() || h > subtree_height);) {
+    if (!node->isRed()) {
+      --h;
+    }
+    parent = node;
+    node = static_cast<Node *>(to_right ? node->right_ : node->left_);
+  }
+
+  size_type added = subtreeSize(subtree) + 1;
+  mid->setRed(true);
+  mid->left_ = to_right ? node : subtree;
+  mid->right_ = to_right ? subtree : node;
+  mid->size_ = subtreeSize(node) + added;
+  mid->setParent(parent);
+  if (node != nullptr) {
+    node->setParent(mid);
+  }
+  if (subtree != nullptr) {
+    subtree->setParent(mid);
+  }
+  if (parent == &header_) {
+    header_.setParent(mid);
+  } else if (to_right) {
+    parent->right_ = mid;
+  } else {
+    parent->left_ = mid;
+  }
+  for (BaseNode *up = parent; up != &header_; up = up->parent()) {
+    static_cast<Node *>(up)->size_ += added;
+  }
+
+  // как после вставки; перекрашивание, дошедшее до корня, растит высоту
+  while (mid != root() && mid->parent()->isRed()) {
+    if (redUncle(mid)) {
+      redUncleChangeColors(mid);
+      mid = static_cast<Node *>(mid->parent()->parent());
+    } else {
+      blackUncleFixup(mid);
+      break;
+    }
+  }
+  if (root()->isRed()) {
+    root()->setRed(false);
+    ++height;
   }
-  Node *new_node = new Node(node->key_);
-  new_node->left_ = CopyTree(reinterpret_cast<Node *>(node->left_), fake_node);
-  new_node->right_ =
-      CopyTree(reinterpret_cast<Node *>(node->right_), fake_node);
-  new_node->parent_ = &fake_node;
-  new_node->red_ = node->red_;
-  return new_node;
 }
 
 /******************************************************************************
@@ -902,59 +4471,190 @@ RBTree<Key, Comparator>::CopyTree(Node *node, Node &fake_node) {
  ******************************************************************************/
 
 /**
- * @brief Inserts a new node into the Red-Black Tree.
- *
- * This function inserts a new node into the Red-Black Tree iteratively,
- * avoiding recursion. It traverses the tree to find the appropriate
- * location for the new node and then inserts it.
+ * @brief Finds the place for a new key in the Red-Black Tree.
  *
- * @tparam Key The type of the keys in the tree.
- * @tparam Comparator The type of the comparator used to compare keys.
- * @param root The root node of the tree.
- * @param new_node The new node to be inserted.
- * @param unique A flag indicating whether the keys should be unique.
+ * The tree is descended iteratively from the root. A key equivalent to
+ * existing ones goes to the right of them, so equal keys keep insertion
+ * order. Nothing is modified, so the caller may still give up the insertion.
  *
- * @note This function assumes that the tree is not empty and that the
- *       root node is not null. If the tree is empty, the root node should
- *       be set to the new node outside of this function.
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param key The key to be inserted.
+ * @param unique If true, the search stops at a node with an equivalent key.
+ * @param parent Receives the parent of the new node, nullptr for an empty
+ * tree.
+ * @param to_left Receives true if the new node is the left child of parent.
  *
- * @warning This function does not handle the case where the tree is empty.
- *          The caller is responsible for setting the root node to the new
- *          node if the tree is empty.
+ * @return Node* The node with an equivalent key if unique is set and one
+ * exists, nullptr otherwise.
  *
- * @see RBTree
+ * @see linkNode
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::insertNode(Node *root, Node *new_node) {
-  Node *current = root;
-  Node *parent = nullptr;
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::findInsertPosition(const K &key,
+                                                       bool unique,
+                                                       Node *&parent,
+                                                       bool &to_left) const {
+  Node *current = root();
+  parent = nullptr;
+  to_left = false;
 
   while (current != nullptr) {
     parent = current;
-    if (comparator_(new_node->key_, current->key_)) {
+    if (comparator_(key, current->key_)) {
+      to_left = true;
       current = reinterpret_cast<Node *>(current->left_);
+    } else if (unique && !comparator_(current->key_, key)) {
+      return current; // равный ключ уже есть
     } else {
+      to_left = false;
       current = reinterpret_cast<Node *>(current->right_);
     }
   }
+  return nullptr;
+}
+
+/**
+ * @brief Finds the place for a new key next to hint.
+ *
+ * The key fits right before hint if it is not greater than the hint key and
+ * not less than the key of its predecessor (strictly, if unique is set). The
+ * predecessor and successor are reached through the header or the parent
+ * links, so with a correct hint the place is found with at most two
+ * comparisons. end() as a hint is the append case: only the maximum is
+ * compared. The position right after hint is tried as well; if neither fits,
+ * the search falls back to findInsertPosition().
+ *
+ * Between two neighbours exactly one of the links is free: either the left
+ * child of the later node or the right child of the earlier one.
+ *
+ * @tparam K Type of the key; any type the comparator accepts.
+ * @param hint Iterator to the element before which the key is expected.
+ * @param key The key to be inserted.
+ * @param unique If true, an existing equivalent key is returned.
+ * @param parent Receives the parent of the new node, nullptr for an empty
+ * tree.
+ * @param to_left Receives true if the new node is the left child of parent.
+ *
+ * @return Node* The node with an equivalent key if unique is set and one
+ * exists, nullptr otherwise.
+ *
+ * @see findInsertPosition
+ */
+template <typename Key, typename Comparator, typename Allocator>
+template <typename K>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::findHintPosition(const_iterator hint,
+                                                     const K &key, bool unique,
+                                                     Node *&parent,
+                                                     bool &to_left) const {
+  const BaseNode *pos = hint.getCurrentNode();
+  // ставит новый узел между соседями prev и next
+  auto between = [&parent, &to_left](const BaseNode *prev,
+                                     const BaseNode *next) {
+    to_left = prev->right_ != nullptr;
+    parent = const_cast<Node *>(
+        static_cast<const Node *>(to_left ? next : prev));
+  };
+  // "a раньше b": для unique строго меньше, иначе допускается равенство
+  auto before = [this, unique](const auto &a, const auto &b) {
+    return unique ? comparator_(a, b) : !comparator_(b, a);
+  };
+
+  if (pos == &header_) {
+    const Node *max = static_cast<const Node *>(header_.right_);
+    if (size_ > 0 && before(max->key_, key)) {
+      parent = const_cast<Node *>(max); // дописываем после максимума
+      to_left = false;
+      return nullptr;
+    }
+  } else {
+    const Node *node = static_cast<const Node *>(pos);
+    if (before(key, node->key_)) {
+      if (pos == header_.left_) {
+        parent = const_cast<Node *>(node); // новый минимум
+        to_left = true;
+        return nullptr;
+      }
+      const Node *prev = static_cast<const Node *>(prevNode(pos));
+      if (before(prev->key_, key)) {
+        between(prev, pos);
+        return nullptr;
+      }
+    } else if (unique && !comparator_(node->key_, key)) {
+      return const_cast<Node *>(node); // равный ключ уже есть
+    } else {
+      // ключ больше подсказки: пробуем место сразу после неё
+      const BaseNode *next = nextNode(pos);
+      if (next == &header_ ||
+          before(key, static_cast<const Node *>(next)->key_)) {
+        between(pos, next); // у максимума правая ссылка свободна
+        return nullptr;
+      }
+    }
+  }
+  return findInsertPosition(key, unique, parent, to_left);
+}
 
-  new_node->parent_ = parent;
+/**
+ * @brief Links a new node at the place found by findInsertPosition().
+ *
+ * Updates the subtree sizes on the path to the root, restores the Red-Black
+ * properties and the element count.
+ *
+ * @param new_node The new red node without links.
+ * @param parent The parent of the new node, nullptr for an empty tree.
+ * @param to_left True if the new node becomes the left child of parent.
+ *
+ * The cached leftmost and rightmost nodes are updated when the new node is
+ * linked below one of them on the outer side.
+ *
+ * @return iterator An iterator to the new node.
+ *
+ * @see findInsertPosition
+ * @see insertFixup
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::iterator
+RBTree<Key, Comparator, Allocator>::linkNode(Node *new_node, Node *parent,
+                                             bool to_left) {
   if (parent == nullptr) {
-    // Если дерево пустое, новый узел становится корнем
-    root = new_node;
-  } else if (comparator_(new_node->key_, parent->key_)) {
-    parent->left_ = new_node;
+    setRoot(new_node);
+    new_node->setRed(false); // корень должен быть чёрный
+    header_.left_ = new_node;
+    header_.right_ = new_node;
   } else {
-    parent->right_ = new_node;
+    new_node->setParent(parent);
+    if (to_left) {
+      parent->left_ = new_node;
+      if (parent == header_.left_) {
+        header_.left_ = new_node; // новый минимум
+      }
+    } else {
+      parent->right_ = new_node;
+      if (parent == header_.right_) {
+        header_.right_ = new_node; // новый максимум
+      }
+    }
+    // новый узел вошёл во все поддеревья на пути к корню
+    for (BaseNode *node = parent; node != &header_; node = node->parent()) {
+      ++static_cast<Node *>(node)->size_;
+    }
+    insertFixup(new_node);
   }
+
+  ++size_;
+  return makeIterator(new_node);
 }
 
 /**
  * @brief Fixes the Red-Black Tree after a node is inserted.
  *
  * This function handles the rebalancing of the Red-Black Tree after a new node
- * is inserted. It checks various conditions and calls the appropriate helper
- * functions to maintain the Red-Black Tree properties.
+ * is inserted. While the node and its parent are both red, a red uncle is
+ * resolved by recoloring and the check moves two levels up; a black uncle is
+ * resolved by at most two rotations, after which the tree is valid.
  *
  * @tparam Key The type of the keys in the tree.
  * @tparam Comparator The type of the comparator used to compare keys.
@@ -971,20 +4671,19 @@ void RBTree<Key, Comparator>::insertNode(Node *root, Node *new_node) {
  * @see redUncleChangeColors
  * @see blackUncleFixup
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::insertFixup(Node *node) {
-  if (node == root_)
-    return;
-  if (node->parent_ == root_)
-    return;
-  if (!node->parent_->red_)
-    return;
-
-  if (redUncle(node)) {
-    redUncleChangeColors(node);
-  } else {
-    blackUncleFixup(node);
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::insertFixup(Node *node) {
+  // пока есть две красные подряд, поднимаемся к деду
+  while (node != root() && node->parent()->isRed()) {
+    if (redUncle(node)) {
+      redUncleChangeColors(node);
+      node = reinterpret_cast<Node *>(node->parent()->parent());
+    } else {
+      blackUncleFixup(node);
+      break;
+    }
   }
+  root()->setRed(false);
 }
 
 /**
@@ -997,13 +4696,13 @@ void RBTree<Key, Comparator>::insertFixup(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::leftDadRightSon(
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::leftDadRightSon(
     Node *node) { // относительно деда папа слева, сын справа
-  return node != nullptr && node->parent_ != nullptr &&
-                 node->parent_->parent_ != nullptr
-             ? node->parent_->right_ == node &&
-                   node->parent_->parent_->left_ == node->parent_
+  return node != nullptr && node->parent() != &header_ &&
+                 node->parent()->parent() != &header_
+             ? node->parent()->right_ == node &&
+                   node->parent()->parent()->left_ == node->parent()
              : false;
 }
 
@@ -1017,13 +4716,13 @@ bool RBTree<Key, Comparator>::leftDadRightSon(
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::rightDadLeftSon(
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::rightDadLeftSon(
     Node *node) { // относительно деда папа справа, сын слева
-  return node != nullptr && node->parent_ != nullptr &&
-                 node->parent_->parent_ != nullptr
-             ? node->parent_->left_ == node &&
-                   node->parent_->parent_->right_ == node->parent_
+  return node != nullptr && node->parent() != &header_ &&
+                 node->parent()->parent() != &header_
+             ? node->parent()->left_ == node &&
+                   node->parent()->parent()->right_ == node->parent()
              : false;
 }
 
@@ -1037,13 +4736,13 @@ bool RBTree<Key, Comparator>::rightDadLeftSon(
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::leftDadLeftSon(
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::leftDadLeftSon(
     Node *node) { // относительно деда папа слева, сын слева
-  return node != nullptr && node->parent_ != nullptr &&
-                 node->parent_->parent_ != nullptr
-             ? node->parent_->left_ == node &&
-                   node->parent_->parent_->left_->left_ == node
+  return node != nullptr && node->parent() != &header_ &&
+                 node->parent()->parent() != &header_
+             ? node->parent()->left_ == node &&
+                   node->parent()->parent()->left_ == node->parent()
              : false;
 }
 
@@ -1057,13 +4756,13 @@ bool RBTree<Key, Comparator>::leftDadLeftSon(
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::rightDadRightSon(
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::rightDadRightSon(
     Node *node) { // относительно деда папа справа, сын справа
-  return node != nullptr && node->parent_ != nullptr &&
-                 node->parent_->parent_ != nullptr
-             ? node->parent_->right_ == node &&
-                   node->parent_->parent_->right_->right_ == node
+  return node != nullptr && node->parent() != &header_ &&
+                 node->parent()->parent() != &header_
+             ? node->parent()->right_ == node &&
+                   node->parent()->parent()->right_ == node->parent()
              : false;
 }
 
@@ -1076,73 +4775,14 @@ bool RBTree<Key, Comparator>::rightDadRightSon(
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::redUncle(
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::redUncle(
     Node *node) { // метод возвращает цвет дяди
-                  // (метод используется если node != root_)
-  if (node->parent_->parent_->right_ == nullptr ||
-      node->parent_->parent_->left_ == nullptr) {
-    return false;
-  }
-
-  // если существует дедушка, вызываем цвет узла дяди
-  return node->parent_->parent_->right_->right_ == node
-             ? node->parent_->parent_->left_->red_
-             : node->parent_->parent_->right_->red_;
-}
-
-/**
- * @brief Checks if both the node and its parent are red.
- *
- * @param node The node to check.
- *
- * @return bool True if both the node and its parent are red, false otherwise.
- *
- * @throws N/A
- */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::doubleRed(Node *node) {
-  return node->red_ && node->parent_->red_;
-}
-
-/**
- * @brief Fixes double red violations in the Red-Black Tree.
- *
- * This function iteratively traverses up the tree from the given node to the
- * root, checking for double red violations (two consecutive red nodes). If a
- * double red violation is found, it calls the `insertFixup` method to correct
- * the violation.
- *
- * @tparam Key The type of the keys in the tree.
- * @tparam Comparator The type of the comparator used to compare keys.
- * @param node The starting node from which to begin the traversal.
- *
- * @note This function uses an iterative approach to avoid recursion, which can
- * be more efficient in terms of stack usage, especially for deep trees.
- *
- * @warning This function assumes that the tree is not empty and that the
- *          root node is not null. The caller is responsible for ensuring that
- *          the tree is not empty.
- *
- * @see RBTree
- * @see insertFixup
- */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::doubleRedFixup(Node *node) {
-  // Итерируемся вверх к родителю, к деду, к прадеду до nullptr,
-  // если встречаем две красные подряд,
-  // тогда относительно первой красной вызываем insertFixup
-
-  Node *current = node;
-  while (current && current->parent_) {
-    // Проверяем наличие двух красных узлов подряд
-    if (doubleRed(current)) {
-      // Вызываем insertFixup для исправления ситуации
-      insertFixup(current);
-    }
-    // Переходим к родительскому узлу
-    current = reinterpret_cast<Node *>(current->parent_);
-  }
+                  // (метод используется если node != root())
+  BaseNode *grandparent = node->parent()->parent();
+  BaseNode *uncle = grandparent->left_ == node->parent() ? grandparent->right_
+                                                        : grandparent->left_;
+  return uncle != nullptr && uncle->isRed();
 }
 
 /**
@@ -1150,9 +4790,8 @@ void RBTree<Key, Comparator>::doubleRedFixup(Node *node) {
  * Red-Black Tree.
  *
  * This function adjusts the colors of the parent, grandparent, and uncle nodes
- * when the uncle node is red during the insertion of a new node. It also
- * handles the case where the grandparent is the root node. If the grandparent
- * is not the root, it calls `doubleRedFixup` to fix any double red violations.
+ * when the uncle node is red during the insertion of a new node. The
+ * grandparent becomes red, so insertFixup continues from it.
  *
  * @tparam Key The type of the keys in the tree.
  * @tparam Comparator The type of the comparator used to compare keys.
@@ -1166,10 +4805,10 @@ void RBTree<Key, Comparator>::doubleRedFixup(Node *node) {
  *          The caller is responsible for ensuring that the tree is not empty.
  *
  * @see RBTree
- * @see doubleRedFixup
+ * @see insertFixup
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::redUncleChangeColors(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::redUncleChangeColors(Node *node) {
   /* * * * * * * * * * * * * * * * * *
    *     (B)G              (R)G      *
    *       / \               / \     *
@@ -1178,23 +4817,16 @@ void RBTree<Key, Comparator>::redUncleChangeColors(Node *node) {
    * (R)L              (R)L          *
    * * * * * * * * * * * * * * * * * */
 
-  node->parent_->red_ = false;
-  node->parent_->parent_->red_ = true;
+  node->parent()->setRed(false);
+  node->parent()->parent()->setRed(true);
 
   // если дядя слева - перекрашиваем его в чёрный
   if (rightDadRightSon(node) || rightDadLeftSon(node)) {
-    node->parent_->parent_->left_->red_ = false;
+    node->parent()->parent()->left_->setRed(false);
   }
   // если дядя справа - перекрашиваем его в чёрный
   if (leftDadLeftSon(node) || leftDadRightSon(node)) {
-    node->parent_->parent_->right_->red_ = false;
-  }
-
-  // если дедушка является корнем, перекрашиваем его в чёрный
-  if (root_ == node->parent_->parent_) {
-    node->parent_->parent_->red_ = false;
-  } else {
-    doubleRedFixup(node);
+    node->parent()->parent()->right_->setRed(false);
   }
 }
 
@@ -1221,16 +4853,16 @@ void RBTree<Key, Comparator>::redUncleChangeColors(Node *node) {
  * @see oppositeDadAndGrandpa
  * @see sameSideDadAndGrandpa
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::blackUncleFixup(Node *node) {
-  Node *parent = reinterpret_cast<Node *>(node->parent_);
-  Node *grandparent = reinterpret_cast<Node *>(node->parent_->parent_);
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::blackUncleFixup(Node *node) {
+  Node *parent = reinterpret_cast<Node *>(node->parent());
+  Node *grandparent = reinterpret_cast<Node *>(node->parent()->parent());
 
   oppositeDadAndGrandpa(node, parent, grandparent);
 
   sameSideDadAndGrandpa(node, parent, grandparent);
 
-  root_->red_ = false;
+  root()->setRed(false);
 }
 
 /**
@@ -1241,31 +4873,35 @@ void RBTree<Key, Comparator>::blackUncleFixup(Node *node) {
  * @throws N/A
  */
 
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::leftRotate(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::leftRotate(Node *node) {
   Node *rightSun = reinterpret_cast<Node *>(node->right_);
 
   // устанавливаем правого ребенка parent на левого ребенка rightSun
   node->right_ = rightSun->left_;
   if (rightSun->left_) {
     // устанавливаем родителя левого ребенка rightSun на parent.
-    rightSun->left_->parent_ = node;
+    rightSun->left_->setParent(node);
   }
   // устанавливаем родителя rightSun на дедушку (родителя parent)
-  rightSun->parent_ = node->parent_;
+  rightSun->setParent(node->parent());
 
-  if (node->parent_ == nullptr) {
-    root_ = rightSun;
-  } else if (node == node->parent_->left_) {
-    node->parent_->left_ = rightSun;
+  if (node->parent() == &header_) {
+    header_.setParent(rightSun);
+  } else if (node == node->parent()->left_) {
+    node->parent()->left_ = rightSun;
   } else {
-    node->parent_->right_ = rightSun;
+    node->parent()->right_ = rightSun;
   }
 
   // устанавливаем левого ребенка rightSun на parent
   rightSun->left_ = node;
   // устанавливаем родителя parent на rightSun
-  node->parent_ = rightSun;
+  node->setParent(rightSun);
+
+  // rightSun занимает место node вместе со всем его поддеревом
+  rightSun->size_ = node->size_;
+  updateSize(node);
 }
 
 /**
@@ -1275,27 +4911,31 @@ void RBTree<Key, Comparator>::leftRotate(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::rightRotate(Node *node) { // аналогично leftRotate
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::rightRotate(
+    Node *node) { // аналогично leftRotate
   Node *leftSun = reinterpret_cast<Node *>(node->left_);
 
   node->left_ = leftSun->right_;
   if (leftSun->right_) {
-    leftSun->right_->parent_ = node;
+    leftSun->right_->setParent(node);
   }
 
-  leftSun->parent_ = node->parent_;
+  leftSun->setParent(node->parent());
 
-  if (node->parent_ == nullptr) {
-    root_ = leftSun;
-  } else if (node == node->parent_->right_) {
-    node->parent_->right_ = leftSun;
+  if (node->parent() == &header_) {
+    header_.setParent(leftSun);
+  } else if (node == node->parent()->right_) {
+    node->parent()->right_ = leftSun;
   } else {
-    node->parent_->left_ = leftSun;
+    node->parent()->left_ = leftSun;
   }
 
   leftSun->right_ = node;
-  node->parent_ = leftSun;
+  node->setParent(leftSun);
+
+  leftSun->size_ = node->size_;
+  updateSize(node);
 }
 
 /**
@@ -1324,8 +4964,8 @@ void RBTree<Key, Comparator>::rightRotate(Node *node) { // аналогично
  * @see leftRotate
  * @see rightRotate
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::oppositeDadAndGrandpa(
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::oppositeDadAndGrandpa(
     Node *&node, Node *&parent,
     Node *&grandparent) { // папа и дед в разных сторонах
   /* * * * * * * * * * * * * * * *
@@ -1339,8 +4979,8 @@ void RBTree<Key, Comparator>::oppositeDadAndGrandpa(
   if (leftDadRightSon(node)) {
     node = parent;
     leftRotate(node);
-    parent = reinterpret_cast<Node *>(node->parent_);
-    grandparent = reinterpret_cast<Node *>(node->parent_->parent_);
+    parent = reinterpret_cast<Node *>(node->parent());
+    grandparent = reinterpret_cast<Node *>(node->parent()->parent());
   }
 
   /* * * * * * * * * * * * * * * *
@@ -1354,8 +4994,8 @@ void RBTree<Key, Comparator>::oppositeDadAndGrandpa(
   if (rightDadLeftSon(node)) {
     node = parent;
     rightRotate(node);
-    parent = reinterpret_cast<Node *>(node->parent_);
-    grandparent = reinterpret_cast<Node *>(node->parent_->parent_);
+    parent = reinterpret_cast<Node *>(node->parent());
+    grandparent = reinterpret_cast<Node *>(node->parent()->parent());
   }
 }
 
@@ -1384,8 +5024,8 @@ void RBTree<Key, Comparator>::oppositeDadAndGrandpa(
  * @see rightRotate
  * @see leftRotate
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::sameSideDadAndGrandpa(
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::sameSideDadAndGrandpa(
     Node *&node, Node *&parent,
     Node *&grandparent) { // папа и дед в одной стороне
   /* * * * * * * * * * * * * * * * * * *
@@ -1397,8 +5037,8 @@ void RBTree<Key, Comparator>::sameSideDadAndGrandpa(
    * * * * * * * * * * * * * * * * * * */
 
   if (leftDadLeftSon(node)) {
-    parent->red_ = false;
-    grandparent->red_ = true;
+    parent->setRed(false);
+    grandparent->setRed(true);
     rightRotate(grandparent);
   }
 
@@ -1411,8 +5051,8 @@ void RBTree<Key, Comparator>::sameSideDadAndGrandpa(
    * * * * * * * * * * * * * * * * * * */
 
   if (rightDadRightSon(node)) {
-    parent->red_ = false;
-    grandparent->red_ = true;
+    parent->setRed(false);
+    grandparent->setRed(true);
     leftRotate(grandparent);
   }
 }
@@ -1431,9 +5071,9 @@ void RBTree<Key, Comparator>::sameSideDadAndGrandpa(
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::Node *
-RBTree<Key, Comparator>::rNephewsRS(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::rNephewsRS(Node *node) {
   return reinterpret_cast<Node *>(node->right_->right_)
              ? reinterpret_cast<Node *>(node->right_->right_)
              : nullptr;
@@ -1449,9 +5089,9 @@ RBTree<Key, Comparator>::rNephewsRS(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::Node *
-RBTree<Key, Comparator>::lNephewsRS(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::lNephewsRS(Node *node) {
   return reinterpret_cast<Node *>(node->right_->left_)
              ? reinterpret_cast<Node *>(node->right_->left_)
              : nullptr;
@@ -1467,9 +5107,9 @@ RBTree<Key, Comparator>::lNephewsRS(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::Node *
-RBTree<Key, Comparator>::rNephewsLS(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::rNephewsLS(Node *node) {
   return reinterpret_cast<Node *>(node->left_->right_)
              ? reinterpret_cast<Node *>(node->left_->right_)
              : nullptr;
@@ -1485,9 +5125,9 @@ RBTree<Key, Comparator>::rNephewsLS(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::Node *
-RBTree<Key, Comparator>::lNephewsLS(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::lNephewsLS(Node *node) {
   return reinterpret_cast<Node *>(node->left_->left_)
              ? reinterpret_cast<Node *>(node->left_->left_)
              : nullptr;
@@ -1503,9 +5143,9 @@ RBTree<Key, Comparator>::lNephewsLS(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::Node *
-RBTree<Key, Comparator>::rSibling(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::rSibling(Node *node) {
   return reinterpret_cast<Node *>(node->right_)
              ? reinterpret_cast<Node *>(node->right_)
              : nullptr;
@@ -1521,9 +5161,9 @@ RBTree<Key, Comparator>::rSibling(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTree<Key, Comparator>::Node *
-RBTree<Key, Comparator>::lSibling(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTree<Key, Comparator, Allocator>::Node *
+RBTree<Key, Comparator, Allocator>::lSibling(Node *node) {
   return reinterpret_cast<Node *>(node->left_)
              ? reinterpret_cast<Node *>(node->left_)
              : nullptr;
@@ -1533,8 +5173,8 @@ RBTree<Key, Comparator>::lSibling(Node *node) {
  * @brief Handles the case where the sibling node is red in the Red-Black Tree.
  *
  * This function adjusts the colors of the parent and sibling nodes when the
- * sibling node is red. It then performs a left rotation on the parent node and
- * calls the `eraseFixup` method to continue the rebalancing process.
+ * sibling node is red and performs a left rotation on the parent node. The new
+ * sibling is black, so `eraseFixup` continues with one of the other cases.
  *
  * @tparam Key The type of the keys in the tree.
  * @tparam Comparator The type of the comparator used to compare keys.
@@ -1551,8 +5191,8 @@ RBTree<Key, Comparator>::lSibling(Node *node) {
  * @see leftRotate
  * @see eraseFixup
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::redSibling(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::redSibling(Node *node) {
   // красный брат (case_4a)
   /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
    *    (b)P                    (b)S       *  (P)Parent, (S)sibling,   *
@@ -1562,9 +5202,8 @@ void RBTree<Key, Comparator>::redSibling(Node *node) {
    *    (b)L   R(b)           (x)  L(b)    *  (b)(r) - цвета           *
    * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
-  std::swap(rSibling(node)->red_, node->red_);
+  BaseNode::swapColors(rSibling(node), node);
   leftRotate(node);
-  eraseFixup(node);
 }
 
 /**
@@ -1575,12 +5214,11 @@ void RBTree<Key, Comparator>::redSibling(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::mirrorRedSibling(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::mirrorRedSibling(Node *node) {
   // (case_4b)
-  std::swap(lSibling(node)->red_, node->red_);
+  BaseNode::swapColors(lSibling(node), node);
   rightRotate(node);
-  eraseFixup(node);
 }
 
 /**
@@ -1605,8 +5243,8 @@ void RBTree<Key, Comparator>::mirrorRedSibling(Node *node) {
  * @see RBTree
  * @see leftRotate
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::rNephewsRedLNephewsAny(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::rNephewsRedLNephewsAny(Node *node) {
   // входящая node == Parent (case_3a)
   // правый племянник красный (левый - любой)
   /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -1617,9 +5255,9 @@ void RBTree<Key, Comparator>::rNephewsRedLNephewsAny(Node *node) {
    *  (any)L   R(r)           (x)  L(any)  *  (b)(r) - цвета           *
    * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
-  rSibling(node)->red_ = node->red_;
-  rNephewsRS(node)->red_ = false;
-  node->red_ = false;
+  rSibling(node)->setRed(node->isRed());
+  rNephewsRS(node)->setRed(false);
+  node->setRed(false);
   leftRotate(node);
 }
 
@@ -1631,29 +5269,27 @@ void RBTree<Key, Comparator>::rNephewsRedLNephewsAny(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::mirrorRNephewsRedLNephewsAny(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::mirrorRNephewsRedLNephewsAny(
+    Node *node) {
   // (case_3b)
-  lSibling(node)->red_ = node->red_;
-  lNephewsLS(node)->red_ = false;
-  node->red_ = false;
+  lSibling(node)->setRed(node->isRed());
+  lNephewsLS(node)->setRed(false);
+  node->setRed(false);
   rightRotate(node);
 }
 
 /**
  * @brief Handles the case where both nephews are black in the Red-Black Tree.
  *
- * This function adjusts the colors of the parent and sibling nodes when both
- * nephews are black. It then performs an iterative rebalancing starting from
- * the parent node if the deleted node and its parent were both black.
+ * This function repaints the sibling red when both nephews are black. The
+ * black height of the whole parent subtree drops by one, so `eraseFixup`
+ * moves the deficiency to the parent (or simply repaints a red parent black).
  *
  * @tparam Key The type of the keys in the tree.
  * @tparam Comparator The type of the comparator used to compare keys.
  * @param node The node where the deletion occurred.
  *
- * @note This function uses an iterative approach to avoid recursion, which can
- * be more efficient in terms of stack usage, especially for deep trees.
- *
  * @warning This function assumes that the tree is not empty and that the
  *          root node is not null. The caller is responsible for ensuring that
  *          the tree is not empty.
@@ -1661,36 +5297,20 @@ void RBTree<Key, Comparator>::mirrorRNephewsRedLNephewsAny(Node *node) {
  * @see RBTree
  * @see eraseFixup
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::lNephewsBlackRNephewsBlack(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::lNephewsBlackRNephewsBlack(
+    Node *node) {
   // оба племянника черные (case_2a)
   /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-   *  (any)P                    (b)P         *  (P)Parent, (S)sibling,   *
+   *  (any)P                  (any)P         *  (P)Parent, (S)sibling,   *
    *      / \                     / \        *  (R)(L) - Nephews,        *
    *    (x)  S(b)      ==>      (x)  S(r)    *  (any) - любой цвет,      *
    *        / \                     / \      *  (x) - удалённый узел,    *
    *    (b)L   R(b)             (b)L   R(b)  *  (b)(r) - цвета           *
    * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
-  // цвет родителя
-  bool color = node->red_;
-
-  // родительскую в черный
-  node->red_ = false;
-
-  // брата в красный
-  rSibling(node)->red_ = true;
-
-  // если удалённая вершина была чёрной и её родитель также чёрный,
-  // начинается итеративная ребалансировка, начиная с родительского узла,
-  // как если бы он был изначально удалён (рекурсия медленнее)
-  if (!color && node->parent_) {
-    Node *parent = reinterpret_cast<Node *>(node->parent_);
-    while (parent) {
-      eraseFixup(parent);
-      parent = reinterpret_cast<Node *>(parent->parent_);
-    }
-  }
+  // брата в красный, недостаток чёрной высоты переходит к родителю
+  rSibling(node)->setRed(true);
 }
 
 /**
@@ -1701,17 +5321,11 @@ void RBTree<Key, Comparator>::lNephewsBlackRNephewsBlack(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::mirrorLNephewsBlackRNephewsBlack(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::mirrorLNephewsBlackRNephewsBlack(
+    Node *node) {
   // (case_2b)
-  bool color = node->red_;
-
-  node->red_ = false;
-  lSibling(node)->red_ = true;
-
-  if (!color && node->parent_) {
-    eraseFixup(reinterpret_cast<Node *>(node->parent_));
-  }
+  lSibling(node)->setRed(true);
 }
 
 /**
@@ -1720,8 +5334,8 @@ void RBTree<Key, Comparator>::mirrorLNephewsBlackRNephewsBlack(Node *node) {
  *
  * This function adjusts the colors of the left nephew and sibling nodes when
  * the left nephew is red and the right nephew is black. It then performs a
- * right rotation on the sibling node and continues the rebalancing process by
- * calling the appropriate case handling functions.
+ * right rotation on the sibling node, which turns the configuration into
+ * case_3a.
  *
  * @tparam Key The type of the keys in the tree.
  * @tparam Comparator The type of the comparator used to compare keys.
@@ -1739,8 +5353,8 @@ void RBTree<Key, Comparator>::mirrorLNephewsBlackRNephewsBlack(Node *node) {
  * @see rNephewsRedLNephewsAny
  * @see mirrorRNephewsRedLNephewsAny
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::lNephewsRedRNephewsBlack(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::lNephewsRedRNephewsBlack(Node *node) {
   // левый племянник красный, правый черный (case_1a)
   /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
    *  (any)P                  (any)P           *                           *
@@ -1752,16 +5366,10 @@ void RBTree<Key, Comparator>::lNephewsRedRNephewsBlack(Node *node) {
    *                                     R(b)  *                           *
    * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
-  std::swap(lNephewsRS(node)->red_, rSibling(node)->red_);
+  BaseNode::swapColors(lNephewsRS(node), rSibling(node));
   rightRotate(rSibling(node));
 
-  // продолжаем балансировку: брат чёрный, племянник красный.
-  // Переходим к шагу case_3.
-  if (rNRlNA(node)) {
-    rNephewsRedLNephewsAny(node);
-  } else {
-    mirrorRNephewsRedLNephewsAny(node);
-  }
+  // брат чёрный, правый племянник красный - дальше case_3a
 }
 
 /**
@@ -1772,17 +5380,12 @@ void RBTree<Key, Comparator>::lNephewsRedRNephewsBlack(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::mirrorLNephewsRedRNephewsBlack(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::mirrorLNephewsRedRNephewsBlack(
+    Node *node) {
   // зеркальный случай (case_1b)
-  std::swap(rNephewsLS(node)->red_, lSibling(node)->red_);
+  BaseNode::swapColors(rNephewsLS(node), lSibling(node));
   leftRotate(lSibling(node));
-
-  if (rNRlNA(node)) {
-    rNephewsRedLNephewsAny(node);
-  } else {
-    mirrorRNephewsRedLNephewsAny(node);
-  }
 }
 
 /**
@@ -1794,10 +5397,10 @@ void RBTree<Key, Comparator>::mirrorLNephewsRedRNephewsBlack(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::sR(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::sR(Node *node) {
   // redSibling (case_4a)
-  return node && rSibling(node) && rSibling(node)->red_;
+  return node && rSibling(node) && rSibling(node)->isRed();
 }
 
 /**
@@ -1809,10 +5412,10 @@ bool RBTree<Key, Comparator>::sR(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::mirrorSR(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::mirrorSR(Node *node) {
   // redSibling (case_4b)
-  return node && lSibling(node) && lSibling(node)->red_;
+  return node && lSibling(node) && lSibling(node)->isRed();
 }
 
 /**
@@ -1825,11 +5428,11 @@ bool RBTree<Key, Comparator>::mirrorSR(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::rNRlNA(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::rNRlNA(Node *node) {
   // rNephewsRedLNephewsAny (case_3a)
-  return node && rSibling(node) && !rSibling(node)->red_ && rNephewsRS(node) &&
-         rNephewsRS(node)->red_;
+  return node && rSibling(node) && !rSibling(node)->isRed() &&
+         rNephewsRS(node) && rNephewsRS(node)->isRed();
 }
 
 /**
@@ -1843,11 +5446,11 @@ bool RBTree<Key, Comparator>::rNRlNA(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::mirrorRNRlNA(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::mirrorRNRlNA(Node *node) {
   // rNephewsRedLNephewsAny (case_3b) зеркальный вариант
-  return node && lSibling(node) && !lSibling(node)->red_ && lNephewsLS(node) &&
-         lNephewsLS(node)->red_;
+  return node && lSibling(node) && !lSibling(node)->isRed() &&
+         lNephewsLS(node) && lNephewsLS(node)->isRed();
 }
 
 /**
@@ -1859,12 +5462,14 @@ bool RBTree<Key, Comparator>::mirrorRNRlNA(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::lNBrNB(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::lNBrNB(Node *node) {
   // lNephewsBlackRNephewsBlack (case_2a)
-  return node && rSibling(node) && !rSibling(node)->red_ &&
-         ((lNephewsRS(node) && !lNephewsRS(node)->red_) || !lNephewsRS(node)) &&
-         ((rNephewsRS(node) && !rNephewsRS(node)->red_) || !rNephewsRS(node));
+  return node && rSibling(node) && !rSibling(node)->isRed() &&
+         ((lNephewsRS(node) && !lNephewsRS(node)->isRed()) ||
+          !lNephewsRS(node)) &&
+         ((rNephewsRS(node) && !rNephewsRS(node)->isRed()) ||
+          !rNephewsRS(node));
 }
 
 /**
@@ -1876,12 +5481,14 @@ bool RBTree<Key, Comparator>::lNBrNB(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::mirrorLNBrNB(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::mirrorLNBrNB(Node *node) {
   // lNephewsBlackRNephewsBlack (case_2b)
-  return node && lSibling(node) && !lSibling(node)->red_ &&
-         ((lNephewsLS(node) && !lNephewsLS(node)->red_) || !lNephewsLS(node)) &&
-         ((rNephewsLS(node) && !rNephewsLS(node)->red_) || !rNephewsLS(node));
+  return node && lSibling(node) && !lSibling(node)->isRed() &&
+         ((lNephewsLS(node) && !lNephewsLS(node)->isRed()) ||
+          !lNephewsLS(node)) &&
+         ((rNephewsLS(node) && !rNephewsLS(node)->isRed()) ||
+          !rNephewsLS(node));
 }
 
 /**
@@ -1894,12 +5501,13 @@ bool RBTree<Key, Comparator>::mirrorLNBrNB(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::lNRrNB(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::lNRrNB(Node *node) {
   // lNephewsRedRNephewsBlack (case_1a)
-  return node && rSibling(node) && !rSibling(node)->red_ && lNephewsRS(node) &&
-         lNephewsRS(node)->red_ &&
-         (!rNephewsRS(node) || (rNephewsRS(node) && !rNephewsRS(node)->red_));
+  return node && rSibling(node) && !rSibling(node)->isRed() &&
+         lNephewsRS(node) && lNephewsRS(node)->isRed() &&
+         (!rNephewsRS(node) ||
+          (rNephewsRS(node) && !rNephewsRS(node)->isRed()));
 }
 
 /**
@@ -1913,31 +5521,27 @@ bool RBTree<Key, Comparator>::lNRrNB(Node *node) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-bool RBTree<Key, Comparator>::mirrorLNRrNB(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+bool RBTree<Key, Comparator, Allocator>::mirrorLNRrNB(Node *node) {
   // lNephewsRedRNephewsBlack (case_1b)
-  return node && lSibling(node) && !lSibling(node)->red_ && rNephewsLS(node) &&
-         rNephewsLS(node)->red_ &&
-         (!lNephewsLS(node) || (lNephewsLS(node) && !lNephewsLS(node)->red_));
+  return node && lSibling(node) && !lSibling(node)->isRed() &&
+         rNephewsLS(node) && rNephewsLS(node)->isRed() &&
+         (!lNephewsLS(node) ||
+          (lNephewsLS(node) && !lNephewsLS(node)->isRed()));
 }
 
 /**
  * @brief Fixes the Red-Black Tree after a node is deleted.
  *
- * This function handles various cases that can occur after a node is deleted
- * from the Red-Black Tree. It calls the appropriate case handling functions
- * based on the configuration of the sibling and nephew nodes.
+ * The subtree rooted at node lacks one black node compared to its sibling.
+ * The function walks up from node and calls the appropriate case handling
+ * function for the side on which the deficient subtree lies until the black
+ * height is restored.
  *
  * @tparam Key The type of the keys in the tree.
  * @tparam Comparator The type of the comparator used to compare keys.
- * @param node The node where the deletion occurred.
- *
- * @note This function assumes that the tree is not empty and that the
- *       root node is not null. The caller is responsible for ensuring that
- *       the tree is not empty.
- *
- * @warning This function does not handle the case where the tree is empty.
- *          The caller is responsible for ensuring that the tree is not empty.
+ * @param node The node that replaced the erased one (may be nullptr).
+ * @param parent The parent of node.
  *
  * @see RBTree
  * @see lNephewsRedRNephewsBlack
@@ -1949,92 +5553,44 @@ bool RBTree<Key, Comparator>::mirrorLNRrNB(Node *node) {
  * @see redSibling
  * @see mirrorRedSibling
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::eraseFixup(Node *node) {
-  if (lNRrNB(node)) {
-    lNephewsRedRNephewsBlack(node); // (case_1a)
-  } else if (mirrorLNRrNB(node)) {
-    mirrorLNephewsRedRNephewsBlack(node); // (case_1b)
-  } else if (lNBrNB(node)) {
-    lNephewsBlackRNephewsBlack(node); // (case_2a)
-  } else if (mirrorLNBrNB(node)) {
-    mirrorLNephewsBlackRNephewsBlack(node); // (case_2b)
-  } else if (rNRlNA(node)) {
-    rNephewsRedLNephewsAny(node); // (case_3a)
-  } else if (mirrorRNRlNA(node)) {
-    mirrorRNephewsRedLNephewsAny(node); // (case_3b)
-  } else if (sR(node)) {
-    redSibling(node); // (case_4a)
-  } else if (mirrorSR(node)) {
-    mirrorRedSibling(node); // (case_4b)
-  }
-}
-
-/**
- * @brief Swaps the contents of two nodes.
- *
- * @param node_1 The first node to swap.
- * @param node_2 The second node to swap.
- *
- * @throws N/A
- */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::swapNodes(Node *node_1,
-                                        Node *node_2) { // меняем местами узлы
-  // Если оба узла одинаковые, ничего не делаем
-  if (node_1 == node_2)
-    return;
-
-  // Обменяем родительские указатели
-  Node *tempParent = reinterpret_cast<Node *>(node_1->parent_);
-  node_1->parent_ = node_2->parent_;
-  node_2->parent_ = reinterpret_cast<Node *>(tempParent);
-
-  // Обновим ссылки у родителей
-  if (node_1->parent_) {
-    if (node_1->parent_->left_ == reinterpret_cast<Node *>(node_2)) {
-      node_1->parent_->left_ = reinterpret_cast<Node *>(node_1);
-    } else {
-      node_1->parent_->right_ = reinterpret_cast<Node *>(node_1);
-    }
-  }
-  if (node_2->parent_) {
-    if (node_2->parent_->left_ == reinterpret_cast<Node *>(node_1)) {
-      node_2->parent_->left_ = reinterpret_cast<Node *>(node_2);
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::eraseFixup(Node *node, Node *parent) {
+  while (node != root() && (node == nullptr || !node->isRed())) {
+    if (node == parent->left_) {
+      if (sR(parent)) {
+        redSibling(parent); // (case_4a)
+      }
+      if (lNBrNB(parent)) {
+        lNephewsBlackRNephewsBlack(parent); // (case_2a)
+        node = parent;
+        parent = reinterpret_cast<Node *>(node->parent());
+      } else {
+        if (lNRrNB(parent)) {
+          lNephewsRedRNephewsBlack(parent); // (case_1a)
+        }
+        rNephewsRedLNephewsAny(parent); // (case_3a)
+        node = root();
+      }
     } else {
-      node_2->parent_->right_ = reinterpret_cast<Node *>(node_2);
+      if (mirrorSR(parent)) {
+        mirrorRedSibling(parent); // (case_4b)
+      }
+      if (mirrorLNBrNB(parent)) {
+        mirrorLNephewsBlackRNephewsBlack(parent); // (case_2b)
+        node = parent;
+        parent = reinterpret_cast<Node *>(node->parent());
+      } else {
+        if (mirrorLNRrNB(parent)) {
+          mirrorLNephewsRedRNephewsBlack(parent); // (case_1b)
+        }
+        mirrorRNephewsRedLNephewsAny(parent); // (case_3b)
+        node = root();
+      }
     }
   }
 
-  // Обменяем указатели левого и правого ребенка
-  Node *tempLeft = reinterpret_cast<Node *>(node_1->left_);
-  node_1->left_ = node_2->left_;
-  node_2->left_ = tempLeft;
-
-  Node *tempRight = reinterpret_cast<Node *>(node_1->right_);
-  node_1->right_ = node_2->right_;
-  node_2->right_ = reinterpret_cast<Node *>(tempRight);
-
-  // Обновим родителей у детей
-  if (node_1->left_)
-    node_1->left_->parent_ = reinterpret_cast<Node *>(node_1);
-  if (node_1->right_)
-    node_1->right_->parent_ = reinterpret_cast<Node *>(node_1);
-  if (node_2->left_)
-    node_2->left_->parent_ = reinterpret_cast<Node *>(node_2);
-  if (node_2->right_)
-    node_2->right_->parent_ = reinterpret_cast<Node *>(node_2);
-
-  // Обменяем цвета узлов
-  bool tempColor = reinterpret_cast<Node *>(node_1->red_);
-  node_1->red_ = node_2->red_;
-  node_2->red_ = reinterpret_cast<Node *>(tempColor);
-
-  // Если один из узлов был корнем, нужно обновить указатель на корень
-  if (root_ == node_1) {
-    root_ = node_2;
-  } else if (root_ == node_2) {
-    root_ = node_1;
+  if (node) {
+    node->setRed(false);
   }
 }
 
@@ -2046,22 +5602,57 @@ void RBTree<Key, Comparator>::swapNodes(Node *node_1,
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::transplant(
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::transplant(
     Node *eraised_node, Node *successor) { // меняем местами родителей
   // если родитель удаляемого узла - корень, предок становится корнем
-  if (!eraised_node->parent_) {
-    root_ = successor;
+  if (eraised_node->parent() == &header_) {
+    header_.setParent(successor);
     // родитель удаляемого узла будет указывать на предка
-  } else if (eraised_node->parent_->right_ == eraised_node) {
-    eraised_node->parent_->right_ = successor;
+  } else if (eraised_node->parent()->right_ == eraised_node) {
+    eraised_node->parent()->right_ = successor;
   } else {
-    eraised_node->parent_->left_ = successor;
+    eraised_node->parent()->left_ = successor;
   }
   // предок будет указывать на родителя удаляемого узла
   if (successor) {
-    std::swap(eraised_node->parent_, successor->parent_);
+    successor->setParent(eraised_node->parent());
+  }
+}
+
+/**
+ * @brief Unlinks a node from the tree without destroying it.
+ *
+ * The cached extreme nodes are moved first, then the node is removed and
+ * the Red-Black properties are restored.
+ *
+ * @param node The node to unlink, must belong to this tree.
+ *
+ * @throws N/A
+ *
+ * @see eraseNode
+ * @see eraseFixup
+ */
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::unlinkNode(Node *node) noexcept {
+  // крайние узлы кэшированы в заголовке - сдвигаем их до удаления
+  if (node == header_.left_) {
+    header_.left_ = nextNode(node);
+  }
+  if (node == header_.right_) {
+    header_.right_ = prevNode(node);
+  }
+
+  Node *to_fix = nullptr;
+  Node *to_fix_parent = nullptr;
+  bool original_color = node->isRed();
+
+  eraseNode(node, to_fix, to_fix_parent, &original_color);
+
+  if (!original_color) {
+    eraseFixup(to_fix, to_fix_parent);
   }
+  --size_;
 }
 
 /**
@@ -2073,8 +5664,8 @@ void RBTree<Key, Comparator>::transplant(
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-char RBTree<Key, Comparator>::howManyChildren(Node *node) {
+template <typename Key, typename Comparator, typename Allocator>
+char RBTree<Key, Comparator, Allocator>::howManyChildren(Node *node) {
   char how_many_children = 0;
   if (node->right_ && node->left_) {
     how_many_children = two_children;
@@ -2091,14 +5682,17 @@ char RBTree<Key, Comparator>::howManyChildren(Node *node) {
  * @brief Handles the case where the node to be erased has no children.
  *
  * @param eraised_node The node to be erased.
- * @param to_fix The node to fix after erasing.
+ * @param to_fix The node to fix after erasing (always nullptr).
+ * @param to_fix_parent The parent of to_fix.
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::noChildren(Node *eraised_node, Node *&to_fix) {
-  to_fix = eraised_node->red_ ? nullptr
-                              : reinterpret_cast<Node *>(eraised_node->parent_);
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::noChildren(
+    Node *eraised_node, Node *&to_fix, Node *&to_fix_parent) {
+  to_fix = nullptr;
+  to_fix_parent = reinterpret_cast<Node *>(eraised_node->parent());
+  decrementSizes(eraised_node->parent());
   transplant(eraised_node, nullptr);
 }
 
@@ -2107,93 +5701,95 @@ void RBTree<Key, Comparator>::noChildren(Node *eraised_node, Node *&to_fix) {
  *
  * @param eraised_node The node to be erased.
  * @param to_fix The node to fix after erasing.
- * @param color The original color of the erased node.
+ * @param to_fix_parent The parent of to_fix.
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::oneChildren(Node *eraised_node, Node *&to_fix,
-                                          bool *color) {
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::oneChildren(
+    Node *eraised_node, Node *&to_fix, Node *&to_fix_parent) {
   // eraised_node - чёрный, а сын красный
-  // (другие варианты не возможны в сбалансированном дереве)
-  if (eraised_node->left_ == nullptr) {
-    to_fix = reinterpret_cast<Node *>(eraised_node->right_);
-    transplant(eraised_node, to_fix);
-  } else if (eraised_node->right_ == nullptr) {
-    to_fix = reinterpret_cast<Node *>(eraised_node->left_);
-    transplant(eraised_node, to_fix);
-  }
-
-  // меняем original_color_red на красный, т.к. балансировка не нужна
-  *color = to_fix->red_;
-
-  // меняем на чёрный
-  to_fix->red_ = eraised_node->red_;
+  // (другие варианты не возможны в сбалансированном дереве),
+  // сын займёт место удаляемого узла и будет перекрашен в eraseFixup
+  to_fix = reinterpret_cast<Node *>(eraised_node->left_ ? eraised_node->left_
+                                                        : eraised_node->right_);
+  to_fix_parent = reinterpret_cast<Node *>(eraised_node->parent());
+  decrementSizes(eraised_node->parent());
+  transplant(eraised_node, to_fix);
 }
 
 /**
  * @brief Handles the case where the node to be erased has two children.
  *
+ * The in-order successor is relinked into the place of the erased node and
+ * takes over its color, so iterators to the successor stay valid. The
+ * balancing problem moves to the former position of the successor.
+ *
  * @param eraised_node The node to be erased.
  * @param to_fix The node to fix after erasing.
- * @param color The original color of the erased node.
+ * @param to_fix_parent The parent of to_fix.
+ * @param color The original color of the successor.
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::twoChildren(Node *eraised_node, Node *&to_fix,
-                                          bool *color) {
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::twoChildren(
+    Node *eraised_node, Node *&to_fix, Node *&to_fix_parent, bool *color) {
   Node *successor = findMinNode(reinterpret_cast<Node *>(eraised_node->right_));
   to_fix = reinterpret_cast<Node *>(successor->right_);
-  // цвет удаляемого узла
-  *color = to_fix ? to_fix->red_ : successor->red_;
+  // фактически из дерева уходит цвет преемника
+  *color = successor->isRed();
+  // путь от места преемника до корня проходит через eraised_node
+  decrementSizes(successor->parent());
 
-  swapNodes(eraised_node, successor);
+  if (successor->parent() == eraised_node) {
+    to_fix_parent = successor;
+  } else {
+    to_fix_parent = reinterpret_cast<Node *>(successor->parent());
+    transplant(successor, to_fix);
+    successor->right_ = eraised_node->right_;
+    successor->right_->setParent(successor);
+  }
 
-  // eraised_node теперь на позиции successor
-  // либо 1 ребёнок, либо нет детей
-  eraseNode(eraised_node, to_fix, color);
+  transplant(eraised_node, successor);
+  successor->left_ = eraised_node->left_;
+  successor->left_->setParent(successor);
+  successor->setRed(eraised_node->isRed());
+  successor->size_ = eraised_node->size_;
 }
 
 /**
- * @brief Erases a node from the Red-Black Tree and fixes the tree properties.
+ * @brief Erases a node from the Red-Black Tree.
  *
- * This function handles the deletion of a node from the Red-Black Tree based on
- * the number of children the node has. It calls the appropriate helper
- * functions to handle the deletion and fix the tree properties.
+ * This function unlinks the node from the Red-Black Tree based on the number
+ * of children the node has and reports where the tree has to be rebalanced.
  *
  * @tparam Key The type of the keys in the tree.
  * @tparam Comparator The type of the comparator used to compare keys.
  * @param eraised_node The node to be erased.
  * @param to_fix A reference to a pointer to the node that needs to be fixed
  * after the deletion.
- * @param color A pointer to a boolean that indicates the color of the node to
- * be fixed.
- *
- * @note This function assumes that the tree is not empty and that the
- *       root node is not null. The caller is responsible for ensuring that
- *       the tree is not empty.
- *
- * @warning This function does not handle the case where the tree is empty.
- *          The caller is responsible for ensuring that the tree is not empty.
+ * @param to_fix_parent A reference to a pointer to the parent of to_fix.
+ * @param color A pointer to a boolean that holds the color of the node that
+ * actually left the tree.
  *
  * @see RBTree
  * @see noChildren
  * @see oneChildren
  * @see twoChildren
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::eraseNode(Node *eraised_node, Node *&to_fix,
-                                        bool *color) {
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::eraseNode(
+    Node *eraised_node, Node *&to_fix, Node *&to_fix_parent, bool *color) {
   switch (howManyChildren(eraised_node)) {
   case no_children:
-    noChildren(eraised_node, to_fix);
+    noChildren(eraised_node, to_fix, to_fix_parent);
     break;
   case one_child:
-    oneChildren(eraised_node, to_fix, color);
+    oneChildren(eraised_node, to_fix, to_fix_parent);
     break;
   case two_children:
-    twoChildren(eraised_node, to_fix, color);
+    twoChildren(eraised_node, to_fix, to_fix_parent, color);
     break;
   }
 }
@@ -2207,41 +5803,51 @@ void RBTree<Key, Comparator>::eraseNode(Node *eraised_node, Node *&to_fix,
 /**
  * @brief Increments the iterator to the next node in the RBTree.
  *
+ * The successor of the last node is the header, i.e. end().
+ *
  * @throws N/A
  */
-template <typename Key, typename Comparator, bool IsConst>
-void RBTreeBaseIterator<Key, Comparator, IsConst>::increment() {
-  if (current_->right_ != nullptr) {
-    current_ = tree_.getMinNode(reinterpret_cast<Node *>(current_->right_));
-  } else {
-    Node *parent = reinterpret_cast<Node *>(current_->parent_);
-    while (parent != nullptr && current_ == parent->right_) {
-      current_ = parent;
-      parent = reinterpret_cast<Node *>(parent->parent_);
-    }
-    current_ = parent;
-  }
+template <typename Key, typename Comparator, typename Allocator, bool IsConst>
+void RBTreeBaseIterator<Key, Comparator, Allocator,
+                        IsConst>::increment() noexcept {
+  current_ = Tree::nextNode(current_);
 }
 
 /**
  * @brief Decrements the iterator to the previous node in the RBTree.
  *
+ * Decrementing end() gives the last node in O(1): the header keeps it.
+ *
  * @throws N/A
  */
-template <typename Key, typename Comparator, bool IsConst>
-void RBTreeBaseIterator<Key, Comparator, IsConst>::decrement() {
-  if (current_ == nullptr) {
-    current_ = tree_.getMaxNode(const_cast<Node *>(tree_.getRoot()));
-  } else if (current_->left_ != nullptr) {
-    current_ = tree_.getMaxNode(reinterpret_cast<Node *>(current_->left_));
-  } else {
-    Node *parent = reinterpret_cast<Node *>(current_->parent_);
-    while (parent != nullptr && current_ == parent->left_) {
-      current_ = parent;
-      parent = reinterpret_cast<Node *>(parent->parent_);
-    }
-    current_ = parent;
+template <typename Key, typename Comparator, typename Allocator, bool IsConst>
+void RBTreeBaseIterator<Key, Comparator, Allocator,
+                        IsConst>::decrement() noexcept {
+  current_ = Tree::prevNode(current_);
+}
+
+/**
+ * @brief Moves the iterator n positions forward (or back if n < 0).
+ *
+ * The position of the current node is computed from the subtree sizes and
+ * the target node is found from the root, O(log n) for any n. The target
+ * position must lie within [0, size()], size() is the end position.
+ *
+ * @param n Number of positions to move.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator, bool IsConst>
+void RBTreeBaseIterator<Key, Comparator, Allocator, IsConst>::jump(
+    difference_type n) noexcept {
+  auto index = static_cast<difference_type>(Tree::getNodeIndex(current_));
+  BaseNode *header = current_;
+  while (!Tree::isHeader(header)) { // корень лежит под заголовком
+    header = header->parent();
   }
+  BaseNode *target =
+      Tree::getNthNode(header->parent(), static_cast<std::size_t>(index + n));
+  current_ = target != nullptr ? target : header;
 }
 
 /**
@@ -2251,9 +5857,9 @@ void RBTreeBaseIterator<Key, Comparator, IsConst>::decrement() {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator, bool IsConst>
-typename RBTreeBaseIterator<Key, Comparator, IsConst>::reference
-RBTreeBaseIterator<Key, Comparator, IsConst>::operator*() const {
+template <typename Key, typename Comparator, typename Allocator, bool IsConst>
+typename RBTreeBaseIterator<Key, Comparator, Allocator, IsConst>::reference
+RBTreeBaseIterator<Key, Comparator, Allocator, IsConst>::operator*() const {
   return this->getCurrentNode()->key_;
 }
 
@@ -2265,9 +5871,9 @@ RBTreeBaseIterator<Key, Comparator, IsConst>::operator*() const {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator, bool IsConst>
-typename RBTreeBaseIterator<Key, Comparator, IsConst>::pointer
-RBTreeBaseIterator<Key, Comparator, IsConst>::operator->() const {
+template <typename Key, typename Comparator, typename Allocator, bool IsConst>
+typename RBTreeBaseIterator<Key, Comparator, Allocator, IsConst>::pointer
+RBTreeBaseIterator<Key, Comparator, Allocator, IsConst>::operator->() const {
   return &(this->getCurrentNode()->key_);
 }
 
@@ -2280,8 +5886,8 @@ RBTreeBaseIterator<Key, Comparator, IsConst>::operator->() const {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator, bool IsConst>
-bool RBTreeBaseIterator<Key, Comparator, IsConst>::operator!=(
+template <typename Key, typename Comparator, typename Allocator, bool IsConst>
+bool RBTreeBaseIterator<Key, Comparator, Allocator, IsConst>::operator!=(
     const RBTreeBaseIterator &other)
     const noexcept { // если указатели разные, итераторы считаются неравными
   return this->current_ != other.current_;
@@ -2296,8 +5902,8 @@ bool RBTreeBaseIterator<Key, Comparator, IsConst>::operator!=(
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator, bool IsConst>
-bool RBTreeBaseIterator<Key, Comparator, IsConst>::operator==(
+template <typename Key, typename Comparator, typename Allocator, bool IsConst>
+bool RBTreeBaseIterator<Key, Comparator, Allocator, IsConst>::operator==(
     const RBTreeBaseIterator &other) const noexcept {
   return this->current_ == other.current_;
 }
@@ -2311,9 +5917,10 @@ bool RBTreeBaseIterator<Key, Comparator, IsConst>::operator==(
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTreeIterator<Key, Comparator>::iterator &
-RBTreeIterator<Key, Comparator>::operator++() { // префиксный инкремент
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTreeIterator<Key, Comparator, Allocator>::iterator &
+RBTreeIterator<Key, Comparator, Allocator>::operator++() {
+  // префиксный инкремент
   this->increment();
   return *this;
 }
@@ -2325,9 +5932,10 @@ RBTreeIterator<Key, Comparator>::operator++() { // префиксный инкр
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTreeIterator<Key, Comparator>::iterator
-RBTreeIterator<Key, Comparator>::operator++(int) { // постфиксный инкремент
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTreeIterator<Key, Comparator, Allocator>::iterator
+RBTreeIterator<Key, Comparator, Allocator>::operator++(int) {
+  // постфиксный инкремент
   iterator tmp(*this);
   this->increment();
   return tmp;
@@ -2340,9 +5948,10 @@ RBTreeIterator<Key, Comparator>::operator++(int) { // постфиксный и
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTreeIterator<Key, Comparator>::iterator &
-RBTreeIterator<Key, Comparator>::operator--() { // префиксный декремент
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTreeIterator<Key, Comparator, Allocator>::iterator &
+RBTreeIterator<Key, Comparator, Allocator>::operator--() {
+  // префиксный декремент
   this->decrement();
   return *this;
 }
@@ -2354,14 +5963,34 @@ RBTreeIterator<Key, Comparator>::operator--() { // префиксный декр
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename RBTreeIterator<Key, Comparator>::iterator
-RBTreeIterator<Key, Comparator>::operator--(int) { // постфиксный декремент
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTreeIterator<Key, Comparator, Allocator>::iterator
+RBTreeIterator<Key, Comparator, Allocator>::operator--(int) {
+  // постфиксный декремент
   iterator tmp(*this);
   this->decrement();
   return tmp;
 }
 
+/**
+ * @brief Moves the iterator n positions forward (or back if n < 0) in
+ * O(log n).
+ *
+ * @param n Number of positions to move, the result must be within
+ * [begin(), end()].
+ *
+ * @return iterator& A reference to the moved iterator.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename RBTreeIterator<Key, Comparator, Allocator>::iterator &
+RBTreeIterator<Key, Comparator, Allocator>::advance(
+    typename Base::difference_type n) noexcept {
+  this->jump(n);
+  return *this;
+}
+
 // ConstRBTreeIterator
 
 /**
@@ -2371,9 +6000,9 @@ RBTreeIterator<Key, Comparator>::operator--(int) { // постфиксный д
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename ConstRBTreeIterator<Key, Comparator>::iterator &
-ConstRBTreeIterator<Key, Comparator>::operator++() {
+template <typename Key, typename Comparator, typename Allocator>
+typename ConstRBTreeIterator<Key, Comparator, Allocator>::iterator &
+ConstRBTreeIterator<Key, Comparator, Allocator>::operator++() {
   this->increment();
   return *this;
 }
@@ -2385,9 +6014,9 @@ ConstRBTreeIterator<Key, Comparator>::operator++() {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename ConstRBTreeIterator<Key, Comparator>::iterator
-ConstRBTreeIterator<Key, Comparator>::operator++(int) {
+template <typename Key, typename Comparator, typename Allocator>
+typename ConstRBTreeIterator<Key, Comparator, Allocator>::iterator
+ConstRBTreeIterator<Key, Comparator, Allocator>::operator++(int) {
   iterator tmp(*this);
   this->increment();
   return tmp;
@@ -2400,9 +6029,9 @@ ConstRBTreeIterator<Key, Comparator>::operator++(int) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename ConstRBTreeIterator<Key, Comparator>::iterator &
-ConstRBTreeIterator<Key, Comparator>::operator--() {
+template <typename Key, typename Comparator, typename Allocator>
+typename ConstRBTreeIterator<Key, Comparator, Allocator>::iterator &
+ConstRBTreeIterator<Key, Comparator, Allocator>::operator--() {
   this->decrement();
   return *this;
 }
@@ -2414,14 +6043,33 @@ ConstRBTreeIterator<Key, Comparator>::operator--() {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-typename ConstRBTreeIterator<Key, Comparator>::iterator
-ConstRBTreeIterator<Key, Comparator>::operator--(int) {
+template <typename Key, typename Comparator, typename Allocator>
+typename ConstRBTreeIterator<Key, Comparator, Allocator>::iterator
+ConstRBTreeIterator<Key, Comparator, Allocator>::operator--(int) {
   iterator tmp(*this);
   this->decrement();
   return tmp;
 }
 
+/**
+ * @brief Moves the iterator n positions forward (or back if n < 0) in
+ * O(log n).
+ *
+ * @param n Number of positions to move, the result must be within
+ * [begin(), end()].
+ *
+ * @return iterator& A reference to the moved iterator.
+ *
+ * @throws N/A
+ */
+template <typename Key, typename Comparator, typename Allocator>
+typename ConstRBTreeIterator<Key, Comparator, Allocator>::iterator &
+ConstRBTreeIterator<Key, Comparator, Allocator>::advance(
+    typename Base::difference_type n) noexcept {
+  this->jump(n);
+  return *this;
+}
+
 /******************************************************************************
  * DEBUGGING METHODS
  ******************************************************************************/
@@ -2433,21 +6081,22 @@ ConstRBTreeIterator<Key, Comparator>::operator--(int) {
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::printNode(
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::printNode(
     Node *node) const { // Метод для печати узолов подряд с указателями
   if (node) {
-    std::cout << (node->red_ ? "[R]" : "[B]") << "  " << node->key_
-              << (root_ == node ? "      <ROOT>" : "") << std::endl;
+    std::cout << (node->isRed() ? "[R]" : "[B]") << "  " << node->key_
+              << (root() == node ? "      <ROOT>" : "") << std::endl;
 
-    std::cout << "parent:" << node->parent_ << " ("
-              << (node->parent_ ? reinterpret_cast<Node *>(node->parent_)->key_
-                                : -1)
+    std::cout << "parent:" << node->parent() << " ("
+              << (node->parent()
+                      ? reinterpret_cast<Node *>(node->parent())->key_
+                      : -1)
               << ")" << std::endl;
     std::cout << "  "
               << "node:" << node << " ("
-              << (node->parent_ && node->parent_->left_ == node ? "left"
-                                                                : "right")
+              << (node->parent() && node->parent()->left_ == node ? "left"
+                                                                  : "right")
               << ")" << std::endl;
     std::cout << "  "
               << "left:" << node->left_ << " "
@@ -2467,8 +6116,8 @@ void RBTree<Key, Comparator>::printNode(
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-int RBTree<Key, Comparator>::blackHeight(
+template <typename Key, typename Comparator, typename Allocator>
+int RBTree<Key, Comparator, Allocator>::blackHeight(
     const Node *node) const { // Метод для подсчёта чёрной высоты
   if (node == nullptr) {
     return 0;
@@ -2476,7 +6125,7 @@ int RBTree<Key, Comparator>::blackHeight(
   int height = 0;
   const Node *current = node;
   while (current != nullptr) {
-    if (!current->red_) {
+    if (!current->isRed()) {
       height++;
     }
     current = reinterpret_cast<Node *>(current->left_);
@@ -2492,13 +6141,13 @@ int RBTree<Key, Comparator>::blackHeight(
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::printRBNode(
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::printRBNode(
     const Node *node, int depth) { // Метод для печати одного узла
-  std::string color = (node->red_) ? "R" : "B";
+  std::string color = (node->isRed()) ? "R" : "B";
   int black_height = blackHeight(node);
   std::cout << std::string(depth * 4, ' ') << "[" << color
-            << (!node->red_ ? std::to_string(black_height + 1) : "") << "]"
+            << (!node->isRed() ? std::to_string(black_height + 1) : "") << "]"
             << node->key_ << std::endl;
 }
 
@@ -2510,8 +6159,8 @@ void RBTree<Key, Comparator>::printRBNode(
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::printNILNode(
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::printNILNode(
     int depth, int blackHeight) { // Метод для печати NIL узла
   std::cout << std::string(depth * 4, ' ') << "NIL["
             << "B" << blackHeight + (blackHeight == 0 ? 1 : 0) << "]"
@@ -2526,8 +6175,8 @@ void RBTree<Key, Comparator>::printNILNode(
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::printRBTree(
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::printRBTree(
     const Node *node, int depth) { // Метод для печати дерева
   if (node != nullptr) {
     printRBTree(reinterpret_cast<Node *>(node->right_), depth + 1);
@@ -2547,8 +6196,8 @@ void RBTree<Key, Comparator>::printRBTree(
  *
  * @throws N/A
  */
-template <typename Key, typename Comparator>
-void RBTree<Key, Comparator>::printMap(
+template <typename Key, typename Comparator, typename Allocator>
+void RBTree<Key, Comparator, Allocator>::printMap(
     const Node *node, int depth,
     std::function<void(const Node *, int)> printNodeFunc)
     const { // Метод для печати map
@@ -0,0 +1,199 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file seqlock_tree.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-17
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_SEQLOCK_TREE_H_
+#define CPP2_S21_CONTAINERS_SEQLOCK_TREE_H_
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional> // std::less
+#include <limits>
+#include <memory> // std::allocator_traits
+#include <mutex>
+#include <optional>
+#include <thread> // std::this_thread::yield
+#include <utility>
+
+// Число счётчиков читателей: потоки с разными номерами по модулю этого
+// числа не пишут в одну кэш-линию
+#ifndef S21_SEQLOCK_READER_SLOTS
+#define S21_SEQLOCK_READER_SLOTS 32
+#endif
+
+namespace s21 {
+
+/**
+ * @brief Red-black tree with unique keys whose lookups take no lock.
+ *
+ * Writers are serialized by a mutex and increment a sequence counter before
+ * and after every change of the tree (insertion, erasure, rotations): the
+ * counter is odd while the tree is being changed. A reader remembers the
+ * counter, descends the tree without any lock and accepts the result only if
+ * the counter is even and unchanged afterwards; otherwise it retries.
+ *
+ * This is safe because a reader never sees a half-built element: the
+ * element of a node is never changed after the node is linked (assignment
+ * links a new node instead), child links are atomic, and a node removed from
+ * the tree is freed only after every reader that could still reach it has
+ * finished (see tryReclaim).
+ *
+ * @tparam Key Type of the keys.
+ * @tparam Value Type of the mapped values.
+ * @tparam Compare Order of keys.
+ * @tparam Allocator Allocator of std::pair<const Key, Value>, rebound to the
+ * node type.
+ */
+template <typename Key, typename Value, typename Compare = std::less<Key>,
+          typename Allocator = std::allocator<std::pair<const Key, Value>>>
+class SeqlockTree {
+public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const Key, Value>;
+  using size_type = std::size_t;
+  using key_compare = Compare;
+  using allocator_type = Allocator;
+
+  SeqlockTree();
+  explicit SeqlockTree(const allocator_type &alloc);
+  SeqlockTree(const SeqlockTree &) = delete;
+  SeqlockTree &operator=(const SeqlockTree &) = delete;
+  ~SeqlockTree();
+
+  // Lock-free lookup:
+  std::optional<mapped_type> find(const key_type &key) const;
+  bool contains(const key_type &key) const;
+  size_type size() const noexcept;
+
+  // Modifiers (serialized by the writer mutex):
+  template <typename... Args>
+  bool emplaceUnique(const key_type &key, Args &&...args);
+  template <typename M> bool assign(const key_type &key, M &&obj);
+  size_type eraseKey(const key_type &key);
+  void clear();
+  template <typename Fn> void forEach(Fn &&fn) const;
+
+  // Reclamation:
+  bool reclaim();
+  size_type retiredCount() const;
+
+  // Debugging methods:
+  bool checkInvariants() const;
+
+private:
+  struct Node {
+    template <typename... Args>
+    explicit Node(Args &&...args) : value(std::forward<Args>(args)...) {}
+
+    value_type value; // не меняется, пока узел доступен читателям
+    std::atomic<Node *> left{nullptr};
+    std::atomic<Node *> right{nullptr};
+    Node *parent = nullptr;  // дальше - только для писателя
+    Node *retired = nullptr; // следующий в списке удалённых узлов
+    bool red = true;
+  };
+
+  // счётчики читателей, вошедших в каждую из двух фаз освобождения
+  struct alignas(64) ReaderSlot {
+    std::array<std::atomic<size_type>, 2> count{};
+  };
+
+  // регистрирует читателя в счётчике его потока на время поиска
+  class ReadGuard {
+  public:
+    explicit ReadGuard(const SeqlockTree &tree);
+    ReadGuard(const ReadGuard &) = delete;
+    ReadGuard &operator=(const ReadGuard &) = delete;
+    ~ReadGuard();
+
+  private:
+    std::atomic<size_type> *count_;
+  };
+
+  using node_allocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using node_traits = std::allocator_traits<node_allocator>;
+
+  // глубже красно-чёрное дерево из size_type узлов быть не может: читатель,
+  // ушедший дальше, попал в перестраиваемую часть и начинает заново
+  static constexpr size_type kMaxDepth =
+      2 * std::numeric_limits<size_type>::digits;
+  static constexpr size_type kReaderSlots = S21_SEQLOCK_READER_SLOTS;
+
+  // Optimistic reading:
+  std::uint64_t readBegin() const noexcept;
+  bool readValidate(std::uint64_t before) const noexcept;
+  const Node *locate(const key_type &key, bool &lost) const;
+  static size_type readerSlot() noexcept;
+
+  // Writing:
+  void writeBegin() noexcept;
+  void writeEnd() noexcept;
+  Node *findLocked(const key_type &key) const;
+  template <typename... Args> Node *createNode(Args &&...args);
+  void destroyNode(Node *node) noexcept;
+  void linkNode(Node *node);
+  void unlinkNode(Node *node) noexcept;
+  void replaceNode(Node *old_node, Node *new_node) noexcept;
+
+  // Balancing:
+  static Node *left(const Node *node) noexcept;
+  static Node *right(const Node *node) noexcept;
+  static void setLeft(Node *node, Node *child) noexcept;
+  static void setRight(Node *node, Node *child) noexcept;
+  static bool isRed(const Node *node) noexcept;
+  Node *root() const noexcept;
+  void replaceChild(Node *parent, Node *old_child, Node *new_child) noexcept;
+  void transplant(Node *old_node, Node *new_node) noexcept;
+  void rotateLeft(Node *node) noexcept;
+  void rotateRight(Node *node) noexcept;
+  void insertFixup(Node *node) noexcept;
+  void eraseFixup(Node *node, Node *parent) noexcept;
+
+  // Reclamation:
+  void retire(Node *node) noexcept;
+  void tryReclaim() noexcept;
+  bool readersIn(unsigned phase) const noexcept;
+  void retireSubtree(Node *node) noexcept;
+  void destroyList(Node *list) noexcept;
+  template <typename Fn> static void visitSubtree(const Node *node, Fn &fn);
+
+  // Debugging methods:
+  int checkSubtree(const Node *node, const Node *parent, const Node *&prev,
+                   size_type &count) const;
+
+  // читаются каждым поиском, пишутся только писателем
+  alignas(64) std::atomic<Node *> root_{nullptr};
+  std::atomic<std::uint64_t> sequence_{0};
+  std::atomic<unsigned> phase_{0};
+  std::atomic<size_type> size_{0};
+  key_compare compare_;
+
+  mutable std::array<ReaderSlot, kReaderSlots> readers_;
+
+  alignas(64) mutable std::mutex writer_mutex_;
+  Node *retired_ = nullptr; // удалены в текущей фазе
+  Node *waiting_ = nullptr; // удалены до смены фазы, ждут старых читателей
+  size_type retired_count_ = 0;
+  node_allocator alloc_;
+};
+
+} // namespace s21
+
+#include "seqlock_tree.tpp"
+
+#endif // CPP2_S21_CONTAINERS_SEQLOCK_TREE_H_
@@ -0,0 +1,853 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file seqlock_tree.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-08-17
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+namespace s21 {
+
+/******************************************************************************
+ * CONSTRUCTOR & DESTRUCTOR
+ ******************************************************************************/
+
+/**
+ * @brief Default constructor.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+SeqlockTree<Key, Value, Compare, Allocator>::SeqlockTree()
+    : SeqlockTree(allocator_type()) {}
+
+/**
+ * @brief Constructor with an allocator.
+ * @param alloc Allocator of the elements, rebound to the node type.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+SeqlockTree<Key, Value, Compare, Allocator>::SeqlockTree(
+    const allocator_type &alloc)
+    : compare_(), alloc_(alloc) {}
+
+/**
+ * @brief Destroys all nodes, including the retired ones. Must not run while
+ * other threads use the tree.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+SeqlockTree<Key, Value, Compare, Allocator>::~SeqlockTree() {
+  retireSubtree(root());
+  destroyList(retired_);
+  destroyList(waiting_);
+}
+
+/******************************************************************************
+ * MAIN METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Returns a copy of the value of the key without taking a lock.
+ *
+ * The search is repeated if a writer changed the tree meanwhile, so the
+ * result is the value of the key at some moment during the call.
+ * @param key Key to search for.
+ * @return The value, or std::nullopt if the key is absent.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::optional<Value>
+SeqlockTree<Key, Value, Compare, Allocator>::find(const key_type &key) const {
+  ReadGuard guard(*this);
+  for (;;) {
+    std::uint64_t before = readBegin();
+    bool lost = false;
+    const Node *node = locate(key, lost);
+    if (lost) {
+      continue;
+    }
+    // узел не освобождается, пока жив guard: копия цела даже при гонке
+    std::optional<mapped_type> result;
+    if (node) {
+      result.emplace(node->value.second);
+    }
+    if (readValidate(before)) {
+      return result;
+    }
+  }
+}
+
+/**
+ * @brief Checks if the tree contains the key without taking a lock.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool SeqlockTree<Key, Value, Compare, Allocator>::contains(
+    const key_type &key) const {
+  ReadGuard guard(*this);
+  for (;;) {
+    std::uint64_t before = readBegin();
+    bool lost = false;
+    bool found = locate(key, lost) != nullptr;
+    if (!lost && readValidate(before)) {
+      return found;
+    }
+  }
+}
+
+/**
+ * @brief Returns the number of elements after the last completed write.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename SeqlockTree<Key, Value, Compare, Allocator>::size_type
+SeqlockTree<Key, Value, Compare, Allocator>::size() const noexcept {
+  return size_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Inserts an element built from args if the key is absent.
+ *
+ * The node is built before the tree is changed, so an exception thrown by
+ * the element constructor leaves the tree and the readers untouched.
+ * @param key Key of the element, equal to the key of the built element.
+ * @param args Arguments of the value_type constructor.
+ * @return true if the element was inserted.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+bool SeqlockTree<Key, Value, Compare, Allocator>::emplaceUnique(
+    const key_type &key, Args &&...args) {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  if (findLocked(key)) {
+    return false;
+  }
+  Node *node = createNode(std::forward<Args>(args)...);
+  writeBegin();
+  linkNode(node);
+  writeEnd();
+  size_.store(size_.load(std::memory_order_relaxed) + 1,
+              std::memory_order_relaxed);
+  return true;
+}
+
+/**
+ * @brief Inserts a key with a value, or replaces the value of the key.
+ *
+ * A present value is never changed in place: a new node takes the place of
+ * the old one, which is retired, so readers copy either the old or the new
+ * value, never a partly assigned one.
+ * @param key Key of the element.
+ * @param obj Value to insert or assign.
+ * @return true if the element was inserted, false if it was replaced.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename M>
+bool SeqlockTree<Key, Value, Compare, Allocator>::assign(const key_type &key,
+                                                         M &&obj) {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  Node *old_node = findLocked(key);
+  Node *node = createNode(key, std::forward<M>(obj));
+  writeBegin();
+  if (old_node) {
+    replaceNode(old_node, node);
+  } else {
+    linkNode(node);
+  }
+  writeEnd();
+  if (!old_node) {
+    size_.store(size_.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+    return true;
+  }
+  retire(old_node);
+  tryReclaim();
+  return false;
+}
+
+/**
+ * @brief Erases the element with the key. The node is freed once no reader
+ * can reach it.
+ * @param key Key to erase.
+ * @return Number of erased elements (0 or 1).
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename SeqlockTree<Key, Value, Compare, Allocator>::size_type
+SeqlockTree<Key, Value, Compare, Allocator>::eraseKey(const key_type &key) {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  Node *node = findLocked(key);
+  if (!node) {
+    return 0;
+  }
+  writeBegin();
+  unlinkNode(node);
+  writeEnd();
+  size_.store(size_.load(std::memory_order_relaxed) - 1,
+              std::memory_order_relaxed);
+  retire(node);
+  tryReclaim();
+  return 1;
+}
+
+/**
+ * @brief Erases all elements: the tree is detached at once, the nodes are
+ * freed once no reader can reach them.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::clear() {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  Node *old_root = root();
+  if (!old_root) {
+    return;
+  }
+  writeBegin();
+  root_.store(nullptr, std::memory_order_release);
+  writeEnd();
+  size_.store(0, std::memory_order_relaxed);
+  retireSubtree(old_root);
+  tryReclaim();
+}
+
+/**
+ * @brief Calls fn(element) for every element in key order.
+ *
+ * Holds the writer mutex: readers are not delayed, writers wait until the
+ * walk ends. fn must not modify the tree.
+ * @param fn Callable taking const value_type &.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename Fn>
+void SeqlockTree<Key, Value, Compare, Allocator>::forEach(Fn &&fn) const {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  visitSubtree(root(), fn);
+}
+
+/**
+ * @brief Frees the retired nodes that no reader can reach any more.
+ *
+ * Writers already do this after every erasure; call it after the last write
+ * to return the memory of the last retired nodes. Never waits for readers.
+ * @return true if no retired node is left.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool SeqlockTree<Key, Value, Compare, Allocator>::reclaim() {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  tryReclaim();
+  tryReclaim(); // вторая попытка освобождает узлы, дождавшиеся смены фазы
+  return retired_count_ == 0;
+}
+
+/**
+ * @brief Returns the number of removed nodes that are not freed yet.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename SeqlockTree<Key, Value, Compare, Allocator>::size_type
+SeqlockTree<Key, Value, Compare, Allocator>::retiredCount() const {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  return retired_count_;
+}
+
+/******************************************************************************
+ * SUPPORT METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Registers the reader in the counter of its thread for the current
+ * phase.
+ *
+ * The phase is read again after the increment: if a writer switched it in
+ * between, the writer may not have seen the increment, so the reader moves
+ * to the new phase.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+SeqlockTree<Key, Value, Compare, Allocator>::ReadGuard::ReadGuard(
+    const SeqlockTree &tree) {
+  ReaderSlot &slot = tree.readers_[readerSlot()];
+  for (;;) {
+    unsigned phase = tree.phase_.load(std::memory_order_seq_cst);
+    count_ = &slot.count[phase];
+    count_->fetch_add(1, std::memory_order_seq_cst);
+    if (tree.phase_.load(std::memory_order_seq_cst) == phase) {
+      return;
+    }
+    count_->fetch_sub(1, std::memory_order_release);
+  }
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+SeqlockTree<Key, Value, Compare, Allocator>::ReadGuard::~ReadGuard() {
+  // release: все чтения узлов завершены до того, как писатель увидит ноль
+  count_->fetch_sub(1, std::memory_order_release);
+}
+
+/**
+ * @brief Waits until no write is in progress and returns the sequence
+ * counter.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+std::uint64_t
+SeqlockTree<Key, Value, Compare, Allocator>::readBegin() const noexcept {
+  for (;;) {
+    std::uint64_t sequence = sequence_.load(std::memory_order_acquire);
+    if ((sequence & 1) == 0) {
+      return sequence;
+    }
+    std::this_thread::yield();
+  }
+}
+
+/**
+ * @brief Checks that no write started since readBegin returned before.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool SeqlockTree<Key, Value, Compare, Allocator>::readValidate(
+    std::uint64_t before) const noexcept {
+  // чтения узлов не переставляются за повторное чтение счётчика
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return sequence_.load(std::memory_order_relaxed) == before;
+}
+
+/**
+ * @brief Descends the tree from the root without a lock.
+ * @param key Key to search for.
+ * @param lost Set if the path is longer than any valid one, i.e. the reader
+ * followed links changed by a writer.
+ * @return The node of the key, or nullptr.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+const typename SeqlockTree<Key, Value, Compare, Allocator>::Node *
+SeqlockTree<Key, Value, Compare, Allocator>::locate(const key_type &key,
+                                                    bool &lost) const {
+  // acquire: поля нового узла видны раньше, чем ссылка на него
+  const Node *node = root_.load(std::memory_order_acquire);
+  for (size_type depth = 0; node; ++depth) {
+    if (depth == kMaxDepth) {
+      lost = true;
+      return nullptr;
+    }
+    if (compare_(key, node->value.first)) {
+      node = node->left.load(std::memory_order_acquire);
+    } else if (compare_(node->value.first, key)) {
+      node = node->right.load(std::memory_order_acquire);
+    } else {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Returns the reader counter of the calling thread. Threads get
+ * consecutive numbers, so the first kReaderSlots threads never share one.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename SeqlockTree<Key, Value, Compare, Allocator>::size_type
+SeqlockTree<Key, Value, Compare, Allocator>::readerSlot() noexcept {
+  static std::atomic<size_type> next{0};
+  thread_local size_type slot =
+      next.fetch_add(1, std::memory_order_relaxed) % kReaderSlots;
+  return slot;
+}
+
+/**
+ * @brief Makes the sequence counter odd before the tree is changed.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::writeBegin() noexcept {
+  sequence_.store(sequence_.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+  // изменения дерева не переставляются раньше нечётного счётчика
+  std::atomic_thread_fence(std::memory_order_release);
+}
+
+/**
+ * @brief Makes the sequence counter even after the tree is changed.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::writeEnd() noexcept {
+  sequence_.store(sequence_.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_release);
+}
+
+/**
+ * @brief Finds the node of the key; called by writers under the mutex.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename SeqlockTree<Key, Value, Compare, Allocator>::Node *
+SeqlockTree<Key, Value, Compare, Allocator>::findLocked(
+    const key_type &key) const {
+  Node *node = root();
+  while (node) {
+    if (compare_(key, node->value.first)) {
+      node = left(node);
+    } else if (compare_(node->value.first, key)) {
+      node = right(node);
+    } else {
+      return node;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Allocates a node and builds its element from args.
+ * @throws std::bad_alloc, anything thrown by the element constructor.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename... Args>
+typename SeqlockTree<Key, Value, Compare, Allocator>::Node *
+SeqlockTree<Key, Value, Compare, Allocator>::createNode(Args &&...args) {
+  Node *node = node_traits::allocate(alloc_, 1);
+  try {
+    node_traits::construct(alloc_, node, std::forward<Args>(args)...);
+  } catch (...) {
+    node_traits::deallocate(alloc_, node, 1);
+    throw;
+  }
+  return node;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::destroyNode(
+    Node *node) noexcept {
+  node_traits::destroy(alloc_, node);
+  node_traits::deallocate(alloc_, node, 1);
+}
+
+/**
+ * @brief Links a new node as a leaf and restores the balance.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::linkNode(Node *node) {
+  Node *parent = nullptr;
+  bool to_left = false;
+  for (Node *current = root(); current;) {
+    parent = current;
+    to_left = compare_(node->value.first, current->value.first);
+    current = to_left ? left(current) : right(current);
+  }
+  node->parent = parent;
+  if (!parent) {
+    root_.store(node, std::memory_order_release);
+  } else if (to_left) {
+    setLeft(parent, node);
+  } else {
+    setRight(parent, node);
+  }
+  insertFixup(node);
+}
+
+/**
+ * @brief Removes a node from the tree and restores the balance.
+ *
+ * The links of the removed node stay as they were, so a reader standing on
+ * it can still descend; the seqlock makes it retry anyway.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::unlinkNode(
+    Node *node) noexcept {
+  Node *moved = node; // узел, уходящий со своего места
+  bool moved_red = moved->red;
+  Node *child = nullptr;
+  Node *child_parent = nullptr;
+  if (!left(node)) {
+    child = right(node);
+    child_parent = node->parent;
+    transplant(node, child);
+  } else if (!right(node)) {
+    child = left(node);
+    child_parent = node->parent;
+    transplant(node, child);
+  } else {
+    // два потомка: место узла занимает его преемник
+    moved = right(node);
+    while (left(moved)) {
+      moved = left(moved);
+    }
+    moved_red = moved->red;
+    child = right(moved);
+    if (moved->parent == node) {
+      child_parent = moved;
+    } else {
+      child_parent = moved->parent;
+      transplant(moved, child);
+      setRight(moved, right(node));
+      right(moved)->parent = moved;
+    }
+    transplant(node, moved);
+    setLeft(moved, left(node));
+    left(moved)->parent = moved;
+    moved->red = node->red;
+  }
+  if (!moved_red) {
+    eraseFixup(child, child_parent);
+  }
+}
+
+/**
+ * @brief Puts a new node with the same key in place of an old one.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::replaceNode(
+    Node *old_node, Node *new_node) noexcept {
+  Node *left_child = left(old_node);
+  Node *right_child = right(old_node);
+  new_node->red = old_node->red;
+  new_node->parent = old_node->parent;
+  setLeft(new_node, left_child);
+  setRight(new_node, right_child);
+  if (left_child) {
+    left_child->parent = new_node;
+  }
+  if (right_child) {
+    right_child->parent = new_node;
+  }
+  replaceChild(old_node->parent, old_node, new_node);
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename SeqlockTree<Key, Value, Compare, Allocator>::Node *
+SeqlockTree<Key, Value, Compare, Allocator>::left(const Node *node) noexcept {
+  return node->left.load(std::memory_order_relaxed);
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename SeqlockTree<Key, Value, Compare, Allocator>::Node *
+SeqlockTree<Key, Value, Compare, Allocator>::right(const Node *node) noexcept {
+  return node->right.load(std::memory_order_relaxed);
+}
+
+// release: читатель, увидевший ссылку, видит и построенный узел
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::setLeft(
+    Node *node, Node *child) noexcept {
+  node->left.store(child, std::memory_order_release);
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::setRight(
+    Node *node, Node *child) noexcept {
+  node->right.store(child, std::memory_order_release);
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool SeqlockTree<Key, Value, Compare, Allocator>::isRed(
+    const Node *node) noexcept {
+  return node && node->red;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+typename SeqlockTree<Key, Value, Compare, Allocator>::Node *
+SeqlockTree<Key, Value, Compare, Allocator>::root() const noexcept {
+  return root_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Redirects the link of parent (or the root) from old_child to
+ * new_child.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::replaceChild(
+    Node *parent, Node *old_child, Node *new_child) noexcept {
+  if (!parent) {
+    root_.store(new_child, std::memory_order_release);
+  } else if (left(parent) == old_child) {
+    setLeft(parent, new_child);
+  } else {
+    setRight(parent, new_child);
+  }
+}
+
+/**
+ * @brief Puts the subtree new_node in place of the subtree old_node.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::transplant(
+    Node *old_node, Node *new_node) noexcept {
+  replaceChild(old_node->parent, old_node, new_node);
+  if (new_node) {
+    new_node->parent = old_node->parent;
+  }
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::rotateLeft(
+    Node *node) noexcept {
+  Node *pivot = right(node);
+  Node *inner = left(pivot);
+  setRight(node, inner);
+  if (inner) {
+    inner->parent = node;
+  }
+  pivot->parent = node->parent;
+  replaceChild(node->parent, node, pivot);
+  setLeft(pivot, node);
+  node->parent = pivot;
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::rotateRight(
+    Node *node) noexcept {
+  Node *pivot = left(node);
+  Node *inner = right(pivot);
+  setLeft(node, inner);
+  if (inner) {
+    inner->parent = node;
+  }
+  pivot->parent = node->parent;
+  replaceChild(node->parent, node, pivot);
+  setRight(pivot, node);
+  node->parent = pivot;
+}
+
+/**
+ * @brief Restores the red-black properties after a red leaf was linked.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::insertFixup(
+    Node *node) noexcept {
+  while (isRed(node->parent)) {
+    Node *parent = node->parent;
+    Node *grandparent = parent->parent; // красный отец - не корень
+    if (parent == left(grandparent)) {
+      Node *uncle = right(grandparent);
+      if (isRed(uncle)) {
+        parent->red = uncle->red = false;
+        grandparent->red = true;
+        node = grandparent;
+        continue;
+      }
+      if (node == right(parent)) {
+        node = parent;
+        rotateLeft(node);
+        parent = node->parent;
+      }
+      parent->red = false;
+      grandparent->red = true;
+      rotateRight(grandparent);
+    } else {
+      Node *uncle = left(grandparent);
+      if (isRed(uncle)) {
+        parent->red = uncle->red = false;
+        grandparent->red = true;
+        node = grandparent;
+        continue;
+      }
+      if (node == left(parent)) {
+        node = parent;
+        rotateRight(node);
+        parent = node->parent;
+      }
+      parent->red = false;
+      grandparent->red = true;
+      rotateLeft(grandparent);
+    }
+  }
+  root()->red = false;
+}
+
+/**
+ * @brief Restores the black height after a black node was removed.
+ * @param node Node that took the place of the removed one (may be nullptr).
+ * @param parent Parent of that place.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::eraseFixup(
+    Node *node, Node *parent) noexcept {
+  while (node != root() && !isRed(node)) {
+    if (node == left(parent)) {
+      Node *sibling = right(parent);
+      if (isRed(sibling)) {
+        sibling->red = false;
+        parent->red = true;
+        rotateLeft(parent);
+        sibling = right(parent);
+      }
+      if (!isRed(left(sibling)) && !isRed(right(sibling))) {
+        sibling->red = true;
+        node = parent;
+        parent = node->parent;
+        continue;
+      }
+      if (!isRed(right(sibling))) {
+        left(sibling)->red = false;
+        sibling->red = true;
+        rotateRight(sibling);
+        sibling = right(parent);
+      }
+      sibling->red = parent->red;
+      parent->red = false;
+      right(sibling)->red = false;
+      rotateLeft(parent);
+    } else {
+      Node *sibling = left(parent);
+      if (isRed(sibling)) {
+        sibling->red = false;
+        parent->red = true;
+        rotateRight(parent);
+        sibling = left(parent);
+      }
+      if (!isRed(left(sibling)) && !isRed(right(sibling))) {
+        sibling->red = true;
+        node = parent;
+        parent = node->parent;
+        continue;
+      }
+      if (!isRed(left(sibling))) {
+        right(sibling)->red = false;
+        sibling->red = true;
+        rotateLeft(sibling);
+        sibling = left(parent);
+      }
+      sibling->red = parent->red;
+      parent->red = false;
+      left(sibling)->red = false;
+      rotateRight(parent);
+    }
+    node = root();
+  }
+  if (node) {
+    node->red = false;
+  }
+}
+
+/**
+ * @brief Adds a removed node to the list of the current phase.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::retire(Node *node) noexcept {
+  node->retired = retired_;
+  retired_ = node;
+  ++retired_count_;
+}
+
+/**
+ * @brief Frees the retired nodes that no reader can reach.
+ *
+ * Readers are counted per phase (0 or 1). Nodes retired in the current
+ * phase may be reached by its readers, so the writer switches the phase:
+ * new readers start from the tree without these nodes, and the nodes are
+ * freed once the counters of the old phase drop to zero. Until then they
+ * wait in waiting_, and the phase is not switched again.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::tryReclaim() noexcept {
+  unsigned phase = phase_.load(std::memory_order_relaxed);
+  if (waiting_) {
+    if (readersIn(phase ^ 1U)) {
+      return;
+    }
+    destroyList(waiting_);
+    waiting_ = nullptr;
+  }
+  if (retired_) {
+    phase_.store(phase ^ 1U, std::memory_order_seq_cst);
+    waiting_ = retired_;
+    retired_ = nullptr;
+    if (!readersIn(phase)) {
+      destroyList(waiting_);
+      waiting_ = nullptr;
+    }
+  }
+}
+
+/**
+ * @brief Checks whether some reader registered in the phase is still
+ * searching.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool SeqlockTree<Key, Value, Compare, Allocator>::readersIn(
+    unsigned phase) const noexcept {
+  for (const ReaderSlot &slot : readers_) {
+    if (slot.count[phase].load(std::memory_order_seq_cst) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief Retires every node of a detached subtree.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::retireSubtree(
+    Node *node) noexcept {
+  while (node) {
+    retireSubtree(left(node));
+    Node *next = right(node);
+    retire(node);
+    node = next;
+  }
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+void SeqlockTree<Key, Value, Compare, Allocator>::destroyList(
+    Node *list) noexcept {
+  while (list) {
+    Node *next = list->retired;
+    destroyNode(list);
+    --retired_count_;
+    list = next;
+  }
+}
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+template <typename Fn>
+void SeqlockTree<Key, Value, Compare, Allocator>::visitSubtree(
+    const Node *node, Fn &fn) {
+  while (node) {
+    visitSubtree(left(node), fn);
+    fn(node->value);
+    node = right(node);
+  }
+}
+
+/******************************************************************************
+ * DEBUGGING METHODS
+ ******************************************************************************/
+
+/**
+ * @brief Checks the order of keys, the parent links, the red-black
+ * properties and the element counter.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+bool SeqlockTree<Key, Value, Compare, Allocator>::checkInvariants() const {
+  std::lock_guard<std::mutex> lock(writer_mutex_);
+  if (isRed(root()) || (sequence_.load() & 1) != 0) {
+    return false;
+  }
+  const Node *prev = nullptr;
+  size_type count = 0;
+  return checkSubtree(root(), nullptr, prev, count) > 0 && count == size();
+}
+
+/**
+ * @brief Checks a subtree in key order.
+ * @return Black height of the subtree, or -1 if it is broken.
+ */
+template <typename Key, typename Value, typename Compare, typename Allocator>
+int SeqlockTree<Key, Value, Compare, Allocator>::checkSubtree(
+    const Node *node, const Node *parent, const Node *&prev,
+    size_type &count) const {
+  if (!node) {
+    return 1;
+  }
+  if (node->parent != parent || (node->red && isRed(parent))) {
+    return -1;
+  }
+  int left_height = checkSubtree(left(node), node, prev, count);
+  if (left_height < 0 ||
+      (prev && !compare_(prev->value.first, node->value.first))) {
+    return -1;
+  }
+  prev = node;
+  ++count;
+  int right_height = checkSubtree(right(node), node, prev, count);
+  if (right_height != left_height) {
+    return -1;
+  }
+  return left_height + (node->red ? 0 : 1);
+}
+
+} // namespace s21
@@ -0,0 +1,286 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file snapshot.h
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-09-07
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#ifndef CPP2_S21_CONTAINERS_SNAPSHOT_H_
+#define CPP2_S21_CONTAINERS_SNAPSHOT_H_
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring> // std::memcpy
+#include <iterator>
+#include <memory> // std::unique_ptr
+#include <new>    // std::launder
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility> // std::pair
+
+#include <sys/stat.h> // fstat
+#include <unistd.h>   // read, write, lseek
+
+namespace s21 {
+
+/**
+ * @brief Container that wrote a snapshot or a mapped index file; loading
+ * checks that it matches.
+ */
+enum class SnapshotKind : std::uint32_t {
+  kVector = 1,
+  kArray = 2,
+  kList = 3,
+  kSet = 4,
+  kMap = 5,
+  kMultiSet = 6,
+  kMappedSet = 7, // файлы MappedSet / MappedMap (см. mapped_index.h)
+  kMappedMap = 8,
+};
+
+/**
+ * @brief Fixed header at the start of every snapshot.
+ *
+ * The header is written in the byte order of the machine; byte_order lets
+ * a reader on another machine reject the file instead of misreading it.
+ * key_size and value_size are the sizes of the fixed-size parts of an
+ * element (the key and the mapped value of a Map), 0 for variable-size
+ * parts such as strings, so that a snapshot of Set<int> is not loaded as a
+ * Set<long>. payload is the number of bytes after the header: the reader
+ * never reads past it, so several snapshots can follow each other in one
+ * stream. leaf is the number of keys per search block in the files of
+ * MappedSet and MappedMap and 0 in snapshots.
+ */
+struct SnapshotHeader {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint32_t kind;
+  std::uint32_t key_size;
+  std::uint32_t value_size;
+  std::uint32_t leaf;
+  std::uint64_t count;
+  std::uint64_t payload;
+};
+
+static_assert(sizeof(SnapshotHeader) == 48,
+              "the snapshot header must have no padding");
+
+inline constexpr char kSnapshotMagic[8] = "S21SNAP";
+inline constexpr std::uint32_t kSnapshotVersion = 1;
+inline constexpr std::uint32_t kSnapshotByteOrder = 0x01020304;
+
+class SnapshotWriter;
+class SnapshotReader;
+
+/**
+ * @brief Encoding of one element in a snapshot.
+ *
+ * Trivially copyable types are stored as their bytes (kSize = sizeof(T));
+ * containers of them are written and read as whole blocks. Specializations
+ * below cover std::basic_string and std::pair (the elements of Map); other
+ * types need a specialization with the same members:
+ * - decoded_type: type returned by read();
+ * - kSize: encoded size if it is fixed, otherwise 0;
+ * - kKeySize, kValueSize: sizes recorded in the header;
+ * - kMinSize: smallest encoded size, used to check the element count;
+ * - size(value), write(writer, value), read(reader).
+ */
+template <typename T, typename = void> struct SnapshotTraits {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "specialize s21::SnapshotTraits to save this type");
+
+  using decoded_type = T;
+  static constexpr std::uint32_t kSize = sizeof(T);
+  static constexpr std::uint32_t kKeySize = sizeof(T);
+  static constexpr std::uint32_t kValueSize = 0;
+  static constexpr std::uint64_t kMinSize = sizeof(T);
+
+  static std::uint64_t size(const T &) noexcept { return sizeof(T); }
+  static void write(SnapshotWriter &writer, const T &value);
+  static T read(SnapshotReader &reader);
+};
+
+/**
+ * @brief Strings: the length as a 64-bit number, then the characters.
+ */
+template <typename Char, typename CharTraits, typename Alloc>
+struct SnapshotTraits<std::basic_string<Char, CharTraits, Alloc>> {
+  using string_type = std::basic_string<Char, CharTraits, Alloc>;
+  using decoded_type = string_type;
+  static constexpr std::uint32_t kSize = 0;
+  static constexpr std::uint32_t kKeySize = 0;
+  static constexpr std::uint32_t kValueSize = 0;
+  static constexpr std::uint64_t kMinSize = sizeof(std::uint64_t);
+
+  static std::uint64_t size(const string_type &value) noexcept;
+  static void write(SnapshotWriter &writer, const string_type &value);
+  static string_type read(SnapshotReader &reader);
+};
+
+/**
+ * @brief Pairs (Map elements): the first member, then the second one.
+ */
+template <typename First, typename Second>
+struct SnapshotTraits<std::pair<First, Second>> {
+  using first_traits = SnapshotTraits<typename std::remove_const<First>::type>;
+  using second_traits = SnapshotTraits<Second>;
+  using decoded_type = std::pair<typename first_traits::decoded_type,
+                                 typename second_traits::decoded_type>;
+  static constexpr std::uint32_t kSize =
+      first_traits::kSize != 0 && second_traits::kSize != 0
+          ? first_traits::kSize + second_traits::kSize
+          : 0;
+  static constexpr std::uint32_t kKeySize = first_traits::kSize;
+  static constexpr std::uint32_t kValueSize = second_traits::kSize;
+  static constexpr std::uint64_t kMinSize =
+      first_traits::kMinSize + second_traits::kMinSize;
+
+  static std::uint64_t size(const std::pair<First, Second> &value) noexcept;
+  static void write(SnapshotWriter &writer,
+                    const std::pair<First, Second> &value);
+  static decoded_type read(SnapshotReader &reader);
+};
+
+/**
+ * @brief Buffered writer of a snapshot to a file descriptor.
+ *
+ * Small pieces are collected in a buffer of kBufferSize bytes; pieces at
+ * least as large as the buffer go to write() directly, so a contiguous
+ * block of trivially copyable elements is written without copying. Short
+ * writes and EINTR are retried. The file descriptor is not closed.
+ */
+class SnapshotWriter {
+public:
+  static constexpr std::size_t kBufferSize = 64 * 1024;
+
+  explicit SnapshotWriter(int fd);
+  SnapshotWriter(const SnapshotWriter &) = delete;
+  SnapshotWriter &operator=(const SnapshotWriter &) = delete;
+
+  void write(const void *data, std::size_t bytes);
+  void flush();
+
+private:
+  void writeAll(const char *data, std::size_t bytes);
+
+  int fd_;
+  std::unique_ptr<char[]> buffer_;
+  std::size_t used_ = 0;
+};
+
+/**
+ * @brief Buffered reader of one snapshot from a file descriptor.
+ *
+ * The constructor reads and checks the header. Afterwards at most
+ * header().payload bytes are read from the descriptor, so the data that
+ * follows the snapshot stays in the stream. Large reads go straight into
+ * the destination, so a vector of trivially copyable elements is filled by
+ * read() without an intermediate buffer.
+ *
+ * For a regular file the constructor also checks that the payload fits in
+ * the rest of the file, so the element count can be trusted to size
+ * allocations. A pipe cannot be checked in advance; reserveCount() and
+ * reserveBytes() then stay within one buffer and the containers and
+ * strings grow as the data actually arrives.
+ */
+class SnapshotReader {
+public:
+  static constexpr std::size_t kBufferSize = 64 * 1024;
+
+  SnapshotReader(int fd, SnapshotKind kind, std::uint32_t key_size,
+                 std::uint32_t value_size, std::uint64_t min_size);
+  SnapshotReader(const SnapshotReader &) = delete;
+  SnapshotReader &operator=(const SnapshotReader &) = delete;
+
+  const SnapshotHeader &header() const noexcept { return header_; }
+  std::size_t count() const noexcept;
+  std::size_t reserveCount() const noexcept; // сколько можно выделить сразу
+  std::size_t reserveBytes(std::uint64_t bytes) const noexcept;
+  std::uint64_t remaining() const noexcept; // непрочитанные байты payload
+  void read(void *data, std::size_t bytes);
+  void finish() const; // весь payload должен быть прочитан
+
+private:
+  std::size_t readSome(char *data, std::size_t bytes);
+  void readExact(char *data, std::size_t bytes);
+
+  int fd_;
+  SnapshotHeader header_;
+  std::uint64_t left_;     // ещё не прочитанные из fd байты payload
+  std::size_t reserve_ = 0;
+  bool checked_ = false;   // payload сверен с размером файла
+  std::unique_ptr<char[]> buffer_;
+  std::size_t begin_ = 0;  // непрочитанная часть буфера: [begin_, end_)
+  std::size_t end_ = 0;
+};
+
+/**
+ * @brief Single-pass iterator that decodes the elements of a snapshot.
+ *
+ * Dereferencing gives the decoded element, which may be moved from (it is
+ * used through std::move_iterator to build tree nodes without a copy).
+ * Exactly count elements are decoded, each one when the iterator reaches
+ * it.
+ */
+template <typename T> class SnapshotInputIterator {
+public:
+  using traits = SnapshotTraits<T>;
+  using iterator_category = std::input_iterator_tag;
+  using value_type = typename traits::decoded_type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = value_type *;
+  using reference = value_type &;
+
+  SnapshotInputIterator(SnapshotReader &reader, std::size_t count);
+
+  reference operator*() const noexcept { return *value_; }
+  pointer operator->() const noexcept { return &*value_; }
+  SnapshotInputIterator &operator++();
+  // копия видела бы тот же поток, поэтому постфиксной формы нет
+
+  // итераторы равны, если до конца осталось одинаковое число элементов
+  bool operator==(const SnapshotInputIterator &other) const noexcept {
+    return left_ == other.left_;
+  }
+  bool operator!=(const SnapshotInputIterator &other) const noexcept {
+    return left_ != other.left_;
+  }
+
+private:
+  SnapshotReader *reader_;
+  std::size_t left_; // элементы до конца, включая текущий
+  // move_iterator разыменовывает как const; у элемента может не быть
+  // конструктора по умолчанию
+  mutable std::optional<value_type> value_;
+};
+
+// Writing and reading whole containers:
+template <typename T, typename InputIt>
+void saveSnapshot(int fd, SnapshotKind kind, InputIt first,
+                  std::size_t count);
+template <typename T>
+void saveSnapshotBlock(int fd, SnapshotKind kind, const T *data,
+                       std::size_t count);
+template <typename T>
+SnapshotReader openSnapshot(int fd, SnapshotKind kind);
+template <typename T>
+void readSnapshotElements(SnapshotReader &reader, T *data, std::size_t count);
+
+} // namespace s21
+
+#include "snapshot.tpp"
+
+#endif // CPP2_S21_CONTAINERS_SNAPSHOT_H_
@@ -0,0 +1,627 @@
+// Copyright 2024 Dmitrii Khramtsov
+
+/**
+ * @file snapshot.tpp
+ *
+ * @author Dmitrii Khramtsov (lonmouth@student.21-school.ru)
+ *
+ * @brief Methods of the CPP2_s21_containers project,
+ * which implements a library for working with containers.
+ *
+ * @date 2024-09-07
+ *
+ * @copyright School-21 (c) 2024
+ */
+
+#include "snapshot.h"
+
+namespace s21 {
+
+/******************************************************************************
+ * ELEMENT ENCODING
+ ******************************************************************************/
+
+/**
+ * @brief Writes the bytes of a trivially copyable value.
+ *
+ * @param writer Destination.
+ * @param value Value to write.
+ *
+ * @throws std::system_error if the descriptor cannot be written.
+ */
+template <typename T, typename Enable>
+void SnapshotTraits<T, Enable>::write(SnapshotWriter &writer, const T &value) {
+  writer.write(&value, sizeof(T));
+}
+
+/**
+ * @brief Reads the bytes of a trivially copyable value.
+ *
+ * The bytes are read into raw storage and the value is copied out of it,
+ * so T does not need a default constructor.
+ *
+ * @param reader Source.
+ *
+ * @return T The value.
+ *
+ * @throws std::runtime_error if the snapshot ends too early.
+ */
+template <typename T, typename Enable>
+T SnapshotTraits<T, Enable>::read(SnapshotReader &reader) {
+  alignas(T) unsigned char bytes[sizeof(T)];
+  reader.read(bytes, sizeof(T));
+  return *std::launder(reinterpret_cast<T *>(bytes));
+}
+
+/**
+ * @brief Returns the encoded size of a string: its length and characters.
+ *
+ * @param value The string.
+ *
+ * @return std::uint64_t Size in bytes.
+ *
+ * @throws N/A
+ */
+template <typename Char, typename CharTraits, typename Alloc>
+std::uint64_t SnapshotTraits<std::basic_string<Char, CharTraits, Alloc>>::size(
+    const string_type &value) noexcept {
+  return sizeof(std::uint64_t) + value.size() * sizeof(Char);
+}
+
+/**
+ * @brief Writes the length of a string and then its characters.
+ *
+ * @param writer Destination.
+ * @param value The string.
+ *
+ * @throws std::system_error if the descriptor cannot be written.
+ */
+template <typename Char, typename CharTraits, typename Alloc>
+void SnapshotTraits<std::basic_string<Char, CharTraits, Alloc>>::write(
+    SnapshotWriter &writer, const string_type &value) {
+  std::uint64_t length = value.size();
+  writer.write(&length, sizeof(length));
+  writer.write(value.data(), value.size() * sizeof(Char));
+}
+
+/**
+ * @brief Reads a string written by write().
+ *
+ * @param reader Source.
+ *
+ * @return string_type The string.
+ *
+ * @throws std::runtime_error if the length does not fit into the rest of
+ * the snapshot or the snapshot ends too early.
+ */
+template <typename Char, typename CharTraits, typename Alloc>
+typename SnapshotTraits<std::basic_string<Char, CharTraits, Alloc>>::string_type
+SnapshotTraits<std::basic_string<Char, CharTraits, Alloc>>::read(
+    SnapshotReader &reader) {
+  std::uint64_t length = 0;
+  reader.read(&length, sizeof(length));
+  // испорченная длина не должна приводить к огромному выделению памяти
+  if (length > reader.remaining() / sizeof(Char)) {
+    throw std::runtime_error("s21::snapshot: corrupted string length");
+  }
+  // из канала длинная строка читается кусками: память растёт только по
+  // мере прихода данных
+  std::size_t step = reader.reserveBytes(length * sizeof(Char)) / sizeof(Char);
+  string_type value;
+  while (value.size() < length) {
+    std::size_t done = value.size();
+    std::size_t part = static_cast<std::size_t>(length) - done;
+    if (part > step) {
+      part = step;
+    }
+    value.resize(done + part);
+    reader.read(&value[done], part * sizeof(Char));
+  }
+  return value;
+}
+
+/**
+ * @brief Returns the encoded size of a pair.
+ *
+ * @param value The pair.
+ *
+ * @return std::uint64_t Size in bytes.
+ *
+ * @throws N/A
+ */
+template <typename First, typename Second>
+std::uint64_t SnapshotTraits<std::pair<First, Second>>::size(
+    const std::pair<First, Second> &value) noexcept {
+  return first_traits::size(value.first) + second_traits::size(value.second);
+}
+
+/**
+ * @brief Writes the first member of a pair and then the second one.
+ *
+ * @param writer Destination.
+ * @param value The pair.
+ *
+ * @throws std::system_error if the descriptor cannot be written.
+ */
+template <typename First, typename Second>
+void SnapshotTraits<std::pair<First, Second>>::write(
+    SnapshotWriter &writer, const std::pair<First, Second> &value) {
+  first_traits::write(writer, value.first);
+  second_traits::write(writer, value.second);
+}
+
+/**
+ * @brief Reads a pair written by write().
+ *
+ * @param reader Source.
+ *
+ * @return decoded_type The pair with a non-const first member.
+ *
+ * @throws std::runtime_error if the snapshot ends too early.
+ */
+template <typename First, typename Second>
+typename SnapshotTraits<std::pair<First, Second>>::decoded_type
+SnapshotTraits<std::pair<First, Second>>::read(SnapshotReader &reader) {
+  auto first = first_traits::read(reader); // порядок чтения важен
+  return decoded_type(std::move(first), second_traits::read(reader));
+}
+
+/******************************************************************************
+ * WRITER
+ ******************************************************************************/
+
+/**
+ * @brief Creates a writer for an open file descriptor.
+ *
+ * @param fd Descriptor open for writing; it is not closed by the writer.
+ *
+ * @throws std::bad_alloc
+ */
+inline SnapshotWriter::SnapshotWriter(int fd)
+    : fd_(fd), buffer_(new char[kBufferSize]) {}
+
+/**
+ * @brief Appends bytes to the snapshot.
+ *
+ * @param data Bytes to write.
+ * @param bytes Number of bytes.
+ *
+ * @throws std::system_error if the descriptor cannot be written.
+ */
+inline void SnapshotWriter::write(const void *data, std::size_t bytes) {
+  const char *from = static_cast<const char *>(data);
+  if (bytes >= kBufferSize) {
+    flush(); // большой блок пишется напрямую, без копии в буфер
+    writeAll(from, bytes);
+    return;
+  }
+  if (used_ + bytes > kBufferSize) {
+    flush();
+  }
+  std::memcpy(buffer_.get() + used_, from, bytes);
+  used_ += bytes;
+}
+
+/**
+ * @brief Writes the buffered bytes to the descriptor.
+ *
+ * @throws std::system_error if the descriptor cannot be written.
+ */
+inline void SnapshotWriter::flush() {
+  std::size_t used = used_;
+  used_ = 0;
+  writeAll(buffer_.get(), used);
+}
+
+/**
+ * @brief Writes all bytes, retrying short writes and interrupted calls.
+ *
+ * @param data Bytes to write.
+ * @param bytes Number of bytes.
+ *
+ * @throws std::system_error if write() fails.
+ */
+inline void SnapshotWriter::writeAll(const char *data, std::size_t bytes) {
+  while (bytes > 0) {
+    ssize_t written = ::write(fd_, data, bytes);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::system_error(errno, std::generic_category(),
+                              "s21::snapshot: write");
+    }
+    data += written;
+    bytes -= static_cast<std::size_t>(written);
+  }
+}
+
+/******************************************************************************
+ * READER
+ ******************************************************************************/
+
+/**
+ * @brief Reads the header of a snapshot and checks that it was written by
+ * the same kind of container with the same element layout.
+ *
+ * @param fd Descriptor open for reading, positioned at the snapshot.
+ * @param kind Container that is loading the snapshot.
+ * @param key_size SnapshotTraits::kKeySize of the element type.
+ * @param value_size SnapshotTraits::kValueSize of the element type.
+ * @param min_size SnapshotTraits::kMinSize of the element type.
+ *
+ * @throws std::runtime_error if the header does not match or the payload
+ * is longer than the rest of a regular file, std::system_error if the
+ * descriptor cannot be read.
+ */
+inline SnapshotReader::SnapshotReader(int fd, SnapshotKind kind,
+                                      std::uint32_t key_size,
+                                      std::uint32_t value_size,
+                                      std::uint64_t min_size)
+    : fd_(fd), header_(), left_(sizeof(SnapshotHeader)),
+      buffer_(new char[kBufferSize]) {
+  readExact(reinterpret_cast<char *>(&header_), sizeof(header_));
+  if (std::memcmp(header_.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) !=
+      0) {
+    throw std::runtime_error("s21::snapshot: not a snapshot");
+  }
+  if (header_.byte_order != kSnapshotByteOrder) {
+    throw std::runtime_error("s21::snapshot: written with another byte order");
+  }
+  if (header_.version != kSnapshotVersion) {
+    throw std::runtime_error("s21::snapshot: unsupported version");
+  }
+  if (header_.kind != static_cast<std::uint32_t>(kind)) {
+    throw std::runtime_error("s21::snapshot: written by another container");
+  }
+  if (header_.key_size != key_size || header_.value_size != value_size) {
+    throw std::runtime_error("s21::snapshot: element types do not match");
+  }
+  // каждый элемент занимает не меньше min_size байт: число элементов не
+  // может превышать payload / min_size
+  if (header_.count > header_.payload / min_size) {
+    throw std::runtime_error(
+        "s21::snapshot: element count does not match the data size");
+  }
+  left_ = header_.payload;
+
+  // обычный файл: payload должен уместиться в остаток файла, иначе count
+  // нельзя использовать для выделения памяти
+  struct stat st;
+  off_t position = -1;
+  if (::fstat(fd_, &st) == 0 && S_ISREG(st.st_mode)) {
+    position = ::lseek(fd_, 0, SEEK_CUR);
+  }
+  if (position >= 0) {
+    if (position > st.st_size ||
+        header_.payload > static_cast<std::uint64_t>(st.st_size - position)) {
+      throw std::runtime_error("s21::snapshot: unexpected end of file");
+    }
+    reserve_ = count();
+    checked_ = true;
+  } else {
+    std::uint64_t buffered = kBufferSize / min_size;
+    reserve_ = static_cast<std::size_t>(
+        header_.count < buffered ? header_.count : buffered);
+  }
+}
+
+/**
+ * @brief Returns the number of elements in the snapshot.
+ *
+ * @return std::size_t Element count from the header.
+ *
+ * @throws N/A
+ */
+inline std::size_t SnapshotReader::count() const noexcept {
+  return static_cast<std::size_t>(header_.count);
+}
+
+/**
+ * @brief Returns how many elements may be allocated before reading them.
+ *
+ * @return std::size_t count() if the payload was checked against the size
+ * of the file, otherwise at most one buffer of elements.
+ *
+ * @throws N/A
+ */
+inline std::size_t SnapshotReader::reserveCount() const noexcept {
+  return reserve_;
+}
+
+/**
+ * @brief Returns how many bytes of one value may be allocated before
+ * reading them.
+ *
+ * @param bytes Size of the value claimed by the snapshot.
+ *
+ * @return std::size_t bytes if the payload was checked against the size of
+ * the file, otherwise at most one buffer.
+ *
+ * @throws N/A
+ */
+inline std::size_t SnapshotReader::reserveBytes(
+    std::uint64_t bytes) const noexcept {
+  if (!checked_ && bytes > kBufferSize) {
+    bytes = kBufferSize;
+  }
+  return static_cast<std::size_t>(bytes);
+}
+
+/**
+ * @brief Returns the number of payload bytes that are not read yet.
+ *
+ * @return std::uint64_t Buffered bytes plus the bytes left in the
+ * descriptor.
+ *
+ * @throws N/A
+ */
+inline std::uint64_t SnapshotReader::remaining() const noexcept {
+  return left_ + (end_ - begin_);
+}
+
+/**
+ * @brief Reads the next bytes of the payload.
+ *
+ * @param data Destination.
+ * @param bytes Number of bytes.
+ *
+ * @throws std::runtime_error if the payload ends before bytes are read,
+ * std::system_error if the descriptor cannot be read.
+ */
+inline void SnapshotReader::read(void *data, std::size_t bytes) {
+  if (bytes == 0) {
+    return;
+  }
+  char *to = static_cast<char *>(data);
+  std::size_t buffered = end_ - begin_;
+  if (bytes <= buffered) {
+    std::memcpy(to, buffer_.get() + begin_, bytes);
+    begin_ += bytes;
+    return;
+  }
+
+  std::memcpy(to, buffer_.get() + begin_, buffered);
+  to += buffered;
+  bytes -= buffered;
+  begin_ = end_ = 0;
+  if (bytes >= kBufferSize) {
+    readExact(to, bytes); // большой блок читается сразу на место
+    return;
+  }
+  while (end_ < bytes) {
+    end_ += readSome(buffer_.get() + end_, kBufferSize - end_);
+  }
+  std::memcpy(to, buffer_.get(), bytes);
+  begin_ = bytes;
+}
+
+/**
+ * @brief Checks that all elements used the whole payload.
+ *
+ * @throws std::runtime_error if some payload bytes were not read.
+ */
+inline void SnapshotReader::finish() const {
+  if (left_ != 0 || begin_ != end_) {
+    throw std::runtime_error("s21::snapshot: unexpected data after elements");
+  }
+}
+
+/**
+ * @brief Reads up to bytes bytes, but not past the payload.
+ *
+ * @param data Destination.
+ * @param bytes Space in the destination.
+ *
+ * @return std::size_t Number of bytes read, at least one.
+ *
+ * @throws std::runtime_error at the end of the payload or of the file,
+ * std::system_error if read() fails.
+ */
+inline std::size_t SnapshotReader::readSome(char *data, std::size_t bytes) {
+  if (bytes > left_) {
+    bytes = static_cast<std::size_t>(left_);
+  }
+  while (true) {
+    ssize_t got = bytes > 0 ? ::read(fd_, data, bytes) : 0;
+    if (got > 0) {
+      left_ -= static_cast<std::uint64_t>(got);
+      return static_cast<std::size_t>(got);
+    }
+    if (got == 0) {
+      throw std::runtime_error("s21::snapshot: unexpected end of file");
+    }
+    if (errno != EINTR) {
+      throw std::system_error(errno, std::generic_category(),
+                              "s21::snapshot: read");
+    }
+  }
+}
+
+/**
+ * @brief Reads exactly bytes bytes of the payload past the buffer.
+ *
+ * @param data Destination.
+ * @param bytes Number of bytes.
+ *
+ * @throws std::runtime_error at the end of the payload or of the file,
+ * std::system_error if read() fails.
+ */
+inline void SnapshotReader::readExact(char *data, std::size_t bytes) {
+  while (bytes > 0) {
+    std::size_t got = readSome(data, bytes);
+    data += got;
+    bytes -= got;
+  }
+}
+
+/******************************************************************************
+ * INPUT ITERATOR
+ ******************************************************************************/
+
+/**
+ * @brief Creates an iterator over count elements and decodes the first one.
+ *
+ * @param reader Reader positioned at the elements.
+ * @param count Number of elements to decode.
+ *
+ * @throws std::runtime_error if the snapshot ends too early.
+ */
+template <typename T>
+SnapshotInputIterator<T>::SnapshotInputIterator(SnapshotReader &reader,
+                                                std::size_t count)
+    : reader_(&reader), left_(count) {
+  if (left_ > 0) {
+    value_.emplace(traits::read(*reader_));
+  }
+}
+
+/**
+ * @brief Decodes the next element, if there is one.
+ *
+ * @return SnapshotInputIterator& This iterator.
+ *
+ * @throws std::runtime_error if the snapshot ends too early.
+ */
+template <typename T>
+SnapshotInputIterator<T> &SnapshotInputIterator<T>::operator++() {
+  if (left_ > 0 && --left_ > 0) {
+    value_.emplace(traits::read(*reader_));
+  }
+  return *this;
+}
+
+/******************************************************************************
+ * CONTAINERS
+ ******************************************************************************/
+
+// Блок тривиально копируемых элементов пишется и читается одним куском
+template <typename T>
+inline constexpr bool kSnapshotRawBlock =
+    std::is_trivially_copyable<T>::value &&
+    SnapshotTraits<T>::kSize == sizeof(T);
+
+/**
+ * @brief Writes a snapshot of count elements taken from a range.
+ *
+ * The payload size must be known before the elements, so elements of
+ * variable size are measured by a first pass over the range.
+ *
+ * @tparam T Element type.
+ * @param fd Descriptor open for writing.
+ * @param kind Container that writes the snapshot.
+ * @param first Beginning of the range (a forward iterator).
+ * @param count Number of elements.
+ *
+ * @throws std::system_error if the descriptor cannot be written.
+ */
+template <typename T, typename InputIt>
+void saveSnapshot(int fd, SnapshotKind kind, InputIt first,
+                  std::size_t count) {
+  using traits = SnapshotTraits<T>;
+  SnapshotHeader header{};
+  std::memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+  header.version = kSnapshotVersion;
+  header.byte_order = kSnapshotByteOrder;
+  header.kind = static_cast<std::uint32_t>(kind);
+  header.key_size = traits::kKeySize;
+  header.value_size = traits::kValueSize;
+  header.count = count;
+  if constexpr (traits::kSize != 0) {
+    header.payload = static_cast<std::uint64_t>(count) * traits::kSize;
+  } else {
+    InputIt it = first;
+    for (std::size_t i = 0; i < count; ++i, ++it) {
+      header.payload += traits::size(*it);
+    }
+  }
+
+  SnapshotWriter writer(fd);
+  writer.write(&header, sizeof(header));
+  for (std::size_t i = 0; i < count; ++i, ++first) {
+    traits::write(writer, *first);
+  }
+  writer.flush();
+}
+
+/**
+ * @brief Writes a snapshot of a contiguous array of elements.
+ *
+ * Trivially copyable elements are written by one write() of the whole
+ * array.
+ *
+ * @tparam T Element type.
+ * @param fd Descriptor open for writing.
+ * @param kind Container that writes the snapshot.
+ * @param data The elements.
+ * @param count Number of elements.
+ *
+ * @throws std::system_error if the descriptor cannot be written.
+ */
+template <typename T>
+void saveSnapshotBlock(int fd, SnapshotKind kind, const T *data,
+                       std::size_t count) {
+  if constexpr (kSnapshotRawBlock<T>) {
+    SnapshotHeader header{};
+    std::memcpy(header.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+    header.version = kSnapshotVersion;
+    header.byte_order = kSnapshotByteOrder;
+    header.kind = static_cast<std::uint32_t>(kind);
+    header.key_size = SnapshotTraits<T>::kKeySize;
+    header.count = count;
+    header.payload = static_cast<std::uint64_t>(count) * sizeof(T);
+
+    SnapshotWriter writer(fd);
+    writer.write(&header, sizeof(header));
+    writer.flush();
+    writer.write(data, count * sizeof(T));
+    writer.flush();
+  } else {
+    saveSnapshot<T, const T *>(fd, kind, data, count);
+  }
+}
+
+/**
+ * @brief Opens a snapshot of elements of type T written by kind.
+ *
+ * @tparam T Element type.
+ * @param fd Descriptor open for reading.
+ * @param kind Container that is loading the snapshot.
+ *
+ * @return SnapshotReader Reader positioned at the first element.
+ *
+ * @throws std::runtime_error if the header does not match,
+ * std::system_error if the descriptor cannot be read.
+ */
+template <typename T>
+SnapshotReader openSnapshot(int fd, SnapshotKind kind) {
+  using traits = SnapshotTraits<T>;
+  return SnapshotReader(fd, kind, traits::kKeySize, traits::kValueSize,
+                        traits::kMinSize);
+}
+
+/**
+ * @brief Reads count elements into constructed elements of an array.
+ *
+ * Trivially copyable elements are read by one read() straight into the
+ * array.
+ *
+ * @tparam T Element type.
+ * @param reader Reader positioned at the elements.
+ * @param data Destination, count constructed elements.
+ * @param count Number of elements.
+ *
+ * @throws std::runtime_error if the snapshot ends too early.
+ */
+template <typename T>
+void readSnapshotElements(SnapshotReader &reader, T *data, std::size_t count) {
+  if constexpr (kSnapshotRawBlock<T>) {
+    reader.read(data, count * sizeof(T));
+  } else {
+    for (std::size_t i = 0; i < count; ++i) {
+      data[i] = SnapshotTraits<T>::read(reader);
+    }
+  }
+}
+
+} // namespace s21
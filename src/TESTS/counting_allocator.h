@@ -0,0 +1,55 @@
+#ifndef COUNTING_ALLOCATOR_H_
+#define COUNTING_ALLOCATOR_H_
+
+#include <cstddef>
+#include <memory>
+
+namespace s21_test {
+
+// Счётчики, общие для всех копий и rebind-копий одного аллокатора
+struct AllocStats {
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  std::size_t live_bytes = 0;
+};
+
+// Аллокатор без конструктора по умолчанию: контейнер обязан
+// пользоваться именно переданным ему экземпляром
+template <typename T> class CountingAllocator {
+public:
+  using value_type = T;
+
+  explicit CountingAllocator(AllocStats *stats) noexcept : stats_(stats) {}
+
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U> &other) noexcept
+      : stats_(other.stats_) {}
+
+  T *allocate(std::size_t n) {
+    ++stats_->allocations;
+    stats_->live_bytes += n * sizeof(T);
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T *ptr, std::size_t n) noexcept {
+    ++stats_->deallocations;
+    stats_->live_bytes -= n * sizeof(T);
+    std::allocator<T>().deallocate(ptr, n);
+  }
+
+  friend bool operator==(const CountingAllocator &a,
+                         const CountingAllocator &b) noexcept {
+    return a.stats_ == b.stats_;
+  }
+
+  friend bool operator!=(const CountingAllocator &a,
+                         const CountingAllocator &b) noexcept {
+    return !(a == b);
+  }
+
+  AllocStats *stats_;
+};
+
+} // namespace s21_test
+
+#endif // COUNTING_ALLOCATOR_H_
@@ -0,0 +1,299 @@
+#include "test_runner.h"
+#include "counting_allocator.h"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(btree_set_test, constructors_and_order) {
+  s21::BTreeSet<int> set{5, 1, 4, 1, 3, 9, 2, 6, 5};
+  std::set<int> expected{5, 1, 4, 1, 3, 9, 2, 6, 5};
+  EXPECT_EQ(set.size(), expected.size());
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), expected.begin(),
+                         expected.end()));
+  EXPECT_TRUE(std::equal(set.rbegin(), set.rend(), expected.rbegin(),
+                         expected.rend()));
+
+  std::vector<int> source(1000);
+  for (int i = 0; i < 1000; ++i) source[i] = i;
+  s21::BTreeSet<int> range(source.begin(), source.end());
+  EXPECT_EQ(range.size(), 1000U);
+  EXPECT_TRUE(range.checkInvariants());
+  EXPECT_TRUE(std::equal(range.begin(), range.end(), source.begin()));
+
+  s21::BTreeSet<int> copy(range);
+  EXPECT_TRUE(copy.checkInvariants());
+  s21::BTreeSet<int> moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.size(), 1000U);
+  copy = moved;
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), moved.begin(),
+                         moved.end()));
+  set = std::move(moved);
+  EXPECT_EQ(set.size(), 1000U);
+  EXPECT_TRUE(moved.empty());
+}
+
+TEST(btree_set_test, random_operations_match_std_set) {
+  std::mt19937 rng(7);
+  s21::BTreeSet<int> set;
+  std::set<int> reference;
+  for (int i = 0; i < 60000; ++i) {
+    int key = static_cast<int>(rng() % 20000);
+    if (rng() % 3 != 0) {
+      ASSERT_EQ(set.insert(key).second, reference.insert(key).second);
+    } else {
+      ASSERT_EQ(set.erase(key), reference.erase(key));
+    }
+    if (i % 10000 == 0) {
+      ASSERT_TRUE(set.checkInvariants());
+    }
+  }
+  ASSERT_TRUE(set.checkInvariants());
+  ASSERT_EQ(set.size(), reference.size());
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), reference.begin(),
+                         reference.end()));
+  for (int key = -1; key <= 20000; key += 37) {
+    auto it = set.lower_bound(key);
+    auto expected = reference.lower_bound(key);
+    ASSERT_EQ(it == set.end(), expected == reference.end());
+    if (it != set.end()) {
+      EXPECT_EQ(*it, *expected);
+    }
+    auto upper = set.upper_bound(key);
+    auto expected_upper = reference.upper_bound(key);
+    ASSERT_EQ(upper == set.end(), expected_upper == reference.end());
+    if (upper != set.end()) {
+      EXPECT_EQ(*upper, *expected_upper);
+    }
+    EXPECT_EQ(set.contains(key), reference.count(key) == 1);
+  }
+}
+
+TEST(btree_set_test, descending_and_string_keys) {
+  // ключи double с std::greater ищутся векторным сравнением
+  s21::BTreeSet<double, std::greater<double>> descending;
+  for (int i = 0; i < 5000; ++i) descending.insert(i * 0.5);
+  EXPECT_TRUE(descending.checkInvariants());
+  EXPECT_EQ(*descending.begin(), 2499.5);
+  EXPECT_EQ(*descending.lower_bound(100.25), 100.0);
+  EXPECT_EQ(*descending.upper_bound(100.0), 99.5);
+  EXPECT_TRUE(descending.contains(1234.5));
+  EXPECT_FALSE(descending.contains(1234.25));
+
+  s21::BTreeSet<std::string> strings;
+  std::set<std::string> reference;
+  for (int i = 0; i < 3000; ++i) {
+    std::string key = "key-" + std::to_string(i * 7919 % 3001);
+    strings.insert(key);
+    reference.insert(key);
+  }
+  for (int i = 0; i < 3000; i += 2) {
+    std::string key = "key-" + std::to_string(i);
+    EXPECT_EQ(strings.erase(key), reference.erase(key));
+  }
+  EXPECT_TRUE(strings.checkInvariants());
+  EXPECT_TRUE(std::equal(strings.begin(), strings.end(), reference.begin(),
+                         reference.end()));
+}
+
+TEST(btree_set_test, erase_returns_next_and_erase_if) {
+  s21::BTreeSet<int> set;
+  for (int i = 0; i < 2000; ++i) set.insert(i);
+  auto it = set.erase(set.find(500));
+  EXPECT_EQ(*it, 501);
+  it = set.erase(set.find(100), set.find(1500));
+  EXPECT_EQ(*it, 1500);
+  EXPECT_EQ(set.size(), 600U);
+  EXPECT_TRUE(set.checkInvariants());
+  EXPECT_EQ(s21::erase_if(set, [](int key) { return key % 2 == 0; }), 300U);
+  EXPECT_TRUE(set.checkInvariants());
+  for (int key : set) EXPECT_EQ(key % 2, 1);
+  while (!set.empty()) set.erase(set.begin());
+  EXPECT_TRUE(set.checkInvariants());
+  EXPECT_EQ(set.begin(), set.end());
+}
+
+TEST(btree_set_test, hints_merge_and_insert_many) {
+  s21::BTreeSet<int> set;
+  for (int i = 0; i < 1000; ++i) set.insert(set.end(), i);
+  EXPECT_TRUE(set.checkInvariants());
+  auto it = set.insert(set.find(10), 10);
+  EXPECT_EQ(*it, 10);
+  EXPECT_EQ(set.size(), 1000U);
+  it = set.emplace_hint(set.begin(), 2000); // неверная подсказка
+  EXPECT_EQ(*it, 2000);
+  EXPECT_TRUE(set.checkInvariants());
+
+  s21::BTreeSet<int> other{1, 5000, 6000};
+  set.merge(other);
+  EXPECT_EQ(set.size(), 1003U);
+  EXPECT_EQ(other.size(), 1U);
+  EXPECT_EQ(*other.begin(), 1);
+
+  std::vector<bool> inserted = set.insert_many(-1, 1, -2);
+  EXPECT_EQ(inserted, (std::vector<bool>{true, false, true}));
+  EXPECT_EQ(*set.begin(), -2);
+}
+
+TEST(btree_set_test, uses_given_allocator) {
+  s21_test::AllocStats stats;
+  {
+    s21_test::CountingAllocator<int> alloc(&stats);
+    s21::BTreeSet<int, std::less<int>, s21_test::CountingAllocator<int>> set(
+        alloc);
+    for (int i = 0; i < 10000; ++i) set.insert(i);
+    EXPECT_GT(stats.allocations, 0U);
+    EXPECT_EQ(stats.live_bytes, set.memory_usage());
+    // последовательная вставка заполняет листья почти целиком
+    EXPECT_LT(set.memory_usage(), 10000U * sizeof(int) * 3 / 2);
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+namespace {
+
+// Ключ, копирование которого можно заставить бросить исключение
+struct FragileKey {
+  static inline bool fail = false;
+  int value;
+
+  FragileKey(int v) : value(v) {}
+  FragileKey(const FragileKey &other) : value(other.value) {
+    if (fail) throw std::runtime_error("copy");
+  }
+  FragileKey(FragileKey &&other) noexcept : value(other.value) {}
+  FragileKey &operator=(const FragileKey &) = default;
+  FragileKey &operator=(FragileKey &&) noexcept = default;
+  bool operator<(const FragileKey &other) const {
+    return value < other.value;
+  }
+};
+
+} // namespace
+
+TEST(btree_set_test, throwing_copy_leaves_valid_tree) {
+  s21::BTreeSet<FragileKey> set;
+  FragileKey::fail = true;
+  FragileKey first(0);
+  EXPECT_THROW(set.insert(first), std::runtime_error);
+  EXPECT_TRUE(set.empty());
+  EXPECT_TRUE(set.checkInvariants());
+  FragileKey::fail = false;
+  for (int i = 0; i < 3000; ++i) set.insert(FragileKey(i));
+
+  FragileKey::fail = true;
+  for (int i = 3000; i < 3100; ++i) {
+    FragileKey key(i);
+    EXPECT_THROW(set.insert(key), std::runtime_error);
+  }
+  for (int i = 0; i < 3000; i += 3) set.erase(FragileKey(i)); // ключ - rvalue
+  FragileKey::fail = false;
+  EXPECT_TRUE(set.checkInvariants());
+  EXPECT_EQ(set.size(), 2000U);
+}
+
+TEST(btree_multiset_test, keeps_duplicates_in_insertion_order) {
+  std::mt19937 rng(11);
+  s21::BTreeMultiSet<int> multiset;
+  std::multiset<int> reference;
+  for (int i = 0; i < 40000; ++i) {
+    int key = static_cast<int>(rng() % 300);
+    if (rng() % 4 != 0) {
+      multiset.insert(key);
+      reference.insert(key);
+    } else {
+      auto it = multiset.find(key);
+      auto expected = reference.find(key);
+      ASSERT_EQ(it == multiset.end(), expected == reference.end());
+      if (it != multiset.end()) {
+        multiset.erase(it);
+        reference.erase(expected);
+      }
+    }
+  }
+  ASSERT_TRUE(multiset.checkInvariants());
+  EXPECT_TRUE(std::equal(multiset.begin(), multiset.end(), reference.begin(),
+                         reference.end()));
+  for (int key = 0; key < 300; ++key) {
+    ASSERT_EQ(multiset.count(key), reference.count(key));
+    auto range = multiset.equal_range(key);
+    EXPECT_EQ(static_cast<size_t>(std::distance(range.first, range.second)),
+              reference.count(key));
+  }
+  EXPECT_EQ(multiset.erase(7), reference.erase(7));
+  EXPECT_EQ(multiset.count(7), 0U);
+  EXPECT_TRUE(multiset.checkInvariants());
+
+  s21::BTreeMultiSet<int> other{7, 7, 7};
+  multiset.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(multiset.count(7), 3U);
+  multiset.insert_many(7, 8);
+  EXPECT_EQ(multiset.count(7), 4U);
+}
+
+TEST(btree_map_test, element_access_and_insertion) {
+  s21::BTreeMap<int, std::string> map{{3, "c"}, {1, "a"}, {2, "b"}};
+  EXPECT_EQ(map.at(2), "b");
+  EXPECT_THROW(map.at(4), std::out_of_range);
+  const auto &const_map = map;
+  EXPECT_EQ(const_map.at(3), "c");
+  map[4] = "d";
+  EXPECT_EQ(map.size(), 4U);
+  EXPECT_EQ(map[4], "d");
+
+  EXPECT_FALSE(map.insert(1, "z").second);
+  EXPECT_EQ(map.at(1), "a");
+  auto result = map.insert_or_assign(1, "z");
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(result.first->second, "z");
+  result = map.try_emplace(5, 3, 'e');
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(map.at(5), "eee");
+  EXPECT_FALSE(map.try_emplace(5, "x").second);
+  EXPECT_EQ(map.at(5), "eee");
+  EXPECT_EQ(map.insert_many(std::make_pair(6, std::string("f")),
+                            std::make_pair(1, std::string("q"))),
+            (std::vector<bool>{true, false}));
+  auto emplaced = map.emplace(7, "g");
+  EXPECT_TRUE(emplaced.second);
+  EXPECT_EQ(map.begin()->first, 1);
+  EXPECT_EQ(map.rbegin()->first, 7);
+}
+
+TEST(btree_map_test, random_operations_match_std_map) {
+  std::mt19937 rng(3);
+  s21::BTreeMap<int, int> map;
+  std::map<int, int> reference;
+  for (int i = 0; i < 50000; ++i) {
+    int key = static_cast<int>(rng() % 10000);
+    switch (rng() % 4) {
+    case 0:
+      ASSERT_EQ(map.erase(key), reference.erase(key));
+      break;
+    case 1:
+      map[key] += i;
+      reference[key] += i;
+      break;
+    default:
+      ASSERT_EQ(map.insert({key, i}).second,
+                reference.insert({key, i}).second);
+    }
+  }
+  ASSERT_TRUE(map.checkInvariants());
+  ASSERT_EQ(map.size(), reference.size());
+  EXPECT_TRUE(std::equal(map.begin(), map.end(), reference.begin(),
+                         reference.end()));
+  EXPECT_EQ(s21::erase_if(map,
+                          [](const auto &item) { return item.second % 2; }),
+            static_cast<size_t>(std::count_if(
+                reference.begin(), reference.end(),
+                [](const auto &item) { return item.second % 2; })));
+  EXPECT_TRUE(map.checkInvariants());
+  for (const auto &item : map) EXPECT_EQ(item.second % 2, 0);
+}
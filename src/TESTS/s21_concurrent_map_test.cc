@@ -0,0 +1,173 @@
+#include "test_runner.h"
+#include "test_helpers.h"
+#include "counting_allocator.h"
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(concurrent_map_test, single_thread_semantics) {
+  s21::ConcurrentMap<int, std::string, 4> map{{1, "one"}, {2, "two"}};
+  EXPECT_EQ(map.shard_count(), 4U);
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_FALSE(map.insert({1, "uno"}));
+  EXPECT_EQ(*map.find(1), "one");
+  EXPECT_TRUE(map.insert(3, "three"));
+  EXPECT_FALSE(map.insert_or_assign(3, "drei"));
+  EXPECT_EQ(*map.find(3), "drei");
+  EXPECT_TRUE(map.insert_or_assign(4, std::string("four")));
+  EXPECT_TRUE(map.try_emplace(5, 3, 'x'));
+  EXPECT_FALSE(map.try_emplace(5, "unused"));
+  EXPECT_EQ(*map.find(5), "xxx");
+  EXPECT_FALSE(map.find(6).has_value());
+  EXPECT_TRUE(map.contains(4));
+  EXPECT_FALSE(map.contains(6));
+
+  std::size_t length = 0;
+  EXPECT_TRUE(map.visit(2, [&](const std::string &s) { length = s.size(); }));
+  EXPECT_EQ(length, 3U);
+  EXPECT_FALSE(map.visit(6, [&](const std::string &) { length = 0; }));
+  EXPECT_TRUE(map.modify(2, [](std::string &s) { s += "!"; }));
+  EXPECT_FALSE(map.modify(6, [](std::string &s) { s.clear(); }));
+  EXPECT_EQ(*map.find(2), "two!");
+
+  EXPECT_EQ(map.erase(4), 1U);
+  EXPECT_EQ(map.erase(4), 0U);
+  s21::Map<int, std::string> copy = map.to_map();
+  EXPECT_EQ(copy.size(), 4U);
+  EXPECT_EQ(copy.at(1), "one");
+  EXPECT_EQ(copy.at(5), "xxx");
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0U);
+}
+
+TEST(concurrent_map_test, to_map_uses_shard_allocator) {
+  using Alloc = s21_test::CountingAllocator<std::pair<const int, int>>;
+  s21_test::AllocStats stats;
+  {
+    s21::ConcurrentMap<int, int, 4, std::hash<int>, std::less<int>, Alloc>
+        map{Alloc(&stats)};
+    for (int i = 0; i < 100; ++i) map.insert(i, -i);
+    std::size_t live = stats.live_bytes;
+    auto copy = map.to_map();
+    EXPECT_TRUE(copy.get_allocator() == Alloc(&stats));
+    EXPECT_GT(stats.live_bytes, live); // узлы копии - из того же аллокатора
+    EXPECT_EQ(copy.size(), 100U);
+    EXPECT_EQ(copy.at(42), -42);
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(concurrent_map_test, keys_spread_over_shards) {
+  // ключи с общим шагом не должны собираться в нескольких шардах
+  s21::ConcurrentMap<int, int, 16> map;
+  for (int i = 0; i < 1600; ++i) {
+    map.insert(i * 16, i);
+  }
+  EXPECT_EQ(map.to_map().size(), 1600U);
+  // внутри шарда ключи упорядочены: каждый спад в обходе - переход к
+  // следующему непустому шарду
+  int previous = -1;
+  int descents = 0;
+  map.for_each([&](const int &key, const int &) {
+    descents += key < previous;
+    previous = key;
+  });
+  EXPECT_GE(descents, 8);
+  s21::ConcurrentMap<int, int, 1> single;
+  EXPECT_TRUE(single.insert(7, 7));
+  EXPECT_EQ(*single.find(7), 7);
+}
+
+TEST(concurrent_map_test, parallel_disjoint_inserts_and_erases) {
+  s21::ConcurrentMap<int, int> map;
+  const unsigned threads = s21_test::testThreads(4);
+  const int per_thread = 5000;
+  s21_test::runThreads(threads, [&](unsigned t) {
+    for (int i = 0; i < per_thread; ++i) {
+      int key = static_cast<int>(t) * per_thread + i;
+      EXPECT_TRUE(map.insert(key, key * 2));
+    }
+  });
+  EXPECT_EQ(map.size(), threads * per_thread);
+  for (int key = 0; key < static_cast<int>(threads) * per_thread; ++key) {
+    ASSERT_EQ(map.find(key).value_or(-1), key * 2);
+  }
+
+  // каждый поток удаляет свои нечётные ключи и читает чужие чётные
+  s21_test::runThreads(threads, [&](unsigned t) {
+    for (int i = 1; i < per_thread; i += 2) {
+      EXPECT_EQ(map.erase(static_cast<int>(t) * per_thread + i), 1U);
+      int other = static_cast<int>((t + 1) % threads) * per_thread + i - 1;
+      EXPECT_TRUE(map.contains(other));
+    }
+  });
+  EXPECT_EQ(map.size(), threads * per_thread / 2);
+  long long sum = 0;
+  map.for_each([&](const int &key, const int &value) {
+    EXPECT_EQ(key % 2, 0);
+    sum += value;
+  });
+  long long expected = 0;
+  for (int key = 0; key < static_cast<int>(threads) * per_thread; key += 2) {
+    expected += key * 2;
+  }
+  EXPECT_EQ(sum, expected);
+}
+
+TEST(concurrent_map_test, concurrent_updates_of_shared_keys) {
+  s21::ConcurrentMap<int, long long, 8> map;
+  const unsigned threads = s21_test::testThreads(4);
+  const int keys = 64;
+  const int rounds = 2000;
+  std::atomic<int> inserted{0};
+  s21_test::runThreads(threads, [&](unsigned) {
+    for (int r = 0; r < rounds; ++r) {
+      int key = r % keys;
+      // вставляет ровно один поток, остальные увеличивают счётчик
+      if (map.try_emplace(key, 1LL)) {
+        ++inserted;
+      } else {
+        EXPECT_TRUE(map.modify(key, [](long long &count) { ++count; }));
+      }
+      map.visit(key, [](const long long &count) { EXPECT_GT(count, 0); });
+    }
+  });
+  EXPECT_EQ(inserted.load(), keys);
+  long long total = 0;
+  map.for_each([&](const int &, const long long &count) { total += count; });
+  EXPECT_EQ(total, static_cast<long long>(threads) * rounds);
+}
+
+TEST(concurrent_map_test, readers_see_whole_values_during_writes) {
+  // писатели заменяют строку целиком: читатель видит либо старую, либо новую
+  s21::ConcurrentMap<int, std::string, 2> map;
+  for (int key = 0; key < 16; ++key) {
+    map.insert(key, std::string(32, 'a'));
+  }
+  std::atomic<bool> stop{false};
+  std::thread writer([&] {
+    for (int r = 0; r < 20000; ++r) {
+      char c = static_cast<char>('a' + r % 26);
+      map.insert_or_assign(r % 16, std::string(32 + r % 7, c));
+    }
+    stop = true;
+  });
+  std::thread reader([&] {
+    while (!stop) {
+      for (int key = 0; key < 16; ++key) {
+        std::string value = map.find(key).value();
+        ASSERT_GE(value.size(), 32U);
+        EXPECT_EQ(std::count(value.begin(), value.end(), value[0]),
+                  static_cast<long>(value.size()));
+      }
+    }
+  });
+  writer.join();
+  reader.join();
+  EXPECT_EQ(map.size(), 16U);
+}
@@ -0,0 +1,350 @@
+#include "test_runner.h"
+#include "counting_allocator.h"
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+TEST(flat_set_test, constructors_and_order) {
+  s21::FlatSet<int> set{5, 1, 4, 1, 3, 9, 2, 6, 5};
+  std::set<int> expected{5, 1, 4, 1, 3, 9, 2, 6, 5};
+  EXPECT_EQ(set.size(), expected.size());
+  EXPECT_TRUE(set.checkInvariants());
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), expected.begin(),
+                         expected.end()));
+  EXPECT_TRUE(std::equal(set.rbegin(), set.rend(), expected.rbegin(),
+                         expected.rend()));
+
+  std::vector<int> source(1000);
+  for (int i = 0; i < 1000; ++i) source[i] = i;
+  s21::FlatSet<int> sorted(s21::sorted_unique, source.begin(), source.end());
+  EXPECT_EQ(sorted.size(), 1000U);
+  EXPECT_TRUE(std::equal(sorted.begin(), sorted.end(), source.begin()));
+
+  // однопроходный итератор: элементы читаются один раз
+  std::istringstream stream("7 3 7 1");
+  s21::FlatSet<int> streamed{std::istream_iterator<int>(stream),
+                             std::istream_iterator<int>()};
+  EXPECT_EQ(streamed.size(), 3U);
+  EXPECT_EQ(*streamed.begin(), 1);
+
+  s21::FlatSet<int> copy(sorted);
+  s21::FlatSet<int> moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.size(), 1000U);
+  copy = moved;
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), moved.begin(),
+                         moved.end()));
+  set = std::move(moved);
+  EXPECT_EQ(set.size(), 1000U);
+}
+
+TEST(flat_set_test, random_operations_match_std_set) {
+  std::mt19937 rng(11);
+  s21::FlatSet<int> set;
+  std::set<int> reference;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(rng() % 5000);
+    if (rng() % 3 != 0) {
+      ASSERT_EQ(set.insert(key).second, reference.insert(key).second);
+    } else {
+      ASSERT_EQ(set.erase(key), reference.erase(key));
+    }
+  }
+  ASSERT_TRUE(set.checkInvariants());
+  ASSERT_EQ(set.size(), reference.size());
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), reference.begin(),
+                         reference.end()));
+  for (int key = -1; key <= 5000; key += 13) {
+    auto it = set.lower_bound(key);
+    auto expected = reference.lower_bound(key);
+    ASSERT_EQ(it == set.end(), expected == reference.end());
+    if (it != set.end()) {
+      EXPECT_EQ(*it, *expected);
+    }
+    auto upper = set.upper_bound(key);
+    EXPECT_EQ(upper - set.begin(),
+              std::distance(reference.begin(), reference.upper_bound(key)));
+    EXPECT_EQ(set.contains(key), reference.count(key) == 1);
+    EXPECT_EQ(set.rank(key), static_cast<std::size_t>(std::distance(
+                                 reference.begin(), expected)));
+  }
+}
+
+TEST(flat_set_test, bulk_insert_sorts_and_merges_once) {
+  s21::FlatSet<int> set{10, 20, 30};
+  std::vector<int> batch{25, 5, 20, 5, 35, 15};
+  set.insert(batch.begin(), batch.end());
+  std::vector<int> expected{5, 10, 15, 20, 25, 30, 35};
+  EXPECT_TRUE(set.checkInvariants());
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), expected.begin(),
+                         expected.end()));
+
+  // отсортированный хвост после старых ключей не сливается заново
+  std::vector<int> tail{40, 50, 60};
+  set.insert(tail.begin(), tail.end());
+  EXPECT_EQ(set.size(), 10U);
+  EXPECT_EQ(*set.rbegin(), 60);
+
+  std::mt19937 rng(3);
+  std::vector<int> random(50000);
+  for (int &key : random) key = static_cast<int>(rng() % 100000);
+  s21::FlatSet<int> big;
+  big.insert(random.begin(), random.begin() + 25000);
+  big.insert(random.begin() + 25000, random.end());
+  std::set<int> reference(random.begin(), random.end());
+  EXPECT_TRUE(big.checkInvariants());
+  EXPECT_TRUE(std::equal(big.begin(), big.end(), reference.begin(),
+                         reference.end()));
+}
+
+TEST(flat_set_test, hints_erase_and_order_statistics) {
+  s21::FlatSet<int> set;
+  for (int i = 0; i < 100; ++i) set.insert(set.end(), i * 2);
+  EXPECT_EQ(*set.insert(set.find(10), 9), 9);
+  EXPECT_EQ(*set.insert(set.begin(), 51), 51); // неверная подсказка
+  EXPECT_EQ(*set.emplace_hint(set.end(), 20), 20);
+  EXPECT_EQ(set.size(), 102U);
+  EXPECT_TRUE(set.checkInvariants());
+
+  EXPECT_EQ(set.select(0), 0);
+  EXPECT_EQ(*set.nth(5), 9);
+  EXPECT_EQ(set.nth(1000), set.end());
+  EXPECT_THROW(set.select(1000), std::out_of_range);
+  EXPECT_EQ(set.count_range(10, 20), 5U);
+  EXPECT_EQ(set.count_range(20, 10), 0U);
+
+  auto next = set.erase(set.find(9));
+  EXPECT_EQ(*next, 10);
+  next = set.erase(set.lower_bound(100), set.end());
+  EXPECT_EQ(next, set.end());
+  EXPECT_EQ(set.size(), 51U);
+  EXPECT_EQ(s21::erase_if(set, [](int key) { return key % 4 == 0; }), 25U);
+  EXPECT_TRUE(set.checkInvariants());
+  EXPECT_EQ(set.insert_many(2, 3, 2), (std::vector<bool>{false, true, false}));
+}
+
+TEST(flat_set_test, merge_keeps_duplicates_in_source) {
+  s21::FlatSet<int> left{1, 3, 5, 7};
+  s21::FlatSet<int> right{0, 3, 4, 7, 9};
+  left.merge(right);
+  std::vector<int> merged{0, 1, 3, 4, 5, 7, 9};
+  std::vector<int> rest{3, 7};
+  EXPECT_TRUE(std::equal(left.begin(), left.end(), merged.begin(),
+                         merged.end()));
+  EXPECT_TRUE(std::equal(right.begin(), right.end(), rest.begin(),
+                         rest.end()));
+  left.merge(left);
+  EXPECT_EQ(left.size(), 7U);
+}
+
+TEST(flat_set_test, conversion_to_and_from_set) {
+  s21::Set<std::string> tree{"pear", "apple", "plum", "fig"};
+  s21::FlatSet<std::string> flat(tree);
+  EXPECT_EQ(flat.size(), 4U);
+  EXPECT_TRUE(std::equal(flat.begin(), flat.end(), tree.begin(), tree.end()));
+  flat.insert("kiwi");
+  s21::Set<std::string> back = flat.to_set();
+  EXPECT_EQ(back.size(), 5U);
+  EXPECT_TRUE(std::equal(back.begin(), back.end(), flat.begin(), flat.end()));
+  EXPECT_TRUE(back.contains("kiwi"));
+}
+
+TEST(flat_set_test, memory_is_the_key_array_only) {
+  s21_test::AllocStats stats;
+  {
+    s21::FlatSet<long, std::less<long>, s21_test::CountingAllocator<long>> set{
+        s21_test::CountingAllocator<long>(&stats)};
+    std::vector<long> keys(1000);
+    for (long i = 0; i < 1000; ++i) keys[i] = 999 - i;
+    set.insert(keys.begin(), keys.end());
+    EXPECT_EQ(stats.live_bytes, set.capacity() * sizeof(long));
+    EXPECT_EQ(set.memory_usage(), stats.live_bytes);
+    set.erase(set.begin(), set.begin() + 500);
+    set.shrink_to_fit();
+    EXPECT_EQ(stats.live_bytes, 500 * sizeof(long));
+    set.shrink_to_fit(); // сжимать нечего
+    set.clear();
+    set.shrink_to_fit();
+    EXPECT_EQ(stats.live_bytes, 0U);
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+}
+
+TEST(flat_multiset_test, equivalent_keys_and_conversion) {
+  s21::FlatMultiSet<int> set{3, 1, 3, 2, 3};
+  EXPECT_EQ(set.count(3), 3U);
+  EXPECT_EQ(set.count(4), 0U);
+  auto it = set.insert(3);
+  EXPECT_EQ(it - set.begin(), 5); // после равных
+  std::vector<int> batch{0, 3, 2};
+  set.insert(batch.begin(), batch.end());
+  EXPECT_EQ(set.size(), 9U);
+  EXPECT_TRUE(set.checkInvariants());
+  auto range = set.equal_range(3);
+  EXPECT_EQ(range.second - range.first, 5);
+  EXPECT_EQ(set.rank(3), 4U);
+  EXPECT_EQ(set.count_range(2, 4), 7U);
+
+  s21::FlatMultiSet<int> other{1, 1, 9};
+  set.merge(other);
+  EXPECT_TRUE(other.empty());
+  EXPECT_EQ(set.size(), 12U);
+  EXPECT_EQ(set.erase(3), 5U);
+  EXPECT_TRUE(set.checkInvariants());
+
+  s21::MultiSet<int> tree = set.to_multiset();
+  EXPECT_EQ(tree.size(), set.size());
+  EXPECT_TRUE(std::equal(tree.begin(), tree.end(), set.begin(), set.end()));
+  s21::FlatMultiSet<int> back(tree);
+  EXPECT_TRUE(std::equal(back.begin(), back.end(), set.begin(), set.end()));
+}
+
+TEST(flat_map_test, element_access_and_modifiers) {
+  s21::FlatMap<std::string, int> map{{"b", 2}, {"a", 1}, {"b", 20}};
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_EQ(map.at("b"), 2); // остаётся первая пара с ключом
+  EXPECT_THROW(map.at("z"), std::out_of_range);
+  map["c"] = 3;
+  EXPECT_EQ(map["c"], 3);
+  EXPECT_FALSE(map.insert("a", 100).second);
+  EXPECT_FALSE(map.insert_or_assign("a", 10).second);
+  EXPECT_EQ(map.at("a"), 10);
+  EXPECT_TRUE(map.try_emplace("d", 4).second);
+  EXPECT_EQ(map.insert_many(std::make_pair(std::string("e"), 5),
+                            std::make_pair(std::string("a"), 0)),
+            (std::vector<bool>{true, false}));
+
+  std::vector<std::pair<std::string, int>> batch{{"h", 8}, {"f", 6}, {"a", 0}};
+  map.insert(batch.begin(), batch.end());
+  EXPECT_EQ(map.size(), 7U);
+  EXPECT_TRUE(map.checkInvariants());
+  EXPECT_EQ(map.select(5).first, "f");
+  EXPECT_EQ(map.nth(6)->second, 8);
+  EXPECT_EQ(map.rank("c"), 2U);
+  EXPECT_EQ(map.count_range("b", "e"), 3U);
+  map.nth(0)->second = -1; // значение меняется через итератор
+  EXPECT_EQ(map.at("a"), -1);
+
+  EXPECT_EQ(s21::erase_if(map,
+                          [](const std::pair<std::string, int> &item) {
+                            return item.second % 2 == 0;
+                          }),
+            4U);
+  EXPECT_EQ(map.size(), 3U);
+  EXPECT_TRUE(map.contains("c"));
+}
+
+TEST(flat_map_test, random_operations_match_std_map) {
+  std::mt19937 rng(5);
+  s21::FlatMap<int, int> map;
+  std::map<int, int> reference;
+  for (int i = 0; i < 20000; ++i) {
+    int key = static_cast<int>(rng() % 3000);
+    switch (rng() % 3) {
+    case 0:
+      ASSERT_EQ(map.insert({key, i}).second,
+                reference.insert({key, i}).second);
+      break;
+    case 1:
+      map[key] += i;
+      reference[key] += i;
+      break;
+    default:
+      ASSERT_EQ(map.erase(key), reference.erase(key));
+    }
+  }
+  ASSERT_TRUE(map.checkInvariants());
+  ASSERT_EQ(map.size(), reference.size());
+  EXPECT_TRUE(std::equal(
+      map.begin(), map.end(), reference.begin(), reference.end(),
+      [](const std::pair<int, int> &a, const std::pair<const int, int> &b) {
+        return a.first == b.first && a.second == b.second;
+      }));
+}
+
+TEST(flat_map_test, conversion_to_and_from_map) {
+  s21::Map<int, std::string> tree{{2, "two"}, {1, "one"}, {3, "three"}};
+  s21::FlatMap<int, std::string> flat(tree);
+  EXPECT_EQ(flat.size(), 3U);
+  EXPECT_EQ(flat.begin()->second, "one");
+  flat[0] = "zero";
+  s21::Map<int, std::string> back = flat.to_map();
+  EXPECT_EQ(back.size(), 4U);
+  EXPECT_EQ(back.at(0), "zero");
+  EXPECT_EQ(back.begin()->first, 0);
+
+  s21::FlatMap<int, std::string> other{{0, "nil"}, {7, "seven"}};
+  flat.merge(other);
+  EXPECT_EQ(flat.size(), 5U);
+  EXPECT_EQ(other.size(), 1U);
+  EXPECT_EQ(other.begin()->second, "nil");
+  EXPECT_EQ(flat.at(0), "zero");
+}
+
+TEST(flat_map_test, iterators_keep_keys_constant) {
+  using Map = s21::FlatMap<int, std::string>;
+  using ArrowKey = decltype((std::declval<Map::iterator>()->first));
+  using StarKey = decltype(((*std::declval<Map::iterator>()).first));
+  static_assert(!std::is_assignable<ArrowKey, int>::value,
+                "the key must not be assignable through an iterator");
+  static_assert(!std::is_assignable<StarKey, int>::value,
+                "the key must not be assignable through a reference");
+
+  Map map{{3, "three"}, {1, "one"}, {2, "two"}};
+  map.begin()->second = "uno";
+  (*(map.begin() + 1)).second += "!";
+  map.begin()[2].second = "drei";
+  EXPECT_EQ(map.at(1), "uno");
+  EXPECT_EQ(map.at(2), "two!");
+  EXPECT_EQ(map.at(3), "drei");
+  EXPECT_TRUE(map.checkInvariants());
+
+  Map::const_iterator first = map.begin();
+  EXPECT_TRUE(first == map.begin());
+  EXPECT_TRUE(map.end() != first);
+  EXPECT_TRUE(first < map.end());
+  EXPECT_EQ(map.end() - first, 3);
+  EXPECT_EQ(std::distance(map.begin(), map.end()), 3);
+  EXPECT_EQ(map.rbegin()->first, 3);
+  EXPECT_EQ((++map.rbegin())->second, "two!");
+
+  std::vector<int> keys;
+  for (const auto &item : map) keys.push_back(item.first);
+  EXPECT_EQ(keys, (std::vector<int>{1, 2, 3}));
+  auto [key, value] = *map.find(2);
+  value = "zwei"; // структурная привязка к паре ссылок
+  EXPECT_EQ(key, 2);
+  EXPECT_EQ(map.at(2), "zwei");
+  EXPECT_EQ(map.select(0).second, "uno");
+}
+
+TEST(flat_test, erase_missing_string_key_keeps_elements) {
+  s21::FlatSet<std::string> set{"a", "c", "e"};
+  EXPECT_EQ(set.erase("b"), 0U);
+  EXPECT_EQ(set.erase(set.begin() + 1, set.begin() + 1), set.begin() + 1);
+  EXPECT_TRUE(std::equal(set.begin(), set.end(),
+                         std::vector<std::string>{"a", "c", "e"}.begin()));
+  EXPECT_EQ(set.erase("e"), 1U);
+  EXPECT_EQ(set.size(), 2U);
+  EXPECT_EQ(*set.rbegin(), "c");
+
+  s21::FlatMultiSet<std::string> multiset{"a", "c", "c", "e"};
+  EXPECT_EQ(multiset.erase("d"), 0U);
+  EXPECT_EQ(multiset.count("c"), 2U);
+  EXPECT_EQ(*multiset.rbegin(), "e");
+  EXPECT_TRUE(multiset.checkInvariants());
+
+  s21::FlatMap<std::string, std::string> map{{"a", "1"}, {"c", "3"}};
+  EXPECT_EQ(map.erase("b"), 0U);
+  map.erase(map.begin() + 1, map.begin() + 1);
+  EXPECT_EQ(map.at("a"), "1");
+  EXPECT_EQ(map.at("c"), "3");
+  EXPECT_TRUE(map.checkInvariants());
+}
@@ -0,0 +1,176 @@
+#include "test_runner.h"
+#include "counting_allocator.h"
+#include "test_helpers.h"
+#include <cstdint>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+// каждый ключ множества находится, соседние отсутствующие - нет
+template <typename Key> void checkFrozen(std::size_t n, unsigned seed) {
+  s21_test::checkAgainstStdSet<Key>(
+      n, seed, [n](const s21::Set<Key> &set, const std::set<Key> &expected) {
+        s21::FrozenSet<Key> frozen = set.freeze();
+        ASSERT_TRUE(frozen.checkInvariants());
+        ASSERT_EQ(frozen.size(), n);
+        s21_test::expectSameMembership(frozen, expected);
+        std::vector<Key> walked;
+        frozen.for_each([&walked](const Key &key) { walked.push_back(key); });
+        EXPECT_TRUE(std::equal(walked.begin(), walked.end(),
+                               expected.begin(), expected.end()));
+      });
+}
+
+} // namespace
+
+TEST(frozen_set_test, small_sets) {
+  s21::FrozenSet<int> empty;
+  EXPECT_TRUE(empty.empty());
+  EXPECT_FALSE(empty.contains(0));
+  EXPECT_TRUE(empty.checkInvariants());
+
+  s21::FrozenSet<int> set{5, -3, 8, 5, 0};
+  EXPECT_EQ(set.size(), 4U);
+  EXPECT_TRUE(set.contains(-3));
+  EXPECT_TRUE(set.contains(8));
+  EXPECT_EQ(set.count(0), 1U);
+  EXPECT_FALSE(set.contains(1));
+  EXPECT_FALSE(set.contains(9));
+  EXPECT_FALSE(set.contains(-4));
+  EXPECT_TRUE(set.checkInvariants());
+
+  s21::Set<int> back = set.to_set();
+  EXPECT_EQ(back.size(), 4U);
+  EXPECT_EQ(*back.begin(), -3);
+}
+
+TEST(frozen_set_test, every_size_of_the_last_block) {
+  // размеры вокруг границ блоков и полных деревьев
+  for (std::size_t n = 1; n <= 300; ++n) {
+    s21::Set<std::uint32_t> set;
+    for (std::size_t i = 0; i < n; ++i) {
+      set.insert(static_cast<std::uint32_t>(3 * i + 1));
+    }
+    s21::FrozenSet<std::uint32_t> frozen = set.freeze();
+    ASSERT_TRUE(frozen.checkInvariants());
+    for (std::uint32_t key = 0; key < 3 * n + 3; ++key) {
+      ASSERT_EQ(frozen.contains(key), key % 3 == 1 && key < 3 * n) << key;
+    }
+  }
+}
+
+TEST(frozen_set_test, arithmetic_keys_match_std_set) {
+  checkFrozen<std::uint8_t>(100, 1);
+  checkFrozen<std::int16_t>(1000, 2);
+  checkFrozen<std::int32_t>(5000, 3);
+  checkFrozen<std::uint32_t>(5000, 4);
+  checkFrozen<std::int64_t>(5000, 5);
+  checkFrozen<std::uint64_t>(5000, 6);
+  checkFrozen<double>(3000, 7);
+}
+
+TEST(frozen_set_test, custom_order_and_strings) {
+  s21::Set<int, std::greater<int>> desc{1, 2, 3, 40, 50};
+  s21::FrozenSet<int, std::greater<int>> frozen = desc.freeze();
+  EXPECT_TRUE(frozen.contains(40));
+  EXPECT_FALSE(frozen.contains(4));
+  std::vector<int> walked;
+  frozen.for_each([&walked](int key) { walked.push_back(key); });
+  EXPECT_EQ(walked, (std::vector<int>{50, 40, 3, 2, 1}));
+
+  s21::Set<std::string> words;
+  for (int i = 0; i < 200; ++i) {
+    words.insert("word" + std::to_string(i));
+  }
+  s21::FrozenSet<std::string> frozen_words = words.freeze();
+  EXPECT_TRUE(frozen_words.checkInvariants());
+  EXPECT_TRUE(frozen_words.contains("word199"));
+  EXPECT_FALSE(frozen_words.contains("word200"));
+  EXPECT_FALSE(frozen_words.contains(""));
+}
+
+namespace {
+struct ThrowingLess {
+  bool operator()(int a, int b) const {
+    if (a == 13 || b == 13) throw std::invalid_argument("unlucky key");
+    return a < b;
+  }
+};
+}  // namespace
+
+TEST(frozen_set_test, comparator_exception_propagates) {
+  s21::Set<int, ThrowingLess> set;
+  for (int i = 20; i < 120; ++i) set.insert(i);
+  s21::FrozenSet<int, ThrowingLess> frozen = set.freeze();
+  // спуск по индексу блоков сравнивает ключи компаратором пользователя
+  EXPECT_THROW(frozen.contains(13), std::invalid_argument);
+  EXPECT_TRUE(frozen.contains(50));
+}
+
+TEST(frozen_set_test, memory_comes_from_the_allocator) {
+  using Alloc = s21_test::CountingAllocator<int>;
+  s21_test::AllocStats stats;
+  {
+    s21::Set<int, std::less<int>, Alloc> set{Alloc(&stats)};
+    for (int i = 0; i < 1000; ++i) {
+      set.insert(i);
+    }
+    std::size_t before = stats.live_bytes;
+    s21::FrozenSet<int, std::less<int>, Alloc> frozen = set.freeze();
+    EXPECT_EQ(stats.live_bytes - before, frozen.memory_usage());
+    // ключи, дополнение последнего блока и по ключу на блок в индексе
+    constexpr std::size_t leaf = s21::EytzingerTree<int>::kLeaf;
+    EXPECT_LE(frozen.memory_usage(),
+              (1000U + leaf + 1000U / leaf + 1) * sizeof(int));
+    EXPECT_TRUE(frozen.contains(999));
+  }
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(frozen_map_test, lookups_and_conversion) {
+  s21::FrozenMap<int, std::string> map{{3, "three"}, {1, "one"}, {3, "drei"}};
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_EQ(map.at(3), "three");
+  EXPECT_EQ(*map.find(1), "one");
+  EXPECT_EQ(map.find(2), nullptr);
+  EXPECT_THROW(map.at(2), std::out_of_range);
+  EXPECT_EQ(map.count(1), 1U);
+  EXPECT_TRUE(map.checkInvariants());
+
+  s21::Map<int, std::string> back = map.to_map();
+  EXPECT_EQ(back.size(), 2U);
+  EXPECT_EQ(back.at(1), "one");
+}
+
+TEST(frozen_map_test, freeze_matches_map) {
+  std::mt19937 gen(9);
+  s21::Map<std::uint64_t, int> map;
+  std::map<std::uint64_t, int> expected;
+  for (int i = 0; i < 20000; ++i) {
+    std::uint64_t key = gen() % 100000;
+    map.insert_or_assign(key, i);
+    expected[key] = i;
+  }
+  s21::FrozenMap<std::uint64_t, int> frozen = map.freeze();
+  ASSERT_TRUE(frozen.checkInvariants());
+  ASSERT_EQ(frozen.size(), expected.size());
+  for (std::uint64_t key = 0; key < 100000; ++key) {
+    auto it = expected.find(key);
+    const int *value = frozen.find(key);
+    ASSERT_EQ(value != nullptr, it != expected.end());
+    if (value) {
+      ASSERT_EQ(*value, it->second);
+    }
+  }
+  auto it = expected.begin();
+  frozen.for_each([&it](const std::uint64_t &key, const int &value) {
+    EXPECT_EQ(key, it->first);
+    EXPECT_EQ(value, it->second);
+    ++it;
+  });
+}
@@ -1,6 +1,9 @@
 
 #include <list>
+#include <memory>
+#include <type_traits>
 #include "test_runner.h"
+#include "counting_allocator.h"
 
 
 TEST(List_Access, front) {
@@ -203,3 +206,53 @@ TEST(List_Modifiers, insert_many_front) {
   EXPECT_EQ(a.front(), -5);
   EXPECT_EQ(a.back(), 88);
 }
+
+TEST(List_Allocator, uses_given_allocator) {
+  s21_test::AllocStats stats;
+  {
+    s21_test::CountingAllocator<int> alloc(&stats);
+    s21::list<int, s21_test::CountingAllocator<int>> a(alloc);
+    a.push_back(3);
+    a.push_front(1);
+    a.insert(--a.end(), 2);
+    EXPECT_EQ(stats.allocations, 3U);
+    a.pop_back();
+    EXPECT_EQ(stats.deallocations, 1U);
+
+    s21::list<int, s21_test::CountingAllocator<int>> b(alloc);
+    b = std::move(a);
+    EXPECT_EQ(b.size(), 2U);
+    EXPECT_EQ(b.front(), 1);
+    EXPECT_TRUE(b.get_allocator() == alloc);
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(List_Allocator, move_assign_with_unequal_allocators_moves_values) {
+  using Alloc = s21_test::CountingAllocator<std::unique_ptr<int>>;
+  using PtrList = s21::list<std::unique_ptr<int>, Alloc>;
+  static_assert(!std::is_nothrow_move_assignable<PtrList>::value,
+                "unequal allocators may have to allocate");
+  static_assert(std::is_nothrow_move_assignable<s21::list<int>>::value,
+                "std::allocator is always equal");
+
+  s21_test::AllocStats stats_a;
+  s21_test::AllocStats stats_b;
+  {
+    PtrList a{Alloc(&stats_a)};
+    PtrList b{Alloc(&stats_b)};
+    for (int i = 0; i < 5; ++i) a.push_back(std::make_unique<int>(i));
+    int *first = a.front().get();
+    b = std::move(a);
+    // ноды созданы аллокатором b, значения перемещены, а не скопированы
+    EXPECT_EQ(b.size(), 5U);
+    EXPECT_EQ(b.front().get(), first);
+    EXPECT_EQ(*b.back(), 4);
+    EXPECT_TRUE(a.empty());
+    EXPECT_TRUE(b.get_allocator() == Alloc(&stats_b));
+    EXPECT_EQ(stats_b.allocations, 5U);
+    EXPECT_EQ(stats_a.live_bytes, 0U);
+  }
+  EXPECT_EQ(stats_b.live_bytes, 0U);
+}
@@ -1,5 +1,10 @@
 #include <map>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
 #include "test_runner.h"
+#include "counting_allocator.h"
 
 
 TEST(map_test, InsertMany) {
@@ -476,3 +481,456 @@ TEST(map_test, swap_2) {
     EXPECT_EQ(map11.size(), map22.size());
     EXPECT_EQ(a1.size(), b1.size());
 }
+
+TEST(map_test, uses_given_allocator) {
+  using value_type = std::pair<const int, std::string>;
+  s21_test::AllocStats stats;
+  {
+    s21_test::CountingAllocator<value_type> alloc(&stats);
+    s21::Map<int, std::string, std::less<int>,
+             s21_test::CountingAllocator<value_type>>
+        map(alloc);
+    for (int i = 0; i < 50; ++i) map.insert({i, std::to_string(i)});
+    EXPECT_EQ(map.at(42), "42");
+    EXPECT_GT(stats.allocations, 0U);
+    EXPECT_TRUE(map.get_allocator() == alloc);
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(map_test, custom_compare) {
+  s21::Map<int, char, std::greater<int>> map = {{1, 'a'}, {3, 'c'}, {2, 'b'}};
+  EXPECT_EQ((*map.begin()).first, 3);
+  EXPECT_EQ(map.at(2), 'b');
+}
+
+TEST(map_test, range_constructor) {
+  std::vector<std::pair<int, std::string>> items = {
+      {3, "c"}, {1, "a"}, {2, "b"}, {1, "dup"}};
+  s21::Map<int, std::string> map(items.begin(), items.end());
+  EXPECT_EQ(map.size(), 3U);
+  EXPECT_EQ(map.at(1), "a");
+  EXPECT_EQ((*map.begin()).first, 1);
+}
+
+TEST(map_test, sorted_unique_constructor) {
+  std::vector<std::pair<const int, int>> items;
+  for (int i = 0; i < 200; ++i) items.emplace_back(i, i * i);
+  s21::Map<int, int> map(s21::sorted_unique, items.begin(), items.end());
+  EXPECT_EQ(map.size(), 200U);
+  EXPECT_EQ(map.at(15), 225);
+  map.assign(items.begin() + 100, items.end());
+  EXPECT_EQ(map.size(), 100U);
+  EXPECT_FALSE(map.contains(15));
+}
+
+TEST(map_test, count_range) {
+  s21::Map<int, std::string> map;
+  for (int i = 0; i < 100; ++i) map.insert({i * 2, std::to_string(i)});
+  EXPECT_EQ(map.count_range(10, 20), 5U);
+  EXPECT_EQ(map.count_range(-5, 1000), 100U);
+  EXPECT_EQ(map.count_range(20, 10), 0U);
+}
+
+TEST(map_test, order_statistics) {
+  s21::Map<int, std::string> map;
+  for (int i = 0; i < 50; ++i) map.insert({i * 10, std::to_string(i)});
+  EXPECT_EQ(map.rank(105), 11U);
+  EXPECT_EQ((*map.nth(7)).second, "7");
+  EXPECT_EQ(map.select(49).first, 490);
+  EXPECT_THROW(map.select(50), std::out_of_range);
+}
+
+TEST(map_test, reverse_iteration) {
+  s21::Map<int, char> map = {{2, 'b'}, {3, 'c'}, {1, 'a'}};
+  std::string letters;
+  for (auto it = map.rbegin(); it != map.rend(); ++it) {
+    letters += it->second;
+  }
+  EXPECT_EQ(letters, "cba");
+  map.erase(map.find(3));
+  EXPECT_EQ(map.rbegin()->first, 2);
+  const auto &cmap = map;
+  EXPECT_EQ(std::distance(cmap.rbegin(), cmap.rend()), 2);
+}
+
+namespace {
+
+// считает конструирования по умолчанию: поиск не должен их вызывать
+struct CountedValue {
+  static int default_constructed;
+  int value = 0;
+  CountedValue() { ++default_constructed; }
+  explicit CountedValue(int v) : value(v) {}
+};
+int CountedValue::default_constructed = 0;
+
+} // namespace
+
+TEST(map_test, lookup_builds_no_mapped_type) {
+  s21::Map<std::string, CountedValue> map;
+  for (int i = 0; i < 100; ++i) {
+    map.insert({"key" + std::to_string(i), CountedValue(i)});
+  }
+  CountedValue::default_constructed = 0;
+  const std::string key = "key42";
+  EXPECT_EQ(map.find(key)->second.value, 42);
+  EXPECT_TRUE(map.contains(key));
+  EXPECT_EQ(map.count(key), 1U);
+  EXPECT_EQ(map.count("missing"), 0U);
+  EXPECT_EQ(map.at(key).value, 42);
+  EXPECT_EQ(map[key].value, 42);
+  EXPECT_EQ(map.rank("key1"), 1U);
+  EXPECT_EQ(map.count_range("key1", "key2"), 11U);
+  auto range = map.equal_range(key);
+  EXPECT_EQ(std::distance(range.first, range.second), 1);
+  EXPECT_EQ(CountedValue::default_constructed, 0);
+
+  map["new"];
+  EXPECT_EQ(CountedValue::default_constructed, 1);
+}
+
+TEST(map_test, transparent_lookup) {
+  s21::Map<std::string, int, std::less<>> map;
+  map.insert({"apple", 1});
+  map.insert({"banana", 2});
+  map.insert({"cherry", 3});
+
+  std::string_view view = "banana";
+  EXPECT_EQ(map.find(view)->second, 2);
+  EXPECT_EQ(map.find(std::string_view("kiwi")), map.end());
+  EXPECT_TRUE(map.contains(std::string_view("cherry")));
+  EXPECT_FALSE(map.contains(std::string_view("cherr")));
+  EXPECT_EQ(map.count(std::string_view("apple")), 1U);
+  EXPECT_EQ(map.count("apple"), 1U);
+
+  auto range = map.equal_range(std::string_view("banana"));
+  ASSERT_NE(range.first, map.end());
+  EXPECT_EQ(range.first->second, 2);
+  EXPECT_EQ(range.second->second, 3);
+
+  const auto &const_map = map;
+  EXPECT_EQ(const_map.find(view)->first, "banana");
+  auto empty = const_map.equal_range(std::string_view("blueberry"));
+  EXPECT_EQ(empty.first, empty.second);
+}
+
+namespace {
+// сравнение, которое бросает на «запрещённом» ключе
+struct ThrowingLess {
+  bool operator()(int a, int b) const {
+    if (a == 13 || b == 13) throw std::invalid_argument("unlucky key");
+    return a < b;
+  }
+};
+}  // namespace
+
+TEST(map_test, comparator_exception_propagates) {
+  s21::Map<int, std::string, ThrowingLess> map;
+  map.insert({1, "one"});
+  map.insert({2, "two"});
+
+  EXPECT_THROW(map.insert({13, "thirteen"}), std::invalid_argument);
+  EXPECT_THROW(map.find(13), std::invalid_argument);
+  EXPECT_THROW(map.contains(13), std::invalid_argument);
+  // пути подсчёта по размерам поддеревьев тоже сравнивают ключи
+  EXPECT_THROW(map.count(13), std::invalid_argument);
+  EXPECT_THROW(map.count_range(1, 13), std::invalid_argument);
+  EXPECT_THROW(map.rank(13), std::invalid_argument);
+  EXPECT_THROW(map.equal_range(13), std::invalid_argument);
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_EQ(map.at(2), "two");
+}
+
+TEST(map_test, move_only_values) {
+  s21::Map<int, std::unique_ptr<int>> map;
+  EXPECT_TRUE(map.try_emplace(1, std::make_unique<int>(10)).second);
+  EXPECT_TRUE(map.emplace(2, std::make_unique<int>(20)).second);
+  EXPECT_TRUE(map.insert({3, std::make_unique<int>(30)}).second);
+  EXPECT_TRUE(map.insert_or_assign(4, std::make_unique<int>(40)).second);
+
+  // ключ уже есть: аргументы не перемещаются
+  auto payload = std::make_unique<int>(99);
+  EXPECT_FALSE(map.try_emplace(2, std::move(payload)).second);
+  EXPECT_NE(payload, nullptr);
+  EXPECT_FALSE(map.emplace(2, std::move(payload)).second);
+  EXPECT_NE(payload, nullptr);
+
+  EXPECT_FALSE(map.insert_or_assign(1, std::move(payload)).second);
+  EXPECT_EQ(payload, nullptr);
+  EXPECT_EQ(*map.at(1), 99);
+  EXPECT_EQ(*map.at(2), 20);
+  EXPECT_EQ(*map.at(3), 30);
+  EXPECT_EQ(*map.at(4), 40);
+  EXPECT_EQ(map[5], nullptr);
+  EXPECT_EQ(map.size(), 5U);
+}
+
+namespace {
+
+struct Tracked {
+  static int constructed;
+  static int copied;
+  static int moved;
+  int value;
+  explicit Tracked(int v) : value(v) { ++constructed; }
+  Tracked(const Tracked &other) : value(other.value) { ++copied; }
+  Tracked(Tracked &&other) noexcept : value(other.value) { ++moved; }
+  Tracked &operator=(const Tracked &other) = default;
+  Tracked &operator=(Tracked &&other) noexcept = default;
+};
+int Tracked::constructed = 0;
+int Tracked::copied = 0;
+int Tracked::moved = 0;
+
+} // namespace
+
+TEST(map_test, emplace_constructs_once) {
+  s21::Map<std::string, Tracked> map;
+  Tracked::constructed = Tracked::copied = Tracked::moved = 0;
+
+  EXPECT_TRUE(map.try_emplace("one", 1).second);
+  EXPECT_TRUE(map.emplace(std::piecewise_construct,
+                          std::forward_as_tuple("two"),
+                          std::forward_as_tuple(2))
+                  .second);
+  EXPECT_EQ(Tracked::constructed, 2);
+
+  // повторный ключ: ни узла, ни значения
+  EXPECT_FALSE(map.try_emplace("one", 100).second);
+  EXPECT_FALSE(map.emplace(std::string("two"), Tracked(200)).second);
+  EXPECT_EQ(Tracked::constructed, 3); // только временный Tracked(200)
+  EXPECT_EQ(Tracked::moved, 0);
+
+  EXPECT_FALSE(map.insert_or_assign("one", Tracked(11)).second);
+  EXPECT_EQ(map.at("one").value, 11);
+  EXPECT_TRUE(map.insert(std::make_pair(std::string("three"), Tracked(3)))
+                  .second);
+  EXPECT_EQ(Tracked::copied, 0);
+  EXPECT_EQ(map.size(), 3U);
+}
+
+TEST(map_test, insert_with_hint) {
+  s21::Map<int, std::string> map;
+  for (int i = 0; i < 100; ++i) {
+    map.insert(map.end(), {i * 2, std::to_string(i)}); // дописываем в конец
+  }
+  auto it = map.emplace_hint(map.find(10), 9, "odd");
+  EXPECT_EQ(it->second, "odd");
+  EXPECT_EQ(std::next(it)->first, 10);
+  it = map.emplace_hint(map.begin(), 10, "ignored");
+  EXPECT_EQ(it->second, "5"); // ключ уже есть
+  std::pair<const int, std::string> value{1000, "last"};
+  EXPECT_EQ(map.insert(map.begin(), value)->second, "last");
+  EXPECT_EQ(map.rbegin()->first, 1000);
+  EXPECT_EQ(map.size(), 102U);
+  EXPECT_TRUE(std::is_sorted(
+      map.begin(), map.end(),
+      [](const auto &a, const auto &b) { return a.first < b.first; }));
+}
+
+TEST(map_test, extract_changes_key) {
+  s21::Map<int, std::unique_ptr<int>> map;
+  for (int i = 0; i < 5; ++i) map.emplace(i, std::make_unique<int>(i * 10));
+  int *payload = map.at(2).get();
+
+  auto node = map.extract(2);
+  ASSERT_FALSE(node.empty());
+  EXPECT_EQ(node.key(), 2);
+  node.key() = 42; // ключ меняется без копирования значения
+  auto result = map.insert(std::move(node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_EQ(result.position->first, 42);
+  EXPECT_EQ(map.at(42).get(), payload);
+  EXPECT_FALSE(map.contains(2));
+  EXPECT_EQ(map.rbegin()->first, 42);
+
+  node = map.extract(map.find(0));
+  node.key() = 1;
+  result = map.insert(std::move(node));
+  EXPECT_FALSE(result.inserted);
+  EXPECT_EQ(*result.node.mapped(), 0);
+  EXPECT_EQ(*result.position->second, 10);
+  EXPECT_EQ(map.size(), 4U);
+}
+
+TEST(map_test, move_assign_with_unequal_allocators_moves_values) {
+  using Alloc = s21_test::CountingAllocator<
+      std::pair<const int, std::unique_ptr<int>>>;
+  using PtrMap = s21::Map<int, std::unique_ptr<int>, std::less<int>, Alloc>;
+  static_assert(!std::is_nothrow_move_assignable<PtrMap>::value,
+                "unequal allocators may have to allocate");
+  static_assert(std::is_nothrow_move_assignable<s21::Map<int, int>>::value,
+                "std::allocator is always equal");
+
+  s21_test::AllocStats stats_a;
+  s21_test::AllocStats stats_b;
+  {
+    PtrMap a{Alloc(&stats_a)};
+    PtrMap b{Alloc(&stats_b)};
+    a.emplace(-1, std::make_unique<int>(-1));
+    for (int i = 0; i < 100; ++i) b.emplace(i, std::make_unique<int>(i * 3));
+    std::size_t b_allocations = stats_b.allocations;
+
+    a = std::move(b); // значения только перемещаемые: копия не собралась бы
+    EXPECT_EQ(a.size(), 100U);
+    EXPECT_TRUE(b.empty());
+    EXPECT_FALSE(a.contains(-1));
+    for (int i = 0; i < 100; ++i) EXPECT_EQ(*a.at(i), i * 3);
+    EXPECT_EQ(stats_b.allocations, b_allocations); // узлы a - из своего
+    EXPECT_GT(stats_a.live_bytes, 0U);
+  }
+  EXPECT_EQ(stats_a.allocations, stats_a.deallocations);
+  EXPECT_EQ(stats_b.allocations, stats_b.deallocations);
+}
+
+TEST(map_test, merge_moves_nodes) {
+  s21::Map<int, std::unique_ptr<int>> a;
+  s21::Map<int, std::unique_ptr<int>> b;
+  for (int i = 0; i < 10; ++i) a.emplace(i, std::make_unique<int>(i));
+  for (int i = 5; i < 15; ++i) b.emplace(i, std::make_unique<int>(-i));
+
+  a.merge(b); // значения только перемещаемые - узлы не копируются
+  EXPECT_EQ(a.size(), 15U);
+  EXPECT_EQ(b.size(), 5U);
+  for (int i = 0; i < 10; ++i) EXPECT_EQ(*a.at(i), i);
+  for (int i = 10; i < 15; ++i) EXPECT_EQ(*a.at(i), -i);
+  for (int i = 5; i < 10; ++i) EXPECT_EQ(*b.at(i), -i);
+}
+
+namespace {
+
+// ключ, копирование которого - ошибка: перемещение pair<const K, V>
+// копирует K, так что узлы должны переходить между деревьями целиком
+struct UncopiedKey {
+  explicit UncopiedKey(int value) : value(value) {}
+  UncopiedKey(const UncopiedKey &) { throw std::logic_error("key copied"); }
+  UncopiedKey &operator=(const UncopiedKey &) = delete;
+  bool operator<(const UncopiedKey &other) const {
+    return value < other.value;
+  }
+  int value;
+};
+
+} // namespace
+
+TEST(map_test, extract_and_merge_keep_nodes_in_place) {
+  using KeyMap = s21::Map<UncopiedKey, std::string>;
+  KeyMap a;
+  KeyMap b;
+  for (int i = 0; i < 40; ++i) a.emplace(i * 2, "a");
+  for (int i = 0; i < 40; ++i) b.emplace(i * 3, "b");
+
+  const UncopiedKey *address = &a.find(UncopiedKey(4))->first;
+  auto node = a.extract(UncopiedKey(4));
+  EXPECT_EQ(&node.key(), address);
+  node.key().value = 5;
+  {
+    KeyMap c;
+    c.emplace(1, "c");
+    EXPECT_TRUE(c.insert(std::move(node)).inserted);
+    EXPECT_EQ(&c.find(UncopiedKey(5))->first, address);
+    node = c.extract(c.find(UncopiedKey(5)));
+  } // узел переживает дерево, в слэбах которого лежит
+  EXPECT_EQ(node.mapped(), "a");
+  EXPECT_TRUE(b.insert(std::move(node)).inserted);
+
+  address = &b.find(UncopiedKey(6))->first;
+  a.merge(b); // повторы остаются в b теми же узлами
+  EXPECT_EQ(a.size(), 39U + 40U - 13U);
+  EXPECT_EQ(b.size(), 14U);
+  EXPECT_EQ(&b.find(UncopiedKey(6))->first, address);
+  EXPECT_EQ(a.at(UncopiedKey(5)), "a");
+  EXPECT_EQ(a.at(UncopiedKey(9)), "b");
+  EXPECT_EQ(b.at(UncopiedKey(0)), "b");
+  b.erase(b.find(UncopiedKey(6)));
+  b.emplace(1000, "b");
+  EXPECT_EQ(b.size(), 14U);
+  int previous = -1;
+  for (const auto &item : a) {
+    EXPECT_LT(previous, item.first.value);
+    previous = item.first.value;
+  }
+}
+
+TEST(map_test, set_algebra_by_key) {
+  s21::Map<int, std::string> a = {{1, "a1"}, {2, "a2"}, {4, "a4"}};
+  s21::Map<int, std::string> b = {{2, "b2"}, {3, "b3"}, {4, "b4"}};
+
+  auto unite = a.set_union(b);
+  EXPECT_EQ(unite.size(), 4U);
+  EXPECT_EQ(unite.at(2), "a2"); // значение берётся из левого операнда
+  EXPECT_EQ(unite.at(3), "b3");
+
+  auto common = b.set_intersection(a);
+  EXPECT_EQ(common.size(), 2U);
+  EXPECT_EQ(common.at(2), "b2");
+  EXPECT_EQ(common.at(4), "b4");
+
+  auto rest = a.set_difference(b);
+  EXPECT_EQ(rest.size(), 1U);
+  EXPECT_EQ(rest.at(1), "a1");
+
+  auto diff = a.symmetric_difference(b);
+  EXPECT_EQ(diff.size(), 2U);
+  EXPECT_EQ(diff.begin()->first, 1);
+  EXPECT_EQ(diff.rbegin()->first, 3);
+}
+
+TEST(map_test, split_and_join_reshard) {
+  s21::Map<int, std::string> shard;
+  for (int i = 0; i < 500; ++i) shard.insert(i, std::to_string(i));
+  std::string *value = &shard.at(400);
+
+  auto moved = shard.split(300);
+  EXPECT_EQ(shard.size(), 300U);
+  EXPECT_EQ(moved.size(), 200U);
+  EXPECT_EQ(&moved.at(400), value); // элементы не копируются
+  EXPECT_EQ(moved.begin()->first, 300);
+  EXPECT_FALSE(shard.contains(300));
+
+  shard.join(moved);
+  EXPECT_EQ(shard.size(), 500U);
+  EXPECT_EQ(&shard.at(400), value);
+  EXPECT_TRUE(moved.empty());
+}
+
+TEST(map_test, erase_by_key_range_and_predicate) {
+  s21::Map<int, std::string> map;
+  for (int i = 0; i < 200; ++i) map.insert(i, std::to_string(i));
+  EXPECT_EQ(map.erase(10), 1U);
+  EXPECT_EQ(map.erase(10), 0U);
+  auto it = map.erase(map.begin(), map.find(100));
+  EXPECT_EQ(it->first, 100);
+  EXPECT_EQ(map.size(), 100U);
+
+  // предикат получает пару ключ-значение
+  auto erased = s21::erase_if(map, [](const auto &item) {
+    return item.second.back() == '7';
+  });
+  EXPECT_EQ(erased, 10U);
+  EXPECT_EQ(map.size(), 90U);
+  EXPECT_FALSE(map.contains(117));
+  EXPECT_EQ(map.at(118), "118");
+}
+
+TEST(map_test, find_many_returns_iterators_in_key_order) {
+  s21::Map<std::string, int> map;
+  for (int i = 0; i < 300; ++i) map.insert(std::to_string(i), i);
+  std::vector<std::string> keys = {"7", "none", "299", "7", "", "150"};
+  std::vector<s21::Map<std::string, int>::iterator> found;
+  map.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+  ASSERT_EQ(found.size(), keys.size());
+  EXPECT_EQ(found[0]->second, 7);
+  EXPECT_EQ(found[1], map.end());
+  EXPECT_EQ(found[2]->second, 299);
+  EXPECT_EQ(found[3], found[0]);
+  EXPECT_EQ(found[4], map.end());
+  found[5]->second = -1; // неконстантная версия даёт изменяемые значения
+  EXPECT_EQ(map.at("150"), -1);
+
+  std::vector<bool> flags;
+  map.contains_many(keys.begin(), keys.end(), std::back_inserter(flags));
+  EXPECT_EQ(flags, (std::vector<bool>{true, false, true, true, false, true}));
+}
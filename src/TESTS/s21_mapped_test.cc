@@ -0,0 +1,185 @@
+#include "test_runner.h"
+#include "test_helpers.h"
+#include <cstdint>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+using s21_test::TempFile;
+
+// сравнение всех операций поиска с std::set на ключах и их соседях
+template <typename Key> void checkMapped(std::size_t n, unsigned seed) {
+  s21_test::checkAgainstStdSet<Key>(
+      n, seed, [n](const s21::Set<Key> &set, const std::set<Key> &expected) {
+        TempFile file;
+        s21::MappedSet<Key>::save(file.fd(), set);
+        s21::MappedSet<Key> mapped(file.path());
+        ASSERT_TRUE(mapped.checkInvariants());
+        ASSERT_EQ(mapped.size(), n);
+        EXPECT_TRUE(std::equal(mapped.begin(), mapped.end(),
+                               expected.begin(), expected.end()));
+        s21_test::expectSameMembership(mapped, expected);
+        for (Key key : s21_test::probeKeys(expected)) {
+          auto lower = expected.lower_bound(key);
+          auto upper = expected.upper_bound(key);
+          ASSERT_EQ(mapped.lower_bound(key) - mapped.begin(),
+                    std::distance(expected.begin(), lower));
+          ASSERT_EQ(mapped.upper_bound(key) - mapped.begin(),
+                    std::distance(expected.begin(), upper));
+        }
+      });
+}
+
+} // namespace
+
+TEST(mapped_set_test, empty_and_small_sets) {
+  s21::MappedSet<int> unopened;
+  EXPECT_TRUE(unopened.empty());
+  EXPECT_EQ(unopened.begin(), unopened.end());
+  EXPECT_FALSE(unopened.contains(1));
+  EXPECT_EQ(unopened.lower_bound(1), unopened.end());
+
+  TempFile empty_file;
+  s21::MappedSet<int>::save(empty_file.fd(), s21::Set<int>());
+  s21::MappedSet<int> empty(empty_file.path());
+  EXPECT_EQ(empty.size(), 0U);
+  EXPECT_EQ(empty.find(0), empty.end());
+  EXPECT_TRUE(empty.checkInvariants());
+
+  TempFile file;
+  s21::MappedSet<int>::save(file.fd(), s21::Set<int>{5, -3, 9});
+  s21::MappedSet<int> set(file.fd()); // дескриптор можно закрыть после
+  EXPECT_EQ(*set.begin(), -3);
+  EXPECT_EQ(*set.find(9), 9);
+  EXPECT_EQ(set.count(4), 0U);
+  EXPECT_EQ(*set.lower_bound(4), 5);
+  EXPECT_EQ(*set.upper_bound(5), 9);
+  EXPECT_EQ(set.upper_bound(9), set.end());
+  auto range = set.equal_range(5);
+  EXPECT_EQ(range.second - range.first, 1);
+  EXPECT_EQ(set.equal_range(6).first, set.equal_range(6).second);
+}
+
+TEST(mapped_set_test, matches_std_set) {
+  for (std::size_t n : {1, 15, 16, 17, 100, 257, 5000}) {
+    checkMapped<int>(n, static_cast<unsigned>(n));
+    checkMapped<std::uint64_t>(n, static_cast<unsigned>(n) + 1);
+    checkMapped<std::int16_t>(n < 1000 ? n : 1000, 3);
+  }
+}
+
+TEST(mapped_set_test, move_and_swap) {
+  TempFile file;
+  s21::MappedSet<long>::save(file.fd(), s21::Set<long>{1, 2, 3});
+  s21::MappedSet<long> first(file.path());
+  s21::MappedSet<long> second(std::move(first));
+  EXPECT_TRUE(first.empty());
+  EXPECT_EQ(second.size(), 3U);
+  first.swap(second);
+  EXPECT_TRUE(first.contains(2));
+  second = std::move(first);
+  EXPECT_TRUE(second.contains(3));
+  EXPECT_EQ(second.mapped_bytes() % 64, 0U);
+}
+
+TEST(mapped_set_test, rejects_foreign_files) {
+  TempFile set_file;
+  s21::MappedSet<int>::save(set_file.fd(), s21::Set<int>{1, 2});
+  EXPECT_THROW(s21::MappedSet<long long>{set_file.path()},
+               std::runtime_error);
+  using IntMap = s21::MappedMap<int, int>;
+  EXPECT_THROW(IntMap{set_file.path()}, std::runtime_error);
+  EXPECT_THROW(s21::MappedSet<int>{"/nonexistent/s21_mapped"},
+               std::system_error);
+
+  // снимок Set - не отображаемый файл
+  TempFile snapshot;
+  s21::Set<int>{1, 2}.save(snapshot.fd());
+  EXPECT_THROW(s21::MappedSet<int>{snapshot.path()}, std::runtime_error);
+
+  // обрезанный файл
+  ASSERT_EQ(ftruncate(set_file.fd(), 100), 0);
+  EXPECT_THROW(s21::MappedSet<int>{set_file.path()}, std::runtime_error);
+  ASSERT_EQ(ftruncate(set_file.fd(), 10), 0);
+  EXPECT_THROW(s21::MappedSet<int>{set_file.path()}, std::runtime_error);
+}
+
+TEST(mapped_set_test, detects_unsorted_keys) {
+  TempFile file;
+  s21::Set<int> set;
+  for (int i = 0; i < 100; ++i) set.insert(i);
+  s21::MappedSet<int>::save(file.fd(), set);
+  int wrong = 1000;
+  ASSERT_EQ(pwrite(file.fd(), &wrong, sizeof(wrong), 64 + 10 * sizeof(int)),
+            static_cast<ssize_t>(sizeof(wrong)));
+  s21::MappedSet<int> mapped(file.path()); // открытие порядок не читает
+  EXPECT_FALSE(mapped.checkInvariants());
+}
+
+TEST(mapped_map_test, lookups_and_iteration) {
+  s21::Map<std::uint64_t, double> map;
+  std::map<std::uint64_t, double> expected;
+  for (std::uint64_t i = 0; i < 3000; ++i) {
+    std::uint64_t key = i * i * 7 + 3;
+    map.insert(key, static_cast<double>(i) / 2);
+    expected[key] = static_cast<double>(i) / 2;
+  }
+  TempFile file;
+  s21::MappedMap<std::uint64_t, double>::save(file.fd(), map);
+  s21::MappedMap<std::uint64_t, double> mapped(file.path());
+  ASSERT_TRUE(mapped.checkInvariants());
+  ASSERT_EQ(mapped.size(), expected.size());
+
+  auto it = mapped.begin();
+  for (const auto &item : expected) {
+    ASSERT_EQ((*it).first, item.first);
+    ASSERT_EQ(it.value(), item.second);
+    ++it;
+  }
+  EXPECT_EQ(it, mapped.end());
+  --it;
+  EXPECT_EQ(it.key(), expected.rbegin()->first);
+
+  EXPECT_EQ(mapped.at(3 + 7 * 100 * 100), 50.0);
+  EXPECT_THROW(mapped.at(4), std::out_of_range);
+  EXPECT_EQ(mapped.find(4), mapped.end());
+  EXPECT_TRUE(mapped.contains(3));
+  EXPECT_EQ(mapped.lower_bound(4).key(), 10U);
+  EXPECT_EQ(mapped.upper_bound(10).key(), 31U);
+  EXPECT_EQ(mapped.upper_bound(expected.rbegin()->first), mapped.end());
+
+  s21::MappedMap<std::uint64_t, double> unopened;
+  EXPECT_EQ(unopened.begin(), unopened.end());
+  EXPECT_EQ(unopened.count(3), 0U);
+  EXPECT_THROW(s21::MappedSet<std::uint64_t>{file.path()},
+               std::runtime_error);
+  using FloatMap = s21::MappedMap<std::uint64_t, float>;
+  EXPECT_THROW(FloatMap{file.path()}, std::runtime_error);
+}
+
+TEST(mapped_map_test, shared_between_processes) {
+  s21::Map<int, int> map;
+  for (int i = 0; i < 10000; ++i) map.insert(i * 2, i);
+  TempFile file;
+  s21::MappedMap<int, int>::save(file.fd(), map);
+  s21::MappedMap<int, int> parent(file.path());
+  pid_t child = fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    // другой процесс открывает тот же файл независимо
+    s21::MappedMap<int, int> mapped(file.path());
+    bool ok = mapped.size() == 10000 && mapped.at(1234) == 617 &&
+              !mapped.contains(1235) && parent.at(1234) == 617;
+    _exit(ok ? 0 : 1);
+  }
+  int status = 0;
+  ASSERT_EQ(waitpid(child, &status, 0), child);
+  EXPECT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+}
@@ -1,5 +1,8 @@
 #include <set>
+#include <stdexcept>
+#include <vector>
 #include "test_runner.h"
+#include "counting_allocator.h"
 
 TEST(MultiSetTest, InsertMany) {
     s21::MultiSet<int> multiset;
@@ -236,6 +239,15 @@ TEST(multiset_test, upper_bound) {
   ASSERT_EQ(*x, 8);
 }
 
+TEST(multiset_test, upper_bound_is_first_greater) {
+  s21::MultiSet<int> v = {1, 8, 8, 8, 20, 42};
+  EXPECT_EQ(*v.upper_bound(8), 20);
+  EXPECT_EQ(*v.upper_bound(0), 1);
+  EXPECT_EQ(v.upper_bound(42), v.end());
+  auto range = v.equal_range(8);
+  EXPECT_EQ(std::distance(range.first, range.second), 3);
+}
+
 TEST(multiset_test, cont) {
   s21::MultiSet<double> v = {2, -3, 20, -5, 1, -6, 8, 42, 26, 1, 1, 1, 8, 8, 8};
   EXPECT_EQ(static_cast<int>(v.count(1)), 4);
@@ -503,3 +515,361 @@ TEST(multiset_test, end_const) {
         EXPECT_EQ(el, el);
     }
 }
+
+TEST(multiset_test, uses_given_allocator) {
+  s21_test::AllocStats stats;
+  {
+    s21_test::CountingAllocator<int> alloc(&stats);
+    s21::MultiSet<int, std::less<int>, s21_test::CountingAllocator<int>>
+        multiset(alloc);
+    for (int i = 0; i < 10; ++i) multiset.insert(i % 3);
+    EXPECT_EQ(multiset.count(1), 3U);
+    EXPECT_TRUE(multiset.get_allocator() == alloc);
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(multiset_test, range_constructor) {
+  std::vector<int> keys = {4, 1, 4, 2, 4};
+  s21::MultiSet<int> set(keys.begin(), keys.end());
+  EXPECT_EQ(set.size(), 5U);
+  EXPECT_EQ(set.count(4), 3U);
+  EXPECT_EQ(*set.begin(), 1);
+}
+
+TEST(multiset_test, sorted_equivalent_constructor) {
+  std::vector<int> keys;
+  for (int i = 0; i < 300; ++i) keys.push_back(i / 3);
+  s21::MultiSet<int> set(s21::sorted_equivalent, keys.begin(), keys.end());
+  EXPECT_EQ(set.size(), 300U);
+  EXPECT_EQ(set.count(50), 3U);
+  EXPECT_TRUE(std::equal(keys.begin(), keys.end(), set.begin()));
+  set.assign(s21::sorted_equivalent, keys.begin(), keys.begin() + 6);
+  EXPECT_EQ(set.size(), 6U);
+  EXPECT_EQ(set.count(1), 3U);
+}
+
+TEST(multiset_test, count_matches_std) {
+  s21::MultiSet<int> set;
+  std::multiset<int> reference;
+  unsigned seed = 5;
+  for (int i = 0; i < 20000; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    int key = static_cast<int>((seed >> 16) % 64);
+    if (i % 5 == 4 && set.contains(key)) {
+      set.erase(set.find(key));
+      reference.erase(reference.find(key));
+    } else {
+      set.insert(key);
+      reference.insert(key);
+    }
+  }
+  for (int key = -1; key <= 64; ++key) {
+    EXPECT_EQ(set.count(key), reference.count(key));
+  }
+}
+
+TEST(multiset_test, count_range) {
+  s21::MultiSet<int> set;
+  std::multiset<int> reference;
+  for (int i = 0; i < 3000; ++i) {
+    set.insert((i * 37) % 500);
+    reference.insert((i * 37) % 500);
+  }
+  for (int lo = -10; lo < 520; lo += 13) {
+    for (int hi = lo - 20; hi < 530; hi += 29) {
+      size_t expected =
+          lo < hi ? static_cast<size_t>(std::distance(
+                        reference.lower_bound(lo), reference.lower_bound(hi)))
+                  : 0;
+      EXPECT_EQ(set.count_range(lo, hi), expected);
+    }
+  }
+  EXPECT_EQ(set.count_range(0, 500), set.size());
+  EXPECT_EQ(s21::MultiSet<int>().count_range(0, 10), 0U);
+}
+
+namespace {
+struct ThrowingLess {
+  bool operator()(int a, int b) const {
+    if (a == 13 || b == 13) throw std::invalid_argument("unlucky key");
+    return a < b;
+  }
+};
+}  // namespace
+
+TEST(multiset_test, counting_comparator_exception_propagates) {
+  s21::MultiSet<int, ThrowingLess> multiset{1, 2, 2, 20};
+  s21::Set<int, ThrowingLess> set{1, 2, 20};
+
+  // исключение компаратора доходит до вызывающего, а не вызывает terminate
+  EXPECT_THROW(multiset.count(13), std::invalid_argument);
+  EXPECT_THROW(multiset.count_range(1, 13), std::invalid_argument);
+  EXPECT_THROW(set.count(13), std::invalid_argument);
+  EXPECT_THROW(set.count_range(13, 20), std::invalid_argument);
+  EXPECT_THROW(multiset.rank(13), std::invalid_argument);
+  EXPECT_THROW(set.rank(13), std::invalid_argument);
+  EXPECT_THROW(multiset.lower_bound(13), std::invalid_argument);
+  EXPECT_THROW(multiset.upper_bound(13), std::invalid_argument);
+  EXPECT_THROW(multiset.equal_range(13), std::invalid_argument);
+  EXPECT_EQ(multiset.count(2), 2U);
+  EXPECT_EQ(set.count_range(1, 20), 2U);
+  EXPECT_EQ(multiset.rank(20), 3U);
+  EXPECT_EQ(*multiset.nth(3), 20); // по индексу - без сравнений
+}
+
+TEST(multiset_test, order_statistics) {
+  s21::MultiSet<uint64_t> samples;
+  std::multiset<uint64_t> reference;
+  unsigned seed = 11;
+  for (int i = 0; i < 5000; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    uint64_t value = (seed >> 12) % 1000;
+    samples.insert(value);
+    reference.insert(value);
+    if (i % 7 == 6) {
+      samples.erase(samples.find(value));
+      reference.erase(reference.find(value));
+    }
+  }
+  ASSERT_EQ(samples.size(), reference.size());
+  auto ref_it = reference.begin();
+  for (size_t k = 0; k < reference.size(); ++k, ++ref_it) {
+    EXPECT_EQ(*samples.nth(k), *ref_it);
+    EXPECT_EQ(samples.select(k), *ref_it);
+  }
+  EXPECT_EQ(samples.nth(samples.size()), samples.end());
+  EXPECT_THROW(samples.select(samples.size()), std::out_of_range);
+
+  for (uint64_t key = 0; key <= 1000; key += 17) {
+    auto expected = std::distance(reference.begin(), reference.lower_bound(key));
+    EXPECT_EQ(samples.rank(key), static_cast<size_t>(expected));
+  }
+  size_t p99 = samples.size() * 99 / 100;
+  EXPECT_EQ(samples.select(p99), *std::next(reference.begin(), p99));
+}
+
+TEST(multiset_test, iterator_advance) {
+  s21::MultiSet<int> set;
+  for (int i = 0; i < 300; ++i) set.insert(i / 2);
+  auto it = set.begin();
+  it.advance(150);
+  EXPECT_EQ(*it, 75);
+  it.advance(-149);
+  EXPECT_EQ(*it, 0);
+  EXPECT_EQ(it, std::next(set.begin()));
+  it.advance(299);
+  EXPECT_EQ(it, set.end());
+  it.advance(-1);
+  EXPECT_EQ(*it, 149);
+  it.advance(0);
+  EXPECT_EQ(*it, 149);
+
+  const s21::MultiSet<int> &const_set = set;
+  auto cit = const_set.begin();
+  EXPECT_EQ(*cit.advance(10), 5);
+}
+
+namespace {
+
+struct Event {
+  int time;
+  std::string name;
+};
+
+// сравнивает события по времени, в том числе с самим временем (int)
+struct ByTime {
+  using is_transparent = void;
+  bool operator()(const Event &a, const Event &b) const {
+    return a.time < b.time;
+  }
+  bool operator()(const Event &a, int time) const { return a.time < time; }
+  bool operator()(int time, const Event &b) const { return time < b.time; }
+};
+
+} // namespace
+
+TEST(multiset_test, transparent_lookup) {
+  // Event нельзя построить из int: поиск по времени компилируется только
+  // через прозрачные перегрузки
+  s21::MultiSet<Event, ByTime, std::allocator<Event>> events;
+  events.insert({10, "a"});
+  events.insert({20, "b"});
+  events.insert({20, "c"});
+  events.insert({30, "d"});
+
+  EXPECT_EQ(events.count(20), 2U);
+  EXPECT_EQ(events.count(25), 0U);
+  EXPECT_TRUE(events.contains(30));
+  EXPECT_EQ(events.find(10)->name, "a");
+  EXPECT_EQ(events.find(15), events.end());
+
+  auto range = events.equal_range(20);
+  EXPECT_EQ(std::distance(range.first, range.second), 2);
+  EXPECT_EQ(range.second->name, "d");
+  EXPECT_EQ(events.lower_bound(15)->time, 20);
+  EXPECT_EQ(events.upper_bound(20)->time, 30);
+
+  const auto &const_events = events;
+  EXPECT_EQ(const_events.lower_bound(31), const_events.end());
+  EXPECT_EQ(const_events.upper_bound(0)->time, 10);
+  EXPECT_EQ(const_events.find(30)->name, "d");
+}
+
+TEST(multiset_test, move_insert_and_emplace) {
+  s21::MultiSet<std::string> set;
+  std::string word = "beta";
+  set.insert(std::move(word));
+  auto it = set.emplace(4, 'b');
+  EXPECT_EQ(*it, "bbbb");
+  set.emplace("beta");
+  set.insert(std::string("alpha"));
+  EXPECT_EQ(set.count("beta"), 2U);
+  EXPECT_EQ(set.size(), 4U);
+  EXPECT_EQ(*set.begin(), "alpha");
+}
+
+TEST(multiset_test, insert_with_hint) {
+  s21::MultiSet<int> set;
+  std::multiset<int> reference;
+  unsigned seed = 3;
+  for (int i = 0; i < 2000; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    int key = static_cast<int>((seed >> 16) % 200);
+    auto hint = i % 2 ? set.upper_bound(key) : set.end();
+    if (i % 7 == 3) hint = set.begin();
+    EXPECT_EQ(*set.insert(hint, key), key);
+    reference.insert(key);
+  }
+  EXPECT_EQ(set.size(), reference.size());
+  EXPECT_TRUE(std::equal(reference.begin(), reference.end(), set.begin()));
+
+  // равный ключ встаёт как можно ближе перед подсказкой
+  s21::MultiSet<int> ones = {1, 1, 1};
+  auto second = std::next(ones.begin());
+  auto it = ones.emplace_hint(second, 1);
+  EXPECT_EQ(std::next(it), second);
+  EXPECT_EQ(ones.size(), 4U);
+  EXPECT_EQ(std::next(ones.insert(ones.end(), 1)), ones.end());
+}
+
+TEST(multiset_test, extract_and_merge_nodes) {
+  s21_test::AllocStats stats;
+  {
+    using CountingMultiSet =
+        s21::MultiSet<int, std::less<int>, s21_test::CountingAllocator<int>>;
+    s21_test::CountingAllocator<int> alloc(&stats);
+    CountingMultiSet a(alloc);
+    CountingMultiSet b(alloc);
+    for (int i = 0; i < 500; ++i) a.insert(i % 50);
+    for (int i = 0; i < 500; ++i) b.insert(i % 70);
+    std::size_t allocations = stats.allocations;
+
+    a.merge(b); // равные ключи тоже переносятся
+    EXPECT_EQ(stats.allocations, allocations);
+    EXPECT_EQ(a.size(), 1000U);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(a.count(3), 10U + 8U);
+    EXPECT_TRUE(std::is_sorted(a.begin(), a.end()));
+
+    auto node = a.extract(3);
+    EXPECT_EQ(node.value(), 3);
+    EXPECT_EQ(a.count(3), 17U);
+    auto it = b.insert(std::move(node));
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(b.size(), 1U);
+    EXPECT_EQ(b.insert(CountingMultiSet::node_type()), b.end());
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(multiset_test, set_algebra_counts_duplicates) {
+  s21::MultiSet<int> a = {1, 1, 1, 2, 3, 3, 5};
+  s21::MultiSet<int> b = {1, 2, 2, 3, 3, 3, 4};
+
+  auto unite = a.set_union(b);
+  EXPECT_EQ(unite.count(1), 3U);
+  EXPECT_EQ(unite.count(2), 2U);
+  EXPECT_EQ(unite.count(3), 3U);
+  EXPECT_EQ(unite.size(), 10U);
+
+  auto common = a.set_intersection(b);
+  std::vector<int> expected = {1, 2, 3, 3};
+  EXPECT_EQ(common.size(), expected.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), common.begin()));
+
+  auto rest = a.set_difference(b);
+  expected = {1, 1, 5};
+  EXPECT_EQ(rest.size(), expected.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), rest.begin()));
+
+  auto diff = a.symmetric_difference(b);
+  expected = {1, 1, 2, 3, 4, 5};
+  EXPECT_EQ(diff.size(), expected.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), diff.begin()));
+}
+
+TEST(multiset_test, split_keeps_equal_keys_together) {
+  s21::MultiSet<int> left;
+  for (int i = 0; i < 300; ++i) left.insert(i % 10);
+  auto right = left.split(5);
+  EXPECT_EQ(left.size(), 150U);
+  EXPECT_EQ(right.size(), 150U);
+  EXPECT_EQ(left.count(4), 30U);
+  EXPECT_EQ(right.count(5), 30U);
+  EXPECT_EQ(*left.rbegin(), 4);
+
+  s21::MultiSet<int> equal = {4, 4};
+  left.join(equal); // равные ключи на границе допустимы
+  EXPECT_EQ(left.count(4), 32U);
+  s21::MultiSet<int> overlap = {3, 6};
+  EXPECT_THROW(left.join(overlap), std::invalid_argument);
+  left.join(right);
+  EXPECT_EQ(left.size(), 302U);
+  EXPECT_TRUE(std::is_sorted(left.begin(), left.end()));
+}
+
+TEST(multiset_test, erase_key_removes_all_copies) {
+  s21::MultiSet<int> multiset;
+  for (int i = 0; i < 1000; ++i) multiset.insert(i % 10);
+  EXPECT_EQ(multiset.erase(3), 100U); // длинный диапазон - разом
+  EXPECT_EQ(multiset.erase(3), 0U);
+  EXPECT_EQ(multiset.size(), 900U);
+  EXPECT_EQ(multiset.count(2), 100U);
+  EXPECT_EQ(multiset.count(4), 100U);
+
+  // диапазон внутри серии равных ключей
+  auto first = multiset.lower_bound(5);
+  auto last = first;
+  last.advance(40);
+  multiset.erase(first, last);
+  EXPECT_EQ(multiset.count(5), 60U);
+
+  EXPECT_EQ(s21::erase_if(multiset, [](int key) { return key >= 5; }), 460U);
+  EXPECT_EQ(multiset.size(), 400U);
+  EXPECT_EQ(*multiset.rbegin(), 4);
+}
+
+TEST(multiset_test, find_many_finds_first_of_equal_keys) {
+  s21::MultiSet<int> multiset;
+  for (int i = 0; i < 500; ++i) multiset.insert(i % 50);
+  std::vector<int> keys;
+  for (int i = -10; i < 60; ++i) keys.push_back(i);
+  std::vector<s21::MultiSet<int>::const_iterator> found;
+  const auto &view = multiset;
+  view.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+  std::vector<char> flags(keys.size());
+  multiset.contains_many(keys.begin(), keys.end(), flags.begin());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    bool present = keys[i] >= 0 && keys[i] < 50;
+    EXPECT_EQ(flags[i] != 0, present);
+    if (present) {
+      EXPECT_EQ(*found[i], keys[i]);
+      EXPECT_EQ(found[i], view.lower_bound(keys[i])); // первый из равных
+    } else {
+      EXPECT_EQ(found[i], view.end());
+    }
+  }
+}
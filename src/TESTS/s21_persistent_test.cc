@@ -0,0 +1,199 @@
+#include "test_runner.h"
+#include "counting_allocator.h"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(persistent_map_test, versions_are_independent) {
+  s21::PersistentMap<int, std::string> empty;
+  s21::PersistentMap<int, std::string> v1 = empty.insert(1, "one");
+  s21::PersistentMap<int, std::string> v2 = v1.insert({2, "two"});
+  s21::PersistentMap<int, std::string> v3 = v2.insert_or_assign(1, "uno");
+  s21::PersistentMap<int, std::string> v4 = v3.erase(2);
+
+  EXPECT_TRUE(empty.empty());
+  EXPECT_EQ(v1.size(), 1U);
+  EXPECT_EQ(v1.at(1), "one");
+  EXPECT_FALSE(v1.contains(2));
+  EXPECT_EQ(v2.size(), 2U);
+  EXPECT_EQ(v2.at(1), "one");
+  EXPECT_EQ(*v3.find(1), "uno");
+  EXPECT_EQ(v3.count(2), 1U);
+  EXPECT_EQ(v4.size(), 1U);
+  EXPECT_EQ(v4.find(2), nullptr);
+  EXPECT_THROW(v4.at(2), std::out_of_range);
+
+  // повторная вставка и удаление отсутствующего ключа не меняют версию
+  s21::PersistentMap<int, std::string> same = v2.insert(2, "dos");
+  EXPECT_EQ(same.at(2), "two");
+  EXPECT_EQ(v4.erase(7).size(), 1U);
+
+  s21::PersistentMap<int, std::string> snap = v3.snapshot();
+  v3 = v3.erase(1);
+  EXPECT_EQ(snap.at(1), "uno");
+  EXPECT_FALSE(v3.contains(1));
+  EXPECT_TRUE(snap.checkInvariants());
+  EXPECT_TRUE(v3.checkInvariants());
+
+  s21::Map<int, std::string> map = v2.to_map();
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_EQ(map.at(2), "two");
+}
+
+TEST(persistent_set_test, versions_are_independent) {
+  s21::PersistentSet<int> base{5, 3, 8, 3};
+  s21::PersistentSet<int> more = base.insert(4).insert(9);
+  s21::PersistentSet<int> less = more.erase(5);
+  EXPECT_EQ(base.size(), 3U);
+  EXPECT_EQ(more.size(), 5U);
+  EXPECT_EQ(less.size(), 4U);
+  EXPECT_TRUE(more.contains(5));
+  EXPECT_FALSE(less.contains(5));
+  EXPECT_FALSE(base.contains(9));
+
+  std::vector<int> keys;
+  less.for_each([&keys](const int &key) { keys.push_back(key); });
+  EXPECT_EQ(keys, (std::vector<int>{3, 4, 8, 9}));
+  s21::Set<int> set = less.to_set();
+  EXPECT_EQ(set.size(), 4U);
+  EXPECT_TRUE(set.contains(9));
+  EXPECT_TRUE(less.checkInvariants());
+}
+
+TEST(persistent_map_test, random_versions_match_std_map) {
+  // каждая версия сохраняется и сверяется с копией std::map после всех
+  // последующих изменений
+  std::vector<s21::PersistentMap<int, int>> versions(1);
+  std::vector<std::map<int, int>> expected(1);
+  std::mt19937 gen(11);
+  std::uniform_int_distribution<int> keys(0, 299);
+  for (int step = 1; step <= 3000; ++step) {
+    std::size_t from = gen() % versions.size();
+    int key = keys(gen);
+    std::map<int, int> next = expected[from];
+    switch (gen() % 3) {
+    case 0:
+      versions.push_back(versions[from].insert(key, step));
+      next.emplace(key, step);
+      break;
+    case 1:
+      versions.push_back(versions[from].insert_or_assign(key, step));
+      next[key] = step;
+      break;
+    default:
+      versions.push_back(versions[from].erase(key));
+      next.erase(key);
+    }
+    expected.push_back(std::move(next));
+    ASSERT_TRUE(versions.back().checkInvariants());
+    if (versions.size() > 64) {
+      std::size_t drop = gen() % versions.size();
+      versions.erase(versions.begin() + drop);
+      expected.erase(expected.begin() + drop);
+    }
+  }
+  for (std::size_t i = 0; i < versions.size(); ++i) {
+    ASSERT_TRUE(versions[i].checkInvariants());
+    ASSERT_EQ(versions[i].size(), expected[i].size());
+    auto it = expected[i].begin();
+    versions[i].for_each([&](const int &key, const int &value) {
+      EXPECT_EQ(key, it->first);
+      EXPECT_EQ(value, it->second);
+      ++it;
+    });
+  }
+}
+
+TEST(persistent_set_test, erase_every_key_in_random_order) {
+  std::vector<int> keys(500);
+  for (int i = 0; i < 500; ++i) {
+    keys[i] = i;
+  }
+  std::mt19937 gen(5);
+  std::shuffle(keys.begin(), keys.end(), gen);
+  s21::PersistentSet<int> set;
+  for (int key : keys) {
+    set = set.insert(key);
+  }
+  const s21::PersistentSet<int> full = set;
+  std::shuffle(keys.begin(), keys.end(), gen);
+  for (int key : keys) {
+    set = set.erase(key);
+    ASSERT_FALSE(set.contains(key));
+    ASSERT_TRUE(set.checkInvariants());
+  }
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(full.size(), 500U);
+  EXPECT_TRUE(full.checkInvariants());
+}
+
+TEST(persistent_map_test, versions_share_nodes) {
+  using Alloc = s21_test::CountingAllocator<std::pair<const int, std::string>>;
+  using PMap = s21::PersistentMap<int, std::string, std::less<int>, Alloc>;
+  s21_test::AllocStats stats;
+  {
+    PMap map{Alloc(&stats)};
+    for (int i = 0; i < 1024; ++i) {
+      map = map.insert(i, std::string(40, 'x'));
+    }
+    std::size_t live = stats.allocations - stats.deallocations;
+    EXPECT_EQ(live, 1024U);
+
+    // снимок ничего не выделяет, изменение копирует только путь до ключа
+    PMap snap = map.snapshot();
+    EXPECT_EQ(stats.allocations - stats.deallocations, live);
+    PMap changed = map.insert_or_assign(512, std::string(50, 'y'));
+    std::size_t copied = stats.allocations - stats.deallocations - live;
+    EXPECT_GT(copied, 0U);
+    EXPECT_LE(copied, 2U * 11U); // не больше высоты дерева
+    EXPECT_EQ(snap.at(512), std::string(40, 'x'));
+    EXPECT_EQ(changed.at(512), std::string(50, 'y'));
+
+    // после удаления старых версий остаются только узлы текущей
+    map = changed.erase(3);
+    snap = map;
+    changed = map;
+    EXPECT_EQ(stats.allocations - stats.deallocations, 1023U);
+    EXPECT_TRUE(map.checkInvariants());
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(persistent_map_test, snapshots_across_threads) {
+  // писатель публикует версии, читатели работают со своими снимками и
+  // освобождают их в своих потоках
+  s21::PersistentMap<int, int> current;
+  for (int key = 0; key < 256; ++key) {
+    current = current.insert(key, 0);
+  }
+  std::vector<s21::PersistentMap<int, int>> snapshots;
+  std::vector<std::thread> readers;
+  for (int round = 1; round <= 8; ++round) {
+    snapshots.push_back(current.snapshot());
+    for (int key = 0; key < 256; ++key) {
+      current = current.insert_or_assign(key, round);
+    }
+  }
+  for (std::size_t t = 0; t < snapshots.size(); ++t) {
+    readers.emplace_back(
+        [version = std::move(snapshots[t]), t]() mutable {
+          for (int pass = 0; pass < 20; ++pass) {
+            version.for_each([t](const int &, const int &value) {
+              ASSERT_EQ(value, static_cast<int>(t));
+            });
+            version = version.erase(pass).insert(pass, static_cast<int>(t));
+          }
+          ASSERT_TRUE(version.checkInvariants());
+        });
+  }
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(current.at(100), 8);
+  EXPECT_TRUE(current.checkInvariants());
+}
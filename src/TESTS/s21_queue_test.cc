@@ -1,6 +1,7 @@
 
 #include <queue>
 #include "test_runner.h"
+#include "counting_allocator.h"
 
 
 TEST(create_queue, check_create_queue_1) { s21::queue<int> ex; }
@@ -134,3 +135,17 @@ TEST(test_insert_many1, check_insert_many_1) {
     st_2.pop();
   }
 }
+
+TEST(Queue_Allocator, forwards_allocator_to_list) {
+  s21_test::AllocStats stats;
+  {
+    s21_test::CountingAllocator<int> alloc(&stats);
+    s21::queue<int, s21_test::CountingAllocator<int>> q(alloc);
+    q.push(1);
+    q.push(2);
+    EXPECT_EQ(q.front(), 1);
+    EXPECT_TRUE(q.get_allocator() == alloc);
+    EXPECT_EQ(stats.allocations, 2U);
+  }
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
@@ -0,0 +1,159 @@
+#include "test_runner.h"
+#include "counting_allocator.h"
+#include "test_helpers.h"
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(seqlock_map_test, single_thread_semantics) {
+  s21::SeqlockMap<int, std::string> map{{2, "two"}, {1, "one"}, {2, "dos"}};
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_EQ(*map.find(2), "two");
+  EXPECT_FALSE(map.find(3).has_value());
+  EXPECT_TRUE(map.insert(3, "three"));
+  EXPECT_FALSE(map.insert(std::make_pair(3, std::string("drei"))));
+  EXPECT_FALSE(map.insert_or_assign(3, "drei"));
+  EXPECT_EQ(*map.find(3), "drei");
+  EXPECT_TRUE(map.insert_or_assign(4, std::string("four")));
+  EXPECT_TRUE(map.contains(4));
+  EXPECT_EQ(map.erase(1), 1U);
+  EXPECT_EQ(map.erase(1), 0U);
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_TRUE(map.checkInvariants());
+
+  std::string keys;
+  map.for_each([&](const int &key, const std::string &value) {
+    keys += std::to_string(key) + value[0];
+  });
+  EXPECT_EQ(keys, "2t3d4f");
+  s21::Map<int, std::string> copy = map.to_map();
+  EXPECT_EQ(copy.size(), 3U);
+  EXPECT_EQ(copy.at(3), "drei");
+
+  // без читателей удалённые узлы освобождаются сразу
+  EXPECT_EQ(map.pending_reclaim(), 0U);
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.reclaim());
+  EXPECT_TRUE(map.checkInvariants());
+}
+
+TEST(seqlock_map_test, random_operations_match_std_map) {
+  s21::SeqlockMap<int, int> map;
+  std::map<int, int> expected;
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> keys(0, 999);
+  for (int step = 0; step < 20000; ++step) {
+    int key = keys(gen);
+    switch (gen() % 4) {
+    case 0:
+      EXPECT_EQ(map.insert(key, step), expected.emplace(key, step).second);
+      break;
+    case 1:
+      EXPECT_EQ(map.insert_or_assign(key, step),
+                expected.count(key) == 0);
+      expected[key] = step;
+      break;
+    case 2:
+      EXPECT_EQ(map.erase(key), expected.erase(key));
+      break;
+    default: {
+      auto it = expected.find(key);
+      std::optional<int> found = map.find(key);
+      ASSERT_EQ(found.has_value(), it != expected.end());
+      if (found) {
+        EXPECT_EQ(*found, it->second);
+      }
+    }
+    }
+    if (step % 1000 == 0) {
+      ASSERT_TRUE(map.checkInvariants());
+    }
+  }
+  EXPECT_EQ(map.size(), expected.size());
+  auto it = expected.begin();
+  map.for_each([&](const int &key, const int &value) {
+    EXPECT_EQ(key, it->first);
+    EXPECT_EQ(value, it->second);
+    ++it;
+  });
+  EXPECT_TRUE(map.checkInvariants());
+}
+
+TEST(seqlock_map_test, nodes_are_freed_with_the_map) {
+  using Alloc = s21_test::CountingAllocator<std::pair<const int, std::string>>;
+  s21_test::AllocStats stats;
+  {
+    s21::SeqlockMap<int, std::string, std::less<int>, Alloc> map{
+        Alloc(&stats)};
+    for (int i = 0; i < 100; ++i) {
+      map.insert(i, std::string(40, 'x'));
+    }
+    for (int i = 0; i < 100; i += 2) {
+      map.insert_or_assign(i, std::string(50, 'y'));
+      map.erase(i + 1);
+    }
+    EXPECT_TRUE(map.checkInvariants());
+    EXPECT_EQ(stats.allocations - stats.deallocations, 50U);
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(seqlock_map_test, readers_during_writes) {
+  // писатель меняет значения и удаляет/вставляет ключи, читатели без
+  // блокировок проверяют, что значение всегда цело и соответствует ключу
+  s21::SeqlockMap<int, std::string> map;
+  const int keys = 512;
+  for (int key = 0; key < keys; ++key) {
+    map.insert(key, std::to_string(key) + ":0");
+  }
+  std::atomic<bool> stop{false};
+  std::atomic<long> lookups{0};
+  std::vector<std::thread> readers;
+  for (unsigned t = 0; t < s21_test::testThreads(3); ++t) {
+    readers.emplace_back([&, t] {
+      long done = 0;
+      for (unsigned i = t; !stop.load(std::memory_order_relaxed) || done < 1000;
+           i = i * 1103515245U + 12345U, ++done) {
+        int key = static_cast<int>(i % keys);
+        std::optional<std::string> value = map.find(key);
+        // нечётные ключи могут временно отсутствовать
+        if (key % 2 == 0) {
+          ASSERT_TRUE(value.has_value());
+        }
+        if (value) {
+          ASSERT_EQ(value->substr(0, value->find(':')), std::to_string(key));
+        }
+      }
+      lookups += done;
+    });
+  }
+  for (int round = 1; round <= 30; ++round) {
+    for (int key = 0; key < keys; ++key) {
+      if (key % 2 == 0) {
+        map.insert_or_assign(key, std::to_string(key) + ":" +
+                                      std::to_string(round));
+      } else if (round % 2 == 1) {
+        map.erase(key);
+      } else {
+        map.insert(key, std::to_string(key) + ":" + std::to_string(round));
+      }
+    }
+  }
+  stop = true;
+  for (std::thread &reader : readers) {
+    reader.join();
+  }
+  EXPECT_GT(lookups.load(), 0);
+  EXPECT_TRUE(map.checkInvariants());
+  EXPECT_EQ(map.size(), static_cast<std::size_t>(keys));
+  EXPECT_EQ(*map.find(10), "10:30");
+  // читатели ушли: все удалённые узлы можно освободить
+  EXPECT_TRUE(map.reclaim());
+  EXPECT_EQ(map.pending_reclaim(), 0U);
+}
@@ -1,5 +1,13 @@
 #include "test_runner.h"
+#include "counting_allocator.h"
 #include <set>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
 
 TEST(SetTest, InsertMany) {
   s21::Set<int> set;
@@ -429,3 +437,1095 @@ TEST(RBTreeTest, erase21) {
   EXPECT_EQ(myTree.size(), 8u);
   EXPECT_EQ(myTree.find(7), myTree.end()); 
 }
+
+namespace {
+
+// проверяет свойства красно-чёрного дерева и возвращает чёрную высоту
+template <typename Node> int checkRBSubtree(const Node *node) {
+  if (!node) {
+    return 1;
+  }
+  const Node *left = static_cast<const Node *>(node->left_);
+  const Node *right = static_cast<const Node *>(node->right_);
+  EXPECT_TRUE(!left || left->parent() == node);
+  EXPECT_TRUE(!right || right->parent() == node);
+  EXPECT_FALSE(node->isRed() &&
+               ((left && left->isRed()) || (right && right->isRed())));
+  EXPECT_EQ(node->size_,
+            1 + (left ? left->size_ : 0) + (right ? right->size_ : 0));
+  int left_height = checkRBSubtree(left);
+  EXPECT_EQ(left_height, checkRBSubtree(right));
+  return left_height + (node->isRed() ? 0 : 1);
+}
+
+} // namespace
+
+TEST(RBTreeTest, random_insert_erase) {
+  s21::RBTree<int> tree;
+  std::multiset<int> reference;
+  unsigned seed = 21;
+  for (int i = 0; i < 5000; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    int key = static_cast<int>((seed >> 16) % 500);
+    if ((seed >> 8) % 3 != 0) {
+      tree.insert(key);
+      reference.insert(key);
+    } else if (tree.contains(key)) {
+      tree.erase(tree.find(key));
+      reference.erase(reference.find(key));
+    }
+  }
+  EXPECT_FALSE(tree.getRoot()->isRed());
+  checkRBSubtree(tree.getRoot());
+  EXPECT_EQ(tree.size(), reference.size());
+  EXPECT_TRUE(std::equal(reference.begin(), reference.end(), tree.cbegin()));
+}
+
+TEST(RBTreeTest, reserve_and_reuse_nodes) {
+  s21::RBTree<int> tree;
+  tree.reserve(100);
+  for (int i = 0; i < 100; ++i) {
+    tree.insertUnique(i);
+  }
+  for (int i = 0; i < 100; i += 2) {
+    tree.erase(tree.find(i));
+  }
+  for (int i = 100; i < 150; ++i) {
+    tree.insertUnique(i);
+  }
+  EXPECT_EQ(tree.size(), 100u);
+  EXPECT_FALSE(tree.contains(0));
+  EXPECT_TRUE(tree.contains(1));
+  EXPECT_TRUE(tree.contains(149));
+  checkRBSubtree(tree.getRoot());
+}
+
+TEST(RBTreeTest, clear_and_reuse) {
+  s21::RBTree<std::string> tree;
+  for (int i = 0; i < 100; ++i) {
+    tree.insert(std::string(32, static_cast<char>('a' + i % 26)));
+  }
+  tree.clear();
+  EXPECT_TRUE(tree.empty());
+  EXPECT_EQ(tree.begin(), tree.end());
+  tree.insert("after clear");
+  EXPECT_EQ(tree.size(), 1u);
+  EXPECT_EQ(*tree.begin(), "after clear");
+}
+
+TEST(set_test, reserve) {
+  s21::Set<int> set;
+  set.reserve(64);
+  for (int i = 64; i > 0; --i) {
+    set.insert(i);
+  }
+  EXPECT_EQ(set.size(), 64u);
+  EXPECT_EQ(*set.begin(), 1);
+}
+
+TEST(set_test, insert_duplicate_returns_existing) {
+  s21::Set<int> set = {1, 2, 3};
+  auto result = set.insert(2);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(result.first, set.find(2));
+  EXPECT_EQ(*result.first, 2);
+  EXPECT_EQ(set.size(), 3U);
+}
+
+TEST(set_test, uses_given_allocator) {
+  s21_test::AllocStats stats;
+  {
+    s21_test::CountingAllocator<int> alloc(&stats);
+    s21::Set<int, std::less<int>, s21_test::CountingAllocator<int>> set(alloc);
+    set.reserve(100);
+#if S21_RBTREE_NODE_POOL
+    EXPECT_EQ(stats.allocations, 1U); // все узлы одним слэбом
+#endif
+    for (int i = 0; i < 100; ++i) set.insert(i);
+#if S21_RBTREE_NODE_POOL
+    EXPECT_EQ(stats.allocations, 1U);
+#else
+    EXPECT_EQ(stats.allocations, 100U); // без пула — по узлу на вставку
+#endif
+    EXPECT_TRUE(set.get_allocator() == alloc);
+
+    auto copy = set;
+    EXPECT_EQ(copy.size(), 100U);
+    EXPECT_TRUE(copy.get_allocator() == alloc);
+    set.clear();
+    EXPECT_EQ(copy.size(), 100U);
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(set_test, custom_compare) {
+  s21::Set<int, std::greater<int>> set = {1, 3, 2};
+  auto it = set.begin();
+  EXPECT_EQ(*it++, 3);
+  EXPECT_EQ(*it++, 2);
+  EXPECT_EQ(*it, 1);
+}
+
+TEST(RBTreeTest, assign_sorted_range_is_balanced) {
+  for (int n : {0, 1, 2, 3, 7, 8, 100, 1000}) {
+    std::vector<int> keys(n);
+    for (int i = 0; i < n; ++i) keys[i] = i * 2;
+    s21::RBTree<int> tree;
+    tree.assign(keys.begin(), keys.end(), true);
+    EXPECT_EQ(tree.size(), static_cast<size_t>(n));
+    EXPECT_TRUE(std::equal(keys.begin(), keys.end(), tree.cbegin()));
+    if (n) {
+      EXPECT_FALSE(tree.getRoot()->isRed());
+    }
+    checkRBSubtree(tree.getRoot());
+    // после сборки дерево должно нормально балансироваться дальше
+    for (int i = 0; i < n; i += 3) tree.insert(i * 2 + 1);
+    for (int i = 0; i < n; i += 5) tree.erase(tree.find(i * 2));
+    checkRBSubtree(tree.getRoot());
+  }
+}
+
+TEST(set_test, range_constructor) {
+  std::list<int> unsorted = {5, 1, 4, 1, 3, 2, 5};
+  s21::Set<int> set(unsorted.begin(), unsorted.end());
+  EXPECT_EQ(set.size(), 5U);
+  int expected = 1;
+  for (int key : set) EXPECT_EQ(key, expected++);
+
+  std::vector<int> sorted = {1, 2, 2, 3, 8};
+  s21::Set<int> from_sorted(sorted.begin(), sorted.end());
+  EXPECT_EQ(from_sorted.size(), 4U);
+  EXPECT_TRUE(from_sorted.contains(8));
+}
+
+TEST(set_test, sorted_unique_constructor) {
+  std::vector<int> keys;
+  for (int i = 0; i < 500; ++i) keys.push_back(i);
+  s21::Set<int> set(s21::sorted_unique, keys.begin(), keys.end());
+  EXPECT_EQ(set.size(), 500U);
+  EXPECT_TRUE(std::equal(keys.begin(), keys.end(), set.begin()));
+  set.insert(1000);
+  set.erase(set.find(250));
+  EXPECT_EQ(set.size(), 500U);
+  EXPECT_FALSE(set.contains(250));
+}
+
+TEST(set_test, assign_range) {
+  s21::Set<int> set = {100, 200};
+  std::vector<int> keys = {3, 1, 2};
+  set.assign(keys.begin(), keys.end());
+  EXPECT_EQ(set.size(), 3U);
+  EXPECT_EQ(*set.begin(), 1);
+  EXPECT_FALSE(set.contains(100));
+
+  std::vector<int> sorted = {7, 8, 9};
+  set.assign(s21::sorted_unique, sorted.begin(), sorted.end());
+  EXPECT_EQ(set.size(), 3U);
+  EXPECT_EQ(*set.begin(), 7);
+}
+
+TEST(set_test, copy_is_balanced) {
+  s21::Set<int> set;
+  for (int i = 0; i < 300; ++i) set.insert((i * 37) % 300);
+  s21::Set<int> copy(set);
+  EXPECT_EQ(copy.size(), 300U);
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), copy.begin()));
+  copy.insert(-1);
+  EXPECT_EQ(*copy.begin(), -1);
+  EXPECT_EQ(*set.begin(), 0);
+}
+
+namespace {
+
+// ключ, конструктор копирования которого бросает исключение по счётчику
+struct ThrowingKey {
+  static std::atomic<int> copies_left;
+  static std::atomic<int> alive;
+  int value;
+
+  explicit ThrowingKey(int v) : value(v) { ++alive; }
+  ThrowingKey(const ThrowingKey &other) : value(other.value) {
+    if (--copies_left == 0) {
+      throw std::runtime_error("copy failed");
+    }
+    ++alive;
+  }
+  ~ThrowingKey() { --alive; }
+  bool operator<(const ThrowingKey &other) const {
+    return value < other.value;
+  }
+};
+
+std::atomic<int> ThrowingKey::copies_left{-1};
+std::atomic<int> ThrowingKey::alive{0};
+
+} // namespace
+
+TEST(RBTreeTest, copy_assignment_links_and_size) {
+  s21::RBTree<int> tree;
+  for (int i = 0; i < 1000; ++i) tree.insert((i * 7919) % 1000);
+  s21::RBTree<int> copy;
+  copy.insert(-5);
+  copy = tree;
+  EXPECT_EQ(copy.size(), 1000U);
+  EXPECT_FALSE(copy.getRoot()->isRed());
+  EXPECT_TRUE(s21::RBTree<int>::isHeader(copy.getRoot()->parent()));
+  checkRBSubtree(copy.getRoot());
+  EXPECT_TRUE(std::equal(tree.cbegin(), tree.cend(), copy.cbegin()));
+
+  s21::Set<int> set = {3, 1, 2};
+  s21::Set<int> other;
+  other = set;
+  EXPECT_EQ(other.size(), 3U);
+}
+
+TEST(RBTreeTest, parallel_copy) {
+  s21::RBTree<int> tree;
+  unsigned seed = 7;
+  for (int i = 0; i < 20000; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    int key = static_cast<int>((seed >> 8) % 50000);
+    if (i % 4 == 3 && tree.contains(key)) {
+      tree.erase(tree.find(key));
+    } else {
+      tree.insert(key);
+    }
+  }
+  for (unsigned threads : {2U, 3U, 8U, 64U}) {
+    s21::RBTree<int> copy;
+    copy.copyFrom(tree, threads);
+    EXPECT_EQ(copy.size(), tree.size());
+    EXPECT_TRUE(std::equal(tree.cbegin(), tree.cend(), copy.cbegin()));
+    EXPECT_FALSE(copy.getRoot()->isRed());
+    EXPECT_TRUE(s21::RBTree<int>::isHeader(copy.getRoot()->parent()));
+    checkRBSubtree(copy.getRoot());
+
+    copy.insert(-1);
+    copy.erase(copy.find(*tree.cbegin()));
+    checkRBSubtree(copy.getRoot());
+    EXPECT_FALSE(tree.contains(-1));
+  }
+
+  s21::RBTree<int> small;
+  small.insert(1);
+  s21::RBTree<int> copy;
+  copy.copyFrom(small, 16); // поддеревьев меньше, чем потоков
+  EXPECT_EQ(copy.size(), 1U);
+  copy.copyFrom(s21::RBTree<int>(), 4);
+  EXPECT_TRUE(copy.empty());
+}
+
+TEST(RBTreeTest, parallel_copy_strings) {
+  s21::RBTree<std::string> tree;
+  for (int i = 0; i < 5000; ++i) {
+    tree.insert(std::string(40, 'x') + std::to_string(i));
+  }
+  s21::RBTree<std::string> copy;
+  copy.copyFrom(tree, 4);
+  EXPECT_EQ(copy.size(), tree.size());
+  EXPECT_TRUE(std::equal(tree.cbegin(), tree.cend(), copy.cbegin()));
+  checkRBSubtree(copy.getRoot());
+}
+
+TEST(RBTreeTest, parallel_copy_exception) {
+  s21_test::AllocStats stats;
+  {
+    using Alloc = s21_test::CountingAllocator<ThrowingKey>;
+    s21::RBTree<ThrowingKey, std::less<ThrowingKey>, Alloc> tree{
+        Alloc(&stats)};
+    for (int i = 0; i < 3000; ++i) tree.insert(ThrowingKey(i));
+    EXPECT_EQ(ThrowingKey::alive, 3000);
+
+    s21::RBTree<ThrowingKey, std::less<ThrowingKey>, Alloc> copy{
+        Alloc(&stats)};
+    copy.insert(ThrowingKey(-1));
+    ThrowingKey::copies_left = 2000;
+    EXPECT_THROW(copy.copyFrom(tree, 4), std::runtime_error);
+    ThrowingKey::copies_left = -1;
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(ThrowingKey::alive, 3000);
+
+    copy.copyFrom(tree, 4);
+    EXPECT_EQ(copy.size(), 3000U);
+  }
+  EXPECT_EQ(ThrowingKey::alive, 0);
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(RBTreeTest, header_tracks_extremes) {
+  s21::RBTree<int> tree;
+  std::multiset<int> reference;
+  EXPECT_EQ(tree.begin(), tree.end());
+  EXPECT_EQ(tree.rbegin(), tree.rend());
+  unsigned seed = 5;
+  for (int i = 0; i < 3000; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    int key = static_cast<int>((seed >> 16) % 300);
+    if ((seed >> 8) % 3 != 0) {
+      tree.insert(key);
+      reference.insert(key);
+    } else if (!reference.empty()) {
+      // чаще всего удаляем крайние элементы - они кэшированы в заголовке
+      auto it = (seed >> 4) % 2 ? tree.begin() : --tree.end();
+      reference.erase(reference.find(*it));
+      tree.erase(it);
+    }
+    if (reference.empty()) {
+      EXPECT_EQ(tree.begin(), tree.end());
+    } else {
+      EXPECT_EQ(*tree.begin(), *reference.begin());
+      EXPECT_EQ(*--tree.end(), *reference.rbegin());
+      EXPECT_EQ(*tree.rbegin(), *reference.rbegin());
+    }
+  }
+  checkRBSubtree(tree.getRoot());
+  EXPECT_TRUE(std::equal(reference.rbegin(), reference.rend(), tree.rbegin()));
+}
+
+TEST(RBTreeTest, iterators_hold_only_a_node) {
+  s21::RBTree<int>::iterator it; // итератор можно создать пустым
+  s21::RBTree<int> tree;
+  for (int key : {3, 1, 2}) tree.insert(key);
+  it = tree.find(2);
+  EXPECT_EQ(*it, 2);
+  s21::RBTree<int>::const_iterator cit;
+  cit = tree.cbegin();
+  EXPECT_EQ(*cit, 1);
+
+  // итераторы остаются действительными после перемещения и обмена
+  s21::RBTree<int> moved(std::move(tree));
+  EXPECT_EQ(*it, 2);
+  EXPECT_EQ(++it, --moved.end());
+  EXPECT_EQ(++it, moved.end());
+  EXPECT_TRUE(tree.empty());
+  EXPECT_EQ(tree.begin(), tree.end());
+
+  s21::RBTree<int> other;
+  other.insert(10);
+  auto ten = other.begin();
+  moved.swap(other);
+  EXPECT_EQ(++ten, moved.end());
+  EXPECT_EQ(*--other.end(), 3);
+  EXPECT_EQ(other.end().advance(-3), other.begin());
+  other = std::move(moved);
+  EXPECT_EQ(*other.begin(), 10);
+  EXPECT_EQ(moved.begin(), moved.end());
+  EXPECT_TRUE(s21::RBTree<int>::isHeader(other.getRoot()->parent()));
+}
+
+TEST(set_test, count_range) {
+  s21::Set<int> set = {1, 3, 5, 7, 9};
+  EXPECT_EQ(set.count_range(3, 8), 3U);
+  EXPECT_EQ(set.count_range(3, 9), 3U);
+  EXPECT_EQ(set.count_range(0, 100), 5U);
+  EXPECT_EQ(set.count_range(5, 5), 0U);
+  EXPECT_EQ(set.count_range(9, 1), 0U);
+}
+
+TEST(set_test, order_statistics) {
+  s21::Set<int> set = {50, 10, 40, 20, 30};
+  EXPECT_EQ(set.rank(10), 0U);
+  EXPECT_EQ(set.rank(35), 3U);
+  EXPECT_EQ(set.rank(100), 5U);
+  EXPECT_EQ(*set.nth(0), 10);
+  EXPECT_EQ(*set.nth(4), 50);
+  EXPECT_EQ(set.nth(5), set.end());
+  EXPECT_EQ(set.select(2), 30);
+  EXPECT_THROW(set.select(5), std::out_of_range);
+  s21::Set<int> empty;
+  EXPECT_EQ(empty.nth(0), empty.end());
+
+  auto it = set.end();
+  EXPECT_EQ(*it.advance(-5), 10);
+}
+
+TEST(set_test, transparent_lookup) {
+  s21::Set<std::string, std::less<>> set = {"alpha", "beta", "gamma"};
+  EXPECT_NE(set.find(std::string_view("beta")), set.end());
+  EXPECT_EQ(set.find(std::string_view("delta")), set.end());
+  EXPECT_TRUE(set.contains(std::string_view("gamma")));
+  EXPECT_EQ(set.count(std::string_view("alpha")), 1U);
+  EXPECT_EQ(set.count(std::string("omega")), 0U);
+
+  auto range = set.equal_range(std::string_view("beta"));
+  EXPECT_EQ(*range.first, "beta");
+  EXPECT_EQ(*range.second, "gamma");
+  const auto &const_set = set;
+  auto empty = const_set.equal_range(std::string_view("zeta"));
+  EXPECT_EQ(empty.first, const_set.end());
+  EXPECT_EQ(empty.second, const_set.end());
+}
+
+TEST(set_test, move_insert_and_emplace) {
+  s21::Set<std::string> set;
+  std::string word = "alpha";
+  EXPECT_TRUE(set.insert(std::move(word)).second);
+  std::string again = "alpha";
+  EXPECT_FALSE(set.insert(std::move(again)).second);
+  EXPECT_EQ(again, "alpha"); // дубликат не перемещается
+  EXPECT_TRUE(set.emplace(3, 'z').second);
+  EXPECT_FALSE(set.emplace("zzz").second);
+  EXPECT_TRUE(set.contains("zzz"));
+
+  s21::Set<std::unique_ptr<int>> owners;
+  auto owner = std::make_unique<int>(1);
+  int *raw = owner.get();
+  EXPECT_TRUE(owners.insert(std::move(owner)).second);
+  EXPECT_TRUE(owners.emplace(new int(2)).second);
+  EXPECT_EQ(owners.size(), 2U);
+  bool found = false;
+  for (const auto &ptr : owners) found = found || ptr.get() == raw;
+  EXPECT_TRUE(found);
+}
+
+namespace {
+
+// считает вызовы сравнения, чтобы проверить вставку без спуска от корня
+struct CountingLess {
+  static int calls;
+  bool operator()(int a, int b) const {
+    ++calls;
+    return a < b;
+  }
+};
+int CountingLess::calls = 0;
+
+} // namespace
+
+TEST(set_test, insert_with_hint) {
+  s21::Set<int> set;
+  std::set<int> reference;
+  unsigned seed = 17;
+  for (int i = 0; i < 2000; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    int key = static_cast<int>((seed >> 16) % 700);
+    // подсказки бывают точными, соседними и совсем неверными
+    auto hint = set.nth(set.rank(key));
+    if (i % 3 == 1 && hint != set.begin()) --hint;
+    if (i % 5 == 4) hint = set.begin();
+    auto it = set.insert(hint, key);
+    reference.insert(key);
+    EXPECT_EQ(*it, key);
+  }
+  EXPECT_EQ(set.size(), reference.size());
+  EXPECT_TRUE(std::equal(reference.begin(), reference.end(), set.begin()));
+
+  auto it = set.find(100);
+  EXPECT_EQ(set.insert(set.end(), 100), it); // дубликат не вставляется
+  EXPECT_EQ(set.emplace_hint(set.begin(), 100), it);
+  EXPECT_EQ(set.size(), reference.size());
+}
+
+TEST(set_test, hinted_append_is_constant) {
+  s21::Set<int, CountingLess> set;
+  for (int i = 0; i < 1000; ++i) set.insert(set.end(), i);
+  CountingLess::calls = 0;
+  for (int i = 1000; i < 2000; ++i) set.insert(set.end(), i);
+  EXPECT_EQ(CountingLess::calls, 1000); // одно сравнение с максимумом
+  auto it = set.find(1500);
+  CountingLess::calls = 0;
+  set.erase(it++);
+  set.emplace_hint(it, 1500); // точная подсказка: сосед справа
+  EXPECT_LE(CountingLess::calls, 3);
+  EXPECT_EQ(set.size(), 2000U);
+  EXPECT_TRUE(std::is_sorted(set.begin(), set.end()));
+}
+
+TEST(RBTreeTest, insert_with_hint_keeps_invariants) {
+  s21::RBTree<int> tree;
+  for (int i = 0; i < 3000; ++i) {
+    tree.insert(tree.end(), i / 3); // почти монотонный поток с повторами
+    if (i % 7 == 0) tree.insert(tree.begin(), -i);
+  }
+  checkRBSubtree(tree.getRoot());
+  EXPECT_FALSE(tree.getRoot()->isRed());
+  EXPECT_TRUE(std::is_sorted(tree.cbegin(), tree.cend()));
+  EXPECT_EQ(*tree.cbegin(), -2996);
+  EXPECT_EQ(*tree.rbegin(), 999);
+}
+
+TEST(set_test, extract_and_insert_node) {
+  s21::Set<std::string> a = {"apple", "banana", "cherry"};
+  s21::Set<std::string> b = {"banana"};
+
+  auto node = a.extract("banana");
+  ASSERT_FALSE(node.empty());
+  EXPECT_EQ(node.value(), "banana");
+  EXPECT_EQ(a.size(), 2U);
+  EXPECT_FALSE(a.contains("banana"));
+  EXPECT_TRUE(a.extract("kiwi").empty());
+
+  auto result = b.insert(std::move(node)); // ключ уже есть - узел остаётся
+  EXPECT_FALSE(result.inserted);
+  EXPECT_EQ(result.position, b.find("banana"));
+  ASSERT_FALSE(result.node.empty());
+
+  result = a.insert(std::move(result.node));
+  EXPECT_TRUE(result.inserted);
+  EXPECT_TRUE(result.node.empty());
+  EXPECT_EQ(*result.position, "banana");
+  EXPECT_EQ(a.size(), 3U);
+
+  auto first = a.extract(a.begin());
+  EXPECT_EQ(first.value(), "apple");
+  EXPECT_EQ(*a.begin(), "banana");
+  auto empty = a.insert(s21::Set<std::string>::node_type());
+  EXPECT_FALSE(empty.inserted);
+  EXPECT_EQ(empty.position, a.end());
+}
+
+TEST(set_test, merge_keeps_duplicates_in_source) {
+  s21::Set<int> a;
+  s21::Set<int> b;
+  for (int i = 0; i < 200; i += 2) a.insert(i);
+  for (int i = 0; i < 300; i += 3) b.insert(i);
+
+  a.merge(b);
+  std::set<int> expected_a;
+  std::set<int> expected_b;
+  for (int i = 0; i < 300; ++i) {
+    if ((i % 2 == 0 && i < 200) || i % 3 == 0) expected_a.insert(i);
+    if (i % 3 == 0 && i % 2 == 0 && i < 200) expected_b.insert(i);
+  }
+  EXPECT_EQ(a.size(), expected_a.size());
+  EXPECT_TRUE(std::equal(expected_a.begin(), expected_a.end(), a.begin()));
+  EXPECT_EQ(b.size(), expected_b.size());
+  EXPECT_TRUE(std::equal(expected_b.begin(), expected_b.end(), b.begin()));
+
+  // оба дерева остаются корректными и изменяемыми
+  for (int i = 0; i < 300; ++i) b.insert(i);
+  for (int i = 0; i < 300; i += 5) {
+    if (a.contains(i)) a.erase(a.find(i));
+    expected_a.erase(i);
+  }
+  EXPECT_EQ(b.size(), 300U);
+  a.merge(a);
+  EXPECT_EQ(a.size(), expected_a.size());
+  EXPECT_TRUE(std::equal(expected_a.begin(), expected_a.end(), a.begin()));
+}
+
+TEST(set_test, merge_allocates_no_nodes) {
+  s21_test::AllocStats stats;
+  {
+    using CountingSet =
+        s21::Set<int, std::less<int>, s21_test::CountingAllocator<int>>;
+    s21_test::CountingAllocator<int> alloc(&stats);
+    CountingSet a(alloc);
+    CountingSet b(alloc);
+    for (int i = 0; i < 1000; ++i) a.insert(i * 2);
+    for (int i = 0; i < 1000; ++i) b.insert(i * 2 + 1);
+    std::size_t allocations = stats.allocations;
+
+    // с пулом - только заголовок группы слэбов, общей для a и b
+    std::size_t shared =
+        CountingSet::rb_tree::node_pool::kPooled ? allocations + 1
+                                                 : allocations;
+    a.merge(b);
+    EXPECT_EQ(stats.allocations, shared);
+    EXPECT_EQ(a.size(), 2000U);
+    EXPECT_TRUE(b.empty());
+    for (int i = 0; i < 2000; ++i) EXPECT_EQ(a.nth(i).operator*(), i);
+
+    // узел остаётся в своей ячейке; b после merge не держит слэбов и
+    // заводит список чужих слэбов, следующий узел того же слэба - уже без него
+    const int *address = &*a.find(7);
+    auto node = a.extract(a.find(7));
+    b.insert(std::move(node));
+    EXPECT_EQ(&*b.find(7), address);
+    std::size_t pinned =
+        CountingSet::rb_tree::node_pool::kPooled ? shared + 1 : shared;
+    EXPECT_EQ(stats.allocations, pinned);
+    b.insert(a.extract(a.find(9)));
+    EXPECT_EQ(stats.allocations, pinned);
+    b.clear();
+    a.clear();
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(set_test, dropped_node_handle_frees_node) {
+  s21_test::AllocStats stats;
+  {
+    s21_test::CountingAllocator<int> alloc(&stats);
+    s21::Set<int, std::less<int>, s21_test::CountingAllocator<int>> set(alloc);
+    for (int i = 0; i < 10; ++i) set.insert(i);
+    {
+      auto node = set.extract(5);
+      EXPECT_EQ(node.value(), 5);
+    }
+    EXPECT_EQ(set.size(), 9U);
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(set_test, node_handle_keeps_only_its_slab) {
+  s21_test::AllocStats stats;
+  {
+    using CountingSet =
+        s21::Set<int, std::less<int>, s21_test::CountingAllocator<int>>;
+    s21_test::CountingAllocator<int> alloc(&stats);
+    CountingSet other(alloc);
+    std::size_t filled = 0;
+    {
+      CountingSet set(alloc);
+      for (int i = 0; i < 10000; ++i) set.insert(i);
+      filled = stats.live_bytes;
+      auto node = set.extract(0);
+      set.clear(); // узел остаётся в своём слэбе, остальные освобождены
+      EXPECT_LT(stats.live_bytes * 100, filled);
+      EXPECT_TRUE(other.insert(std::move(node)).inserted);
+    }
+    EXPECT_LT(stats.live_bytes * 100, filled);
+    EXPECT_EQ(other.size(), 1U);
+    EXPECT_EQ(*other.begin(), 0);
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(set_test, merge_with_other_allocator_copies) {
+  s21_test::AllocStats stats_a;
+  s21_test::AllocStats stats_b;
+  {
+    using CountingSet =
+        s21::Set<int, std::less<int>, s21_test::CountingAllocator<int>>;
+    CountingSet a{s21_test::CountingAllocator<int>(&stats_a)};
+    CountingSet b{s21_test::CountingAllocator<int>(&stats_b)};
+    for (int i = 0; i < 50; ++i) a.insert(i);
+    for (int i = 25; i < 100; ++i) b.insert(i);
+    a.merge(b);
+    EXPECT_EQ(a.size(), 100U);
+    EXPECT_EQ(b.size(), 25U);
+    EXPECT_EQ(*b.begin(), 25);
+    EXPECT_EQ(*b.rbegin(), 49);
+  }
+  EXPECT_EQ(stats_a.live_bytes, 0U);
+  EXPECT_EQ(stats_b.live_bytes, 0U);
+}
+
+TEST(RBTreeTest, merge_keeps_invariants) {
+  s21::RBTree<int> a;
+  s21::RBTree<int> b;
+  unsigned seed = 5;
+  for (int i = 0; i < 3000; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    (i % 2 ? a : b).insertUnique(static_cast<int>((seed >> 16) % 1000));
+  }
+  std::size_t total = a.size() + b.size();
+  a.mergeUnique(b);
+  checkRBSubtree(a.getRoot());
+  checkRBSubtree(b.getRoot());
+  EXPECT_EQ(a.size() + b.size(), total);
+  EXPECT_TRUE(std::adjacent_find(a.cbegin(), a.cend()) == a.cend());
+  a.merge(b);
+  checkRBSubtree(a.getRoot());
+  EXPECT_EQ(a.size(), total);
+  EXPECT_TRUE(b.empty());
+  EXPECT_TRUE(std::is_sorted(a.cbegin(), a.cend()));
+}
+
+TEST(set_test, set_algebra) {
+  s21::Set<int> a;
+  s21::Set<int> b;
+  std::set<int> ref_a;
+  std::set<int> ref_b;
+  unsigned seed = 3;
+  for (int i = 0; i < 2000; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    int key = static_cast<int>((seed >> 16) % 3000);
+    if (i % 2) {
+      a.insert(key);
+      ref_a.insert(key);
+    } else {
+      b.insert(key);
+      ref_b.insert(key);
+    }
+  }
+
+  std::vector<int> expected;
+  std::set_union(ref_a.begin(), ref_a.end(), ref_b.begin(), ref_b.end(),
+                 std::back_inserter(expected));
+  auto result = a.set_union(b);
+  EXPECT_EQ(result.size(), expected.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), result.begin()));
+
+  expected.clear();
+  std::set_intersection(ref_a.begin(), ref_a.end(), ref_b.begin(),
+                        ref_b.end(), std::back_inserter(expected));
+  result = a.set_intersection(b);
+  EXPECT_EQ(result.size(), expected.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), result.begin()));
+
+  expected.clear();
+  std::set_difference(ref_a.begin(), ref_a.end(), ref_b.begin(), ref_b.end(),
+                      std::back_inserter(expected));
+  result = a.set_difference(b);
+  EXPECT_EQ(result.size(), expected.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), result.begin()));
+
+  expected.clear();
+  std::set_symmetric_difference(ref_a.begin(), ref_a.end(), ref_b.begin(),
+                                ref_b.end(), std::back_inserter(expected));
+  result = a.symmetric_difference(b);
+  EXPECT_EQ(result.size(), expected.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), result.begin()));
+
+  s21::Set<int> empty;
+  EXPECT_TRUE(a.set_intersection(empty).empty());
+  EXPECT_EQ(empty.set_union(a).size(), a.size());
+  EXPECT_EQ(a.set_difference(empty).size(), a.size());
+  EXPECT_TRUE(a.symmetric_difference(a).empty());
+}
+
+TEST(RBTreeTest, parallel_set_algebra_matches_serial) {
+  s21::RBTree<int> a;
+  s21::RBTree<int> b;
+  unsigned seed = 9;
+  for (int i = 0; i < 20000; ++i) {
+    seed = seed * 1103515245u + 12345u;
+    // много повторов: равные ключи не должны попасть в разные куски
+    (i % 3 ? a : b).insert(static_cast<int>((seed >> 16) % 500));
+  }
+  for (unsigned threads : {2U, 3U, 8U}) {
+    auto serial = a.setUnion(b, 1);
+    auto parallel = a.setUnion(b, threads);
+    EXPECT_EQ(parallel.size(), serial.size());
+    EXPECT_TRUE(std::equal(serial.cbegin(), serial.cend(), parallel.cbegin()));
+    checkRBSubtree(parallel.getRoot());
+
+    serial = a.setIntersection(b, 1);
+    parallel = a.setIntersection(b, threads);
+    EXPECT_EQ(parallel.size(), serial.size());
+    EXPECT_TRUE(std::equal(serial.cbegin(), serial.cend(), parallel.cbegin()));
+    checkRBSubtree(parallel.getRoot());
+
+    serial = b.setDifference(a, 1);
+    parallel = b.setDifference(a, threads);
+    EXPECT_EQ(parallel.size(), serial.size());
+    EXPECT_TRUE(std::equal(serial.cbegin(), serial.cend(), parallel.cbegin()));
+    checkRBSubtree(parallel.getRoot());
+
+    serial = a.symmetricDifference(b, 1);
+    parallel = a.symmetricDifference(b, threads);
+    EXPECT_EQ(parallel.size(), serial.size());
+    EXPECT_TRUE(std::equal(serial.cbegin(), serial.cend(), parallel.cbegin()));
+    checkRBSubtree(parallel.getRoot());
+  }
+}
+
+TEST(RBTreeTest, parallel_set_algebra_exception) {
+  s21_test::AllocStats stats;
+  {
+    using Alloc = s21_test::CountingAllocator<ThrowingKey>;
+    s21::RBTree<ThrowingKey, std::less<ThrowingKey>, Alloc> a{Alloc(&stats)};
+    s21::RBTree<ThrowingKey, std::less<ThrowingKey>, Alloc> b{Alloc(&stats)};
+    for (int i = 0; i < 3000; ++i) (i % 2 ? a : b).insert(ThrowingKey(i));
+    EXPECT_EQ(ThrowingKey::alive, 3000);
+
+    ThrowingKey::copies_left = 2000;
+    EXPECT_THROW(a.setUnion(b, 4), std::runtime_error);
+    ThrowingKey::copies_left = -1;
+    EXPECT_EQ(ThrowingKey::alive, 3000);
+
+    auto unite = a.setUnion(b, 4);
+    EXPECT_EQ(unite.size(), 3000U);
+    checkRBSubtree(unite.getRoot());
+  }
+  EXPECT_EQ(ThrowingKey::alive, 0);
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(RBTreeTest, parallel_set_algebra_strings) {
+  s21::RBTree<std::string> a;
+  s21::RBTree<std::string> b;
+  for (int i = 0; i < 6000; ++i) {
+    (i % 3 ? a : b).insert(std::string(40, 'x') + std::to_string(i % 4000));
+  }
+  for (unsigned threads : {2U, 5U}) {
+    auto serial = a.setUnion(b, 1);
+    auto parallel = a.setUnion(b, threads);
+    EXPECT_EQ(parallel.size(), serial.size());
+    EXPECT_TRUE(std::equal(serial.cbegin(), serial.cend(), parallel.cbegin()));
+    checkRBSubtree(parallel.getRoot());
+    EXPECT_EQ(*parallel.cbegin(), *serial.cbegin());
+    EXPECT_EQ(*--parallel.cend(), *--serial.cend());
+  }
+}
+
+TEST(RBTreeTest, split_and_join_keep_invariants) {
+  for (int n : {0, 1, 2, 3, 10, 100, 1000}) {
+    for (int pivot : {-1, 0, 1, n / 3, n / 2, n - 1, n, n + 5}) {
+      s21::RBTree<int> left;
+      for (int i = 0; i < n; ++i) left.insert(i);
+      auto right = left.split(pivot);
+      int border = std::max(0, std::min(pivot, n));
+      EXPECT_EQ(left.size(), static_cast<size_t>(border));
+      EXPECT_EQ(right.size(), static_cast<size_t>(n - border));
+      checkRBSubtree(left.getRoot());
+      checkRBSubtree(right.getRoot());
+      if (!left.empty()) {
+        EXPECT_FALSE(left.getRoot()->isRed());
+        EXPECT_EQ(*left.cbegin(), 0);
+        EXPECT_EQ(*left.rbegin(), border - 1);
+      }
+      if (!right.empty()) {
+        EXPECT_EQ(*right.cbegin(), border);
+        EXPECT_EQ(*right.rbegin(), n - 1);
+      }
+      EXPECT_TRUE(std::is_sorted(right.cbegin(), right.cend()));
+
+      // деревья после split остаются изменяемыми
+      right.insert(n + 10);
+      left.insert(-10);
+      left.joinUnique(right);
+      checkRBSubtree(left.getRoot());
+      EXPECT_EQ(left.size(), static_cast<size_t>(n + 2));
+      EXPECT_TRUE(right.empty());
+      EXPECT_EQ(*left.cbegin(), -10);
+      EXPECT_EQ(*left.rbegin(), n + 10);
+      if (n > 0) {
+        EXPECT_EQ(left.nth(static_cast<size_t>(n / 2 + 1)).operator*(), n / 2);
+      }
+    }
+  }
+}
+
+TEST(RBTreeTest, join_trees_of_different_heights) {
+  for (int small : {0, 1, 5, 40}) {
+    s21::RBTree<int> big;
+    s21::RBTree<int> tail;
+    for (int i = 0; i < 5000; ++i) big.insert(i);
+    s21::RBTree<int> head;
+    for (int i = 0; i < small; ++i) {
+      tail.insert(10000 + i);
+      head.insert(-1 - i);
+    }
+
+    big.join(tail); // низкое дерево справа
+    checkRBSubtree(big.getRoot());
+    EXPECT_EQ(big.size(), 5000U + small);
+
+    head.join(big); // высокое дерево справа от низкого
+    checkRBSubtree(head.getRoot());
+    EXPECT_TRUE(big.empty());
+    EXPECT_EQ(head.size(), 5000U + 2 * small);
+    EXPECT_TRUE(std::is_sorted(head.cbegin(), head.cend()));
+  }
+}
+
+TEST(set_test, split_and_join) {
+  s21::Set<int> set;
+  for (int i = 0; i < 1000; ++i) set.insert(i * 2);
+
+  auto upper = set.split(1001);
+  EXPECT_EQ(set.size(), 501U);
+  EXPECT_EQ(upper.size(), 499U);
+  EXPECT_EQ(*set.rbegin(), 1000);
+  EXPECT_EQ(*upper.begin(), 1002);
+  EXPECT_TRUE(set.contains(0));
+  EXPECT_FALSE(set.contains(1002));
+  EXPECT_EQ(upper.rank(1500), 249U);
+
+  s21::Set<int> overlap = {999, 5000};
+  EXPECT_THROW(set.join(overlap), std::invalid_argument);
+  EXPECT_EQ(overlap.size(), 2U);
+  s21::Set<int> touch = {1000};
+  EXPECT_THROW(set.join(touch), std::invalid_argument);
+
+  upper.join(set); // set целиком левее upper
+  EXPECT_TRUE(set.empty());
+  EXPECT_EQ(upper.size(), 1000U);
+  for (int i = 0; i < 1000; ++i) EXPECT_EQ(upper.select(i), i * 2);
+}
+
+TEST(set_test, split_shares_node_memory) {
+  s21_test::AllocStats stats;
+  {
+    using CountingSet =
+        s21::Set<int, std::less<int>, s21_test::CountingAllocator<int>>;
+    s21_test::CountingAllocator<int> alloc(&stats);
+    auto left = std::make_unique<CountingSet>(alloc);
+    for (int i = 0; i < 3000; ++i) left->insert(i);
+
+    auto right = std::make_unique<CountingSet>(left->split(1500));
+    auto third = std::make_unique<CountingSet>(right->split(2500));
+    // левое дерево удалено раньше - узлы правых частей живут в его слэбах
+    left.reset();
+    EXPECT_EQ(right->size(), 1000U);
+    for (int i = 1500; i < 2500; ++i) EXPECT_TRUE(right->contains(i));
+    for (int i = 0; i < 100; ++i) right->insert(1000 + i);
+    right->erase(right->find(2000));
+
+    third->join(*right); // right целиком левее third
+    right.reset();
+    EXPECT_EQ(third->size(), 1599U);
+    EXPECT_EQ(*third->begin(), 1000);
+    EXPECT_EQ(*third->rbegin(), 2999);
+    EXPECT_EQ(third->rank(2500), 1099U);
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(RBTreeTest, range_erase_keeps_invariants) {
+  for (int n : {1, 2, 40, 100, 1000}) {
+    for (int from : {0, 1, n / 3, n - 1}) {
+      for (int len : {0, 1, 5, 31, 32, 33, n / 2, n}) {
+        int to = std::min(n, from + len);
+        s21::RBTree<int> tree;
+        for (int i = 0; i < n; ++i) tree.insert(i);
+        auto survivor = tree.nth(static_cast<size_t>(to)); // может быть end
+        auto it = tree.erase(tree.nth(static_cast<size_t>(from)), survivor);
+        EXPECT_EQ(it, survivor);
+        checkRBSubtree(tree.getRoot());
+        ASSERT_EQ(tree.size(), static_cast<size_t>(n - (to - from)));
+        int expected = 0;
+        for (int key : tree) {
+          if (expected == from) expected = to;
+          EXPECT_EQ(key, expected++);
+        }
+        if (!tree.empty()) {
+          EXPECT_EQ(*tree.rbegin(), to == n ? from - 1 : n - 1);
+        }
+        tree.insert(from); // дерево остаётся изменяемым
+        checkRBSubtree(tree.getRoot());
+      }
+    }
+  }
+}
+
+TEST(RBTreeTest, erase_if_keeps_invariants) {
+  for (int n : {0, 1, 7, 100, 1000}) {
+    for (int step : {1, 2, 3, 1000}) {
+      s21::RBTree<int> tree;
+      for (int i = 0; i < n; ++i) tree.insert(i);
+      auto last = tree.nth(static_cast<size_t>(n / 2));
+      bool last_kept = n > 0 && (n / 2) % step != 0;
+      size_t erased = tree.eraseIf([step](int key) { return key % step == 0; });
+      checkRBSubtree(tree.getRoot());
+      EXPECT_EQ(erased + tree.size(), static_cast<size_t>(n));
+      for (int key : tree) EXPECT_NE(key % step, 0);
+      if (last_kept) {
+        EXPECT_EQ(*last, n / 2); // узел не перемещён
+        EXPECT_EQ(tree.rank(n / 2), tree.getNodeIndex(last.getCurrentNode()));
+      }
+    }
+  }
+}
+
+TEST(set_test, erase_range_and_key) {
+  s21::Set<int> set;
+  for (int i = 0; i < 1000; ++i) set.insert(i);
+  // просроченные ключи ниже водяной отметки
+  auto it = set.erase(set.begin(), set.find(600));
+  EXPECT_EQ(*it, 600);
+  EXPECT_EQ(set.size(), 400U);
+  EXPECT_EQ(*set.begin(), 600);
+
+  EXPECT_EQ(set.erase(700), 1U);
+  EXPECT_EQ(set.erase(700), 0U);
+  EXPECT_EQ(set.erase(5), 0U);
+  EXPECT_FALSE(set.contains(700));
+
+  it = set.erase(set.find(900), set.end());
+  EXPECT_EQ(it, set.end());
+  EXPECT_EQ(*set.rbegin(), 899);
+  EXPECT_EQ(set.size(), 299U);
+  EXPECT_EQ(set.erase(set.begin(), set.begin()), set.begin());
+}
+
+TEST(set_test, erase_if_counts_and_keeps_order) {
+  s21::Set<int> set;
+  for (int i = 0; i < 500; ++i) set.insert(i);
+  auto kept = set.find(251);
+  EXPECT_EQ(s21::erase_if(set, [](int key) { return key % 2 == 0; }), 250U);
+  EXPECT_EQ(set.size(), 250U);
+  EXPECT_EQ(*kept, 251);
+  EXPECT_EQ(set.rank(251), 125U);
+  EXPECT_TRUE(std::is_sorted(set.begin(), set.end()));
+  EXPECT_EQ(s21::erase_if(set, [](int) { return false; }), 0U);
+  EXPECT_EQ(s21::erase_if(set, [](int) { return true; }), 250U);
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(set_test, erase_if_throwing_predicate_leaves_valid_set) {
+  s21::Set<int> set;
+  for (int i = 0; i < 100; ++i) set.insert(i);
+  EXPECT_THROW(s21::erase_if(set,
+                             [](int key) {
+                               if (key == 50) {
+                                 throw std::runtime_error("stop");
+                               }
+                               return key < 10;
+                             }),
+               std::runtime_error);
+  // ключи до исключения стёрты, остальные на месте
+  EXPECT_EQ(set.size(), 90U);
+  EXPECT_EQ(*set.begin(), 10);
+  EXPECT_EQ(*set.rbegin(), 99);
+  EXPECT_TRUE(set.contains(50));
+  set.insert(5);
+  EXPECT_EQ(set.rank(50), 41U);
+}
+
+TEST(set_test, node_color_packed_into_parent_link) {
+  using BaseNode = s21::RBTBaseNode<long long, std::less<long long>>;
+  using Node = s21::RBTNode<long long, std::less<long long>>;
+  if (S21_RBTREE_PACKED_COLOR) {
+    // три ссылки, ключ и размер поддерева - без отдельного слова под цвет
+    EXPECT_EQ(sizeof(BaseNode), 3 * sizeof(void *));
+    EXPECT_EQ(sizeof(Node), 3 * sizeof(void *) + 2 * 8);
+  }
+  Node parent(1LL);
+  Node child(2LL);
+  child.setParent(&parent);
+  EXPECT_TRUE(child.isRed());
+  EXPECT_EQ(child.parent(), &parent);
+  child.setRed(false);
+  EXPECT_FALSE(child.isRed());
+  EXPECT_EQ(child.parent(), &parent);
+  child.setParent(nullptr);
+  EXPECT_EQ(child.parent(), nullptr);
+  EXPECT_FALSE(child.isRed());
+  BaseNode::swapColors(&parent, &child);
+  EXPECT_FALSE(parent.isRed());
+  EXPECT_TRUE(child.isRed());
+}
+
+TEST(set_test, find_many_matches_single_find) {
+  // дерево больше S21_RBTREE_BATCH_MIN_BYTES - ключи ищутся пакетами
+  s21::Set<int> set;
+  for (int i = 0; i < 20000; ++i) set.insert(i * 3);
+  // пачка длиннее ширины пакета, с отсутствующими и повторными ключами
+  std::vector<int> keys;
+  for (int i = 0; i < 200; ++i) keys.push_back((i * 937) % 61000);
+  keys.push_back(-5);
+  keys.push_back(0);
+
+  std::vector<s21::Set<int>::iterator> found;
+  set.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+  ASSERT_EQ(found.size(), keys.size());
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(found[i], set.find(keys[i])) << keys[i];
+  }
+
+  const s21::Set<int> &view = set;
+  std::vector<s21::Set<int>::const_iterator> const_found(keys.size());
+  auto end = view.find_many(keys.begin(), keys.end(), const_found.begin());
+  EXPECT_EQ(end, const_found.end());
+  bool flags[202];
+  set.contains_many(keys.begin(), keys.end(), flags);
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(const_found[i], view.find(keys[i]));
+    EXPECT_EQ(flags[i], set.contains(keys[i]));
+  }
+
+  s21::Set<int> empty;
+  empty.contains_many(keys.begin(), keys.begin() + 3, flags);
+  EXPECT_FALSE(flags[0] || flags[1] || flags[2]);
+}
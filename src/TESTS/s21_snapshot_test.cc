@@ -0,0 +1,385 @@
+#include "test_runner.h"
+#include "test_helpers.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+using s21_test::TempFile;
+
+std::uint64_t payloadOf(const TempFile &file) {
+  s21::SnapshotHeader header{};
+  EXPECT_EQ(pread(file.fd(), &header, sizeof(header), 0),
+            static_cast<ssize_t>(sizeof(header)));
+  return header.payload;
+}
+
+} // namespace
+
+TEST(snapshot_test, vector_and_array_round_trip) {
+  TempFile file;
+  s21::vector<int> numbers;
+  for (int i = 0; i < 100000; ++i) numbers.push_back(i * 7 - 3);
+  numbers.save(file.fd());
+  // тривиально копируемые элементы - одним блоком без длины каждого
+  EXPECT_EQ(payloadOf(file), 100000U * sizeof(int));
+  s21::vector<std::string> words = {"", "alpha", std::string(70000, 'x')};
+  words.save(file.fd());
+  s21::array<double, 3> point = {1.5, -2.0, 3.25};
+  point.save(file.fd());
+
+  file.rewind();
+  s21::vector<int> loaded_numbers = {42};
+  loaded_numbers.load(file.fd());
+  ASSERT_EQ(loaded_numbers.size(), numbers.size());
+  for (std::size_t i = 0; i < numbers.size(); ++i) {
+    ASSERT_EQ(loaded_numbers[i], numbers[i]);
+  }
+  s21::vector<std::string> loaded_words;
+  loaded_words.load(file.fd());
+  ASSERT_EQ(loaded_words.size(), 3U);
+  EXPECT_EQ(loaded_words[0], "");
+  EXPECT_EQ(loaded_words[1], "alpha");
+  EXPECT_EQ(loaded_words[2], words[2]);
+  s21::array<double, 3> loaded_point;
+  loaded_point.load(file.fd());
+  EXPECT_EQ(loaded_point[1], -2.0);
+  EXPECT_EQ(loaded_point[2], 3.25);
+
+  // в снимке три элемента, а массив на два
+  file.rewind();
+  lseek(file.fd(), -static_cast<off_t>(sizeof(s21::SnapshotHeader) +
+                                       3 * sizeof(double)),
+        SEEK_END);
+  s21::array<double, 2> small;
+  EXPECT_THROW(small.load(file.fd()), std::runtime_error);
+}
+
+TEST(snapshot_test, list_round_trip) {
+  TempFile file;
+  s21::list<std::string> list = {"one", "two", "three"};
+  list.save(file.fd());
+  s21::list<std::string> empty;
+  empty.save(file.fd());
+
+  file.rewind();
+  s21::list<std::string> loaded = {"old"};
+  loaded.load(file.fd());
+  ASSERT_EQ(loaded.size(), 3U);
+  EXPECT_EQ(loaded.front(), "one");
+  EXPECT_EQ(loaded.back(), "three");
+  loaded.load(file.fd());
+  EXPECT_TRUE(loaded.empty());
+}
+
+TEST(snapshot_test, trees_round_trip_in_one_stream) {
+  TempFile file;
+  s21::Set<std::string> set;
+  s21::Map<int, std::string> map;
+  s21::MultiSet<long long> multiset;
+  for (int i = 0; i < 5000; ++i) {
+    set.insert("key" + std::to_string(i));
+    map.insert(i * 3, std::to_string(i));
+    multiset.insert(i % 100);
+  }
+  set.save(file.fd());
+  map.save(file.fd());
+  multiset.save(file.fd());
+
+  file.rewind();
+  s21::Set<std::string> loaded_set;
+  loaded_set.load(file.fd());
+  s21::Map<int, std::string> loaded_map;
+  loaded_map.load(file.fd());
+  s21::MultiSet<long long> loaded_multiset;
+  loaded_multiset.load(file.fd());
+
+  EXPECT_TRUE(std::equal(set.begin(), set.end(), loaded_set.begin(),
+                         loaded_set.end()));
+  ASSERT_EQ(loaded_map.size(), 5000U);
+  EXPECT_EQ(loaded_map.at(300), "100");
+  EXPECT_FALSE(loaded_map.contains(301));
+  EXPECT_EQ(loaded_multiset.size(), 5000U);
+  EXPECT_EQ(loaded_multiset.count(42), 50U);
+  // дерево построено целиком: поиск и порядковая статистика работают
+  EXPECT_EQ(loaded_set.rank("key2"), set.rank("key2"));
+  loaded_set.insert("key!");
+  EXPECT_EQ(*loaded_set.begin(), "key!");
+}
+
+namespace {
+
+// тривиально копируемый ключ без конструктора по умолчанию
+struct Point {
+  explicit Point(int x, int y) : x(x), y(y) {}
+  bool operator<(const Point &other) const {
+    return x < other.x || (x == other.x && y < other.y);
+  }
+  int x;
+  int y;
+};
+
+} // namespace
+
+TEST(snapshot_test, keys_without_default_constructor_round_trip) {
+  TempFile file;
+  s21::Set<Point> set;
+  s21::Map<Point, Point> map;
+  for (int i = 0; i < 100; ++i) {
+    set.insert(Point(i, -i));
+    map.insert(Point(i, i), Point(-i, i));
+  }
+  set.save(file.fd());
+  map.save(file.fd());
+
+  file.rewind();
+  s21::Set<Point> loaded_set;
+  loaded_set.load(file.fd());
+  s21::Map<Point, Point> loaded_map;
+  loaded_map.load(file.fd());
+  ASSERT_EQ(loaded_set.size(), 100U);
+  EXPECT_TRUE(loaded_set.contains(Point(42, -42)));
+  ASSERT_EQ(loaded_map.size(), 100U);
+  EXPECT_EQ(loaded_map.at(Point(7, 7)).x, -7);
+}
+
+TEST(snapshot_test, streams_through_a_pipe_without_reading_ahead) {
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  s21::Map<std::string, int> map = {{"b", 2}, {"a", 1}};
+  s21::vector<char> tail = {'e', 'n', 'd'};
+  map.save(fds[1]);
+  tail.save(fds[1]);
+  ASSERT_EQ(write(fds[1], "!", 1), 1);
+  close(fds[1]);
+
+  s21::Map<std::string, int> loaded;
+  loaded.load(fds[0]);
+  EXPECT_EQ(loaded.at("a"), 1);
+  EXPECT_EQ(loaded.at("b"), 2);
+  s21::vector<char> loaded_tail;
+  loaded_tail.load(fds[0]);
+  EXPECT_EQ(loaded_tail[2], 'd');
+  char rest = 0;
+  EXPECT_EQ(read(fds[0], &rest, 1), 1); // байт после снимков не съеден
+  EXPECT_EQ(rest, '!');
+  close(fds[0]);
+}
+
+TEST(snapshot_test, rejects_other_containers_and_types) {
+  TempFile file;
+  s21::Set<int> set = {1, 2, 3};
+  set.save(file.fd());
+
+  s21::Map<int, int> map = {{7, 7}};
+  file.rewind();
+  EXPECT_THROW(map.load(file.fd()), std::runtime_error);
+  EXPECT_EQ(map.at(7), 7); // при ошибке содержимое не меняется
+  s21::Set<long long> wider = {9};
+  file.rewind();
+  EXPECT_THROW(wider.load(file.fd()), std::runtime_error);
+  EXPECT_TRUE(wider.contains(9));
+  s21::vector<int> vector;
+  file.rewind();
+  EXPECT_THROW(vector.load(file.fd()), std::runtime_error);
+  s21::MultiSet<int> multiset;
+  file.rewind();
+  EXPECT_THROW(multiset.load(file.fd()), std::runtime_error);
+
+  char junk[64] = "not a snapshot at all";
+  TempFile other;
+  ASSERT_EQ(write(other.fd(), junk, sizeof(junk)),
+            static_cast<ssize_t>(sizeof(junk)));
+  other.rewind();
+  EXPECT_THROW(set.load(other.fd()), std::runtime_error);
+  EXPECT_EQ(set.size(), 3U);
+}
+
+TEST(snapshot_test, rejects_truncated_and_corrupted_data) {
+  TempFile file;
+  s21::Set<int> set;
+  for (int i = 0; i < 1000; ++i) set.insert(i);
+  set.save(file.fd());
+
+  // переставленные ключи: дерево не строится
+  int swapped[2] = {5, 4};
+  ASSERT_EQ(pwrite(file.fd(), swapped, sizeof(swapped),
+                   sizeof(s21::SnapshotHeader) + 4 * sizeof(int)),
+            static_cast<ssize_t>(sizeof(swapped)));
+  s21::Set<int> loaded = {-1};
+  file.rewind();
+  EXPECT_THROW(loaded.load(file.fd()), std::invalid_argument);
+  EXPECT_EQ(loaded.size(), 1U);
+  // те же данные - допустимый снимок MultiSet только без повторов
+  int duplicate[2] = {4, 4};
+  ASSERT_EQ(pwrite(file.fd(), duplicate, sizeof(duplicate),
+                   sizeof(s21::SnapshotHeader) + 4 * sizeof(int)),
+            static_cast<ssize_t>(sizeof(duplicate)));
+  file.rewind();
+  EXPECT_THROW(loaded.load(file.fd()), std::invalid_argument);
+
+  // обрезанный файл
+  ASSERT_EQ(ftruncate(file.fd(), file.size() - 1), 0);
+  file.rewind();
+  EXPECT_THROW(loaded.load(file.fd()), std::runtime_error);
+  EXPECT_TRUE(loaded.contains(-1));
+
+  // испорченная длина строки не приводит к огромному выделению памяти
+  TempFile strings;
+  s21::vector<std::string> words = {"abc"};
+  words.save(strings.fd());
+  std::uint64_t length = std::uint64_t(1) << 60;
+  ASSERT_EQ(pwrite(strings.fd(), &length, sizeof(length),
+                   sizeof(s21::SnapshotHeader)),
+            static_cast<ssize_t>(sizeof(length)));
+  strings.rewind();
+  EXPECT_THROW(words.load(strings.fd()), std::runtime_error);
+  EXPECT_EQ(words[0], "abc");
+}
+
+namespace {
+
+// снимок, оборванный на середине, подаётся через канал: размер файла не
+// проверить заранее, и ошибка случается посреди построения дерева
+template <typename Container>
+void expectTruncatedPipeThrows(const Container &source, off_t cut) {
+  TempFile file;
+  source.save(file.fd());
+  std::vector<char> bytes(static_cast<std::size_t>(file.size() - cut));
+  ASSERT_EQ(pread(file.fd(), bytes.data(), bytes.size(), 0),
+            static_cast<ssize_t>(bytes.size()));
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  ASSERT_EQ(write(fds[1], bytes.data(), bytes.size()),
+            static_cast<ssize_t>(bytes.size()));
+  close(fds[1]);
+  Container loaded;
+  EXPECT_THROW(loaded.load(fds[0]), std::runtime_error);
+  EXPECT_TRUE(loaded.empty());
+  close(fds[0]);
+}
+
+} // namespace
+
+TEST(snapshot_test, truncated_string_trees_free_partial_nodes) {
+  s21::Set<std::string> set;
+  s21::Map<std::string, std::string> map;
+  s21::MultiSet<std::string> multiset;
+  for (int i = 0; i < 300; ++i) {
+    // длинные строки живут в куче: утечка узла видна проверке утечек
+    std::string key = "snapshot key that is not short " + std::to_string(i);
+    set.insert(key);
+    map.insert(key, key + " value");
+    multiset.insert(key);
+    multiset.insert(key);
+  }
+  for (off_t cut : {1, 5, 40, 700}) {
+    expectTruncatedPipeThrows(set, cut);
+    expectTruncatedPipeThrows(map, cut);
+    expectTruncatedPipeThrows(multiset, cut);
+  }
+}
+
+TEST(snapshot_test, header_count_does_not_size_allocations) {
+  TempFile file;
+  s21::vector<int> numbers = {1, 2, 3};
+  numbers.save(file.fd());
+  s21::SnapshotHeader header{};
+  ASSERT_EQ(pread(file.fd(), &header, sizeof(header), 0),
+            static_cast<ssize_t>(sizeof(header)));
+  header.count = std::uint64_t(1) << 50;
+  header.payload = header.count * sizeof(int);
+  ASSERT_EQ(pwrite(file.fd(), &header, sizeof(header), 0),
+            static_cast<ssize_t>(sizeof(header)));
+
+  // обычный файл: payload длиннее остатка файла отвергается сразу
+  file.rewind();
+  EXPECT_THROW(numbers.load(file.fd()), std::runtime_error);
+  s21::Set<int> set = {7};
+  file.rewind();
+  header.kind = static_cast<std::uint32_t>(s21::SnapshotKind::kSet);
+  ASSERT_EQ(pwrite(file.fd(), &header, sizeof(header), 0),
+            static_cast<ssize_t>(sizeof(header)));
+  EXPECT_THROW(set.load(file.fd()), std::runtime_error);
+  EXPECT_TRUE(set.contains(7));
+
+  // канал: память растёт только по мере прихода данных
+  char bytes[sizeof(header) + 3 * sizeof(int)];
+  ASSERT_EQ(pread(file.fd(), bytes, sizeof(bytes), 0),
+            static_cast<ssize_t>(sizeof(bytes)));
+  for (s21::SnapshotKind kind :
+       {s21::SnapshotKind::kSet, s21::SnapshotKind::kVector}) {
+    header.kind = static_cast<std::uint32_t>(kind);
+    std::memcpy(bytes, &header, sizeof(header));
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    ASSERT_EQ(write(fds[1], bytes, sizeof(bytes)),
+              static_cast<ssize_t>(sizeof(bytes)));
+    close(fds[1]);
+    if (kind == s21::SnapshotKind::kSet) {
+      EXPECT_THROW(set.load(fds[0]), std::runtime_error);
+    } else {
+      EXPECT_THROW(numbers.load(fds[0]), std::runtime_error);
+    }
+    close(fds[0]);
+  }
+  EXPECT_EQ(numbers.size(), 3U);
+}
+
+TEST(snapshot_test, string_length_does_not_size_allocations) {
+  TempFile file;
+  s21::vector<std::string> words = {"abc"};
+  words.save(file.fd());
+  s21::SnapshotHeader header{};
+  ASSERT_EQ(pread(file.fd(), &header, sizeof(header), 0),
+            static_cast<ssize_t>(sizeof(header)));
+  // payload и длина согласованы между собой, но данных за ними нет
+  header.payload = std::uint64_t(1) << 40;
+  std::uint64_t length = std::uint64_t(1) << 33;
+  char bytes[sizeof(header) + sizeof(length) + 3];
+  ASSERT_EQ(pread(file.fd(), bytes, sizeof(bytes), 0),
+            static_cast<ssize_t>(sizeof(bytes)));
+  std::memcpy(bytes, &header, sizeof(header));
+  std::memcpy(bytes + sizeof(header), &length, sizeof(length));
+
+  int fds[2];
+  ASSERT_EQ(pipe(fds), 0);
+  ASSERT_EQ(write(fds[1], bytes, sizeof(bytes)),
+            static_cast<ssize_t>(sizeof(bytes)));
+  close(fds[1]);
+  EXPECT_THROW(words.load(fds[0]), std::runtime_error);
+  close(fds[0]);
+  EXPECT_EQ(words.size(), 1U);
+  EXPECT_EQ(words[0], "abc");
+
+  // настоящая длинная строка из канала собирается из нескольких кусков
+  TempFile source;
+  s21::vector<std::string> long_words = {
+      std::string(3 * s21::SnapshotReader::kBufferSize + 5, 'q'), "tail"};
+  long_words.save(source.fd());
+  std::vector<char> data(static_cast<std::size_t>(source.size()));
+  ASSERT_EQ(pread(source.fd(), data.data(), data.size(), 0),
+            static_cast<ssize_t>(data.size()));
+  ASSERT_EQ(pipe(fds), 0);
+  std::thread feeder([&] {
+    ASSERT_EQ(write(fds[1], data.data(), data.size()),
+              static_cast<ssize_t>(data.size()));
+    close(fds[1]);
+  });
+  s21::vector<std::string> loaded;
+  loaded.load(fds[0]);
+  feeder.join();
+  close(fds[0]);
+  ASSERT_EQ(loaded.size(), 2U);
+  EXPECT_EQ(loaded[0], long_words[0]);
+  EXPECT_EQ(loaded[1], "tail");
+}
@@ -1,6 +1,7 @@
 
 #include <stack>
 #include "test_runner.h"
+#include "counting_allocator.h"
 
 
 TEST(create_stack, check_create_stack_1) { s21::stack<int> ex; }
@@ -107,3 +108,16 @@ TEST(test_insert_many, check_insert_many_1) {
   }
 }
 
+TEST(Stack_Allocator, forwards_allocator_to_vector) {
+  s21_test::AllocStats stats;
+  {
+    s21_test::CountingAllocator<int> alloc(&stats);
+    s21::stack<int, s21_test::CountingAllocator<int>> st(alloc);
+    st.push(1);
+    st.push(2);
+    EXPECT_EQ(st.top(), 2);
+    EXPECT_TRUE(st.get_allocator() == alloc);
+    EXPECT_GT(stats.allocations, 0U);
+  }
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
@@ -0,0 +1,320 @@
+#include "test_runner.h"
+#include "counting_allocator.h"
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+// Прозрачные хеш и сравнение: поиск по const char * и string_view без
+// построения std::string
+struct StringHash {
+  using is_transparent = void;
+  std::size_t operator()(std::string_view key) const noexcept {
+    return std::hash<std::string_view>()(key);
+  }
+};
+
+struct StringEqual {
+  using is_transparent = void;
+  bool operator()(std::string_view a, std::string_view b) const noexcept {
+    return a == b;
+  }
+};
+
+// Все ключи в одной цепочке проб: проверяет надгробия и полный перебор групп
+struct CollidingHash {
+  std::size_t operator()(int) const noexcept { return 42; }
+};
+
+// Ключ, копирование которого можно заставить бросить исключение
+struct FragileKey {
+  static inline bool fail = false;
+  int value;
+
+  FragileKey(int v) : value(v) {}
+  FragileKey(const FragileKey &other) : value(other.value) {
+    if (fail) throw std::runtime_error("copy");
+  }
+  FragileKey(FragileKey &&other) : value(other.value) {} // не noexcept
+  bool operator==(const FragileKey &other) const {
+    return value == other.value;
+  }
+};
+
+struct FragileHash {
+  std::size_t operator()(const FragileKey &key) const noexcept {
+    return static_cast<std::size_t>(key.value);
+  }
+};
+
+} // namespace
+
+TEST(unordered_map_test, element_access_and_modifiers) {
+  s21::UnorderedMap<std::string, int> map{{"one", 1}, {"two", 2}, {"one", 3}};
+  EXPECT_EQ(map.size(), 2U);
+  EXPECT_EQ(map.at("one"), 1);
+  EXPECT_THROW(map.at("three"), std::out_of_range);
+  map["three"] = 3;
+  EXPECT_EQ(map.at("three"), 3);
+  EXPECT_FALSE(map.insert("two", 20).second);
+  EXPECT_EQ(map["two"], 2);
+  EXPECT_FALSE(map.insert_or_assign("two", 20).second);
+  EXPECT_EQ(map["two"], 20);
+  EXPECT_TRUE(map.try_emplace("four", 4).second);
+  EXPECT_FALSE(map.try_emplace("four", 40).second);
+  EXPECT_EQ(map.at("four"), 4);
+  EXPECT_TRUE(map.emplace("five", 5).second);
+  EXPECT_EQ(map.insert_many(std::make_pair(std::string("six"), 6),
+                            std::make_pair(std::string("one"), 0)),
+            (std::vector<bool>{true, false}));
+  EXPECT_EQ(map.size(), 6U);
+  EXPECT_TRUE(map.contains("five"));
+  EXPECT_EQ(map.count("seven"), 0U);
+  auto range = map.equal_range("six");
+  EXPECT_EQ(std::distance(range.first, range.second), 1);
+  EXPECT_EQ(range.first->second, 6);
+  range = map.equal_range("seven");
+  EXPECT_TRUE(range.first == map.end() && range.second == map.end());
+  EXPECT_EQ(map.erase("one"), 1U);
+  EXPECT_EQ(map.erase("one"), 0U);
+  EXPECT_TRUE(map.checkInvariants());
+
+  s21::UnorderedMap<std::string, int> copy(map);
+  EXPECT_TRUE(copy.checkInvariants());
+  s21::UnorderedMap<std::string, int> moved(std::move(copy));
+  EXPECT_TRUE(copy.empty());
+  EXPECT_EQ(moved.size(), 5U);
+  copy = moved;
+  EXPECT_EQ(copy.at("two"), 20);
+  map = std::move(moved);
+  EXPECT_EQ(map.size(), 5U);
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_TRUE(map.checkInvariants());
+}
+
+TEST(unordered_map_test, random_operations_match_std_unordered_map) {
+  std::mt19937 rng(17);
+  s21::UnorderedMap<int, int> map;
+  std::unordered_map<int, int> reference;
+  for (int i = 0; i < 200000; ++i) {
+    int key = static_cast<int>(rng() % 30000);
+    switch (rng() % 4) {
+    case 0:
+    case 1:
+      ASSERT_EQ(map.insert({key, i}).second,
+                reference.insert({key, i}).second);
+      break;
+    case 2:
+      ASSERT_EQ(map.erase(key), reference.erase(key));
+      break;
+    default:
+      ASSERT_EQ(map.contains(key), reference.count(key) == 1);
+    }
+    if (i % 20000 == 0) {
+      ASSERT_TRUE(map.checkInvariants());
+    }
+  }
+  ASSERT_TRUE(map.checkInvariants());
+  ASSERT_EQ(map.size(), reference.size());
+  std::size_t visited = 0;
+  for (const auto &item : map) {
+    auto it = reference.find(item.first);
+    ASSERT_NE(it, reference.end());
+    ASSERT_EQ(it->second, item.second);
+    ++visited;
+  }
+  EXPECT_EQ(visited, reference.size());
+  EXPECT_LE(map.load_factor(), 0.875f);
+}
+
+TEST(unordered_map_test, copy_after_erase_churn_keeps_tombstones) {
+  std::mt19937 rng(23);
+  s21::UnorderedMap<int, int> map;
+  std::unordered_map<int, int> reference;
+  for (int round = 0; round < 200; ++round) {
+    for (int i = 0; i < 50; ++i) {
+      int key = static_cast<int>(rng() % 1200);
+      if (rng() % 2 == 0) {
+        map.insert({key, round});
+        reference.insert({key, round});
+      } else {
+        map.erase(key);
+        reference.erase(key);
+      }
+    }
+    // копии конструктором и присваиванием находят каждый свой ключ
+    s21::UnorderedMap<int, int> copy(map);
+    s21::UnorderedMap<int, int> assigned;
+    assigned = map;
+    ASSERT_TRUE(copy.checkInvariants());
+    ASSERT_TRUE(assigned.checkInvariants());
+    ASSERT_EQ(copy.size(), reference.size());
+    for (const auto &item : reference) {
+      ASSERT_EQ(copy.at(item.first), item.second);
+      ASSERT_TRUE(assigned.contains(item.first));
+      // повторная вставка в копию не создаёт дубликат
+      ASSERT_FALSE(copy.insert({item.first, -1}).second);
+    }
+    ASSERT_EQ(copy.size(), reference.size());
+  }
+}
+
+TEST(unordered_map_test, erase_while_iterating_and_erase_if) {
+  s21::UnorderedMap<int, int> map;
+  for (int i = 0; i < 5000; ++i) map[i] = i * 2;
+  for (auto it = map.begin(); it != map.end();) {
+    it = it->first % 2 == 0 ? map.erase(it) : std::next(it);
+  }
+  EXPECT_EQ(map.size(), 2500U);
+  EXPECT_TRUE(map.checkInvariants());
+  EXPECT_EQ(s21::erase_if(map, [](const auto &item) {
+              return item.first % 5 == 0;
+            }),
+            500U);
+  EXPECT_EQ(map.size(), 2000U);
+  EXPECT_FALSE(map.contains(15));
+  EXPECT_EQ(map.at(17), 34);
+  map.erase(map.begin(), map.end());
+  EXPECT_TRUE(map.empty());
+  EXPECT_TRUE(map.checkInvariants());
+}
+
+TEST(unordered_map_test, reserve_keeps_iterators_valid) {
+  s21::UnorderedMap<int, int> map(1000);
+  std::size_t capacity = map.capacity();
+  EXPECT_GE(capacity * 7 / 8, 1000U);
+  auto first = map.insert({-1, -1}).first;
+  for (int i = 0; i < 999; ++i) map.insert({i, i});
+  EXPECT_EQ(map.capacity(), capacity);
+  EXPECT_EQ(first->first, -1); // таблица не перестраивалась
+  map.reserve(10);
+  EXPECT_EQ(map.capacity(), capacity);
+  map.reserve(100000);
+  EXPECT_GE(map.capacity() * 7 / 8, 100000U);
+  EXPECT_EQ(map.size(), 1000U);
+  EXPECT_TRUE(map.checkInvariants());
+}
+
+TEST(unordered_map_test, heterogeneous_lookup) {
+  s21::UnorderedMap<std::string, int, StringHash, StringEqual> map;
+  map["alpha"] = 1;
+  map["beta"] = 2;
+  std::string_view key = "beta";
+  EXPECT_TRUE(map.contains(key));
+  EXPECT_EQ(map.count("alpha"), 1U);
+  EXPECT_EQ(map.find(key)->second, 2);
+  EXPECT_EQ(map.find(std::string_view("gamma")), map.end());
+  const auto &constant = map;
+  EXPECT_EQ(constant.find(key)->second, 2);
+}
+
+TEST(unordered_map_test, merge_moves_absent_keys) {
+  s21::UnorderedMap<int, std::string> map{{1, "a"}, {2, "b"}};
+  s21::UnorderedMap<int, std::string> other{{2, "x"}, {3, "c"}};
+  map.merge(other);
+  EXPECT_EQ(map.size(), 3U);
+  EXPECT_EQ(map.at(2), "b");
+  EXPECT_EQ(map.at(3), "c");
+  EXPECT_EQ(other.size(), 1U);
+  EXPECT_EQ(other.at(2), "x");
+}
+
+TEST(unordered_set_test, collisions_and_tombstones) {
+  s21::UnorderedSet<int, CollidingHash> set;
+  for (int i = 0; i < 300; ++i) set.insert(i);
+  EXPECT_TRUE(set.checkInvariants());
+  for (int round = 0; round < 20; ++round) {
+    for (int i = 0; i < 300; i += 2) EXPECT_EQ(set.erase(i), 1U);
+    EXPECT_TRUE(set.checkInvariants());
+    for (int i = 0; i < 300; i += 2) EXPECT_TRUE(set.insert(i).second);
+    EXPECT_TRUE(set.checkInvariants());
+  }
+  EXPECT_EQ(set.size(), 300U);
+  EXPECT_LE(set.capacity(), 512U); // надгробия не раздувают таблицу
+  for (int i = 0; i < 300; ++i) EXPECT_TRUE(set.contains(i));
+  EXPECT_FALSE(set.contains(300));
+}
+
+TEST(unordered_set_test, modifiers_and_lookup) {
+  s21::UnorderedSet<int> set{5, 1, 4, 1, 3};
+  EXPECT_EQ(set.size(), 4U);
+  std::vector<int> source{3, 7, 8, 7};
+  set.insert(source.begin(), source.end());
+  EXPECT_EQ(set.size(), 6U);
+  EXPECT_EQ(set.insert_many(9, 1, 10), (std::vector<bool>{true, false, true}));
+  EXPECT_TRUE(set.emplace(11).second);
+  EXPECT_EQ(*set.find(7), 7);
+  EXPECT_EQ(set.find(2), set.end());
+  std::vector<int> keys(set.begin(), set.end());
+  std::sort(keys.begin(), keys.end());
+  EXPECT_EQ(keys, (std::vector<int>{1, 3, 4, 5, 7, 8, 9, 10, 11}));
+
+  s21::UnorderedSet<int> other{1, 100};
+  set.merge(other);
+  EXPECT_EQ(set.size(), 10U);
+  EXPECT_EQ(other.size(), 1U);
+  set.swap(other);
+  EXPECT_EQ(set.size(), 1U);
+  EXPECT_EQ(other.size(), 10U);
+  EXPECT_EQ(s21::erase_if(other, [](int key) { return key > 5; }), 6U);
+  EXPECT_TRUE(other.checkInvariants());
+}
+
+TEST(unordered_set_test, heterogeneous_lookup) {
+  s21::UnorderedSet<std::string, StringHash, StringEqual> set{"red", "green"};
+  EXPECT_TRUE(set.contains(std::string_view("red")));
+  EXPECT_FALSE(set.contains("blue"));
+  EXPECT_EQ(set.count(std::string_view("green")), 1U);
+  EXPECT_EQ(*set.find("green"), "green");
+}
+
+TEST(unordered_set_test, uses_given_allocator) {
+  s21_test::AllocStats stats;
+  {
+    using Set = s21::UnorderedSet<int, std::hash<int>, std::equal_to<int>,
+                                  s21_test::CountingAllocator<int>>;
+    Set set{s21_test::CountingAllocator<int>(&stats)};
+    for (int i = 0; i < 10000; ++i) set.insert(i);
+    EXPECT_GT(stats.allocations, 0U);
+    EXPECT_EQ(stats.live_bytes, set.memory_usage());
+    Set copy(set);
+    EXPECT_EQ(stats.live_bytes, 2 * set.memory_usage());
+    copy.clear();
+    EXPECT_EQ(stats.live_bytes, 2 * set.memory_usage()); // ячейки остаются
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(unordered_set_test, throwing_copy_leaves_valid_table) {
+  s21::UnorderedSet<FragileKey, FragileHash> set;
+  for (int i = 0; i < 13; ++i) set.insert(FragileKey(i));
+  std::size_t capacity = set.capacity();
+  FragileKey::fail = true;
+  FragileKey key(13);
+  EXPECT_THROW(set.insert(key), std::runtime_error); // копия ключа
+  FragileKey::fail = false;
+  EXPECT_EQ(set.size(), 13U);
+  EXPECT_TRUE(set.checkInvariants());
+  set.insert(key);
+  EXPECT_EQ(set.capacity(), capacity);
+
+  FragileKey::fail = true; // таблица полна: перестройка копирует ключи
+  EXPECT_THROW(set.insert(FragileKey(14)), std::runtime_error);
+  FragileKey::fail = false;
+  EXPECT_EQ(set.capacity(), capacity);
+  EXPECT_EQ(set.size(), 14U);
+  EXPECT_TRUE(set.checkInvariants());
+  for (int i = 0; i < 14; ++i) EXPECT_TRUE(set.contains(FragileKey(i)));
+  EXPECT_TRUE(set.insert(FragileKey(14)).second);
+  EXPECT_GT(set.capacity(), capacity);
+  EXPECT_TRUE(set.checkInvariants());
+}
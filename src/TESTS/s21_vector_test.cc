@@ -1,6 +1,10 @@
 
+#include <memory>
+#include <string>
+#include <type_traits>
 #include <vector>
 #include "test_runner.h"
+#include "counting_allocator.h"
 
 
 
@@ -172,3 +176,103 @@ TEST(Vector_Modifiers, insert_many_back) {
   EXPECT_EQ(a.size(), 7);
   EXPECT_EQ(a.back(), -7);
 }
+
+TEST(Vector_Modifiers, insert_and_push_back_by_move) {
+  s21::vector<std::string> a;
+  std::string text(100, 'x');
+  a.push_back(std::move(text));
+  EXPECT_TRUE(text.empty());
+  std::string head = "head";
+  auto it = a.insert(a.begin(), std::move(head));
+  EXPECT_EQ(*it, "head");
+  EXPECT_EQ(a.size(), 2U);
+  EXPECT_EQ(a.back(), std::string(100, 'x'));
+}
+
+TEST(Vector_Modifiers, erase_range) {
+  s21::vector<int> a = {0, 1, 2, 3, 4, 5};
+  auto it = a.erase(a.begin() + 1, a.begin() + 4);
+  EXPECT_EQ(*it, 4);
+  EXPECT_EQ(a.size(), 3U);
+  EXPECT_EQ(a[2], 5);
+  EXPECT_EQ(a.erase(a.end(), a.end()), a.end());
+  EXPECT_THROW(a.erase(a.begin() + 2, a.begin() + 1), std::out_of_range);
+  const s21::vector<int> &c = a;
+  EXPECT_EQ(*c.begin(), 0);
+  EXPECT_EQ(c.end() - c.data(), 3);
+}
+
+TEST(Vector_Modifiers, erase_empty_range_keeps_strings) {
+  s21::vector<std::string> a = {"a", "c", "e"};
+  auto it = a.erase(a.begin() + 1, a.begin() + 1);
+  EXPECT_EQ(it, a.begin() + 1);
+  ASSERT_EQ(a.size(), 3U);
+  EXPECT_EQ(a[0], "a");
+  EXPECT_EQ(a[1], "c"); // сдвиг на себя опустошал строки
+  EXPECT_EQ(a[2], "e");
+
+  a.erase(a.begin(), a.begin() + 1);
+  ASSERT_EQ(a.size(), 2U);
+  EXPECT_EQ(a[0], "c");
+  EXPECT_EQ(a[1], "e");
+}
+
+TEST(Vector_Modifiers, erase_range_releases_elements) {
+  auto first = std::make_shared<int>(1);
+  auto last = std::make_shared<int>(2);
+  s21::vector<std::shared_ptr<int>> a = {first, first, last};
+  EXPECT_EQ(first.use_count(), 3);
+  a.erase(a.begin() + 2, a.end()); // удаление в конце
+  EXPECT_EQ(last.use_count(), 1);
+  a.erase(a.begin(), a.begin() + 1);
+  EXPECT_EQ(first.use_count(), 2);
+  EXPECT_EQ(a.size(), 1U);
+}
+
+TEST(Vector_Allocator, uses_given_allocator) {
+  s21_test::AllocStats stats;
+  {
+    s21_test::CountingAllocator<int> alloc(&stats);
+    s21::vector<int, s21_test::CountingAllocator<int>> a(alloc);
+    for (int i = 0; i < 100; ++i) a.push_back(i);
+    a.shrink_to_fit();
+    EXPECT_EQ(a.size(), 100U);
+    EXPECT_EQ(a[99], 99);
+    EXPECT_TRUE(a.get_allocator() == alloc);
+    EXPECT_GT(stats.allocations, 0U);
+
+    auto b = a;
+    EXPECT_EQ(b.size(), 100U);
+    EXPECT_TRUE(b.get_allocator() == alloc);
+  }
+  EXPECT_EQ(stats.allocations, stats.deallocations);
+  EXPECT_EQ(stats.live_bytes, 0U);
+}
+
+TEST(Vector_Allocator, move_assign_with_unequal_allocators_moves_values) {
+  using Alloc = s21_test::CountingAllocator<std::shared_ptr<int>>;
+  using PtrVector = s21::vector<std::shared_ptr<int>, Alloc>;
+  static_assert(!std::is_nothrow_move_assignable<PtrVector>::value,
+                "unequal allocators may have to allocate");
+  static_assert(std::is_nothrow_move_assignable<s21::vector<int>>::value,
+                "std::allocator is always equal");
+
+  s21_test::AllocStats stats_a;
+  s21_test::AllocStats stats_b;
+  {
+    PtrVector a{Alloc(&stats_a)};
+    PtrVector b{Alloc(&stats_b)};
+    auto shared = std::make_shared<int>(7);
+    for (int i = 0; i < 5; ++i) a.push_back(shared);
+    EXPECT_EQ(shared.use_count(), 6);
+    b = std::move(a);
+    // память взята у аллокатора b, значения перемещены, а не скопированы
+    EXPECT_EQ(b.size(), 5U);
+    EXPECT_EQ(shared.use_count(), 6);
+    EXPECT_EQ(*b[4], 7);
+    EXPECT_TRUE(b.get_allocator() == Alloc(&stats_b));
+    EXPECT_GT(stats_b.live_bytes, 0U);
+  }
+  EXPECT_EQ(stats_a.live_bytes, 0U);
+  EXPECT_EQ(stats_b.live_bytes, 0U);
+}
@@ -0,0 +1,102 @@
+#ifndef TEST_HELPERS_H_
+#define TEST_HELPERS_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib> // mkstemp
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "test_runner.h"
+
+namespace s21_test {
+
+// Временный файл: дескриптор для снимков, путь - для открытия по имени;
+// удаляется в деструкторе
+class TempFile {
+public:
+  TempFile() {
+    char path[] = "/tmp/s21_test_XXXXXX";
+    fd_ = mkstemp(path);
+    path_ = path;
+  }
+  ~TempFile() {
+    close(fd_);
+    unlink(path_.c_str());
+  }
+  TempFile(const TempFile &) = delete;
+  TempFile &operator=(const TempFile &) = delete;
+
+  int fd() const { return fd_; }
+  const std::string &path() const { return path_; }
+  void rewind() const { lseek(fd_, 0, SEEK_SET); }
+  off_t size() const { return lseek(fd_, 0, SEEK_END); }
+
+private:
+  int fd_;
+  std::string path_;
+};
+
+// Строит случайное s21::Set из n чётных ключей (нечётные соседи заведомо
+// отсутствуют) и такой же std::set и передаёт оба в check
+template <typename Key, typename Check>
+void checkAgainstStdSet(std::size_t n, unsigned seed, Check check) {
+  std::mt19937_64 gen(seed);
+  std::set<Key> expected;
+  s21::Set<Key> set;
+  while (expected.size() < n) {
+    Key key = static_cast<Key>(gen() % (4 * n + 1)) * 2;
+    expected.insert(key);
+    set.insert(key);
+  }
+  check(set, expected);
+}
+
+// Запросы для сравнения поиска: ключи образца, их соседи и крайние значения
+template <typename Key> std::vector<Key> probeKeys(const std::set<Key> &keys) {
+  std::vector<Key> probes;
+  for (Key key : keys) {
+    probes.push_back(key);
+    probes.push_back(static_cast<Key>(key + 1));
+    probes.push_back(static_cast<Key>(key - 1));
+  }
+  probes.push_back(std::numeric_limits<Key>::max());
+  probes.push_back(std::numeric_limits<Key>::min());
+  return probes;
+}
+
+// contains и count контейнера совпадают с std::set на всех запросах
+template <typename Container, typename Key>
+void expectSameMembership(const Container &container,
+                          const std::set<Key> &expected) {
+  for (Key key : probeKeys(expected)) {
+    ASSERT_EQ(container.contains(key), expected.count(key) == 1);
+    ASSERT_EQ(container.count(key), expected.count(key));
+  }
+}
+
+// Число потоков в тестах: не меньше minimum даже на одноядерной машине
+inline unsigned testThreads(unsigned minimum) {
+  return std::max(minimum, std::thread::hardware_concurrency());
+}
+
+// Запускает fn(номер потока) в count потоках и ждёт их завершения
+template <typename Fn> void runThreads(unsigned count, Fn fn) {
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < count; ++t) {
+    threads.emplace_back(fn, t);
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+}
+
+} // namespace s21_test
+
+#endif // TEST_HELPERS_H_
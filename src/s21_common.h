@@ -10,6 +10,8 @@
 #include <utility>    // для std::exchange
 #include <functional> // printMap
 #include <initializer_list>
+#include <iterator>    // std::iterator_traits для RequireInputIter
+#include <type_traits> // std::enable_if
 
 
 // Цветовые макросы для печати
@@ -29,16 +31,31 @@
 // Макрос для упрощения печати функции print
 #define PRINT(var) print(var, #var)
 
-#ifdef __APPLE__
-using std::exchange;
-#endif
-
-#ifdef __linux__
-#define exchange __exchange
-using std::__exchange;
-#endif
-
 // Используемые стандартные функции
 using std::cout, std::endl, std::copy, std::move, std::swap;
 
+namespace s21 {
+
+// Разрешает перегрузку только для итераторов (а не, например, для int)
+template <typename It>
+using RequireInputIter = typename std::enable_if<std::is_convertible<
+    typename std::iterator_traits<It>::iterator_category,
+    std::input_iterator_tag>::value>::type;
+
+// Ключ элемента множества - сам элемент
+template <typename Key> struct Identity {
+  const Key &operator()(const Key &value) const noexcept { return value; }
+};
+
+// Ключ элемента словаря - первый член пары
+template <typename Key> struct SelectFirst {
+  // шаблон: std::pair<Key, T> не преобразуется во временный value_type
+  template <typename Pair>
+  const Key &operator()(const Pair &value) const noexcept {
+    return value.first;
+  }
+};
+
+} // namespace s21
+
 #endif  // S21_COMMON_H_
\ No newline at end of file
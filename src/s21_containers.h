@@ -14,33 +14,100 @@
 #include "MAIN_FUNCTIONS/s21_multiset.h"
 #include "MAIN_FUNCTIONS/s21_set.h"
 #include "MAIN_FUNCTIONS/s21_queue.h"
+#include "MAIN_FUNCTIONS/s21_btree_map.h"
+#include "MAIN_FUNCTIONS/s21_btree_multiset.h"
+#include "MAIN_FUNCTIONS/s21_btree_set.h"
+#include "MAIN_FUNCTIONS/s21_flat_map.h"
+#include "MAIN_FUNCTIONS/s21_flat_multiset.h"
+#include "MAIN_FUNCTIONS/s21_flat_set.h"
+#include "MAIN_FUNCTIONS/s21_unordered_map.h"
+#include "MAIN_FUNCTIONS/s21_unordered_set.h"
+#include "MAIN_FUNCTIONS/s21_concurrent_map.h"
+#include "MAIN_FUNCTIONS/s21_seqlock_map.h"
+#include "MAIN_FUNCTIONS/s21_persistent_map.h"
+#include "MAIN_FUNCTIONS/s21_persistent_set.h"
+#include "MAIN_FUNCTIONS/s21_frozen_map.h"
+#include "MAIN_FUNCTIONS/s21_frozen_set.h"
+#include "MAIN_FUNCTIONS/s21_mapped_map.h"
+#include "MAIN_FUNCTIONS/s21_mapped_set.h"
 
 
 namespace s21 {
 
-template <typename T>
+template <typename T, typename Allocator>
 class vector;
 
 template <typename T, std::size_t N>
 class array;
 
-template <typename T>
+template <typename T, typename Allocator>
 class stack;
 
-template <typename T>
+template <typename T, typename Allocator>
 class list;
 
-template <typename T>
+template <typename T, typename Allocator>
 class queue;
 
-template <typename Key, typename Value> class Map;
+template <typename Key, typename Value, typename Compare, typename Allocator>
+class Map;
 
-template <typename Key>
+template <typename Key, typename Compare, typename Allocator>
 class Set;
 
-template <typename Key>
+template <typename Key, typename Compare, typename Allocator>
 class MultiSet;
 
+template <typename Key, typename Value, typename Compare, typename Allocator>
+class BTreeMap;
+
+template <typename Key, typename Compare, typename Allocator>
+class BTreeSet;
+
+template <typename Key, typename Compare, typename Allocator>
+class BTreeMultiSet;
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+class FlatMap;
+
+template <typename Key, typename Compare, typename Allocator>
+class FlatSet;
+
+template <typename Key, typename Compare, typename Allocator>
+class FlatMultiSet;
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual,
+          typename Allocator>
+class UnorderedMap;
+
+template <typename Key, typename Hash, typename KeyEqual, typename Allocator>
+class UnorderedSet;
+
+template <typename Key, typename Value, std::size_t Shards, typename Hash,
+          typename Compare, typename Allocator>
+class ConcurrentMap;
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+class SeqlockMap;
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+class PersistentMap;
+
+template <typename Key, typename Compare, typename Allocator>
+class PersistentSet;
+
+template <typename Key, typename Value, typename Compare, typename Allocator>
+class FrozenMap;
+
+template <typename Key, typename Compare, typename Allocator>
+class FrozenSet;
+
+template <typename Key, typename Value, typename Compare>
+class MappedMap;
+
+template <typename Key, typename Compare>
+class MappedSet;
+
 }
 
 